@@ -0,0 +1,304 @@
+/**
+ * \file            gsm_bench.c
+ * \brief           Host benchmark of GSM stack on virtual device
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "stdio.h"
+#include "string.h"
+#include "time.h"
+#include "unistd.h"
+#include "gsm/gsm.h"
+#include "gsm/gsm_mem.h"
+#include "gsm/apps/gsm_mqtt_client.h"
+#include "system/gsm_ll_sim.h"
+
+/* Number of commands timed in latency scenario */
+#define BENCH_CMD_COUNT                     200
+
+/* Number of bytes received in each throughput scenario */
+#define BENCH_RX_TOTAL                      (4 * 1024 * 1024)
+
+/* Maximal number of `+RECEIVE` chunks queued in virtual device */
+#define BENCH_RX_INFLIGHT                   16
+
+/* Number of messages published in MQTT scenario */
+#define BENCH_MQTT_COUNT                    2000
+
+/* Payload length of published messages */
+#define BENCH_MQTT_PAYLOAD_LEN              64
+
+/* Time to wait for scenario to finish in units of milliseconds */
+#define BENCH_TIMEOUT                       10000
+
+static volatile size_t rx_bytes;                /* Bytes received on connection */
+static volatile uint32_t mqtt_published;        /* Number of published messages */
+static volatile uint8_t mqtt_connected;         /* Set to `1` when CONNACK is received */
+
+/**
+ * \brief           Get monotonic time
+ * \return          Time in units of microseconds
+ */
+static uint64_t
+time_us(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * \brief           Get peak heap usage since last \ref gsm_mem_reset_peak call
+ * \return          Peak heap usage in units of bytes
+ */
+static size_t
+heap_peak(void) {
+    gsm_mem_stats_t stats;
+
+    gsm_mem_getstats(&stats);
+    return stats.total - stats.min_free;
+}
+
+/**
+ * \brief           Wait for counter to reach value
+ * \param[in]       cnt: Counter to check
+ * \param[in]       value: Expected value
+ * \return          `1` when value is reached, `0` on timeout
+ */
+static uint8_t
+wait_count(volatile size_t* cnt, size_t value) {
+    uint64_t start = time_us();
+
+    while (*cnt < value) {
+        if (time_us() - start > (uint64_t)BENCH_TIMEOUT * 1000) {
+            return 0;
+        }
+        usleep(100);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Global event callback
+ * \param[in]       evt: Event information
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+gsm_evt(gsm_evt_t* evt) {
+    (void)evt;
+    return gsmOK;
+}
+
+/**
+ * \brief           Connection event callback, counts received bytes
+ * \param[in]       evt: Event information
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+conn_evt(gsm_evt_t* evt) {
+    if (gsm_evt_get_type(evt) == GSM_EVT_CONN_DATA_RECV) {
+        rx_bytes += gsm_pbuf_length(gsm_evt_conn_data_recv_get_buff(evt), 1);
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           MQTT event callback, counts published messages
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: MQTT event
+ */
+static void
+mqtt_evt(gsm_mqtt_client_p client, gsm_mqtt_evt_t* evt) {
+    switch (gsm_mqtt_client_evt_get_type(client, evt)) {
+        case GSM_MQTT_EVT_CONNECT:
+            mqtt_connected = gsm_mqtt_client_evt_connect_get_status(client, evt) == GSM_MQTT_CONN_STATUS_ACCEPTED;
+            break;
+        case GSM_MQTT_EVT_PUBLISH:
+            if (gsm_mqtt_client_evt_publish_get_result(client, evt) == gsmOK) {
+                mqtt_published++;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * \brief           Measure round-trip latency of blocking command
+ *
+ *                  Time covers producer queue, command start, device response and completion
+ */
+static void
+bench_cmd(void) {
+    uint64_t t, sum = 0, min = UINT64_MAX, max = 0;
+    gsm_ll_sim_stats_t stats;
+    int16_t rssi;
+    size_t i;
+
+    gsm_ll_sim_reset_stats();
+    gsm_mem_reset_peak();
+    for (i = 0; i < BENCH_CMD_COUNT; i++) {
+        t = time_us();
+        if (gsm_network_rssi(&rssi, 1) != gsmOK) {
+            printf("cmd AT+CSQ                failed\r\n");
+            return;
+        }
+        t = time_us() - t;
+        sum += t;
+        min = GSM_MIN(min, t);
+        max = GSM_MAX(max, t);
+    }
+    gsm_ll_sim_get_stats(&stats);
+    printf("cmd AT+CSQ                avg %6u us, min %6u us, max %6u us, peak heap %6u B, %u commands\r\n",
+        (unsigned)(sum / BENCH_CMD_COUNT), (unsigned)min, (unsigned)max, (unsigned)heap_peak(), (unsigned)stats.cmds);
+}
+
+/**
+ * \brief           Measure receive throughput with `+RECEIVE` data of fixed chunk size
+ * \param[in]       num: Connection number
+ * \param[in]       chunk: Number of bytes in each `+RECEIVE` notification
+ */
+static void
+bench_rx(uint8_t num, size_t chunk) {
+    static uint8_t data[1460];
+    size_t injected = 0, len;
+    uint64_t t;
+
+    memset(data, 'x', sizeof(data));
+    rx_bytes = 0;
+    gsm_mem_reset_peak();
+    t = time_us();
+    while (injected < BENCH_RX_TOTAL) {
+        if (injected - rx_bytes >= BENCH_RX_INFLIGHT * chunk) {
+            usleep(50);                         /* Keep virtual device queue from overflowing */
+            continue;
+        }
+        len = GSM_MIN(chunk, BENCH_RX_TOTAL - injected);
+        if (gsm_ll_sim_receive(num, data, len, 0) != gsmOK) {
+            break;
+        }
+        injected += len;
+    }
+    if (!wait_count(&rx_bytes, injected) || injected < BENCH_RX_TOTAL) {
+        printf("rx %4u B chunks          failed, %u of %u bytes received\r\n",
+            (unsigned)chunk, (unsigned)rx_bytes, (unsigned)BENCH_RX_TOTAL);
+        return;
+    }
+    t = time_us() - t;
+    printf("rx %4u B chunks          %9u B/s, peak heap %6u B\r\n",
+        (unsigned)chunk, (unsigned)((uint64_t)BENCH_RX_TOTAL * 1000000 / t), (unsigned)heap_peak());
+}
+
+/**
+ * \brief           Measure rate of QoS 0 messages published by MQTT client
+ * \param[in]       num: Connection number client will use
+ */
+static void
+bench_mqtt(uint8_t num) {
+    static const uint8_t connack[] = { 0x20, 0x02, 0x00, 0x00 };
+    static const gsm_mqtt_client_info_t info = {
+        .id = "gsm_bench",
+        .keep_alive = 60,
+    };
+    uint8_t payload[BENCH_MQTT_PAYLOAD_LEN];
+    gsm_mqtt_client_p client;
+    uint64_t t;
+    uint32_t i;
+
+    memset(payload, 'p', sizeof(payload));
+    gsm_mem_reset_peak();
+    if ((client = gsm_mqtt_client_new(2048, 256)) == NULL
+        || gsm_mqtt_client_connect(client, "broker", 1883, mqtt_evt, &info) != gsmOK) {
+        printf("mqtt publish              failed to connect\r\n");
+        return;
+    }
+
+    /* Virtual device does not speak MQTT, answer CONNECT packet once it is sent */
+    gsm_delay(100);
+    gsm_ll_sim_receive(num, connack, sizeof(connack), 0);
+    for (i = 0; !mqtt_connected && i < 100; i++) {
+        gsm_delay(10);
+    }
+    if (!mqtt_connected) {
+        printf("mqtt publish              no CONNACK\r\n");
+        gsm_mqtt_client_delete(client);
+        return;
+    }
+
+    mqtt_published = 0;
+    t = time_us();
+    for (i = 0; i < BENCH_MQTT_COUNT; i++) {
+        while (gsm_mqtt_client_publish(client, "bench/topic", payload, sizeof(payload), GSM_MQTT_QOS_AT_MOST_ONCE, 0, NULL) != gsmOK) {
+            usleep(50);                         /* Wait for space in client buffer */
+        }
+    }
+    while (mqtt_published < BENCH_MQTT_COUNT && time_us() - t < (uint64_t)BENCH_TIMEOUT * 1000) {
+        usleep(100);
+    }
+    t = time_us() - t;
+    if (mqtt_published < BENCH_MQTT_COUNT) {
+        printf("mqtt publish              failed, %u of %u published\r\n", (unsigned)mqtt_published, (unsigned)BENCH_MQTT_COUNT);
+    } else {
+        printf("mqtt publish %3u B QoS 0  %8u msg/s, peak heap %6u B\r\n",
+            (unsigned)BENCH_MQTT_PAYLOAD_LEN, (unsigned)((uint64_t)BENCH_MQTT_COUNT * 1000000 / t), (unsigned)heap_peak());
+    }
+    gsm_mqtt_client_disconnect(client);
+    gsm_delay(100);
+    gsm_mqtt_client_delete(client);
+}
+
+int
+main(void) {
+    static const size_t chunks[] = { 64, 512, 1460 };
+    gsm_conn_p conn;
+    uint8_t num;
+    size_t i;
+
+    setvbuf(stdout, NULL, _IOLBF, 0);           /* Show each result as soon as it is measured */
+    if (gsm_init(gsm_evt, 1) != gsmOK
+        || gsm_network_attach("apn", "", "", 1) != gsmOK) {
+        printf("Cannot initialize stack\r\n");
+        return 1;
+    }
+
+    bench_cmd();
+
+    if (gsm_conn_start(&conn, GSM_CONN_TYPE_TCP, "example.com", 80, NULL, conn_evt, 1) != gsmOK) {
+        printf("Cannot start connection\r\n");
+        return 1;
+    }
+    num = (uint8_t)gsm_conn_getnum(conn);
+    for (i = 0; i < GSM_ARRAYSIZE(chunks); i++) {
+        bench_rx(num, chunks[i]);
+    }
+    gsm_conn_close(conn, 1);
+
+    bench_mqtt(num);                            /* Stack reuses number of closed connection */
+    return 0;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file            gsm_config.h
+ * \brief           Configuration of GSM stack for host benchmark
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_CONFIG_H
+#define __GSM_CONFIG_H
+
+/* First include debug before any config changes */
+#include "gsm/gsm_debug.h"
+
+/*
+ * Run stack with POSIX system port on virtual device.
+ * Other options may be changed from command line,
+ * for example `make CFLAGS_EXTRA=-DGSM_CFG_IPD_MAX_BUFF_SIZE=512`
+ */
+#define GSM_CFG_SYS_PORT                    GSM_SYS_PORT_POSIX
+#define GSM_CFG_CONN                        1
+
+/* Virtual device thread passes data directly to parser, no data are dropped */
+#define GSM_CFG_INPUT_USE_PROCESS           1
+
+/* After user configuration, call default config to merge config together */
+#include "gsm/gsm_config_default.h"
+
+#endif /* __GSM_CONFIG_H */
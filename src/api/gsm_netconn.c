@@ -65,10 +65,44 @@ typedef struct gsm_netconn {
 #if GSM_CFG_NETCONN_RECEIVE_TIMEOUT || __DOXYGEN__
     uint32_t rcv_timeout;                       /*!< Receive timeout in unit of milliseconds */
 #endif
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+    size_t rcv_window;                          /*!< Receive window in units of bytes */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
+
+    gsm_pbuf_p rcv_pbuf;                        /*!< Partially read packet buffer, used by \ref gsm_netconn_read */
+    size_t rcv_pbuf_off;                        /*!< Read offset in partially read packet buffer */
+    uint8_t rcv_closed;                         /*!< Set to `1` when closed notification was taken by \ref gsm_netconn_read */
+
+    size_t rcv_queued;                          /*!< Number of packet buffers in receive mbox */
+    uint8_t closed;                             /*!< Set to `1` when connection was closed by remote side */
+    uint8_t poll_wait;                          /*!< Set to `1` when thread waits in \ref gsm_netconn_poll for this netconn */
+
+    gsm_sys_mbox_t mbox_accept;                 /*!< Accept queue of server netconn */
+    gsm_port_t listen_port;                     /*!< Port used by server netconn */
+    struct gsm_netconn* listener;               /*!< Server netconn which owns this pre-allocated netconn */
+    struct gsm_netconn* pool_next;              /*!< Next free pre-allocated netconn, or first free one on server netconn */
+    uint32_t conn_idle;                         /*!< Time without data exchange in units of milliseconds */
 } gsm_netconn_t;
 
+/**
+ * \brief           Maximal number of not read packet buffers in receive mbox.
+ *                  One entry is always kept free for closed connection notification
+ */
+#define NETCONN_RCV_WINDOW_PKTS             (GSM_CFG_NETCONN_RECEIVE_QUEUE_LEN - 1)
+
 static uint8_t recv_closed = 0xFF, recv_not_present = 0xFF;
-static gsm_netconn_t* netconn_list;             /*!< Linked list of netconn entries */
+
+/**
+ * \brief           Wake up thread waiting in \ref gsm_netconn_poll for netconn
+ * \note            Core must be protected when function is called
+ * \param[in]       nc: Netconn with new event
+ */
+static void
+poll_signal(gsm_netconn_t* nc) {
+    if (nc->poll_wait && gsm_sys_sem_isvalid(&gsm.netconn.poll_sem)) {
+        gsm_sys_sem_release(&gsm.netconn.poll_sem);
+    }
+}
 
 /**
  * \brief           Flush all mboxes and clear possible used memories
@@ -86,14 +120,99 @@ flush_mboxes(gsm_netconn_t* nc, uint8_t protect) {
                 gsm_pbuf_free(pbuf);            /* Free received data buffers */
             }
         }
-        gsm_sys_mbox_delete(&nc->mbox_receive); /* Delete message queue */
-        gsm_sys_mbox_invalid(&nc->mbox_receive);/* Invalid handle */
+        nc->rcv_queued = 0;
+        if (nc->listener == NULL) {             /* Pre-allocated netconns keep mbox for next client */
+            gsm_sys_mbox_delete(&nc->mbox_receive); /* Delete message queue */
+            gsm_sys_mbox_invalid(&nc->mbox_receive);/* Invalid handle */
+        }
+    }
+    if (nc->rcv_pbuf != NULL) {                 /* Free partially read buffer */
+        gsm_pbuf_free(nc->rcv_pbuf);
+        nc->rcv_pbuf = NULL;
     }
     if (protect) {
         gsm_core_unlock();                      /* Release protection */
     }
 }
 
+/**
+ * \brief           Take next packet buffer from receive mbox
+ * \param[in]       nc: Netconn handle
+ * \param[out]      pbuf: Pointer to output variable to save packet buffer to
+ * \param[in]       timeout: Maximal time to wait when blocking. Set to `0` to wait forever
+ * \param[in]       block: Set to `1` to wait for packet or `0` to only check queue
+ * \return          \ref gsmOK on success, \ref gsmCLOSED when connection closed
+ *                  or \ref gsmTIMEOUT when there is no packet
+ */
+static gsmr_t
+take_pbuf(gsm_netconn_p nc, gsm_pbuf_p* pbuf, uint32_t timeout, uint8_t block) {
+    *pbuf = NULL;
+    if (block) {
+        if (gsm_sys_mbox_get(&nc->mbox_receive, (void **)pbuf, timeout) == GSM_SYS_TIMEOUT) {
+            return gsmTIMEOUT;
+        }
+    } else if (!gsm_sys_mbox_getnow(&nc->mbox_receive, (void **)pbuf)) {
+        return gsmTIMEOUT;
+    }
+
+    /* Check if connection closed */
+    if ((uint8_t *)(*pbuf) == (uint8_t *)&recv_closed) {
+        *pbuf = NULL;                           /* Reset pbuf */
+        return gsmCLOSED;
+    }
+    GSM_CORE_PROTECT();
+    nc->rcv_queued--;
+    GSM_CORE_UNPROTECT();
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    gsm_conn_recved(nc->conn, *pbuf);           /* Application took data, read more from device */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+    return gsmOK;                               /* We have data available */
+}
+
+/**
+ * \brief           Take free pre-allocated netconn for new server connection
+ * \note            Core must be protected when function is called
+ * \param[in]       conn: Connection accepted by device
+ * \return          Netconn handle on success, `NULL` when all are in use
+ */
+static gsm_netconn_t*
+netconn_accept_conn(gsm_conn_p conn) {
+    gsm_netconn_t* nc;
+
+    if (gsm.netconn.listen == NULL || (nc = gsm.netconn.listen->pool_next) == NULL) {
+        return NULL;
+    }
+    gsm.netconn.listen->pool_next = nc->pool_next;  /* Remove it from free list */
+    nc->pool_next = NULL;
+    nc->conn = conn;
+    nc->rcv_packets = 0;
+    nc->rcv_queued = 0;
+    nc->rcv_closed = 0;
+    nc->closed = 0;
+    nc->conn_idle = 0;
+    nc->conn_timeout = gsm.netconn.listen->conn_timeout;
+#if GSM_CFG_NETCONN_RECEIVE_TIMEOUT
+    nc->rcv_timeout = gsm.netconn.listen->rcv_timeout;
+#endif /* GSM_CFG_NETCONN_RECEIVE_TIMEOUT */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    nc->rcv_window = gsm.netconn.listen->rcv_window;
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+    return nc;
+}
+
+/**
+ * \brief           Return pre-allocated netconn to free list of its server
+ * \note            Core must be protected when function is called
+ * \param[in]       nc: Pre-allocated netconn handle
+ */
+static void
+netconn_pool_put(gsm_netconn_t* nc) {
+    flush_mboxes(nc, 0);                        /* Clear old data, mbox stays valid */
+    nc->conn = NULL;
+    nc->pool_next = nc->listener->pool_next;
+    nc->listener->pool_next = nc;
+}
+
 /**
  * \brief           Callback function for every server connection
  * \param[in]       evt: Pointer to callback structure
@@ -116,13 +235,36 @@ netconn_evt(gsm_evt_t* evt) {
                 nc = gsm_conn_get_arg(conn);    /* Argument should be already set */
                 if (nc != NULL) {
                     nc->conn = conn;            /* Save actual connection */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+                    gsm_conn_set_receive_window(conn, nc->rcv_window, NETCONN_RCV_WINDOW_PKTS);
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
                 } else {
                     close = 1;                  /* Close this connection, invalid netconn */
                 }
             } else {
-                GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
-                    "[NETCONN] Closing connection, it is not in client mode!\r\n");
-                close = 1;                      /* Close the connection at this point */
+                /*
+                 * Connection accepted by device server.
+                 * Use pre-allocated netconn, no memory allocation is done here
+                 */
+                nc = netconn_accept_conn(conn);
+                if (nc != NULL) {
+                    gsm_conn_set_arg(conn, nc); /* Set netconn as connection argument */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+                    gsm_conn_set_receive_window(conn, nc->rcv_window, NETCONN_RCV_WINDOW_PKTS);
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+                    if (nc->conn_timeout > 0) { /* Idle time is counted on poll events */
+                        gsm_conn_set_poll_interval(conn, GSM_CFG_CONN_POLL_INTERVAL);
+                    }
+                    if (!gsm_sys_mbox_putnow(&gsm.netconn.listen->mbox_accept, nc)) {
+                        GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+                            "[NETCONN] Cannot put server connection to accept queue!\r\n");
+                        close = 1;
+                    }
+                } else {
+                    GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+                        "[NETCONN] Closing server connection, accept queue is full!\r\n");
+                    close = 1;                  /* Close the connection at this point */
+                }
             }
 
             /* Decide if some events want to close the connection */
@@ -147,8 +289,11 @@ netconn_evt(gsm_evt_t* evt) {
             nc = gsm_conn_get_arg(conn);        /* Get API from connection */
             pbuf = gsm_evt_conn_data_recv_get_buff(evt);/* Get received buff */
 
+#if !GSM_CFG_CONN_MANUAL_TCP_RECEIVE
             gsm_conn_recved(conn, pbuf);        /* Notify stack about received data */
+#endif /* !GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
             nc->rcv_packets++;                  /* Increase number of received packets */
+            nc->conn_idle = 0;                  /* Reset idle time on data exchange */
 
             /*
              * First increase reference number to prevent
@@ -160,12 +305,20 @@ netconn_evt(gsm_evt_t* evt) {
              */
             gsm_pbuf_ref(pbuf);                 /* Increase reference counter */
             if (!nc || !gsm_sys_mbox_isvalid(&nc->mbox_receive)
+#if GSM_CFG_IPD_ZERO_COPY
+                || gsmi_pbuf_copy_payload(pbuf) != gsmOK    /* Receiving thread must not read receive buffer */
+#endif /* GSM_CFG_IPD_ZERO_COPY */
                 || !gsm_sys_mbox_putnow(&nc->mbox_receive, pbuf)) {
                 GSM_DEBUGF(GSM_CFG_DBG_NETCONN,
                     "[NETCONN] Ignoring more data for receive!\r\n");
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+                gsm_conn_recved(conn, pbuf);    /* Data are dropped, do not block reception */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
                 gsm_pbuf_free(pbuf);            /* Free pbuf */
                 return gsmOKIGNOREMORE;         /* Return OK to free the memory and ignore further data */
             }
+            nc->rcv_queued++;
+            poll_signal(nc);
             GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE,
                 "[NETCONN] Written %d bytes to receive mbox\r\n",
                 (int)gsm_pbuf_length(pbuf, 0));
@@ -182,10 +335,36 @@ netconn_evt(gsm_evt_t* evt) {
              */
             if (nc != NULL && gsm_sys_mbox_isvalid(&nc->mbox_receive)) {
                 gsm_sys_mbox_putnow(&nc->mbox_receive, (void *)&recv_closed);
+                nc->closed = 1;
+                poll_signal(nc);
             }
 
             break;
         }
+
+        /* Data were sent, connection is not idle */
+        case GSM_EVT_CONN_DATA_SEND: {
+            nc = gsm_conn_get_arg(conn);        /* Get API from connection */
+            if (nc != NULL) {
+                nc->conn_idle = 0;
+            }
+            break;
+        }
+
+        /* Periodic poll, close server connections without data exchange */
+        case GSM_EVT_CONN_POLL: {
+            nc = gsm_conn_get_arg(conn);        /* Get API from connection */
+            if (nc != NULL && nc->conn_timeout > 0) {
+                nc->conn_idle += GSM_CFG_CONN_POLL_INTERVAL;
+                if (nc->conn_idle >= (uint32_t)nc->conn_timeout * 1000) {
+                    GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE,
+                        "[NETCONN] Closing idle server connection\r\n");
+                    nc->conn_idle = 0;
+                    gsm_conn_close(conn, 0);    /* Close connection, closed event follows */
+                }
+            }
+            break;
+        }
         default:
             return gsmERR;
     }
@@ -222,21 +401,24 @@ gsm_netconn_new(gsm_netconn_type_t type) {
         gsm_evt_register(gsm_evt);              /* Register global event function */
     }
     GSM_CORE_UNPROTECT();
-    a = gsm_mem_calloc(1, sizeof(*a));          /* Allocate memory for core object */
+    a = gsm_mem_alloc_tag(GSM_MEM_TAG_NETCONN, sizeof(*a));    /* Allocate memory for core object */
     if (a != NULL) {
         a->type = type;                         /* Save netconn type */
         a->conn_timeout = 0;                    /* Default connection timeout */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+        a->rcv_window = GSM_CFG_NETCONN_RECEIVE_WINDOW; /* Default receive window */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
         if (!gsm_sys_mbox_create(&a->mbox_receive, GSM_CFG_NETCONN_RECEIVE_QUEUE_LEN)) {    /* Allocate memory for receiving message box */
             GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_DANGER,
                 "[NETCONN] Cannot create receive MBOX\r\n");
             goto free_ret;
         }
         GSM_CORE_PROTECT();
-        if (netconn_list == NULL) {             /* Add new netconn to the existing list */
-            netconn_list = a;
+        if (gsm.netconn.list == NULL) {         /* Add new netconn to the existing list */
+            gsm.netconn.list = a;
         } else {
-            a->next = netconn_list;             /* Add it to beginning of the list */
-            netconn_list = a;
+            a->next = gsm.netconn.list;         /* Add it to beginning of the list */
+            gsm.netconn.list = a;
         }
         GSM_CORE_UNPROTECT();
     }
@@ -262,16 +444,54 @@ gsmr_t
 gsm_netconn_delete(gsm_netconn_p nc) {
     GSM_ASSERT("netconn != NULL", nc != NULL);  /* Assert input parameters */
 
+    if (nc == gsm.netconn.listen) {             /* Stop server before its netconns are freed */
+        gsm_set_server(0, 0, NULL, 1);
+    }
+
     GSM_CORE_PROTECT();
+    if (nc->listener != NULL) {                 /* Pre-allocated server netconn is not freed */
+        netconn_pool_put(nc);
+        GSM_CORE_UNPROTECT();
+        return gsmOK;
+    }
+    if (gsm_sys_mbox_isvalid(&nc->mbox_accept)) {
+        gsm_netconn_p tmp;
+
+        if (gsm.netconn.listen == nc) {
+            gsm.netconn.listen = NULL;
+        }
+        /* Close connections not yet accepted by application */
+        while (gsm_sys_mbox_getnow(&nc->mbox_accept, (void **)&tmp)) {
+            if (tmp->conn != NULL) {
+                gsm_conn_set_arg(tmp->conn, NULL);
+                gsm_conn_close(tmp->conn, 0);
+            }
+            netconn_pool_put(tmp);
+        }
+        gsm_sys_mbox_delete(&nc->mbox_accept);
+        gsm_sys_mbox_invalid(&nc->mbox_accept);
+
+        /* Netconns in use become regular netconns, free ones are released now */
+        for (tmp = gsm.netconn.list; tmp != NULL; tmp = tmp->next) {
+            if (tmp->listener == nc) {
+                tmp->listener = NULL;
+            }
+        }
+        while (nc->pool_next != NULL) {
+            tmp = nc->pool_next;
+            nc->pool_next = tmp->pool_next;
+            gsm_netconn_delete(tmp);
+        }
+    }
     flush_mboxes(nc, 0);                        /* Clear mboxes */
 
     /* Remove netconn from linkedlist */
-    if (netconn_list == nc) {
-        netconn_list = netconn_list->next;      /* Remove first from linked list */
-    } else if (netconn_list != NULL) {
+    if (gsm.netconn.list == nc) {
+        gsm.netconn.list = gsm.netconn.list->next;  /* Remove first from linked list */
+    } else if (gsm.netconn.list != NULL) {
         gsm_netconn_p tmp, prev;
         /* Find element on the list */
-        for (prev = netconn_list, tmp = netconn_list->next;
+        for (prev = gsm.netconn.list, tmp = gsm.netconn.list->next;
             tmp != NULL; prev = tmp, tmp = tmp->next) {
             if (nc == tmp) {
                 prev->next = tmp->next;         /* Remove tmp from linked list */
@@ -312,6 +532,112 @@ gsm_netconn_connect(gsm_netconn_p nc, const char* host, gsm_port_t port) {
     return res;
 }
 
+/**
+ * \brief           Bind a connection to specific port, can be only used for server connections
+ *
+ *                  \ref GSM_CFG_NETCONN_ACCEPT_QUEUE_LEN netconns with receive mboxes are allocated here,
+ *                  accepting new connection later does not allocate any memory
+ *
+ * \param[in]       nc: Netconn handle
+ * \param[in]       port: Port used to bind a connection to
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_netconn_bind(gsm_netconn_p nc, gsm_port_t port) {
+    gsm_netconn_p child;
+    size_t i;
+
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+    GSM_ASSERT("nc->type must be TCP", nc->type == GSM_NETCONN_TYPE_TCP);   /* Assert input parameters */
+    GSM_ASSERT("port > 0", port > 0);           /* Assert input parameters */
+
+    if (gsm_sys_mbox_isvalid(&nc->mbox_accept)) {   /* Already bound */
+        nc->listen_port = port;
+        return gsmOK;
+    }
+    if (!gsm_sys_mbox_create(&nc->mbox_accept, GSM_CFG_NETCONN_ACCEPT_QUEUE_LEN)) {
+        GSM_DEBUGF(GSM_CFG_DBG_NETCONN | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_DANGER,
+            "[NETCONN] Cannot create accept MBOX\r\n");
+        return gsmERRMEM;
+    }
+    for (i = 0; i < GSM_CFG_NETCONN_ACCEPT_QUEUE_LEN; i++) {
+        if ((child = gsm_netconn_new(nc->type)) == NULL) {
+            gsm_netconn_delete(nc);             /* Release everything allocated */
+            return gsmERRMEM;
+        }
+        GSM_CORE_PROTECT();
+        child->listener = nc;
+        child->pool_next = nc->pool_next;       /* Add it to free list */
+        nc->pool_next = child;
+        GSM_CORE_UNPROTECT();
+    }
+    nc->listen_port = port;
+    return gsmOK;
+}
+
+/**
+ * \brief           Listen on previously binded connection
+ * \note            Device supports only one server, listening netconn replaces previous one
+ * \param[in]       nc: Netconn handle used to listen for new connections
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_netconn_listen(gsm_netconn_p nc) {
+    gsmr_t res;
+
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+    GSM_ASSERT("nc->type must be TCP", nc->type == GSM_NETCONN_TYPE_TCP);   /* Assert input parameters */
+    GSM_ASSERT("nc must be binded", gsm_sys_mbox_isvalid(&nc->mbox_accept));    /* Assert input parameters */
+
+    /* Enable server on port and set default netconn callback */
+    if ((res = gsm_set_server(1, nc->listen_port, netconn_evt, 1)) == gsmOK) {
+        GSM_CORE_PROTECT();
+        gsm.netconn.listen = nc;                /* Set current main API in listening state */
+        GSM_CORE_UNPROTECT();
+    }
+    return res;
+}
+
+/**
+ * \brief           Set timeout for connections accepted by listening netconn
+ *
+ *                  Accepted connection is closed automatically when there is no data exchange for this time
+ *
+ * \param[in]       nc: Listening netconn handle
+ * \param[in]       timeout: Timeout in units of seconds. Set to `0` to disable timeout
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_netconn_set_listen_conn_timeout(gsm_netconn_p nc, uint16_t timeout) {
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+
+    nc->conn_timeout = timeout;
+    return gsmOK;
+}
+
+/**
+ * \brief           Accept a new connection
+ * \param[in]       nc: Netconn handle used as base connection to accept new clients
+ * \param[out]      client: Pointer to netconn handle to save new client to. Delete it with \ref gsm_netconn_delete when done
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_netconn_accept(gsm_netconn_p nc, gsm_netconn_p* client) {
+    gsm_netconn_t* tmp;
+
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+    GSM_ASSERT("client != NULL", client != NULL);   /* Assert input parameters */
+    GSM_ASSERT("nc must be listening", gsm_sys_mbox_isvalid(&nc->mbox_accept)); /* Assert input parameters */
+
+    *client = NULL;
+    gsm_sys_mbox_get(&nc->mbox_accept, (void **)&tmp, 0);
+    if (tmp == NULL || (uint8_t *)tmp == (uint8_t *)&recv_closed) {
+        return gsmCLOSED;
+    }
+    *client = tmp;                              /* Set new pointer */
+    return gsmOK;                               /* We have a new connection */
+}
+
 /**
  * \brief           Write data to connection output buffers
  * \note            This function may only be used on TCP or SSL connections
@@ -327,7 +653,7 @@ gsm_netconn_write(gsm_netconn_p nc, const void* data, size_t btw) {
     gsmr_t res;
 
     GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
-    GSM_ASSERT("nc->type must be TCP\r\n", nc->type == GSM_NETCONN_TYPE_TCP);   /* Assert input parameters */
+    GSM_ASSERT("nc->type must be TCP or SSL\r\n", nc->type != GSM_NETCONN_TYPE_UDP);    /* Assert input parameters */
     GSM_ASSERT("nc->conn must be active", gsm_conn_is_active(nc->conn));    /* Assert input parameters */
 
     /*
@@ -382,7 +708,7 @@ gsm_netconn_write(gsm_netconn_p nc, const void* data, size_t btw) {
 
     /* Step 3 */
     if (nc->buff.buff == NULL) {                /* Check if we should allocate a new buffer */
-        nc->buff.buff = gsm_mem_alloc(sizeof(*nc->buff.buff) * GSM_CFG_CONN_MAX_DATA_LEN);
+        nc->buff.buff = gsm_mem_pool_alloc(GSM_MEM_POOL_TX_CHUNK, GSM_MEM_TAG_NETCONN, sizeof(*nc->buff.buff) * GSM_CFG_CONN_MAX_DATA_LEN);
         nc->buff.len = GSM_CFG_CONN_MAX_DATA_LEN;   /* Save buffer length */
         nc->buff.ptr = 0;                       /* Save buffer pointer */
     }
@@ -392,11 +718,104 @@ gsm_netconn_write(gsm_netconn_p nc, const void* data, size_t btw) {
         GSM_MEMCPY(&nc->buff.buff[nc->buff.ptr], d, btw);   /* Copy data to buffer */
         nc->buff.ptr += btw;
     } else {                                    /* Still no memory available? */
-        return gsm_conn_send(nc->conn, data, btw, NULL, 1); /* Simply send directly blocking */
+        return gsm_conn_send(nc->conn, d, btw, NULL, 1);    /* Simply send directly blocking */
     }
     return gsmOK;
 }
 
+/**
+ * \brief           Copy data from vectors to netconn write buffer until buffer is full
+ * \param[in]       nc: Netconn handle with allocated write buffer
+ * \param[in]       iov: Array of data vectors
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \param[in,out]   i: Current vector index
+ * \param[in,out]   off: Offset in current vector
+ */
+static void
+iov_copy_to_buff(gsm_netconn_p nc, const gsm_iovec_t* iov, size_t iovcnt, size_t* i, size_t* off) {
+    size_t len;
+
+    while (*i < iovcnt && nc->buff.ptr < nc->buff.len) {
+        len = GSM_MIN(iov[*i].len - *off, nc->buff.len - nc->buff.ptr);
+        GSM_MEMCPY(&nc->buff.buff[nc->buff.ptr], (const uint8_t *)iov[*i].data + *off, len);
+        nc->buff.ptr += len;
+        *off += len;
+        if (*off == iov[*i].len) {              /* Go to next vector */
+            ++*i;
+            *off = 0;
+        }
+    }
+}
+
+/**
+ * \brief           Write data from multiple buffers to connection output buffers
+ *
+ *                  Data are handled as one continuous stream. Packets sent to device are filled
+ *                  up to \ref GSM_CFG_CONN_MAX_DATA_LEN bytes across vector boundaries
+ *                  and full packets are sent directly from application buffers without copy.
+ *
+ * \note            This function may only be used on TCP or SSL connections
+ * \param[in]       nc: Netconn handle used to write data to
+ * \param[in]       iov: Array of data vectors to write
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_netconn_writev(gsm_netconn_p nc, const gsm_iovec_t* iov, size_t iovcnt) {
+    size_t i = 0, off = 0, btw = 0, sent, j;
+    gsmr_t res;
+
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+    GSM_ASSERT("iov != NULL", iov != NULL);     /* Assert input parameters */
+    GSM_ASSERT("nc->type must be TCP or SSL\r\n", nc->type != GSM_NETCONN_TYPE_UDP);    /* Assert input parameters */
+    GSM_ASSERT("nc->conn must be active", gsm_conn_is_active(nc->conn));    /* Assert input parameters */
+
+    /* Fill pending write buffer first and send it when full */
+    if (nc->buff.buff != NULL) {
+        iov_copy_to_buff(nc, iov, iovcnt, &i, &off);
+        if (nc->buff.ptr < nc->buff.len) {
+            return gsmOK;                       /* Everything is in buffer */
+        }
+        res = gsm_conn_send(nc->conn, nc->buff.buff, nc->buff.len, &sent, 1);
+        gsm_mem_free(nc->buff.buff);            /* Free memory */
+        nc->buff.buff = NULL;                   /* Invalidate buffer */
+        if (res != gsmOK) {
+            return res;
+        }
+    }
+
+    for (j = i; j < iovcnt; j++) {              /* Get remaining length */
+        btw += iov[j].len;
+    }
+    btw -= off;
+
+    /* Send full packets directly from vectors */
+    if (btw >= GSM_CFG_CONN_MAX_DATA_LEN) {
+        sent = btw - btw % GSM_CFG_CONN_MAX_DATA_LEN;
+        if ((res = gsmi_conn_sendv(nc->conn, &iov[i], iovcnt - i, off, sent, NULL, 1)) != gsmOK) {
+            return res;
+        }
+        btw -= sent;
+        for (off += sent; i < iovcnt && off >= iov[i].len; i++) {   /* Skip sent vectors */
+            off -= iov[i].len;
+        }
+    }
+
+    if (!btw) {                                 /* Sent everything? */
+        return gsmOK;
+    }
+
+    /* Keep remaining data in write buffer, like \ref gsm_netconn_write does */
+    nc->buff.buff = gsm_mem_pool_alloc(GSM_MEM_POOL_TX_CHUNK, GSM_MEM_TAG_NETCONN, sizeof(*nc->buff.buff) * GSM_CFG_CONN_MAX_DATA_LEN);
+    if (nc->buff.buff == NULL) {                /* No memory, send directly blocking */
+        return gsmi_conn_sendv(nc->conn, &iov[i], iovcnt - i, off, btw, NULL, 1);
+    }
+    nc->buff.len = GSM_CFG_CONN_MAX_DATA_LEN;
+    nc->buff.ptr = 0;
+    iov_copy_to_buff(nc, iov, iovcnt, &i, &off);
+    return gsmOK;
+}
+
 /**
  * \brief           Flush buffered data on netconn `TCP/SSL` connection
  * \note            This function may only be used on `TCP/SSL` connection
@@ -406,7 +825,7 @@ gsm_netconn_write(gsm_netconn_p nc, const void* data, size_t btw) {
 gsmr_t
 gsm_netconn_flush(gsm_netconn_p nc) {
     GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
-    GSM_ASSERT("nc->type must be TCP\r\n", nc->type == GSM_NETCONN_TYPE_TCP);   /* Assert input parameters */
+    GSM_ASSERT("nc->type must be TCP or SSL\r\n", nc->type != GSM_NETCONN_TYPE_UDP);    /* Assert input parameters */
     GSM_ASSERT("nc->conn must be active", gsm_conn_is_active(nc->conn));    /* Assert input parameters */
 
     /*
@@ -471,26 +890,149 @@ gsm_netconn_receive(gsm_netconn_p nc, gsm_pbuf_p* pbuf) {
     GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
     GSM_ASSERT("pbuf != NULL", pbuf != NULL);   /* Assert input parameters */
 
-    *pbuf = NULL;
 #if GSM_CFG_NETCONN_RECEIVE_TIMEOUT
     /*
      * Wait for new received data for up to specific timeout
      * or throw error for timeout notification
      */
-    if (gsm_sys_mbox_get(&nc->mbox_receive, (void **)pbuf, nc->rcv_timeout) == GSM_SYS_TIMEOUT) {
-        return gsmTIMEOUT;
-    }
+    return take_pbuf(nc, pbuf, nc->rcv_timeout, 1);
 #else /* GSM_CFG_NETCONN_RECEIVE_TIMEOUT */
     /* Forever wait for new receive packet */
-    gsm_sys_mbox_get(&nc->mbox_receive, (void **)pbuf, 0);
+    return take_pbuf(nc, pbuf, 0, 1);
 #endif /* !GSM_CFG_NETCONN_RECEIVE_TIMEOUT */
+}
 
-    /* Check if connection closed */
-    if ((uint8_t *)(*pbuf) == (uint8_t *)&recv_closed) {
-        *pbuf = NULL;                           /* Reset pbuf */
-        return gsmCLOSED;
+/**
+ * \brief           Read received data from netconn to linear memory
+ *
+ *                  Function blocks until at least one byte is available,
+ *                  then copies data from all packet buffers already in queue, without waiting for more.
+ *                  Partially read packet buffer is kept in netconn for next call
+ *
+ * \note            Do not mix this function with \ref gsm_netconn_receive on same netconn
+ * \param[in]       nc: Netconn handle used to read data
+ * \param[out]      data: Memory to copy data to
+ * \param[in]       len: Size of memory in units of bytes
+ * \param[out]      br: Pointer to output variable to save number of bytes read
+ * \param[in]       timeout: Maximal time to wait for first byte in units of milliseconds.
+ *                      Set to `0` to wait forever
+ * \return          \ref gsmOK when data were read, \ref gsmCLOSED when connection closed by remote side
+ *                  and all data were read, \ref gsmTIMEOUT when no data within timeout
+ *                  or any other member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_netconn_read(gsm_netconn_p nc, void* data, size_t len, size_t* br, uint32_t timeout) {
+    uint8_t* d = data;
+    size_t copied;
+    gsmr_t res = gsmOK;
+
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+    GSM_ASSERT("data != NULL", data != NULL);   /* Assert input parameters */
+    GSM_ASSERT("len > 0", len > 0);             /* Assert input parameters */
+    GSM_ASSERT("br != NULL", br != NULL);       /* Assert input parameters */
+
+    *br = 0;
+    while (*br < len) {
+        if (nc->rcv_pbuf == NULL) {
+            if (nc->rcv_closed) {
+                res = gsmCLOSED;
+                break;
+            }
+
+            /* Only first packet may block, others are taken only when already in queue */
+            res = take_pbuf(nc, &nc->rcv_pbuf, timeout, *br == 0);
+            if (res != gsmOK) {
+                nc->rcv_closed = res == gsmCLOSED;
+                break;
+            }
+            nc->rcv_pbuf_off = 0;
+        }
+        copied = gsm_pbuf_copy(nc->rcv_pbuf, &d[*br], len - *br, nc->rcv_pbuf_off);
+        *br += copied;
+        nc->rcv_pbuf_off += copied;
+        if (nc->rcv_pbuf_off >= gsm_pbuf_length(nc->rcv_pbuf, 1)) {
+            gsm_pbuf_free(nc->rcv_pbuf);        /* Packet fully read */
+            nc->rcv_pbuf = NULL;
+        }
     }
-    return gsmOK;                               /* We have data available */
+    return *br > 0 ? gsmOK : res;
+}
+
+/**
+ * \brief           Wait for events on multiple netconns at the same time
+ *
+ *                  Function allows single thread to service multiple connections.
+ *                  It returns as soon as at least one netconn from set has requested event.
+ *                  Events are reported in `revents` member of each entry
+ *
+ * \note            Data must be read with \ref gsm_netconn_receive or \ref gsm_netconn_read
+ *                  to clear \ref GSM_NETCONN_POLL_RECV event
+ * \note            Wakeup semaphore is shared by all netconns, a netconn should be polled by one thread at a time
+ * \param[in,out]   set: Array of netconns with events to wait for
+ * \param[in]       count: Number of entries in array
+ * \param[in]       timeout: Maximal time to wait in units of milliseconds. Set to `0` to wait forever
+ * \return          \ref gsmOK when at least one netconn is ready, \ref gsmTIMEOUT when no event within timeout
+ *                  or any other member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_netconn_poll(gsm_netconn_poll_t* set, size_t count, uint32_t timeout) {
+    size_t i, ready;
+    uint32_t time;
+
+    GSM_ASSERT("set != NULL", set != NULL);     /* Assert input parameters */
+    GSM_ASSERT("count > 0", count > 0);         /* Assert input parameters */
+
+    GSM_CORE_PROTECT();
+    if (!gsm_sys_sem_isvalid(&gsm.netconn.poll_sem) && !gsm_sys_sem_create(&gsm.netconn.poll_sem, 0)) {
+        GSM_CORE_UNPROTECT();
+        return gsmERRMEM;
+    }
+    GSM_CORE_UNPROTECT();
+
+    while (1) {
+        GSM_CORE_PROTECT();
+        ready = 0;
+        for (i = 0; i < count; ++i) {
+            gsm_netconn_p nc = set[i].nc;
+
+            set[i].revents = 0;
+            if (nc->rcv_queued > 0 || nc->rcv_pbuf != NULL) {
+                set[i].revents |= GSM_NETCONN_POLL_RECV;
+            }
+            if (nc->closed) {
+                set[i].revents |= GSM_NETCONN_POLL_CLOSED;
+            }
+            set[i].revents &= set[i].events;
+            nc->poll_wait = !set[i].revents;    /* Wake up only when something changes */
+            if (set[i].revents) {
+                ready++;
+            }
+        }
+        if (ready) {
+            for (i = 0; i < count; ++i) {
+                set[i].nc->poll_wait = 0;
+            }
+        }
+        GSM_CORE_UNPROTECT();
+        if (ready) {
+            return gsmOK;
+        }
+
+        /* Wait for event on any netconn and check set again */
+        time = gsm_sys_sem_wait(&gsm.netconn.poll_sem, timeout);
+        if (time == GSM_SYS_TIMEOUT) {
+            break;
+        }
+        if (timeout) {
+            timeout = time < timeout ? timeout - time : 1;  /* Check set once more in case of event */
+        }
+    }
+    GSM_CORE_PROTECT();
+    for (i = 0; i < count; ++i) {
+        set[i].nc->poll_wait = 0;
+    }
+    GSM_CORE_UNPROTECT();
+    return gsmTIMEOUT;
 }
 
 /**
@@ -557,4 +1099,29 @@ gsm_netconn_get_receive_timeout(gsm_netconn_p nc) {
 
 #endif /* GSM_CFG_NETCONN_RECEIVE_TIMEOUT || __DOXYGEN__ */
 
+/**
+ * \brief           Set receive window of netconn
+ *
+ *                  Stack stops reading data from device when this many bytes
+ *                  wait in netconn to be read with \ref gsm_netconn_receive
+ *
+ * \note            Function has effect only when \ref GSM_CFG_CONN_MANUAL_TCP_RECEIVE is enabled
+ * \param[in]       nc: Netconn handle
+ * \param[in]       size: Window size in units of bytes
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_netconn_set_receive_window(gsm_netconn_p nc, size_t size) {
+    GSM_ASSERT("nc != NULL", nc != NULL);       /* Assert input parameters */
+    GSM_ASSERT("size > 0", size > 0);           /* Assert input parameters */
+
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    nc->rcv_window = size;
+    if (nc->conn != NULL) {                     /* Apply to active connection */
+        gsm_conn_set_receive_window(nc->conn, size, NETCONN_RCV_WINDOW_PKTS);
+    }
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+    return gsmOK;
+}
+
 #endif /* GSM_CFG_NETCONN || __DOXYGEN__ */
@@ -33,6 +33,18 @@
 #include "gsm/apps/gsm_mqtt_client.h"
 #include "gsm/gsm_mem.h"
 #include "gsm/gsm_pbuf.h"
+#include "gsm/gsm_timeout.h"
+
+#if GSM_CFG_MQTT_V5 || __DOXYGEN__
+/**
+ * \brief           Topic alias assigned by client
+ */
+typedef struct {
+    char* topic;                                /*!< Topic copy, `NULL` when alias is not assigned */
+    uint16_t topic_len;                         /*!< Length of topic */
+    uint32_t used;                              /*!< Last use counter value, for least recently used replacement */
+} gsm_mqtt_topic_alias_t;
+#endif /* GSM_CFG_MQTT_V5 || __DOXYGEN__ */
 
 /**
  * \brief           MQTT client connection
@@ -42,7 +54,13 @@ typedef struct gsm_mqtt_client {
     const gsm_mqtt_client_info_t* info;         /*!< Connection info */
     gsm_mqtt_state_t conn_state;                /*!< MQTT connection state */
     
-    uint32_t poll_time;                         /*!< Poll time, increased every 500ms */
+    uint32_t last_activity;                     /*!< Time of last data sent or received, in units of milliseconds */
+    gsm_timeout_id_t keep_alive_timeout;        /*!< Keep-alive timeout ID */
+    uint8_t keep_alive_armed;                   /*!< Set to `1` when keep-alive timeout is running */
+#if GSM_CFG_MQTT_REQUEST_TIMEOUT || __DOXYGEN__
+    gsm_timeout_id_t req_timeout;               /*!< Request timeout ID, armed for oldest request waiting acknowledge */
+    uint8_t req_timeout_armed;                  /*!< Set to `1` when request timeout is running */
+#endif /* GSM_CFG_MQTT_REQUEST_TIMEOUT || __DOXYGEN__ */
     
     gsm_mqtt_evt_t evt;                         /*!< MQTT event callback */
     gsm_mqtt_evt_fn evt_fn;                     /*!< Event callback function */
@@ -50,12 +68,22 @@ typedef struct gsm_mqtt_client {
     gsm_buff_t tx_buff;                         /*!< Buffer for raw output data to transmit */
     
     uint8_t is_sending;                         /*!< Flag if we are sending data currently */
+#if GSM_CFG_MQTT_TX_COALESCE_DELAY || __DOXYGEN__
+    uint8_t flush_pending;                      /*!< Set to `1` when delayed send is scheduled */
+    gsm_timeout_id_t flush_timeout;             /*!< Timeout ID of delayed send */
+#endif /* GSM_CFG_MQTT_TX_COALESCE_DELAY || __DOXYGEN__ */
     uint32_t sent_total;                        /*!< Total number of bytes sent so far on connection */
     uint32_t written_total;                     /*!< Total number of bytes written into send buffer and queued for send */
     
     uint16_t last_packet_id;                    /*!< Packet ID used on last packet */
     
     gsm_mqtt_request_t requests[GSM_CFG_MQTT_MAX_REQUESTS]; /*!< List of requests */
+    gsm_mqtt_request_t* req_free;               /*!< List of free requests */
+    gsm_mqtt_request_t* req_hash[GSM_CFG_MQTT_MAX_REQUESTS];/*!< Pending requests with packet ID, hashed by packet ID */
+    gsm_mqtt_request_t* req_ack_first;          /*!< Oldest pending request waiting server acknowledge */
+    gsm_mqtt_request_t* req_ack_last;           /*!< Newest pending request waiting server acknowledge */
+    gsm_mqtt_request_t* req_sent_first;         /*!< Oldest pending request without packet ID, waiting to be sent */
+    gsm_mqtt_request_t* req_sent_last;          /*!< Newest pending request without packet ID, waiting to be sent */
     
     uint8_t* rx_buff;                           /*!< Raw RX buffer */
     size_t rx_buff_len;                         /*!< Length of raw RX buffer */
@@ -63,7 +91,31 @@ typedef struct gsm_mqtt_client {
     uint8_t parser_state;                       /*!< Incoming data parser state */
     uint8_t msg_hdr_byte;                       /*!< Incoming message header byte */
     uint32_t msg_rem_len;                       /*!< Remaining length value of current message */
-    uint32_t msg_curr_pos;                      /*!< Current buffer write pointer */
+    uint8_t msg_rem_len_shift;                  /*!< Bit position of next remaining length digit */
+    uint32_t msg_curr_pos;                      /*!< Number of received bytes of remaining part of message */
+    size_t msg_buff_pos;                        /*!< Current RX buffer write pointer */
+    size_t msg_hdr_len;                         /*!< Length of publish variable header kept in RX buffer while payload is streamed */
+    size_t msg_payload_off;                     /*!< Offset of payload already delivered to user in partial events */
+    uint8_t msg_skip;                           /*!< Set to `1` when message does not fit to RX buffer and is ignored */
+    uint32_t msg_skip_id_pos;                   /*!< Position of packet ID in ignored publish message, `0` if not used */
+    uint16_t msg_skip_pkt_id;                   /*!< Packet ID of ignored publish message, collected while skipping it */
+    const uint8_t* msg_data;                    /*!< Data of message being processed, either RX buffer or received packet buffer memory */
+    gsm_pbuf_p msg_pbuf;                        /*!< Packet buffer when `msg_data` points to its memory, `NULL` otherwise */
+
+#if GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+    gsm_mqtt_client_queue_t* queue;             /*!< Offline publish queue, `NULL` when not used */
+    size_t queue_send_pos;                      /*!< Ring position of next entry to send */
+    size_t queue_inflight;                      /*!< Number of ring bytes sent and waiting for server acknowledge */
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
+#if GSM_CFG_MQTT_V5 || __DOXYGEN__
+    uint8_t v5;                                 /*!< Set to `1` when connection uses MQTT 5.0 */
+    uint16_t alias_max;                         /*!< Topic alias maximum received from server */
+    uint32_t alias_tick;                        /*!< Topic alias use counter */
+#if GSM_CFG_MQTT_TOPIC_ALIAS_MAX || __DOXYGEN__
+    gsm_mqtt_topic_alias_t aliases[GSM_CFG_MQTT_TOPIC_ALIAS_MAX];   /*!< Topic aliases, alias value is index + 1 */
+#endif /* GSM_CFG_MQTT_TOPIC_ALIAS_MAX || __DOXYGEN__ */
+#endif /* GSM_CFG_MQTT_V5 || __DOXYGEN__ */
 
     void* arg;                                  /*!< User argument */
 } gsm_mqtt_client_t;
@@ -75,6 +127,9 @@ typedef struct gsm_mqtt_client {
 
 static gsmr_t   mqtt_conn_cb(gsm_evt_t* evt);
 static void     send_data(gsm_mqtt_client_p client);
+#if GSM_CFG_MQTT_REQUEST_TIMEOUT
+static void     mqtt_request_timeout_start(gsm_mqtt_client_p client, uint32_t time);
+#endif /* GSM_CFG_MQTT_REQUEST_TIMEOUT */
 
 /**
  * \brief           List of MQTT message types
@@ -108,6 +163,9 @@ typedef enum {
 #define MQTT_PARSER_STATE_CALC_REM_LEN  0x01    /*!< MQTT parser in calculating remaining length state */
 #define MQTT_PARSER_STATE_READ_REM      0x02    /*!< MQTT parser in reading remaining bytes state */
 
+/* Remaining length uses up to 4 bytes, 7 bits each */
+#define MQTT_REM_LEN_MAX_SHIFT          21      /*!< Bit position of last allowed remaining length digit */
+
 /* Get packet type from incoming byte */
 #define MQTT_RCV_GET_PACKET_TYPE(d)     ((mqtt_msg_type_t)(((d) >> 0x04) & 0x0F))
 #define MQTT_RCV_GET_PACKET_QOS(d)      ((gsm_mqtt_qos_t)(((d) >> 0x01) & 0x03))
@@ -118,6 +176,21 @@ typedef enum {
 #define MQTT_REQUEST_FLAG_PENDING       0x02    /*!< Request object is pending waiting for rgsmonse from server */
 #define MQTT_REQUEST_FLAG_SUBSCRIBE     0x04    /*!< Request object has subscribe type */
 #define MQTT_REQUEST_FLAG_UNSUBSCRIBE   0x08    /*!< Request object has unsubscribe type */
+#define MQTT_REQUEST_FLAG_QUEUED        0x10    /*!< Request object sends entry from offline queue */
+
+/* MQTT 5.0 property identifiers */
+#define MQTT_PROP_TOPIC_ALIAS_MAXIMUM   0x22    /*!< Maximal topic alias value accepted by receiver */
+#define MQTT_PROP_TOPIC_ALIAS           0x23    /*!< Topic alias used instead of topic name */
+
+/* Check if connection uses MQTT 5.0 */
+#if GSM_CFG_MQTT_V5
+#define MQTT_IS_V5(client)              ((client)->v5)
+#else
+#define MQTT_IS_V5(client)              0
+#endif /* GSM_CFG_MQTT_V5 */
+
+/* Offline queue entry header: topic length (2), payload length (2), QoS (1), retain (1) */
+#define MQTT_QUEUE_HDR_LEN              6
 
 #if GSM_CFG_DBG
 
@@ -164,6 +237,25 @@ create_packet_id(gsm_mqtt_client_p client) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 
+/**
+ * \brief           Reset all requests and put them to free list
+ * \param[in]       client: MQTT client
+ */
+static void
+request_init(gsm_mqtt_client_p client) {
+    size_t i;
+
+    GSM_MEMSET(client->requests, 0x00, sizeof(client->requests));
+    GSM_MEMSET(client->req_hash, 0x00, sizeof(client->req_hash));
+    client->req_ack_first = client->req_ack_last = NULL;
+    client->req_sent_first = client->req_sent_last = NULL;
+    client->req_free = NULL;
+    for (i = GSM_CFG_MQTT_MAX_REQUESTS; i > 0; i--) {
+        client->requests[i - 1].next = client->req_free;
+        client->req_free = &client->requests[i - 1];
+    }
+}
+
 /**
  * \brief           Create and return new request object
  * \param[in]       client: MQTT client
@@ -174,16 +266,11 @@ create_packet_id(gsm_mqtt_client_p client) {
 static gsm_mqtt_request_t *
 request_create(gsm_mqtt_client_p client, uint16_t packet_id, void* arg) {
     gsm_mqtt_request_t* request;
-    uint16_t i;
     
-    /* Try to find a new request which does not have IN_USE flag set */
-    for (request = NULL, i = 0; i < GSM_CFG_MQTT_MAX_REQUESTS; i++) {
-        if ((client->requests[i].status & MQTT_REQUEST_FLAG_IN_USE) == 0) {
-            request = &client->requests[i];     /* We have empty request */
-            break;
-        }
-    }
+    request = client->req_free;                 /* Take first free request */
     if (request != NULL) {
+        client->req_free = request->next;
+        request->next = NULL;
         request->packet_id = packet_id;         /* Set request packet ID */
         request->arg = arg;                     /* Set user argument */
         request->status = MQTT_REQUEST_FLAG_IN_USE; /* Reset everything at this point */
@@ -198,36 +285,109 @@ request_create(gsm_mqtt_client_p client, uint16_t packet_id, void* arg) {
  */
 static void
 request_delete(gsm_mqtt_client_p client, gsm_mqtt_request_t* request) {
+    if (request->status & MQTT_REQUEST_FLAG_PENDING) {
+        gsm_mqtt_request_t **first, **last, **r;
+
+        /* Remove from ordered list */
+        if (request->packet_id) {
+            first = &client->req_ack_first;
+            last = &client->req_ack_last;
+        } else {
+            first = &client->req_sent_first;
+            last = &client->req_sent_last;
+        }
+        if (request->list_prev != NULL) {
+            request->list_prev->list_next = request->list_next;
+        } else {
+            *first = request->list_next;
+        }
+        if (request->list_next != NULL) {
+            request->list_next->list_prev = request->list_prev;
+        } else {
+            *last = request->list_prev;
+        }
+        request->list_prev = request->list_next = NULL;
+
+        /* Remove from packet ID hash chain */
+        if (request->packet_id) {
+            for (r = &client->req_hash[request->packet_id % GSM_CFG_MQTT_MAX_REQUESTS]; *r != NULL; r = &(*r)->next) {
+                if (*r == request) {
+                    *r = request->next;
+                    break;
+                }
+            }
+        }
+    }
     request->status = 0;                        /* Reset status to make request unused */
+    request->next = client->req_free;           /* Return it to free list */
+    client->req_free = request;
 }
 
 /**
  * \brief           Set request as pending waiting for server reply
+ *
+ *                  Requests with packet ID wait for server acknowledge and are found by packet ID,
+ *                  requests without packet ID wait to be sent. Both lists are kept in order of creation
+ *
  * \param[in]       client: MQTT client
  * \param[in]       request: Request object to delete
  */
 static void
 request_set_pending(gsm_mqtt_client_p client, gsm_mqtt_request_t* request) {
+    gsm_mqtt_request_t **first, **last;
+
     request->timeout_start_time = gsm_sys_now();/* Set timeout start time */
     request->status |= MQTT_REQUEST_FLAG_PENDING;   /* Set pending flag */
+
+    if (request->packet_id) {
+        size_t idx = request->packet_id % GSM_CFG_MQTT_MAX_REQUESTS;
+        request->next = client->req_hash[idx];  /* Add to hash chain */
+        client->req_hash[idx] = request;
+        first = &client->req_ack_first;
+        last = &client->req_ack_last;
+#if GSM_CFG_MQTT_REQUEST_TIMEOUT
+        if (!client->req_timeout_armed) {       /* Start timeout for first request */
+            mqtt_request_timeout_start(client, GSM_CFG_MQTT_REQUEST_TIMEOUT);
+        }
+#endif /* GSM_CFG_MQTT_REQUEST_TIMEOUT */
+    } else {
+        first = &client->req_sent_first;
+        last = &client->req_sent_last;
+    }
+    request->list_next = NULL;                  /* Add to the end of ordered list */
+    request->list_prev = *last;
+    if (*last != NULL) {
+        (*last)->list_next = request;
+    } else {
+        *first = request;
+    }
+    *last = request;
 }
 
 /**
  * \brief           Get pending request by specific packet ID
+ *
+ *                  Packet IDs are created sequentially, which spreads requests in flight
+ *                  evenly over hash chains
+ *
  * \param[in]       client: MQTT client
  * \param[in]       pkt_id: Packet id to get request for. Use `-1` to get first pending request
+ *                      or `0` to get oldest pending request without packet ID
  * \return          Request on success, `NULL` otherwise
  */
 static gsm_mqtt_request_t *
 request_get_pending(gsm_mqtt_client_p client, int32_t pkt_id) {
-    /* Try to find a new request which does not have IN_USE flag set */
-    for (size_t i = 0; i < GSM_CFG_MQTT_MAX_REQUESTS; i++) {
-        if ((client->requests[i].status & MQTT_REQUEST_FLAG_PENDING)
-            && (
-                pkt_id == -1 
-                || client->requests[i].packet_id == (uint16_t)pkt_id
-                )) {
-            return &client->requests[i];
+    gsm_mqtt_request_t* request;
+
+    if (pkt_id == -1) {
+        return client->req_ack_first != NULL ? client->req_ack_first : client->req_sent_first;
+    } else if (pkt_id == 0) {
+        return client->req_sent_first;
+    }
+    for (request = client->req_hash[(uint16_t)pkt_id % GSM_CFG_MQTT_MAX_REQUESTS];
+        request != NULL; request = request->next) {
+        if (request->packet_id == (uint16_t)pkt_id) {
+            return request;
         }
     }
     return NULL;
@@ -241,6 +401,9 @@ request_get_pending(gsm_mqtt_client_p client, int32_t pkt_id) {
  */
 static void
 request_send_err_callback(gsm_mqtt_client_p client, uint8_t status, void* arg) {
+    if (status & MQTT_REQUEST_FLAG_QUEUED) {    /* Entry stays in offline queue and is sent again */
+        return;
+    }
     if (status & MQTT_REQUEST_FLAG_SUBSCRIBE) {
         client->evt.type = GSM_MQTT_EVT_SUBSCRIBE;
     } else if (status & MQTT_REQUEST_FLAG_UNSUBSCRIBE) {
@@ -259,6 +422,54 @@ request_send_err_callback(gsm_mqtt_client_p client, uint8_t status, void* arg) {
     client->evt_fn(client, &client->evt);
 }
 
+#if GSM_CFG_MQTT_REQUEST_TIMEOUT || __DOXYGEN__
+
+/**
+ * \brief           Request timeout callback
+ *
+ *                  Requests waiting acknowledge are ordered by start time,
+ *                  only oldest requests are checked and timeout is started again for next one
+ *
+ * \param[in]       arg: MQTT client
+ */
+static void
+mqtt_request_timeout_fn(void* arg) {
+    gsm_mqtt_client_p client = arg;
+    gsm_mqtt_request_t* request;
+    uint32_t now = gsm_sys_now();
+
+    client->req_timeout_armed = 0;
+    while ((request = client->req_ack_first) != NULL
+        && (now - request->timeout_start_time) >= GSM_CFG_MQTT_REQUEST_TIMEOUT) {
+        uint8_t status = request->status;
+        void* req_arg = request->arg;
+
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING,
+            "[MQTT] Request with pkt_id %d timeout\r\n", (int)request->packet_id);
+        request_delete(client, request);        /* Delete request */
+        request_send_err_callback(client, status, req_arg); /* Send error callback to user */
+    }
+    if ((request = client->req_ack_first) != NULL && !client->req_timeout_armed) {
+        mqtt_request_timeout_start(client, GSM_CFG_MQTT_REQUEST_TIMEOUT - (now - request->timeout_start_time));
+    }
+}
+
+/**
+ * \brief           Start request timeout
+ * \param[in]       client: MQTT client
+ * \param[in]       time: Time until oldest request expires, in units of milliseconds
+ */
+static void
+mqtt_request_timeout_start(gsm_mqtt_client_p client, uint32_t time) {
+    if (gsm_timeout_start(time, mqtt_request_timeout_fn, client, &client->req_timeout) == gsmOK) {
+        client->req_timeout_armed = 1;
+    } else {
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING, "[MQTT] Cannot start request timeout\r\n");
+    }
+}
+
+#endif /* GSM_CFG_MQTT_REQUEST_TIMEOUT || __DOXYGEN__ */
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /* MQTT buffer helper functions                                                                       */
@@ -393,6 +604,12 @@ send_data(gsm_mqtt_client_p client) {
     const void* addr;
     size_t len;
     
+#if GSM_CFG_MQTT_TX_COALESCE_DELAY
+    if (client->flush_pending) {                /* Data are sent now, cancel delayed send */
+        gsm_timeout_stop(client->flush_timeout);
+        client->flush_pending = 0;
+    }
+#endif /* GSM_CFG_MQTT_TX_COALESCE_DELAY */
     if (client->is_sending) {                   /* We are currently sending data */
         return;
     }
@@ -407,6 +624,459 @@ send_data(gsm_mqtt_client_p client) {
     }
 }
 
+#if GSM_CFG_MQTT_TX_COALESCE_DELAY || __DOXYGEN__
+
+/**
+ * \brief           Delayed send timeout callback
+ * \param[in]       arg: MQTT client
+ */
+static void
+mqtt_flush_timeout_fn(void* arg) {
+    gsm_mqtt_client_p client = arg;
+
+    client->flush_pending = 0;
+    send_data(client);
+}
+
+#endif /* GSM_CFG_MQTT_TX_COALESCE_DELAY || __DOXYGEN__ */
+
+/**
+ * \brief           Send data to the remote or schedule delayed send to collect more packets
+ * \param[in]       client: MQTT client
+ */
+static void
+send_data_coalesce(gsm_mqtt_client_p client) {
+#if GSM_CFG_MQTT_TX_COALESCE_DELAY
+    if (gsm_buff_get_full(&client->tx_buff) < GSM_CFG_MQTT_TX_COALESCE_MAX_BYTES) {
+        if (!client->flush_pending
+            && gsm_timeout_start(GSM_CFG_MQTT_TX_COALESCE_DELAY, mqtt_flush_timeout_fn, client, &client->flush_timeout) == gsmOK) {
+            client->flush_pending = 1;
+        }
+        if (client->flush_pending) {
+            return;                             /* Wait more packets */
+        }
+    }
+#endif /* GSM_CFG_MQTT_TX_COALESCE_DELAY */
+    send_data(client);
+}
+
+#if GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Write data to offline queue ring, wrapping at the end of ring
+ * \param[in]       q: Offline queue
+ * \param[in]       pos: Ring position to write to
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \return          Ring position after written data or `q->size` on storage error
+ */
+static size_t
+queue_write(gsm_mqtt_client_queue_t* q, size_t pos, const void* data, size_t len) {
+    const uint8_t* d = data;
+    size_t chunk;
+
+    while (len > 0) {
+        chunk = GSM_MIN(len, q->size - pos);    /* Write up to end of ring */
+        if (q->write_fn != NULL) {
+            if (!q->write_fn(q->arg, pos, d, chunk)) {
+                return q->size;
+            }
+        } else {
+            GSM_MEMCPY(&q->mem[pos], d, chunk);
+        }
+        d += chunk;
+        len -= chunk;
+        pos = (pos + chunk) % q->size;
+    }
+    return pos;
+}
+
+/**
+ * \brief           Read data from offline queue ring, wrapping at the end of ring
+ * \param[in]       q: Offline queue
+ * \param[in]       pos: Ring position to read from
+ * \param[out]      data: Memory to read data to
+ * \param[in]       len: Number of bytes to read
+ * \return          Ring position after read data or `q->size` on storage error
+ */
+static size_t
+queue_read(gsm_mqtt_client_queue_t* q, size_t pos, void* data, size_t len) {
+    uint8_t* d = data;
+    size_t chunk;
+
+    while (len > 0) {
+        chunk = GSM_MIN(len, q->size - pos);    /* Read up to end of ring */
+        if (q->write_fn != NULL) {
+            if (!q->read_fn(q->arg, pos, d, chunk)) {
+                return q->size;
+            }
+        } else {
+            GSM_MEMCPY(d, &q->mem[pos], chunk);
+        }
+        d += chunk;
+        len -= chunk;
+        pos = (pos + chunk) % q->size;
+    }
+    return pos;
+}
+
+/**
+ * \brief           Copy data from offline queue ring to output buffer
+ * \param[in]       client: MQTT client
+ * \param[in]       pos: Ring position to copy from
+ * \param[in]       len: Number of bytes to copy
+ * \return          Ring position after copied data or `q->size` on storage error
+ */
+static size_t
+queue_copy_to_output(gsm_mqtt_client_p client, size_t pos, size_t len) {
+    gsm_mqtt_client_queue_t* q = client->queue;
+    uint8_t tmp[32];
+    size_t chunk;
+
+    if (q->write_fn == NULL) {                  /* RAM ring, write directly up to 2 times */
+        while (len > 0) {
+            chunk = GSM_MIN(len, q->size - pos);
+            write_data(client, &q->mem[pos], chunk);
+            len -= chunk;
+            pos = (pos + chunk) % q->size;
+        }
+        return pos;
+    }
+    while (len > 0 && pos < q->size) {          /* Read storage in small chunks */
+        chunk = GSM_MIN(len, sizeof(tmp));
+        pos = queue_read(q, pos, tmp, chunk);
+        write_data(client, tmp, chunk);
+        len -= chunk;
+    }
+    return pos;
+}
+
+/**
+ * \brief           Store publish packet to offline queue
+ * \note            Function must be called with core locked
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic to send message to
+ * \param[in]       topic_len: Length of topic
+ * \param[in]       payload: Message data
+ * \param[in]       payload_len: Length of payload data
+ * \param[in]       qos: Quality of service
+ * \param[in]       retain: Retain parameter value
+ * \return          \ref gsmINPROG when stored to queue, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+queue_put(gsm_mqtt_client_p client, const char* topic, uint16_t topic_len,
+            const void* payload, uint16_t payload_len, uint8_t qos, uint8_t retain) {
+    gsm_mqtt_client_queue_t* q = client->queue;
+    uint8_t hdr[MQTT_QUEUE_HDR_LEN];
+    size_t pos, len;
+
+    len = MQTT_QUEUE_HDR_LEN + topic_len + payload_len;
+    if (q->size - q->used < len) {
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING, "[MQTT] Offline queue is full\r\n");
+        return gsmERRMEM;
+    }
+    hdr[0] = GSM_U8(topic_len >> 8);
+    hdr[1] = GSM_U8(topic_len & 0xFF);
+    hdr[2] = GSM_U8(payload_len >> 8);
+    hdr[3] = GSM_U8(payload_len & 0xFF);
+    hdr[4] = qos;
+    hdr[5] = retain;
+
+    pos = queue_write(q, q->w, hdr, sizeof(hdr));
+    if (pos < q->size) {
+        pos = queue_write(q, pos, topic, topic_len);
+    }
+    if (pos < q->size && payload_len > 0) {
+        pos = queue_write(q, pos, payload, payload_len);
+    }
+    if (pos >= q->size) {
+        return gsmERR;
+    }
+    q->w = pos;                                 /* Commit entry only when fully written */
+    q->used += len;
+    return gsmINPROG;
+}
+
+/**
+ * \brief           Send entries from offline queue to server
+ *
+ *                  As many entries as allowed by free requests and output buffer
+ *                  are written and sent together, to keep acknowledge window full
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+queue_send(gsm_mqtt_client_p client) {
+    gsm_mqtt_client_queue_t* q = client->queue;
+    gsm_mqtt_request_t* request;
+    uint8_t hdr[MQTT_QUEUE_HDR_LEN];
+    uint16_t topic_len, payload_len, rem_len, raw_len, pkt_id;
+    size_t pos, len;
+    uint8_t written = 0;
+
+    if (q == NULL || client->conn_state != GSM_MQTT_CONNECTED) {
+        return;
+    }
+    while (q->used > client->queue_inflight && client->req_free != NULL) {
+        if ((pos = queue_read(q, client->queue_send_pos, hdr, sizeof(hdr))) >= q->size) {
+            break;
+        }
+        topic_len = GSM_U16(hdr[0] << 8 | hdr[1]);
+        payload_len = GSM_U16(hdr[2] << 8 | hdr[3]);
+        len = MQTT_QUEUE_HDR_LEN + topic_len + payload_len;
+
+        rem_len = 2 + topic_len + 2 + payload_len;  /* Topic with length, packet ID and payload */
+        if (MQTT_IS_V5(client)) {
+            rem_len++;                          /* Empty properties */
+        }
+        if ((raw_len = output_check_enough_memory(client, rem_len)) == 0) {
+            break;                              /* Continue after data are sent */
+        }
+        pkt_id = create_packet_id(client);
+        request = request_create(client, pkt_id, NULL);
+        request->status |= MQTT_REQUEST_FLAG_QUEUED;
+        request->queue_len = len;
+        request->expected_sent_len = client->written_total + raw_len;
+
+        write_fixed_header(client, MQTT_MSG_TYPE_PUBLISH, 0, (gsm_mqtt_qos_t)GSM_MIN(hdr[4], GSM_U8(GSM_MQTT_QOS_EXACTLY_ONCE)), hdr[5], rem_len);
+        write_u16(client, topic_len);
+        pos = queue_copy_to_output(client, pos, topic_len);
+        write_u16(client, pkt_id);
+        if (MQTT_IS_V5(client)) {
+            write_u8(client, 0);                /* No properties */
+        }
+        pos = queue_copy_to_output(client, pos, payload_len);
+        request_set_pending(client, request);
+
+        client->queue_send_pos = (client->queue_send_pos + len) % q->size;
+        client->queue_inflight += len;
+        written = 1;
+
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE,
+            "[MQTT] Pkt publish from offline queue. pkt_id: %d\r\n", (int)pkt_id);
+    }
+    if (written) {
+        send_data(client);                      /* Send all entries together */
+    }
+}
+
+/**
+ * \brief           Release offline queue entry acknowledged by server
+ * \param[in]       client: MQTT client
+ * \param[in]       len: Size of acknowledged entry
+ */
+static void
+queue_release(gsm_mqtt_client_p client, size_t len) {
+    gsm_mqtt_client_queue_t* q = client->queue;
+
+    if (q != NULL && len <= client->queue_inflight) {
+        q->r = (q->r + len) % q->size;
+        q->used -= len;
+        client->queue_inflight -= len;
+    }
+}
+
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
+#if GSM_CFG_MQTT_V5 || __DOXYGEN__
+
+/**
+ * \brief           Decode variable byte integer
+ * \param[in]       d: Encoded data
+ * \param[in]       len: Number of available bytes
+ * \param[out]      val: Output variable to save decoded value to
+ * \return          Number of used bytes or `0` on invalid or incomplete value
+ */
+static size_t
+mqtt_varint_decode(const uint8_t* d, size_t len, uint32_t* val) {
+    size_t i;
+
+    *val = 0;
+    for (i = 0; i < len && i < 4; ++i) {
+        *val |= GSM_U32(d[i] & 0x7F) << (7 * i);
+        if (!(d[i] & 0x80)) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Get length of single property, including identifier
+ * \param[in]       p: Property data
+ * \param[in]       len: Number of available bytes
+ * \return          Length of property or `0` on unknown or incomplete property
+ */
+static size_t
+mqtt_prop_len(const uint8_t* p, size_t len) {
+    size_t l, n;
+    uint32_t v;
+
+    switch (p[0]) {
+        case 0x01: case 0x17: case 0x19: case 0x24:
+        case 0x25: case 0x28: case 0x29: case 0x2A:
+            l = 2; break;                       /* Byte */
+        case 0x13: case 0x21: case 0x22: case 0x23:
+            l = 3; break;                       /* Two byte integer */
+        case 0x02: case 0x11: case 0x18: case 0x27:
+            l = 5; break;                       /* Four byte integer */
+        case 0x0B:                              /* Variable byte integer */
+            n = mqtt_varint_decode(&p[1], len - 1, &v);
+            l = n > 0 ? 1 + n : 0;
+            break;
+        case 0x03: case 0x08: case 0x09: case 0x12: case 0x15:
+        case 0x16: case 0x1A: case 0x1C: case 0x1F:
+            l = len >= 3 ? 3 + (p[1] << 8 | p[2]) : 0;  /* String or binary data */
+            break;
+        case 0x26:                              /* String pair */
+            l = len >= 3 ? 3 + (p[1] << 8 | p[2]) : 0;
+            l = l > 0 && len >= l + 2 ? l + 2 + (p[l] << 8 | p[l + 1]) : 0;
+            break;
+        default:
+            l = 0; break;
+    }
+    return l <= len ? l : 0;
+}
+
+/**
+ * \brief           Skip properties of received packet
+ * \param[in]       d: Properties, starting with properties length
+ * \param[in]       len: Number of available bytes
+ * \return          Number of bytes used by properties or `0` on invalid value
+ */
+static size_t
+mqtt_props_skip(const uint8_t* d, size_t len) {
+    uint32_t props_len;
+    size_t n = mqtt_varint_decode(d, len, &props_len);
+
+    return n > 0 && n + props_len <= len ? n + props_len : 0;
+}
+
+/**
+ * \brief           Process CONNACK properties
+ * \param[in]       client: MQTT client
+ * \param[in]       d: Properties, starting with properties length
+ * \param[in]       len: Number of available bytes
+ */
+static void
+mqtt_connack_props(gsm_mqtt_client_p client, const uint8_t* d, size_t len) {
+    uint32_t props_len;
+    size_t n, l;
+
+    if ((n = mqtt_varint_decode(d, len, &props_len)) == 0 || n + props_len > len) {
+        return;
+    }
+    for (d += n; props_len > 0; d += l, props_len -= l) {
+        if ((l = mqtt_prop_len(d, props_len)) == 0) {
+            break;
+        }
+        if (d[0] == MQTT_PROP_TOPIC_ALIAS_MAXIMUM) {
+            client->alias_max = GSM_U16(d[1] << 8 | d[2]);
+        }
+    }
+}
+
+/**
+ * \brief           Free all topic aliases
+ * \param[in]       client: MQTT client
+ */
+static void
+topic_alias_reset(gsm_mqtt_client_p client) {
+#if GSM_CFG_MQTT_TOPIC_ALIAS_MAX
+    for (size_t i = 0; i < GSM_CFG_MQTT_TOPIC_ALIAS_MAX; ++i) {
+        if (client->aliases[i].topic != NULL) {
+            gsm_mem_free(client->aliases[i].topic);
+        }
+    }
+    GSM_MEMSET(client->aliases, 0x00, sizeof(client->aliases));
+#endif /* GSM_CFG_MQTT_TOPIC_ALIAS_MAX */
+    client->alias_max = 0;
+    client->alias_tick = 0;
+}
+
+/**
+ * \brief           Find topic alias already assigned to topic
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic name
+ * \param[in]       topic_len: Length of topic
+ * \return          Alias value or `0` if topic has no alias
+ */
+static uint16_t
+topic_alias_find(gsm_mqtt_client_p client, const char* topic, uint16_t topic_len) {
+#if GSM_CFG_MQTT_TOPIC_ALIAS_MAX
+    size_t cnt = GSM_MIN(GSM_CFG_MQTT_TOPIC_ALIAS_MAX, client->alias_max);
+
+    for (size_t i = 0; i < cnt; ++i) {
+        if (client->aliases[i].topic != NULL && client->aliases[i].topic_len == topic_len
+            && !strncmp(client->aliases[i].topic, topic, topic_len)) {
+            client->aliases[i].used = ++client->alias_tick;
+            return GSM_U16(i + 1);
+        }
+    }
+#endif /* GSM_CFG_MQTT_TOPIC_ALIAS_MAX */
+    return 0;
+}
+
+/**
+ * \brief           Assign topic alias to topic, replacing least recently used alias
+ * \param[in]       client: MQTT client
+ * \param[in]       topic: Topic name
+ * \param[in]       topic_len: Length of topic
+ * \return          Alias value or `0` if alias cannot be assigned
+ */
+static uint16_t
+topic_alias_assign(gsm_mqtt_client_p client, const char* topic, uint16_t topic_len) {
+#if GSM_CFG_MQTT_TOPIC_ALIAS_MAX
+    size_t cnt = GSM_MIN(GSM_CFG_MQTT_TOPIC_ALIAS_MAX, client->alias_max), i, lru = 0;
+    char* t;
+
+    if (cnt == 0) {
+        return 0;
+    }
+    for (i = 0; i < cnt; ++i) {                 /* Find free or least recently used alias */
+        if (client->aliases[i].topic == NULL) {
+            lru = i;
+            break;
+        }
+        if (client->aliases[i].used < client->aliases[lru].used) {
+            lru = i;
+        }
+    }
+    if ((t = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, topic_len)) == NULL) {
+        return 0;
+    }
+    if (client->aliases[lru].topic != NULL) {
+        gsm_mem_free(client->aliases[lru].topic);
+    }
+    GSM_MEMCPY(t, topic, topic_len);
+    client->aliases[lru].topic = t;
+    client->aliases[lru].topic_len = topic_len;
+    client->aliases[lru].used = ++client->alias_tick;
+    return GSM_U16(lru + 1);
+#else
+    return 0;
+#endif /* GSM_CFG_MQTT_TOPIC_ALIAS_MAX */
+}
+
+/**
+ * \brief           Remove topic from alias table
+ * \param[in]       client: MQTT client
+ * \param[in]       alias: Alias value to remove
+ */
+static void
+topic_alias_drop(gsm_mqtt_client_p client, uint16_t alias) {
+#if GSM_CFG_MQTT_TOPIC_ALIAS_MAX
+    gsm_mqtt_topic_alias_t* a = &client->aliases[alias - 1];
+
+    if (a->topic != NULL) {
+        gsm_mem_free(a->topic);
+    }
+    GSM_MEMSET(a, 0x00, sizeof(*a));
+#endif /* GSM_CFG_MQTT_TOPIC_ALIAS_MAX */
+}
+
+#endif /* GSM_CFG_MQTT_V5 || __DOXYGEN__ */
+
 /**
  * \brief           Close a MQTT connection with server
  * \param[in]       client: MQTT client
@@ -455,6 +1125,9 @@ sub_unsub(gsm_mqtt_client_p client, const char* topic, gsm_mqtt_qos_t qos, void*
     if (sub) {
         rem_len++;
     }
+    if (MQTT_IS_V5(client)) {
+        rem_len++;                              /* Empty properties */
+    }
     
     gsm_core_lock();                            /* Lock core */
     if (client->conn_state == GSM_MQTT_CONNECTED && 
@@ -464,6 +1137,9 @@ sub_unsub(gsm_mqtt_client_p client, const char* topic, gsm_mqtt_qos_t qos, void*
         if (request != NULL) {                  /* Do we have a request */
             write_fixed_header(client, sub ? MQTT_MSG_TYPE_SUBSCRIBE : MQTT_MSG_TYPE_UNSUBSCRIBE, 0, (gsm_mqtt_qos_t)1, 0, rem_len);
             write_u16(client, pkt_id);          /* Write packet ID */
+            if (MQTT_IS_V5(client)) {
+                write_u8(client, 0);            /* No properties */
+            }
             write_string(client, topic, len_topic); /* Write topic string to packet */
             if (sub) {                          /* Send quality of service only on subscribe */
                 write_u8(client, GSM_MIN(GSM_U8(qos), GSM_U8(GSM_MQTT_QOS_EXACTLY_ONCE)));  /* Write quality of service */
@@ -479,6 +1155,122 @@ sub_unsub(gsm_mqtt_client_p client, const char* topic, gsm_mqtt_qos_t qos, void*
     return ret;
 }
 
+/**
+ * \brief           Send publish received event to user for data in RX buffer
+ *
+ *                  Variable header (topic and optional packet ID) is at the beginning of RX buffer,
+ *                  followed by payload part received since last event
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       hdr_len: Length of variable header in RX buffer
+ */
+static void
+mqtt_publish_recv_evt(gsm_mqtt_client_p client, size_t hdr_len) {
+    client->evt.type = GSM_MQTT_EVT_PUBLISH_RECV;
+    client->evt.evt.publish_recv.topic = &client->msg_data[2];
+    client->evt.evt.publish_recv.topic_len = client->msg_data[0] << 8 | client->msg_data[1];
+    client->evt.evt.publish_recv.payload = &client->msg_data[hdr_len];
+    client->evt.evt.publish_recv.payload_len = client->msg_buff_pos - hdr_len;
+    client->evt.evt.publish_recv.payload_offset = client->msg_payload_off;
+    client->evt.evt.publish_recv.payload_total = client->msg_rem_len - hdr_len;
+    client->evt.evt.publish_recv.pbuf = client->msg_pbuf;
+    client->evt.evt.publish_recv.dup = MQTT_RCV_GET_PACKET_DUP(client->msg_hdr_byte);
+    client->evt.evt.publish_recv.qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte);
+    client->evt.evt.publish_recv.res = gsmOK;
+    client->evt_fn(client, &client->evt);
+}
+
+/**
+ * \brief           Process end of message which did not fit to RX buffer
+ *
+ *                  Ignored publish packet with QoS > 0 is acknowledged to server
+ *                  so its delivery does not stay pending, and user is notified with error result
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+mqtt_process_skipped_message(gsm_mqtt_client_p client) {
+    uint8_t qos;
+
+    if (MQTT_RCV_GET_PACKET_TYPE(client->msg_hdr_byte) != MQTT_MSG_TYPE_PUBLISH) {
+        return;
+    }
+    qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte);
+    if (qos > 0 && client->msg_skip_id_pos > 0) {
+        mqtt_msg_type_t rgsm_msg_type = qos == 1 ? MQTT_MSG_TYPE_PUBACK : MQTT_MSG_TYPE_PUBREC;
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] Sending publish rgsm: %s on ignored pkt_id: %d\r\n", \
+                    mqtt_msg_type_to_str(rgsm_msg_type), (int)client->msg_skip_pkt_id);
+
+        write_ack_rec_rel_rgsm(client, rgsm_msg_type, client->msg_skip_pkt_id, (gsm_mqtt_qos_t)qos);
+    }
+
+    /* Notify application layer about dropped packet */
+    client->evt.type = GSM_MQTT_EVT_PUBLISH_RECV;
+    client->evt.evt.publish_recv.topic = NULL;
+    client->evt.evt.publish_recv.topic_len = 0;
+    client->evt.evt.publish_recv.payload = NULL;
+    client->evt.evt.publish_recv.payload_len = 0;
+    client->evt.evt.publish_recv.payload_offset = 0;
+    client->evt.evt.publish_recv.payload_total = client->msg_rem_len;
+    client->evt.evt.publish_recv.pbuf = NULL;
+    client->evt.evt.publish_recv.dup = MQTT_RCV_GET_PACKET_DUP(client->msg_hdr_byte);
+    client->evt.evt.publish_recv.qos = (gsm_mqtt_qos_t)qos;
+    client->evt.evt.publish_recv.res = gsmERRMEM;
+    client->evt_fn(client, &client->evt);
+}
+
+/**
+ * \brief           Process RX buffer when it is full and message is not yet received completely
+ *
+ *                  Publish payload is delivered to user in partial events,
+ *                  variable header stays in buffer and remaining space is reused for next part.
+ *                  Other messages are ignored
+ *
+ * \param[in]       client: MQTT client
+ */
+static void
+mqtt_process_incoming_part(gsm_mqtt_client_p client) {
+    if (client->msg_hdr_len == 0) {             /* First part of message */
+        size_t hdr_len = 0;
+
+        if (MQTT_RCV_GET_PACKET_TYPE(client->msg_hdr_byte) == MQTT_MSG_TYPE_PUBLISH && client->rx_buff_len > 2) {
+            hdr_len = 2 + (client->msg_data[0] << 8 | client->msg_data[1]);   /* Topic with length */
+            if (MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte) > 0) {
+                hdr_len += 2;                   /* Packet ID */
+            }
+#if GSM_CFG_MQTT_V5
+            if (client->v5 && hdr_len < client->rx_buff_len) {
+                size_t props_len = mqtt_props_skip(&client->msg_data[hdr_len], client->rx_buff_len - hdr_len);
+                hdr_len = props_len > 0 ? hdr_len + props_len : 0;
+            }
+#endif /* GSM_CFG_MQTT_V5 */
+        }
+        if (hdr_len == 0 || hdr_len >= client->rx_buff_len) {
+            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING,
+                "[MQTT] Message of %d bytes does not fit to RX buffer, ignoring\r\n", (int)client->msg_rem_len);
+            client->msg_skip = 1;               /* Ignore rest of message */
+            if (MQTT_RCV_GET_PACKET_TYPE(client->msg_hdr_byte) == MQTT_MSG_TYPE_PUBLISH
+                && MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte) > 0 && client->rx_buff_len > 2) {
+                size_t i;
+
+                /* Packet ID follows topic, collect bytes already in buffer, rest is collected while skipping */
+                client->msg_skip_id_pos = 2 + (client->msg_data[0] << 8 | client->msg_data[1]);
+                for (i = client->msg_skip_id_pos; i < client->msg_skip_id_pos + 2 && i < client->msg_buff_pos; ++i) {
+                    client->msg_skip_pkt_id = (client->msg_skip_pkt_id << 8) | client->msg_data[i];
+                }
+            }
+            return;
+        }
+        client->msg_hdr_len = hdr_len;
+    }
+
+    GSM_DEBUGF(GSM_CFG_DBG_MQTT_STATE,
+        "[MQTT] Publish payload part at offset %d received\r\n", (int)client->msg_payload_off);
+    mqtt_publish_recv_evt(client, client->msg_hdr_len);
+    client->msg_payload_off += client->msg_buff_pos - client->msg_hdr_len;
+    client->msg_buff_pos = client->msg_hdr_len; /* Keep variable header for next part */
+}
+
 /**
  * \brief           Process incoming fully received message
  * \param[in]       client: MQTT client
@@ -495,8 +1287,13 @@ mqtt_process_incoming_message(gsm_mqtt_client_p client) {
     /* Check received packet type */
     switch (msg_type) {
         case MQTT_MSG_TYPE_CONNACK: {
-            gsm_mqtt_conn_status_t err = (gsm_mqtt_conn_status_t)client->rx_buff[1];
+            gsm_mqtt_conn_status_t err = (gsm_mqtt_conn_status_t)client->msg_data[1];
             if (client->conn_state == GSM_MQTT_CONNECTING) {
+#if GSM_CFG_MQTT_V5
+                if (client->v5 && client->msg_rem_len > 2) {
+                    mqtt_connack_props(client, &client->msg_data[2], client->msg_rem_len - 2);
+                }
+#endif /* GSM_CFG_MQTT_V5 */
                 if (err == GSM_MQTT_CONN_STATUS_ACCEPTED) {
                     client->conn_state = GSM_MQTT_CONNECTED;
                 }
@@ -507,6 +1304,9 @@ mqtt_process_incoming_message(gsm_mqtt_client_p client) {
                 client->evt.type = GSM_MQTT_EVT_CONNECT;
                 client->evt.evt.connect.status = err;
                 client->evt_fn(client, &client->evt);
+#if GSM_CFG_MQTT_OFFLINE_QUEUE
+                queue_send(client);             /* Send packets stored while offline */
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE */
             } else {
                 /* Protocol violation here */
                 GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE,
@@ -515,29 +1315,37 @@ mqtt_process_incoming_message(gsm_mqtt_client_p client) {
             break;
         }
         case MQTT_MSG_TYPE_PUBLISH: {
-            uint16_t topic_len, data_len;
-            uint8_t *topic, *data, dup;
+            uint16_t topic_len;
+            const uint8_t *topic, *data;
             
             qos = MQTT_RCV_GET_PACKET_QOS(client->msg_hdr_byte);    /* Get QoS from received packet */
-            dup = MQTT_RCV_GET_PACKET_DUP(client->msg_hdr_byte);    /* Get duplicate flag */
             
-            topic_len = client->rx_buff[0] << 8 | client->rx_buff[1];
-            topic = &client->rx_buff[2];        /* Start of topic */
+            topic_len = client->msg_data[0] << 8 | client->msg_data[1];
+            topic = &client->msg_data[2];        /* Start of topic */
             
             data = topic + topic_len;           /* Get data pointer */
             
             /* Packet ID is only available if quality of service is not 0 */
             if (qos > 0) {
-                pkt_id = (client->rx_buff[2 + topic_len] << 8) | client->rx_buff[2 + topic_len + 1];/* Get packet ID */
+                pkt_id = (client->msg_data[2 + topic_len] << 8) | client->msg_data[2 + topic_len + 1];/* Get packet ID */
                 data += 2;                      /* Increase pointer for 2 bytes */
             } else {
                 pkt_id = 0;                     /* No packet ID */
             }
-            data_len = client->msg_rem_len - (data - client->rx_buff);  /* Calculate length of remaining data */
+#if GSM_CFG_MQTT_V5
+            if (client->v5) {                   /* Skip properties before payload */
+                size_t used = data - client->msg_data;
+                size_t props_len = used < client->msg_rem_len ? mqtt_props_skip(data, client->msg_rem_len - used) : 0;
+                if (props_len == 0) {
+                    return 0;
+                }
+                data += props_len;
+            }
+#endif /* GSM_CFG_MQTT_V5 */
             
             GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE,
                 "[MQTT] Publish packet received on topic %.*s; QoS: %d; pkt_id: %d; data_len: %d\r\n",
-                (int)topic_len, (const char *)topic, (int)qos, (int)pkt_id, (int)data_len);
+                (int)topic_len, (const char *)topic, (int)qos, (int)pkt_id, (int)(client->msg_rem_len - (data - client->msg_data)));
             
             /*
              * We have to send rgsmond to command if 
@@ -554,15 +1362,8 @@ mqtt_process_incoming_message(gsm_mqtt_client_p client) {
                 write_ack_rec_rel_rgsm(client, rgsm_msg_type, pkt_id, qos);
             }
             
-            /* Notify application layer about received packet */
-            client->evt.type = GSM_MQTT_EVT_PUBLISH_RECV;
-            client->evt.evt.publish_recv.topic = topic;
-            client->evt.evt.publish_recv.topic_len = topic_len;
-            client->evt.evt.publish_recv.payload = data;
-            client->evt.evt.publish_recv.payload_len = data_len;
-            client->evt.evt.publish_recv.dup = dup;
-            client->evt.evt.publish_recv.qos = qos;
-            client->evt_fn(client, &client->evt);
+            /* Notify application layer about received packet or its last part */
+            mqtt_publish_recv_evt(client, data - client->msg_data);
             
             break;
         }
@@ -579,7 +1380,7 @@ mqtt_process_incoming_message(gsm_mqtt_client_p client) {
         case MQTT_MSG_TYPE_PUBREL:
         case MQTT_MSG_TYPE_PUBACK:
         case MQTT_MSG_TYPE_PUBCOMP: {
-            pkt_id = client->rx_buff[0] << 8 | client->rx_buff[1];  /* Get packet ID */
+            pkt_id = client->msg_data[0] << 8 | client->msg_data[1];  /* Get packet ID */
             
             if (msg_type == MQTT_MSG_TYPE_PUBREC) { /* Publish record received from server */
                 write_ack_rec_rel_rgsm(client, MQTT_MSG_TYPE_PUBREL, pkt_id, (gsm_mqtt_qos_t)1);    /* Send back publish release message */
@@ -600,25 +1401,49 @@ mqtt_process_incoming_message(gsm_mqtt_client_p client) {
                  */          
                 request = request_get_pending(client, pkt_id);  /* Get pending request by packet ID */
                 if (request != NULL) {
+                    gsmr_t res = gsmOK;
+                    size_t off = 2;             /* Offset of return or reason code */
+
+#if GSM_CFG_MQTT_V5
+                    /* SUBACK and UNSUBACK have properties before reason codes */
+                    if (client->v5 && client->msg_rem_len > 2
+                        && (msg_type == MQTT_MSG_TYPE_SUBACK || msg_type == MQTT_MSG_TYPE_UNSUBACK)) {
+                        off += mqtt_props_skip(&client->msg_data[2], client->msg_rem_len - 2);
+                    }
+#endif /* GSM_CFG_MQTT_V5 */
+                    if (off < client->msg_rem_len) {
+                        if (MQTT_IS_V5(client)) {
+                            res = client->msg_data[off] < 0x80 ? gsmOK : gsmERR;
+                        } else if (msg_type == MQTT_MSG_TYPE_SUBACK) {
+                            res = client->msg_data[off] < 3 ? gsmOK : gsmERR;
+                        }
+                    }
                     if (msg_type == MQTT_MSG_TYPE_SUBACK
                         || msg_type == MQTT_MSG_TYPE_UNSUBACK) {
                         client->evt.type = msg_type == MQTT_MSG_TYPE_SUBACK ? GSM_MQTT_EVT_SUBSCRIBE : GSM_MQTT_EVT_UNSUBSCRIBE;
                         client->evt.evt.sub_unsub_scribed.arg = request->arg;
-                        client->evt.evt.sub_unsub_scribed.res = client->rx_buff[2] < 3 ? gsmOK : gsmERR;
+                        client->evt.evt.sub_unsub_scribed.res = res;
                         client->evt_fn(client, &client->evt);
                         
                     /*
                      * Final acknowledge of packet received
                      * Ack type depends on QoS level being sent to server on request
                      */
+#if GSM_CFG_MQTT_OFFLINE_QUEUE
+                    } else if (request->status & MQTT_REQUEST_FLAG_QUEUED) {
+                        queue_release(client, request->queue_len); /* Entry delivered, remove it from queue */
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE */
                     } else if (msg_type == MQTT_MSG_TYPE_PUBCOMP
                             || msg_type == MQTT_MSG_TYPE_PUBACK) {
                         client->evt.type = GSM_MQTT_EVT_PUBLISH;
                         client->evt.evt.publish.arg = request->arg;
-                        client->evt.evt.publish.res = gsmOK;
+                        client->evt.evt.publish.res = res;
                         client->evt_fn(client, &client->evt);
                     }
                     request_delete(client, request);    /* Delete request object */
+#if GSM_CFG_MQTT_OFFLINE_QUEUE
+                    queue_send(client);         /* Request is free, send next queued entry */
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE */
                 } else {
                     /* Protocol violation at this point! */
                     GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE,
@@ -661,20 +1486,48 @@ mqtt_parse_incoming(gsm_mqtt_client_p client, gsm_pbuf_p pbuf) {
                     /* Save other info about message */
                     client->msg_hdr_byte = ch;  /* Save first entry */
                     client->msg_rem_len = 0;    /* Reset remaining length */
-                    client->msg_curr_pos = 0;   /* Reset current buffer write pointer */
+                    client->msg_rem_len_shift = 0;
+                    client->msg_curr_pos = 0;   /* Reset number of received bytes */
+                    client->msg_buff_pos = 0;   /* Reset current buffer write pointer */
+                    client->msg_hdr_len = 0;
+                    client->msg_payload_off = 0;
+                    client->msg_skip = 0;
+                    client->msg_skip_id_pos = 0;
+                    client->msg_skip_pkt_id = 0;
                     
                     client->parser_state = MQTT_PARSER_STATE_CALC_REM_LEN;
                     break;
                 }
                 case MQTT_PARSER_STATE_CALC_REM_LEN: {  /* Calculate remaining length of packet */
-                    client->msg_rem_len <<= 7;  /* Shift remaining length by 7 bits */
-                    client->msg_rem_len |= (ch & 0x7F);
-                    /* TODO: Ignore too-big messages */
+                    /* Remaining length is encoded with least significant digit first */
+                    client->msg_rem_len |= (uint32_t)(ch & 0x7F) << client->msg_rem_len_shift;
+                    if ((ch & 0x80) && client->msg_rem_len_shift == MQTT_REM_LEN_MAX_SHIFT) {
+                        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING,
+                            "[MQTT] Protocol violation. Remaining length is longer than 4 bytes!\r\n");
+                        client->parser_state = MQTT_PARSER_STATE_INIT;
+                        mqtt_close(client);     /* Stream cannot be synchronized anymore */
+                        return 0;
+                    }
+                    client->msg_rem_len_shift += 7;
                     if ((ch & 0x80) == 0) {     /* Is this last entry? */
                         GSM_DEBUGF(GSM_CFG_DBG_MQTT_STATE,
                             "[MQTT] Remaining length received: %d bytes\r\n", (int)client->msg_rem_len);
                         
-                        if (client->msg_rem_len) {
+                        if (client->msg_rem_len && buff_len - idx >= client->msg_rem_len) {
+                            /*
+                             * Entire message is in current linear part of packet buffer,
+                             * process it directly from packet buffer memory without copy
+                             */
+                            client->msg_data = &d[idx];
+                            client->msg_pbuf = pbuf;
+                            client->msg_buff_pos = client->msg_rem_len;
+                            client->msg_curr_pos = client->msg_rem_len;
+                            mqtt_process_incoming_message(client);
+                            client->msg_data = client->rx_buff;
+                            client->msg_pbuf = NULL;
+                            idx += client->msg_rem_len;
+                            client->parser_state = MQTT_PARSER_STATE_INIT;
+                        } else if (client->msg_rem_len) {
                             client->parser_state = MQTT_PARSER_STATE_READ_REM;
                         } else {
                             mqtt_process_incoming_message(client);
@@ -684,14 +1537,26 @@ mqtt_parse_incoming(gsm_mqtt_client_p client, gsm_pbuf_p pbuf) {
                     break;
                 }
                 case MQTT_PARSER_STATE_READ_REM: {  /* Read remaining bytes and write to RX buffer */
-                    client->rx_buff[client->msg_curr_pos++] = ch;   /* Write received character */
+                    if (client->msg_buff_pos < client->rx_buff_len) {
+                        client->rx_buff[client->msg_buff_pos++] = ch;   /* Write received character */
+                    } else if (client->msg_skip && client->msg_skip_id_pos > 0
+                        && client->msg_curr_pos - client->msg_skip_id_pos < 2) {
+                        client->msg_skip_pkt_id = (client->msg_skip_pkt_id << 8) | ch;  /* Collect packet ID of ignored message */
+                    }
+                    client->msg_curr_pos++;
                     
                     if (client->msg_curr_pos == client->msg_rem_len) {
                         GSM_DEBUGF(GSM_CFG_DBG_MQTT_STATE,
                             "[MQTT] Packet parsed and ready for processing\r\n");
                         
-                        mqtt_process_incoming_message(client);  /* Process incoming packet */
+                        if (!client->msg_skip) {
+                            mqtt_process_incoming_message(client);  /* Process incoming packet */
+                        } else {
+                            mqtt_process_skipped_message(client);   /* Acknowledge and report ignored packet */
+                        }
                         client->parser_state = MQTT_PARSER_STATE_INIT;  /* Go to initial state and listen for next received packet */
+                    } else if (client->msg_buff_pos == client->rx_buff_len && !client->msg_skip) {
+                        mqtt_process_incoming_part(client); /* Buffer is full, deliver part of message */
                     }
                     break;
                 }
@@ -709,6 +1574,67 @@ mqtt_parse_incoming(gsm_mqtt_client_p client, gsm_pbuf_p pbuf) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 
+/**
+ * \brief           Keep-alive timeout callback
+ *
+ *                  Timeout is started for keep-alive deadline after last data exchange.
+ *                  When data were sent or received in the meantime, it is started again for remaining time,
+ *                  otherwise PINGREQ packet is sent
+ *
+ * \param[in]       arg: MQTT client
+ */
+static void
+mqtt_keep_alive_fn(void* arg) {
+    gsm_mqtt_client_p client = arg;
+    uint32_t period, elapsed, time;
+
+    client->keep_alive_armed = 0;
+    if ((client->conn_state != GSM_MQTT_CONNECTING && client->conn_state != GSM_MQTT_CONNECTED)
+        || !client->info->keep_alive) {
+        return;
+    }
+    period = GSM_U32(client->info->keep_alive) * 1000;
+    elapsed = gsm_sys_now() - client->last_activity;
+    if (elapsed >= period) {
+        if (output_check_enough_memory(client, 0)) {/* Check if memory available in output buffer */
+            write_fixed_header(client, MQTT_MSG_TYPE_PINGREQ, 0, (gsm_mqtt_qos_t)0, 0, 0);  /* Write PINGREQ command to output buffer */
+            send_data(client);                  /* Force send data */
+            client->last_activity = gsm_sys_now();  /* Reset keep-alive time */
+            time = period;
+
+            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] Sending PINGREQ packet\r\n");
+        } else {
+            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING, "[MQTT] No memory to send PINGREQ packet\r\n");
+            time = GSM_MIN(period, 1000);       /* Try again later */
+        }
+    } else {
+        time = period - elapsed;                /* Data were exchanged, wait remaining time */
+    }
+    if (gsm_timeout_start(time, mqtt_keep_alive_fn, client, &client->keep_alive_timeout) == gsmOK) {
+        client->keep_alive_armed = 1;
+    } else {
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING, "[MQTT] Cannot start keep-alive timeout\r\n");
+    }
+}
+
+/**
+ * \brief           Stop keep-alive and request timeouts
+ * \param[in]       client: MQTT client
+ */
+static void
+mqtt_timeouts_stop(gsm_mqtt_client_p client) {
+    if (client->keep_alive_armed) {
+        gsm_timeout_stop(client->keep_alive_timeout);
+        client->keep_alive_armed = 0;
+    }
+#if GSM_CFG_MQTT_REQUEST_TIMEOUT
+    if (client->req_timeout_armed) {
+        gsm_timeout_stop(client->req_timeout);
+        client->req_timeout_armed = 0;
+    }
+#endif /* GSM_CFG_MQTT_REQUEST_TIMEOUT */
+}
+
 /**
  * \brief           Callback when we are connected to MQTT server
  * \param[in]       client: MQTT client
@@ -719,6 +1645,10 @@ mqtt_connected_cb(gsm_mqtt_client_p client) {
     uint16_t rem_len, len_id, len_pass, len_user, len_will_topic, len_will_message;
 
     flags |= MQTT_FLAG_CONNECT_CLEAN_SESSION;   /* Start as clean session */
+#if GSM_CFG_MQTT_V5
+    topic_alias_reset(client);                  /* Aliases are valid for single connection only */
+    client->v5 = client->info->protocol_version == 5;
+#endif /* GSM_CFG_MQTT_V5 */
     
     /*
      * Remaining length consist of fixed header data
@@ -730,6 +1660,9 @@ mqtt_connected_cb(gsm_mqtt_client_p client) {
     
     len_id = GSM_U16(strlen(client->info->id)); /* Get cliend ID length */
     rem_len += len_id + 2;                      /* Add client id length including length entries */
+    if (MQTT_IS_V5(client)) {
+        rem_len++;                              /* Empty connect properties */
+    }
     
     if (client->info->will_topic != NULL && client->info->will_message != NULL) {
         flags |= MQTT_FLAG_CONNECT_WILL;
@@ -740,6 +1673,9 @@ mqtt_connected_cb(gsm_mqtt_client_p client) {
         
         rem_len += len_will_topic + 2;          /* Add will topic parameter */
         rem_len += len_will_message + 2;        /* Add will message parameter */
+        if (MQTT_IS_V5(client)) {
+            rem_len++;                          /* Empty will properties */
+        }
     }
     
     if (client->info->user != NULL) {           /* Check for username */
@@ -763,11 +1699,17 @@ mqtt_connected_cb(gsm_mqtt_client_p client) {
     /* Write everything to output buffer */
     write_fixed_header(client, MQTT_MSG_TYPE_CONNECT, 0, (gsm_mqtt_qos_t)0, 0, rem_len);
     write_string(client, "MQTT", 4);            /* Protocol name */
-    write_u8(client, 4);                        /* Protocol version */
+    write_u8(client, MQTT_IS_V5(client) ? 5 : 4);   /* Protocol version */
     write_u8(client, flags);                    /* Flags for CONNECT message */
     write_u16(client, client->info->keep_alive);/* Keep alive timeout in units of seconds */
+    if (MQTT_IS_V5(client)) {
+        write_u8(client, 0);                    /* No connect properties */
+    }
     write_string(client, client->info->id, len_id); /* This is client ID string */
     if (flags & MQTT_FLAG_CONNECT_WILL) {       /* Check for will topic */
+        if (MQTT_IS_V5(client)) {
+            write_u8(client, 0);                /* No will properties */
+        }
         write_string(client, client->info->will_topic, len_will_topic); /* Write topic to packet */
         write_string(client, client->info->will_message, len_will_message); /* Write message to packet */
     }
@@ -780,10 +1722,11 @@ mqtt_connected_cb(gsm_mqtt_client_p client) {
     
     client->parser_state = MQTT_PARSER_STATE_INIT;  /* Reset parser state */
     
-    client->poll_time = 0;                      /* Reset kep alive time */
+    client->last_activity = gsm_sys_now();      /* Reset keep-alive time */
     client->conn_state = GSM_MQTT_CONNECTING;   /* MQTT is connecting to server */
 
     send_data(client);                          /* Flush and send the actual data */
+    mqtt_keep_alive_fn(client);                 /* Start keep-alive timeout */
 }
 
 /**
@@ -794,7 +1737,7 @@ mqtt_connected_cb(gsm_mqtt_client_p client) {
  */
 static uint8_t
 mqtt_data_recv_cb(gsm_mqtt_client_p client, gsm_pbuf_p pbuf) {
-    client->poll_time = 0;                      /* Reset kep alive time */
+    client->last_activity = gsm_sys_now();      /* Reset keep-alive time */
     mqtt_parse_incoming(client, pbuf);
     gsm_conn_recved(client->conn, pbuf);        /* Notify stack about received data */
     return 1;
@@ -813,7 +1756,7 @@ mqtt_data_sent_cb(gsm_mqtt_client_p client, size_t sent_len, uint8_t successful)
     client->is_sending = 0;                     /* We are not sending anymore */
     client->sent_total += sent_len;
 
-    client->poll_time = 0;                      /* Reset kep alive time */
+    client->last_activity = gsm_sys_now();      /* Reset keep-alive time */
 
     /*
      * In case transmit was not successful,
@@ -856,6 +1799,9 @@ mqtt_data_sent_cb(gsm_mqtt_client_p client, size_t sent_len, uint8_t successful)
         }
     }
     
+#if GSM_CFG_MQTT_OFFLINE_QUEUE
+    queue_send(client);                         /* Output buffer has free memory for queued entries */
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE */
     send_data(client);                          /* Try to send more */
     return 1;
 }
@@ -863,42 +1809,21 @@ mqtt_data_sent_cb(gsm_mqtt_client_p client, size_t sent_len, uint8_t successful)
 /**
  * \brief           Poll for client connection
  *                  Called every GSM_CFG_CONN_POLL_INTERVAL ms when MQTT client TCP connection is established
+ *
+ *                  Keep-alive and request timeouts run on timeout manager,
+ *                  poll only starts keep-alive again if it could not be started before
+ *
  * \param[in]       client: MQTT client
  * \return          `1` on success, `0` otherwise
  */
 static uint8_t
 mqtt_poll_cb(gsm_mqtt_client_p client) {
-    client->poll_time++;
-    
     if (client->conn_state == GSM_MQTT_CONN_DISCONNECTING) {
         return 0;
     }
-
-    /*
-     * Check for keep-alive time if equal or greater than
-     * keep alive time. In that case, send packet 
-     * to make sure we are still alive
-     */
-    if (client->info->keep_alive                /* Keep alive must be enabled */
-        /* Poll time is in units of GSM_CFG_CONN_POLL_INTERVAL milliseconds,
-           while keep_alive is in units of seconds */
-        && (client->poll_time * GSM_CFG_CONN_POLL_INTERVAL) >= (uint32_t)(client->info->keep_alive * 1000)) {
-            
-        if (output_check_enough_memory(client, 0)) {/* Check if memory available in output buffer */
-            write_fixed_header(client, MQTT_MSG_TYPE_PINGREQ, 0, (gsm_mqtt_qos_t)0, 0, 0);  /* Write PINGREQ command to output buffer */
-            send_data(client);                  /* Force send data */
-            client->poll_time = 0;              /* Reset polling time */
-            
-            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] Sending PINGREQ packet\r\n");
-        } else {
-            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE_WARNING, "[MQTT] No memory to send PINGREQ packet\r\n");
-        }
+    if (!client->keep_alive_armed) {
+        mqtt_keep_alive_fn(client);
     }
-
-    /*
-     * Process all active packets and 
-     * check for timeout if there was no reply from MQTT server
-     */
     return 1;
 }
 
@@ -931,9 +1856,25 @@ mqtt_closed_cb(gsm_mqtt_client_p client, uint8_t forced) {
         request_delete(client, request);        /* Delete request */
         request_send_err_callback(client, status, arg); /* Send error callback to user */
     }
-    memset(client->requests, 0x00, sizeof(client->requests));
+    request_init(client);
+#if GSM_CFG_MQTT_V5
+    topic_alias_reset(client);
+#endif /* GSM_CFG_MQTT_V5 */
+#if GSM_CFG_MQTT_OFFLINE_QUEUE
+    if (client->queue != NULL) {                /* Send unacknowledged entries again on next connection */
+        client->queue_send_pos = client->queue->r;
+        client->queue_inflight = 0;
+    }
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE */
     
     client->is_sending = client->sent_total = client->written_total = 0;
+    mqtt_timeouts_stop(client);
+#if GSM_CFG_MQTT_TX_COALESCE_DELAY
+    if (client->flush_pending) {                /* Nothing to send anymore */
+        gsm_timeout_stop(client->flush_timeout);
+        client->flush_pending = 0;
+    }
+#endif /* GSM_CFG_MQTT_TX_COALESCE_DELAY */
     client->parser_state = MQTT_PARSER_STATE_INIT;
     gsm_buff_reset(&client->tx_buff);           /* Reset TX buffer */
     
@@ -982,6 +1923,7 @@ mqtt_conn_cb(gsm_evt_t* evt) {
         
         /* Connection active to MQTT server */
         case GSM_EVT_CONN_ACTIVE: {
+            gsm_conn_set_poll_interval(conn, GSM_CFG_CONN_POLL_INTERVAL);
             mqtt_connected_cb(client);          /* Call function to process status */
             break;
         }
@@ -1020,6 +1962,8 @@ mqtt_conn_cb(gsm_evt_t* evt) {
 
 /**
  * \brief           Allocate a new MQTT client structure
+ * \note            Connected client uses entries of timeout manager for keep-alive,
+ *                  request timeout and delayed send, see \ref GSM_CFG_MAX_TIMEOUTS
  * \param[in]       tx_buff_len: Length of raw data output buffer
  * \param[in]       rx_buff_len: Length of raw data input buffer
  * \return          Pointer to new allocated MQTT client structure or `NULL` on failure
@@ -1028,10 +1972,11 @@ gsm_mqtt_client_t *
 gsm_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len) {
     gsm_mqtt_client_p client;
     
-    client = gsm_mem_alloc(sizeof(*client));    /* Allocate memory for client structure */
+    client = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, sizeof(*client));  /* Allocate memory for client structure */
     if (client != NULL) {
         memset(client, 0x00, sizeof(*client));  /* Reset memory */
         client->conn_state = GSM_MQTT_CONN_DISCONNECTED;/* Set to disconnected mode */
+        request_init(client);                   /* Prepare free list of requests */
         
         if (!gsm_buff_init(&client->tx_buff, tx_buff_len)) {
             gsm_mem_free(client);
@@ -1039,7 +1984,8 @@ gsm_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len) {
         }
         if (client != NULL) {
             client->rx_buff_len = rx_buff_len;
-            client->rx_buff = gsm_mem_alloc(rx_buff_len);
+            client->rx_buff = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, rx_buff_len);
+            client->msg_data = client->rx_buff;
             if (client->rx_buff == NULL) {
                 gsm_buff_free(&client->tx_buff);
                 gsm_mem_free(client);
@@ -1058,6 +2004,15 @@ gsm_mqtt_client_new(size_t tx_buff_len, size_t rx_buff_len) {
 void
 gsm_mqtt_client_delete(gsm_mqtt_client_p client) {
     if (client != NULL) {
+        mqtt_timeouts_stop(client);
+#if GSM_CFG_MQTT_TX_COALESCE_DELAY
+        if (client->flush_pending) {
+            gsm_timeout_stop(client->flush_timeout);
+        }
+#endif /* GSM_CFG_MQTT_TX_COALESCE_DELAY */
+#if GSM_CFG_MQTT_V5
+        topic_alias_reset(client);              /* Free topic copies */
+#endif /* GSM_CFG_MQTT_V5 */
         if (client->rx_buff != NULL) {
             gsm_mem_free(client->rx_buff);      /* Free RX buffer memory */
             client->rx_buff = NULL;
@@ -1093,7 +2048,11 @@ gsm_mqtt_client_connect(gsm_mqtt_client_p client, const char* host, gsm_port_t p
         client->evt_fn = evt_fn != NULL ? evt_fn : mqtt_evt_fn_default;
         
         /* Start a new connection in non-blocking mode */
+#if GSM_CFG_CONN_SSL
+        res = gsm_conn_start(&client->conn, info->use_ssl ? GSM_CONN_TYPE_SSL : GSM_CONN_TYPE_TCP, host, port, client, mqtt_conn_cb, 0);
+#else /* GSM_CFG_CONN_SSL */
         res = gsm_conn_start(&client->conn, GSM_CONN_TYPE_TCP, host, port, client, mqtt_conn_cb, 0);
+#endif /* !GSM_CFG_CONN_SSL */
         if (res == gsmOK) {
             client->conn_state = GSM_MQTT_CONN_CONNECTING;
         }
@@ -1155,7 +2114,8 @@ gsm_mqtt_client_unsubscribe(gsm_mqtt_client_p client, const char* topic, void* a
  * \param[in]       qos: Quality of service. This parameter can be a value of \ref gsm_mqtt_qos_t enumeration
  * \param[in]       retain: Retian parameter value
  * \param[in]       arg: User custom argument used in callback
- * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ * \return          \ref gsmOK on success, \ref gsmINPROG when packet is stored to offline queue,
+ *                      member of \ref gsmr_t enumeration otherwise
  */
 gsmr_t
 gsm_mqtt_client_publish(gsm_mqtt_client_p client, const char* topic, const void* payload,
@@ -1181,47 +2141,152 @@ gsm_mqtt_client_publish(gsm_mqtt_client_p client, const char* topic, const void*
     }
     
     gsm_core_lock();                            /* Protect core */
+#if GSM_CFG_MQTT_OFFLINE_QUEUE
+    /* Store to queue while offline or while older entries wait, to keep order of packets */
+    if (client->queue != NULL && qos_u8 > 0
+        && (client->conn_state != GSM_MQTT_CONNECTED || client->queue->used > 0)) {
+        res = queue_put(client, topic, len_topic, payload, payload != NULL ? payload_len : 0, qos_u8, retain);
+        queue_send(client);
+    } else
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE */
     if (client->conn_state != GSM_MQTT_CONNECTED) {
         res = gsmERR;
-    } else if ((raw_len = output_check_enough_memory(client, rem_len)) != 0) {
-        pkt_id = qos_u8 > 0 ? create_packet_id(client) : 0; /* Create new packet ID */
-        request = request_create(client, pkt_id, arg);  /* Create request for packet */
-        if (request != NULL) {
-            /*
-             * Set expected number of bytes we should send before
-             * we can say that this packet was sent.
-             * Used in case QoS is set to 0 where packet notification 
-             * is not received by server. In this case, wait
-             * number of bytes sent before notifying user about success
-             */
-            request->expected_sent_len = client->written_total + raw_len;
-            
-            write_fixed_header(client, MQTT_MSG_TYPE_PUBLISH, 0, (gsm_mqtt_qos_t)GSM_MIN(qos_u8, GSM_U8(GSM_MQTT_QOS_EXACTLY_ONCE)), retain, rem_len);
-            write_string(client, topic, len_topic); /* Write topic string to packet */
-            if (qos_u8 > 0) {
-                write_u16(client, pkt_id);      /* Write packet ID */
+    } else {
+#if GSM_CFG_MQTT_V5
+        uint16_t alias = 0;
+        uint8_t send_topic = 1, new_alias = 0;
+
+        /*
+         * Add properties, with topic alias when server accepts it.
+         * Topic with already assigned alias is sent as empty string
+         */
+        if (client->v5) {
+            rem_len++;
+            if ((alias = topic_alias_find(client, topic, len_topic)) != 0) {
+                send_topic = 0;
+                rem_len += 3 - len_topic;
+            } else if ((alias = topic_alias_assign(client, topic, len_topic)) != 0) {
+                new_alias = 1;
+                rem_len += 3;
             }
-            if (payload != NULL && payload_len > 0) {
-                write_data(client, payload, payload_len);   /* Write RAW topic payload */
+        }
+#endif /* GSM_CFG_MQTT_V5 */
+        if ((raw_len = output_check_enough_memory(client, rem_len)) != 0) {
+            pkt_id = qos_u8 > 0 ? create_packet_id(client) : 0; /* Create new packet ID */
+            request = request_create(client, pkt_id, arg);  /* Create request for packet */
+            if (request != NULL) {
+                /*
+                 * Set expected number of bytes we should send before
+                 * we can say that this packet was sent.
+                 * Used in case QoS is set to 0 where packet notification 
+                 * is not received by server. In this case, wait
+                 * number of bytes sent before notifying user about success
+                 */
+                request->expected_sent_len = client->written_total + raw_len;
+                
+                write_fixed_header(client, MQTT_MSG_TYPE_PUBLISH, 0, (gsm_mqtt_qos_t)GSM_MIN(qos_u8, GSM_U8(GSM_MQTT_QOS_EXACTLY_ONCE)), retain, rem_len);
+#if GSM_CFG_MQTT_V5
+                write_string(client, topic, send_topic ? len_topic : 0);    /* Write topic string to packet */
+#else
+                write_string(client, topic, len_topic); /* Write topic string to packet */
+#endif /* GSM_CFG_MQTT_V5 */
+                if (qos_u8 > 0) {
+                    write_u16(client, pkt_id);  /* Write packet ID */
+                }
+#if GSM_CFG_MQTT_V5
+                if (client->v5) {               /* Write properties */
+                    write_u8(client, alias ? 3 : 0);
+                    if (alias) {
+                        write_u8(client, MQTT_PROP_TOPIC_ALIAS);
+                        write_u16(client, alias);
+                    }
+                }
+#endif /* GSM_CFG_MQTT_V5 */
+                if (payload != NULL && payload_len > 0) {
+                    write_data(client, payload, payload_len);   /* Write RAW topic payload */
+                }
+                request_set_pending(client, request);   /* Set request as pending waiting for server reply */
+                
+                send_data_coalesce(client);     /* Send data now or together with next packets */
+                
+                GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE,
+                    "[MQTT] Pkt publish start. QoS: %d, pkt_id: %d\r\n", (int)qos_u8, (int)pkt_id);
+            } else {
+                GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] No free request available\r\n");
+                res = gsmERRMEM;
             }
-            request_set_pending(client, request);   /* Set request as pending waiting for server reply */
-            
-            send_data(client);                  /* Try to send data */
-            
-            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE,
-                "[MQTT] Pkt publish start. QoS: %d, pkt_id: %d\r\n", (int)qos_u8, (int)pkt_id);
         } else {
-            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] No free request available\r\n");
+            GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] No enough memory to publish message\r\n");
             res = gsmERRMEM;
         }
-    } else {
-        GSM_DEBUGF(GSM_CFG_DBG_MQTT_TRACE, "[MQTT] No enough memory to publish message\r\n");
-        res = gsmERRMEM;
+#if GSM_CFG_MQTT_V5
+        if (res != gsmOK && new_alias) {        /* Packet with new alias was not sent */
+            topic_alias_drop(client, alias);
+        }
+#endif /* GSM_CFG_MQTT_V5 */
     }
     gsm_core_unlock();                          /* Unprotect core */
     return res;
 }
 
+/**
+ * \brief           Send all packets waiting in output buffer immediately
+ *
+ *                  Use it after latency sensitive publish when \ref GSM_CFG_MQTT_TX_COALESCE_DELAY is enabled
+ *
+ * \param[in]       client: MQTT client
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_mqtt_client_flush(gsm_mqtt_client_p client) {
+    gsmr_t res = gsmERR;
+
+    gsm_core_lock();                            /* Protect core */
+    if (client->conn_state == GSM_MQTT_CONNECTED) {
+        send_data(client);                      /* Send everything now */
+        res = gsmOK;
+    }
+    gsm_core_unlock();                          /* Unprotect core */
+    return res;
+}
+
+#if GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Set offline publish queue
+ *
+ *                  Publish packets with quality of service above `0` are stored to queue
+ *                  when client is not connected and \ref gsm_mqtt_client_publish returns \ref gsmINPROG.
+ *                  Stored packets are sent in batches after connection is accepted
+ *                  and removed from queue when acknowledged by server.
+ *                  No publish event is sent to user for queued packets.
+ *
+ * \note            Queue content is kept in order, while queue is not empty new packets are queued too
+ * \param[in]       client: MQTT client
+ * \param[in]       queue: Queue to use. Ring positions are used as they are to continue with stored entries.
+ *                      Set to `NULL` to disable queue
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_mqtt_client_set_queue(gsm_mqtt_client_p client, gsm_mqtt_client_queue_t* queue) {
+    gsmr_t res = gsmERR;
+
+    GSM_ASSERT("client != NULL", client != NULL);
+    GSM_ASSERT("queue == NULL || queue->size > 0", queue == NULL || queue->size > 0);
+
+    gsm_core_lock();                            /* Protect core */
+    if (client->queue_inflight == 0) {          /* Entries must not wait for acknowledge */
+        client->queue = queue;
+        client->queue_send_pos = queue != NULL ? queue->r : 0;
+        queue_send(client);
+        res = gsmOK;
+    }
+    gsm_core_unlock();                          /* Unprotect core */
+    return res;
+}
+
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
 /**
  * \brief           Test if client is connected to server and accepted to MQTT protocol
  * \note            Function will return error if TCP is connected but MQTT not accepted
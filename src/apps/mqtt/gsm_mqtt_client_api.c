@@ -38,6 +38,40 @@
 #define GSM_CFG_DBG_MQTT_API_STATE              (GSM_CFG_DBG_MQTT_API | GSM_DBG_TYPE_STATE)
 #define GSM_CFG_DBG_MQTT_API_TRACE_WARNING      (GSM_CFG_DBG_MQTT_API | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING)
 
+/**
+ * \brief           Asynchronous publish request, used with \ref gsm_mqtt_client_api_publish_async
+ */
+typedef struct {
+    void* arg;                                  /*!< User argument identifying publish */
+    gsmr_t res;                                 /*!< Publish result */
+    uint8_t in_use;                             /*!< Set to `1` when entry is used by pending publish */
+} gsm_mqtt_client_api_pub_t;
+
+/**
+ * \brief           Size of buffer header, buffer data starts after it
+ */
+#define BUF_HDR_SIZE                GSM_MEM_ALIGN(sizeof(gsm_mqtt_client_api_buf_t))
+
+/**
+ * \brief           Receive buffer pool size class
+ */
+typedef struct {
+    size_t size;                                /*!< Data size of each buffer in class */
+    gsm_mqtt_client_api_buf_p free;             /*!< List of free buffers */
+} gsm_mqtt_client_api_pool_t;
+
+/**
+ * \brief           Subscription router node, one topic level of subscription topic filter
+ */
+typedef struct gsm_mqtt_client_api_route {
+    struct gsm_mqtt_client_api_route* child;    /*!< First node on next topic level */
+    struct gsm_mqtt_client_api_route* next;     /*!< Next node on the same topic level */
+    gsm_mqtt_client_api_sub_fn fn;              /*!< Callback for filter ending at this node, `NULL` if none */
+    void* arg;                                  /*!< User argument for callback */
+    size_t level_len;                           /*!< Length of topic level name */
+    char level[];                               /*!< Topic level name, not `NULL` terminated */
+} gsm_mqtt_client_api_route_t;
+
 /**
  * \brief           MQTT API client structure
  */
@@ -49,6 +83,12 @@ struct gsm_mqtt_client_api {
     uint8_t release_sem;                        /*!< Set to `1` to release semaphore */
     gsm_mqtt_conn_status_t connect_rgsm;        /*!< Rgsmonse when connecting to server */
     gsmr_t sub_pub_rgsm;                        /*!< Subscribe/Unsubscribe/Publish rgsmonse */
+    gsm_mqtt_client_api_buf_p rcv_buf;          /*!< Publish buffer waiting for remaining payload parts */
+    gsm_sys_mbox_t pub_mbox;                    /*!< Completion queue of asynchronous publish requests */
+    gsm_mqtt_client_api_pub_t pubs[GSM_CFG_MQTT_MAX_REQUESTS];  /*!< Asynchronous publish requests */
+    gsm_mqtt_client_api_route_t* routes;        /*!< Subscription router, nodes of first topic level */
+    gsm_mqtt_client_api_pool_t* pools;          /*!< Receive buffer pool size classes, single allocation with buffers */
+    size_t pools_len;                           /*!< Number of receive buffer pool size classes */
 } gsm_mqtt_client_api_t;
 
 static uint8_t mqtt_closed = 0xFF;
@@ -65,6 +105,269 @@ release_sem(gsm_mqtt_client_api_p client) {
     }
 }
 
+/**
+ * \brief           Create receive buffer pool
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       cfg: Size classes configuration
+ * \param[in]       len: Number of size classes
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+static gsmr_t
+buf_pool_create(gsm_mqtt_client_api_p client, const gsm_mqtt_client_api_pool_cfg_t* cfg, size_t len) {
+    gsm_mqtt_client_api_buf_p buf;
+    uint8_t* mem;
+    size_t size, i, k, slot;
+
+    /* Calculate memory for classes and all buffers, 2 bytes for topic and payload termination */
+    size = GSM_MEM_ALIGN(sizeof(*client->pools) * len);
+    for (i = 0; i < len; ++i) {
+        size += cfg[i].count * (BUF_HDR_SIZE + GSM_MEM_ALIGN(cfg[i].size + 2));
+    }
+    mem = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, size);
+    if (mem == NULL) {
+        return gsmERRMEM;
+    }
+    client->pools = (void *)mem;
+    client->pools_len = len;
+    mem += GSM_MEM_ALIGN(sizeof(*client->pools) * len);
+
+    /* Split memory to buffers and link them to free lists */
+    for (i = 0; i < len; ++i) {
+        client->pools[i].size = GSM_MEM_ALIGN(cfg[i].size + 2);
+        slot = BUF_HDR_SIZE + client->pools[i].size;
+        for (k = 0; k < cfg[i].count; ++k, mem += slot) {
+            buf = (void *)mem;
+            buf->next = client->pools[i].free;
+            client->pools[i].free = buf;
+        }
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           Allocate receive buffer
+ *
+ * Smallest pool size class with free buffer is used,
+ * heap is used only when no pool buffer is large enough or available
+ *
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       data_size: Number of bytes for topic and payload, located after buffer header
+ * \return          Zeroed buffer on success, `NULL` otherwise
+ */
+static gsm_mqtt_client_api_buf_p
+buf_alloc(gsm_mqtt_client_api_p client, size_t data_size) {
+    gsm_mqtt_client_api_pool_t* pool = NULL;
+    gsm_mqtt_client_api_buf_p buf;
+
+    gsm_core_lock();
+    for (size_t i = 0; i < client->pools_len; ++i) {
+        if (client->pools[i].free != NULL && client->pools[i].size >= data_size
+            && (pool == NULL || client->pools[i].size < pool->size)) {
+            pool = &client->pools[i];
+        }
+    }
+    if (pool != NULL) {
+        buf = pool->free;
+        pool->free = buf->next;
+    }
+    gsm_core_unlock();
+
+    if (pool != NULL) {
+        GSM_MEMSET(buf, 0x00, BUF_HDR_SIZE + data_size);
+        buf->pool = pool;
+    } else {
+        buf = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, BUF_HDR_SIZE + data_size);
+    }
+    return buf;
+}
+
+/**
+ * \brief           Get length of first topic level
+ * \param[in]       topic: Topic or topic filter
+ * \param[in]       len: Length of topic
+ * \return          Number of characters before first `/` or end of topic
+ */
+static size_t
+route_level_len(const char* topic, size_t len) {
+    size_t i;
+    for (i = 0; i < len && topic[i] != '/'; ++i) {}
+    return i;
+}
+
+/**
+ * \brief           Check if route node is single character wildcard node
+ * \param[in]       r: Route node
+ * \param[in]       ch: Wildcard character, `+` or `#`
+ * \return          `1` if node is wildcard, `0` otherwise
+ */
+static uint8_t
+route_is_wildcard(gsm_mqtt_client_api_route_t* r, char ch) {
+    return r->level_len == 1 && r->level[0] == ch;
+}
+
+/**
+ * \brief           Add subscription topic filter to router
+ * \note            Function must be called with core locked
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       filter: Topic filter, `NULL` terminated
+ * \param[in]       fn: Callback function
+ * \param[in]       arg: User argument
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+static gsmr_t
+route_add(gsm_mqtt_client_api_p client, const char* filter,
+            gsm_mqtt_client_api_sub_fn fn, void* arg) {
+    gsm_mqtt_client_api_route_t **first = &client->routes, *r = NULL;
+    size_t len = strlen(filter), lvl;
+
+    while (1) {
+        lvl = route_level_len(filter, len);
+        for (r = *first; r != NULL; r = r->next) {
+            if (r->level_len == lvl && !strncmp(r->level, filter, lvl)) {
+                break;
+            }
+        }
+        if (r == NULL) {                        /* Create new level */
+            r = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, sizeof(*r) + lvl);
+            if (r == NULL) {
+                return gsmERRMEM;
+            }
+            r->level_len = lvl;
+            GSM_MEMCPY(r->level, filter, lvl);
+            r->next = *first;
+            *first = r;
+        }
+        if (lvl == len) {                       /* Last level of filter */
+            break;
+        }
+        first = &r->child;
+        filter += lvl + 1;
+        len -= lvl + 1;
+    }
+    r->fn = fn;
+    r->arg = arg;
+    return gsmOK;
+}
+
+/**
+ * \brief           Remove topic filter from router and free unused nodes
+ * \note            Function must be called with core locked
+ * \param[in]       first: Pointer to first node of current level
+ * \param[in]       filter: Remaining topic filter
+ * \param[in]       len: Length of remaining topic filter
+ */
+static void
+route_remove(gsm_mqtt_client_api_route_t** first, const char* filter, size_t len) {
+    gsm_mqtt_client_api_route_t* r;
+    size_t lvl = route_level_len(filter, len);
+
+    for (; *first != NULL; first = &(*first)->next) {
+        r = *first;
+        if (r->level_len == lvl && !strncmp(r->level, filter, lvl)) {
+            if (lvl == len) {
+                r->fn = NULL;
+                r->arg = NULL;
+            } else {
+                route_remove(&r->child, filter + lvl + 1, len - lvl - 1);
+            }
+            if (r->fn == NULL && r->child == NULL) {/* Node is not used anymore */
+                *first = r->next;
+                gsm_mem_free(r);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * \brief           Free all router nodes
+ * \param[in]       r: First node of level to free
+ */
+static void
+route_free(gsm_mqtt_client_api_route_t* r) {
+    gsm_mqtt_client_api_route_t* n;
+    for (; r != NULL; r = n) {
+        n = r->next;
+        route_free(r->child);
+        gsm_mem_free(r);
+    }
+}
+
+/**
+ * \brief           Call subscription callback of route node if set
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       r: Route node
+ * \param[in]       buf: Received publish buffer
+ * \return          `1` if callback was called, `0` otherwise
+ */
+static size_t
+route_call(gsm_mqtt_client_api_p client, gsm_mqtt_client_api_route_t* r, gsm_mqtt_client_api_buf_p buf) {
+    if (r->fn != NULL) {
+        r->fn(client, buf, r->arg);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Match topic level against router nodes and call matching callbacks
+ *
+ * Each topic level is compared once against nodes of the same level,
+ * matching cost depends on topic depth instead of number of subscriptions
+ *
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       first: First node of current level
+ * \param[in]       topic: Remaining topic
+ * \param[in]       len: Length of remaining topic
+ * \param[in]       root: Set to `1` when matching first topic level
+ * \param[in]       buf: Received publish buffer
+ * \return          Number of called callbacks
+ */
+static size_t
+route_match(gsm_mqtt_client_api_p client, gsm_mqtt_client_api_route_t* first,
+            const char* topic, size_t len, uint8_t root, gsm_mqtt_client_api_buf_p buf) {
+    gsm_mqtt_client_api_route_t *r, *c;
+    size_t cnt = 0, lvl = route_level_len(topic, len);
+    uint8_t wc = !(root && len > 0 && topic[0] == '$');   /* Topics starting with `$` do not match wildcards on first level */
+
+    for (r = first; r != NULL; r = r->next) {
+        if (route_is_wildcard(r, '#')) {
+            if (wc) {
+                cnt += route_call(client, r, buf);
+            }
+        } else if ((wc && route_is_wildcard(r, '+'))
+            || (r->level_len == lvl && !strncmp(r->level, topic, lvl))) {
+            if (lvl == len) {                   /* Last topic level */
+                cnt += route_call(client, r, buf);
+
+                /* Filter `a/#` matches topic `a` too */
+                for (c = r->child; c != NULL; c = c->next) {
+                    if (route_is_wildcard(c, '#')) {
+                        cnt += route_call(client, c, buf);
+                    }
+                }
+            } else {
+                cnt += route_match(client, r->child, topic + lvl + 1, len - lvl - 1, 0, buf);
+            }
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Dispatch received publish to subscription callbacks
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       buf: Received publish buffer
+ * \return          `1` if at least one callback was called, `0` otherwise
+ */
+static uint8_t
+route_dispatch(gsm_mqtt_client_api_p client, gsm_mqtt_client_api_buf_p buf) {
+    if (client->routes == NULL) {
+        return 0;
+    }
+    return route_match(client, client->routes, buf->topic, buf->topic_len, 1, buf) > 0;
+}
+
 /**
  * \brief           MQTT event callback function
  */
@@ -100,54 +403,121 @@ mqtt_evt(gsm_mqtt_client_p client, gsm_mqtt_evt_t* evt) {
             break;
         }
         case GSM_MQTT_EVT_PUBLISH_RECV: {
-            /* Check valid receive mbox */
-            if (gsm_sys_mbox_isvalid(&api_client->rcv_mbox)) {
+            /* Check valid receive mbox and ignore packets which did not fit to RX buffer */
+            if (gsm_sys_mbox_isvalid(&api_client->rcv_mbox)
+                && gsm_mqtt_client_evt_publish_recv_get_result(client, evt) == gsmOK) {
                 gsm_mqtt_client_api_buf_p buf;
-                size_t size, buf_size, topic_size, payload_size;
+                size_t size, topic_size, payload_size;
 
                 /* Get event data */
                 const char* topic = gsm_mqtt_client_evt_publish_recv_get_topic(client, evt);
                 size_t topic_len = gsm_mqtt_client_evt_publish_recv_get_topic_len(client, evt);
                 const uint8_t* payload = gsm_mqtt_client_evt_publish_recv_get_payload(client, evt);
                 size_t payload_len = gsm_mqtt_client_evt_publish_recv_get_payload_len(client, evt);
+                size_t payload_off = gsm_mqtt_client_evt_publish_recv_get_payload_offset(client, evt);
+                size_t payload_total = gsm_mqtt_client_evt_publish_recv_get_payload_total(client, evt);
                 gsm_mqtt_qos_t qos = gsm_mqtt_client_evt_publish_recv_get_qos(client, evt);
 
-                /* Print debug message */
-                GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE,
-                    "[MQTT API] New publish received on topic %.*s\r\n", (int)topic_len, topic);
+                /* Entire packet received at once, route it without allocating buffer */
+                if (api_client->routes != NULL && payload_off == 0 && payload_len == payload_total) {
+                    gsm_mqtt_client_api_buf_t rbuf = {
+                        .topic = topic,
+                        .topic_len = topic_len,
+                        .payload = payload,
+                        .payload_len = payload_len,
+                        .qos = qos,
+#if GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY
+                        .pbuf = gsm_mqtt_client_evt_publish_recv_get_pbuf(client, evt),
+#endif /* GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY */
+                    };
+                    if (route_dispatch(api_client, &rbuf)) {
+                        break;
+                    }
+                }
 
-                /* Calculate sizes */
-                buf_size = sizeof(*buf);
-                topic_size = sizeof(*topic) * (topic_len + 1);
-                payload_size = sizeof(*payload) * (payload_len + 1);
+#if GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY
+                gsm_pbuf_p pbuf = gsm_mqtt_client_evt_publish_recv_get_pbuf(client, evt);
 
-                size = sizeof(*buf) + topic_size + payload_size;
-                buf = gsm_mem_alloc(size);
-                if (buf != NULL) {
-                    GSM_MEMSET(buf, 0x00, size);
-                    buf->topic = (const void *)(buf + buf_size);
-                    buf->payload = (const void *)(buf->topic + topic_size);
-                    buf->topic_len = topic_len;
-                    buf->payload_len = payload_len;
-                    buf->qos = qos;
-
-                    /* Copy content to new memory */
-                    GSM_MEMCPY((void *)buf->topic, topic, sizeof(*topic) * topic_len);
-                    GSM_MEMCPY((void *)buf->payload, payload, sizeof(*payload) * payload_len);
-
-                    /* Write to receive queue */
-                    if (!gsm_sys_mbox_putnow(&api_client->rcv_mbox, buf)) {
-                        gsm_mem_free(buf);
+                /* Entire packet is in packet buffer memory, keep reference instead of payload copy */
+                if (pbuf != NULL && payload_off == 0 && payload_len == payload_total) {
+                    size = sizeof(*topic) * (topic_len + 1);
+                    buf = buf_alloc(api_client, size);
+                    if (buf != NULL) {
+                        buf->topic = (const void *)((uint8_t *)buf + BUF_HDR_SIZE);
+                        buf->topic_len = topic_len;
+                        buf->payload = payload;
+                        buf->payload_len = payload_len;
+                        buf->qos = qos;
+                        buf->pbuf = pbuf;
+                        GSM_MEMCPY((void *)buf->topic, topic, sizeof(*topic) * topic_len);
+                        gsm_pbuf_ref(pbuf);     /* Keep packet buffer until user frees API buffer */
+                        if (!gsm_sys_mbox_putnow(&api_client->rcv_mbox, buf)) {
+                            gsm_mqtt_client_api_buf_free(buf);
+                        }
+                    }
+                    break;
+                }
+#endif /* GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY */
+                if (payload_off == 0) {         /* First or only part of payload */
+                    /* Print debug message */
+                    GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE,
+                        "[MQTT API] New publish received on topic %.*s\r\n", (int)topic_len, topic);
+
+                    if (api_client->rcv_buf != NULL) {  /* Previous message was not completed */
+                        gsm_mqtt_client_api_buf_free(api_client->rcv_buf);
+                        api_client->rcv_buf = NULL;
+                    }
+
+                    /* Calculate sizes, memory is allocated for entire payload */
+                    topic_size = sizeof(*topic) * (topic_len + 1);
+                    payload_size = sizeof(*payload) * (payload_total + 1);
+
+                    size = topic_size + payload_size;
+                    buf = buf_alloc(api_client, size);
+                    if (buf != NULL) {
+                        /* Topic and payload follow buffer header, offsets are in bytes */
+                        buf->topic = (const void *)((uint8_t *)buf + BUF_HDR_SIZE);
+                        buf->payload = (const void *)((uint8_t *)buf->topic + topic_size);
+                        buf->topic_len = topic_len;
+                        buf->payload_len = payload_total;
+                        buf->qos = qos;
+
+                        /* Copy topic to new memory */
+                        GSM_MEMCPY((void *)buf->topic, topic, sizeof(*topic) * topic_len);
+                    } else {
+                        GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE_WARNING,
+                            "[MQTT API] Cannot allocate memory for packet buffer of size %d bytes\r\n",
+                            (int)size);
                     }
                 } else {
-                    GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE_WARNING,
-                        "[MQTT API] Cannot allocate memory for packet buffer of size %d bytes\r\n",
-                        (int)size);
+                    buf = api_client->rcv_buf;  /* Continue with previous parts */
+                    api_client->rcv_buf = NULL;
+                }
+
+                if (buf != NULL) {
+                    GSM_MEMCPY((void *)&buf->payload[payload_off], payload, sizeof(*payload) * payload_len);
+                    if (payload_off + payload_len < payload_total) {
+                        api_client->rcv_buf = buf;  /* Wait for remaining parts */
+                    } else if (route_dispatch(api_client, buf)) {   /* Delivered to subscription callback */
+                        gsm_mqtt_client_api_buf_free(buf);
+                    } else if (!gsm_sys_mbox_putnow(&api_client->rcv_mbox, buf)) {  /* Write to receive queue */
+                        gsm_mqtt_client_api_buf_free(buf);
+                    }
                 }
             }
             break;
         }
         case GSM_MQTT_EVT_PUBLISH: {
+            gsm_mqtt_client_api_pub_t* pub = gsm_mqtt_client_evt_publish_get_argument(client, evt);
+
+            /* Asynchronous publish has request as argument, blocking publish has `NULL` */
+            if (pub != NULL) {
+                pub->res = gsm_mqtt_client_evt_publish_get_result(client, evt);
+                if (!gsm_sys_mbox_putnow(&api_client->pub_mbox, pub)) {
+                    pub->in_use = 0;            /* Cannot happen, queue is as long as requests array */
+                }
+                break;
+            }
             api_client->sub_pub_rgsm = gsm_mqtt_client_evt_publish_get_result(client, evt);
 
             /* Print debug message */
@@ -209,13 +579,35 @@ mqtt_evt(gsm_mqtt_client_p client, gsm_mqtt_evt_t* evt) {
  */
 gsm_mqtt_client_api_p
 gsm_mqtt_client_api_new(size_t tx_buff_len, size_t rx_buff_len) {
+    return gsm_mqtt_client_api_new_ex(tx_buff_len, rx_buff_len, NULL, 0);
+}
+
+/**
+ * \brief           Create new MQTT client API with preallocated receive buffers
+ *
+ * Receive buffers of each size class are allocated once, together with the client.
+ * Received packet uses smallest class large enough for topic and payload,
+ * heap memory is used only for oversized packets or when pool is exhausted.
+ *
+ * \note            All received buffers must be freed with \ref gsm_mqtt_client_api_buf_free
+ *                  before client is deleted
+ *
+ * \param[in]       tx_buff_len: Maximal TX buffer for maximal packet length
+ * \param[in]       rx_buff_len: Maximal RX buffer
+ * \param[in]       pool: Array of receive buffer size classes. Set to `NULL` to use heap only
+ * \param[in]       pool_len: Number of entries in pool array
+ * \return          Client handle on success, `NULL` otherwise
+ */
+gsm_mqtt_client_api_p
+gsm_mqtt_client_api_new_ex(size_t tx_buff_len, size_t rx_buff_len,
+                            const gsm_mqtt_client_api_pool_cfg_t* pool, size_t pool_len) {
     gsm_mqtt_client_api_p client;
     size_t size;
 
     size = GSM_MEM_ALIGN(sizeof(*client));      /* Get size of client itself */
 
     /* Create client APi structure */
-    client = gsm_mem_calloc(1, size);           /* Allocate client memory */
+    client = gsm_mem_alloc_tag(GSM_MEM_TAG_MQTT, size);    /* Allocate client memory */
     if (client != NULL) {
         /* Create MQTT raw client structure */
         client->mc = gsm_mqtt_client_new(tx_buff_len, rx_buff_len);
@@ -226,8 +618,20 @@ gsm_mqtt_client_api_new(size_t tx_buff_len, size_t rx_buff_len) {
                 if (gsm_sys_sem_create(&client->sync_sem, 5)) {
                     /* Create mutex */
                     if (gsm_sys_mutex_create(&client->mutex)) {
-                        gsm_mqtt_client_set_arg(client->mc, client);/* Set client to mqtt client argument */
-                        return client;
+                        /* Create asynchronous publish completion queue */
+                        if (gsm_sys_mbox_create(&client->pub_mbox, GSM_CFG_MQTT_MAX_REQUESTS)) {
+                            /* Create receive buffer pool */
+                            if (pool == NULL || pool_len == 0 || buf_pool_create(client, pool, pool_len) == gsmOK) {
+                                gsm_mqtt_client_set_arg(client->mc, client);/* Set client to mqtt client argument */
+                                return client;
+                            } else {
+                                GSM_DEBUGF(GSM_CFG_DBG_MQTT_API,
+                                    "[MQTT API] Cannot allocate receive buffer pool\r\n");
+                            }
+                        } else {
+                            GSM_DEBUGF(GSM_CFG_DBG_MQTT_API,
+                                "[MQTT API] Cannot allocate publish completion queue\r\n");
+                        }
                     } else {
                         GSM_DEBUGF(GSM_CFG_DBG_MQTT_API,
                             "[MQTT API] Cannot allocate mutex\r\n");
@@ -281,10 +685,24 @@ gsm_mqtt_client_api_delete(gsm_mqtt_client_api_p client) {
         gsm_sys_mbox_delete(&client->rcv_mbox);
         gsm_sys_mbox_invalid(&client->rcv_mbox);
     }
+    if (client->rcv_buf != NULL) {
+        gsm_mqtt_client_api_buf_free(client->rcv_buf);
+        client->rcv_buf = NULL;
+    }
+    if (gsm_sys_mbox_isvalid(&client->pub_mbox)) {
+        gsm_sys_mbox_delete(&client->pub_mbox);
+        gsm_sys_mbox_invalid(&client->pub_mbox);
+    }
     if (client->mc != NULL) {
         gsm_mqtt_client_delete(client->mc);
         client->mc = NULL;
     }
+    route_free(client->routes);
+    client->routes = NULL;
+    if (client->pools != NULL) {                /* Classes and buffers are in single memory block */
+        gsm_mem_free(client->pools);
+        client->pools = NULL;
+    }
     gsm_mem_free(client);
 }
 
@@ -381,8 +799,50 @@ gsm_mqtt_client_api_subscribe(gsm_mqtt_client_api_p client, const char* topic,
     return res;
 }
 
+/**
+ * \brief           Subscribe to topic and deliver matching publish packets to callback
+ *
+ * Subscription topic filter is added to router, built over topic levels.
+ * Received packets matching at least one filter are passed to callbacks
+ * instead of receive queue, read with \ref gsm_mqtt_client_api_receive.
+ * Subscribing again to the same filter replaces callback.
+ *
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       topic: Topic filter to subscribe on, may include `+` and `#` wildcards
+ * \param[in]       qos: Quality of service. This parameter can be a value of \ref gsm_mqtt_qos_t
+ * \param[in]       fn: Callback function called for every matching received packet
+ * \param[in]       arg: User argument passed to callback function
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_mqtt_client_api_subscribe_cb(gsm_mqtt_client_api_p client, const char* topic,
+                                gsm_mqtt_qos_t qos, gsm_mqtt_client_api_sub_fn fn, void* arg) {
+    gsmr_t res;
+
+    GSM_ASSERT("client != NULL", client != NULL);
+    GSM_ASSERT("topic != NULL", topic != NULL);
+    GSM_ASSERT("fn != NULL", fn != NULL);
+
+    /* Add route before subscription to not miss retained messages */
+    gsm_core_lock();
+    res = route_add(client, topic, fn, arg);
+    gsm_core_unlock();
+    if (res != gsmOK) {
+        return res;
+    }
+
+    res = gsm_mqtt_client_api_subscribe(client, topic, qos);
+    if (res != gsmOK) {
+        gsm_core_lock();
+        route_remove(&client->routes, topic, strlen(topic));
+        gsm_core_unlock();
+    }
+    return res;
+}
+
 /**
  * \brief           Unsubscribe from topic
+ * \note            Callback set with \ref gsm_mqtt_client_api_subscribe_cb for topic is removed
  * \param[in]       client: MQTT API client handle
  * \param[in]       topic: Topic to unsubscribe from
  * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
@@ -408,6 +868,11 @@ gsm_mqtt_client_api_unsubscribe(gsm_mqtt_client_api_p client, const char* topic)
     gsm_sys_sem_release(&client->sync_sem);
     gsm_sys_mutex_unlock(&client->mutex);
 
+    if (res == gsmOK) {
+        gsm_core_lock();
+        route_remove(&client->routes, topic, strlen(topic));
+        gsm_core_unlock();
+    }
     return res;
 }
 
@@ -419,7 +884,8 @@ gsm_mqtt_client_api_unsubscribe(gsm_mqtt_client_api_p client, const char* topic)
  * \param[in]       btw: Number of bytes to send for data parameter
  * \param[in]       qos: Quality of service. This parameter can be a value of \ref gsm_mqtt_qos_t
  * \param[in]       retain: Set to `1` for retain flag, `0` otherwise
- * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ * \return          \ref gsmOK on success, \ref gsmINPROG when packet is stored to offline queue,
+ *                      member of \ref gsmr_t otherwise
  */
 gsmr_t
 gsm_mqtt_client_api_publish(gsm_mqtt_client_api_p client, const char* topic, const void* data,
@@ -434,9 +900,13 @@ gsm_mqtt_client_api_publish(gsm_mqtt_client_api_p client, const char* topic, con
     gsm_sys_mutex_lock(&client->mutex);
     gsm_sys_sem_wait(&client->sync_sem, 0);
     client->release_sem = 1;
-    if (gsm_mqtt_client_publish(client->mc, topic, data, GSM_U16(btw), qos, 1, NULL) == gsmOK) {
+    res = gsm_mqtt_client_publish(client->mc, topic, data, GSM_U16(btw), qos, 1, NULL);
+    if (res == gsmOK) {
         gsm_sys_sem_wait(&client->sync_sem, 0);
         res = client->sub_pub_rgsm;
+    } else if (res == gsmINPROG) {              /* Stored to offline queue, no result event follows */
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE,
+            "[MQTT API] Packet stored to offline queue\r\n");
     } else {
         GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE_WARNING,
             "[MQTT API] Cannot publish new packet\r\n");
@@ -448,6 +918,94 @@ gsm_mqtt_client_api_publish(gsm_mqtt_client_api_p client, const char* topic, con
     return res;
 }
 
+/**
+ * \brief           Publish new packet to MQTT network without waiting for result
+ *
+ *                  Function returns as soon as packet is written to MQTT output buffer.
+ *                  Up to \ref GSM_CFG_MQTT_MAX_REQUESTS packets may be in progress at the same time.
+ *                  Every successfully started publish reports its result exactly once,
+ *                  get it with \ref gsm_mqtt_client_api_publish_get_result
+ *
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       topic: Topic to publish on
+ * \param[in]       data: Data to send. Data are copied and may be released after function returns
+ * \param[in]       btw: Number of bytes to send for data parameter
+ * \param[in]       qos: Quality of service. This parameter can be a value of \ref gsm_mqtt_qos_t
+ * \param[in]       retain: Set to `1` for retain flag, `0` otherwise
+ * \param[in]       arg: User argument returned with result to identify publish
+ * \return          \ref gsmOK on success, \ref gsmERRMEM when too many publish requests are in progress,
+ *                      \ref gsmINPROG when packet is stored to offline queue, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_mqtt_client_api_publish_async(gsm_mqtt_client_api_p client, const char* topic, const void* data,
+                            size_t btw, gsm_mqtt_qos_t qos, uint8_t retain, void* arg) {
+    gsm_mqtt_client_api_pub_t* pub = NULL;
+    gsmr_t res;
+    size_t i;
+
+    GSM_ASSERT("client != NULL", client != NULL);
+    GSM_ASSERT("topic != NULL", topic != NULL);
+    GSM_ASSERT("data != NULL", data != NULL);
+    GSM_ASSERT("btw > 0", btw > 0);
+
+    gsm_core_lock();                            /* Entries are released from MQTT callback */
+    for (i = 0; i < GSM_ARRAYSIZE(client->pubs); i++) {
+        if (!client->pubs[i].in_use) {
+            pub = &client->pubs[i];
+            pub->in_use = 1;
+            pub->arg = arg;
+            break;
+        }
+    }
+    gsm_core_unlock();
+    if (pub == NULL) {
+        return gsmERRMEM;
+    }
+
+    res = gsm_mqtt_client_publish(client->mc, topic, data, GSM_U16(btw), qos, retain, pub);
+    if (res == gsmINPROG) {                     /* Stored to offline queue, no result is reported */
+        pub->in_use = 0;
+    } else if (res != gsmOK) {
+        GSM_DEBUGF(GSM_CFG_DBG_MQTT_API_TRACE_WARNING,
+            "[MQTT API] Cannot publish new packet\r\n");
+        pub->in_use = 0;
+    }
+    return res;
+}
+
+/**
+ * \brief           Get result of next finished asynchronous publish
+ * \note            This function can be called from separate thread than \ref gsm_mqtt_client_api_publish_async
+ * \param[in]       client: MQTT API client handle
+ * \param[out]      arg: Pointer to output variable to save user argument of finished publish.
+ *                      Can be set to `NULL` if not used
+ * \param[out]      res: Pointer to output variable to save publish result. Can be set to `NULL` if not used
+ * \param[in]       timeout: Maximal time to wait for result. Set to `0` to return immediately
+ * \return          \ref gsmOK when result is available, \ref gsmTIMEOUT otherwise
+ */
+gsmr_t
+gsm_mqtt_client_api_publish_get_result(gsm_mqtt_client_api_p client, void** arg, gsmr_t* res, uint32_t timeout) {
+    gsm_mqtt_client_api_pub_t* pub;
+
+    GSM_ASSERT("client != NULL", client != NULL);
+
+    if (timeout == 0) {
+        if (!gsm_sys_mbox_getnow(&client->pub_mbox, (void **)&pub)) {
+            return gsmTIMEOUT;
+        }
+    } else if (gsm_sys_mbox_get(&client->pub_mbox, (void **)&pub, timeout) == GSM_SYS_TIMEOUT) {
+        return gsmTIMEOUT;
+    }
+    if (arg != NULL) {
+        *arg = pub->arg;
+    }
+    if (res != NULL) {
+        *res = pub->res;
+    }
+    pub->in_use = 0;                            /* Entry can be used again */
+    return gsmOK;
+}
+
 /**
  * \brief           Receive next packet in specific timeout time
  * \note            This function can be called from separate thread
@@ -493,6 +1051,18 @@ gsm_mqtt_client_api_receive(gsm_mqtt_client_api_p client, gsm_mqtt_client_api_bu
 void
 gsm_mqtt_client_api_buf_free(gsm_mqtt_client_api_buf_p p) {
     if (p != NULL) {
-        gsm_mem_free(p);
+        if (p->pbuf != NULL) {                  /* Release referenced packet buffer */
+            gsm_pbuf_free(p->pbuf);
+        }
+        if (p->pool != NULL) {                  /* Return buffer to its pool class */
+            gsm_mqtt_client_api_pool_t* pool = p->pool;
+
+            gsm_core_lock();
+            p->next = pool->free;
+            pool->free = p;
+            gsm_core_unlock();
+        } else {
+            gsm_mem_free(p);
+        }
     }
 }
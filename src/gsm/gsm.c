@@ -35,15 +35,32 @@
 #include "gsm/gsm_mem.h"
 #include "gsm/gsm_threads.h"
 #include "system/gsm_ll.h"
+#include "stddef.h"
 
 #if GSM_CFG_OS != 1
 #error GSM_CFG_OS must be set to 1!
 #endif
 
 static gsmr_t   def_callback(gsm_evt_t* cb);
-static gsm_evt_func_t def_evt_link;
 
+#if GSM_CFG_MAX_INSTANCES > 1
+static gsm_t gsm_instances[GSM_CFG_MAX_INSTANCES];
+GSM_CFG_THREAD_LOCAL gsm_t* gsmi_inst = &gsm_instances[0];
+static uint8_t sys_initialized;
+#else
 gsm_t gsm;
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+
+#if GSM_CFG_WARM_START
+#define GSM_WARM_MAGIC          0x47534D01  /* "GSM" and structure version */
+#define GSM_WARM_CFG            ((uint32_t)GSM_CFG_AT_ECHO | ((uint32_t)GSM_CFG_NETWORK_URC << 1) \
+                                    | ((uint32_t)GSM_CFG_AT_PORT_BAUDRATE_AUTO << 2))
+#endif /* GSM_CFG_WARM_START */
+
+#if GSM_CFG_CMD_EVT
+static GSM_CFG_THREAD_LOCAL gsm_api_cmd_evt_fn cmd_evt_fn;  /* Completion callback for next command of this thread */
+static GSM_CFG_THREAD_LOCAL void* cmd_evt_arg;
+#endif /* GSM_CFG_CMD_EVT */
 
 /**
  * \brief           Default callback function for events
@@ -56,37 +73,79 @@ def_callback(gsm_evt_t* cb) {
 }
 
 /**
- * \brief           Init and prepare GSM stack
- * \note            When \ref GSM_CFG_RESET_ON_INIT is enabled, reset sequence will be sent to device.
- *                  In this case, `blocking` parameter indicates if we shall wait or not for response
+ * \brief           Prepare stack memory, system objects and threads
  * \param[in]       evt_func: Event callback function
- * \param[in]       blocking: Status whether command should be blocking or not
- * \return          Member of \ref gsmr_t enumeration
  */
-gsmr_t
-gsm_init(gsm_evt_fn evt_func, uint32_t blocking) {
+static void
+init_stack(gsm_evt_fn evt_func) {
+    size_t i;
+
     gsm.status.f.initialized = 0;               /* Clear possible init flag */
     
-    def_evt_link.fn = evt_func != NULL ? evt_func : def_callback;
-    gsm.evt_func = &def_evt_link;               /* Set callback function */
+    gsm.evt_func_def.fn = evt_func != NULL ? evt_func : def_callback;
+    gsm.evt_func_def.mask = GSM_EVT_MASK_ALL;   /* Default function receives all events */
+    gsm.evt_func = &gsm.evt_func_def;           /* Set callback function */
+    gsm.evt_func_mask = GSM_EVT_MASK_ALL;
     
+#if GSM_CFG_MAX_INSTANCES > 1
+    if (!sys_initialized) {                     /* System layer is shared between instances */
+        sys_initialized = 1;
+        gsm_sys_init();                         /* Init low-level system */
+    }
+#else
     gsm_sys_init();                             /* Init low-level system */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
     gsm.ll.uart.baudrate = GSM_CFG_AT_PORT_BAUDRATE;
     gsm_ll_init(&gsm.ll);                       /* Init low-level communication */
     
+#if GSM_CFG_LOCK_DOMAINS
+    gsm_sys_mutex_create(&gsm.lock_core);       /* Create locks before any thread uses them */
+    gsm_sys_mutex_create(&gsm.lock_evt);
+    gsm_sys_mutex_create(&gsm.lock_producer);
+#if GSM_CFG_CONN
+    for (i = 0; i < GSM_CFG_MAX_CONNS; i++) {
+        gsm_sys_mutex_create(&gsm.conns[i].tx_lock);
+    }
+#endif /* GSM_CFG_CONN */
+#endif /* GSM_CFG_LOCK_DOMAINS */
     gsm_sys_sem_create(&gsm.sem_sync, 1);       /* Create new semaphore with unlocked state */
-    gsm_sys_mbox_create(&gsm.mbox_producer, GSM_CFG_THREAD_PRODUCER_MBOX_SIZE); /* Producer message queue */
+    for (i = 0; i < GSM_MSG_PRIO_END; i++) {
+        gsm_sys_mbox_create(&gsm.mbox_producer_lane[i], GSM_CFG_THREAD_PRODUCER_MBOX_SIZE);  /* Producer message queue for each lane */
+    }
+    gsm_sys_mbox_create(&gsm.mbox_producer, GSM_MSG_PRIO_END * GSM_CFG_THREAD_PRODUCER_MBOX_SIZE);  /* Producer wakeup queue */
     gsm_sys_thread_create(&gsm.thread_producer, "gsm_producer", (gsm_sys_thread_fn)gsm_thread_producer, &gsm, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO);
 
+#if !GSM_SYS_THREAD_NOTIFY
     gsm_sys_mbox_create(&gsm.mbox_process, GSM_CFG_THREAD_PROCESS_MBOX_SIZE);   /* Consumer message queue */
+#endif /* !GSM_SYS_THREAD_NOTIFY */
     gsm_sys_thread_create(&gsm.thread_process,  "gsm_process", (gsm_sys_thread_fn)gsm_thread_process, &gsm, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO);
 
+#if GSM_CFG_EVT_DEFERRED
+    gsm_sys_mbox_create(&gsm.mbox_evt, GSM_CFG_THREAD_EVT_MBOX_SIZE);   /* Deferred event queue */
+    gsm_sys_thread_create(&gsm.thread_evt, "gsm_evt", (gsm_sys_thread_fn)gsm_thread_evt, &gsm, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO);
+#endif /* GSM_CFG_EVT_DEFERRED */
+
 #if !GSM_CFG_INPUT_USE_PROCESS
-    gsm_buff_init(&gsm.buff, GSM_CFG_RCV_BUFF_SIZE);    /* Init buffer for input data */
+    GSMI_BUFF_FN(gsm_buff_init)(&gsm.buff, GSM_CFG_RCV_BUFF_SIZE);  /* Init buffer for input data */
 #endif /* !GSM_CFG_INPUT_USE_PROCESS */
     gsm.status.f.initialized = 1;               /* We are initialized now */
     gsm.status.f.dev_present = 1;               /* We assume device is present at this point */
-    
+}
+
+/**
+ * \brief           Init and prepare GSM stack
+ * \note            When \ref GSM_CFG_MAX_INSTANCES is greater than `1`, currently selected instance is initialized.
+ *                  Use \ref gsm_instance_select before calling this function to init other than default instance
+ * \note            When \ref GSM_CFG_RESET_ON_INIT is enabled, reset sequence will be sent to device.
+ *                  In this case, `blocking` parameter indicates if we shall wait or not for response
+ * \param[in]       evt_func: Event callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          Member of \ref gsmr_t enumeration
+ */
+gsmr_t
+gsm_init(gsm_evt_fn evt_func, uint32_t blocking) {
+    init_stack(evt_func);
+
     /*
      * Call reset command and call default
      * AT commands to prepare basic setup for device
@@ -103,8 +162,131 @@ gsm_init(gsm_evt_fn evt_func, uint32_t blocking) {
     return gsmOK;
 }
 
+#if GSM_CFG_WARM_START || __DOXYGEN__
+
+/**
+ * \brief           Calculate checksum of warm start state
+ * \param[in]       state: State to calculate checksum for
+ * \return          FNV-1a hash of all fields before `check` field
+ */
+static uint32_t
+warm_state_check(const gsm_warm_state_t* state) {
+    const uint8_t* d = (const uint8_t *)state;
+    uint32_t hash = 0x811C9DC5;
+
+    for (size_t i = 0; i < offsetof(gsm_warm_state_t, check); i++) {
+        hash = (hash ^ d[i]) * 0x01000193;
+    }
+    return hash;
+}
+
+/**
+ * \brief           Send warm start command sequence
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+warm_start_cmd(uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_WARM_START;
+    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_AT_SYNC; /* Single liveness check */
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Init GSM stack and start device without reset when possible
+ *
+ *                  When `state` is valid, device identity and AT port baudrate are restored from it
+ *                  and device is only checked with single `AT` command followed by SIM state query.
+ *                  If device does not respond or has lost its configuration,
+ *                  full reset sequence is started instead, same as in \ref gsm_init.
+ *
+ *                  SIM information queries are deferred until \ref GSM_EVT_INIT_FINISH event has been sent
+ *
+ * \note            When `state` is `NULL` or not valid, function behaves as \ref gsm_init with reset on init
+ * \param[in]       evt_func: Event callback function
+ * \param[in]       state: State previously saved with \ref gsm_warm_state_get. Set to `NULL` for cold start
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          Member of \ref gsmr_t enumeration
+ */
+gsmr_t
+gsm_init_warm(gsm_evt_fn evt_func, const gsm_warm_state_t* state, uint32_t blocking) {
+    init_stack(evt_func);
+
+    if (state != NULL && state->magic == GSM_WARM_MAGIC && state->cfg == GSM_WARM_CFG
+        && state->check == warm_state_check(state)) {
+        GSM_CORE_PROTECT();
+        GSM_MEMCPY(gsm.model_manufacturer, state->model_manufacturer, sizeof(gsm.model_manufacturer));
+        GSM_MEMCPY(gsm.model_number, state->model_number, sizeof(gsm.model_number));
+        GSM_MEMCPY(gsm.model_serial_number, state->model_serial_number, sizeof(gsm.model_serial_number));
+        gsm.model_manufacturer[sizeof(gsm.model_manufacturer) - 1] = 0;
+        gsm.model_number[sizeof(gsm.model_number) - 1] = 0;
+        gsm.model_serial_number[sizeof(gsm.model_serial_number) - 1] = 0;
+        if (state->baudrate != gsm.ll.uart.baudrate) {
+            gsm.ll.uart.baudrate = state->baudrate;
+            gsm_ll_init(&gsm.ll);               /* Continue on baudrate device was left at */
+        }
+        gsm.warm.hold = GSM_WARM_HOLD_SEQ | GSM_WARM_HOLD_INIT;
+        gsm.warm.echo = 0;
+        gsm.warm.sim_info = 0;
+        GSM_CORE_UNPROTECT();
+
+        if (warm_start_cmd(blocking) != gsmOK) {
+            GSM_CORE_PROTECT();
+            gsmi_warm_release(GSM_WARM_HOLD_SEQ);
+            GSM_CORE_UNPROTECT();
+        }
+    } else {
+        gsm_reset_with_delay(GSM_CFG_RESET_DELAY_DEFAULT, blocking);    /* Cold start */
+    }
+    gsmi_send_cb(GSM_EVT_INIT_FINISH);          /* Call user callback function */
+
+    GSM_CORE_PROTECT();
+    gsmi_warm_release(GSM_WARM_HOLD_INIT);      /* Start deferred queries */
+    GSM_CORE_UNPROTECT();
+    return gsmOK;
+}
+
+/**
+ * \brief           Get device state to be used on next warm start
+ *
+ *                  Call this function before putting system to sleep
+ *                  and keep `state` in memory which is retained until next startup
+ *
+ * \param[out]      state: Pointer to state structure to fill
+ * \return          \ref gsmOK on success, \ref gsmERR if device has not been identified yet
+ */
+gsmr_t
+gsm_warm_state_get(gsm_warm_state_t* state) {
+    gsmr_t res = gsmERR;
+
+    GSM_ASSERT("state != NULL", state != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();
+    if (gsm.model_manufacturer[0]) {            /* Device must be identified */
+        GSM_MEMSET(state, 0x00, sizeof(*state));
+        state->magic = GSM_WARM_MAGIC;
+        state->cfg = GSM_WARM_CFG;
+        state->baudrate = gsm.ll.uart.baudrate;
+        GSM_MEMCPY(state->model_manufacturer, gsm.model_manufacturer, sizeof(state->model_manufacturer));
+        GSM_MEMCPY(state->model_number, gsm.model_number, sizeof(state->model_number));
+        GSM_MEMCPY(state->model_serial_number, gsm.model_serial_number, sizeof(state->model_serial_number));
+        state->check = warm_state_check(state);
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();
+    return res;
+}
+
+#endif /* GSM_CFG_WARM_START || __DOXYGEN__ */
+
 /**
  * \brief           Execute reset and send default commands
+ * \note            Reset is executed before commands already waiting in producer queue,
+ *                  see \ref gsm_msg_prio_t
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
  */
@@ -115,6 +297,8 @@ gsm_reset(uint32_t blocking) {
 
 /**
  * \brief           Execute reset and send default commands with delay
+ * \note            Reset is executed before commands already waiting in producer queue,
+ *                  see \ref gsm_msg_prio_t
  * \param[in]       delay: Number of milliseconds to wait before initiating first command to device
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
@@ -158,6 +342,18 @@ gsm_core_unlock(void) {
     return gsmOK;
 }
 
+/**
+ * \brief           Recalculate union of all registered event masks
+ * \note            Event list must be protected when function is called
+ */
+static void
+evt_update_mask(void) {
+    gsm.evt_func_mask = 0;
+    for (gsm_evt_func_t* func = gsm.evt_func; func != NULL; func = func->next) {
+        gsm.evt_func_mask |= func->mask;
+    }
+}
+
 /**
  * \brief           Register callback function for global (non-connection based) events
  * \param[in]       fn: Callback function to call on specific event
@@ -166,25 +362,57 @@ gsm_core_unlock(void) {
 gsmr_t
 gsm_evt_register(gsm_evt_fn fn) {
     gsmr_t res = gsmOK;
+
+    GSM_ASSERT("cb_fn != NULL", fn != NULL);    /* Assert input parameters */
+
+    GSM_EVT_PROTECT();                          /* Lock event list */
+    /* Check if function already exists on list */
+    for (gsm_evt_func_t* func = gsm.evt_func; func != NULL; func = func->next) {
+        if (func->fn == fn) {
+            res = gsmERR;
+            break;
+        }
+    }
+    if (res == gsmOK) {
+        res = gsm_evt_register_mask(fn, GSM_EVT_MASK_ALL);
+    }
+    GSM_EVT_UNPROTECT();                        /* Unlock event list */
+    return res;
+}
+
+/**
+ * \brief           Register callback function for selected global events only
+ *
+ *                  Function is called only for event types included in mask.
+ *                  If function is already registered, its mask is replaced
+ *
+ * \param[in]       fn: Callback function to call on specific event
+ * \param[in]       mask: Event types to subscribe to. Use \ref GSM_EVT_MASK to build mask
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_evt_register_mask(gsm_evt_fn fn, gsm_evt_mask_t mask) {
+    gsmr_t res = gsmOK;
     gsm_evt_func_t* func, *newFunc;
     
     GSM_ASSERT("cb_fn != NULL", fn != NULL);    /* Assert input parameters */
     
-    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    GSM_EVT_PROTECT();                          /* Lock event list */
     
     /* Check if function already exists on list */
     for (func = gsm.evt_func; func != NULL; func = func->next) {
         if (func->fn == fn) {
-            res = gsmERR;
+            func->mask = mask;                  /* Update subscription only */
             break;
         }
     }
     
-    if (res == gsmOK) {
-        newFunc = gsm_mem_alloc(sizeof(*newFunc));  /* Get memory for new function */
+    if (func == NULL) {
+        newFunc = gsm_mem_alloc_tag(GSM_MEM_TAG_CORE, sizeof(*newFunc));  /* Get memory for new function */
         if (newFunc != NULL) {
             memset(newFunc, 0x00, sizeof(*newFunc));/* Reset memory */
             newFunc->fn = fn;                   /* Set function pointer */
+            newFunc->mask = mask;
             if (gsm.evt_func == NULL) {
                 gsm.evt_func = newFunc;         /* This should never happen! */
             } else {
@@ -196,7 +424,8 @@ gsm_evt_register(gsm_evt_fn fn) {
             res = gsmERRMEM;
         }
     }
-    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+    evt_update_mask();
+    GSM_EVT_UNPROTECT();                        /* Unlock event list */
     return res;
 }
 
@@ -211,7 +440,7 @@ gsm_evt_unregister(gsm_evt_fn fn) {
     gsm_evt_func_t* func, *prev;
     GSM_ASSERT("cb_fn != NULL", fn != NULL);    /* Assert input parameters */
     
-    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    GSM_EVT_PROTECT();                          /* Lock event list */
     for (prev = gsm.evt_func, func = gsm.evt_func->next; func != NULL; prev = func, func = func->next) {
         if (func->fn == fn) {
             prev->next = func->next;
@@ -220,10 +449,184 @@ gsm_evt_unregister(gsm_evt_fn fn) {
             break;
         }
     }
+    evt_update_mask();
+    GSM_EVT_UNPROTECT();                        /* Unlock event list */
+    return gsmOK;
+}
+
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Check if event data remain valid after processing thread continues
+ *
+ *                  Deferred event is copied by value. Events pointing to command message
+ *                  or user memory owned by blocking call cannot be deferred
+ *
+ * \param[in]       type: Event type
+ * \return          `1` if event can be deferred, `0` otherwise
+ */
+static uint8_t
+evt_is_deferrable(gsm_evt_type_t type) {
+    switch (type) {
+        case GSM_EVT_NETWORK_OPERATOR_SCAN:
+#if GSM_CFG_CONN
+        case GSM_EVT_CONN_ERROR:
+#endif /* GSM_CFG_CONN */
+#if GSM_CFG_SMS
+        case GSM_EVT_SMS_READ:
+        case GSM_EVT_SMS_LIST:
+#if GSM_CFG_SMS_PDU
+        case GSM_EVT_SMS_SEND_BATCH:
+#endif /* GSM_CFG_SMS_PDU */
+#endif /* GSM_CFG_SMS */
+#if GSM_CFG_PHONEBOOK
+        case GSM_EVT_PB_LIST:
+        case GSM_EVT_PB_SEARCH:
+#endif /* GSM_CFG_PHONEBOOK */
+#if GSM_CFG_PING
+        case GSM_EVT_LINK_QUALITY:
+#endif /* GSM_CFG_PING */
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * \brief           Select if event type is dispatched from deferred event thread
+ *
+ *                  Callbacks for deferred event are called from separate thread without core protection,
+ *                  while processing thread continues to parse received data.
+ *                  Use direct call (default) for latency sensitive events
+ *
+ *                  Event data are copied, so only events without pointers to transient memory can be deferred.
+ *                  These are events with plain values, connection events and events pointing to library state,
+ *                  such as \ref GSM_EVT_NETWORK_OPERATOR_CURRENT and \ref GSM_EVT_CALL_CHANGED.
+ *                  \ref GSM_EVT_NETWORK_OPERATOR_SCAN, \ref GSM_EVT_CONN_ERROR, \ref GSM_EVT_SMS_READ,
+ *                  \ref GSM_EVT_SMS_LIST, \ref GSM_EVT_SMS_SEND_BATCH, \ref GSM_EVT_PB_LIST,
+ *                  \ref GSM_EVT_PB_SEARCH and \ref GSM_EVT_LINK_QUALITY are always called directly
+ *
+ * \note            Return value of deferred callback is ignored
+ * \note            Packet buffer of \ref GSM_EVT_CONN_DATA_RECV event stays valid until callback returns.
+ *                  Connection events are dropped if connection was reused before dispatch.
+ *                  Pointers to library state reference its value at the time of dispatch
+ *
+ * \param[in]       type: Event type. Member of \ref gsm_evt_type_t enumeration
+ * \param[in]       deferred: Set to `1` to call callbacks from event thread or `0` to call them directly
+ * \return          \ref gsmOK on success, \ref gsmPARERR if event type cannot be deferred,
+ *                  member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_evt_set_deferred(gsm_evt_type_t type, uint8_t deferred) {
+    if ((size_t)type >= sizeof(gsm_evt_mask_t) * 8 || (deferred && !evt_is_deferrable(type))) {
+        return gsmPARERR;
+    }
+    GSM_EVT_PROTECT();                          /* Lock event list */
+    if (deferred) {
+        gsm.evt_deferred_mask |= GSM_EVT_MASK(type);
+    } else {
+        gsm.evt_deferred_mask &= ~GSM_EVT_MASK(type);
+    }
+    GSM_EVT_UNPROTECT();                        /* Unlock event list */
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
+
+/**
+ * \brief           Get statistics of producer message queue lane
+ * \param[in]       prio: Lane to get statistics for. Member of \ref gsm_msg_prio_t enumeration
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_get_msg_lane_stats(gsm_msg_prio_t prio, gsm_msg_lane_stats_t* stats) {
+    if (prio >= GSM_MSG_PRIO_END || stats == NULL) {
+        return gsmPARERR;
+    }
+    GSM_PRODUCER_PROTECT();                     /* Lock producer queues */
+    *stats = gsm.producer_lane_stats[prio];
+    GSM_PRODUCER_UNPROTECT();                   /* Unlock producer queues */
+    return gsmOK;
+}
+
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+
+/**
+ * \brief           Get latency statistics of API command
+ *
+ *                  Statistics are kept for first \ref GSM_CFG_CMD_STATS_NUM different commands.
+ *                  Read entries from index `0` on until function returns \ref gsmPARERR
+ *
+ * \param[in]       index: Index of statistics entry
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_get_cmd_stats(size_t index, gsm_cmd_stats_t* stats) {
+    gsmr_t res = gsmPARERR;
+
+    if (stats == NULL) {
+        return gsmPARERR;
+    }
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    if (index < gsm.cmd_stats_num) {
+        *stats = gsm.cmd_stats[index];
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+    return res;
+}
+
+/**
+ * \brief           Clear latency statistics of all commands
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_reset_cmd_stats(void) {
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    memset(gsm.cmd_stats, 0x00, sizeof(gsm.cmd_stats));
+    gsm.cmd_stats_num = 0;
     GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
     return gsmOK;
 }
 
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
+
+#if GSM_SYS_RUNTIME_STATS || __DOXYGEN__
+
+/**
+ * \brief           Get stack high-water marks, run time of internal threads and occupancy of internal message queues
+ *
+ *                  Values are measured by system port, see \ref GSM_SYS.
+ *                  Entries of objects which do not exist in current configuration are set to `0`
+ *
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_get_runtime_stats(gsm_runtime_stats_t* stats) {
+    GSM_ASSERT("stats != NULL", stats != NULL); /* Assert input parameters */
+
+    GSM_MEMSET(stats, 0x00, sizeof(*stats));
+    if (!gsm.status.f.initialized) {
+        return gsmERR;
+    }
+    gsm_sys_thread_get_stats(&gsm.thread_producer, &stats->thread_producer);
+    gsm_sys_thread_get_stats(&gsm.thread_process, &stats->thread_process);
+    gsm_sys_mbox_get_stats(&gsm.mbox_producer, &stats->mbox_producer);
+    if (gsm_sys_mbox_isvalid(&gsm.mbox_process)) {
+        gsm_sys_mbox_get_stats(&gsm.mbox_process, &stats->mbox_process);
+    }
+#if GSM_CFG_EVT_DEFERRED
+    gsm_sys_thread_get_stats(&gsm.thread_evt, &stats->thread_evt);
+    gsm_sys_mbox_get_stats(&gsm.mbox_evt, &stats->mbox_evt);
+#endif /* GSM_CFG_EVT_DEFERRED */
+    return gsmOK;
+}
+
+#endif /* GSM_SYS_RUNTIME_STATS || __DOXYGEN__ */
+
 /**
  * \brief           Delay for amount of milliseconds
  * \param[in]       ms: Milliseconds to delay
@@ -239,6 +642,128 @@ gsm_delay(uint32_t ms) {
     }
 }
 
+#if GSM_CFG_CMD_EVT || __DOXYGEN__
+
+/**
+ * \brief           Set completion callback for next command started by current thread
+ *
+ *                  Callback is attached to next API call which sends command to producer queue
+ *                  and is called with command result from producer thread.
+ *                  It is called only when API function returned \ref gsmOK,
+ *                  for blocking and non-blocking calls
+ *
+ * \note            When API function fails before command is allocated (invalid parameters),
+ *                  callback stays pending. Call this function with `NULL` to clear it.
+ *                  \ref gsm_conn_write never takes pending callback
+ * \param[in]       fn: Callback function to call or `NULL` to clear pending callback
+ * \param[in]       arg: Custom user argument passed to callback
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_set_cmd_evt(gsm_api_cmd_evt_fn fn, void* arg) {
+    cmd_evt_fn = fn;
+    cmd_evt_arg = arg;
+    return gsmOK;
+}
+
+/**
+ * \brief           Move pending completion callback of current thread to new message
+ * \param[in]       msg: Newly allocated message or `NULL` to only clear pending callback
+ */
+void
+gsmi_msg_take_cmd_evt(gsm_msg_t* msg) {
+    if (msg != NULL) {
+        msg->evt_fn = cmd_evt_fn;
+        msg->evt_arg = cmd_evt_arg;
+    }
+    cmd_evt_fn = NULL;
+    cmd_evt_arg = NULL;
+}
+
+/**
+ * \brief           Exchange pending completion callback of current thread
+ *
+ *                  Used to keep callback for last command
+ *                  when API function internally queues more commands
+ *
+ * \param[in,out]   fn: Callback to set as pending, replaced with previously pending one
+ * \param[in,out]   arg: Argument to set as pending, replaced with previously pending one
+ */
+void
+gsmi_cmd_evt_swap(gsm_api_cmd_evt_fn* fn, void** arg) {
+    gsm_api_cmd_evt_fn f = cmd_evt_fn;
+    void* a = cmd_evt_arg;
+
+    cmd_evt_fn = *fn;
+    cmd_evt_arg = *arg;
+    *fn = f;
+    *arg = a;
+}
+
+#endif /* GSM_CFG_CMD_EVT || __DOXYGEN__ */
+
+#if GSM_CFG_MAX_INSTANCES > 1 || __DOXYGEN__
+
+/**
+ * \brief           Get handle of device instance
+ * \param[in]       index: Instance index, `0` is default instance. Must be less than \ref GSM_CFG_MAX_INSTANCES
+ * \return          Instance handle on success, `NULL` otherwise
+ */
+gsm_instance_p
+gsm_instance_get(size_t index) {
+    if (index >= GSM_ARRAYSIZE(gsm_instances)) {
+        return NULL;
+    }
+    return &gsm_instances[index];
+}
+
+/**
+ * \brief           Select device instance used by all GSM API calls from current thread
+ *
+ *                  Each thread keeps its own selection. Threads which never
+ *                  select any instance operate on default instance
+ *
+ * \note            Low-level driver thread which feeds received data with \ref gsm_input
+ *                  or \ref gsm_input_process must select instance which owns AT port.
+ *                  Inside \ref gsm_ll_init, owner is returned by \ref gsm_instance_current
+ * \param[in]       inst: Instance handle to select. Set to `NULL` to select default instance
+ * \return          Previously selected instance handle
+ */
+gsm_instance_p
+gsm_instance_select(gsm_instance_p inst) {
+    gsm_t* prev = gsmi_inst;
+
+    gsmi_inst = inst != NULL ? inst : &gsm_instances[0];
+    return prev;
+}
+
+/**
+ * \brief           Get device instance selected for current thread
+ * \return          Selected instance handle
+ */
+gsm_instance_p
+gsm_instance_current(void) {
+    return gsmi_inst;
+}
+
+/**
+ * \brief           Get index of device instance
+ *
+ *                  Low-level drivers use it to find state of AT port owned by instance
+ *
+ * \param[in]       inst: Instance handle. Set to `NULL` to get index of instance selected for current thread
+ * \return          Instance index, `0` is default instance
+ */
+size_t
+gsm_instance_get_index(gsm_instance_p inst) {
+    if (inst == NULL) {
+        inst = gsmi_inst;
+    }
+    return (size_t)(inst - gsm_instances);
+}
+
+#endif /* GSM_CFG_MAX_INSTANCES > 1 || __DOXYGEN__ */
+
 /**
  * \brief           Set modem function mode
  * \note            Use this function to set modem to normal or low-power mode
@@ -318,5 +843,5 @@ gsm_set_at_baudrate(uint32_t baud, uint32_t blocking) {
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_UART;
     GSM_MSG_VAR_REF(msg).msg.uart.baudrate = baud;
 
-    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 2000);    /* Send message to producer queue */
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 5000);    /* Send message to producer queue */
 }
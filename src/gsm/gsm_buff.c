@@ -38,6 +38,24 @@
 #define GSM_CFG_DBG_BUFF        GSM_CFG_DBG_OFF
 #endif
 
+/*
+ * Buffer is safe for single producer and single consumer without locking.
+ *
+ * Producer (write, advance) only modifies input pointer,
+ * consumer (read, skip) only modifies output pointer.
+ * Both sides take local copy of pointers and publish new value
+ * only after data memory has been accessed, with memory barrier in between.
+ */
+#define BUFF_BARRIER()          GSM_CFG_MEMORY_BARRIER()
+
+/**
+ * \brief           Get number of bytes ready to read for pointer snapshot
+ * \param[in]       size: Buffer size
+ * \param[in]       in: Input pointer
+ * \param[in]       out: Output pointer
+ */
+#define BUFF_FULL(size, in, out)    ((in) >= (out) ? ((in) - (out)) : ((size) - ((out) - (in))))
+
 /**
  * \brief           Initialize buffer
  * \param[in]       buff: Pointer to buffer structure
@@ -52,7 +70,7 @@ gsm_buff_init(gsm_buff_t* buff, size_t size) {
     GSM_MEMSET(buff, 0, sizeof(*buff));         /* Set buffer values to all zeros */
 
     buff->size = size;                          /* Set default values */
-    buff->buff = gsm_mem_alloc(sizeof(buff->buff) * size);  /* Allocate memory for buffer */
+    buff->buff = gsm_mem_alloc_tag(GSM_MEM_TAG_CORE, sizeof(buff->buff) * size);  /* Allocate memory for buffer */
     if (buff->buff == NULL) {                   /* Check allocation */
         return 0;
     }
@@ -74,6 +92,8 @@ gsm_buff_free(gsm_buff_t* buff) {
 
 /**
  * \brief           Write data to buffer
+ * \note            Function may be called from interrupt context
+ *                  when buffer has single writer
  * \param[in]       buff: Pointer to buffer structure
  * \param[in]       data: Pointer to data to copy memory from
  * \param[in]       count: Number of bytes we want to write
@@ -81,19 +101,15 @@ gsm_buff_free(gsm_buff_t* buff) {
  */
 size_t
 gsm_buff_write(gsm_buff_t* buff, const void* data, size_t count) {
-	size_t i = 0;
-	size_t free;
     const uint8_t* d = data;
-    size_t tocopy;
+    size_t free, tocopy, in;
 
     if (buff == NULL || count == 0) {           /* Check buffer structure */
         return 0;
     }
-    if (buff->in >= buff->size) {               /* Check input pointer */
-        buff->in = 0;
-    }
+    in = buff->in;                              /* Only writer modifies input pointer */
     free = gsm_buff_get_free(buff);             /* Get free memory */
-    if (free < count) {                         /* Check available memory */	
+    if (free < count) {                         /* Check available memory */
         if (free == 0) {                        /* If no memory, stop execution */
             return 0;
         }
@@ -101,22 +117,18 @@ gsm_buff_write(gsm_buff_t* buff, const void* data, size_t count) {
     }
 
     /* We have calculated memory for write */
-    tocopy = buff->size - buff->in;             /* Calculate number of elements we can put at the end of buffer */
-    if (tocopy > count) {                       /* Check for copy count */
-        tocopy = count;
-    }
-    GSM_MEMCPY(&buff->buff[buff->in], d, tocopy);   /* Copy content to buffer */
-    i += tocopy;                                /* Increase number of bytes we copied already */
-    buff->in += tocopy;	
-    count -= tocopy;
-    if (count > 0) {                            /* Check if anything to write */	
-        GSM_MEMCPY(buff->buff, (void *)&d[i], count);   /* Copy content */
-        buff->in = count;									/* Set input pointer */
+    tocopy = GSM_MIN(buff->size - in, count);   /* Calculate number of elements we can put at the end of buffer */
+    GSM_MEMCPY(&buff->buff[in], d, tocopy);     /* Copy content to buffer */
+    if (count > tocopy) {                       /* Check if anything to write */
+        GSM_MEMCPY(buff->buff, &d[tocopy], count - tocopy); /* Copy content */
     }
-    if (buff->in >= buff->size) {               /* Check input overflow */
-        buff->in = 0;
+    in += count;
+    if (in >= buff->size) {                     /* Check input overflow */
+        in -= buff->size;
     }
-    return (i + count);                         /* Return number of elements stored in memory */
+    BUFF_BARRIER();                             /* Data must be in memory before they are published */
+    buff->in = in;
+    return count;                               /* Return number of elements stored in memory */
 }
 
 /**
@@ -128,40 +140,8 @@ gsm_buff_write(gsm_buff_t* buff, const void* data, size_t count) {
  */
 size_t
 gsm_buff_read(gsm_buff_t* buff, void* data, size_t count) {
-    uint8_t *d = data;
-    size_t i = 0, full;
-    size_t tocopy;
-
-    if (buff == NULL || count == 0) {           /* Check buffer structure */
-        return 0;
-    }
-    if (buff->out >= buff->size) {              /* Check output pointer */
-        buff->out = 0;
-    }
-    full = gsm_buff_get_full(buff);             /* Get free memory */
-    if (full < count) {                         /* Check available memory */
-        if (full == 0) {                        /* If no memory, stop execution */
-            return 0;
-        }
-        count = full;                           /* Set values for write */
-    }
-
-    tocopy = buff->size - buff->out;            /* Calculate number of elements we can read from end of buffer */
-    if (tocopy > count) {                       /* Check for copy count */
-        tocopy = count;
-    }
-    GSM_MEMCPY(d, &buff->buff[buff->out], tocopy);  /* Copy content from buffer */
-    i += tocopy;                                /* Increase number of bytes we copied already */
-    buff->out += tocopy;
-    count -= tocopy;
-    if (count > 0) {                            /* Check if anything to read */
-        GSM_MEMCPY(&d[i], buff->buff, count);   /* Copy content */
-        buff->out = count;                      /* Set input pointer */
-    }
-    if (buff->out >= buff->size) {              /* Check output overflow */
-        buff->out = 0;
-    }
-    return i + count;                           /* Return number of elements stored in memory */
+    count = gsm_buff_peek(buff, 0, data, count);/* Copy data from buffer */
+    return gsm_buff_skip(buff, count);          /* Release memory for writer */
 }
 
 /**
@@ -175,16 +155,13 @@ gsm_buff_read(gsm_buff_t* buff, void* data, size_t count) {
 size_t
 gsm_buff_peek(gsm_buff_t* buff, size_t skip_count, void* data, size_t count) {
     uint8_t *d = data;
-    size_t i = 0, full, tocopy, out;
+    size_t full, tocopy, out;
 
     if (buff == NULL || count == 0) {           /* Check buffer structure */
         return 0;
     }
-    out = buff->out;
-    if (buff->out >= buff->size) {              /* Check output pointer */
-        buff->out = 0;
-    }
-    full = gsm_buff_get_full(buff);             /* Get free memory */
+    out = buff->out;                            /* Only reader modifies output pointer */
+    full = gsm_buff_get_full(buff);             /* Get full memory */
     if (skip_count >= full) {                   /* We cannot skip for more than we have in buffer */
         return 0;
     }
@@ -193,24 +170,14 @@ gsm_buff_peek(gsm_buff_t* buff, size_t skip_count, void* data, size_t count) {
     if (out >= buff->size) {                    /* Check overflow */
         out -= buff->size;                      /* Go to beginning */
     }
-    if (full < count) {                         /* Check available memory */
-        if (full == 0) {                        /* If no memory, stop execution */
-            return 0;
-        }
-        count = full;                           /* Set values for write */
-    }
+    count = GSM_MIN(count, full);
 
-    tocopy = buff->size - out;                  /* Calculate number of elements we can read from end of buffer */
-    if (tocopy > count) {                       /* Check for copy count */
-        tocopy = count;
-    }
+    tocopy = GSM_MIN(buff->size - out, count);  /* Calculate number of elements we can read from end of buffer */
     GSM_MEMCPY(d, &buff->buff[out], tocopy);    /* Copy content from buffer */
-    i += tocopy;                                /* Increase number of bytes we copied already */
-    count -= tocopy;
-    if (count > 0) {                            /* Check if anything to read */
-        GSM_MEMCPY(&d[i], buff->buff, count);   /* Copy content */
+    if (count > tocopy) {                       /* Check if anything to read */
+        GSM_MEMCPY(&d[tocopy], buff->buff, count - tocopy); /* Copy content */
     }
-    return i + count;                           /* Return number of elements stored in memory */
+    return count;                               /* Return number of elements stored in memory */
 }
 
 /**
@@ -220,21 +187,14 @@ gsm_buff_peek(gsm_buff_t* buff, size_t skip_count, void* data, size_t count) {
  */
 size_t
 gsm_buff_get_free(gsm_buff_t* buff) {
-    size_t size, in, out;
+    size_t in, out;
 
-    if (buff == NULL) {                         /* Check buffer structure */
+    if (buff == NULL || buff->size == 0) {      /* Check buffer structure */
         return 0;
     }
     in = buff->in;                              /* Save values */
     out = buff->out;
-    if (in == out) {                            /* Check if the same */
-        size = buff->size;
-    } else if (out > in) {                      /* Check normal mode */
-        size = out - in;
-    } else {                                    /* Check if overflow mode */
-        size = buff->size - (in - out);
-    }
-    return size - 1;                            /* Return free memory */
+    return buff->size - 1 - BUFF_FULL(buff->size, in, out); /* One byte is always kept empty */
 }
 
 /**
@@ -244,34 +204,30 @@ gsm_buff_get_free(gsm_buff_t* buff) {
  */
 size_t
 gsm_buff_get_full(gsm_buff_t* buff) {
-    size_t in, out, size;
+    size_t in, out;
 
     if (buff == NULL) {                         /* Check buffer structure */
         return 0;
     }
     in = buff->in;                              /* Save values */
     out = buff->out;
-    if (in == out) {                            /* Pointer are same? */
-        size = 0;
-    } else if (in > out) {                      /* buff is not in overflow mode */
-        size = in - out;
-    } else {                                    /* buff is in overflow mode */
-        size = buff->size - (out - in);
-    }
-    return size;                                /* Return number of elements in buffer */
+    BUFF_BARRIER();                             /* Read data only after input pointer */
+    return BUFF_FULL(buff->size, in, out);      /* Return number of elements in buffer */
 }
 
 /**
  * \brief           Resets and clears buffer
+ * \note            Function modifies both pointers and
+ *                  may not be called while writer or reader is active
  * \param[in]       buff: Pointer to buffer structure
  */
 void
 gsm_buff_reset(gsm_buff_t* buff) {
-	if (buff == NULL) {                         /* Check buffer structure */
-		return;
-	}
-	buff->in = 0;                               /* Reset values */
-	buff->out = 0;
+    if (buff == NULL) {                         /* Check buffer structure */
+        return;
+    }
+    buff->in = 0;                               /* Reset values */
+    buff->out = 0;
 }
 
 /**
@@ -291,15 +247,12 @@ gsm_buff_get_linear_block_address(gsm_buff_t* buff) {
  */
 size_t
 gsm_buff_get_linear_block_length(gsm_buff_t* buff) {
-    size_t len;
-    if (buff->in > buff->out) {
-        len = buff->in - buff->out;
-    } else if (buff->out > buff->in) {
-        len = buff->size - buff->out;
-    } else {
-        len = 0;
-    }
-    return len;
+    size_t in, out;
+
+    in = buff->in;                              /* Save values */
+    out = buff->out;
+    BUFF_BARRIER();                             /* Read data only after input pointer */
+    return in >= out ? (in - out) : (buff->size - out);
 }
 
 /**
@@ -311,14 +264,276 @@ gsm_buff_get_linear_block_length(gsm_buff_t* buff) {
  */
 size_t
 gsm_buff_skip(gsm_buff_t* buff, size_t len) {
-    size_t full;
+    size_t full, out;
+
+    if (buff == NULL || len == 0) {
+        return 0;
+    }
+    out = buff->out;
     full = gsm_buff_get_full(buff);             /* Get buffer used length */
-    if (len > full) {
-        len = full;
+    len = GSM_MIN(len, full);
+    out += len;                                 /* Advance buffer */
+    if (out >= buff->size) {                    /* Subtract possible overflow */
+        out -= buff->size;                      /* Do subtract */
+    }
+    BUFF_BARRIER();                             /* Data must be read before memory is released */
+    buff->out = out;
+    return len;
+}
+
+/**
+ * \brief           Get linear address for buffer for fast write, for example with DMA
+ * \note            Use \ref gsm_buff_advance after data are written
+ * \param[in]       buff: Pointer to buffer
+ * \return          Pointer to start of linear address to write to
+ */
+void *
+gsm_buff_get_linear_block_write_address(gsm_buff_t* buff) {
+    return &buff->buff[buff->in];               /* Return write address */
+}
+
+/**
+ * \brief           Get length of free linear block at write address before it overflows
+ * \param[in]       buff: Pointer to buffer
+ * \return          Number of bytes which can be written to linear write address
+ */
+size_t
+gsm_buff_get_linear_block_write_length(gsm_buff_t* buff) {
+    size_t in, out, len;
+
+    in = buff->in;                              /* Save values */
+    out = buff->out;
+    if (in >= out) {
+        len = buff->size - in;                  /* Until end of memory ... */
+        if (out == 0) {
+            len--;                              /* ... but keep one byte empty before output pointer */
+        }
+    } else {
+        len = out - in - 1;
+    }
+    return len;
+}
+
+/**
+ * \brief           Publish data written directly to linear write address
+ * \note            Function may be called from interrupt context
+ *                  when buffer has single writer
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[in]       len: Number of bytes written to buffer memory
+ * \return          Number of bytes actually added to buffer
+ */
+size_t
+gsm_buff_advance(gsm_buff_t* buff, size_t len) {
+    size_t in;
+
+    if (buff == NULL || len == 0) {
+        return 0;
+    }
+    in = buff->in;
+    len = GSM_MIN(len, gsm_buff_get_free(buff));
+    in += len;                                  /* Advance buffer */
+    if (in >= buff->size) {                     /* Subtract possible overflow */
+        in -= buff->size;                       /* Do subtract */
+    }
+    BUFF_BARRIER();                             /* Data must be in memory before they are published */
+    buff->in = in;
+    return len;
+}
+
+/**
+ * \brief           Get data ready to read as up to two linear memory views, without copying
+ *
+ *                  First view starts at read pointer, second view is non-empty
+ *                  only when data wrap around end of buffer memory.
+ *                  Use \ref gsm_buff_skip to release memory once data are processed
+ *
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[out]      views: Array of `2` entries to fill with views
+ * \return          Total number of bytes in both views
+ */
+size_t
+gsm_buff_get_read_views(gsm_buff_t* buff, gsm_iovec_t* views) {
+    size_t in, out, full;
+
+    GSM_MEMSET(views, 0x00, 2 * sizeof(*views));
+    if (buff == NULL || buff->buff == NULL) {
+        return 0;
+    }
+    in = buff->in;                              /* Save values */
+    out = buff->out;
+    BUFF_BARRIER();                             /* Read data only after input pointer */
+    full = BUFF_FULL(buff->size, in, out);
+    views[0].data = &buff->buff[out];
+    views[0].len = GSM_MIN(full, buff->size - out);
+    if (full > views[0].len) {                  /* Data wrap to beginning of memory */
+        views[1].data = buff->buff;
+        views[1].len = full - views[0].len;
+    }
+    return full;
+}
+
+#if GSM_CFG_BUFF_POW2 || __DOXYGEN__
+
+/*
+ * Power-of-two buffer functions, used for input buffer only.
+ *
+ * Pointers run freely and overflow naturally,
+ * memory position is pointer masked with size.
+ * Entire memory can be used as full and empty state differ in pointers.
+ * Buffer must be initialized with \ref gsm_buff_init_pow2
+ * and used only with `_pow2` functions
+ */
+#define BUFF_POW2_FULL(in, out)     ((size_t)((in) - (out)))
+#define BUFF_POW2_POS(buff, ptr)    ((ptr) & ((buff)->size - 1))
+
+/**
+ * \brief           Initialize buffer in power-of-two mode
+ *
+ *                  Pointers run freely and are masked with buffer size on memory access,
+ *                  which removes wrap-around checks and lets buffer use its entire memory
+ *
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[in]       size: Size of buffer, must be power of two
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsm_buff_init_pow2(gsm_buff_t* buff, size_t size) {
+    if (size == 0 || (size & (size - 1))) {     /* Size must be power of two */
+        return 0;
+    }
+    return gsm_buff_init(buff, size);
+}
+
+/**
+ * \brief           Get length of buffer currently being used, power-of-two buffer
+ * \param[in]       buff: Pointer to buffer structure
+ * \return          Number of bytes ready to be read
+ */
+size_t
+gsm_buff_get_full_pow2(gsm_buff_t* buff) {
+    size_t in, out;
+
+    in = buff->in;                              /* Save values */
+    out = buff->out;
+    BUFF_BARRIER();                             /* Read data only after input pointer */
+    return BUFF_POW2_FULL(in, out);
+}
+
+/**
+ * \brief           Get length of free space, power-of-two buffer
+ * \param[in]       buff: Pointer to buffer structure
+ * \return          Number of free bytes in memory
+ */
+size_t
+gsm_buff_get_free_pow2(gsm_buff_t* buff) {
+    return buff->size - BUFF_POW2_FULL(buff->in, buff->out);
+}
+
+/**
+ * \brief           Write data to power-of-two buffer
+ * \note            Function may be called from interrupt context
+ *                  when buffer has single writer
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[in]       data: Pointer to data to copy memory from
+ * \param[in]       count: Number of bytes we want to write
+ * \return          Number of bytes actually written to buffer
+ */
+size_t
+gsm_buff_write_pow2(gsm_buff_t* buff, const void* data, size_t count) {
+    const uint8_t* d = data;
+    size_t tocopy, in, pos;
+
+    in = buff->in;                              /* Only writer modifies input pointer */
+    count = GSM_MIN(count, gsm_buff_get_free_pow2(buff));
+    if (count == 0) {
+        return 0;
     }
-    buff->out += len;                           /* Advance buffer */
-    if (buff->out >= buff->size) {              /* Subtract possible overflow */
-        buff->out -= buff->size;                /* Do subtract */
+    pos = BUFF_POW2_POS(buff, in);
+    tocopy = GSM_MIN(buff->size - pos, count);  /* Calculate number of elements we can put at the end of buffer */
+    GSM_MEMCPY(&buff->buff[pos], d, tocopy);    /* Copy content to buffer */
+    if (count > tocopy) {                       /* Check if anything to write */
+        GSM_MEMCPY(buff->buff, &d[tocopy], count - tocopy); /* Copy content */
     }
+    BUFF_BARRIER();                             /* Data must be in memory before they are published */
+    buff->in = in + count;
+    return count;
+}
+
+/**
+ * \brief           Skip (ignore) data of power-of-two buffer
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[in]       len: Length of bytes we want to skip
+ * \return          Number of bytes skipped
+ */
+size_t
+gsm_buff_skip_pow2(gsm_buff_t* buff, size_t len) {
+    size_t out;
+
+    out = buff->out;
+    len = GSM_MIN(len, gsm_buff_get_full_pow2(buff));
+    BUFF_BARRIER();                             /* Data must be read before memory is released */
+    buff->out = out + len;
     return len;
 }
+
+/**
+ * \brief           Get linear address of power-of-two buffer for fast write, for example with DMA
+ * \note            Use \ref gsm_buff_advance_pow2 after data are written
+ * \param[in]       buff: Pointer to buffer
+ * \return          Pointer to start of linear address to write to
+ */
+void *
+gsm_buff_get_linear_block_write_address_pow2(gsm_buff_t* buff) {
+    return &buff->buff[BUFF_POW2_POS(buff, buff->in)];  /* Return write address */
+}
+
+/**
+ * \brief           Get length of free linear block at write address of power-of-two buffer
+ * \param[in]       buff: Pointer to buffer
+ * \return          Number of bytes which can be written to linear write address
+ */
+size_t
+gsm_buff_get_linear_block_write_length_pow2(gsm_buff_t* buff) {
+    /* Free memory, but not more than until end of memory */
+    return GSM_MIN(gsm_buff_get_free_pow2(buff), buff->size - BUFF_POW2_POS(buff, buff->in));
+}
+
+/**
+ * \brief           Publish data written directly to linear write address of power-of-two buffer
+ * \note            Function may be called from interrupt context
+ *                  when buffer has single writer
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[in]       len: Number of bytes written to buffer memory
+ * \return          Number of bytes actually added to buffer
+ */
+size_t
+gsm_buff_advance_pow2(gsm_buff_t* buff, size_t len) {
+    size_t in;
+
+    in = buff->in;
+    len = GSM_MIN(len, gsm_buff_get_free_pow2(buff));
+    BUFF_BARRIER();                             /* Data must be in memory before they are published */
+    buff->in = in + len;
+    return len;
+}
+
+/**
+ * \brief           Get data ready to read as up to two linear memory views of power-of-two buffer
+ * \param[in]       buff: Pointer to buffer structure
+ * \param[out]      views: Array of `2` entries to fill with views
+ * \return          Total number of bytes in both views
+ */
+size_t
+gsm_buff_get_read_views_pow2(gsm_buff_t* buff, gsm_iovec_t* views) {
+    size_t full, pos;
+
+    full = gsm_buff_get_full_pow2(buff);
+    pos = BUFF_POW2_POS(buff, buff->out);
+    views[0].data = &buff->buff[pos];
+    views[0].len = GSM_MIN(full, buff->size - pos);
+    views[1].data = buff->buff;                 /* Data wrap to beginning of memory */
+    views[1].len = full - views[0].len;
+    return full;
+}
+
+#endif /* GSM_CFG_BUFF_POW2 || __DOXYGEN__ */
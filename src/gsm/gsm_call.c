@@ -118,6 +118,8 @@ gsm_call_start(const char* number, uint32_t blocking) {
 
 /**
  * \brief           Answer to an incoming call
+ * \note            Command is executed before commands already waiting in producer queue,
+ *                  see \ref gsm_msg_prio_t
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
  */
@@ -134,6 +136,8 @@ gsm_call_answer(uint32_t blocking) {
 
 /**
  * \brief           Hang-up incoming or active call
+ * \note            Command is executed before commands already waiting in producer queue,
+ *                  see \ref gsm_msg_prio_t
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
  */
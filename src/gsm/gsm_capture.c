@@ -0,0 +1,140 @@
+/**	
+ * \file            gsm_capture.c
+ * \brief           AT port traffic capture
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_capture.h"
+
+#if GSM_CFG_AT_CAPTURE || __DOXYGEN__
+
+/**
+ * \brief           Pass AT port data to capture function
+ * \param[in]       dir: Direction of data
+ * \param[in]       data: Data sent or received
+ * \param[in]       len: Length of data in units of bytes
+ */
+void
+gsmi_capture(gsm_capture_dir_t dir, const void* data, size_t len) {
+    gsm_capture_fn fn = gsm.capture.fn;         /* Read once, capture may be stopped from other thread */
+
+    if (fn != NULL && len > 0) {
+        fn(dir, gsm_sys_now() - gsm.capture.start, data, len, gsm.capture.arg);
+    }
+}
+
+/**
+ * \brief           Start capture of AT port traffic
+ *
+ *                  Data sent to device and received from it are passed to capture function
+ *                  as they are, with multiplexer frames when \ref GSM_CFG_CMUX is active
+ *
+ * \note            Function may be called before \ref gsm_init to capture initialization sequence
+ *
+ * \param[in]       fn: Capture function
+ * \param[in]       arg: Custom argument for capture function
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_capture_start(gsm_capture_fn fn, void* arg) {
+    GSM_ASSERT("fn != NULL", fn != NULL);       /* Assert input parameters */
+
+    gsm.capture.fn = NULL;                      /* Core lock may not exist yet, disable capture first */
+    gsm.capture.arg = arg;
+    gsm.capture.start = gsm_sys_now();
+    gsm.capture.fn = fn;                        /* Set last, input may be captured from other thread */
+    return gsmOK;
+}
+
+/**
+ * \brief           Stop capture of AT port traffic
+ * \note            Capture function may still be called once from receive thread
+ *                  if it was started before this function returned
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_capture_stop(void) {
+    gsm.capture.fn = NULL;
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_AT_CAPTURE || __DOXYGEN__ */
+
+/**
+ * \brief           Build capture record header
+ * \param[out]      hdr: Output memory of at least \ref GSM_CAPTURE_HDR_LEN bytes
+ * \param[in]       dir: Direction of data
+ * \param[in]       time: Time since capture start in units of milliseconds
+ * \param[in]       len: Length of data following header
+ * \return          Number of bytes written to header
+ */
+size_t
+gsm_capture_hdr_encode(uint8_t* hdr, gsm_capture_dir_t dir, uint32_t time, size_t len) {
+    if (hdr == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i < 4; i++) {
+        hdr[i] = GSM_U8(time >> (8 * i));
+        hdr[5 + i] = GSM_U8((uint32_t)len >> (8 * i));
+    }
+    hdr[4] = GSM_U8(dir);
+    return GSM_CAPTURE_HDR_LEN;
+}
+
+/**
+ * \brief           Parse capture record header
+ * \param[in]       hdr: Header of \ref GSM_CAPTURE_HDR_LEN bytes
+ * \param[out]      dir: Output variable to save direction to
+ * \param[out]      time: Output variable to save time since capture start to
+ * \param[out]      len: Output variable to save length of data following header to
+ * \return          `1` if header is valid, `0` otherwise
+ */
+uint8_t
+gsm_capture_hdr_decode(const uint8_t* hdr, gsm_capture_dir_t* dir, uint32_t* time, size_t* len) {
+    uint32_t t = 0, l = 0;
+
+    if (hdr == NULL || (hdr[4] != GSM_CAPTURE_DIR_TX && hdr[4] != GSM_CAPTURE_DIR_RX)) {
+        return 0;
+    }
+    for (size_t i = 0; i < 4; i++) {
+        t |= (uint32_t)hdr[i] << (8 * i);
+        l |= (uint32_t)hdr[5 + i] << (8 * i);
+    }
+    if (dir != NULL) {
+        *dir = (gsm_capture_dir_t)hdr[4];
+    }
+    if (time != NULL) {
+        *time = t;
+    }
+    if (len != NULL) {
+        *len = l;
+    }
+    return 1;
+}
@@ -0,0 +1,618 @@
+/**	
+ * \file            gsm_cmux.c
+ * \brief           GSM 07.10 multiplexer
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_cmux.h"
+#include "gsm/gsm_mem.h"
+
+#if GSM_CFG_CMUX || __DOXYGEN__
+
+#define CMUX_FLAG                   0xF9
+#define CMUX_EA                     0x01    /*!< Extension bit, last byte of field */
+#define CMUX_CR                     0x02    /*!< Command/response bit */
+#define CMUX_PF                     0x10    /*!< Poll/final bit */
+
+#define CMUX_SABM                   0x2F    /*!< Set asynchronous balanced mode, opens channel */
+#define CMUX_UA                     0x63    /*!< Unnumbered acknowledgement */
+#define CMUX_DM                     0x0F    /*!< Disconnected mode */
+#define CMUX_DISC                   0x43    /*!< Disconnect, closes channel */
+#define CMUX_UIH                    0xEF    /*!< Unnumbered information with header check */
+
+#define CMUX_MSG_CLD                0xC1    /*!< Multiplexer close down control message */
+#define CMUX_MSG_MSC                0xE1    /*!< Modem status control message */
+
+#define CMUX_FCS_INIT               0xFF
+#define CMUX_FCS_GOOD               0xCF    /*!< Remainder after valid frame check sequence */
+
+/**
+ * \brief           Frame decoder states
+ */
+typedef enum {
+    CMUX_RX_FLAG = 0x00,                        /*!< Wait for opening flag */
+    CMUX_RX_ADDR,                               /*!< Wait for address field */
+    CMUX_RX_CTRL,                               /*!< Wait for control field */
+    CMUX_RX_LEN,                                /*!< Wait for first length byte */
+    CMUX_RX_LEN2,                               /*!< Wait for second length byte */
+    CMUX_RX_DATA,                               /*!< Read information field */
+    CMUX_RX_FCS,                                /*!< Wait for frame check sequence */
+    CMUX_RX_END,                                /*!< Wait for closing flag */
+} cmux_rx_state_t;
+
+/**
+ * \brief           Add byte to frame check sequence
+ *
+ * Reversed CRC-8 with polynomial `x^8 + x^2 + x + 1` as defined by GSM 07.10
+ *
+ * \param[in]       fcs: Current frame check sequence
+ * \param[in]       b: Byte to add
+ * \return          New frame check sequence
+ */
+static uint8_t
+cmux_fcs_add(uint8_t fcs, uint8_t b) {
+    fcs ^= b;
+    for (size_t i = 0; i < 8; i++) {
+        fcs = (fcs & 0x01) ? GSM_U8((fcs >> 1) ^ 0xE0) : GSM_U8(fcs >> 1);
+    }
+    return fcs;
+}
+
+/**
+ * \brief           Send part of frame to physical port
+ * \param[in]       data: Data to send
+ * \param[in]       len: Length of data in units of bytes
+ */
+static void
+cmux_phy_send(const void* data, size_t len) {
+#if GSM_CFG_AT_CAPTURE
+    gsmi_capture(GSM_CAPTURE_DIR_TX, data, len);
+#endif /* GSM_CFG_AT_CAPTURE */
+    gsm.cmux.send_fn(data, len);
+}
+
+/**
+ * \brief           Send single frame to physical port
+ * \param[in]       dlci: Channel number
+ * \param[in]       ctrl: Control field, including poll/final bit
+ * \param[in]       cr: Set to `1` for command or `0` for response frame
+ * \param[in]       data: Information field data. Set to `NULL` if `len` is `0`
+ * \param[in]       len: Length of information field, maximal value is \ref GSM_CFG_CMUX_FRAME_SIZE
+ */
+static void
+cmux_send_frame(uint8_t dlci, uint8_t ctrl, uint8_t cr, const void* data, size_t len) {
+    uint8_t hdr[5], tail[2], fcs = CMUX_FCS_INIT;
+    size_t hdr_len = 4;
+
+    hdr[0] = CMUX_FLAG;
+    hdr[1] = GSM_U8((dlci << 2) | (cr ? CMUX_CR : 0) | CMUX_EA);
+    hdr[2] = ctrl;
+    if (len > 0x7F) {                           /* Length does not fit to single byte */
+        hdr[3] = GSM_U8((len & 0x7F) << 1);
+        hdr[4] = GSM_U8(len >> 7);
+        hdr_len = 5;
+    } else {
+        hdr[3] = GSM_U8((len << 1) | CMUX_EA);
+    }
+    for (size_t i = 1; i < hdr_len; i++) {
+        fcs = cmux_fcs_add(fcs, hdr[i]);
+    }
+    if ((ctrl & ~CMUX_PF) != CMUX_UIH) {        /* Information field is protected only on non-UIH frames */
+        for (size_t i = 0; i < len; i++) {
+            fcs = cmux_fcs_add(fcs, ((const uint8_t *)data)[i]);
+        }
+    }
+    tail[0] = GSM_U8(0xFF - fcs);
+    tail[1] = CMUX_FLAG;
+
+    cmux_phy_send(hdr, hdr_len);
+    if (len) {
+        cmux_phy_send(data, len);
+    }
+    cmux_phy_send(tail, sizeof(tail));
+}
+
+/**
+ * \brief           Send data on channel, split to frames of maximal size
+ * \param[in]       dlci: Channel number
+ * \param[in]       data: Data to send
+ * \param[in]       len: Number of bytes to send
+ */
+static void
+cmux_send_data(uint8_t dlci, const void* data, size_t len) {
+    const uint8_t* d = data;
+    size_t l;
+
+    while (len) {
+        l = GSM_MIN(len, GSM_CFG_CMUX_FRAME_SIZE);
+        cmux_send_frame(dlci, CMUX_UIH, 1, d, l);
+        d += l;
+        len -= l;
+    }
+}
+
+/**
+ * \brief           Low-level send function of AT command engine in multiplexer mode
+ *
+ * Data are sent on channel selected for current command,
+ * which is AT command channel or transparent connection channel
+ *
+ * \param[in]       data: Data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+cmux_at_send(const void* data, size_t len) {
+    cmux_send_data(gsm.cmux.tx_dlci, data, len);
+    return len;
+}
+
+/**
+ * \brief           Send modem status to device after channel is open
+ * \param[in]       dlci: Channel number
+ */
+static void
+cmux_send_msc(uint8_t dlci) {
+    uint8_t msc[4];
+
+    msc[0] = CMUX_MSG_MSC | CMUX_CR;
+    msc[1] = GSM_U8((2 << 1) | CMUX_EA);        /* 2 bytes of values */
+    msc[2] = GSM_U8((dlci << 2) | CMUX_CR | CMUX_EA);
+    msc[3] = 0x8D;                              /* Ready to communicate, ready to receive, data valid */
+    cmux_send_frame(0, CMUX_UIH, 1, msc, sizeof(msc));
+}
+
+/**
+ * \brief           Leave multiplexer mode and send AT data directly to physical port again
+ */
+static void
+cmux_deactivate(void) {
+    if (gsm.cmux.active) {
+        gsm.ll.send_fn = gsm.cmux.send_fn;
+        GSM_MEMSET(gsm.cmux.ch, 0x00, sizeof(gsm.cmux.ch));
+        gsm.cmux.active = 0;
+        GSM_DEBUGF(GSM_CFG_DBG_CMUX | GSM_DBG_TYPE_TRACE,
+            "[CMUX] Multiplexer closed\r\n");
+    }
+}
+
+/**
+ * \brief           Process message received on control channel
+ */
+static void
+cmux_ctrl_process(void) {
+    uint8_t type;
+
+    if (!gsm.cmux.rx.len) {
+        return;
+    }
+    type = gsm.cmux.rx.data[0];
+    if (type & CMUX_CR) {                       /* Command from device, reply with same content */
+        gsm.cmux.rx.data[0] = GSM_U8(type & ~CMUX_CR);
+        cmux_send_frame(0, CMUX_UIH, 1, gsm.cmux.rx.data, gsm.cmux.rx.len);
+        if ((type & ~CMUX_CR) == CMUX_MSG_CLD) {
+            cmux_deactivate();                  /* Device closes multiplexer */
+        }
+    }
+}
+
+/**
+ * \brief           Process fully received and checked frame
+ */
+static void
+cmux_frame_process(void) {
+    uint8_t dlci = GSM_U8(gsm.cmux.rx.addr >> 2), ctrl = GSM_U8(gsm.cmux.rx.ctrl & ~CMUX_PF);
+    gsm_cmux_ch_t* ch;
+
+    if (dlci > GSM_CFG_CMUX_MAX_CHANNELS) {     /* Channel is not supported */
+        if (ctrl == CMUX_SABM) {
+            cmux_send_frame(dlci, CMUX_DM | CMUX_PF, 0, NULL, 0);
+        }
+        return;
+    }
+    ch = &gsm.cmux.ch[dlci];
+    switch (ctrl) {
+        case CMUX_UIH: {
+            if (dlci == 0) {
+                cmux_ctrl_process();
+            } else if (dlci == GSM_CFG_CMUX_AT_DLCI
+#if GSM_CFG_CONN_TRANSPARENT
+                || dlci == GSM_CFG_CMUX_DATA_DLCI
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+                ) {
+                gsmi_process_at(gsm.cmux.rx.data, gsm.cmux.rx.len);
+            } else if (ch->fn != NULL) {
+                ch->fn(dlci, gsm.cmux.rx.data, gsm.cmux.rx.len, ch->arg);
+            }
+            break;
+        }
+        case CMUX_UA:
+        case CMUX_DM: {
+            /* Response to channel open or close command */
+            if ((CMD_IS_CUR(GSM_CMD_CMUX_SABM) || CMD_IS_CUR(GSM_CMD_CMUX_DISC)) && gsm.msg->msg.cmux.dlci == dlci) {
+                uint8_t ok;
+
+                if (CMD_IS_CUR(GSM_CMD_CMUX_SABM)) {
+                    ok = ctrl == CMUX_UA;
+                    if (ok) {
+                        ch->open = 1;
+                        ch->fn = gsm.msg->msg.cmux.fn;
+                        ch->arg = gsm.msg->msg.cmux.arg;
+                        if (dlci != 0) {
+                            cmux_send_msc(dlci);
+                        }
+                    }
+                } else {
+                    ok = 1;                     /* Disconnected mode means channel is closed too */
+                    GSM_MEMSET(ch, 0x00, sizeof(*ch));
+                    if (dlci == 0) {
+                        cmux_deactivate();      /* Closed control channel closes multiplexer */
+                    }
+                }
+                gsmi_process_cmd_result(ok, !ok);
+            }
+            break;
+        }
+        case CMUX_SABM: {                       /* Device opens channel */
+            ch->open = 1;
+            cmux_send_frame(dlci, CMUX_UA | CMUX_PF, 0, NULL, 0);
+            break;
+        }
+        case CMUX_DISC: {                       /* Device closes channel */
+            cmux_send_frame(dlci, (ch->open ? CMUX_UA : CMUX_DM) | CMUX_PF, 0, NULL, 0);
+            GSM_MEMSET(ch, 0x00, sizeof(*ch));
+            if (dlci == 0) {
+                cmux_deactivate();
+            }
+            break;
+        }
+        default: break;
+    }
+}
+
+/**
+ * \brief           Enable multiplexer framing after device accepted `AT+CMUX` command
+ *
+ * AT command engine low-level send function is replaced with function
+ * to send data in frames on \ref GSM_CFG_CMUX_AT_DLCI channel
+ */
+void
+gsmi_cmux_activate(void) {
+    if (!gsm.cmux.active) {
+        gsm.cmux.send_fn = gsm.ll.send_fn;
+        gsm.ll.send_fn = cmux_at_send;
+        gsm.cmux.tx_dlci = GSM_CFG_CMUX_AT_DLCI;
+        GSM_MEMSET(gsm.cmux.ch, 0x00, sizeof(gsm.cmux.ch));
+        gsm.cmux.rx.state = CMUX_RX_FLAG;
+        gsm.cmux.active = 1;
+        GSM_DEBUGF(GSM_CFG_DBG_CMUX | GSM_DBG_TYPE_TRACE,
+            "[CMUX] Multiplexer active\r\n");
+    }
+}
+
+/**
+ * \brief           Send channel open or close command
+ * \note            Command is finished when device responds with acknowledge
+ * \param[in]       dlci: Channel number
+ * \param[in]       open: Set to `1` to open or `0` to close channel
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_cmux_open_close(uint8_t dlci, uint8_t open) {
+    if (!gsm.cmux.active || dlci > GSM_CFG_CMUX_MAX_CHANNELS
+        || gsm.cmux.ch[dlci].open == !!open) {
+        return gsmERR;
+    }
+    cmux_send_frame(dlci, GSM_U8((open ? CMUX_SABM : CMUX_DISC) | CMUX_PF), 1, NULL, 0);
+    return gsmOK;
+}
+
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+
+/**
+ * \brief           Select channel for next data of AT command engine
+ * \note            When transparent connection channel is not open, AT command channel is used
+ * \param[in]       transp: Set to `1` for command of transparent connection, `0` otherwise
+ */
+void
+gsmi_cmux_select_channel(uint8_t transp) {
+    gsm.cmux.tx_dlci = transp && gsmi_cmux_transp_separate() ? GSM_CFG_CMUX_DATA_DLCI : GSM_CFG_CMUX_AT_DLCI;
+}
+
+/**
+ * \brief           Check if transparent connection has its own channel
+ * \return          `1` when AT command channel stays in command mode during connection, `0` otherwise
+ */
+uint8_t
+gsmi_cmux_transp_separate(void) {
+    return gsm.cmux.active && gsm.cmux.ch[GSM_CFG_CMUX_DATA_DLCI].open;
+}
+
+/**
+ * \brief           Check if data passed to AT parser may belong to transparent connection
+ * \return          `1` when data are received on connection channel, `0` for AT command channel
+ */
+uint8_t
+gsmi_cmux_transp_rx(void) {
+    return !gsmi_cmux_transp_separate() || GSM_U8(gsm.cmux.rx.addr >> 2) == GSM_CFG_CMUX_DATA_DLCI;
+}
+
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
+
+/**
+ * \brief           Decode multiplexer frames received from device
+ *
+ * Information of AT command channel and transparent connection channel
+ * is processed by AT parser, other channels are delivered to their receive functions
+ *
+ * \param[in]       data: Received data
+ * \param[in]       len: Number of bytes received
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_cmux_process(const void* data, size_t len) {
+    const uint8_t* d = data;
+    uint8_t b;
+    size_t l;
+
+    while (len) {
+        b = *d++;
+        len--;
+        switch (gsm.cmux.rx.state) {
+            case CMUX_RX_FLAG: {
+                if (b == CMUX_FLAG) {
+                    gsm.cmux.rx.state = CMUX_RX_ADDR;
+                }
+                break;
+            }
+            case CMUX_RX_ADDR: {
+                if (b != CMUX_FLAG) {           /* Multiple flags may be present between frames */
+                    gsm.cmux.rx.addr = b;
+                    gsm.cmux.rx.fcs = cmux_fcs_add(CMUX_FCS_INIT, b);
+                    gsm.cmux.rx.state = CMUX_RX_CTRL;
+                }
+                break;
+            }
+            case CMUX_RX_CTRL: {
+                gsm.cmux.rx.ctrl = b;
+                gsm.cmux.rx.fcs = cmux_fcs_add(gsm.cmux.rx.fcs, b);
+                gsm.cmux.rx.state = CMUX_RX_LEN;
+                break;
+            }
+            case CMUX_RX_LEN:
+            case CMUX_RX_LEN2: {
+                gsm.cmux.rx.fcs = cmux_fcs_add(gsm.cmux.rx.fcs, b);
+                if (gsm.cmux.rx.state == CMUX_RX_LEN) {
+                    gsm.cmux.rx.len = b >> 1;
+                    if (!(b & CMUX_EA)) {       /* Length continues in next byte */
+                        gsm.cmux.rx.state = CMUX_RX_LEN2;
+                        break;
+                    }
+                } else {
+                    gsm.cmux.rx.len |= (size_t)b << 7;
+                }
+                gsm.cmux.rx.ptr = 0;
+                if (gsm.cmux.rx.len > sizeof(gsm.cmux.rx.data)) {
+                    GSM_DEBUGF(GSM_CFG_DBG_CMUX | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+                        "[CMUX] Frame too long: %d bytes\r\n", (int)gsm.cmux.rx.len);
+                    gsm.cmux.rx.state = CMUX_RX_FLAG;
+                } else {
+                    gsm.cmux.rx.state = gsm.cmux.rx.len ? CMUX_RX_DATA : CMUX_RX_FCS;
+                }
+                break;
+            }
+            case CMUX_RX_DATA: {
+                /* Copy as much information as available at once */
+                l = GSM_MIN(gsm.cmux.rx.len - gsm.cmux.rx.ptr, len + 1);
+                GSM_MEMCPY(&gsm.cmux.rx.data[gsm.cmux.rx.ptr], d - 1, l);
+                if ((gsm.cmux.rx.ctrl & ~CMUX_PF) != CMUX_UIH) {
+                    for (size_t i = 0; i < l; i++) {
+                        gsm.cmux.rx.fcs = cmux_fcs_add(gsm.cmux.rx.fcs, gsm.cmux.rx.data[gsm.cmux.rx.ptr + i]);
+                    }
+                }
+                gsm.cmux.rx.ptr += l;
+                d += l - 1;
+                len -= l - 1;
+                if (gsm.cmux.rx.ptr == gsm.cmux.rx.len) {
+                    gsm.cmux.rx.state = CMUX_RX_FCS;
+                }
+                break;
+            }
+            case CMUX_RX_FCS: {
+                if (cmux_fcs_add(gsm.cmux.rx.fcs, b) == CMUX_FCS_GOOD) {
+                    gsm.cmux.rx.state = CMUX_RX_END;
+                } else {
+                    GSM_DEBUGF(GSM_CFG_DBG_CMUX | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+                        "[CMUX] Invalid frame check sequence\r\n");
+                    gsm.cmux.rx.state = CMUX_RX_FLAG;
+                }
+                break;
+            }
+            case CMUX_RX_END: {
+                if (b == CMUX_FLAG) {
+                    gsm.cmux.rx.state = CMUX_RX_ADDR;   /* Closing flag may be opening flag of next frame */
+                    cmux_frame_process();
+                    if (!gsm.cmux.active) {     /* Device is in AT command mode again */
+                        return gsmi_process_at(d, len);
+                    }
+                } else {
+                    gsm.cmux.rx.state = CMUX_RX_FLAG;
+                }
+                break;
+            }
+            default: {
+                gsm.cmux.rx.state = CMUX_RX_FLAG;
+                break;
+            }
+        }
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           Start multiplexer mode on device
+ *
+ * Device is set to basic option multiplexer mode with `AT+CMUX` command,
+ * then control channel and AT command channel \ref GSM_CFG_CMUX_AT_DLCI are opened.
+ * All further AT commands are sent on AT command channel.
+ *
+ * When \ref GSM_CFG_CONN_TRANSPARENT is enabled, \ref GSM_CFG_CMUX_DATA_DLCI channel is opened too.
+ * Transparent connection is started and carries its data on that channel,
+ * so AT commands may still be executed while connection is in data mode
+ *
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cmux_start(const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMUX_SET;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 5000);    /* Send message to producer queue */
+}
+
+/**
+ * \brief           Stop multiplexer mode and return device to normal AT command mode
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cmux_stop(const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMUX_DISC;
+    GSM_MSG_VAR_REF(msg).msg.cmux.dlci = 0;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 5000);    /* Send message to producer queue */
+}
+
+/**
+ * \brief           Open multiplexer data channel
+ * \param[in]       dlci: Channel number, between `1` and \ref GSM_CFG_CMUX_MAX_CHANNELS.
+ *                      AT command channel \ref GSM_CFG_CMUX_AT_DLCI and transparent connection
+ *                      channel \ref GSM_CFG_CMUX_DATA_DLCI are not allowed
+ * \param[in]       fn: Function to call when data are received on channel
+ * \param[in]       arg: Custom argument for receive function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cmux_channel_open(uint8_t dlci, gsm_cmux_recv_fn fn, void* const arg, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("dlci > 0", dlci > 0);           /* Assert input parameters */
+    GSM_ASSERT("dlci <= GSM_CFG_CMUX_MAX_CHANNELS", dlci <= GSM_CFG_CMUX_MAX_CHANNELS); /* Assert input parameters */
+    GSM_ASSERT("dlci != GSM_CFG_CMUX_AT_DLCI", dlci != GSM_CFG_CMUX_AT_DLCI);   /* Assert input parameters */
+#if GSM_CFG_CONN_TRANSPARENT
+    GSM_ASSERT("dlci != GSM_CFG_CMUX_DATA_DLCI", dlci != GSM_CFG_CMUX_DATA_DLCI);   /* Assert input parameters */
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMUX_SABM;
+    GSM_MSG_VAR_REF(msg).msg.cmux.dlci = dlci;
+    GSM_MSG_VAR_REF(msg).msg.cmux.fn = fn;
+    GSM_MSG_VAR_REF(msg).msg.cmux.arg = arg;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);    /* Send message to producer queue */
+}
+
+/**
+ * \brief           Close multiplexer data channel
+ * \param[in]       dlci: Channel number to close
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cmux_channel_close(uint8_t dlci, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("dlci > 0", dlci > 0);           /* Assert input parameters */
+    GSM_ASSERT("dlci <= GSM_CFG_CMUX_MAX_CHANNELS", dlci <= GSM_CFG_CMUX_MAX_CHANNELS); /* Assert input parameters */
+    GSM_ASSERT("dlci != GSM_CFG_CMUX_AT_DLCI", dlci != GSM_CFG_CMUX_AT_DLCI);   /* Assert input parameters */
+#if GSM_CFG_CONN_TRANSPARENT
+    GSM_ASSERT("dlci != GSM_CFG_CMUX_DATA_DLCI", dlci != GSM_CFG_CMUX_DATA_DLCI);   /* Assert input parameters */
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMUX_DISC;
+    GSM_MSG_VAR_REF(msg).msg.cmux.dlci = dlci;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);    /* Send message to producer queue */
+}
+
+/**
+ * \brief           Write data to open multiplexer data channel
+ *
+ * Data are framed and sent immediately, without waiting for AT commands
+ * in producer queue, which may be in progress on AT command channel
+ *
+ * \param[in]       dlci: Channel number
+ * \param[in]       data: Data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cmux_channel_write(uint8_t dlci, const void* data, size_t len) {
+    gsmr_t res = gsmERR;
+
+    GSM_ASSERT("data != NULL", data != NULL);   /* Assert input parameters */
+    GSM_ASSERT("len > 0", len > 0);             /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (gsm.cmux.active && dlci > 0 && dlci <= GSM_CFG_CMUX_MAX_CHANNELS
+        && dlci != GSM_CFG_CMUX_AT_DLCI
+#if GSM_CFG_CONN_TRANSPARENT
+        && dlci != GSM_CFG_CMUX_DATA_DLCI
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+        && gsm.cmux.ch[dlci].open) {
+        cmux_send_data(dlci, data, len);
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Check if multiplexer mode is active
+ * \return          `1` if active, `0` otherwise
+ */
+uint8_t
+gsm_cmux_is_active(void) {
+    uint8_t res;
+    GSM_CORE_PROTECT();                         /* Protect core */
+    res = gsm.cmux.active;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
@@ -43,44 +43,136 @@
  */
 #define CONN_CHECK_CLOSED_IN_CLOSING(conn) do { \
     gsmr_t r = gsmOK;                           \
-    GSM_CORE_PROTECT();                         \
+    GSM_CONN_TX_PROTECT(conn);                  \
     if (conn->status.f.in_closing || !conn->status.f.active) {  \
         r = gsmCLOSED;                          \
     }                                           \
-    GSM_CORE_UNPROTECT();                       \
+    GSM_CONN_TX_UNPROTECT(conn);                \
     if (r != gsmOK) {                           \
         return r;                               \
     }                                           \
 } while (0)
 
+#if GSM_CFG_CMD_EVT
 /**
- * \brief           Timeout callback for connection
- * \param[in]       arg: Timeout callback custom argument
+ * \brief           Keep pending completion callback away from commands queued internally
+ *
+ *                  Callback set by user belongs to last command of API function
+ */
+#define CMD_EVT_SUSPEND()               gsm_api_cmd_evt_fn evt_fn = NULL; void* evt_arg = NULL; gsmi_cmd_evt_swap(&evt_fn, &evt_arg)
+#define CMD_EVT_RESUME()                gsmi_cmd_evt_swap(&evt_fn, &evt_arg)
+#else
+#define CMD_EVT_SUSPEND()
+#define CMD_EVT_RESUME()
+#endif /* GSM_CFG_CMD_EVT */
+
+/**
+ * \brief           Flush write buffer without attaching pending completion callback to it
+ * \param[in]       conn: Connection to flush buffer on
+ */
+#define FLUSH_BUFF_KEEP_CMD_EVT(conn)   do { \
+    CMD_EVT_SUSPEND();                          \
+    flush_buff(conn);                           \
+    CMD_EVT_RESUME();                           \
+} while (0)
+
+/**
+ * \brief           Poll timeout callback, shared by all connections
+ *
+ * Poll event is sent to every connection with expired interval.
+ * When connection callback returns \ref gsmERR, owner is not interested and polling is disabled
+ *
+ * \param[in]       arg: Timeout callback custom argument, not used
  */
 static void
-conn_timeout_cb(void* arg) {
-    gsm_conn_p conn = arg;                      /* Argument is actual connection */
+conn_poll_cb(void* arg) {
+    uint32_t now = gsm_sys_now();
 
-    if (conn->status.f.active) {                /* Handle only active connections */
-        gsm.evt.type = GSM_EVT_CONN_POLL;       /* Poll connection event */
-        gsm.evt.evt.conn_poll.conn = conn;      /* Set connection pointer */
-        gsmi_send_conn_cb(conn, NULL);          /* Send connection callback */
-        
-        gsm_timeout_add(GSM_CFG_CONN_POLL_INTERVAL, conn_timeout_cb, conn); /* Schedule timeout again */
-        GSM_DEBUGF(GSM_CFG_DBG_CONN | GSM_DBG_TYPE_TRACE,
-            "[CONN] Poll event: %p\r\n", conn);
+    GSM_UNUSED(arg);
+    for (size_t i = 0; i < GSM_CFG_MAX_CONNS; i++) {
+        gsm_conn_p conn = &gsm.conns[i];
+
+        if (conn->status.f.active && conn->poll_interval > 0
+            && (int32_t)(now - conn->poll_next) >= 0) {
+            conn->poll_next = now + conn->poll_interval;
+            gsm.evt.type = GSM_EVT_CONN_POLL;   /* Poll connection event */
+            gsm.evt.evt.conn_poll.conn = conn;  /* Set connection pointer */
+            if (gsmi_send_conn_cb(conn, NULL) == gsmERR) {
+                conn->poll_interval = 0;        /* Owner does not handle poll events */
+            }
+            GSM_DEBUGF(GSM_CFG_DBG_CONN | GSM_DBG_TYPE_TRACE,
+                "[CONN] Poll event: %p\r\n", conn);
+        }
     }
+    gsmi_conn_poll_schedule();
 }
 
 /**
- * \brief           Start timeout function for connection
- * \param[in]       conn: Connection handle as user argument
+ * \brief           Start single poll timeout for connection which is polled first
+ * \note            Core must be protected when calling this function
  */
 void
-gsmi_conn_start_timeout(gsm_conn_p conn) {
-    gsm_timeout_add(GSM_CFG_CONN_POLL_INTERVAL, conn_timeout_cb, conn); /* Add connection timeout */
+gsmi_conn_poll_schedule(void) {
+    uint32_t now = gsm_sys_now(), delay = 0;
+    uint8_t found = 0;
+
+    for (size_t i = 0; i < GSM_CFG_MAX_CONNS; i++) {
+        gsm_conn_p conn = &gsm.conns[i];
+
+        if (conn->status.f.active && conn->poll_interval > 0) {
+            int32_t diff = (int32_t)(conn->poll_next - now);
+            uint32_t d = diff > 0 ? (uint32_t)diff : 0;
+
+            if (!found || d < delay) {
+                delay = d;
+                found = 1;
+            }
+        }
+    }
+    gsm_timeout_stop(gsm.conn_poll_timeout);
+    gsm.conn_poll_timeout = 0;
+    if (found) {
+        gsm_timeout_start(delay, conn_poll_cb, NULL, &gsm.conn_poll_timeout);
+    }
 }
 
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+
+/**
+ * \brief           Start manual read of data buffered in device if application has room for it
+ * \note            Core must be protected before function is called
+ * \param[in]       conn: Connection handle
+ * \return          \ref gsmOK on success or if read is not necessary, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_conn_manual_tcp_try_read_data(gsm_conn_p conn) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    gsmr_t res;
+
+    if (!conn->status.f.active || conn->status.f.in_closing
+        || !conn->status.f.rx_pending || conn->status.f.rx_reading
+        || conn->tcp_not_ack_bytes >= conn->tcp_rx_window
+        || (conn->tcp_rx_window_pkts > 0 && conn->tcp_not_ack_pkts >= conn->tcp_rx_window_pkts)) {
+        return gsmOK;                           /* Nothing to read or no room for data */
+    }
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPRXGET;
+    GSM_MSG_VAR_REF(msg).msg.ciprxget.conn = conn;
+    GSM_MSG_VAR_REF(msg).msg.ciprxget.len = GSM_MIN(GSM_CFG_IPD_MAX_BUFF_SIZE,
+        conn->tcp_rx_window - conn->tcp_not_ack_bytes);
+    GSM_MSG_VAR_REF(msg).msg.ciprxget.val_id = conn->val_id;
+
+    conn->status.f.rx_reading = 1;              /* Only one read at a time */
+    res = gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, 0, 10000);
+    if (res != gsmOK) {
+        conn->status.f.rx_reading = 0;          /* Try again on next event */
+    }
+    return res;
+}
+
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
+
 /**
  * \brief           Get connection validation ID
  * \param[in]       conn: Connection handle
@@ -89,9 +181,9 @@ gsmi_conn_start_timeout(gsm_conn_p conn) {
 uint8_t
 conn_get_val_id(gsm_conn_p conn) {
     uint8_t val_id;
-    GSM_CORE_PROTECT();                         /* Protect core */
+    GSM_CONN_TX_PROTECT(conn);                  /* Protect connection */
     val_id = conn->val_id;
-    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_CONN_TX_UNPROTECT(conn);                /* Unprotect connection */
     
     return val_id;
 }
@@ -146,8 +238,11 @@ conn_send(gsm_conn_p conn, const gsm_ip_t* const ip, gsm_port_t port, const void
 static gsmr_t
 flush_buff(gsm_conn_p conn) {
     gsmr_t res = gsmOK;
-    GSM_CORE_PROTECT();                         /* Protect core */
-    if (conn != NULL && conn->buff.buff != NULL) {  /* Do we have something ready? */
+    if (conn == NULL) {
+        return res;
+    }
+    GSM_CONN_TX_PROTECT(conn);                  /* Protect connection write buffer */
+    if (conn->buff.buff != NULL) {              /* Do we have something ready? */
         /*
          * If there is nothing to write or if write was not successful,
          * simply free the memory and stop execution
@@ -164,7 +259,7 @@ flush_buff(gsm_conn_p conn) {
         }
         conn->buff.buff = NULL;
     }
-    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_CONN_TX_UNPROTECT(conn);                /* Unprotect connection write buffer */
     return res;
 }
 
@@ -179,8 +274,10 @@ gsmi_conn_init(void) {
 /**
  * \brief           Start a new connection of specific type
  * \param[out]      conn: Pointer to connection handle to set new connection reference in case of successful connection
- * \param[in]       type: Connection type. This parameter can be a value of \ref gsm_conn_type_t enumeration
- * \param[in]       host: Connection host. In case of IP, write it as string, ex. "192.168.1.1"
+ * \param[in]       type: Connection type. This parameter can be a value of \ref gsm_conn_type_t enumeration.
+ *                      With \ref GSM_CONN_TYPE_SSL, TLS is handled by device, see \ref gsm_conn_ssl_set_cert
+ * \param[in]       host: Connection host. In case of IP, write it as string, ex. "192.168.1.1".
+ *                      Host name is resolved from DNS cache when \ref GSM_CFG_DNS_CACHE is enabled
  * \param[in]       port: Connection port
  * \param[in]       arg: Pointer to user argument passed to connection if successfully connected
  * \param[in]       evt_fn: Callback function for this connection
@@ -209,6 +306,67 @@ gsm_conn_start(gsm_conn_p* conn, gsm_conn_type_t type, const char* const host, g
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+
+/**
+ * \brief           Reopen connection closed by PDP deactivation
+ *
+ * Connection is started with the same number, host, port, callback and argument.
+ * Result is reported to connection callback as for \ref gsm_conn_start
+ *
+ * \note            Command is always non-blocking, function is called from processing thread
+ * \param[in]       conn: Connection handle to reopen
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_conn_resume(gsm_conn_p conn) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPSTART;
+    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CIPSTATUS;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.num = conn->num;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.type = conn->resume.type;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.host = conn->resume.host;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.port = conn->resume.port;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.evt_func = conn->evt_func;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.arg = conn->arg;
+    GSM_MSG_VAR_REF(msg).msg.conn_start.resume = conn;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, 0, 60000);  /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+
+/**
+ * \brief           Enable or disable TCP server on device
+ *
+ * When enabled, every connection accepted by device is reported with \ref GSM_EVT_CONN_ACTIVE event
+ * to callback function, where \ref gsm_conn_is_server returns `1` for connection handle
+ *
+ * \note            Connection timeout is not handled by device, application shall close idle connections
+ * \param[in]       en: Set to `1` to enable server, `0` to disable it
+ * \param[in]       port: Port number to listen on. Ignored when server is disabled
+ * \param[in]       cb_func: Callback function for server connections. Ignored when server is disabled
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_set_server(uint8_t en, gsm_port_t port, gsm_evt_fn cb_func, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("en == 0 || port > 0", !en || port > 0); /* Assert input parameters */
+    GSM_ASSERT("en == 0 || cb_func != NULL", !en || cb_func != NULL);   /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPSERVER;
+    GSM_MSG_VAR_REF(msg).msg.tcpip_server.en = en;
+    GSM_MSG_VAR_REF(msg).msg.tcpip_server.port = port;
+    GSM_MSG_VAR_REF(msg).msg.tcpip_server.cb = cb_func;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 5000);   /* Send message to producer queue */
+}
+
 /**
  * \brief           Close specific or all connections
  * \param[in]       conn: Connection handle to close. Set to NULL if you want to close all connections.
@@ -234,9 +392,11 @@ gsm_conn_close(gsm_conn_p conn, const uint32_t blocking) {
     res = gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000); /* Send message to producer queue */
     if (res == gsmOK && !blocking) {            /* Function succedded in non-blocking mode */
         GSM_CORE_PROTECT();                     /* Protect core */
+        GSM_CONN_TX_PROTECT(conn);              /* Status is also read by writers */
         GSM_DEBUGF(GSM_CFG_DBG_CONN | GSM_DBG_TYPE_TRACE,
             "[CONN] Connection %d set to closing state\r\n", (int)conn->num);
         conn->status.f.in_closing = 1;          /* Connection is in closing mode but not yet closed */
+        GSM_CONN_TX_UNPROTECT(conn);
         GSM_CORE_UNPROTECT();                   /* Unprotect core */
     }
     return res;
@@ -258,10 +418,202 @@ gsmr_t
 gsm_conn_sendto(gsm_conn_p conn, const gsm_ip_t* const ip, gsm_port_t port, const void* data, size_t btw, size_t* bw, const uint32_t blocking) {
     GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
 
-    flush_buff(conn);                           /* Flush currently written memory if exists */
+    FLUSH_BUFF_KEEP_CMD_EVT(conn);              /* Flush currently written memory if exists */
     return conn_send(conn, ip, port, data, btw, bw, 0, blocking);
 }
 
+/**
+ * \brief           Send multiple datagrams on active UDP connection with single command
+ *
+ *                  Datagrams are sent back to back from producer thread,
+ *                  each with its own `+CIPSEND` and remote address.
+ *                  Sending stops on first datagram which cannot be sent
+ *
+ * \note            In non-blocking mode, array and data must stay valid until \ref GSM_EVT_CONN_DATA_SEND event
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       dgrams: Array of datagrams to send
+ * \param[in]       dgramcnt: Number of entries in `dgrams` array
+ * \param[out]      sent: Pointer to output variable to save number of datagrams successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_sendto_batch(gsm_conn_p conn, const gsm_dgram_t* dgrams, size_t dgramcnt, size_t* const sent, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    size_t i;
+
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("dgrams != NULL", dgrams != NULL);   /* Assert input parameters */
+    GSM_ASSERT("dgramcnt > 0", dgramcnt > 0);   /* Assert input parameters */
+
+    if (sent != NULL) {
+        *sent = 0;
+    }
+    for (i = 0; i < dgramcnt; i++) {            /* Each datagram must fit single packet */
+        if (dgrams[i].data == NULL || !dgrams[i].len || dgrams[i].len > GSM_CFG_CONN_MAX_DATA_LEN) {
+            return gsmPARERR;
+        }
+    }
+
+    FLUSH_BUFF_KEEP_CMD_EVT(conn);              /* Flush currently written memory if exists */
+    CONN_CHECK_CLOSED_IN_CLOSING(conn);         /* Check if we can continue */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPSEND;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.dgrams = dgrams;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.dgramcnt = dgramcnt;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.dgram_sent = sent;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.data = dgrams[0].data;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.btw = dgrams[0].len;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.remote_ip = dgrams[0].ip;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.remote_port = dgrams[0].port;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.val_id = conn_get_val_id(conn);
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Send data from packet buffer on already active connection
+ *
+ *                  Data are sent directly from packet buffer memory without copy.
+ *                  Packet buffer may be a chain of multiple packet buffers.
+ *
+ * \note            Stack takes ownership of packet buffer and frees it with \ref gsm_pbuf_free
+ *                  when all data are sent or sending failed. Application must not use it after this call
+ *
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       pbuf: Packet buffer with data to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_send_pbuf(gsm_conn_p conn, gsm_pbuf_p pbuf, size_t* const bw, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    gsmr_t res = gsmOK;
+    size_t ref;
+
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("pbuf != NULL", pbuf != NULL);   /* Assert input parameters */
+
+    if (bw != NULL) {
+        *bw = 0;
+    }
+    FLUSH_BUFF_KEEP_CMD_EVT(conn);              /* Flush currently written memory if exists */
+
+    GSM_CORE_PROTECT();
+    if (conn->status.f.in_closing || !conn->status.f.active) {
+        res = gsmCLOSED;
+    } else if (!gsm_pbuf_length(pbuf, 1)) {
+        res = gsmPARERR;
+    }
+    GSM_CORE_UNPROTECT();
+    if (res == gsmOK && (msg = gsm_mem_pool_alloc(GSM_MEM_POOL_MSG, GSM_MEM_TAG_MSG, sizeof(*msg))) == NULL) {
+        res = gsmERRMEM;
+    }
+    if (res != gsmOK) {
+        gsm_pbuf_free(pbuf);                    /* We own packet buffer, free it */
+        return res;
+    }
+
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPSEND;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.pbuf = pbuf;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.btw = gsm_pbuf_length(pbuf, 1);
+    GSM_MSG_VAR_REF(msg).msg.conn_send.bw = bw;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.val_id = conn_get_val_id(conn);
+
+    /*
+     * Keep additional reference during the call.
+     * Stack releases its reference after data are sent,
+     * if it is still there, command was never processed
+     */
+    gsm_pbuf_ref(pbuf);
+    res = gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);
+    GSM_CORE_PROTECT();
+    ref = pbuf->ref;
+    GSM_CORE_UNPROTECT();
+    if (ref > 1 && (blocking || res != gsmOK)) {
+        gsm_pbuf_free(pbuf);                    /* Release reference of unprocessed command */
+    }
+    gsm_pbuf_free(pbuf);                        /* Release our reference */
+    return res;
+}
+
+/**
+ * \brief           Send data from data vectors on active connection
+ *
+ *                  Data are written to AT port directly from vectors after `> ` prompt,
+ *                  every packet is filled up to \ref GSM_CFG_CONN_MAX_DATA_LEN bytes across vector boundaries
+ *
+ * \note            Vectors and their data must stay valid until send is finished
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       iov: Array of data vectors
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \param[in]       off: Offset in bytes in all vectors to start sending from
+ * \param[in]       btw: Number of bytes to send
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_conn_sendv(gsm_conn_p conn, const gsm_iovec_t* iov, size_t iovcnt, size_t off, size_t btw, size_t* const bw, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("iov != NULL", iov != NULL);     /* Assert input parameters */
+    GSM_ASSERT("btw > 0", btw > 0);             /* Assert input parameters */
+
+    if (bw != NULL) {
+        *bw = 0;
+    }
+
+    CONN_CHECK_CLOSED_IN_CLOSING(conn);         /* Check if we can continue */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPSEND;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.conn = conn;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.iov = iov;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.iovcnt = iovcnt;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.ptr = off;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.btw = btw;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.bw = bw;
+    GSM_MSG_VAR_REF(msg).msg.conn_send.val_id = conn_get_val_id(conn);
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Send data from multiple buffers on already active connection
+ *
+ *                  Buffers are sent as one continuous stream, without copy to temporary memory
+ *
+ * \note            In non-blocking mode, vectors and their data must stay valid until \ref GSM_EVT_CONN_DATA_SEND event
+ * \param[in]       conn: Connection handle to send data
+ * \param[in]       iov: Array of data vectors to send
+ * \param[in]       iovcnt: Number of entries in `iov` array
+ * \param[out]      bw: Pointer to output variable to save number of sent data when successfully sent
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_sendv(gsm_conn_p conn, const gsm_iovec_t* iov, size_t iovcnt, size_t* const bw, const uint32_t blocking) {
+    size_t i, btw = 0;
+
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("iov != NULL", iov != NULL);     /* Assert input parameters */
+
+    for (i = 0; i < iovcnt; i++) {
+        btw += iov[i].len;
+    }
+    if (!btw) {
+        return gsmPARERR;
+    }
+    FLUSH_BUFF_KEEP_CMD_EVT(conn);              /* Flush currently written memory if exists */
+    return gsmi_conn_sendv(conn, iov, iovcnt, 0, btw, bw, blocking);
+}
+
 /**
  * \brief           Send data on already active connection either as client or server
  * \param[in]       conn: Connection handle to send data
@@ -281,7 +633,7 @@ gsm_conn_send(gsm_conn_p conn, const void* data, size_t btw, size_t* const bw, c
     GSM_ASSERT("data != NULL", data != NULL);   /* Assert input parameters */
     GSM_ASSERT("btw > 0", btw > 0);             /* Assert input parameters */
 
-    GSM_CORE_PROTECT();                         /* Protect core */
+    GSM_CONN_TX_PROTECT(conn);                  /* Protect connection write buffer */
     if (conn->buff.buff != NULL) {              /* Check if memory available */
         size_t to_copy;
         to_copy = GSM_MIN(btw, conn->buff.len - conn->buff.ptr);
@@ -292,10 +644,12 @@ gsm_conn_send(gsm_conn_p conn, const void* data, size_t btw, size_t* const bw, c
             btw -= to_copy;
         }
     }
-    GSM_CORE_UNPROTECT();                       /* Unprotect core */
-    res = flush_buff(conn);                     /* Flush currently written memory if exists */
+    GSM_CONN_TX_UNPROTECT(conn);                /* Unprotect connection write buffer */
     if (btw) {                                  /* Check for remaining data */
+        FLUSH_BUFF_KEEP_CMD_EVT(conn);          /* Flush currently written memory if exists */
         res = conn_send(conn, NULL, 0, d, btw, bw, 0, blocking);
+    } else {
+        res = flush_buff(conn);                 /* Flush currently written memory, it holds all data */
     }
     return res;
 }
@@ -305,10 +659,9 @@ gsm_conn_send(gsm_conn_p conn, const void* data, size_t btw, size_t* const bw, c
  * 
  *                  Once data reception is confirmed, stack will try to send more data to user.
  * 
- * \note            Since this feature is not supported yet by AT commands, function is only prototype
- *                  and should be used in connection callback when data are received
- *
- * \note            Function is not thread safe and may only be called from callback function
+ * \note            Function has effect only when \ref GSM_CFG_CONN_MANUAL_TCP_RECEIVE is enabled.
+ *                  It may be called from connection callback or later from any thread
+ *                  once application processed the data
  *
  * \param[in]       conn: Connection handle
  * \param[in]       pbuf: Packet buffer received on connection
@@ -318,13 +671,18 @@ gsmr_t
 gsm_conn_recved(gsm_conn_p conn, gsm_pbuf_p pbuf) {
 #if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
     size_t len;
+
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("pbuf != NULL", pbuf != NULL);   /* Assert input parameters */
+
     len = gsm_pbuf_length(pbuf, 1);             /* Get length of pbuf */
-    if (conn->tcp_available_data > len) {
-        conn->tcp_available_data -= len;        /* Decrease for available length */
-        if (conn->tcp_available_data) {
-            /* Start new manual receive here... */
-        }
+    GSM_CORE_PROTECT();                         /* Protect core */
+    conn->tcp_not_ack_bytes -= GSM_MIN(len, conn->tcp_not_ack_bytes);
+    if (conn->tcp_not_ack_pkts > 0) {
+        conn->tcp_not_ack_pkts--;
     }
+    gsmi_conn_manual_tcp_try_read_data(conn);   /* Application has room for more data */
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
 #else /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
     GSM_UNUSED(conn);
     GSM_UNUSED(pbuf);
@@ -332,6 +690,215 @@ gsm_conn_recved(gsm_conn_p conn, gsm_pbuf_p pbuf) {
     return gsmOK;
 }
 
+/**
+ * \brief           Set receive window of connection
+ *
+ * Stack stops reading data from device once application holds
+ * this many not confirmed bytes or packet buffers.
+ * Reading resumes with \ref gsm_conn_recved calls
+ *
+ * \note            Function has effect only when \ref GSM_CFG_CONN_MANUAL_TCP_RECEIVE is enabled.
+ *                  Window is reset to \ref GSM_CFG_CONN_MANUAL_TCP_RECEIVE_WINDOW bytes each time connection becomes active
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       bytes: Maximal number of not confirmed bytes
+ * \param[in]       pkts: Maximal number of not confirmed packet buffers. Set to `0` for no limit
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_set_receive_window(gsm_conn_p conn, size_t bytes, size_t pkts) {
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("bytes > 0", bytes > 0);         /* Assert input parameters */
+
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    GSM_CORE_PROTECT();                         /* Protect core */
+    conn->tcp_rx_window = bytes;
+    conn->tcp_rx_window_pkts = pkts;
+    gsmi_conn_manual_tcp_try_read_data(conn);   /* Window may be larger now */
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+#else /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+    GSM_UNUSED(pkts);
+#endif /* !GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+    return gsmOK;
+}
+
+/**
+ * \brief           Set interval of \ref GSM_EVT_CONN_POLL events for connection
+ *
+ * Polling is disabled when connection becomes active.
+ * All connections share single timer, which only runs while at least one connection is polled.
+ * Polling is disabled automatically when connection callback returns \ref gsmERR for poll event
+ *
+ * \param[in]       conn: Connection handle
+ * \param[in]       interval: Poll interval in units of milliseconds. Set to `0` to disable polling
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_set_poll_interval(gsm_conn_p conn, uint32_t interval) {
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    conn->poll_interval = interval;
+    conn->poll_next = gsm_sys_now() + interval;
+    gsmi_conn_poll_schedule();                  /* Timer may need to run earlier or not at all */
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+
+/**
+ * \brief           Store certificate to device and use it for TLS connections
+ *
+ * Certificate is written to device file system once and stays there after reset.
+ * Later, call function with `data` set to `NULL` to only select stored file
+ *
+ * \note            Use \ref GSM_CONN_TYPE_SSL to start connection with TLS handled by device
+ * \param[in]       name: File name on device, without path
+ * \param[in]       data: Certificate data to write or `NULL` to use file already on device.
+ *                      Must stay valid until command finishes
+ * \param[in]       len: Length of certificate data in units of bytes
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_ssl_set_cert(const char* name, const void* data, size_t len, const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("name != NULL", name != NULL);   /* Assert input parameters */
+    GSM_ASSERT("data == NULL || (len > 0 && len <= 10240)", data == NULL || (len > 0 && len <= 10240)); /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_SSLSETCERT;
+    GSM_MSG_VAR_REF(msg).cmd = data != NULL ? GSM_CMD_FSDEL : GSM_CMD_SSLSETCERT;
+    GSM_MSG_VAR_REF(msg).msg.ssl_cert.name = name;
+    GSM_MSG_VAR_REF(msg).msg.ssl_cert.data = data;
+    GSM_MSG_VAR_REF(msg).msg.ssl_cert.len = len;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 30000);  /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
+
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Check if host name may be resolved and stored in DNS cache
+ * \param[in]       host: Host name or IP address as string
+ * \return          `1` if host should be resolved, `0` for IP address or too long host name
+ */
+uint8_t
+gsmi_dns_cache_is_cacheable(const char* host) {
+    size_t len = 0;
+    uint8_t is_ip = 1;
+
+    for (; host[len] != '\0'; len++) {
+        if (!GSM_CHARISNUM(host[len]) && host[len] != '.') {
+            is_ip = 0;
+        }
+    }
+    return !is_ip && len < GSM_CFG_DNS_CACHE_HOST_LEN;
+}
+
+/**
+ * \brief           Get resolved IP address of host from DNS cache
+ * \note            Core must be protected when calling this function
+ * \param[in]       host: Host name
+ * \param[out]      ip: Output IP address
+ * \return          `1` if valid entry exists, `0` otherwise
+ */
+uint8_t
+gsmi_dns_cache_get(const char* host, gsm_ip_t* ip) {
+    uint32_t now = gsm_sys_now();
+
+    for (size_t i = 0; i < GSM_CFG_DNS_CACHE_SIZE; i++) {
+        if (gsm.dns_cache[i].valid && !strcmp(gsm.dns_cache[i].host, host)) {
+            if ((now - gsm.dns_cache[i].time) >= GSM_CFG_DNS_CACHE_TTL) {
+                gsm.dns_cache[i].valid = 0;     /* Entry expired */
+                return 0;
+            }
+            *ip = gsm.dns_cache[i].ip;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Store resolved IP address of host to DNS cache
+ * \note            Core must be protected when calling this function
+ * \param[in]       host: Host name, must be shorter than \ref GSM_CFG_DNS_CACHE_HOST_LEN
+ * \param[in]       ip: Resolved IP address
+ */
+void
+gsmi_dns_cache_put(const char* host, const gsm_ip_t* ip) {
+    size_t idx = 0;
+
+    /* Use entry of the same host, free entry or oldest entry, in this order */
+    for (size_t i = 0; i < GSM_CFG_DNS_CACHE_SIZE; i++) {
+        if (gsm.dns_cache[i].valid && !strcmp(gsm.dns_cache[i].host, host)) {
+            idx = i;
+            break;
+        }
+        if (!gsm.dns_cache[i].valid) {
+            if (gsm.dns_cache[idx].valid) {
+                idx = i;
+            }
+        } else if (gsm.dns_cache[idx].valid
+            && (int32_t)(gsm.dns_cache[i].time - gsm.dns_cache[idx].time) < 0) {
+            idx = i;
+        }
+    }
+    strncpy(gsm.dns_cache[idx].host, host, sizeof(gsm.dns_cache[idx].host) - 1);
+    gsm.dns_cache[idx].host[sizeof(gsm.dns_cache[idx].host) - 1] = '\0';
+    gsm.dns_cache[idx].ip = *ip;
+    gsm.dns_cache[idx].time = gsm_sys_now();
+    gsm.dns_cache[idx].valid = 1;
+}
+
+/**
+ * \brief           Remove host from DNS cache
+ * \note            Core must be protected when calling this function
+ * \param[in]       host: Host name
+ */
+void
+gsmi_dns_cache_remove(const char* host) {
+    for (size_t i = 0; i < GSM_CFG_DNS_CACHE_SIZE; i++) {
+        if (gsm.dns_cache[i].valid && !strcmp(gsm.dns_cache[i].host, host)) {
+            gsm.dns_cache[i].valid = 0;
+        }
+    }
+}
+
+/**
+ * \brief           Remove all entries from DNS cache
+ * \note            Core must be protected when calling this function
+ */
+void
+gsmi_dns_cache_flush(void) {
+    for (size_t i = 0; i < GSM_CFG_DNS_CACHE_SIZE; i++) {
+        gsm.dns_cache[i].valid = 0;
+    }
+}
+
+/**
+ * \brief           Remove all entries from DNS cache
+ *
+ * Use when remote hosts are known to change address,
+ * next \ref gsm_conn_start call resolves host name again
+ *
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_dns_cache_flush(void) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    gsmi_dns_cache_flush();
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
+
 /**
  * \brief           Set argument variable for connection
  * \param[in]       conn: Connection handle to set argument
@@ -362,6 +929,40 @@ gsm_conn_get_arg(gsm_conn_p conn) {
     return arg;
 }
 
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+
+/**
+ * \brief           Enable or disable connection resume after network reattach
+ *
+ * When enabled and PDP context is deactivated, connection is reopened after automatic reattach.
+ * Owner gets single \ref GSM_EVT_CONN_ACTIVE event when connection is reopened,
+ * or single \ref GSM_EVT_CONN_ERROR or \ref GSM_EVT_CONN_CLOSED event when it is not.
+ * Connection handle stays the same
+ *
+ * \note            Only active client connections with host name shorter than
+ *                  \ref GSM_CFG_NETWORK_REATTACH_HOST_LEN can be resumed
+ * \param[in]       conn: Connection handle
+ * \param[in]       en: Set to `1` to enable resume, `0` to disable it
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_set_resume(gsm_conn_p conn, uint8_t en) {
+    gsmr_t res = gsmOK;
+
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (en && (!conn->status.f.active || !conn->status.f.client || !conn->resume.host[0])) {
+        res = gsmERR;
+    } else {
+        conn->resume.en = GSM_U8(!!en);
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+
 /**
  * \brief           Gets connections status
  * \param[in]       blocking: Status whether command should be blocking or not
@@ -493,10 +1094,12 @@ gsm_conn_get_from_evt(gsm_evt_t* evt) {
 gsmr_t
 gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, size_t* const mem_available) {
     size_t len;
+    gsmr_t res = gsmOK;
     
     const uint8_t* d = data;
     
     GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    CMD_EVT_SUSPEND();                          /* Buffered write never takes completion callback */
     
     /*
      * Steps, performed in write process:
@@ -511,6 +1114,8 @@ gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, siz
      * 4. Flush (send) current buffer if necessary
      */
     
+    GSM_CONN_TX_PROTECT(conn);                  /* Only this connection is locked, not the core */
+
     /* Step 1 */
     if (conn->buff.buff != NULL) {
         len = GSM_MIN(conn->buff.len - conn->buff.ptr, btw);
@@ -535,7 +1140,7 @@ gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, siz
     /* Step 2 */
     while (btw >= GSM_CFG_CONN_MAX_DATA_LEN) {
         uint8_t* buff;
-        buff = gsm_mem_alloc(sizeof(*buff) * GSM_CFG_CONN_MAX_DATA_LEN);    /* Allocate memory */
+        buff = gsm_mem_pool_alloc(GSM_MEM_POOL_TX_CHUNK, GSM_MEM_TAG_CONN, sizeof(*buff) * GSM_CFG_CONN_MAX_DATA_LEN);    /* Allocate memory */
         if (buff != NULL) {
             GSM_MEMCPY(buff, d, GSM_CFG_CONN_MAX_DATA_LEN); /* Copy data to buffer */
             if (conn_send(conn, NULL, 0, buff, GSM_CFG_CONN_MAX_DATA_LEN, NULL, 1, 0) != gsmOK) {
@@ -543,19 +1148,27 @@ gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, siz
                     "[CONN] Free write buffer: %p\r\n", (void *)buff);
                 gsm_mem_free(buff);             /* Manually free memory */
                 buff = NULL;
-                return gsmERRMEM;
+                res = gsmERRMEM;
+                break;
             }
         } else {
-            return gsmERRMEM;
+            res = gsmERRMEM;
+            break;
         }
         
         btw -= GSM_CFG_CONN_MAX_DATA_LEN;       /* Decrease remaining length */
         d += GSM_CFG_CONN_MAX_DATA_LEN;         /* Advance data pointer */
     }
     
+    if (res != gsmOK) {
+        GSM_CONN_TX_UNPROTECT(conn);
+        CMD_EVT_RESUME();
+        return res;
+    }
+
     /* Step 3 */
     if (conn->buff.buff == NULL) {
-        conn->buff.buff = gsm_mem_alloc(sizeof(*conn->buff.buff) * GSM_CFG_CONN_MAX_DATA_LEN);  /* Allocate memory for temp buffer */
+        conn->buff.buff = gsm_mem_pool_alloc(GSM_MEM_POOL_TX_CHUNK, GSM_MEM_TAG_CONN, sizeof(*conn->buff.buff) * GSM_CFG_CONN_MAX_DATA_LEN);  /* Allocate memory for temp buffer */
         conn->buff.len = GSM_CFG_CONN_MAX_DATA_LEN;
         conn->buff.ptr = 0;
         
@@ -569,6 +1182,8 @@ gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, siz
             GSM_MEMCPY(conn->buff.buff, d, btw);    /* Copy data to memory */
             conn->buff.ptr = btw;
         } else {
+            GSM_CONN_TX_UNPROTECT(conn);
+            CMD_EVT_RESUME();
             return gsmERRMEM;
         }
     }
@@ -586,6 +1201,8 @@ gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, siz
             *mem_available = 0;
         }
     }
+    GSM_CONN_TX_UNPROTECT(conn);
+    CMD_EVT_RESUME();
     return gsmOK;
 }
 
@@ -606,6 +1223,29 @@ gsm_conn_get_total_recved_count(gsm_conn_p conn) {
     return tot;
 }
 
+/**
+ * \brief           Get traffic statistics of connection
+ * \param[in]       conn: Connection handle
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_get_stats(gsm_conn_p conn, gsm_conn_stats_t* stats) {
+    GSM_ASSERT("conn != NULL", conn != NULL);   /* Assert input parameters */
+    GSM_ASSERT("stats != NULL", stats != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    *stats = conn->stats;
+    stats->rx_bytes = conn->total_recved;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+
+    if (stats->tx_chunks) {
+        stats->tx_fill = GSM_U8(GSM_MIN(stats->tx_bytes / stats->tx_chunks * 100 / GSM_CFG_CONN_MAX_DATA_LEN, 100));
+        stats->ack_time_avg = stats->ack_time_total / stats->tx_chunks;
+    }
+    return gsmOK;
+}
+
 
 
 /**
@@ -657,5 +1297,73 @@ gsm_conn_get_local_port(gsm_conn_p conn) {
     return port;
 }
 
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+
+/**
+ * \brief           Request transparent or multiple connections mode
+ *
+ * Mode is applied by device on next \ref gsm_network_attach call.
+ * Only one connection can be active in transparent mode and it uses
+ * device data mode after it is connected
+ *
+ * \param[in]       enable: Set to `1` to use transparent mode or `0` to use multiple connections mode
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_set_transparent(uint8_t enable) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    gsm.transp.req = !!enable;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+/**
+ * \brief           Check if device is configured for transparent mode
+ * \return          `1` if transparent mode is active, `0` otherwise
+ */
+uint8_t
+gsm_conn_is_transparent(void) {
+    uint8_t res;
+    GSM_CORE_PROTECT();                         /* Protect core */
+    res = gsm.transp.active;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Leave data mode of transparent connection and return to command mode
+ *
+ * Connection stays active and other AT commands can be used
+ * until \ref gsm_conn_transparent_resume is called
+ *
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_transparent_pause(const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_TRANSP_ESCAPE;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 2 * GSM_CFG_CONN_TRANSPARENT_GUARD_TIME + 1000);    /* Send message to producer queue */
+}
+
+/**
+ * \brief           Return to data mode of transparent connection
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_conn_transparent_resume(const uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_ATO;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);    /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
 
 #endif /* GSM_CFG_CONN || __DOXYGEN__ */
@@ -55,6 +55,28 @@ gsm_evt_reset_is_forced(gsm_evt_t* cc) {
     return cc->evt.reset.forced;                /* Return forced reset status */
 }
 
+/**
+ * \brief           Get AT port baudrate after change
+ * \note            This function may only be used when event type is \ref GSM_EVT_AT_BAUDRATE
+ * \param[in]       cc: Event data
+ * \return          Baudrate in units of bits per second
+ */
+uint32_t
+gsm_evt_at_baudrate_get_baudrate(gsm_evt_t* cc) {
+    return cc->evt.at_baudrate.baudrate;
+}
+
+/**
+ * \brief           Get result of AT port baudrate change
+ * \note            This function may only be used when event type is \ref GSM_EVT_AT_BAUDRATE
+ * \param[in]       cc: Event data
+ * \return          \ref gsmOK when requested baudrate is active, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_evt_at_baudrate_get_result(gsm_evt_t* cc) {
+    return cc->evt.at_baudrate.res;
+}
+
 /**
  * \brief           Get current operator data from event
  * \note            This function may only be used when event type is \ref GSM_EVT_OPERATOR_CURRENT
@@ -66,6 +88,28 @@ gsm_evt_network_operator_get_current(gsm_evt_t* cc) {
     return cc->evt.operator_current.operator_current;
 }
 
+/**
+ * \brief           Get operator found during scan
+ * \note            This function may only be used when event type is \ref GSM_EVT_NETWORK_OPERATOR_SCAN
+ * \param[in]       cc: Event data
+ * \return          Operator handle, valid only during event callback
+ */
+const gsm_operator_t *
+gsm_evt_network_operator_scan_get_operator(gsm_evt_t* cc) {
+    return cc->evt.operator_scan.op;
+}
+
+/**
+ * \brief           Get index of operator found during scan
+ * \note            This function may only be used when event type is \ref GSM_EVT_NETWORK_OPERATOR_SCAN
+ * \param[in]       cc: Event data
+ * \return          Index of operator in scan result, starting with `0`
+ */
+size_t
+gsm_evt_network_operator_scan_get_index(gsm_evt_t* cc) {
+    return cc->evt.operator_scan.index;
+}
+
 /**
  * \brief           Get RSSi from CSQ command
  * \param[in]       cc: Event data
@@ -293,4 +337,72 @@ gsm_evt_sms_send_get_pos(gsm_evt_t* cc) {
     return cc->evt.sms_send.num;
 }
 
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Get recipients array with per recipient results
+ * \param[in]       cc: Event handle
+ * \return          Pointer to recipients array
+ */
+gsm_sms_recipient_t*
+gsm_evt_sms_send_batch_get_recipients(gsm_evt_t* cc) {
+    return cc->evt.sms_send_batch.rcpts;
+}
+
+/**
+ * \brief           Get number of recipients in batch
+ * \param[in]       cc: Event handle
+ * \return          Number of recipients
+ */
+size_t
+gsm_evt_sms_send_batch_get_count(gsm_evt_t* cc) {
+    return cc->evt.sms_send_batch.count;
+}
+
+/**
+ * \brief           Get number of recipients with successful send
+ * \param[in]       cc: Event handle
+ * \return          Number of successful recipients
+ */
+size_t
+gsm_evt_sms_send_batch_get_sent(gsm_evt_t* cc) {
+    return cc->evt.sms_send_batch.sent;
+}
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
 #endif /* GSM_CFG_CONN || __DOXYGEN__ */
+
+#if GSM_CFG_PING || __DOXYGEN__
+
+/**
+ * \brief           Get probed host of link quality event
+ * \param[in]       cc: Event handle
+ * \return          Host name or IP address
+ */
+const char*
+gsm_evt_link_quality_get_host(gsm_evt_t* cc) {
+    return cc->evt.link_quality.host;
+}
+
+/**
+ * \brief           Get statistics of link quality probe
+ * \param[in]       cc: Event handle
+ * \return          Pointer to statistics, valid until next probe round starts
+ */
+const gsm_ping_stats_t*
+gsm_evt_link_quality_get_stats(gsm_evt_t* cc) {
+    return cc->evt.link_quality.stats;
+}
+
+/**
+ * \brief           Get result of link quality probe
+ * \param[in]       cc: Event handle
+ * \return          Member of \ref gsmr_t enumeration
+ */
+gsmr_t
+gsm_evt_link_quality_get_result(gsm_evt_t* cc) {
+    return cc->evt.link_quality.res;
+}
+
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
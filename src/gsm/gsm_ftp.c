@@ -36,4 +36,183 @@
 
 #if GSM_CFG_FTP || __DOXYGEN__
 
+/**
+ * \brief           Mark start of next transfer chunk
+ * \param[in]       msg: FTP message
+ */
+void
+gsmi_ftp_chunk_start(gsm_msg_t* msg) {
+    msg->msg.ftp.chunk_start = gsm_sys_now();
+}
+
+/**
+ * \brief           Update transfer statistics with finished chunk
+ * \param[in]       msg: FTP message
+ * \param[in]       len: Number of bytes in chunk
+ */
+void
+gsmi_ftp_chunk_done(gsm_msg_t* msg, size_t len) {
+    gsm_ftp_stats_t* s = msg->msg.ftp.stats;
+    uint32_t now, t;
+
+    if (s == NULL || !len) {
+        return;
+    }
+    now = gsm_sys_now();
+    t = now - msg->msg.ftp.chunk_start;
+    s->bytes += len;
+    s->chunks++;
+    s->chunk_time_total += t;
+    if (t > s->chunk_time_max) {
+        s->chunk_time_max = t;
+    }
+    s->time = now - msg->msg.ftp.start;
+}
+
+/**
+ * \brief           Process received FTP file data
+ * \note            Function is called from processing thread with active `+FTPGET=2` command
+ * \param[in]       data: Received data
+ * \param[in]       len: Number of bytes available in data
+ * \return          Number of bytes consumed from data
+ */
+size_t
+gsmi_ftp_recv(const void* data, size_t len) {
+    gsm_msg_t* msg = gsm.msg;
+    gsmr_t res;
+
+    if (msg->msg.ftp.buff == NULL && !msg->msg.ftp.stop) {
+        msg->msg.ftp.buff = gsm_pbuf_new(msg->msg.ftp.rem); /* Entire chunk is delivered at once */
+        msg->msg.ftp.buff_ptr = 0;
+        if (msg->msg.ftp.buff == NULL) {
+            GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+                "[FTP] Buffer allocation failed for %d bytes\r\n", (int)msg->msg.ftp.rem);
+            msg->msg.ftp.stop = 1;              /* Ignore rest of file */
+            msg->msg.ftp.err = 1;
+        }
+    }
+
+    len = GSM_MIN(len, msg->msg.ftp.rem);
+    if (msg->msg.ftp.buff != NULL) {
+        GSM_MEMCPY(&msg->msg.ftp.buff->payload[msg->msg.ftp.buff_ptr], data, len);
+        msg->msg.ftp.buff_ptr += len;
+    }
+    msg->msg.ftp.rem -= len;
+    if (!msg->msg.ftp.rem) {                    /* Chunk is received */
+        gsm_pbuf_p p = msg->msg.ftp.buff;
+
+        msg->msg.ftp.read = 0;
+        if (p != NULL) {
+            gsmi_ftp_chunk_done(msg, p->len);
+            res = msg->msg.ftp.sink != NULL ? msg->msg.ftp.sink(p, msg->msg.ftp.offset, msg->msg.ftp.arg) : gsmOK;
+            msg->msg.ftp.offset += p->len;
+            gsm_pbuf_free(p);                   /* Free our reference */
+            msg->msg.ftp.buff = NULL;
+            if (res != gsmOK) {                 /* Application does not want more data */
+                msg->msg.ftp.stop = 1;
+                msg->msg.ftp.err = res != gsmOKIGNOREMORE;
+            }
+        }
+    }
+    return len;
+}
+
+/**
+ * \brief           Get next chunk to upload from application
+ * \param[in]       msg: FTP message
+ */
+void
+gsmi_ftp_put_next(gsm_msg_t* msg) {
+    const void* data = NULL;
+    size_t len = 0;
+
+    msg->msg.ftp.offset += msg->msg.ftp.len;    /* Previous chunk was written */
+    if (msg->msg.ftp.source != NULL) {
+        len = msg->msg.ftp.source(&data, msg->msg.ftp.max_len, msg->msg.ftp.offset, msg->msg.ftp.arg);
+    }
+    msg->msg.ftp.data = data;
+    msg->msg.ftp.len = data != NULL ? GSM_MIN(len, msg->msg.ftp.max_len) : 0;
+}
+
+/**
+ * \brief           Prepare FTP transfer message
+ * \param[in]       msg: Message to prepare
+ * \param[in]       cmd: Default command of transfer
+ * \param[in]       server: Server login information
+ * \param[in]       path: File path on server
+ * \param[in]       name: File name on server
+ * \param[in]       arg: Custom argument for sink or source function
+ * \param[out]      stats: Pointer to output transfer statistics
+ */
+static void
+ftp_msg_prepare(gsm_msg_t* msg, gsm_cmd_t cmd, const gsm_ftp_server_t* server, const char* path, const char* name, void* arg, gsm_ftp_stats_t* stats) {
+    msg->cmd_def = cmd;
+    msg->cmd = GSM_CMD_FTPCID;
+    msg->msg.ftp.server = server;
+    msg->msg.ftp.path = path;
+    msg->msg.ftp.name = name;
+    msg->msg.ftp.arg = arg;
+    msg->msg.ftp.stats = stats;
+    if (stats != NULL) {
+        GSM_MEMSET(stats, 0x00, sizeof(*stats));
+    }
+}
+
+/**
+ * \brief           Download file from FTP server and stream it to sink function
+ * \note            All input parameters must stay valid until command finishes
+ * \param[in]       server: Server login information
+ * \param[in]       path: File path on server, for example `/logs/`
+ * \param[in]       name: File name on server
+ * \param[in]       fn: Function called with file data. Set to `NULL` to skip data
+ * \param[in]       arg: Custom argument for sink function
+ * \param[out]      stats: Pointer to output transfer statistics. Set to `NULL` if not used
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ftp_get(const gsm_ftp_server_t* server, const char* path, const char* name,
+                gsm_ftp_sink_fn fn, void* arg, gsm_ftp_stats_t* stats, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("server != NULL", server != NULL);   /* Assert input parameters */
+    GSM_ASSERT("path != NULL", path != NULL);   /* Assert input parameters */
+    GSM_ASSERT("name != NULL", name != NULL);   /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    ftp_msg_prepare(&GSM_MSG_VAR_REF(msg), GSM_CMD_FTP_GET, server, path, name, arg, stats);
+    GSM_MSG_VAR_REF(msg).msg.ftp.sink = fn;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, GSM_CFG_FTP_TIMEOUT); /* Send message to producer queue */
+}
+
+/**
+ * \brief           Upload file to FTP server with data provided by source function
+ * \note            All input parameters must stay valid until command finishes
+ * \param[in]       server: Server login information
+ * \param[in]       path: File path on server, for example `/logs/`
+ * \param[in]       name: File name on server
+ * \param[in]       fn: Function called to get next chunk of file
+ * \param[in]       arg: Custom argument for source function
+ * \param[out]      stats: Pointer to output transfer statistics. Set to `NULL` if not used
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ftp_put(const gsm_ftp_server_t* server, const char* path, const char* name,
+                gsm_ftp_source_fn fn, void* arg, gsm_ftp_stats_t* stats, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("server != NULL", server != NULL);   /* Assert input parameters */
+    GSM_ASSERT("path != NULL", path != NULL);   /* Assert input parameters */
+    GSM_ASSERT("name != NULL", name != NULL);   /* Assert input parameters */
+    GSM_ASSERT("fn != NULL", fn != NULL);       /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    ftp_msg_prepare(&GSM_MSG_VAR_REF(msg), GSM_CMD_FTP_PUT, server, path, name, arg, stats);
+    GSM_MSG_VAR_REF(msg).msg.ftp.source = fn;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, GSM_CFG_FTP_TIMEOUT); /* Send message to producer queue */
+}
+
 #endif /* GSM_CFG_FTP || __DOXYGEN__ */
@@ -36,4 +36,99 @@
 
 #if GSM_CFG_HTTP || __DOXYGEN__
 
+/**
+ * \brief           Process received HTTP response body data
+ * \note            Function is called from processing thread with active `+HTTPREAD` command
+ * \param[in]       data: Received data
+ * \param[in]       len: Number of bytes available in data
+ * \return          Number of bytes consumed from data
+ */
+size_t
+gsmi_http_recv(const void* data, size_t len) {
+    gsm_msg_t* msg = gsm.msg;
+    gsmr_t res;
+
+    if (msg->msg.http_get.buff == NULL && !msg->msg.http_get.stop) {
+        size_t new_len = GSM_MIN(msg->msg.http_get.rem, GSM_CFG_HTTP_BUFF_SIZE);
+
+        msg->msg.http_get.buff = gsm_pbuf_new(new_len); /* Allocate buffer for next part of body */
+        msg->msg.http_get.buff_ptr = 0;
+        if (msg->msg.http_get.buff == NULL) {
+            GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+                "[HTTP] Buffer allocation failed for %d bytes\r\n", (int)new_len);
+            msg->msg.http_get.stop = 1;         /* Ignore rest of body */
+            msg->msg.http_get.err = 1;
+        }
+    }
+
+    len = GSM_MIN(len, msg->msg.http_get.rem);
+    if (msg->msg.http_get.buff != NULL) {
+        gsm_pbuf_p p = msg->msg.http_get.buff;
+
+        len = GSM_MIN(len, p->len - msg->msg.http_get.buff_ptr);
+        GSM_MEMCPY(&p->payload[msg->msg.http_get.buff_ptr], data, len);
+        msg->msg.http_get.buff_ptr += len;
+        if (msg->msg.http_get.buff_ptr == p->len) { /* Is buffer full? */
+            res = msg->msg.http_get.fn != NULL ? msg->msg.http_get.fn(p, msg->msg.http_get.offset, msg->msg.http_get.arg) : gsmOK;
+            msg->msg.http_get.offset += p->len;
+            gsm_pbuf_free(p);                   /* Free our reference */
+            msg->msg.http_get.buff = NULL;
+            if (res != gsmOK) {                 /* Application does not want more data */
+                msg->msg.http_get.stop = 1;
+                msg->msg.http_get.err = res != gsmOKIGNOREMORE;
+            }
+        }
+    }
+    msg->msg.http_get.rem -= len;
+    if (!msg->msg.http_get.rem) {
+        msg->msg.http_get.read = 0;             /* Window is received */
+    }
+    return len;
+}
+
+/**
+ * \brief           Check if another part of response body shall be read
+ * \param[in]       msg: HTTP GET message
+ * \return          `1` if more data shall be read, `0` otherwise
+ */
+uint8_t
+gsmi_http_read_next(gsm_msg_t* msg) {
+    return !msg->msg.http_get.stop && !msg->msg.http_get.err
+        && msg->msg.http_get.offset < msg->msg.http_get.body_len;
+}
+
+/**
+ * \brief           Execute HTTP GET request and stream response body to sink function
+ *
+ * Function succeeds when request was executed and entire body was passed to sink function,
+ * regardless of HTTP status code. Check `status` for server response
+ *
+ * \note            URL must stay valid until command finishes
+ * \param[in]       url: Request URL. HTTPS is used when URL starts with `https://`
+ * \param[in]       fn: Function called with response body data. Set to `NULL` to skip body
+ * \param[in]       arg: Custom argument for sink function
+ * \param[out]      status: Pointer to output HTTP status code. Set to `NULL` if not used
+ * \param[out]      len: Pointer to output response body length. Set to `NULL` if not used
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_http_get(const char* url, gsm_http_sink_fn fn, void* arg, uint16_t* status, size_t* len, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("url != NULL", url != NULL);     /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_HTTP_GET;
+    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_HTTPTERM;    /* Terminate previous session first */
+    GSM_MSG_VAR_REF(msg).msg.http_get.url = url;
+    GSM_MSG_VAR_REF(msg).msg.http_get.fn = fn;
+    GSM_MSG_VAR_REF(msg).msg.http_get.arg = arg;
+    GSM_MSG_VAR_REF(msg).msg.http_get.status = status;
+    GSM_MSG_VAR_REF(msg).msg.http_get.len = len;
+    GSM_MSG_VAR_REF(msg).msg.http_get.ssl = !strncmp(url, "https://", 8);
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, GSM_CFG_HTTP_TIMEOUT);    /* Send message to producer queue */
+}
+
 #endif /* GSM_CFG_HTTP || __DOXYGEN__ */
@@ -35,27 +35,101 @@
 #include "gsm/gsm_input.h"
 #include "gsm/gsm_buff.h"
 
-static uint32_t gsm_recv_total_len;
-static uint32_t gsm_recv_calls;
 
 #if !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__
 
+/**
+ * \brief           Wakeup processing thread after new data were written to input buffer
+ *
+ *                  Thread is notified only when buffer contains nothing but new data,
+ *                  meaning it was empty before write and thread may be waiting.
+ *                  Otherwise processing thread has not yet finished with old data
+ *                  and will find new data before it goes to wait
+ *
+ * \param[in]       written: Number of bytes just written to buffer
+ */
+static void
+input_notify(size_t written) {
+    size_t full = GSMI_BUFF_FN(gsm_buff_get_full)(&gsm.buff);
+    if (written > 0 && full == written) {
+        GSMI_PROCESS_WAKEUP();                  /* Wakeup processing thread, don't care if it fails */
+    }
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+    /* Ask device to stop before buffer overflows, processing thread resumes it */
+    if (!gsm.rx_paused && full >= GSM_CFG_AT_PORT_FLOW_HIGH_WATERMARK) {
+        gsm.rx_paused = 1;
+        if (gsm.ll.rx_flow_fn != NULL) {
+            gsm.ll.rx_flow_fn(0);
+        }
+    }
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+}
+
 /**
  * \brief           Write data to input buffer
  * \note            \ref GSM_CFG_INPUT_USE_PROCESS must be disabled to use this function
+ * \note            Function may be called from interrupt context when system port
+ *                  wakes processing thread with interrupt safe call, such as CMSIS-RTOS2 port
  * \param[in]       data: Pointer to data to write
  * \param[in]       len: Number of data elements in units of bytes
  * \return          Member of \ref gsmr_t enumeration
  */
 gsmr_t
 gsm_input(const void* data, size_t len) {
+    size_t written;
+
     if (gsm.buff.buff == NULL) {
         return gsmERR;
     }
-    gsm_buff_write(&gsm.buff, data, len);       /* Write data to buffer */
-    gsm_sys_mbox_putnow(&gsm.mbox_process, NULL);   /* Write empty box, don't care if write fails */
-    gsm_recv_total_len += len;                  /* Update total number of received bytes */
-    gsm_recv_calls++;                           /* Update number of calls */
+#if GSM_CFG_AT_CAPTURE
+    gsmi_capture(GSM_CAPTURE_DIR_RX, data, len);
+#endif /* GSM_CFG_AT_CAPTURE */
+    written = GSMI_BUFF_FN(gsm_buff_write)(&gsm.buff, data, len);   /* Write data to buffer */
+    input_notify(written);
+    gsm.recv_total_len += len;                  /* Update total number of received bytes */
+    gsm.recv_calls++;                           /* Update number of calls */
+    return gsmOK;
+}
+
+/**
+ * \brief           Get linear memory in input buffer to write received data to directly, for example with DMA
+ * \note            \ref GSM_CFG_INPUT_USE_PROCESS must be disabled to use this function
+ * \note            Use \ref gsm_input_advance once data are written to memory
+ * \param[out]      addr: Pointer to output variable to save write address to
+ * \param[out]      len: Pointer to output variable to save number of bytes available at address
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_input_get_write_block(void** addr, size_t* len) {
+    GSM_ASSERT("addr != NULL", addr != NULL);   /* Assert input parameters */
+    GSM_ASSERT("len != NULL", len != NULL);     /* Assert input parameters */
+
+    if (gsm.buff.buff == NULL) {
+        return gsmERR;
+    }
+    *addr = GSMI_BUFF_FN(gsm_buff_get_linear_block_write_address)(&gsm.buff);
+    *len = GSMI_BUFF_FN(gsm_buff_get_linear_block_write_length)(&gsm.buff);
+    return gsmOK;
+}
+
+/**
+ * \brief           Notify stack about data written directly to memory from \ref gsm_input_get_write_block
+ * \note            \ref GSM_CFG_INPUT_USE_PROCESS must be disabled to use this function
+ * \note            Function may be called from interrupt context, such as DMA transfer complete
+ * \param[in]       len: Number of bytes written to input buffer memory
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_input_advance(size_t len) {
+    if (gsm.buff.buff == NULL) {
+        return gsmERR;
+    }
+#if GSM_CFG_AT_CAPTURE
+    gsmi_capture(GSM_CAPTURE_DIR_RX, GSMI_BUFF_FN(gsm_buff_get_linear_block_write_address)(&gsm.buff), len);
+#endif /* GSM_CFG_AT_CAPTURE */
+    input_notify(GSMI_BUFF_FN(gsm_buff_advance)(&gsm.buff, len));
+    gsm.recv_total_len += len;                  /* Update total number of received bytes */
+    gsm.recv_calls++;                           /* Update number of calls */
     return gsmOK;
 }
 
@@ -76,8 +150,12 @@ gsm_input(const void* data, size_t len) {
 gsmr_t
 gsm_input_process(const void* data, size_t len) {
     gsmr_t res;
-    gsm_recv_total_len += len;                  /* Update total number of received bytes */
-    gsm_recv_calls++;                           /* Update number of calls */
+
+#if GSM_CFG_AT_CAPTURE
+    gsmi_capture(GSM_CAPTURE_DIR_RX, data, len);
+#endif /* GSM_CFG_AT_CAPTURE */
+    gsm.recv_total_len += len;                  /* Update total number of received bytes */
+    gsm.recv_calls++;                           /* Update number of calls */
     
     if (!gsm.status.f.initialized) {
         return gsmERR;
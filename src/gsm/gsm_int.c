@@ -34,12 +34,12 @@
 #include "gsm/gsm.h"
 #include "gsm/gsm_int.h"
 #include "gsm/gsm_mem.h"
+#include "gsm/gsm_timeout.h"
 #include "gsm/gsm_parser.h"
 #include "gsm/gsm_unicode.h"
+#include "gsm/gsm_sms_pdu.h"
 #include "system/gsm_ll.h"
 
-static gsm_recv_t recv_buff;
-
 static gsmr_t gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error);
 
 /**
@@ -57,6 +57,11 @@ gsm_dev_mem_map[] = {
 size_t
 gsm_dev_mem_map_size = GSM_ARRAYSIZE(gsm_dev_mem_map);
 
+#if GSM_CFG_THREAD_SEM_CACHE
+static GSM_CFG_THREAD_LOCAL gsm_sys_sem_t sem_cache;    /* Synchronization semaphore of current thread for blocking calls */
+static GSM_CFG_THREAD_LOCAL uint8_t sem_cache_valid;    /* Set to `1` when `sem_cache` is created */
+#endif /* GSM_CFG_THREAD_SEM_CACHE */
+
 /**
  * \brief           Free connection send data memory
  * \param[in]       m: Send data message type
@@ -71,6 +76,12 @@ gsm_dev_mem_map_size = GSM_ARRAYSIZE(gsm_dev_mem_map);
             (m)->msg.conn_send.data = NULL;         \
         }                                           \
     }                                               \
+    if ((m) != NULL && (m)->msg.conn_send.pbuf != NULL) {   \
+        GSM_DEBUGF(GSM_CFG_DBG_CONN | GSM_DBG_TYPE_TRACE,   \
+            "[CONN] Free write pbuf: %p\r\n", (void *)(m)->msg.conn_send.pbuf);    \
+        gsm_pbuf_free((m)->msg.conn_send.pbuf);     \
+        (m)->msg.conn_send.pbuf = NULL;             \
+    }                                               \
 } while (0)
 
 /**
@@ -105,34 +116,163 @@ gsmi_get_sim_info(uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_WARM_START || __DOXYGEN__
+
+/**
+ * \brief           Mark warm start step as finished
+ *
+ * Deferred SIM info query is started once all steps are finished
+ *
+ * \note            Core must be protected when calling this function
+ * \param[in]       step: Finished step, `GSM_WARM_HOLD_SEQ` or `GSM_WARM_HOLD_INIT`
+ */
+void
+gsmi_warm_release(uint8_t step) {
+    gsm.warm.hold &= GSM_U8(~step);
+    if (!gsm.warm.hold && gsm.warm.sim_info) {
+        gsm.warm.sim_info = 0;
+        gsmi_get_sim_info(0);
+    }
+}
+
+#endif /* GSM_CFG_WARM_START || __DOXYGEN__ */
+
+/**
+ * \brief           Mark cached value as updated now
+ * \param[in]       age: Age descriptor of cached value
+ */
+void
+gsmi_value_age_update(gsm_value_age_t* age) {
+    age->time = gsm_sys_now();
+    age->valid = 1;
+}
+
+/**
+ * \brief           Check if cached value is fresh enough
+ * \note            Function must be called with core protected
+ * \param[in]       age: Age descriptor of cached value
+ * \param[in]       max_age: Maximal allowed age in units of milliseconds
+ * \return          `1` if value is valid and not older than `max_age`, `0` otherwise
+ */
+uint8_t
+gsmi_value_age_is_fresh(const gsm_value_age_t* age, uint32_t max_age) {
+    return age->valid && (uint32_t)(gsm_sys_now() - age->time) <= max_age;
+}
+
+/**
+ * \brief           Send data to low-level driver
+ *
+ * When flow control is enabled, function waits for device to accept data first
+ *
+ * \param[in]       data: Data to send
+ * \param[in]       len: Length of data in units of bytes
+ * \return          Number of bytes sent
+ */
+size_t
+gsmi_ll_send(const void* data, size_t len) {
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+    if (gsm.ll.tx_ready_fn != NULL) {
+        uint32_t time;
+        for (time = 0; !gsm.ll.tx_ready_fn() && time < GSM_CFG_AT_PORT_TX_READY_TIMEOUT; ++time) {
+            gsm_delay(1);                       /* Device buffer is full, give it some time */
+        }
+    }
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+#if GSM_CFG_AT_CAPTURE
+#if GSM_CFG_CMUX
+    if (!gsm.cmux.active)                       /* Multiplexer captures its frames */
+#endif /* GSM_CFG_CMUX */
+    {
+        gsmi_capture(GSM_CAPTURE_DIR_TX, data, len);
+    }
+#endif /* GSM_CFG_AT_CAPTURE */
+    return gsm.ll.send_fn(data, len);
+}
+
+/**
+ * \brief           Add data to command line buffer
+ *
+ * Data are sent to low-level driver when buffer is full or when \ref gsmi_at_tx_flush is called.
+ * Data longer than buffer itself are sent directly.
+ *
+ * \param[in]       data: Data to add
+ * \param[in]       len: Length of data in units of bytes
+ */
+void
+gsmi_at_tx_add(const void* data, size_t len) {
+    if (gsm.at_tx_len + len > sizeof(gsm.at_tx_buff)) {
+        gsmi_at_tx_flush();                     /* Not enough space, send what we have */
+    }
+    if (len >= sizeof(gsm.at_tx_buff)) {
+        gsmi_ll_send(data, len);                /* Too long for buffer, send directly */
+    } else {
+        GSM_MEMCPY(&gsm.at_tx_buff[gsm.at_tx_len], data, len);
+        gsm.at_tx_len += len;
+    }
+}
+
+/**
+ * \brief           Send all data in command line buffer to low-level driver
+ */
+void
+gsmi_at_tx_flush(void) {
+    if (gsm.at_tx_len > 0) {
+        gsmi_ll_send(gsm.at_tx_buff, gsm.at_tx_len); /* Single call to driver per command line */
+        gsm.at_tx_len = 0;
+    }
+}
+
 /**
  * \brief           Create 2-characters long hex from byte
  * \param[in]       num: Number to convert to string
  * \param[out]      str: Pointer to string to save result to
+ * \return          Length of string, excluding `NULL` termination
  */
-void
+size_t
 byte_to_str(uint8_t num, char* str) {
-    sprintf(str, "%02X", (unsigned)num);        /* Currently use sprintf only */
+    static const char hex[] = "0123456789ABCDEF";
+
+    str[0] = hex[(num >> 4) & 0x0F];
+    str[1] = hex[num & 0x0F];
+    str[2] = 0;
+    return 2;
 }
 
 /**
  * \brief           Create string from number
  * \param[in]       num: Number to convert to string
  * \param[out]      str: Pointer to string to save result to
+ * \return          Length of string, excluding `NULL` termination
  */
-void
+size_t
 number_to_str(uint32_t num, char* str) {
-    sprintf(str, "%u", (unsigned)num);          /* Currently use sprintf only */
+    char tmp[10];
+    size_t len = 0, i = 0;
+
+    do {                                        /* Generate digits in reverse order */
+        tmp[len++] = (char)('0' + (num % 10));
+        num /= 10;
+    } while (num > 0);
+    while (len > 0) {
+        str[i++] = tmp[--len];
+    }
+    str[i] = 0;
+    return i;
 }
 
 /**
  * \brief           Create string from signed number
  * \param[in]       num: Number to convert to string
  * \param[out]      str: Pointer to string to save result to
+ * \return          Length of string, excluding `NULL` termination
  */
-void
+size_t
 signed_number_to_str(int32_t num, char* str) {
-    sprintf(str, "%d", (signed)num);            /* Currently use sprintf only */
+    if (num < 0) {
+        *str = '-';
+        return 1 + number_to_str((uint32_t)0 - (uint32_t)num, str + 1);
+    }
+    return number_to_str((uint32_t)num, str);
 }
 
 /**
@@ -146,6 +286,7 @@ void
 send_ip_mac(const void* d, uint8_t is_ip, uint8_t q, uint8_t c) {
     uint8_t ch;
     char str[4];
+    size_t len;
     const gsm_mac_t* mac = d;
     const gsm_ip_t* ip = d;
 
@@ -157,11 +298,11 @@ send_ip_mac(const void* d, uint8_t is_ip, uint8_t q, uint8_t c) {
     ch = is_ip ? '.' : ':';                     /* Get delimiter character */
     for (uint8_t i = 0; i < (is_ip ? 4 : 6); i++) { /* Process byte by byte */
         if (is_ip) {                            /* In case of IP ... */
-            number_to_str(ip->ip[i], str);      /* ... go to decimal format ... */
+            len = number_to_str(ip->ip[i], str);/* ... go to decimal format ... */
         } else {                                /* ... in case of MAC ... */
-            byte_to_str(mac->mac[i], str);      /* ... go to HEX format */
+            len = byte_to_str(mac->mac[i], str);/* ... go to HEX format */
         }
-        GSM_AT_PORT_SEND_STR(str);              /* Send str */
+        gsmi_at_tx_add(str, len);               /* Send str */
         if (i < (is_ip ? 4 : 6) - 1) {          /* Check end if characters */
             GSM_AT_PORT_SEND_CHR(&ch);          /* Send character */
         }
@@ -207,12 +348,13 @@ send_string(const char* str, uint8_t e, uint8_t q, uint8_t c) {
 void
 send_number(uint32_t num, uint8_t q, uint8_t c) {
     char str[11];
+    size_t len;
 
-    number_to_str(num, str);                    /* Convert digit to decimal string */
+    len = number_to_str(num, str);              /* Convert digit to decimal string */
     
     GSM_AT_PORT_SEND_COMMA_COND(c);             /* Send comma */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
-    GSM_AT_PORT_SEND_STR(str);                  /* Send string with number */
+    gsmi_at_tx_add(str, len);                   /* Send string with number */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
 }
 
@@ -224,16 +366,40 @@ send_number(uint32_t num, uint8_t q, uint8_t c) {
  */
 void
 send_port(gsm_port_t port, uint8_t q, uint8_t c) {
-    char str[6];
+    char str[11];
+    size_t len;
 
-    number_to_str(GSM_PORT2NUM(port), str);     /* Convert digit to decimal string */
+    len = number_to_str(GSM_PORT2NUM(port), str);   /* Convert digit to decimal string */
     
     GSM_AT_PORT_SEND_COMMA_COND(c);             /* Send comma */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
-    GSM_AT_PORT_SEND_STR(str);                  /* Send string with number */
+    gsmi_at_tx_add(str, len);                   /* Send string with number */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
 }
 
+#if GSM_CFG_SLEEP || __DOXYGEN__
+/**
+ * \brief           Send number as binary string to AT port, most significant bit first
+ * \param[in]       num: Number to send to AT port
+ * \param[in]       bits: Number of bits to send
+ * \param[in]       q: Value to indicate starting and ending quotes, enabled (`1`) or disabled (`0`)
+ * \param[in]       c: Set to `1` to include comma before string
+ */
+static void
+send_bits(uint32_t num, uint8_t bits, uint8_t q, uint8_t c) {
+    char str[32];
+
+    for (uint8_t i = 0; i < bits; i++) {
+        str[i] = (num & (1UL << (bits - 1 - i))) ? '1' : '0';
+    }
+
+    GSM_AT_PORT_SEND_COMMA_COND(c);             /* Send comma */
+    GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
+    gsmi_at_tx_add(str, bits);                  /* Send string with bits */
+    GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
+}
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
+
 /**
  * \brief           Send signed number to AT port
  * \param[in]       num: Number to send to AT port
@@ -242,13 +408,14 @@ send_port(gsm_port_t port, uint8_t q, uint8_t c) {
  */
 void
 send_signed_number(int32_t num, uint8_t q, uint8_t c) {
-    char str[11];
+    char str[12];
+    size_t len;
     
-    signed_number_to_str(num, str);             /* Convert digit to decimal string */
+    len = signed_number_to_str(num, str);       /* Convert digit to decimal string */
     
     GSM_AT_PORT_SEND_COMMA_COND(c);             /* Send comma */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
-    GSM_AT_PORT_SEND_STR(str);                  /* Send string with number */
+    gsmi_at_tx_add(str, len);                   /* Send string with number */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
 }
 
@@ -287,6 +454,102 @@ send_sms_stat(gsm_sms_status_t status, uint8_t q, uint8_t c) {
     send_string(t, 0, q, c);
 }
 
+/**
+ * \brief           Pass parsed SMS list entry to user callback and prepare entry for next one
+ * \param[in]       e: Entry to pass to user
+ */
+static void
+gsmi_sms_list_entry(gsm_sms_entry_t* e) {
+    uint8_t act;
+
+    act = gsm.msg->msg.sms_list.fn(e, gsm.msg->msg.sms_list.arg);
+    if ((act & GSM_SMS_LIST_DELETE) && e->pos <= GSM_CFG_SMS_LIST_DELETE_MAX_POS) {
+        gsm.msg->msg.sms_list.del[e->pos >> 3] |= GSM_U8(1 << (e->pos & 0x07));
+    }
+    if (act & GSM_SMS_LIST_STOP) {
+        gsm.msg->msg.sms_list.stop = 1;         /* Ignore remaining entries */
+    }
+    GSM_MEMSET(e, 0x00, sizeof(*e));
+}
+
+/**
+ * \brief           Get next position marked for delete by SMS list callback
+ * \note            Position is unmarked and written to message
+ * \return          `1` if position is available, `0` otherwise
+ */
+static uint8_t
+gsmi_sms_list_next_delete(void) {
+    size_t pos;
+
+    if (gsm.msg->msg.sms_list.fn == NULL) {
+        return 0;
+    }
+    for (pos = 0; pos <= GSM_CFG_SMS_LIST_DELETE_MAX_POS; pos++) {
+        if (gsm.msg->msg.sms_list.del[pos >> 3] & (1 << (pos & 0x07))) {
+            gsm.msg->msg.sms_list.del[pos >> 3] &= GSM_U8(~(1 << (pos & 0x07)));
+            gsm.msg->msg.sms_list.del_pos = pos;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Save memory selected with successful `+CPMS` set command as current
+ * \note            Operations on active memory skip memory select command
+ * \param[in]       msg: Message with memory set
+ */
+static void
+gsmi_sms_mem_selected(gsm_msg_t* msg) {
+    gsm_mem_t mem = GSM_MEM_CURRENT;
+
+    if (CMD_IS_DEF(GSM_CMD_CMGR)) {
+        mem = msg->msg.sms_read.mem;
+    } else if (CMD_IS_DEF(GSM_CMD_CMGD)) {
+        mem = msg->msg.sms_delete.mem;
+    } else if (CMD_IS_DEF(GSM_CMD_CMGL)) {
+        mem = msg->msg.sms_list.mem;
+    } else if (CMD_IS_DEF(GSM_CMD_CPMS_SET)) {
+        for (size_t i = 1; i < 3; i++) {
+            if (msg->msg.sms_memory.mem[i] != GSM_MEM_CURRENT) {
+                gsm.sms.mem[i].current = msg->msg.sms_memory.mem[i];
+            }
+        }
+        mem = msg->msg.sms_memory.mem[0];
+    }
+    if (mem != GSM_MEM_CURRENT) {
+        gsm.sms.mem[0].current = mem;
+    }
+}
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Move batch SMS send to next part or recipient
+ * \param[in]       msg: Batch send message
+ * \param[in]       is_ok: Status of last `+CMGS` command
+ * \return          `1` if another `+CMGS` command is needed, `0` when batch is finished
+ */
+static uint8_t
+gsmi_sms_batch_next(gsm_msg_t* msg, uint8_t is_ok) {
+    if (is_ok && ++msg->msg.sms_send.part < msg->msg.sms_send.parts) {
+        msg->msg.sms_send.part_start = msg->msg.sms_send.part_end;  /* Continue with next part */
+        return 1;
+    }
+    msg->msg.sms_send.rcpts[msg->msg.sms_send.ri].res = is_ok ? gsmOK : gsmERR;
+    if (is_ok) {
+        msg->msg.sms_send.sent++;
+    }
+    if (++msg->msg.sms_send.ri < msg->msg.sms_send.rcpts_len) {
+        msg->msg.sms_send.part = 0;             /* Start from beginning for next recipient */
+        msg->msg.sms_send.part_start = 0;
+        return 1;
+    }
+    return 0;
+}
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
 #endif /* GSM_CFG_SMS */
 
 /**
@@ -311,6 +574,107 @@ reset_connections(uint8_t forced) {
     //}
 }
 
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Try to write current event to deferred event queue
+ * \param[in]       conn: Connection for connection event or `NULL` for global event
+ * \param[in]       fn: Connection callback function to call, used only with connection events
+ * \return          `1` if event was queued, `0` if it must be called directly
+ */
+static uint8_t
+gsmi_evt_defer(gsm_conn_p conn, gsm_evt_fn fn) {
+    gsm_evt_deferred_t* e;
+
+    if (!(gsm.evt_deferred_mask & GSM_EVT_MASK(gsm.evt.type))) {
+        return 0;
+    }
+    if ((e = gsm_mem_alloc_tag(GSM_MEM_TAG_CORE, sizeof(*e))) == NULL) {
+        return 0;                               /* No memory, fallback to direct call */
+    }
+    e->evt = gsm.evt;                           /* Copy event data */
+    e->fn = fn;
+    e->conn = conn;
+    e->val_id = conn != NULL ? conn->val_id : 0;
+#if GSM_CFG_CONN
+    if (gsm.evt.type == GSM_EVT_CONN_DATA_RECV) {
+#if GSM_CFG_IPD_ZERO_COPY
+        if (gsmi_pbuf_copy_payload(e->evt.evt.conn_data_recv.buff) != gsmOK) {  /* Event thread must not read receive buffer */
+            gsm_mem_free(e);
+            return 0;                           /* No memory for copy, fallback to direct call */
+        }
+#endif /* GSM_CFG_IPD_ZERO_COPY */
+        gsm_pbuf_ref(e->evt.evt.conn_data_recv.buff);   /* Keep packet buffer until event is dispatched */
+    }
+#endif /* GSM_CFG_CONN */
+    if (!gsm_sys_mbox_putnow(&gsm.mbox_evt, e)) {
+#if GSM_CFG_CONN
+        if (gsm.evt.type == GSM_EVT_CONN_DATA_RECV) {
+            gsm_pbuf_free(e->evt.evt.conn_data_recv.buff);
+        }
+#endif /* GSM_CFG_CONN */
+        gsm_mem_free(e);
+        return 0;                               /* Queue is full, fallback to direct call */
+    }
+    return 1;
+}
+
+/**
+ * \brief           Call user callbacks for deferred event and release it
+ * \note            Function is called from deferred event thread, core must not be protected.
+ *                  Callbacks are called without core protection
+ * \param[in]       e: Deferred event to dispatch
+ */
+void
+gsmi_evt_deferred_dispatch(gsm_evt_deferred_t* e) {
+    gsm_evt_func_t* link;
+    gsm_evt_fn fn;
+
+    GSM_CORE_PROTECT();
+    if (e->conn != NULL) {
+#if GSM_CFG_CONN
+        /* Skip event if connection was reused for new connection in the meantime */
+        if (e->conn->val_id == e->val_id && e->fn != NULL) {
+            GSM_CORE_UNPROTECT();
+            e->fn(&e->evt);
+            GSM_CORE_PROTECT();
+        }
+#endif /* GSM_CFG_CONN */
+    } else {
+        /*
+         * Call all registered functions.
+         * Lock is released during each call, find next function
+         * by its pointer as list may be modified by callback
+         */
+        GSM_EVT_PROTECT();
+        for (link = gsm.evt_func; link != NULL; ) {
+            fn = link->fn;
+            if (link->mask & GSM_EVT_MASK(e->evt.type)) {
+                GSM_EVT_UNPROTECT();
+                GSM_CORE_UNPROTECT();
+                fn(&e->evt);
+                GSM_CORE_PROTECT();
+                GSM_EVT_PROTECT();
+            }
+            for (link = gsm.evt_func; link != NULL && link->fn != fn; link = link->next) {}
+            if (link != NULL) {
+                link = link->next;
+            }
+        }
+        GSM_EVT_UNPROTECT();
+    }
+#if GSM_CFG_CONN
+    if (e->evt.type == GSM_EVT_CONN_DATA_RECV) {
+        gsm_pbuf_free(e->evt.evt.conn_data_recv.buff);  /* Release our reference */
+        GSMI_PROCESS_WAKEUP();                  /* Wakeup process thread, receive buffer may be released */
+    }
+#endif /* GSM_CFG_CONN */
+    GSM_CORE_UNPROTECT();
+    gsm_mem_free(e);
+}
+
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
+
 /**
  * \brief           Process callback function to user with specific type
  * \param[in]       type: Callback event type
@@ -319,11 +683,24 @@ reset_connections(uint8_t forced) {
 gsmr_t
 gsmi_send_cb(gsm_evt_type_t type) {
     gsm.evt.type = type;                         /* Set callback type to process */
-    
-    /* Call callback function for all registered functions */
+
+    if (!(gsm.evt_func_mask & GSM_EVT_MASK(type))) {
+        return gsmOK;                           /* Nobody is subscribed to this event */
+    }
+#if GSM_CFG_EVT_DEFERRED
+    if (gsmi_evt_defer(NULL, NULL)) {           /* Dispatch from event thread if enabled for type */
+        return gsmOK;
+    }
+#endif /* GSM_CFG_EVT_DEFERRED */
+
+    /* Call callback function for all registered functions subscribed to event */
+    GSM_EVT_PROTECT();                          /* List may be modified by application threads */
     for (gsm_evt_func_t* link = gsm.evt_func; link != NULL; link = link->next) {
-        link->fn(&gsm.evt);
+        if (link->mask & GSM_EVT_MASK(type)) {
+            link->fn(&gsm.evt);
+        }
     }
+    GSM_EVT_UNPROTECT();
     return gsmOK;
 }
 
@@ -342,6 +719,13 @@ gsmi_send_conn_cb(gsm_conn_t* conn, gsm_evt_fn evt) {
         /* return gsmOK; */
     }
 
+#if GSM_CFG_EVT_DEFERRED
+    if (conn != NULL && (evt != NULL || conn->evt_func != NULL)
+        && gsmi_evt_defer(conn, evt != NULL ? evt : conn->evt_func)) {
+        return gsmOK;                           /* Dispatch from event thread if enabled for type */
+    }
+#endif /* GSM_CFG_EVT_DEFERRED */
+
     if (evt != NULL) {                          /* Try with user connection */
         return evt(&gsm.evt);                   /* Call temporary function */
     } else if (conn != NULL && conn->evt_func != NULL) {/* Connection custom callback? */
@@ -386,7 +770,7 @@ gsmi_tcpip_process_send_data(void) {
     gsm.msg->msg.conn_send.sent = GSM_MIN(gsm.msg->msg.conn_send.btw, GSM_CFG_CONN_MAX_DATA_LEN);
 
     GSM_AT_PORT_SEND_BEGIN();
-    GSM_AT_PORT_SEND_STR("+CIPSEND=");
+    GSM_AT_PORT_SEND_CONST_STR("+CIPSEND=");
     send_number(GSM_U32(c->num), 0, 0);         /* Send connection number */
     send_number(GSM_U32(gsm.msg->msg.conn_send.sent), 0, 1);/* Send length number */
     
@@ -401,6 +785,143 @@ gsmi_tcpip_process_send_data(void) {
     return gsmOK;
 }
 
+/**
+ * \brief           Send current packet data to AT port after "> " was received
+ */
+static void
+gsmi_tcpip_send_packet_data(void) {
+    if (gsm.msg->msg.conn_send.pbuf != NULL) {  /* Send directly from packet buffer memory */
+        size_t off = gsm.msg->msg.conn_send.ptr, rem = gsm.msg->msg.conn_send.sent, len;
+        const void* d;
+
+        while (rem && (d = gsm_pbuf_get_linear_addr(gsm.msg->msg.conn_send.pbuf, off, &len)) != NULL && len) {
+            len = GSM_MIN(len, rem);
+            GSM_AT_PORT_SEND(d, len);           /* Send linear part of packet buffer chain */
+            off += len;
+            rem -= len;
+        }
+    } else if (gsm.msg->msg.conn_send.iov != NULL) {    /* Stream directly from application data vectors */
+        const gsm_iovec_t* iov = gsm.msg->msg.conn_send.iov;
+        size_t i, off = gsm.msg->msg.conn_send.ptr, rem = gsm.msg->msg.conn_send.sent, len;
+
+        for (i = 0; rem && i < gsm.msg->msg.conn_send.iovcnt; i++) {
+            if (off >= iov[i].len) {            /* Skip already sent vectors */
+                off -= iov[i].len;
+                continue;
+            }
+            len = GSM_MIN(iov[i].len - off, rem);
+            GSM_AT_PORT_SEND((const uint8_t *)iov[i].data + off, len);
+            off = 0;
+            rem -= len;
+        }
+    } else {
+        GSM_AT_PORT_SEND(&gsm.msg->msg.conn_send.data[gsm.msg->msg.conn_send.ptr], gsm.msg->msg.conn_send.sent);
+    }
+}
+
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+
+/**
+ * \brief           Send data of current message in transparent data mode
+ *
+ * Data are written directly to AT port as there is no prompt nor
+ * send confirmation in data mode. Command finishes immediately
+ *
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+gsmi_transp_send_data(void) {
+    gsm_conn_p c = gsm.msg->msg.conn_send.conn;
+
+    if (!gsm.transp.data_mode || !gsm_conn_is_active(c) || c->val_id != gsm.msg->msg.conn_send.val_id) {
+        CONN_SEND_DATA_SEND_EVT(gsm.msg, c, gsm.msg->msg.conn_send.sent_all, gsmCLOSED);
+        return gsmERR;
+    }
+    gsm.msg->msg.conn_send.sent = gsm.msg->msg.conn_send.btw;  /* There is no packet limit in data mode */
+    gsmi_tcpip_send_packet_data();              /* Write all data to port */
+
+    gsm.msg->msg.conn_send.sent_all += gsm.msg->msg.conn_send.sent;
+    gsm.msg->msg.conn_send.ptr += gsm.msg->msg.conn_send.sent;
+    gsm.msg->msg.conn_send.btw = 0;
+    c->stats.tx_bytes += gsm.msg->msg.conn_send.sent;   /* No chunks nor confirmations in data mode */
+    if (gsm.msg->msg.conn_send.bw) {
+        *gsm.msg->msg.conn_send.bw += gsm.msg->msg.conn_send.sent;
+    }
+    CONN_SEND_DATA_SEND_EVT(gsm.msg, c, gsm.msg->msg.conn_send.sent_all, gsmOK);
+
+    gsm.msg->res = gsmOK;
+    gsm_sys_sem_release(&gsm.sem_sync);         /* Command is finished, no response is expected */
+    return gsmOK;
+}
+
+#if GSM_CFG_CMUX || __DOXYGEN__
+
+/**
+ * \brief           Check if current command is executed by transparent connection
+ * \return          `1` if command is sent on connection channel, `0` otherwise
+ */
+static uint8_t
+gsmi_transp_is_conn_cmd(void) {
+    return gsm.transp.active && (CMD_IS_CUR(GSM_CMD_CIPSTART) || CMD_IS_CUR(GSM_CMD_CIPSEND)
+        || CMD_IS_CUR(GSM_CMD_CIPCLOSE) || CMD_IS_CUR(GSM_CMD_TRANSP_ESCAPE) || CMD_IS_CUR(GSM_CMD_ATO));
+}
+
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
+
+/**
+ * \brief           Send data received in transparent data mode to connection
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data in units of bytes
+ */
+static void
+gsmi_transp_recv(const void* data, size_t len) {
+    gsm_conn_p c = &gsm.conns[0];
+    gsm_pbuf_p pbuf;
+
+    if (!len || !c->status.f.active || c->status.f.in_closing) {
+        return;
+    }
+    if ((pbuf = gsm_pbuf_new(len)) == NULL) {
+        GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+            "[TRANSP] Buffer allocation failed for %d byte(s)\r\n", (int)len);
+        c->stats.rx_alloc_fail++;
+        c->stats.rx_dropped += len;
+        return;
+    }
+    gsm_pbuf_take(pbuf, data, len, 0);          /* Copy data to packet buffer */
+    c->total_recved += len;
+    c->stats.rx_pbufs++;
+    c->status.f.data_received = 1;
+
+    gsm.evt.type = GSM_EVT_CONN_DATA_RECV;      /* We have received data */
+    gsm.evt.evt.conn_data_recv.buff = pbuf;
+    gsm.evt.evt.conn_data_recv.conn = c;
+    gsmi_send_conn_cb(c, NULL);                 /* Send connection callback */
+    gsm_pbuf_free(pbuf);                        /* Free our reference */
+}
+
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
+
+/**
+ * \brief           Load next datagram of batched send to current message
+ * \return          `1` if next datagram is ready to send, `0` if all datagrams were processed
+ */
+static uint8_t
+gsmi_tcpip_next_dgram(void) {
+    const gsm_dgram_t* d;
+
+    if (++gsm.msg->msg.conn_send.dgram >= gsm.msg->msg.conn_send.dgramcnt) {
+        return 0;
+    }
+    d = &gsm.msg->msg.conn_send.dgrams[gsm.msg->msg.conn_send.dgram];
+    gsm.msg->msg.conn_send.data = d->data;
+    gsm.msg->msg.conn_send.btw = d->len;
+    gsm.msg->msg.conn_send.ptr = 0;
+    gsm.msg->msg.conn_send.remote_ip = d->ip;
+    gsm.msg->msg.conn_send.remote_port = d->port;
+    return 1;
+}
+
 /**
  * \brief           Process data sent and send remaining
  * \param[in]       sent: Status whether data were sent or not,
@@ -409,7 +930,20 @@ gsmi_tcpip_process_send_data(void) {
  */
 static uint8_t
 gsmi_tcpip_process_data_sent(uint8_t sent) {
+    gsm_conn_t* c = gsm.msg->msg.conn_send.conn;
+    gsm_conn_stats_t* stats = c->val_id == gsm.msg->msg.conn_send.val_id ? &c->stats : NULL;
+
     if (sent) {                                 /* Data were successfully sent */
+        if (stats != NULL) {
+            uint32_t time = gsm_sys_now() - gsm.msg->msg.conn_send.send_time;
+
+            stats->tx_bytes += gsm.msg->msg.conn_send.sent;
+            stats->tx_chunks++;
+            stats->ack_time_total += time;
+            if (time > stats->ack_time_max) {
+                stats->ack_time_max = time;
+            }
+        }
         gsm.msg->msg.conn_send.sent_all += gsm.msg->msg.conn_send.sent;
         gsm.msg->msg.conn_send.btw -= gsm.msg->msg.conn_send.sent;
         gsm.msg->msg.conn_send.ptr += gsm.msg->msg.conn_send.sent;
@@ -417,11 +951,25 @@ gsmi_tcpip_process_data_sent(uint8_t sent) {
             *gsm.msg->msg.conn_send.bw += gsm.msg->msg.conn_send.sent;
         }
         gsm.msg->msg.conn_send.tries = 0;
+
+        /* Datagram is complete, continue with next one in the same command */
+        if (!gsm.msg->msg.conn_send.btw && gsm.msg->msg.conn_send.dgrams != NULL) {
+            if (gsm.msg->msg.conn_send.dgram_sent != NULL) {
+                ++*gsm.msg->msg.conn_send.dgram_sent;
+            }
+            gsmi_tcpip_next_dgram();
+        }
     } else {                                    /* We were not successful */
         gsm.msg->msg.conn_send.tries++;         /* Increase number of tries */
         if (gsm.msg->msg.conn_send.tries == GSM_CFG_MAX_SEND_RETRIES) { /* In case we reached max number of retransmissions */
+            if (stats != NULL) {
+                stats->tx_failed++;
+            }
             return 1;                           /* Return 1 and indicate error */
         }
+        if (stats != NULL) {
+            stats->tx_retries++;                /* Same chunk is sent again */
+        }
     }
     if (gsm.msg->msg.conn_send.btw) {           /* Do we still have data to send? */
         if (gsmi_tcpip_process_send_data() != gsmOK) {  /* Check if we can continue */
@@ -462,6 +1010,28 @@ gsmi_process_cipsend_response(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_erro
                         gsmERR);
                 }
             }
+#if GSM_CFG_CONN_QUICK_SEND
+        } else if (!strncmp(rcv->data, "DATA ACCEPT:", 12)) {
+            const char* str = &rcv->data[12];
+            uint8_t num;
+            size_t len;
+
+            num = GSM_U8(gsmi_parse_number(&str));  /* Get connection number */
+            len = GSM_SZ(gsmi_parse_number(&str));  /* Get number of bytes accepted by device */
+            if (num == gsm.msg->msg.conn_send.conn->num) {
+                gsm.msg->msg.conn_send.wait_send_ok_err = 0;
+                if (len < gsm.msg->msg.conn_send.sent) {    /* Device accepted only part of data? */
+                    gsm.msg->msg.conn_send.sent = len;  /* Send remaining part with next packet */
+                }
+                *is_ok = gsmi_tcpip_process_data_sent(1);   /* Process as data were sent and send next packet */
+                if (*is_ok && gsm.msg->msg.conn_send.conn->status.f.active) {
+                    CONN_SEND_DATA_SEND_EVT(gsm.msg,
+                        gsm.msg->msg.conn_send.conn,
+                        gsm.msg->msg.conn_send.sent_all,
+                        gsmOK);
+                }
+            }
+#endif /* GSM_CFG_CONN_QUICK_SEND */
         }
     /* Check for an error or if connection closed in the meantime */
     } else if (*is_error) {
@@ -506,24 +1076,161 @@ gsmi_is_valid_conn_ptr(gsm_conn_p conn) {
 }
 
 /**
- * \brief           Connection close event detected, process with callback to user
+ * \brief           Reset connection structure and mark it active
  * \param[in]       conn_num: Connection number
- * \param[in]       forced: Set to `1` if close forced by command, `0` otherwise
- * \return          `1` on success, `0` otherwise
+ * \return          Connection handle
  */
-uint8_t
-gsmi_conn_closed_process(uint8_t conn_num, uint8_t forced) {
-    gsm_conn_t* conn = &gsm.conns[conn_num];
+static gsm_conn_t*
+gsmi_conn_reset_activate(uint8_t conn_num) {
+    gsm_conn_t* conn = &gsm.conns[conn_num];    /* Get connection handle */
 
-    conn->status.f.active = 0;
+    /*
+     * Reset connection parameters field by field.
+     * TX lock lives for the whole stack lifetime and may be held by other threads,
+     * resume host may still be used by resume command
+     */
+    GSM_CONN_TX_PROTECT(conn);                  /* API threads read status and validation ID under this lock */
+    conn->type = GSM_CONN_TYPE_TCP;
+    conn->num = conn_num;
+    GSM_MEMSET(&conn->remote_ip, 0x00, sizeof(conn->remote_ip));
+    conn->remote_port = 0;
+    conn->local_port = 0;
+    conn->evt_func = NULL;
+    conn->arg = NULL;
+    conn->val_id++;                             /* Set new validation ID */
+    GSM_MEMSET(&conn->buff, 0x00, sizeof(conn->buff));
+#if GSM_CFG_NETWORK_REATTACH
+    conn->resume.en = 0;
+    conn->resume.pending = 0;
+#endif /* GSM_CFG_NETWORK_REATTACH */
+    conn->total_recved = 0;
+    GSM_MEMSET(&conn->stats, 0x00, sizeof(conn->stats));
+    conn->poll_interval = 0;
+    conn->poll_next = 0;
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    conn->tcp_not_ack_bytes = 0;
+    conn->tcp_not_ack_pkts = 0;
+    conn->tcp_rx_window = GSM_CFG_CONN_MANUAL_TCP_RECEIVE_WINDOW;
+    conn->tcp_rx_window_pkts = 0;
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+    GSM_MEMSET(&conn->status, 0x00, sizeof(conn->status));
+    conn->status.f.active = 1;
+    GSM_CONN_TX_UNPROTECT(conn);
+    return conn;
+}
 
-    /* Check if write buffer is set */
+/**
+ * \brief           Get remote IP address of connection from start message
+ * \param[in]       msg: Connection start message
+ * \param[out]      ip: Output variable for IP address
+ * \return          `1` if address is known without status query, `0` otherwise
+ */
+static uint8_t
+gsmi_conn_start_get_ip(gsm_msg_t* msg, gsm_ip_t* ip) {
+    const char* host = msg->msg.conn_start.host;
+    uint8_t dots = 0;
+
+#if GSM_CFG_DNS_CACHE
+    if (msg->msg.conn_start.ip_valid) {         /* Connection was started with resolved address */
+        GSM_MEMCPY(ip, &msg->msg.conn_start.ip, sizeof(*ip));
+        return 1;
+    }
+#endif /* GSM_CFG_DNS_CACHE */
+    for (const char* s = host; *s != '\0'; ++s) {
+        if (*s == '.') {
+            ++dots;
+        } else if (!GSM_CHARISNUM(*s)) {
+            return 0;                           /* Host name, only device knows the address */
+        }
+    }
+    if (dots != 3) {
+        return 0;
+    }
+    gsmi_parse_ip(&host, ip);
+    return 1;
+}
+
+/**
+ * \brief           Reset and activate connection after device reported it is connected
+ * \note            Current message must be connection start message
+ * \param[in]       conn_num: Connection number
+ */
+static void
+gsmi_conn_start_activate(uint8_t conn_num) {
+    gsm_conn_t* conn = gsmi_conn_reset_activate(conn_num);
+
+    /* Set connection parameters */
+    conn->status.f.client = 1;
+    conn->evt_func = gsm.msg->msg.conn_start.evt_func;
+    conn->arg = gsm.msg->msg.conn_start.arg;
+    conn->type = gsm.msg->msg.conn_start.type;
+    conn->remote_port = gsm.msg->msg.conn_start.port;
+    gsmi_conn_start_get_ip(gsm.msg, &conn->remote_ip);  /* Address of host name is set by status query */
+#if GSM_CFG_NETWORK_REATTACH
+    if (gsm.msg->msg.conn_start.resume == NULL) {   /* Keep parameters of new connection to reopen it later */
+        size_t len = strlen(gsm.msg->msg.conn_start.host);
+
+        if (len < sizeof(conn->resume.host)) {
+            GSM_MEMCPY(conn->resume.host, gsm.msg->msg.conn_start.host, len + 1);
+        } else {
+            conn->resume.host[0] = 0;           /* Connection cannot be resumed */
+        }
+        conn->resume.port = gsm.msg->msg.conn_start.port;
+        conn->resume.type = gsm.msg->msg.conn_start.type;
+    } else {
+        conn->resume.en = 1;                    /* Reopened connection stays marked for resume */
+    }
+#endif /* GSM_CFG_NETWORK_REATTACH */
+}
+
+/**
+ * \brief           Activate connection accepted by device server and notify application
+ * \param[in]       conn_num: Connection number
+ * \param[in]       str: Remote IP address string
+ */
+static void
+gsmi_conn_server_accept(uint8_t conn_num, const char* str) {
+    gsm_conn_t* conn = gsmi_conn_reset_activate(conn_num);
+
+    gsmi_parse_ip(&str, &conn->remote_ip);      /* Parse remote IP address */
+    conn->local_port = gsm.server_port;
+    conn->evt_func = gsm.evt_server;            /* Connection without callback is closed automatically */
+
+    gsm.evt.type = GSM_EVT_CONN_ACTIVE;         /* Connection just active */
+    gsm.evt.evt.conn_active_closed.client = 0;
+    gsm.evt.evt.conn_active_closed.conn = conn;
+    gsm.evt.evt.conn_active_closed.forced = 0;
+    gsmi_send_conn_cb(conn, NULL);
+}
+
+/**
+ * \brief           Connection close event detected, process with callback to user
+ * \param[in]       conn_num: Connection number
+ * \param[in]       forced: Set to `1` if close forced by command, `0` otherwise
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gsmi_conn_closed_process(uint8_t conn_num, uint8_t forced) {
+    gsm_conn_t* conn = &gsm.conns[conn_num];
+
+    GSM_CONN_TX_PROTECT(conn);                  /* Write buffer is owned by API threads */
+    conn->status.f.active = 0;
+
+    /* Check if write buffer is set */
     if (conn->buff.buff != NULL) {
         GSM_DEBUGF(GSM_CFG_DBG_CONN | GSM_DBG_TYPE_TRACE,
             "[CONN] Free write buffer: %p\r\n", conn->buff.buff);
         gsm_mem_free(conn->buff.buff);  /* Free the memory */
         conn->buff.buff = NULL;
     }
+    GSM_CONN_TX_UNPROTECT(conn);
+
+#if GSM_CFG_NETWORK_REATTACH
+    if (gsm.reattach.active && conn->resume.en) {
+        conn->resume.pending = 1;               /* Owner is notified once connection is reopened */
+        return 1;
+    }
+#endif /* GSM_CFG_NETWORK_REATTACH */
 
     /* Send event */
     gsm.evt.type = GSM_EVT_CONN_CLOSED;
@@ -535,104 +1242,518 @@ gsmi_conn_closed_process(uint8_t conn_num, uint8_t forced) {
     return 1;
 }
 
+/**
+ * \brief           Process close of all active connections,
+ *                  when device is known to have closed them without per-connection notification
+ */
+void
+gsmi_conn_closed_all(void) {
+    for (size_t i = 0; i < GSM_CFG_MAX_CONNS; i++) {
+        if (gsm.conns[i].status.f.active) {
+            gsmi_conn_closed_process(GSM_U8(i), 0);
+        }
+    }
+}
+
 #endif /* GSM_CFG_CONN || __DOXYGEN__ */
 
 /**
- * \brief           Process received string from GSM
- * \param[in]       recv: Pointer to \ref gsm_rect_t structure with input string
+ * \brief           Update PDP context state and notify application on change
+ * \param[in]       attached: Set to `1` when PDP context is active, `0` otherwise
+ */
+void
+gsmi_network_set_attached(uint8_t attached) {
+    if (gsm.network.is_attached != attached) {
+        gsm.network.is_attached = attached;
+        gsmi_send_cb(attached ? GSM_EVT_NETWORK_ATTACHED : GSM_EVT_NETWORK_DETACHED);
+    }
+}
+
+/**
+ * \brief           Pack first 4 characters of response to single key
+ * \hideinitializer
  */
+#define GSM_RSP_KEY(a, b, c, d)             ((GSM_U32(GSM_U8(a)) << 24) | (GSM_U32(GSM_U8(b)) << 16) | (GSM_U32(GSM_U8(c)) << 8) | GSM_U32(GSM_U8(d)))
+
+/**
+ * \brief           Response handler function prototype
+ * \param[in]       rcv: Received line
+ * \param[in,out]   is_ok: Set to `1` if line finishes command with success
+ * \param[in,out]   is_error: Set to non-zero if line finishes command with error
+ */
+typedef void (*gsmi_rsp_fn)(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error);
+
+/**
+ * \brief           Response dispatch table entry
+ */
+typedef struct {
+    uint32_t key;                               /*!< Packed first 4 characters of response, see \ref GSM_RSP_KEY */
+    const char* str;                            /*!< Full response prefix to compare */
+    uint8_t str_len;                            /*!< Length of prefix string */
+    gsm_cmd_t cmd;                              /*!< Current command required to process response or `GSM_CMD_IDLE` for any */
+    gsmi_rsp_fn fn;                             /*!< Handler function */
+} gsmi_rsp_t;
+
+#define GSM_RSP_ENTRY(a, b, c, d, str, cmd, fn)     { GSM_RSP_KEY(a, b, c, d), str, sizeof(str) - 1, cmd, fn }
+
 static void
-gsmi_parse_received(gsm_recv_t* rcv) {
-    uint8_t is_ok = 0;
-    uint16_t is_error = 0;
+gsmi_rsp_ok(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_error);
+    *is_ok = 1;
+}
 
-    /* Try to remove non-parsable strings */
-    if (rcv->len == 2 && rcv->data[0] == '\r' && rcv->data[1] == '\n') {
-        return;
-    }
+static void
+gsmi_rsp_error(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    *is_error = 1;
+}
 
-    /* Check OK rgsmonse */
-    is_ok = rcv->len == (2 + CRLF_LEN) && !strcmp(rcv->data, "OK" CRLF);    /* Check if received string is OK */
-    if (!is_ok) {                               /* Check for SHUT OK string */
-        is_ok = rcv->len == (7 + CRLF_LEN) && !strcmp(rcv->data, "SEND OK" CRLF);
+static void
+gsmi_rsp_csq(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_csq(rcv->data);                  /* Parse +CSQ response */
+}
+
+static void
+gsmi_rsp_creg(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_creg(rcv->data, GSM_U8(CMD_IS_CUR(GSM_CMD_CREG_GET)));  /* Parse +CREG rgsmonse */
+}
+
+static void
+gsmi_rsp_cpin(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cpin(rcv->data, !CMD_IS_DEF(GSM_CMD_CPIN_SET));  /* Parse +CPIN rgsmonse */
+}
+
+static void
+gsmi_rsp_cops(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cops(rcv->data);                 /* Parse current +COPS */
+}
+
+static void
+gsmi_rsp_at_echo(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    const char* tmp = rcv->data;
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    if (CMD_IS_CUR(GSM_CMD_CGMI_GET)) {         /* Check device manufacturer */
+        gsmi_parse_string(&tmp, gsm.model_manufacturer, sizeof(gsm.model_manufacturer), 1);
+    } else if (CMD_IS_CUR(GSM_CMD_CGMM_GET)) {  /* Check device model number */
+        gsmi_parse_string(&tmp, gsm.model_number, sizeof(gsm.model_number), 1);
+    } else if (CMD_IS_CUR(GSM_CMD_CGSN_GET)) {  /* Check device serial number */
+        gsmi_parse_string(&tmp, gsm.model_serial_number, sizeof(gsm.model_serial_number), 1);
     }
+}
 
-    /* Check error rgsmonse */
-    if (!is_ok) {                               /* If still not ok, check if error? */                             
-        is_error = rcv->data[0] == '+' && !strncmp(rcv->data, "+CME ERROR", 10); /* First check +CME coded errors */
-        if (!is_error) {                        /* Check basic error aswell */
-            is_error = rcv->data[0] == '+' && !strncmp(rcv->data, "+CMS ERROR", 10); /* First check +CME coded errors */
-            if (!is_error) {
-                is_error = !strcmp(rcv->data, "ERROR" CRLF) || !strcmp(rcv->data, "FAIL" CRLF);
-            }
+#if GSM_CFG_NETWORK || __DOXYGEN__
+static void
+gsmi_rsp_pdp_deact(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+#if GSM_CFG_DNS_CACHE
+    gsmi_dns_cache_flush();                     /* Addresses may change with new PDP context */
+#endif /* GSM_CFG_DNS_CACHE */
+#if GSM_CFG_NETWORK_REATTACH
+    if (gsm.reattach.valid && !gsm.reattach.active) {
+        gsm.reattach.active = 1;
+        if (gsmi_network_reattach() != gsmOK) {
+            gsm.reattach.active = 0;
         }
     }
+#endif /* GSM_CFG_NETWORK_REATTACH */
 
-    /* Scan received strings which start with '+' */
-    if (rcv->data[0] == '+') {
-        if (!strncmp(rcv->data, "+CSQ", 4)) {
-            gsmi_parse_csq(rcv->data);          /* Parse +CSQ response */
-#if GSM_CFG_NETWORK
-        } else if (!strncmp(rcv->data, "+PDP: DEACT", 11)) {
-            /* PDP has been deactivated */
-            gsm_network_check_status(0);        /* Update status */
-#endif /* GSM_CFG_NETWORK */
+    /*
+     * Device closed all connections together with PDP context.
+     * Connections marked for resume are reopened once reattach finishes
+     */
 #if GSM_CFG_CONN
-        } else if (!strncmp(rcv->data, "+RECEIVE", 8)) {
-            gsmi_parse_ipd(rcv->data);          /* Parse IPD */
+    gsmi_conn_closed_all();
 #endif /* GSM_CFG_CONN */
-        } else if (!strncmp(rcv->data, "+CREG", 5)) {   /* Check for +CREG indication */
-            gsmi_parse_creg(rcv->data, GSM_U8(CMD_IS_CUR(GSM_CMD_CREG_GET)));  /* Parse +CREG rgsmonse */
-        } else if (CMD_IS_CUR(GSM_CMD_CPIN_GET) && !strncmp(rcv->data, "+CPIN", 5)) {  /* Check for +CPIN indication for SIM */
-            gsmi_parse_cpin(rcv->data, !CMD_IS_DEF(GSM_CMD_CPIN_SET));  /* Parse +CPIN rgsmonse */
-        } else if (CMD_IS_CUR(GSM_CMD_COPS_GET) && !strncmp(rcv->data, "+COPS", 5)) {
-            gsmi_parse_cops(rcv->data);         /* Parse current +COPS */
-#if GSM_CFG_SMS
-        } else if (CMD_IS_CUR(GSM_CMD_CMGS) && !strncmp(rcv->data, "+CMGS", 5)) {
-            gsmi_parse_cmgs(rcv->data, 1);      /* Parse +CMGS rgsmonse */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGR) && !strncmp(rcv->data, "+CMGR", 5)) {
-            if (gsmi_parse_cmgr(rcv->data)) {   /* Parse +CMGR rgsmonse */
-                gsm.msg->msg.sms_read.read = 2; /* Set read flag and process the data */
-            } else {
-                gsm.msg->msg.sms_read.read = 1; /* Read but ignore data */
-            }
-        } else if (CMD_IS_CUR(GSM_CMD_CMGL) && !strncmp(rcv->data, "+CMGL", 5)) {
-            if (gsmi_parse_cmgl(rcv->data)) {   /* Parse +CMGL rgsmonse */
-                gsm.msg->msg.sms_list.read = 2; /* Set read flag and process the data */
-            } else {
-                gsm.msg->msg.sms_list.read = 1; /* Read but ignore data */
-            }
-        } else if (!strncmp(rcv->data, "+CMTI", 5)) {
-            gsmi_parse_cmti(rcv->data, 1);      /* Parse +CMTI rgsmonse with received SMS */
-        } else if (CMD_IS_CUR(GSM_CMD_CPMS_GET_OPT) && !strncmp(rcv->data, "+CPMS", 5)) {
-            gsmi_parse_cpms(rcv->data, 0);      /* Parse +CPMS with SMS memories info */
-        } else if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && !strncmp(rcv->data, "+CPMS", 5)) {
-            gsmi_parse_cpms(rcv->data, 1);      /* Parse +CPMS with SMS memories info */
-        } else if (CMD_IS_CUR(GSM_CMD_CPMS_SET) && !strncmp(rcv->data, "+CPMS", 5)) {
-            gsmi_parse_cpms(rcv->data, 2);      /* Parse +CPMS with SMS memories info */
-#endif /* GSM_CFG_SMS */
+    gsmi_network_set_attached(0);
+}
+#endif /* GSM_CFG_NETWORK || __DOXYGEN__ */
+
+#if GSM_CFG_CONN || __DOXYGEN__
+static void
+gsmi_rsp_receive(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_ipd(rcv->data);                  /* Parse IPD */
+}
+
+#if GSM_CFG_CONN_RECV_FROM || __DOXYGEN__
+static void
+gsmi_rsp_recv_from(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_recv_from(rcv->data);            /* Remote address of next packet */
+}
+#endif /* GSM_CFG_CONN_RECV_FROM || __DOXYGEN__ */
+
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+static void
+gsmi_rsp_ciprxget(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_ciprxget(rcv->data);             /* Parse data notification or read header */
+}
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
+
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+static void
+gsmi_rsp_sslsetcert(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    const char* tmp = &rcv->data[13];
+    if (gsmi_parse_number(&tmp) == 0) {
+        *is_ok = 1;                             /* Certificate loaded */
+    } else {
+        *is_error = 1;
+    }
+}
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
+
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+static void
+gsmi_rsp_cdnsgip(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    if (gsmi_parse_cdnsgip(rcv->data, &gsm.msg->msg.conn_start.ip)) {
+        *is_ok = 1;                             /* Host name resolved */
+    } else {
+        *is_error = 1;
+    }
+}
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
+#endif /* GSM_CFG_CONN || __DOXYGEN__ */
+
+#if GSM_CFG_HTTP || __DOXYGEN__
+static void
+gsmi_rsp_httpaction(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_httpaction(rcv->data);          /* Parse result of HTTP request */
+}
+
+static void
+gsmi_rsp_httpread(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_httpread(rcv->data);            /* Parse body data header */
+}
+#endif /* GSM_CFG_HTTP || __DOXYGEN__ */
+
+#if GSM_CFG_FTP || __DOXYGEN__
+static void
+gsmi_rsp_ftpget(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_ftpget(rcv->data);               /* Parse download status or data header */
+}
+
+static void
+gsmi_rsp_ftpput(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_ftpput(rcv->data);               /* Parse upload status and send chunk data */
+}
+#endif /* GSM_CFG_FTP || __DOXYGEN__ */
+
+#if GSM_CFG_PING || __DOXYGEN__
+static void
+gsmi_rsp_cipping(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cipping(rcv->data);              /* Parse reply of single probe */
+}
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
+
+#if GSM_CFG_SMS || __DOXYGEN__
+static void
+gsmi_rsp_cmgs(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cmgs(rcv->data, 1);              /* Parse +CMGS rgsmonse */
+}
+
+static void
+gsmi_rsp_cmgr(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    if (gsmi_parse_cmgr(rcv->data)) {           /* Parse +CMGR rgsmonse */
+        gsm.msg->msg.sms_read.read = 2;         /* Set read flag and process the data */
+    } else {
+        gsm.msg->msg.sms_read.read = 1;         /* Read but ignore data */
+    }
+}
+
+static void
+gsmi_rsp_cmgl(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    if (gsmi_parse_cmgl(rcv->data)) {           /* Parse +CMGL rgsmonse */
+        gsm.msg->msg.sms_list.read = 2;         /* Set read flag and process the data */
+    } else {
+        gsm.msg->msg.sms_list.read = 1;         /* Read but ignore data */
+    }
+}
+
+static void
+gsmi_rsp_cmti(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cmti(rcv->data, 1);              /* Parse +CMTI rgsmonse with received SMS */
+}
+
+static void
+gsmi_rsp_cpms(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    /* Parse +CPMS with SMS memories info */
+    gsmi_parse_cpms(rcv->data, CMD_IS_CUR(GSM_CMD_CPMS_GET_OPT) ? 0 : (CMD_IS_CUR(GSM_CMD_CPMS_GET) ? 1 : 2));
+}
+
+static void
+gsmi_rsp_sms_ready(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsm.sms.ready = 1;                          /* SMS ready flag */
+    gsmi_send_cb(GSM_EVT_SMS_READY);            /* Send SMS ready event */
+}
+#endif /* GSM_CFG_SMS || __DOXYGEN__ */
+
+#if GSM_CFG_CALL || __DOXYGEN__
+static void
+gsmi_rsp_clcc(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_clcc(rcv->data, 1);              /* Parse +CLCC rgsmonse with call info change */
+}
+
+static void
+gsmi_rsp_call_ready(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsm.call.ready = 1;
+    gsmi_send_cb(GSM_EVT_CALL_READY);           /* Send CALL ready event */
+}
+
+static void
+gsmi_rsp_call_ring(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_send_cb(GSM_EVT_CALL_RING);            /* Send call ring */
+}
+
+static void
+gsmi_rsp_call_no_carrier(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_send_cb(GSM_EVT_CALL_NO_CARRIER);      /* Send call no carrier event */
+}
+
+static void
+gsmi_rsp_call_busy(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(rcv);
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_send_cb(GSM_EVT_CALL_BUSY);            /* Send call busy message */
+}
+#endif /* GSM_CFG_CALL || __DOXYGEN__ */
+
+#if GSM_CFG_PHONEBOOK || __DOXYGEN__
+static void
+gsmi_rsp_cpbs(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    /* Parse +CPBS rgsmonse */
+    gsmi_parse_cpbs(rcv->data, CMD_IS_CUR(GSM_CMD_CPBS_GET_OPT) ? 0 : (CMD_IS_CUR(GSM_CMD_CPBS_GET) ? 1 : 2));
+}
+
+static void
+gsmi_rsp_cpbr(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cpbr(rcv->data);                 /* Parse +CPBR statement */
+}
+
+static void
+gsmi_rsp_cpbf(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+    GSM_UNUSED(is_ok);
+    GSM_UNUSED(is_error);
+    gsmi_parse_cpbf(rcv->data);                 /* Parse +CPBF statement */
+}
+#endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
+
+/**
+ * \brief           Responses starting with `+` character
+ * \note            Key is built from characters after `+` sign.
+ *                  Table must be sorted by key in ascending order
+ */
+static const gsmi_rsp_t
+gsmi_rsp_plus[] = {
+#if GSM_CFG_DNS_CACHE
+    GSM_RSP_ENTRY('C', 'D', 'N', 'S', "+CDNSGIP: ", GSM_CMD_CDNSGIP, gsmi_rsp_cdnsgip),
+#endif /* GSM_CFG_DNS_CACHE */
+#if GSM_CFG_PING
+    GSM_RSP_ENTRY('C', 'I', 'P', 'P', "+CIPPING", GSM_CMD_CIPPING, gsmi_rsp_cipping),
+#endif /* GSM_CFG_PING */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    GSM_RSP_ENTRY('C', 'I', 'P', 'R', "+CIPRXGET", GSM_CMD_IDLE, gsmi_rsp_ciprxget),
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
 #if GSM_CFG_CALL
-        } else if (!strncmp(rcv->data, "+CLCC", 5)) {
-            gsmi_parse_clcc(rcv->data, 1);      /* Parse +CLCC rgsmonse with call info change */
+    GSM_RSP_ENTRY('C', 'L', 'C', 'C', "+CLCC", GSM_CMD_IDLE, gsmi_rsp_clcc),
 #endif /* GSM_CFG_CALL */
+    GSM_RSP_ENTRY('C', 'M', 'E', ' ', "+CME ERROR", GSM_CMD_IDLE, gsmi_rsp_error),
+#if GSM_CFG_SMS
+    GSM_RSP_ENTRY('C', 'M', 'G', 'L', "+CMGL", GSM_CMD_CMGL, gsmi_rsp_cmgl),
+    GSM_RSP_ENTRY('C', 'M', 'G', 'R', "+CMGR", GSM_CMD_CMGR, gsmi_rsp_cmgr),
+    GSM_RSP_ENTRY('C', 'M', 'G', 'S', "+CMGS", GSM_CMD_CMGS, gsmi_rsp_cmgs),
+#endif /* GSM_CFG_SMS */
+    GSM_RSP_ENTRY('C', 'M', 'S', ' ', "+CMS ERROR", GSM_CMD_IDLE, gsmi_rsp_error),
+#if GSM_CFG_SMS
+    GSM_RSP_ENTRY('C', 'M', 'T', 'I', "+CMTI", GSM_CMD_IDLE, gsmi_rsp_cmti),
+#endif /* GSM_CFG_SMS */
+    GSM_RSP_ENTRY('C', 'O', 'P', 'S', "+COPS", GSM_CMD_COPS_GET, gsmi_rsp_cops),
 #if GSM_CFG_PHONEBOOK
-        } else if (CMD_IS_CUR(GSM_CMD_CPBS_GET_OPT) && !strncmp(rcv->data, "+CPBS", 5)) {
-            gsmi_parse_cpbs(rcv->data, 0);      /* Parse +CPBS rgsmonse */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBS_GET) && !strncmp(rcv->data, "+CPBS", 5)) {
-            gsmi_parse_cpbs(rcv->data, 1);      /* Parse +CPBS rgsmonse */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBS_SET) && !strncmp(rcv->data, "+CPBS", 5)) {
-            gsmi_parse_cpbs(rcv->data, 2);      /* Parse +CPBS rgsmonse */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBR) && !strncmp(rcv->data, "+CPBR", 5)) {
-            gsmi_parse_cpbr(rcv->data);         /* Parse +CPBR statement */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBF) && !strncmp(rcv->data, "+CPBF", 5)) {
-            gsmi_parse_cpbf(rcv->data);         /* Parse +CPBR statement */
+    GSM_RSP_ENTRY('C', 'P', 'B', 'F', "+CPBF", GSM_CMD_CPBF, gsmi_rsp_cpbf),
+    GSM_RSP_ENTRY('C', 'P', 'B', 'R', "+CPBR", GSM_CMD_CPBR, gsmi_rsp_cpbr),
+    GSM_RSP_ENTRY('C', 'P', 'B', 'S', "+CPBS", GSM_CMD_CPBS_GET_OPT, gsmi_rsp_cpbs),
+    GSM_RSP_ENTRY('C', 'P', 'B', 'S', "+CPBS", GSM_CMD_CPBS_GET, gsmi_rsp_cpbs),
+    GSM_RSP_ENTRY('C', 'P', 'B', 'S', "+CPBS", GSM_CMD_CPBS_SET, gsmi_rsp_cpbs),
 #endif /* GSM_CFG_PHONEBOOK */
+    GSM_RSP_ENTRY('C', 'P', 'I', 'N', "+CPIN", GSM_CMD_CPIN_GET, gsmi_rsp_cpin),
+#if GSM_CFG_SMS
+    GSM_RSP_ENTRY('C', 'P', 'M', 'S', "+CPMS", GSM_CMD_CPMS_GET_OPT, gsmi_rsp_cpms),
+    GSM_RSP_ENTRY('C', 'P', 'M', 'S', "+CPMS", GSM_CMD_CPMS_GET, gsmi_rsp_cpms),
+    GSM_RSP_ENTRY('C', 'P', 'M', 'S', "+CPMS", GSM_CMD_CPMS_SET, gsmi_rsp_cpms),
+#endif /* GSM_CFG_SMS */
+    GSM_RSP_ENTRY('C', 'R', 'E', 'G', "+CREG", GSM_CMD_IDLE, gsmi_rsp_creg),
+    GSM_RSP_ENTRY('C', 'S', 'Q', ':', "+CSQ", GSM_CMD_IDLE, gsmi_rsp_csq),
+#if GSM_CFG_FTP
+    GSM_RSP_ENTRY('F', 'T', 'P', 'G', "+FTPGET", GSM_CMD_IDLE, gsmi_rsp_ftpget),
+    GSM_RSP_ENTRY('F', 'T', 'P', 'P', "+FTPPUT", GSM_CMD_IDLE, gsmi_rsp_ftpput),
+#endif /* GSM_CFG_FTP */
+#if GSM_CFG_HTTP
+    GSM_RSP_ENTRY('H', 'T', 'T', 'P', "+HTTPACTION", GSM_CMD_HTTPACTION, gsmi_rsp_httpaction),
+    GSM_RSP_ENTRY('H', 'T', 'T', 'P', "+HTTPREAD", GSM_CMD_HTTPREAD, gsmi_rsp_httpread),
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_NETWORK
+    GSM_RSP_ENTRY('P', 'D', 'P', ':', "+PDP: DEACT", GSM_CMD_IDLE, gsmi_rsp_pdp_deact),
+#endif /* GSM_CFG_NETWORK */
+#if GSM_CFG_CONN
+    GSM_RSP_ENTRY('R', 'E', 'C', 'E', "+RECEIVE", GSM_CMD_IDLE, gsmi_rsp_receive),
+#endif /* GSM_CFG_CONN */
+#if GSM_CFG_CONN_SSL
+    GSM_RSP_ENTRY('S', 'S', 'L', 'S', "+SSLSETCERT: ", GSM_CMD_SSLSETCERT, gsmi_rsp_sslsetcert),
+#endif /* GSM_CFG_CONN_SSL */
+};
+
+/**
+ * \brief           Responses not starting with `+` character
+ * \note            Table must be sorted by key in ascending order
+ */
+static const gsmi_rsp_t
+gsmi_rsp_plain[] = {
+    GSM_RSP_ENTRY('A', 'T', '+', 'C', "AT+", GSM_CMD_IDLE, gsmi_rsp_at_echo),
+#if GSM_CFG_CALL
+    GSM_RSP_ENTRY('B', 'U', 'S', 'Y', "BUSY" CRLF, GSM_CMD_IDLE, gsmi_rsp_call_busy),
+    GSM_RSP_ENTRY('C', 'a', 'l', 'l', "Call Ready" CRLF, GSM_CMD_IDLE, gsmi_rsp_call_ready),
+#endif /* GSM_CFG_CALL */
+    GSM_RSP_ENTRY('E', 'R', 'R', 'O', "ERROR" CRLF, GSM_CMD_IDLE, gsmi_rsp_error),
+    GSM_RSP_ENTRY('F', 'A', 'I', 'L', "FAIL" CRLF, GSM_CMD_IDLE, gsmi_rsp_error),
+#if GSM_CFG_CALL
+    GSM_RSP_ENTRY('N', 'O', ' ', 'C', "NO CARRIER" CRLF, GSM_CMD_IDLE, gsmi_rsp_call_no_carrier),
+#endif /* GSM_CFG_CALL */
+    GSM_RSP_ENTRY('O', 'K', '\r', '\n', "OK" CRLF, GSM_CMD_IDLE, gsmi_rsp_ok),
+#if GSM_CFG_CONN_RECV_FROM
+    GSM_RSP_ENTRY('R', 'E', 'C', 'V', "RECV FROM:", GSM_CMD_IDLE, gsmi_rsp_recv_from),
+#endif /* GSM_CFG_CONN_RECV_FROM */
+#if GSM_CFG_CALL
+    GSM_RSP_ENTRY('R', 'I', 'N', 'G', "RING" CRLF, GSM_CMD_IDLE, gsmi_rsp_call_ring),
+#endif /* GSM_CFG_CALL */
+    GSM_RSP_ENTRY('S', 'E', 'N', 'D', "SEND OK" CRLF, GSM_CMD_IDLE, gsmi_rsp_ok),
+    GSM_RSP_ENTRY('S', 'H', 'U', 'T', "SHUT OK" CRLF, GSM_CMD_IDLE, gsmi_rsp_ok),
+#if GSM_CFG_SMS
+    GSM_RSP_ENTRY('S', 'M', 'S', ' ', "SMS Ready" CRLF, GSM_CMD_IDLE, gsmi_rsp_sms_ready),
+#endif /* GSM_CFG_SMS */
+};
+
+/**
+ * \brief           Find and call handler for received line
+ *
+ * Entry is found with binary search on packed key and only entries with equal key
+ * are compared as strings. Cost is independent of number of enabled modules
+ *
+ * \param[in]       tbl: Sorted dispatch table
+ * \param[in]       tbl_len: Number of entries in table
+ * \param[in]       rcv: Received line
+ * \param[in]       offset: Offset of first key character in received line
+ * \param[in,out]   is_ok: Passed to handler function
+ * \param[in,out]   is_error: Passed to handler function
+ * \return          `1` if handler was called, `0` otherwise
+ */
+static uint8_t
+gsmi_rsp_dispatch(const gsmi_rsp_t* tbl, size_t tbl_len, gsm_recv_t* rcv, size_t offset, uint8_t* is_ok, uint16_t* is_error) {
+    uint32_t key = 0;
+    size_t l = 0, r = tbl_len, m;
+
+    /* Pack next 4 characters, missing characters are zero */
+    for (size_t i = 0; i < 4; i++) {
+        key <<= 8;
+        if ((offset + i) < rcv->len) {
+            key |= GSM_U8(rcv->data[offset + i]);
+        }
+    }
+
+    /* Find first entry with key greater or equal to received one */
+    while (l < r) {
+        m = (l + r) / 2;
+        if (tbl[m].key < key) {
+            l = m + 1;
+        } else {
+            r = m;
         }
+    }
 
-    /* Messages not starting with '+' sign */
-    } else {
-        if (rcv->data[0] == 'S' && !strncmp(rcv->data, "SHUT OK" CRLF, 7 + CRLF_LEN)) {
-            is_ok = 1;
+    /* Check all entries with the same key */
+    for (; l < tbl_len && tbl[l].key == key; l++) {
+        if ((tbl[l].cmd == GSM_CMD_IDLE || CMD_IS_CUR(tbl[l].cmd))
+            && rcv->len >= tbl[l].str_len && !strncmp(rcv->data, tbl[l].str, tbl[l].str_len)) {
+            tbl[l].fn(rcv, is_ok, is_error);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Process received string from GSM
+ * \param[in]       recv: Pointer to \ref gsm_rect_t structure with input string
+ */
+static void
+gsmi_parse_received(gsm_recv_t* rcv) {
+    uint8_t is_ok = 0;
+    uint16_t is_error = 0;
+
+    /* Try to remove non-parsable strings */
+    if (rcv->len == 2 && rcv->data[0] == '\r' && rcv->data[1] == '\n') {
+        return;
+    }
+
+    /* Find response handler by line prefix */
+    if (rcv->data[0] == '+') {
+        gsmi_rsp_dispatch(gsmi_rsp_plus, GSM_ARRAYSIZE(gsmi_rsp_plus), rcv, 1, &is_ok, &is_error);
+    } else if (!gsmi_rsp_dispatch(gsmi_rsp_plain, GSM_ARRAYSIZE(gsmi_rsp_plain), rcv, 0, &is_ok, &is_error)) {
+        if (0) {
 #if GSM_CFG_CONN
         } else if (GSM_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',' && rcv->data[2] == ' '
             && (!strncmp(&rcv->data[3], "CLOSE OK" CRLF, 8 + CRLF_LEN) || !strncmp(&rcv->data[3], "CLOSED" CRLF, 6 + CRLF_LEN))) {
@@ -641,6 +1762,7 @@ gsmi_parse_received(gsm_recv_t* rcv) {
             num = GSM_CHARTONUM(rcv->data[0]);  /* Get connection number */
             if (CMD_IS_CUR(GSM_CMD_CIPCLOSE) && gsm.msg->msg.conn_close.conn->num == num) {
                 forced = 1;
+                is_ok = 1;                      /* Close response is final response of command */
             }
 
             /* Manually stop send command? */
@@ -653,37 +1775,36 @@ gsmi_parse_received(gsm_recv_t* rcv) {
                 gsmi_process_cipsend_response(rcv, &is_ok, &is_error);
             }
             gsmi_conn_closed_process(num, forced);  /* Connection closed, process */
-#endif /* GSM_CFG_CONN */
-#if GSM_CFG_CALL
-        } else if (rcv->data[0] == 'C' && !strncmp(rcv->data, "Call Ready" CRLF, 10 + CRLF_LEN)) {
-            gsm.call.ready = 1;
-            gsmi_send_cb(GSM_EVT_CALL_READY);   /* Send CALL ready event */
-        } else if (rcv->data[0] == 'R' && !strncmp(rcv->data, "RING" CRLF, 4 + CRLF_LEN)) {
-            gsmi_send_cb(GSM_EVT_CALL_RING);    /* Send call ring */
-        } else if (rcv->data[0] == 'N' && !strncmp(rcv->data, "NO CARRIER" CRLF, 10 + CRLF_LEN)) {
-            gsmi_send_cb(GSM_EVT_CALL_NO_CARRIER);  /* Send call no carrier event */
-        } else if (rcv->data[0] == 'B' && !strncmp(rcv->data, "BUSY" CRLF, 4 + CRLF_LEN)) {
-            gsmi_send_cb(GSM_EVT_CALL_BUSY);    /* Send call busy message */
-#endif /* GSM_CFG_CALL */
-#if GSM_CFG_SMS
-        } else if (rcv->data[0] == 'S' && !strncmp(rcv->data, "SMS Ready" CRLF, 9 + CRLF_LEN)) {
-            gsm.sms.ready = 1;                  /* SMS ready flag */
-            gsmi_send_cb(GSM_EVT_SMS_READY);    /* Send SMS ready event */
-#endif /* GSM_CFG_SMS */
-        } else if (!is_ok && !is_error && !strncmp(rcv->data, "AT+", 3)) {
-            const char* tmp = rcv->data;
-            if (CMD_IS_CUR(GSM_CMD_CGMI_GET)) { /* Check device manufacturer */
-                gsmi_parse_string(&tmp, gsm.model_manufacturer, sizeof(gsm.model_manufacturer), 1);
-            } else if (CMD_IS_CUR(GSM_CMD_CGMM_GET)) {  /* Check device model number */
-                gsmi_parse_string(&tmp, gsm.model_number, sizeof(gsm.model_number), 1);
-            } else if (CMD_IS_CUR(GSM_CMD_CGSN_GET)) {  /* Check device serial number */
-                gsmi_parse_string(&tmp, gsm.model_serial_number, sizeof(gsm.model_serial_number), 1);
+        } else if (GSM_CHARISNUM(rcv->data[0]) && rcv->data[1] == ',' && rcv->data[2] == ' '
+            && !strncmp(&rcv->data[3], "REMOTE IP: ", 11)) {
+            uint8_t num = GSM_CHARTONUM(rcv->data[0]);
+            if (num < GSM_CFG_MAX_CONNS) {
+                gsmi_conn_server_accept(num, &rcv->data[14]);   /* New connection to our server */
+            }
+#if GSM_CFG_CONN_TRANSPARENT
+        } else if (gsm.transp.active
+            && (!strncmp(rcv->data, "CLOSE OK" CRLF, 8 + CRLF_LEN) || !strncmp(rcv->data, "CLOSED" CRLF, 6 + CRLF_LEN))) {
+            uint8_t forced = CMD_IS_CUR(GSM_CMD_CIPCLOSE);
+
+            if (forced) {
+                is_ok = 1;                      /* Single connection close has no other response */
+            }
+            gsm.transp.data_mode = 0;
+            if (gsm.conns[0].status.f.active) {
+                gsmi_conn_closed_process(0, forced);    /* Connection closed, process */
             }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+#endif /* GSM_CFG_CONN */
         } else if (CMD_IS_CUR(GSM_CMD_CIFSR) && GSM_CHARISNUM(rcv->data[0])) {
             const char* tmp = rcv->data;
             gsmi_parse_ip(&tmp, &gsm.network.ip_addr);  /* Parse IP address */
 
             is_ok = 1;                          /* Manually set OK flag as we don't expect OK in CIFSR command */
+#if GSM_CFG_WARM_START && !GSM_CFG_AT_ECHO
+        } else if (CMD_IS_DEF(GSM_CMD_WARM_START) && CMD_IS_CUR(GSM_CMD_AT_SYNC)
+            && rcv->len <= 5 && rcv->data[0] == 'A' && rcv->data[1] == 'T') {
+            gsm.warm.echo = 1;                  /* Echo is enabled, device lost configuration */
+#endif /* GSM_CFG_WARM_START && !GSM_CFG_AT_ECHO */
         }
     }
 
@@ -693,7 +1814,7 @@ gsmi_parse_received(gsm_recv_t* rcv) {
 #if GSM_CFG_SMS
         } else if (CMD_IS_CUR(GSM_CMD_CMGS) && is_ok) {
             /* At this point we have to wait for "> " to send data */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGS) && is_error) {
+        } else if (CMD_IS_CUR(GSM_CMD_CMGS) && is_error && gsm.msg->msg.sms_send.format) {
             gsm.evt.evt.sms_send.res = gsmERR;
             gsmi_send_cb(GSM_EVT_SMS_SEND); /* SIM card event */
 #endif /* GSM_CFG_SMS */
@@ -716,6 +1837,11 @@ gsmi_parse_received(gsm_recv_t* rcv) {
                 } else if (!strncmp(rcv->data, "STATE:", 6)) {
                     processed = 1;
                     gsmi_parse_cipstatus_conn(rcv->data, 0, &continueScan);
+#if GSM_CFG_CONN_TRANSPARENT
+                    if (gsm.transp.active) {
+                        continueScan = 0;       /* Single connection mode has no connection lines */
+                    }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
                 }
 
                 /* Check if we shall stop processing at this stage */
@@ -723,33 +1849,51 @@ gsmi_parse_received(gsm_recv_t* rcv) {
                     is_ok = 1;
                 }
             }
+#if GSM_CFG_CONN_SSL
+        } else if (CMD_IS_CUR(GSM_CMD_SSLSETCERT)) {
+            /* For SSLSETCERT, OK is returned before certificate is loaded, result is handled by response table */
+            if (is_ok && rcv->data[0] != '+') {
+                is_ok = 0;
+            }
+#endif /* GSM_CFG_CONN_SSL */
+#if GSM_CFG_DNS_CACHE
+        } else if (CMD_IS_CUR(GSM_CMD_CDNSGIP)) {
+            /* For CDNSGIP, OK is returned before resolved address, handled by response table */
+            if (is_ok && rcv->data[0] != '+') {
+                is_ok = 0;
+            }
+#endif /* GSM_CFG_DNS_CACHE */
         } else if (CMD_IS_CUR(GSM_CMD_CIPSTART)) {
             /* For CIPSTART, OK is returned before important data */
             if (is_ok) {
                 is_ok = 0;
             }
 
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.active) {
+                /* Single connection responses have no connection number */
+                if (!strncmp(rcv->data, "CONNECT" CRLF, 7 + CRLF_LEN)) {
+                    gsmi_conn_start_activate(0);
+                    gsm.msg->msg.conn_start.conn_res = GSM_CONN_CONNECT_OK;
+                    gsm.transp.close_match = 0;
+                    gsm.transp.data_mode = 1;   /* Device is in data mode from now on */
+                    is_ok = 1;
+                } else if (!strncmp(rcv->data, "CONNECT FAIL" CRLF, 12 + CRLF_LEN)) {
+                    gsm.msg->msg.conn_start.conn_res = GSM_CONN_CONNECT_ERROR;
+                    is_error = 1;
+                } else if (!strncmp(rcv->data, "ALREADY CONNECT" CRLF, 15 + CRLF_LEN)) {
+                    gsm.msg->msg.conn_start.conn_res = GSM_CONN_CONNECT_ALREADY;
+                    is_error = 1;
+                }
+            } else
+#endif /* GSM_CFG_CONN_TRANSPARENT */
             /* Wait here for CONNECT status before we cancel connection */
             if (GSM_CHARISNUM(rcv->data[0])
                 && rcv->data[1] == ',' && rcv->data[2] == ' ') {
                 uint8_t num = GSM_CHARTONUM(rcv->data[0]);
                 if (num < GSM_CFG_MAX_CONNS) {
-                    uint8_t id;
-                    gsm_conn_t* conn = &gsm.conns[num]; /* Get connection handle */
-
                     if (!strncmp(&rcv->data[3], "CONNECT OK" CRLF, 10 + CRLF_LEN)) {
-                        id = conn->val_id;
-                        GSM_MEMSET(conn, 0x00, sizeof(*conn));  /* Reset connection parameters */
-                        conn->num = num;
-                        conn->status.f.active = 1;
-                        conn->val_id = ++id;            /* Set new validation ID */
-
-                        /* Set connection parameters */
-                        conn->status.f.client = 1;
-                        conn->evt_func = gsm.msg->msg.conn_start.evt_func;
-                        conn->arg = gsm.msg->msg.conn_start.arg;
-
-                        /* Set status */
+                        gsmi_conn_start_activate(num);
                         gsm.msg->msg.conn_start.conn_res = GSM_CONN_CONNECT_OK;
                         is_ok = 1;
                     } else if (!strncmp(&rcv->data[3], "CONNECT FAIL" CRLF, 12 + CRLF_LEN)) {
@@ -766,7 +1910,29 @@ gsmi_parse_received(gsm_recv_t* rcv) {
                 is_ok = 0;
             }
             gsmi_process_cipsend_response(rcv, &is_ok, &is_error);
+#if GSM_CFG_CONN_TRANSPARENT
+        } else if (CMD_IS_CUR(GSM_CMD_ATO)) {
+            if (!strncmp(rcv->data, "CONNECT" CRLF, 7 + CRLF_LEN)) {
+                gsm.transp.close_match = 0;
+                gsm.transp.data_mode = 1;       /* Back in data mode */
+                is_ok = 1;
+            }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
 #endif /* GSM_CFG_CONN */
+#if GSM_CFG_HTTP
+        } else if (CMD_IS_CUR(GSM_CMD_HTTPACTION)) {
+            /* For HTTPACTION, OK is returned before request result */
+            is_ok = gsm.msg->msg.http_get.action;
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_FTP
+        } else if (CMD_IS_CUR(GSM_CMD_FTPGET_OPEN) || CMD_IS_CUR(GSM_CMD_FTPGET_READ)
+                || CMD_IS_CUR(GSM_CMD_FTPPUT_OPEN) || CMD_IS_CUR(GSM_CMD_FTPPUT_WRITE)) {
+            /* OK may be returned before transfer status */
+            if (is_ok) {
+                gsm.msg->msg.ftp.ok = 1;
+            }
+            is_ok = gsm.msg->msg.ftp.ok && !gsm.msg->msg.ftp.wait;
+#endif /* GSM_CFG_FTP */
         }
     }
     
@@ -775,39 +1941,169 @@ gsmi_parse_received(gsm_recv_t* rcv) {
      * and proceed with next command
      */
     if (is_ok || is_error) {
-        gsmr_t res = gsmOK;
-        if (gsm.msg != NULL) {                  /* Do we have active message? */
-            res = gsmi_process_sub_cmd(gsm.msg, &is_ok, &is_error);
-
-            /* Check if reset command finished */
-            if (CMD_IS_DEF(GSM_CMD_RESET)) {
-                if (gsm.msg->cmd == GSM_CMD_IDLE) {
-                    gsmi_send_cb(GSM_EVT_RESET_FINISH); /* Send to upper layer */
-                }
+        gsmi_process_cmd_result(is_ok, is_error);
+    }
+}
+
+/**
+ * \brief           Process final result of current command
+ *
+ * Next sub-command is started or synchronization semaphore is released
+ * so that producer thread continues with next message
+ *
+ * \param[in]       is_ok: Set to `1` if command finished with success
+ * \param[in]       is_error: Set to non-zero if command finished with error
+ */
+void
+gsmi_process_cmd_result(uint8_t is_ok, uint16_t is_error) {
+    gsmr_t res = gsmOK;
+    if (gsm.msg != NULL) {                      /* Do we have active message? */
+        res = gsmi_process_sub_cmd(gsm.msg, &is_ok, &is_error);
+
+        /* Check if reset command finished */
+        if (CMD_IS_DEF(GSM_CMD_RESET)) {
+            if (gsm.msg->cmd == GSM_CMD_IDLE) {
+                gsmi_send_cb(GSM_EVT_RESET_FINISH); /* Send to upper layer */
             }
+        }
 
-            if (res != gsmCONT) {               /* Shall we continue with next subcommand under this one? */
-                if (is_ok) {                    /* Check OK status */
-                    res = gsm.msg->res = gsmOK;
-                } else {                        /* Or error status */
-                    res = gsm.msg->res = res;   /* Set the error status */
-                }
-            } else {
-                gsm.msg->i++;                   /* Number of continue calls */
+        if (res != gsmCONT) {                   /* Shall we continue with next subcommand under this one? */
+            if (is_ok) {                        /* Check OK status */
+                res = gsm.msg->res = gsmOK;
+            } else {                            /* Or error status */
+                res = gsm.msg->res = res;       /* Set the error status */
             }
+        } else {
+            gsm.msg->i++;                       /* Number of continue calls */
         }
+    }
 
-        /*
-         * When the command is finished,
-         * release synchronization semaphore
-         * from user thread and start with next command
-         */
-        if (res != gsmCONT) {                   /* Do we have to continue to wait for command? */
-            gsm_sys_sem_release(&gsm.sem_sync); /* Release semaphore */
+    /*
+     * When the command is finished,
+     * release synchronization semaphore
+     * from user thread and start with next command
+     */
+    if (res != gsmCONT) {                       /* Do we have to continue to wait for command? */
+        gsm_sys_sem_release(&gsm.sem_sync);     /* Release semaphore */
+    }
+}
+
+/**
+ * \brief           Pass operators scan line to byte parser
+ * \param[in]       data: Fragment of received line
+ * \param[in]       len: Length of fragment in units of bytes
+ * \param[in]       flags: Fragment position flags
+ */
+static void
+gsmi_line_cops_scan(const char* data, size_t len, uint8_t flags) {
+    if (flags & GSMI_LINE_FIRST) {
+        gsmi_parse_cops_scan(0, 1);             /* Reset parser state */
+        data += 6;                              /* Skip "+COPS:" prefix */
+        len -= 6;
+    }
+    for (; len > 0; --len, ++data) {
+        if (*data != '\n') {
+            gsmi_parse_cops_scan(GSM_U8(*data), 0); /* Parse character by character */
+        }
+    }
+}
+
+/**
+ * \brief           Streamed line table entry
+ */
+typedef struct gsmi_line_stream {
+    gsm_cmd_t cmd;                              /*!< Current command required to stream line */
+    const char* str;                            /*!< Prefix of lines to pass to handler */
+    uint8_t str_len;                            /*!< Length of prefix string */
+    gsmi_line_fn fn;                            /*!< Fragment handler function */
+} gsmi_line_stream_t;
+
+#define GSM_LINE_STREAM_ENTRY(cmd, str, fn)     { cmd, str, sizeof(str) - 1, fn }
+
+/**
+ * \brief           Responses passed to handler in fragments as they arrive
+ *
+ * Lines of these responses may be longer than received line buffer.
+ * They are not parsed with \ref gsmi_parse_received, all other lines
+ * longer than buffer are truncated
+ */
+static const gsmi_line_stream_t
+gsmi_line_streams[] = {
+    GSM_LINE_STREAM_ENTRY(GSM_CMD_COPS_GET_OPT, "+COPS:", gsmi_line_cops_scan),
+};
+
+/**
+ * \brief           Select line stream entry for command
+ * \param[in]       cmd: Command being started
+ */
+static void
+gsmi_recv_stream_set(gsm_cmd_t cmd) {
+    gsm.recv_stream.entry = NULL;
+    for (size_t i = 0; i < GSM_ARRAYSIZE(gsmi_line_streams); i++) {
+        if (gsmi_line_streams[i].cmd == cmd) {
+            gsm.recv_stream.entry = &gsmi_line_streams[i];
+            break;
+        }
+    }
+}
+
+/**
+ * \brief           Start streaming of current line if it matches prefix of current command
+ */
+static void
+gsmi_recv_stream_check(void) {
+    const gsmi_line_stream_t* s = gsm.recv_stream.entry;
+
+    if (s != NULL && !gsm.recv_stream.checked && RECV_LEN() >= s->str_len) {
+        gsm.recv_stream.checked = 1;            /* Compare only once per line */
+        if (CMD_IS_CUR(s->cmd) && !strncmp(gsm.recv_buff.data, s->str, s->str_len)) {
+            gsm.recv_stream.active = 1;
+            gsm.recv_stream.first = 1;
         }
     }
 }
 
+/**
+ * \brief           Pass received line buffer to stream handler and empty it
+ * \param[in]       flags: Fragment position flags, \ref GSMI_LINE_FIRST is added automatically
+ */
+static void
+gsmi_recv_stream_flush(uint8_t flags) {
+    if (gsm.recv_stream.first) {
+        flags |= GSMI_LINE_FIRST;
+        gsm.recv_stream.first = 0;
+    }
+    if (CMD_IS_CUR(gsm.recv_stream.entry->cmd)) {
+        gsm.recv_stream.entry->fn(gsm.recv_buff.data, RECV_LEN(), flags);
+    }
+    gsm.recv_buff.len = 0;                      /* Line continues, keep stream state */
+    gsm.recv_buff.data[0] = 0;
+}
+
+/**
+ * \brief           Add character to received line buffer
+ *
+ * When buffer is full, streamed line is passed to handler
+ * and other lines are truncated. Space for `CR LF` is always kept
+ *
+ * \param[in]       ch: Character to add
+ */
+static void
+gsmi_recv_add(uint8_t ch) {
+    if (RECV_LEN() >= RECV_LINE_MAX && ch != '\r' && ch != '\n') {
+        if (gsm.recv_stream.active) {
+            gsmi_recv_stream_flush(0);
+        } else {
+            GSM_DEBUGW(GSM_CFG_DBG_INPUT | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING, !gsm.recv_stream.truncated,
+                "[INPUT] Received line longer than %d bytes, truncating\r\n", (int)RECV_LINE_MAX);
+            gsm.recv_stream.truncated = 1;
+            return;
+        }
+    }
+    RECV_ADD(ch);
+    gsmi_recv_stream_check();
+}
+
 #if !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__
 /**
  * \brief           Process data from input buffer
@@ -815,36 +2111,92 @@ gsmi_parse_received(gsm_recv_t* rcv) {
  */
 gsmr_t
 gsmi_process_buffer(void) {
-    void* data;
+    gsm_iovec_t views[2];
     size_t len;
     
     do {
+#if GSM_CFG_CONN && GSM_CFG_IPD_ZERO_COPY
         /*
-         * Get length of linear memory in buffer
-         * we can process directly as memory
+         * Check if packet buffer still references receive buffer memory
+         * and release memory once application freed it
          */
-        len = gsm_buff_get_linear_block_length(&gsm.buff);
-        if (len) {
-            /*
-             * Get memory address of first element
-             * in linear block to process
-             */
-            data = gsm_buff_get_linear_block_address(&gsm.buff);
-            
-            /* Process actual received data */
-            gsmi_process(data, len);
+        if (gsm.ipd.hold != NULL) {
+            if (gsm.ipd.hold->ref > 1) {        /* Application still uses packet buffer */
+                break;
+            }
+            len = gsm.ipd.hold->len;
+            gsm_pbuf_free(gsm.ipd.hold);        /* Free our reference */
+            gsm.ipd.hold = NULL;
+            GSMI_BUFF_FN(gsm_buff_skip)(&gsm.buff, len);    /* Release receive buffer memory */
+        }
+#endif /* GSM_CFG_CONN && GSM_CFG_IPD_ZERO_COPY */
+
+        /*
+         * Get received data as linear memory views,
+         * second one is used only when data wrap around end of buffer.
+         * Each view is processed directly from buffer memory with single call
+         */
+        len = GSMI_BUFF_FN(gsm_buff_get_read_views)(&gsm.buff, views);
+        for (size_t i = 0; i < GSM_ARRAYSIZE(views) && views[i].len; ++i) {
+            gsmi_process(views[i].data, views[i].len);
+#if GSM_CFG_CONN && GSM_CFG_IPD_ZERO_COPY
+            if (gsm.ipd.hold != NULL) {         /* Skip only data before held payload and start over */
+                GSMI_BUFF_FN(gsm_buff_skip)(&gsm.buff, gsm.ipd.hold_off);
+                break;
+            }
+#endif /* GSM_CFG_CONN && GSM_CFG_IPD_ZERO_COPY */
             
             /*
              * Once they are processed, simply skip
-             * the buffer memory and start over
+             * the buffer memory
              */
-            gsm_buff_skip(&gsm.buff, len);
+            GSMI_BUFF_FN(gsm_buff_skip)(&gsm.buff, views[i].len);
         }
     } while (len);
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+    /* Let device send again once enough memory is free */
+    if (gsm.rx_paused && GSMI_BUFF_FN(gsm_buff_get_full)(&gsm.buff) <= GSM_CFG_AT_PORT_FLOW_LOW_WATERMARK) {
+        gsm.rx_paused = 0;
+        if (gsm.ll.rx_flow_fn != NULL) {
+            gsm.ll.rx_flow_fn(1);
+        }
+    }
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
     return gsmOK;
 }
 #endif /* !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
 
+/**
+ * \brief           Get length of plain ASCII run at the beginning of input data
+ *
+ * Plain characters are printable ASCII characters and `CR`.
+ * Run stops at first `LF`, control or non-ASCII character. Input is scanned
+ * word by word and only the last word is checked byte by byte
+ *
+ * \param[in]       d: Input data to scan
+ * \param[in]       len: Maximal number of bytes to scan
+ * \return          Number of plain ASCII characters at the beginning of input data
+ */
+static size_t
+gsmi_ascii_run_len(const uint8_t* d, size_t len) {
+    size_t i = 0;
+    uint32_t w;
+
+    /* Check 4 bytes at a time: any byte >= 0x80, < 0x20 or equal to 0x7F stops the word */
+    for (; (len - i) >= sizeof(w); i += sizeof(w)) {
+        GSM_MEMCPY(&w, &d[i], sizeof(w));       /* Load unaligned word */
+        if (((w - GSM_U32(0x20202020)) | w | ((w ^ GSM_U32(0x7F7F7F7F)) - GSM_U32(0x01010101))) & GSM_U32(0x80808080)) {
+            break;                              /* Special character somewhere in this word */
+        }
+    }
+    for (; i < len; i++) {
+        if ((d[i] < 32 || d[i] > 126) && d[i] != '\r') {
+            break;
+        }
+    }
+    return i;
+}
+
 /**
  * \brief           Process input data received from GSM device
  * \param[in]       data: Pointer to data to process
@@ -853,11 +2205,33 @@ gsmi_process_buffer(void) {
  */
 gsmr_t
 gsmi_process(const void* data, size_t data_len) {
+#if GSM_CFG_CMUX
+    if (gsm.cmux.active) {                      /* Data are framed by multiplexer */
+        return gsmi_cmux_process(data, data_len);
+    }
+#endif /* GSM_CFG_CMUX */
+    return gsmi_process_at(data, data_len);
+}
+
+/**
+ * \brief           Process AT command channel data received from GSM device
+ * \param[in]       data: Pointer to data to process
+ * \param[in]       data_len: Length of data to process in units of bytes
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_process_at(const void* data, size_t data_len) {
     uint8_t ch;
+    size_t run;
     size_t d_len = data_len;
     const uint8_t* d;
-    static uint8_t ch_prev1, ch_prev2;
-    static gsm_unicode_t unicode;
+
+#if GSM_CFG_CMD_STATS
+    if (gsm.msg != NULL && !gsm.msg->rsp_received && data_len > 0) {
+        gsm.msg->rsp_time = gsm_sys_now();      /* First byte after command was started */
+        gsm.msg->rsp_received = 1;
+    }
+#endif /* GSM_CFG_CMD_STATS */
     
     d = data;                                   /* Go to byte format */
     d_len = data_len;
@@ -867,11 +2241,113 @@ gsmi_process(const void* data, size_t data_len) {
         
         if (0) {
 #if GSM_CFG_CONN
+#if GSM_CFG_CONN_TRANSPARENT
+        } else if (gsm.transp.data_mode         /* In data mode all bytes belong to connection */
+#if GSM_CFG_CMUX
+            && gsmi_cmux_transp_rx()            /* AT command channel stays in command mode */
+#endif /* GSM_CFG_CMUX */
+            ) {
+            static const char closed_str[] = CRLF "CLOSED" CRLF;
+            const uint8_t* start = d - 1;
+            size_t len, avail = d_len + 1, closed_len = sizeof(closed_str) - 1;
+
+            /* Take bytes until end of block or until device reports closed connection */
+            for (len = 0; len < avail && gsm.transp.close_match < closed_len; ++len) {
+                if (start[len] == GSM_U8(closed_str[gsm.transp.close_match])) {
+                    gsm.transp.close_match++;
+                } else {
+                    gsm.transp.close_match = start[len] == GSM_U8(closed_str[0]);
+                }
+            }
+            d += len - 1;                       /* First byte was already read */
+            d_len -= len - 1;
+            if (gsm.transp.close_match == closed_len) {
+                /*
+                 * Marker is not part of connection data.
+                 * If it started in previous block, these bytes were already sent to connection
+                 */
+                gsmi_transp_recv(start, len > closed_len ? len - closed_len : 0);
+                gsm.transp.close_match = 0;
+                gsm.transp.data_mode = 0;       /* Device is in command mode again */
+                if (gsm.conns[0].status.f.active) {
+                    gsmi_conn_closed_process(0, 0);
+                }
+                ch = '\n';                      /* Next byte starts new line */
+            } else {
+                gsmi_transp_recv(start, len);
+                ch = d[-1];                     /* Last byte in data block */
+            }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
         } else if (gsm.ipd.read) {              /* Read connection data */
             size_t len;
 
+#if GSM_CFG_IPD_ZERO_COPY
+            /*
+             * Take as much data as available in current block
+             * and reference it directly from receive buffer
+             */
+            len = GSM_MIN(d_len + 1, gsm.ipd.rem_len);
+            if (!gsm.ipd.ignore && (gsm.ipd.buff = gsm_pbuf_new(0)) == NULL) {
+                gsm.ipd.conn->stats.rx_alloc_fail++;
+            }
+            if (gsm.ipd.buff != NULL) {
+                gsmr_t res;
+
+                gsm.ipd.buff->payload = (uint8_t *)(d - 1); /* Payload is in receive buffer */
+                gsm.ipd.buff->tot_len = gsm.ipd.buff->len = len;
+                gsm_pbuf_set_ip(gsm.ipd.buff, &gsm.ipd.ip, gsm.ipd.port);
+                gsm.ipd.conn->total_recved += len;  /* Increase number of bytes received */
+                gsm.ipd.conn->stats.rx_pbufs++;
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+                gsm.ipd.conn->tcp_not_ack_bytes += len; /* Confirmed later by application */
+                gsm.ipd.conn->tcp_not_ack_pkts++;
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+
+                gsm.evt.type = GSM_EVT_CONN_DATA_RECV;  /* We have received data */
+                gsm.evt.evt.conn_data_recv.buff = gsm.ipd.buff;
+                gsm.evt.evt.conn_data_recv.conn = gsm.ipd.conn;
+                res = gsmi_send_conn_cb(gsm.ipd.conn, NULL);    /* Send connection callback */
+
+                /*
+                 * If application still has reference to packet buffer,
+                 * copy its payload out of receive buffer so processing can continue.
+                 * Only when there is no memory for copy, keep our reference
+                 * and hold receive buffer memory until it is released
+                 */
+                if (gsm.ipd.buff->ref > 1 && gsmi_pbuf_copy_payload(gsm.ipd.buff) != gsmOK) {
+                    gsm.ipd.hold = gsm.ipd.buff;
+                    gsm.ipd.hold_off = GSM_SZ((d - 1) - (const uint8_t *)data);
+                    GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE,
+                        "[IPD] Packet buffer kept by application, holding %d bytes\r\n", (int)len);
+                } else {
+                    gsm_pbuf_free(gsm.ipd.buff);    /* Free packet buffer at this point */
+                }
+                gsm.ipd.buff = NULL;
+                if (res == gsmOKIGNOREMORE || gsm.ipd.conn->status.f.in_closing) {
+                    GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE,
+                        "[IPD] Ignoring more data from this IPD if available\r\n");
+                    gsm.ipd.ignore = 1;
+                }
+            } else {
+                GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE,
+                    "[IPD] Bytes skipped: %d\r\n", (int)len);
+                gsm.ipd.conn->stats.rx_dropped += len;
+            }
+            gsm.ipd.rem_len -= len;
+            d += len - 1;                       /* First byte was already read */
+            d_len -= len - 1;
+            if (len > 1) {
+                gsm.recv_ch_prev1 = d[-2];      /* Becomes "previous previous" below */
+            }
+            ch = d[-1];                         /* Last byte in data block */
+            if (!gsm.ipd.rem_len) {             /* Check if we read everything */
+                gsm.ipd.read = 0;               /* Stop reading data */
+            }
+#else /* GSM_CFG_IPD_ZERO_COPY */
             if (gsm.ipd.buff != NULL) {         /* Do we have active buffer? */
                 gsm.ipd.buff->payload[gsm.ipd.buff_ptr] = ch;   /* Save data character */
+            } else {
+                gsm.ipd.conn->stats.rx_dropped++;
             }
             gsm.ipd.buff_ptr++;
             gsm.ipd.rem_len--;
@@ -888,6 +2364,7 @@ gsmi_process(const void* data, size_t data_len) {
                 } else {                        /* Simply skip the data in buffer */
                     GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE,
                         "[IPD] Bytes skipped: %d\r\n", (int)len);
+                    gsm.ipd.conn->stats.rx_dropped += len;
                 }
                 d_len -= len;                   /* Decrease effective length */
                 d += len;                       /* Skip remaining length */
@@ -902,6 +2379,11 @@ gsmi_process(const void* data, size_t data_len) {
                 /* Call user callback function with received data */
                 if (gsm.ipd.buff != NULL) {     /* Do we have valid buffer? */
                     gsm.ipd.conn->total_recved += gsm.ipd.buff->tot_len;    /* Increase number of bytes received */
+                    gsm.ipd.conn->stats.rx_pbufs++;
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+                    gsm.ipd.conn->tcp_not_ack_bytes += gsm.ipd.buff->tot_len;   /* Confirmed later by application */
+                    gsm.ipd.conn->tcp_not_ack_pkts++;
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
 
                     /*
                      * Send data buffer to upper layer
@@ -935,6 +2417,10 @@ gsmi_process(const void* data, size_t data_len) {
                         GSM_DEBUGF(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE,
                             "[IPD] Allocating new packet buffer of size: %d bytes\r\n", (int)new_len);
                         gsm.ipd.buff = gsm_pbuf_new(new_len);   /* Allocate new packet buffer */
+                        gsm_pbuf_set_ip(gsm.ipd.buff, &gsm.ipd.ip, gsm.ipd.port);
+                        if (gsm.ipd.buff == NULL) {
+                            gsm.ipd.conn->stats.rx_alloc_fail++;
+                        }
 
                         GSM_DEBUGW(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
                             gsm.ipd.buff == NULL, "[IPD] Buffer allocation failed for %d bytes\r\n", (int)new_len);
@@ -948,17 +2434,26 @@ gsmi_process(const void* data, size_t data_len) {
                 }
                 gsm.ipd.buff_ptr = 0;           /* Reset input buffer pointer */
             }
+#endif /* !GSM_CFG_IPD_ZERO_COPY */
 #endif /* GSM_CFG_CONN */
-        /*
-         * Check if operators scan command is active
-         * and if we are ready to read the incoming data
-         */
-        } else if (CMD_IS_CUR(GSM_CMD_COPS_GET_OPT) && gsm.msg->msg.cops_scan.read) {
-            if (ch == '\n') {
-                gsm.msg->msg.cops_scan.read = 0;
-            } else {
-                gsmi_parse_cops_scan(ch, 0);    /* Parse character by character */
-            }
+#if GSM_CFG_HTTP
+        } else if (CMD_IS_CUR(GSM_CMD_HTTPREAD) && gsm.msg->msg.http_get.read) {
+            size_t len;
+
+            len = gsmi_http_recv(d - 1, d_len + 1); /* Take as much body data as available */
+            d += len - 1;                       /* First byte was already read */
+            d_len -= len - 1;
+            ch = d[-1];                         /* Last byte of body data */
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_FTP
+        } else if (CMD_IS_CUR(GSM_CMD_FTPGET_READ) && gsm.msg->msg.ftp.read) {
+            size_t len;
+
+            len = gsmi_ftp_recv(d - 1, d_len + 1);  /* Take as much file data as available */
+            d += len - 1;                       /* First byte was already read */
+            d_len -= len - 1;
+            ch = d[-1];                         /* Last byte of file data */
+#endif /* GSM_CFG_FTP */
 #if GSM_CFG_SMS
         } else if (CMD_IS_CUR(GSM_CMD_CMGR) && gsm.msg->msg.sms_read.read) {
             gsm_sms_entry_t* e = gsm.msg->msg.sms_read.entry;
@@ -971,7 +2466,7 @@ gsmi_process(const void* data, size_t data_len) {
                     gsm.msg->msg.sms_read.read = 1; /* Read but ignore data */
                 }
             }
-            if (ch == '\n' && ch_prev1 == '\r') {
+            if (ch == '\n' && gsm.recv_ch_prev1 == '\r') {
                 if (gsm.msg->msg.sms_read.read == 2) {
                     gsm.evt.evt.sms_read.entry = e;
                     gsmi_send_cb(GSM_EVT_SMS_READ);
@@ -979,14 +2474,17 @@ gsmi_process(const void* data, size_t data_len) {
                 gsm.msg->msg.sms_read.read = 0;
             }
         } else if (CMD_IS_CUR(GSM_CMD_CMGL) && gsm.msg->msg.sms_list.read) {
+            gsm_sms_entry_t* e = &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.fn != NULL ? 0 : gsm.msg->msg.sms_list.ei];
             if (gsm.msg->msg.sms_list.read == 2) {
-                gsm_sms_entry_t* e = &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei];
                 if (e->length < (sizeof(e->data) - 1)) {
                     e->data[e->length++] = ch;
                 }
             }
-            if (ch == '\n' && ch_prev1 == '\r') {
+            if (ch == '\n' && gsm.recv_ch_prev1 == '\r') {
                 if (gsm.msg->msg.sms_list.read == 2) {
+                    if (gsm.msg->msg.sms_list.fn != NULL) { /* Pass entry to user and reuse memory */
+                        gsmi_sms_list_entry(e);
+                    }
                     gsm.msg->msg.sms_list.ei++; /* Go to next entry */
                     if (gsm.msg->msg.sms_list.er != NULL) { /* Check and update user variable */
                         *gsm.msg->msg.sms_list.er = gsm.msg->msg.sms_list.ei;
@@ -995,6 +2493,28 @@ gsmi_process(const void* data, size_t data_len) {
                 gsm.msg->msg.sms_list.read = 0;
             }
 #endif /* GSM_CFG_SMS */
+        /*
+         * Fast path for plain ASCII runs in command mode
+         *
+         * Copy entire run up to next special character to receive buffer at once.
+         * First 2 characters after new line and unicode sequences
+         * are processed byte by byte to properly detect "> " sequence.
+         * Full buffer is handled byte by byte to stream or truncate the line
+         */
+        } else if (!gsm.recv_unicode.r && gsm.recv_ch_prev1 != '\n' && gsm.recv_ch_prev2 != '\n'
+                    && RECV_LEN() < (RECV_LINE_MAX - 1)
+                    && (run = gsmi_ascii_run_len(d - 1, GSM_MIN(d_len + 1, RECV_LINE_MAX - RECV_LEN()))) > 1) {
+            GSM_MEMCPY(&gsm.recv_buff.data[gsm.recv_buff.len], d - 1, run);
+            gsm.recv_buff.len += run;
+            gsm.recv_buff.data[gsm.recv_buff.len] = 0;
+            gsmi_recv_stream_check();           /* Run may complete stream prefix */
+            gsm.recv_unicode.t = 1;             /* Same state as after single ASCII character */
+            gsm.recv_unicode.r = 0;
+
+            d += run - 1;                       /* First character was already read */
+            d_len -= run - 1;
+            ch = d[-1];                         /* Last character in run */
+            gsm.recv_ch_prev1 = d[-2];          /* Becomes "previous previous" below */
         /*
          * We are in command mode where we have to process byte by byte
          * Simply check for ASCII and unicode format and process data accordingly
@@ -1003,25 +2523,29 @@ gsmi_process(const void* data, size_t data_len) {
             gsmr_t res = gsmERR;
             if (GSM_ISVALIDASCII(ch)) {         /* Manually check if valid ASCII character */
                 res = gsmOK;
-                unicode.t = 1;                  /* Manually set total to 1 */
-                unicode.r = 0;                  /* Reset remaining bytes */
+                gsm.recv_unicode.t = 1;         /* Manually set total to 1 */
+                gsm.recv_unicode.r = 0;         /* Reset remaining bytes */
             } else if (ch >= 0x80) {            /* Process only if more than ASCII can hold */
-                res = gsmi_unicode_decode(&unicode, ch);    /* Try to decode unicode format */
+                res = gsmi_unicode_decode(&gsm.recv_unicode, ch); /* Try to decode unicode format */
             }
             
             if (res == gsmERR) {                /* In case of an ERROR */
-                unicode.r = 0;
+                gsm.recv_unicode.r = 0;
             }
             if (res == gsmOK) {                 /* Can we process the character(s) */
-                if (unicode.t == 1) {           /* Totally 1 character? */
+                if (gsm.recv_unicode.t == 1) {  /* Totally 1 character? */
                     switch (ch) {
                         case '\n':
-                            RECV_ADD(ch);       /* Add character to input buffer */
-                            gsmi_parse_received(&recv_buff);	/* Parse received string */
+                            gsmi_recv_add(ch);  /* Add character to input buffer */
+                            if (gsm.recv_stream.active) {
+                                gsmi_recv_stream_flush(GSMI_LINE_LAST); /* Last fragment of streamed line */
+                            } else {
+                                gsmi_parse_received(&gsm.recv_buff);    /* Parse received string */
+                            }
                             RECV_RESET();       /* Reset received string */
                             break;
                         default:
-                            RECV_ADD(ch);       /* Any ASCII valid character */
+                            gsmi_recv_add(ch);  /* Any ASCII valid character */
                             break;
                     }
 
@@ -1041,8 +2565,17 @@ gsmi_process(const void* data, size_t data_len) {
                          *  - Connection is active and
                          *  - Connection is not in closing mode
                          */
+#if GSM_CFG_IPD_ZERO_COPY
+                        gsm.ipd.buff = NULL;    /* Packet buffers are created when data are read */
+                        gsm.ipd.ignore = !gsm.ipd.conn->status.f.active || gsm.ipd.conn->status.f.in_closing;
+                        GSM_UNUSED(len);
+#else /* GSM_CFG_IPD_ZERO_COPY */
                         if (gsm.ipd.conn->status.f.active && !gsm.ipd.conn->status.f.in_closing) {
                             gsm.ipd.buff = gsm_pbuf_new(len);   /* Allocate new packet buffer */
+                            gsm_pbuf_set_ip(gsm.ipd.buff, &gsm.ipd.ip, gsm.ipd.port);
+                            if (gsm.ipd.buff == NULL) {
+                                gsm.ipd.conn->stats.rx_alloc_fail++;
+                            }
                             GSM_DEBUGW(GSM_CFG_DBG_IPD | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING, gsm.ipd.buff == NULL,
                                 "[IPD] Buffer allocation failed for %d byte(s)\r\n", (int)len);
                         } else {
@@ -1051,6 +2584,7 @@ gsmi_process(const void* data, size_t data_len) {
                                 "[IPD] Connection %d closed or in closing, skipping %d byte(s)\r\n",
                                 (int)gsm.ipd.conn->num, (int)len);
                         }
+#endif /* !GSM_CFG_IPD_ZERO_COPY */
                         gsm.ipd.conn->status.f.data_received = 1;   /* We have first received data */
 
                         gsm.ipd.buff_ptr = 0;   /* Reset buffer write pointer */
@@ -1062,28 +2596,39 @@ gsmi_process(const void* data, size_t data_len) {
                      *
                      * Check if any command active which may expect that kind of rgsmonse
                      */
-                    if (ch_prev2 == '\n' && ch_prev1 == '>' && ch == ' ') {
+                    if (gsm.recv_ch_prev2 == '\n' && gsm.recv_ch_prev1 == '>' && ch == ' ') {
                         if (0) {
 #if GSM_CFG_CONN
                         } else if (CMD_IS_CUR(GSM_CMD_CIPSEND)) {
                             RECV_RESET();       /* Reset received object */
 
                             /* Now actually send the data prepared before */
-                            GSM_AT_PORT_SEND(&gsm.msg->msg.conn_send.data[gsm.msg->msg.conn_send.ptr], gsm.msg->msg.conn_send.sent);
+                            gsmi_tcpip_send_packet_data();
+                            gsm.msg->msg.conn_send.send_time = gsm_sys_now();
                             gsm.msg->msg.conn_send.wait_send_ok_err = 1;    /* Now we are waiting for "SEND OK" or "SEND ERROR" */
+#if GSM_CFG_CONN_SSL
+                        } else if (CMD_IS_CUR(GSM_CMD_FSWRITE)) {
+                            RECV_RESET();       /* Reset received object */
+                            GSM_AT_PORT_SEND(gsm.msg->msg.ssl_cert.data, gsm.msg->msg.ssl_cert.len);
+#endif /* GSM_CFG_CONN_SSL */
 #endif /* GSM_CFG_CONN */
 #if GSM_CFG_SMS
                         } else if (CMD_IS_CUR(GSM_CMD_CMGS)) {  /* Send SMS? */
-                            GSM_AT_PORT_SEND(gsm.msg->msg.sms_send.text, strlen(gsm.msg->msg.sms_send.text));
+#if GSM_CFG_SMS_PDU
+                            if (!gsm.msg->msg.sms_send.format) {
+                                gsmi_sms_pdu_send(gsm.msg->msg.sms_send.rcpts[gsm.msg->msg.sms_send.ri].num,
+                                    gsm.msg->msg.sms_send.text, gsm.msg->msg.sms_send.part_start,
+                                    gsm.msg->msg.sms_send.part_end, gsm.msg->msg.sms_send.enc,
+                                    gsm.msg->msg.sms_send.part_units, gsm.msg->msg.sms_send.ref,
+                                    GSM_U8(gsm.msg->msg.sms_send.parts), GSM_U8(gsm.msg->msg.sms_send.part + 1));
+                            } else
+#endif /* GSM_CFG_SMS_PDU */
+                            {
+                                GSM_AT_PORT_SEND(gsm.msg->msg.sms_send.text, strlen(gsm.msg->msg.sms_send.text));
+                            }
                             GSM_AT_PORT_SEND_CTRL_Z();
 #endif /* GSM_CFG_SMS */
                         }
-                    } else if (CMD_IS_CUR(GSM_CMD_COPS_GET_OPT)) {
-                        if (RECV_LEN() > 5 && !strncmp(recv_buff.data, "+COPS:", 5)) {
-                            RECV_RESET();       /* Reset incoming buffer */
-                            gsmi_parse_cops_scan(0, 1); /* Reset parser state */
-                            gsm.msg->msg.cops_scan.read = 1;    /* Start reading incoming bytes */
-                        }
                     }
                 } else {                        /* We have sequence of unicode characters */
                     /*
@@ -1091,8 +2636,8 @@ gsmi_process(const void* data, size_t data_len) {
                      * so it is safe to just add them to receive array without checking
                      * what are the actual values
                      */
-                    for (uint8_t i = 0; i < unicode.t; i++) {
-                        RECV_ADD(unicode.ch[i]);/* Add character to receive array */
+                    for (uint8_t i = 0; i < gsm.recv_unicode.t; i++) {
+                        gsmi_recv_add(gsm.recv_unicode.ch[i]);  /* Add character to receive array */
                     }
                 }
             } else if (res != gsmINPROG) {      /* Not in progress? */
@@ -1100,12 +2645,235 @@ gsmi_process(const void* data, size_t data_len) {
             }
         }
         
-        ch_prev2 = ch_prev1;                    /* Save previous character to previous previous */
-        ch_prev1 = ch;                          /* Char current to previous */
+        gsm.recv_ch_prev2 = gsm.recv_ch_prev1;  /* Save previous character to previous previous */
+        gsm.recv_ch_prev1 = ch;                 /* Char current to previous */
+#if GSM_CFG_CONN && GSM_CFG_IPD_ZERO_COPY
+        if (gsm.ipd.hold != NULL) {             /* Stop when receive buffer memory is held */
+            break;
+        }
+#endif /* GSM_CFG_CONN && GSM_CFG_IPD_ZERO_COPY */
     }
     return gsmOK;
 }
 
+#if GSM_CFG_CONN || __DOXYGEN__
+
+/**
+ * \brief           Get command to start connection with, after connection states are known
+ * \param[in]       msg: Connection start message
+ * \return          Command to continue with
+ */
+static gsm_cmd_t
+gsmi_conn_start_first_cmd(gsm_msg_t* msg) {
+#if GSM_CFG_DNS_CACHE
+    if (gsmi_dns_cache_get(msg->msg.conn_start.host, &msg->msg.conn_start.ip)) {
+        msg->msg.conn_start.ip_valid = 1;       /* Skip DNS lookup on device */
+    } else if (gsmi_dns_cache_is_cacheable(msg->msg.conn_start.host)) {
+        return GSM_CMD_CDNSGIP;                 /* Resolve host name before connection is started */
+    }
+#endif /* GSM_CFG_DNS_CACHE */
+#if GSM_CFG_CONN_SSL
+    if (gsm.conn_ssl != (msg->msg.conn_start.type == GSM_CONN_TYPE_SSL)) {
+        return GSM_CMD_CIPSSL;                  /* Switch device TLS mode before connection is started */
+    }
+#endif /* GSM_CFG_CONN_SSL */
+    GSM_UNUSED(msg);
+    return GSM_CMD_CIPSTART;
+}
+
+/**
+ * \brief           Notify application about result of connection start command
+ * \param[in]       msg: Connection start message
+ * \param[in,out]   is_ok: Pointer to current ok status
+ * \param[in,out]   is_error: Pointer to current error status
+ */
+static void
+gsmi_conn_start_finish(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
+    switch (msg->msg.conn_start.conn_res) {
+        case GSM_CONN_CONNECT_OK: {             /* Successfully connected */
+            gsm_conn_t* conn = &gsm.conns[msg->msg.conn_start.num]; /* Get connection number */
+
+            gsm.evt.type = GSM_EVT_CONN_ACTIVE; /* Connection just active */
+            gsm.evt.evt.conn_active_closed.client = 1;
+            gsm.evt.evt.conn_active_closed.conn = conn;
+            gsm.evt.evt.conn_active_closed.forced = 1;
+            gsmi_send_conn_cb(conn, NULL);
+            break;
+        }
+        case GSM_CONN_CONNECT_ERROR: {          /* Connection error */
+            gsmi_send_conn_error_cb(msg, gsmERRCONNFAIL);
+            *is_error = 1;                      /* Manually set error */
+            *is_ok = 0;                         /* Reset success */
+            break;
+        }
+        default: {
+            /* Do nothing as of now */
+            break;
+        }
+    }
+}
+
+#endif /* GSM_CFG_CONN || __DOXYGEN__ */
+
+#if GSM_CFG_AT_PORT_BAUDRATE_AUTO || __DOXYGEN__
+static const uint32_t baud_list[] = { GSM_CFG_AT_PORT_BAUDRATE_LIST };  /*!< Escalation candidates */
+#endif /* GSM_CFG_AT_PORT_BAUDRATE_AUTO || __DOXYGEN__ */
+
+/**
+ * \brief           Reconfigure host side of AT port
+ * \param[in]       baud: New baudrate in units of bits per second
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+gsmi_baud_apply(uint32_t baud) {
+    gsm.ll.uart.baudrate = baud;
+    return gsm_ll_init(&gsm.ll);
+}
+
+/**
+ * \brief           Timeout callback for sync command after baudrate change
+ * \param[in]       arg: Message sync command belongs to
+ */
+static void
+gsmi_baud_sync_timeout_fn(void* arg) {
+    if (gsm.msg != NULL && gsm.msg == arg && CMD_IS_CUR(GSM_CMD_AT_SYNC)) {
+        gsmi_process_cmd_result(0, 1);          /* No response on current baudrate */
+    }
+}
+
+/**
+ * \brief           Report final AT port baudrate to user
+ */
+static void
+gsmi_baud_report(void) {
+    gsm.evt.evt.at_baudrate.baudrate = gsm.ll.uart.baudrate;
+    gsm.evt.evt.at_baudrate.res = gsm.baud.res;
+    gsmi_send_cb(GSM_EVT_AT_BAUDRATE);
+}
+
+/**
+ * \brief           Process result of baudrate change or sync command
+ *
+ * After device accepts new baudrate, host port is reconfigured and link verified.
+ * If verification fails, previous baudrate is restored and verified again.
+ * Result is written to `gsm.baud.res`
+ *
+ * \param[in]       is_ok: Set to `1` if last command finished with success
+ * \return          Next command to execute or \ref GSM_CMD_IDLE when change has finished
+ */
+static gsm_cmd_t
+gsmi_baud_process(uint8_t is_ok) {
+    if (!CMD_IS_CUR(GSM_CMD_AT_SYNC)) {         /* Response on baudrate change request */
+        if (!is_ok) {
+            gsm.baud.res = gsmERR;              /* Device does not support baudrate */
+            return GSM_CMD_IDLE;
+        }
+        gsm.baud.prev = gsm.ll.uart.baudrate;
+        gsm.baud.revert = 0;
+        if (gsmi_baud_apply(gsm.baud.target) != gsmOK) {
+            gsm.baud.revert = 1;                /* Host cannot use it, try to stay on previous */
+            gsmi_baud_apply(gsm.baud.prev);
+        }
+        return GSM_CMD_AT_SYNC;
+    }
+    gsm_timeout_stop(gsm.baud.sync_timeout);
+    if (is_ok) {
+        gsm.baud.res = gsm.baud.revert ? gsmERR : gsmOK;
+        return GSM_CMD_IDLE;
+    }
+    if (!gsm.baud.revert) {                     /* No response on new baudrate */
+        gsm.baud.revert = 1;
+        gsmi_baud_apply(gsm.baud.prev);
+        return GSM_CMD_AT_SYNC;
+    }
+    gsm.baud.res = gsmERRNODEVICE;              /* Device lost on both baudrates */
+    return GSM_CMD_IDLE;
+}
+
+#if GSM_CFG_AT_PORT_BAUDRATE_AUTO || __DOXYGEN__
+
+/**
+ * \brief           Get next command in reset sequence during baudrate escalation
+ *
+ * Candidates not higher than current baudrate are skipped.
+ * When list is exhausted or sync has finished, final baudrate is reported
+ *
+ * \return          Next command to execute
+ */
+static gsm_cmd_t
+gsmi_baud_escalate_next(void) {
+    if (gsm.baud.res != gsmOK && gsm.baud.res != gsmERRNODEVICE) {
+        for (; gsm.baud.idx < GSM_ARRAYSIZE(baud_list); ++gsm.baud.idx) {
+            if (baud_list[gsm.baud.idx] > gsm.ll.uart.baudrate) {
+                gsm.baud.target = baud_list[gsm.baud.idx++];
+                return GSM_CMD_IPR;
+            }
+        }
+    }
+    gsmi_baud_report();
+    return GSM_CMD_CGMI_GET;
+}
+
+#endif /* GSM_CFG_AT_PORT_BAUDRATE_AUTO || __DOXYGEN__ */
+
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+
+/**
+ * \brief           Copy string to fixed size buffer
+ * \param[out]      dst: Destination buffer
+ * \param[in]       dst_len: Size of destination buffer in units of bytes
+ * \param[in]       src: Source string. Set to `NULL` for empty string
+ * \return          `1` on success, `0` if string does not fit to buffer
+ */
+static uint8_t
+gsmi_reattach_copy_str(char* dst, size_t dst_len, const char* src) {
+    size_t len = src != NULL ? strlen(src) : 0;
+
+    if (len >= dst_len) {
+        return 0;
+    }
+    if (len > 0) {
+        GSM_MEMCPY(dst, src, len);
+    }
+    dst[len] = 0;
+    return 1;
+}
+
+/**
+ * \brief           Save credentials of successful network attach for later reattach
+ * \param[in]       msg: Network attach message
+ */
+static void
+gsmi_reattach_save(gsm_msg_t* msg) {
+    gsm.reattach.valid = gsmi_reattach_copy_str(gsm.reattach.apn, sizeof(gsm.reattach.apn), msg->msg.network_attach.apn)
+        && gsmi_reattach_copy_str(gsm.reattach.user, sizeof(gsm.reattach.user), msg->msg.network_attach.user)
+        && gsmi_reattach_copy_str(gsm.reattach.pass, sizeof(gsm.reattach.pass), msg->msg.network_attach.pass);
+}
+
+/**
+ * \brief           Finish network reattach and reopen connections closed by PDP deactivation
+ *
+ * When connection cannot be reopened, owner gets \ref GSM_EVT_CONN_CLOSED event instead
+ */
+static void
+gsmi_reattach_finish(void) {
+    gsm.reattach.active = 0;
+#if GSM_CFG_CONN
+    for (size_t i = 0; i < GSM_CFG_MAX_CONNS; i++) {
+        gsm_conn_t* c = &gsm.conns[i];
+
+        if (c->resume.pending) {
+            c->resume.pending = 0;
+            if (!gsm.network.is_attached || gsmi_conn_resume(c) != gsmOK) {
+                gsmi_conn_closed_process(GSM_U8(i), 0); /* Report connection closed as without reattach */
+            }
+        }
+    }
+#endif /* GSM_CFG_CONN */
+}
+
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+
 /* Temporary macros, only available for inside gsmi_process_sub_cmd function */
 /* Set new command, but first check for error on previous */
 #define SET_NEW_CMD_CHECK_ERROR(new_cmd) do {   \
@@ -1129,6 +2897,39 @@ gsmi_process(const void* data, size_t data_len) {
 static gsmr_t
 gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
     gsm_cmd_t n_cmd = GSM_CMD_IDLE;
+#if GSM_CFG_SMS
+    if (CMD_IS_CUR(GSM_CMD_CPMS_SET) && *is_ok) {
+        gsmi_sms_mem_selected(msg);             /* Track active memory */
+    }
+#endif /* GSM_CFG_SMS */
+#if GSM_CFG_SLEEP
+    if (CMD_IS_CUR(GSM_CMD_CSCLK_SET) && *is_ok) {
+        gsm.sleep.mode = msg->msg.sleep.mode;   /* Device accepted new sleep mode */
+        gsm.sleep.idle_time = msg->msg.sleep.idle_time;
+    } else if (CMD_IS_CUR(GSM_CMD_RESET)) {
+        gsm.sleep.mode = 0;                     /* Device restarts with sleep mode disabled */
+    }
+#endif /* GSM_CFG_SLEEP */
+#if GSM_CFG_CONN_SSL
+    if (CMD_IS_CUR(GSM_CMD_RESET)) {
+        gsm.conn_ssl = 0;                       /* Device restarts without TLS */
+    }
+#endif /* GSM_CFG_CONN_SSL */
+#if GSM_CFG_CONN
+    if (CMD_IS_CUR(GSM_CMD_RESET)) {
+        gsm.conns_status_valid = 0;             /* Device restarts, connection states are unknown */
+    } else if (CMD_IS_CUR(GSM_CMD_CIPSTATUS) && *is_ok) {
+        gsm.conns_status_valid = 1;             /* All connection lines have been parsed */
+    } else if (CMD_IS_CUR(GSM_CMD_CIPSHUT) && *is_ok) {
+        gsmi_conn_closed_all();                 /* Device closed all connections */
+        gsm.conns_status_valid = 1;
+    }
+#endif /* GSM_CFG_CONN */
+#if GSM_CFG_OPERATOR_SCAN_CACHE_LEN
+    if (CMD_IS_CUR(GSM_CMD_COPS_GET_OPT) && *is_ok) {
+        gsmi_value_age_update(&gsm.network.scan_cache_age); /* Scan finished, cache is complete */
+    }
+#endif /* GSM_CFG_OPERATOR_SCAN_CACHE_LEN */
     if (CMD_IS_DEF(GSM_CMD_RESET)) {
         switch (CMD_GET_CUR()) {                /* Check current command */
             case GSM_CMD_RESET: {
@@ -1139,7 +2940,24 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
             case GSM_CMD_ATE0:
             case GSM_CMD_ATE1:      SET_NEW_CMD(GSM_CMD_CFUN_SET); break;   /* Set full functionality */
             case GSM_CMD_CFUN_SET:  SET_NEW_CMD(GSM_CMD_CMEE_SET); break;   /* Set detailed error reporting */
+#if GSM_CFG_AT_PORT_BAUDRATE_AUTO
+            case GSM_CMD_CMEE_SET: {            /* Start baudrate escalation */
+                gsm.baud.idx = 0;
+                gsm.baud.res = gsmERR;
+                SET_NEW_CMD(gsmi_baud_escalate_next());
+                break;
+            }
+            case GSM_CMD_IPR:
+            case GSM_CMD_AT_SYNC: {
+                n_cmd = gsmi_baud_process(*is_ok);
+                if (n_cmd == GSM_CMD_IDLE) {    /* Candidate finished, try next or continue reset */
+                    SET_NEW_CMD(gsmi_baud_escalate_next());
+                }
+                break;
+            }
+#else /* GSM_CFG_AT_PORT_BAUDRATE_AUTO */
             case GSM_CMD_CMEE_SET:  SET_NEW_CMD(GSM_CMD_CGMI_GET); break;   /* Get manufacturer */
+#endif /* !GSM_CFG_AT_PORT_BAUDRATE_AUTO */
             case GSM_CMD_CGMI_GET:  SET_NEW_CMD(GSM_CMD_CGMM_GET); break;   /* Get model */
             case GSM_CMD_CGMM_GET:  SET_NEW_CMD(GSM_CMD_CGSN_GET); break;   /* Get product serial number */
             case GSM_CMD_CGSN_GET: {
@@ -1153,11 +2971,65 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
                 SET_NEW_CMD(GSM_CMD_CREG_SET);      /* Enable unsolicited code for CREG */
                 break;
             }
+#if GSM_CFG_NETWORK_URC
+            case GSM_CMD_CREG_SET: SET_NEW_CMD(GSM_CMD_AUTOCSQ_SET); break; /* Enable signal strength reports */
+            case GSM_CMD_AUTOCSQ_SET: SET_NEW_CMD(GSM_CMD_CLCC_SET); break; /* Set call state */
+#else /* GSM_CFG_NETWORK_URC */
             case GSM_CMD_CREG_SET: SET_NEW_CMD(GSM_CMD_CLCC_SET); break;/* Set call state */
+#endif /* !GSM_CFG_NETWORK_URC */
             case GSM_CMD_CLCC_SET: SET_NEW_CMD(GSM_CMD_CPIN_GET); break;/* Get SIM state */
             case GSM_CMD_CPIN_GET: break;
             default: break;
         }
+#if GSM_CFG_WARM_START
+    } else if (CMD_IS_DEF(GSM_CMD_WARM_START)) {
+        switch (CMD_GET_CUR()) {
+            case GSM_CMD_AT_SYNC: {
+                gsm_timeout_stop(gsm.baud.sync_timeout);
+                if (*is_ok && !gsm.warm.echo) { /* Device kept configuration, identity is already restored */
+                    gsmi_send_cb(GSM_EVT_DEVICE_IDENTIFIED);
+                    SET_NEW_CMD(GSM_CMD_CPIN_GET);  /* Get SIM state */
+                } else {                        /* Fallback to full reset sequence */
+                    if (gsm.ll.uart.baudrate != GSM_CFG_AT_PORT_BAUDRATE) {
+                        gsmi_baud_apply(GSM_CFG_AT_PORT_BAUDRATE);  /* Device may be back on default baudrate */
+                    }
+                    msg->cmd_def = GSM_CMD_RESET;
+                    msg->msg.reset.delay = 0;
+                    SET_NEW_CMD(GSM_CMD_RESET);
+                    gsmi_warm_release(GSM_WARM_HOLD_SEQ);
+                }
+                break;
+            }
+            case GSM_CMD_CPIN_GET: {
+                gsmi_warm_release(GSM_WARM_HOLD_SEQ);
+                break;
+            }
+            default: break;
+        }
+#endif /* GSM_CFG_WARM_START */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+    } else if (CMD_IS_DEF(GSM_CMD_CIPRXGET)) {
+        gsm_conn_p c = msg->msg.ciprxget.conn;
+        c->status.f.rx_reading = 0;
+        if (!*is_ok) {
+            c->status.f.rx_pending = 0;         /* Wait for new notification from device */
+        }
+        gsmi_conn_manual_tcp_try_read_data(c);  /* Continue if device has more data */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+#if GSM_CFG_CONN
+    } else if (CMD_IS_DEF(GSM_CMD_CIPSERVER)) {
+        if (*is_ok) {                           /* Use callback only when device accepted configuration */
+            gsm.evt_server = msg->msg.tcpip_server.en ? msg->msg.tcpip_server.cb : NULL;
+            gsm.server_port = msg->msg.tcpip_server.port;
+        }
+#endif /* GSM_CFG_CONN */
+    } else if (CMD_IS_DEF(GSM_CMD_UART)) {
+        n_cmd = gsmi_baud_process(*is_ok);
+        if (n_cmd == GSM_CMD_IDLE) {            /* Baudrate change finished */
+            *is_ok = gsm.baud.res == gsmOK;
+            *is_error = !*is_ok;
+            gsmi_baud_report();
+        }
     } else if (CMD_IS_DEF(GSM_CMD_COPS_GET)) {
         if (CMD_IS_CUR(GSM_CMD_COPS_GET)) {
             gsm.evt.evt.operator_current.operator_current = &gsm.network.curr_operator;
@@ -1178,7 +3050,22 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
         }    
     } else if (CMD_IS_DEF(GSM_CMD_CMGS)) {      /* Send SMS default command */
         if (CMD_IS_CUR(GSM_CMD_CMGF) && *is_ok) {   /* Set message format current command*/
+#if GSM_CFG_SMS_PDU
+            msg->msg.sms_send.ref = ++gsm.sms.pdu_ref;  /* New reference for concatenated messages */
+#endif /* GSM_CFG_SMS_PDU */
             SET_NEW_CMD(GSM_CMD_CMGS);          /* Now send actual message */
+#if GSM_CFG_SMS_PDU
+        } else if (CMD_IS_CUR(GSM_CMD_CMGS) && !msg->msg.sms_send.format) {
+            if (gsmi_sms_batch_next(msg, *is_ok)) {
+                SET_NEW_CMD(GSM_CMD_CMGS);      /* Next part or recipient */
+            } else {
+                *is_ok = msg->msg.sms_send.sent == msg->msg.sms_send.rcpts_len;
+                gsm.evt.evt.sms_send_batch.rcpts = msg->msg.sms_send.rcpts;
+                gsm.evt.evt.sms_send_batch.count = msg->msg.sms_send.rcpts_len;
+                gsm.evt.evt.sms_send_batch.sent = msg->msg.sms_send.sent;
+                gsmi_send_cb(GSM_EVT_SMS_SEND_BATCH);
+            }
+#endif /* GSM_CFG_SMS_PDU */
         }
     } else if (CMD_IS_DEF(GSM_CMD_CMGR)) {      /* Read SMS message */
         if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && *is_ok) {
@@ -1203,12 +3090,17 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
             SET_NEW_CMD(GSM_CMD_CMGF);          /* Set text format */
         } else if (CMD_IS_CUR(GSM_CMD_CMGF) && *is_ok) {
             SET_NEW_CMD(GSM_CMD_CMGL);          /* List messages */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGL)) {
-            gsm.evt.evt.sms_list.mem = gsm.sms.mem[0].current;
-            gsm.evt.evt.sms_list.entries = gsm.msg->msg.sms_list.entries;
-            gsm.evt.evt.sms_list.size = gsm.msg->msg.sms_list.ei;
-            gsm.evt.evt.sms_list.err = *is_ok ? gsmOK : gsmERR;
-            gsmi_send_cb(GSM_EVT_SMS_LIST);
+        } else if (CMD_IS_CUR(GSM_CMD_CMGL) || CMD_IS_CUR(GSM_CMD_CMGD)) {
+            if (CMD_IS_CUR(GSM_CMD_CMGL)) {
+                gsm.evt.evt.sms_list.mem = gsm.sms.mem[0].current;
+                gsm.evt.evt.sms_list.entries = gsm.msg->msg.sms_list.entries;
+                gsm.evt.evt.sms_list.size = gsm.msg->msg.sms_list.ei;
+                gsm.evt.evt.sms_list.err = *is_ok ? gsmOK : gsmERR;
+                gsmi_send_cb(GSM_EVT_SMS_LIST);
+            }
+            if (*is_ok && gsmi_sms_list_next_delete()) {
+                SET_NEW_CMD(GSM_CMD_CMGD);      /* Delete entries marked by callback */
+            }
         }
     } else if (CMD_IS_DEF(GSM_CMD_CPMS_SET)) {  /* Set preferred memory */
         if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && *is_ok) {
@@ -1258,6 +3150,10 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
             SET_NEW_CMD(GSM_CMD_CPBS_SET);      /* Set current memory */
         } else if (CMD_IS_CUR(GSM_CMD_CPBS_SET) && *is_ok) {
             SET_NEW_CMD(GSM_CMD_CPBW_SET);      /* Write entry to phonebook */
+#if GSM_CFG_PHONEBOOK_CACHE
+        } else if (CMD_IS_CUR(GSM_CMD_CPBW_SET) && *is_ok) {
+            gsmi_pb_cache_write(msg);           /* Keep local cache coherent */
+#endif /* GSM_CFG_PHONEBOOK_CACHE */
         }
     } else if (CMD_IS_DEF(GSM_CMD_CPBR)) {
         if (CMD_IS_CUR(GSM_CMD_CPBS_GET) && *is_ok) {/* Get current memory */
@@ -1265,6 +3161,11 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
         } else if (CMD_IS_CUR(GSM_CMD_CPBS_SET) && *is_ok) {
             SET_NEW_CMD(GSM_CMD_CPBR);          /* Read entries */
         } else if (CMD_IS_CUR(GSM_CMD_CPBR)) {
+#if GSM_CFG_PHONEBOOK_CACHE
+            if (msg->msg.pb_list.cache) {
+                gsmi_pb_cache_loaded(msg, *is_ok);  /* Build cache indexes */
+            }
+#endif /* GSM_CFG_PHONEBOOK_CACHE */
             gsm.evt.evt.pb_list.mem = gsm.pb.mem.current;
             gsm.evt.evt.pb_list.entries = gsm.msg->msg.pb_list.entries;
             gsm.evt.evt.pb_list.size = gsm.msg->msg.pb_list.ei;
@@ -1287,6 +3188,11 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
 #endif /* GSM_CFG_PHONEBOOK */
 #if GSM_CFG_NETWORK
     } if (CMD_IS_DEF(GSM_CMD_NETWORK_ATTACH)) {
+#if GSM_CFG_CONN_TRANSPARENT
+        if (CMD_IS_CUR(GSM_CMD_CIPMODE_SET)) {
+            gsm.transp.active = *is_ok ? gsm.transp.req : 0;    /* Application mode is now known */
+        }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
         switch (msg->i) {
             case 0: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CGACT_SET_0); break;
             case 1: SET_NEW_CMD(GSM_CMD_CGACT_SET_1); break;
@@ -1294,64 +3200,238 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
             case 3: SET_NEW_CMD(GSM_CMD_CGATT_SET_1); break;
             case 4: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPSHUT); break;
             case 5: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPMUX_SET); break;
-            case 6: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPRXGET_SET); break;
-            case 7: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CSTT_SET); break;
-            case 8: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIICR); break;
-            case 9: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIFSR); break;
-            case 10: SET_NEW_CMD(GSM_CMD_CIPSTATUS); break;
+            case 6: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPMODE_SET); break;
+            case 7: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPRXGET_SET); break;
+#if GSM_CFG_CONN_QUICK_SEND
+            case 8: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPQSEND_SET); break;
+#else /* GSM_CFG_CONN_QUICK_SEND */
+            case 8: msg->i++; SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPSRIP); break;  /* Device default send mode is used, skip step */
+#endif /* !GSM_CFG_CONN_QUICK_SEND */
+            case 9: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPSRIP); break;
+            case 10: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CSTT_SET); break;
+            case 11: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIICR); break;
+            case 12: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIFSR); break;
+            default: break;
+        }
+        if (n_cmd == GSM_CMD_IDLE) {
+            gsmi_network_set_attached(*is_ok);  /* Device has IP address only if all steps succeeded */
+        }
+#if GSM_CFG_NETWORK_REATTACH
+        if (n_cmd == GSM_CMD_IDLE && *is_ok) {
+            gsmi_reattach_save(msg);            /* Credentials are known to work */
+        }
+    } else if (CMD_IS_DEF(GSM_CMD_NETWORK_REATTACH)) {
+        switch (CMD_GET_CUR()) {
+            case GSM_CMD_CIPSHUT: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CSTT_SET); break;
+            case GSM_CMD_CSTT_SET: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIICR); break;
+            case GSM_CMD_CIICR: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIFSR); break;
+            case GSM_CMD_CIFSR: {
+                if (*is_ok) {
+                    gsmi_network_set_attached(1);   /* Notify application */
+                }
+                break;
+            }
             default: break;
         }
+        if (n_cmd == GSM_CMD_IDLE) {
+            gsmi_reattach_finish();
+        }
+#endif /* GSM_CFG_NETWORK_REATTACH */
     } else if (CMD_IS_DEF(GSM_CMD_NETWORK_DETACH)) {
         switch (msg->i) {
             case 0: SET_NEW_CMD(GSM_CMD_CGATT_SET_0); break;
             case 1: SET_NEW_CMD(GSM_CMD_CGACT_SET_0); break;
-#if GSM_CFG_CONN
-            case 2: SET_NEW_CMD(GSM_CMD_CIPSTATUS); break;
-#endif /* GSM_CFG_CONN */
             default: break;
         }
         if (!n_cmd) {
             *is_ok = 1;
+#if GSM_CFG_CONN
+            gsmi_conn_closed_all();             /* PDP context is deactivated, device closed all connections */
+#endif /* GSM_CFG_CONN */
+            gsmi_network_set_attached(0);
         }
 #endif /* GSM_CFG_NETWORK */
+#if GSM_CFG_CMUX
+    } else if (CMD_IS_DEF(GSM_CMD_CMUX_SET)) {
+        if (CMD_IS_CUR(GSM_CMD_CMUX_SET) && *is_ok) {
+            gsmi_cmux_activate();               /* Device expects frames from now on */
+            msg->msg.cmux.dlci = 0;
+            SET_NEW_CMD(GSM_CMD_CMUX_SABM);     /* Open control channel */
+        } else if (CMD_IS_CUR(GSM_CMD_CMUX_SABM) && *is_ok && msg->msg.cmux.dlci == 0) {
+            msg->msg.cmux.dlci = GSM_CFG_CMUX_AT_DLCI;
+            SET_NEW_CMD(GSM_CMD_CMUX_SABM);     /* Open AT command channel */
+#if GSM_CFG_CONN_TRANSPARENT
+        } else if (CMD_IS_CUR(GSM_CMD_CMUX_SABM) && *is_ok && msg->msg.cmux.dlci == GSM_CFG_CMUX_AT_DLCI) {
+            msg->msg.cmux.dlci = GSM_CFG_CMUX_DATA_DLCI;
+            SET_NEW_CMD(GSM_CMD_CMUX_SABM);     /* Open transparent connection channel */
+        } else if (CMD_IS_CUR(GSM_CMD_CMUX_SABM) && msg->msg.cmux.dlci == GSM_CFG_CMUX_DATA_DLCI) {
+            *is_ok = 1;                         /* Without own channel, connection shares AT command channel */
+            *is_error = 0;
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+        }
+#endif /* GSM_CFG_CMUX */
 #if GSM_CFG_CONN
     } else if (CMD_IS_DEF(GSM_CMD_CIPSTART)) {
         if (msg->i == 0 && CMD_IS_CUR(GSM_CMD_CIPSTATUS)) { /* Was the current command status info? */
             if (*is_ok) {
-                SET_NEW_CMD(GSM_CMD_CIPSTART);  /* Now actually start connection */
+                SET_NEW_CMD(gsmi_conn_start_first_cmd(msg));    /* Now actually start connection */
+            }
+#if GSM_CFG_DNS_CACHE
+        } else if (CMD_IS_CUR(GSM_CMD_CDNSGIP)) {
+            if (*is_ok) {
+                gsmi_dns_cache_put(msg->msg.conn_start.host, &msg->msg.conn_start.ip);
+                msg->msg.conn_start.ip_valid = 1;
+            }
+            SET_NEW_CMD(GSM_CMD_CIPSTART);      /* On failure, device resolves host name itself */
+#endif /* GSM_CFG_DNS_CACHE */
+#if GSM_CFG_CONN_SSL
+        } else if (CMD_IS_CUR(GSM_CMD_CIPSSL)) {
+            if (*is_ok) {
+                gsm.conn_ssl = GSM_U8(msg->msg.conn_start.type == GSM_CONN_TYPE_SSL);
+                SET_NEW_CMD(GSM_CMD_CIPSTART);
+            } else {
+                msg->msg.conn_start.conn_res = GSM_CONN_CONNECT_ERROR;
+                gsmi_conn_start_finish(msg, is_ok, is_error);
             }
-        } else if (msg->i == 1 && CMD_IS_CUR(GSM_CMD_CIPSTART)) {
-            SET_NEW_CMD(GSM_CMD_CIPSTATUS);     /* Go to status mode */
+#endif /* GSM_CFG_CONN_SSL */
+        } else if (CMD_IS_CUR(GSM_CMD_CIPSTART)) {
             if (*is_error) {
                 msg->msg.conn_start.conn_res = GSM_CONN_CONNECT_ERROR;
+#if GSM_CFG_DNS_CACHE
+                if (msg->msg.conn_start.ip_valid) {
+                    gsmi_dns_cache_remove(msg->msg.conn_start.host);    /* Address may be stale */
+                }
+#endif /* GSM_CFG_DNS_CACHE */
             }
-        } else if (msg->i == 2 && CMD_IS_CUR(GSM_CMD_CIPSTATUS)) {
-            /* After second CIP status, define what to do next */
-            switch (msg->msg.conn_start.conn_res) {
-                case GSM_CONN_CONNECT_OK: {     /* Successfully connected */
-                    gsm_conn_t* conn = &gsm.conns[msg->msg.conn_start.num]; /* Get connection number */
-
-                    gsm.evt.type = GSM_EVT_CONN_ACTIVE; /* Connection just active */
-                    gsm.evt.evt.conn_active_closed.client = 1;
-                    gsm.evt.evt.conn_active_closed.conn = conn;
-                    gsm.evt.evt.conn_active_closed.forced = 1;
-                    gsmi_send_conn_cb(conn, NULL);
-                    gsmi_conn_start_timeout(conn);  /* Start connection timeout timer */
-                    break;
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.active) {            /* Device is in data mode, status cannot be queried */
+                gsmi_conn_start_finish(msg, is_ok, is_error);
+            } else
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+            if (gsm.conns_status_valid
+                && (msg->msg.conn_start.conn_res != GSM_CONN_CONNECT_OK
+                    || gsmi_conn_start_get_ip(msg, &gsm.conns[msg->msg.conn_start.num].remote_ip))) {
+                gsmi_conn_start_finish(msg, is_ok, is_error);   /* Result line has been tracked, no need for status */
+            } else {
+                SET_NEW_CMD(GSM_CMD_CIPSTATUS); /* Go to status mode */
+            }
+        } else if (msg->i > 0 && CMD_IS_CUR(GSM_CMD_CIPSTATUS)) {
+            gsmi_conn_start_finish(msg, is_ok, is_error);   /* After second CIP status, define what to do next */
+        }
+#if GSM_CFG_CONN_SSL
+        if (n_cmd == GSM_CMD_CIPSTART
+            && gsm.conn_ssl != (msg->msg.conn_start.type == GSM_CONN_TYPE_SSL)) {
+            SET_NEW_CMD(GSM_CMD_CIPSSL);        /* Switch device TLS mode before connection is started */
+        }
+    } else if (CMD_IS_DEF(GSM_CMD_SSLSETCERT)) {
+        if (CMD_IS_CUR(GSM_CMD_FSDEL)) {
+            SET_NEW_CMD(GSM_CMD_FSCREATE);      /* Error only means file did not exist */
+        } else if (CMD_IS_CUR(GSM_CMD_FSCREATE)) {
+            SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FSWRITE);
+        } else if (CMD_IS_CUR(GSM_CMD_FSWRITE)) {
+            SET_NEW_CMD_CHECK_ERROR(GSM_CMD_SSLSETCERT);
+        }
+#endif /* GSM_CFG_CONN_SSL */
+#if GSM_CFG_CONN_TRANSPARENT
+    } else if (CMD_IS_DEF(GSM_CMD_CIPCLOSE)) {
+        if (CMD_IS_CUR(GSM_CMD_TRANSP_ESCAPE)) {
+            SET_NEW_CMD_CHECK_ERROR(GSM_CMD_CIPCLOSE);  /* Device is in command mode, close connection */
+        }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+#endif /* GSM_CFG_CONN */
+#if GSM_CFG_HTTP || GSM_CFG_FTP
+    } else if (CMD_IS_DEF(GSM_CMD_BEARER_OPEN)) {
+        switch (msg->i) {
+            case 0: SET_NEW_CMD(GSM_CMD_SAPBR_SET); break;  /* Bearer may already be closed, ignore error */
+            case 1:
+            case 2:
+            case 3: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_SAPBR_SET); break;
+            case 4: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_SAPBR_OPEN); break;
+            default: break;
+        }
+#endif /* GSM_CFG_HTTP || GSM_CFG_FTP */
+#if GSM_CFG_HTTP
+    } else if (CMD_IS_DEF(GSM_CMD_HTTP_GET)) {
+        switch (CMD_GET_CUR()) {
+            case GSM_CMD_HTTPTERM: {
+                if (!msg->msg.http_get.done) {
+                    SET_NEW_CMD(GSM_CMD_HTTPINIT);  /* Previous session may not exist, ignore error */
                 }
-                case GSM_CONN_CONNECT_ERROR: {  /* Connection error */
-                    gsmi_send_conn_error_cb(msg, gsmERRCONNFAIL);
-                    *is_error = 1;              /* Manually set error */
-                    *is_ok = 0;                 /* Reset success */
-                    break;
+                break;
+            }
+            case GSM_CMD_HTTPINIT: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_HTTPPARA_CID); break;
+            case GSM_CMD_HTTPPARA_CID: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_HTTPPARA_URL); break;
+            case GSM_CMD_HTTPPARA_URL: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_HTTPSSL); break;
+            case GSM_CMD_HTTPSSL: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_HTTPACTION); break;
+            case GSM_CMD_HTTPACTION:
+            case GSM_CMD_HTTPREAD: {
+                if (*is_ok && gsmi_http_read_next(msg)) {
+                    SET_NEW_CMD(GSM_CMD_HTTPREAD);  /* Request next window of body */
                 }
-                default: {
-                    /* Do nothing as of now */
-                    break;
+                break;
+            }
+            default: break;
+        }
+        if (n_cmd == GSM_CMD_IDLE && !msg->msg.http_get.done) {
+            msg->msg.http_get.done = 1;
+            if (!*is_ok) {
+                msg->msg.http_get.err = 1;
+            }
+            if (!CMD_IS_CUR(GSM_CMD_HTTPINIT)) {
+                SET_NEW_CMD(GSM_CMD_HTTPTERM);  /* Release session on device */
+            }
+        }
+        if (msg->msg.http_get.done) {           /* Result is known before session is terminated */
+            *is_ok = !msg->msg.http_get.err;
+            *is_error = msg->msg.http_get.err;
+        }
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_FTP
+    } else if (CMD_IS_DEF(GSM_CMD_FTP_GET) || CMD_IS_DEF(GSM_CMD_FTP_PUT)) {
+        uint8_t put = CMD_IS_DEF(GSM_CMD_FTP_PUT);
+
+        switch (CMD_GET_CUR()) {
+            case GSM_CMD_FTPCID: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPSERV); break;
+            case GSM_CMD_FTPSERV: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPPORT); break;
+            case GSM_CMD_FTPPORT: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPUN); break;
+            case GSM_CMD_FTPUN: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPPW); break;
+            case GSM_CMD_FTPPW: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPTYPE); break;
+            case GSM_CMD_FTPTYPE: SET_NEW_CMD_CHECK_ERROR(put ? GSM_CMD_FTPPUTPATH : GSM_CMD_FTPGETPATH); break;
+            case GSM_CMD_FTPGETPATH: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPGETNAME); break;
+            case GSM_CMD_FTPGETNAME: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPGET_OPEN); break;
+            case GSM_CMD_FTPPUTPATH: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPPUTNAME); break;
+            case GSM_CMD_FTPPUTNAME: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPPUTOPT); break;
+            case GSM_CMD_FTPPUTOPT: SET_NEW_CMD_CHECK_ERROR(GSM_CMD_FTPPUT_OPEN); break;
+            case GSM_CMD_FTPGET_OPEN:
+            case GSM_CMD_FTPGET_READ:
+            case GSM_CMD_FTPPUT_OPEN:
+            case GSM_CMD_FTPPUT_WRITE: {
+                if (CMD_IS_CUR(GSM_CMD_FTPPUT_WRITE) && *is_ok) {
+                    gsmi_ftp_chunk_done(msg, msg->msg.ftp.len);
+                }
+                if (!*is_ok || msg->msg.ftp.err || msg->msg.ftp.finished) {
+                    break;                      /* Transfer is over */
+                } else if (msg->msg.ftp.stop) {
+                    SET_NEW_CMD(GSM_CMD_FTPQUIT);   /* Abort transfer on device */
+                } else if (put) {
+                    gsmi_ftp_put_next(msg);     /* Get next chunk from application */
+                    SET_NEW_CMD(GSM_CMD_FTPPUT_WRITE);
+                } else {
+                    SET_NEW_CMD(GSM_CMD_FTPGET_READ);   /* Keep reading while device has data */
                 }
+                break;
             }
+            default: break;
         }
-#endif /* GSM_CFG_CONN */
+        if (n_cmd == GSM_CMD_IDLE) {            /* Result of aborted transfer does not depend on quit command */
+            *is_ok = (*is_ok || CMD_IS_CUR(GSM_CMD_FTPQUIT)) && !msg->msg.ftp.err;
+            *is_error = !*is_ok;
+        }
+#endif /* GSM_CFG_FTP */
+#if GSM_CFG_PING
+    } else if (CMD_IS_DEF(GSM_CMD_CIPPING)) {
+        gsmi_ping_finish(msg, *is_ok);          /* Calculate statistics and notify monitor */
+#endif /* GSM_CFG_FTP */
     }
 
     /* Check if new command was set for execution */
@@ -1366,6 +3446,87 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
     return *is_ok ? gsmOK : gsmERR;
 }
 
+/**
+ * \brief           Command descriptor for commands without parameters
+ */
+typedef struct {
+    const char* str;                            /*!< Complete command line, including `AT` and `CR LF` */
+    uint8_t len;                                /*!< Length of command line in units of bytes */
+} gsmi_cmd_desc_t;
+
+#define GSM_CMD_DESC(cmd, str)              [cmd] = { "AT" str CRLF, sizeof("AT" str CRLF) - 1 }
+
+/**
+ * \brief           Constant command lines, indexed by \ref gsm_cmd_t
+ *
+ * Commands listed here are sent with single write to low-level driver.
+ * Commands with parameters or side effects are built in \ref gsmi_initiate_cmd.
+ * Expected response for each command is handled by response dispatch table
+ */
+static const gsmi_cmd_desc_t
+cmd_desc[GSM_CMD_END] = {
+    GSM_CMD_DESC(GSM_CMD_ATE0, "E0"),
+    GSM_CMD_DESC(GSM_CMD_ATE1, "E1"),
+    GSM_CMD_DESC(GSM_CMD_CMEE_SET, "+CMEE=1"),
+    GSM_CMD_DESC(GSM_CMD_CLCC_SET, "+CLCC=1"),
+    GSM_CMD_DESC(GSM_CMD_CGMI_GET, "+CGMI"),
+    GSM_CMD_DESC(GSM_CMD_CGMM_GET, "+CGMM"),
+    GSM_CMD_DESC(GSM_CMD_CGSN_GET, "+CGSN"),
+#if GSM_CFG_NETWORK_URC
+    GSM_CMD_DESC(GSM_CMD_CREG_SET, "+CREG=2"),  /* Include location info to report cell changes */
+    GSM_CMD_DESC(GSM_CMD_AUTOCSQ_SET, "+AUTOCSQ=1,1"),  /* Report signal strength on change */
+#else /* GSM_CFG_NETWORK_URC */
+    GSM_CMD_DESC(GSM_CMD_CREG_SET, "+CREG=1"),
+#endif /* !GSM_CFG_NETWORK_URC */
+    GSM_CMD_DESC(GSM_CMD_CREG_GET, "+CREG?"),
+    GSM_CMD_DESC(GSM_CMD_CPIN_GET, "+CPIN?"),
+    GSM_CMD_DESC(GSM_CMD_COPS_GET, "+COPS?"),
+    GSM_CMD_DESC(GSM_CMD_COPS_GET_OPT, "+COPS=?"),
+    GSM_CMD_DESC(GSM_CMD_CSQ_GET, "+CSQ"),
+    GSM_CMD_DESC(GSM_CMD_CNUM, "+CNUM"),
+    GSM_CMD_DESC(GSM_CMD_CIPSHUT, "+CIPSHUT"),
+#if GSM_CFG_CONN
+    GSM_CMD_DESC(GSM_CMD_CIPMUX, "+CIPMUX=1"),
+    GSM_CMD_DESC(GSM_CMD_CIPHEAD, "+CIPHEAD=1"),
+    GSM_CMD_DESC(GSM_CMD_CIPSTATUS, "+CIPSTATUS"),
+#endif /* GSM_CFG_CONN */
+#if GSM_CFG_SMS
+    GSM_CMD_DESC(GSM_CMD_CPMS_GET_OPT, "+CPMS=?"),
+    GSM_CMD_DESC(GSM_CMD_CPMS_GET, "+CPMS?"),
+#endif /* GSM_CFG_SMS */
+#if GSM_CFG_CALL
+    GSM_CMD_DESC(GSM_CMD_ATA, "A"),
+    GSM_CMD_DESC(GSM_CMD_ATH, "H"),
+#endif /* GSM_CFG_CALL */
+#if GSM_CFG_PHONEBOOK
+    GSM_CMD_DESC(GSM_CMD_CPBS_GET_OPT, "+CPBS=?"),
+    GSM_CMD_DESC(GSM_CMD_CPBS_GET, "+CPBS?"),
+#endif /* GSM_CFG_PHONEBOOK */
+#if GSM_CFG_NETWORK
+    GSM_CMD_DESC(GSM_CMD_CGACT_SET_0, "+CGACT=0"),
+    GSM_CMD_DESC(GSM_CMD_CGACT_SET_1, "+CGACT=1"),
+    GSM_CMD_DESC(GSM_CMD_CGATT_SET_0, "+CGATT=0"),
+    GSM_CMD_DESC(GSM_CMD_CGATT_SET_1, "+CGATT=1"),
+    GSM_CMD_DESC(GSM_CMD_CIICR, "+CIICR"),
+    GSM_CMD_DESC(GSM_CMD_CIFSR, "+CIFSR"),
+#endif /* GSM_CFG_NETWORK */
+#if GSM_CFG_HTTP || GSM_CFG_FTP
+    GSM_CMD_DESC(GSM_CMD_SAPBR_CLOSE, "+SAPBR=0,1"),
+    GSM_CMD_DESC(GSM_CMD_SAPBR_OPEN, "+SAPBR=1,1"),
+#endif /* GSM_CFG_HTTP || GSM_CFG_FTP */
+#if GSM_CFG_HTTP
+    GSM_CMD_DESC(GSM_CMD_HTTPINIT, "+HTTPINIT"),
+    GSM_CMD_DESC(GSM_CMD_HTTPPARA_CID, "+HTTPPARA=\"CID\",1"),
+    GSM_CMD_DESC(GSM_CMD_HTTPTERM, "+HTTPTERM"),
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_FTP
+    GSM_CMD_DESC(GSM_CMD_FTPCID, "+FTPCID=1"),
+    GSM_CMD_DESC(GSM_CMD_FTPTYPE, "+FTPTYPE=\"I\""),
+    GSM_CMD_DESC(GSM_CMD_FTPPUTOPT, "+FTPPUTOPT=\"STOR\""),
+    GSM_CMD_DESC(GSM_CMD_FTPQUIT, "+FTPQUIT"),
+#endif /* GSM_CFG_FTP */
+};
+
 /**
  * \brief           Function to initialize every AT command
  * \note            Never call this function directly. Set as initialization function for command and use `msg->fn(msg)`
@@ -1374,10 +3535,42 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t* is_ok, uint16_t* is_error) {
  */
 gsmr_t
 gsmi_initiate_cmd(gsm_msg_t* msg) {
-    switch (CMD_GET_CUR()) {                    /* Check current message we want to send over AT */
+    gsm_cmd_t cmd = CMD_GET_CUR();
+
+#if GSM_CFG_CONN_TRANSPARENT
+    /* Device does not process AT commands on channel in data mode */
+    if (gsm.transp.data_mode && !CMD_IS_CUR(GSM_CMD_TRANSP_ESCAPE)
+        && !CMD_IS_CUR(GSM_CMD_CIPSEND) && !CMD_IS_CUR(GSM_CMD_CIPCLOSE)
+#if GSM_CFG_CMUX
+        && (gsmi_transp_is_conn_cmd() || !gsmi_cmux_transp_separate())
+#endif /* GSM_CFG_CMUX */
+        ) {
+        return gsmERR;
+    }
+#if GSM_CFG_CMUX
+    gsmi_cmux_select_channel(gsmi_transp_is_conn_cmd());
+#endif /* GSM_CFG_CMUX */
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+#if GSM_CFG_CONN
+    if (CMD_IS_DEF(GSM_CMD_CIPSTART) && CMD_IS_CUR(GSM_CMD_CIPSTATUS)
+        && msg->msg.conn_start.conn_res == GSM_CONN_CONNECT_UNKNOWN && msg->i == 0
+        && gsm.conns_status_valid) {            /* Status before start, closed connections are already processed */
+        msg->cmd = gsmi_conn_start_first_cmd(msg);
+        cmd = msg->cmd;
+    }
+#endif /* GSM_CFG_CONN */
+    gsmi_recv_stream_set(cmd);                  /* Select handler for long response lines */
+    if (cmd < GSM_CMD_END && cmd_desc[cmd].str != NULL) {   /* Constant command line, send at once */
+        GSM_AT_PORT_SEND(cmd_desc[cmd].str, cmd_desc[cmd].len);
+        return gsmOK;
+    }
+    switch (cmd) {                    /* Check current message we want to send over AT */
         case GSM_CMD_RESET: {                   /* Reset modem with AT commands */
+#if GSM_CFG_CONN_TRANSPARENT
+            gsm.transp.active = 0;              /* Application mode is set again on network attach */
+#endif /* GSM_CFG_CONN_TRANSPARENT */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CFUN=1,1");  /* Second "1" means reset */
+            GSM_AT_PORT_SEND_CONST_STR("+CFUN=1,1");  /* Second "1" means reset */
             GSM_AT_PORT_SEND_END();
             break;
         }
@@ -1386,97 +3579,87 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_ATE0:
-        case GSM_CMD_ATE1: {
-            GSM_AT_PORT_SEND_BEGIN();
-            if (CMD_IS_CUR(GSM_CMD_ATE0)) {
-                GSM_AT_PORT_SEND_STR("E0");
-            } else {
-                GSM_AT_PORT_SEND_STR("E1");
+        case GSM_CMD_UART:
+        case GSM_CMD_IPR: {                     /* Set AT port baudrate */
+            if (CMD_IS_CUR(GSM_CMD_UART)) {
+                gsm.baud.target = msg->msg.uart.baudrate;
             }
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CMEE_SET: {                /* Enable detailed error messages */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CMEE=1");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CLCC_SET: {                /* Enable detailed call info */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CLCC=1");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CGMI_GET: {                /* Get manufacturer */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGMI");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CGMM_GET: {                /* Get model */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGMM");
+            GSM_AT_PORT_SEND_CONST_STR("+IPR=");
+            send_number(gsm.baud.target, 0, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CGSN_GET: {                /* Get serial number */
+        case GSM_CMD_AT_SYNC: {                 /* Verify link after baudrate change */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGSN");
             GSM_AT_PORT_SEND_END();
+            gsm_timeout_start(GSM_CFG_AT_PORT_BAUDRATE_SYNC_TIMEOUT, gsmi_baud_sync_timeout_fn, msg, &gsm.baud.sync_timeout);
             break;
         }
-        case GSM_CMD_CREG_SET: {                /* Enable +CREG message */
+        case GSM_CMD_CFUN_SET: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CREG=1");
+            GSM_AT_PORT_SEND_CONST_STR("+CFUN=");
+            /**
+             * \todo: If CFUN command forced, check value
+             */
+            if (CMD_IS_DEF(GSM_CMD_RESET)
+                || (CMD_IS_DEF(GSM_CMD_CFUN_SET) && msg->msg.cfun.mode)) {
+                GSM_AT_PORT_SEND_CONST_STR("1");
+            } else {
+                GSM_AT_PORT_SEND_CONST_STR("0");
+            }
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CREG_GET: {                /* Get network registration status */
+#if GSM_CFG_SLEEP
+        case GSM_CMD_CSCLK_SET: {               /* Set slow clock mode */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CREG?");
+            GSM_AT_PORT_SEND_CONST_STR("+CSCLK=");
+            send_number(GSM_U32(msg->msg.sleep.mode), 0, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CFUN_SET: {
+        case GSM_CMD_CPSMS_SET: {               /* Set power saving mode */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CFUN=");
-            /**
-             * \todo: If CFUN command forced, check value
-             */
-            if (CMD_IS_DEF(GSM_CMD_RESET)
-                || (CMD_IS_DEF(GSM_CMD_CFUN_SET) && msg->msg.cfun.mode)) {
-                GSM_AT_PORT_SEND_STR("1");
-            } else {
-                GSM_AT_PORT_SEND_STR("0");
+            GSM_AT_PORT_SEND_CONST_STR("+CPSMS=");
+            send_number(GSM_U32(msg->msg.psm.en), 0, 0);
+            if (msg->msg.psm.en) {
+                GSM_AT_PORT_SEND_CONST_STR(",,");   /* Skip legacy GPRS timers */
+                send_bits(msg->msg.psm.tau, 8, 1, 1);
+                send_bits(msg->msg.psm.active, 8, 1, 1);
             }
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CPIN_GET: {                /* Read current SIM status */
+        case GSM_CMD_CEDRXS_SET: {              /* Set extended discontinuous reception */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPIN?");
+            GSM_AT_PORT_SEND_CONST_STR("+CEDRXS=");
+            send_number(GSM_U32(msg->msg.edrx.en), 0, 0);
+            if (msg->msg.edrx.en) {
+                send_number(GSM_U32(msg->msg.edrx.act), 0, 1);
+                send_bits(msg->msg.edrx.cycle, 4, 1, 1);
+            }
             GSM_AT_PORT_SEND_END();
             break;
         }
+#endif /* GSM_CFG_SLEEP */
         case GSM_CMD_CPIN_SET: {                /* Set SIM pin code */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPIN=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPIN=");
             send_string(msg->msg.cpin_enter.pin, 0, 1, 0);  /* Send pin with quotes */
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GSM_CMD_CPIN_ADD: {                /* Add new pin code */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CLCK=\"SC\",1,");
+            GSM_AT_PORT_SEND_CONST_STR("+CLCK=\"SC\",1,");
             send_string(msg->msg.cpin_add.pin, 0, 1, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }                          
         case GSM_CMD_CPIN_CHANGE: {             /* Change already active SIM */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPWD=\"SC\"");
+            GSM_AT_PORT_SEND_CONST_STR("+CPWD=\"SC\"");
             send_string(msg->msg.cpin_change.current_pin, 0, 1, 1);
             send_string(msg->msg.cpin_change.new_pin, 0, 1, 1);
             GSM_AT_PORT_SEND_END();
@@ -1484,14 +3667,14 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
         }
         case GSM_CMD_CPIN_REMOVE: {             /* Remove current PIN */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CLCK=\"SC\",0,");
+            GSM_AT_PORT_SEND_CONST_STR("+CLCK=\"SC\",0,");
             send_string(msg->msg.cpin_remove.pin, 0, 1, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GMM_CMD_CPUK_SET: {                /* Enter PUK and set new PIN */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPIN=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPIN=");
             send_string(msg->msg.cpuk_enter.puk, 0, 1, 0);
             send_string(msg->msg.cpuk_enter.pin, 0, 1, 1);
             GSM_AT_PORT_SEND_END();
@@ -1499,7 +3682,7 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
         }
         case GSM_CMD_COPS_SET: {                /* Set current operator */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+COPS=");
+            GSM_AT_PORT_SEND_CONST_STR("+COPS=");
             send_number(GSM_U32(msg->msg.cops_set.mode), 0, 0);
             if (msg->msg.cops_set.mode != GSM_OPERATOR_MODE_AUTO) {
                 send_number(GSM_U32(msg->msg.cops_set.format), 0, 1);
@@ -1515,56 +3698,67 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_COPS_GET: {                /* Get current operator */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+COPS?");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_COPS_GET_OPT: {            /* Get list of available operators */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+COPS=?");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CSQ_GET: {                 /* Get signal strength */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CSQ");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CNUM: {                    /* Get SIM number */
+#if GSM_CFG_CONN
+        case GSM_CMD_CIPSERVER: {              /* Enable or disable server */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CNUM");
+            GSM_AT_PORT_SEND_CONST_STR("+CIPSERVER=");
+            if (msg->msg.tcpip_server.en) {
+                GSM_AT_PORT_SEND_CONST_STR("1");
+                send_port(msg->msg.tcpip_server.port, 0, 1);
+            } else {
+                GSM_AT_PORT_SEND_CONST_STR("0");
+            }
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIPSHUT: {                 /* Shut down network connection and put to reset state */
+
+#if GSM_CFG_CONN_SSL
+        case GSM_CMD_CIPSSL: {                  /* Set TLS mode for next connection */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPSHUT");
+            GSM_AT_PORT_SEND_CONST_STR("+CIPSSL=");
+            GSM_AT_PORT_SEND_CONST_STR(msg->msg.conn_start.type == GSM_CONN_TYPE_SSL ? "1" : "0");
             GSM_AT_PORT_SEND_END();
             break;
         }
-#if GSM_CFG_CONN
-        case GSM_CMD_CIPMUX: {                  /* Enable multiple connections */
+        case GSM_CMD_FSDEL:
+        case GSM_CMD_FSCREATE:
+        case GSM_CMD_FSWRITE: {                 /* File system commands use unquoted path */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPMUX=1");
+            if (CMD_IS_CUR(GSM_CMD_FSDEL)) {
+                GSM_AT_PORT_SEND_CONST_STR("+FSDEL=");
+            } else if (CMD_IS_CUR(GSM_CMD_FSCREATE)) {
+                GSM_AT_PORT_SEND_CONST_STR("+FSCREATE=");
+            } else {
+                GSM_AT_PORT_SEND_CONST_STR("+FSWRITE=");
+            }
+            GSM_AT_PORT_SEND_CONST_STR("C:\\USER\\");
+            GSM_AT_PORT_SEND_STR(msg->msg.ssl_cert.name);
+            if (CMD_IS_CUR(GSM_CMD_FSWRITE)) {
+                GSM_AT_PORT_SEND_CONST_STR(",0");   /* Write from beginning of file */
+                send_number(GSM_U32(msg->msg.ssl_cert.len), 0, 1);
+                GSM_AT_PORT_SEND_CONST_STR(",10");  /* Input time in units of seconds */
+            }
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIPHEAD: {                 /* Enable information on receive data about connection and length */
+        case GSM_CMD_SSLSETCERT: {              /* Select certificate file */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPHEAD=1");
+            GSM_AT_PORT_SEND_CONST_STR("+SSLSETCERT=\"C:\\USER\\");
+            GSM_AT_PORT_SEND_STR(msg->msg.ssl_cert.name);
+            GSM_AT_PORT_SEND_CONST_STR("\"");
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIPSRIP: {
+#endif /* GSM_CFG_CONN_SSL */
+#if GSM_CFG_DNS_CACHE
+        case GSM_CMD_CDNSGIP: {                 /* Resolve host name */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPSRIP=1");
+            GSM_AT_PORT_SEND_CONST_STR("+CDNSGIP=");
+            send_string(msg->msg.conn_start.host, 0, 1, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
-
+#endif /* GSM_CFG_DNS_CACHE */
         case GSM_CMD_CIPSTART: {                /* Start a new connection */
             gsm_conn_t* c = NULL;
 
@@ -1572,6 +3766,22 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
             /* Check if we are connected to network */
 
             msg->msg.conn_start.num = 0;        /* Start with max value = invalidated */
+#if GSM_CFG_NETWORK_REATTACH
+            if (msg->msg.conn_start.resume != NULL) {   /* Reopen connection with the same number */
+                if (!msg->msg.conn_start.resume->status.f.active) {
+                    c = msg->msg.conn_start.resume;
+                    msg->msg.conn_start.num = c->num;
+                }
+            } else
+#endif /* GSM_CFG_NETWORK_REATTACH */
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.active) {            /* Only first connection is available in single connection mode */
+                if (!gsm.conns[0].status.f.active) {
+                    c = &gsm.conns[0];
+                    c->num = 0;
+                }
+            } else
+#endif /* GSM_CFG_CONN_TRANSPARENT */
             for (int16_t i = GSM_CFG_MAX_CONNS - 1; i >= 0; i--) {  /* Find available connection */
                 if (!gsm.conns[i].status.f.active) {
                     c = &gsm.conns[i];
@@ -1590,14 +3800,32 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
             }
 
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPSTART=");
-            send_number(GSM_U32(c->num), 0, 0);
-            if (msg->msg.conn_start.type == GSM_CONN_TYPE_TCP) {
-                send_string("TCP", 0, 1, 1);
-            } else if (msg->msg.conn_start.type == GSM_CONN_TYPE_UDP) {
-                send_string("UDP", 0, 1, 1);
-            } 
-            send_string(msg->msg.conn_start.host, 0, 1, 1);
+            GSM_AT_PORT_SEND_CONST_STR("+CIPSTART=");
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.active) {            /* Single connection command has no connection number */
+                if (msg->msg.conn_start.type != GSM_CONN_TYPE_UDP) {   /* TLS runs over TCP */
+                    send_string("TCP", 0, 1, 0);
+                } else if (msg->msg.conn_start.type == GSM_CONN_TYPE_UDP) {
+                    send_string("UDP", 0, 1, 0);
+                }
+            } else
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+            {
+                send_number(GSM_U32(c->num), 0, 0);
+                if (msg->msg.conn_start.type != GSM_CONN_TYPE_UDP) {   /* TLS runs over TCP */
+                    send_string("TCP", 0, 1, 1);
+                } else if (msg->msg.conn_start.type == GSM_CONN_TYPE_UDP) {
+                    send_string("UDP", 0, 1, 1);
+                }
+            }
+#if GSM_CFG_DNS_CACHE
+            if (msg->msg.conn_start.ip_valid) {
+                send_ip_mac(&msg->msg.conn_start.ip, 1, 1, 1); /* Use resolved address */
+            } else
+#endif /* GSM_CFG_DNS_CACHE */
+            {
+                send_string(msg->msg.conn_start.host, 0, 1, 1);
+            }
             send_port(msg->msg.conn_start.port, 0, 1);
             GSM_AT_PORT_SEND_END();
             break;
@@ -1610,27 +3838,62 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
                 (!gsm_conn_is_active(c) || c->val_id != msg->msg.conn_close.val_id)) {
                 return gsmERR;
             }
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.active) {
+                if (gsm.transp.data_mode) {     /* Return to command mode first */
+                    msg->cmd = GSM_CMD_TRANSP_ESCAPE;
+                    return gsmi_initiate_cmd(msg);
+                }
+                GSM_AT_PORT_SEND_BEGIN();
+                GSM_AT_PORT_SEND_CONST_STR("+CIPCLOSE");
+                GSM_AT_PORT_SEND_END();
+                break;
+            }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPCLOSE=");
+            GSM_AT_PORT_SEND_CONST_STR("+CIPCLOSE=");
             send_number(GSM_U32(msg->msg.conn_close.conn ? msg->msg.conn_close.conn->num : GSM_CFG_MAX_CONNS), 0, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GSM_CMD_CIPSEND: {                 /* Send data to connection */
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.active) {
+                return gsmi_transp_send_data(); /* Write data directly in data mode */
+            }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
             return gsmi_tcpip_process_send_data();  /* Process send data */
         }
-        case GSM_CMD_CIPSTATUS: {               /* Get status of device and all connections */
+#if GSM_CFG_CONN_TRANSPARENT
+        case GSM_CMD_TRANSP_ESCAPE: {           /* Leave data mode */
+            if (!gsm.transp.data_mode) {
+                return gsmERR;
+            }
+            gsm.transp.data_mode = 0;           /* Response to escape sequence is parsed as command response */
+
+            /* Escape sequence must be surrounded by silence on UART */
+            GSM_CORE_UNPROTECT();
+            gsm_delay(GSM_CFG_CONN_TRANSPARENT_GUARD_TIME);
+            GSM_CORE_PROTECT();
+            GSM_AT_PORT_SEND("+++", 3);
+            break;
+        }
+        case GSM_CMD_ATO: {                     /* Return to data mode */
+            if (!gsm_conn_is_active(&gsm.conns[0])) {
+                return gsmERR;
+            }
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPSTATUS");
+            GSM_AT_PORT_SEND_CONST_STR("O");
             GSM_AT_PORT_SEND_END();
             break;
         }
+#endif /* GSM_CFG_CONN_TRANSPARENT */
 
 #endif /* GSM_CFG_CONN */
 #if GSM_CFG_SMS
         case GSM_CMD_CMGF: {                    /* Select SMS message format */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CMGF=");
+            GSM_AT_PORT_SEND_CONST_STR("+CMGF=");
             if (CMD_IS_DEF(GSM_CMD_CMGS)) {
                 send_number(GSM_U32(!!msg->msg.sms_send.format), 0, 0);
             } else if (CMD_IS_DEF(GSM_CMD_CMGR)) {
@@ -1638,21 +3901,31 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
             } else if (CMD_IS_DEF(GSM_CMD_CMGL)) {
                 send_number(GSM_U32(!!msg->msg.sms_list.format), 0, 0);
             } else {
-                GSM_AT_PORT_SEND_STR("1");      /* Force text mode */
+                GSM_AT_PORT_SEND_CONST_STR("1");      /* Force text mode */
             }
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GSM_CMD_CMGS: {                    /* Send SMS */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CMGS=");
-            send_string(msg->msg.sms_send.num, 0, 1, 0);
+            GSM_AT_PORT_SEND_CONST_STR("+CMGS=");
+#if GSM_CFG_SMS_PDU
+            if (!msg->msg.sms_send.format) {    /* PDU mode uses TPDU length */
+                msg->msg.sms_send.part_end = gsmi_sms_pdu_part(msg->msg.sms_send.text, msg->msg.sms_send.text_len,
+                    msg->msg.sms_send.part_start, msg->msg.sms_send.enc, msg->msg.sms_send.parts > 1, &msg->msg.sms_send.part_units);
+                send_number(GSM_U32(gsmi_sms_pdu_tpdu_len(msg->msg.sms_send.rcpts[msg->msg.sms_send.ri].num,
+                    msg->msg.sms_send.enc, msg->msg.sms_send.part_units, msg->msg.sms_send.parts > 1)), 0, 0);
+            } else
+#endif /* GSM_CFG_SMS_PDU */
+            {
+                send_string(msg->msg.sms_send.num, 0, 1, 0);
+            }
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GSM_CMD_CMGR: {                    /* Read message */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CMGR=");
+            GSM_AT_PORT_SEND_CONST_STR("+CMGR=");
             send_number(GSM_U32(msg->msg.sms_read.pos), 0, 0);
             send_number(GSM_U32(!msg->msg.sms_read.update), 0, 1);
             GSM_AT_PORT_SEND_END();
@@ -1660,34 +3933,25 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
         }
         case GSM_CMD_CMGD: {                    /* Delete SMS message */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CMGD=");
-            send_number(GSM_U32(msg->msg.sms_delete.pos), 0, 0);
+            GSM_AT_PORT_SEND_CONST_STR("+CMGD=");
+            send_number(GSM_U32(CMD_IS_DEF(GSM_CMD_CMGL) ? msg->msg.sms_list.del_pos : msg->msg.sms_delete.pos), 0, 0);
+            if (CMD_IS_DEF(GSM_CMD_CMGD) && msg->msg.sms_delete.delflag) {
+                send_number(GSM_U32(msg->msg.sms_delete.delflag), 0, 1);
+            }
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GSM_CMD_CMGL: {                    /* Delete SMS message */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CMGL=");
+            GSM_AT_PORT_SEND_CONST_STR("+CMGL=");
             send_sms_stat(msg->msg.sms_list.status, 1, 0);
             send_number(GSM_U32(!msg->msg.sms_list.update), 0, 1);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CPMS_GET_OPT: {            /* Get available SMS storages */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPMS=?");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CPMS_GET: {                /* Get current SMS storage info */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPMS?");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
         case GSM_CMD_CPMS_SET: {                /* Set active SMS storage(s) */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPMS=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPMS=");
             if (CMD_IS_DEF(GSM_CMD_CMGR)) { /* Read SMS original command? */
                 send_dev_memory(msg->msg.sms_read.mem == GSM_MEM_CURRENT ? gsm.sms.mem[0].current : msg->msg.sms_read.mem, 1, 0);
             } else if(CMD_IS_DEF(GSM_CMD_CMGD)) {   /* Delete SMS original command? */
@@ -1706,42 +3970,18 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
 #if GSM_CFG_CALL
         case GSM_CMD_ATD: {                     /* Start new call */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("D");
+            GSM_AT_PORT_SEND_CONST_STR("D");
             send_string(msg->msg.call_start.number, 0, 0, 0);
-            GSM_AT_PORT_SEND_STR(";");          /* Voice call includes semicolon at the end */
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_ATA: {                     /* Answer phone call */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("A");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_ATH: {                     /* Disconnect existing connection (hang-up phone call) */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("H");
+            GSM_AT_PORT_SEND_CONST_STR(";");          /* Voice call includes semicolon at the end */
             GSM_AT_PORT_SEND_END();
             break;
         }
 #endif /* GSM_CFG_CALL */
 #if GSM_CFG_PHONEBOOK
-        case GSM_CMD_CPBS_GET_OPT: {            /* Get available phonebook storages */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPBS=?");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
-        case GSM_CMD_CPBS_GET: {                /* Get current memory info */
-            GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPBS?");
-            GSM_AT_PORT_SEND_END();
-            break;
-        }
         case GSM_CMD_CPBS_SET: {                /* Get current memory info */
             gsm_mem_t mem;
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPBS=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPBS=");
             switch (CMD_GET_DEF()) {
                 case GSM_CMD_CPBW_SET: mem = msg->msg.pb_write.mem; break;
                 case GSM_CMD_CPBR: mem = msg->msg.pb_list.mem; break;
@@ -1754,7 +3994,7 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
         }
         case GSM_CMD_CPBW_SET: {                /* Write/Delete new/old entry */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPBW=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPBW=");
             if (msg->msg.pb_write.pos) {        /* Write number if more than 0 */
                 send_number(GSM_U32(msg->msg.pb_write.pos), 0, 0);
             }
@@ -1768,7 +4008,7 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
         }
         case GSM_CMD_CPBR: {                    /* Read entires */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPBR=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPBR=");
             send_number(GSM_U32(msg->msg.pb_list.start_index), 0, 0);
             send_number(GSM_U32(msg->msg.pb_list.etr), 0, 1);
             GSM_AT_PORT_SEND_END();
@@ -1776,7 +4016,7 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
         }
         case GSM_CMD_CPBF: {                    /* Find entires */
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CPBF=");
+            GSM_AT_PORT_SEND_CONST_STR("+CPBF=");
             send_string(msg->msg.pb_search.search, 1, 1, 0);
             GSM_AT_PORT_SEND_END();
             break;
@@ -1784,71 +4024,499 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
 #endif /* GSM_CFG_PHONEBOOK */
 #if GSM_CFG_NETWORK
         case GSM_CMD_NETWORK_ATTACH:
-        case GSM_CMD_CGACT_SET_0: {
+        case GSM_CMD_NETWORK_DETACH:
+        case GSM_CMD_CIPMUX_SET: {
+            GSM_AT_PORT_SEND_BEGIN();
+#if GSM_CFG_CONN_TRANSPARENT
+            GSM_AT_PORT_SEND_CONST_STR("+CIPMUX=");
+            send_number(GSM_U32(!gsm.transp.req), 0, 0);
+#else /* GSM_CFG_CONN_TRANSPARENT */
+            GSM_AT_PORT_SEND_CONST_STR("+CIPMUX=1");
+#endif /* !GSM_CFG_CONN_TRANSPARENT */
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+#if GSM_CFG_CMUX
+        case GSM_CMD_CMUX_SET: {                /* Enable multiplexer in basic mode */
+            static const uint32_t speeds[] = { 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600 };
+            uint8_t speed = 5;                  /* 115200 bauds by default */
+
+            for (size_t i = 0; i < GSM_ARRAYSIZE(speeds); i++) {
+                if (gsm.ll.uart.baudrate == speeds[i]) {
+                    speed = GSM_U8(i + 1);      /* Keep current port speed */
+                    break;
+                }
+            }
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGACT=0");
+            GSM_AT_PORT_SEND_CONST_STR("+CMUX=0,0");
+            send_number(GSM_U32(speed), 0, 1);
+            send_number(GSM_U32(GSM_CFG_CMUX_FRAME_SIZE), 0, 1);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CGACT_SET_1: {
+        case GSM_CMD_CMUX_SABM:                 /* Open or close channel */
+        case GSM_CMD_CMUX_DISC: {
+            return gsmi_cmux_open_close(msg->msg.cmux.dlci, CMD_IS_CUR(GSM_CMD_CMUX_SABM));
+        }
+#endif /* GSM_CFG_CMUX */
+        case GSM_CMD_CIPMODE_SET: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGACT=1");
+#if GSM_CFG_CONN_TRANSPARENT
+            GSM_AT_PORT_SEND_CONST_STR("+CIPMODE=");
+            send_number(GSM_U32(!!gsm.transp.req), 0, 0);
+#else /* GSM_CFG_CONN_TRANSPARENT */
+            GSM_AT_PORT_SEND_CONST_STR("+CIPMODE=0");
+#endif /* !GSM_CFG_CONN_TRANSPARENT */
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_NETWORK_DETACH:
-        case GSM_CMD_CGATT_SET_0: {
+        case GSM_CMD_CIPRXGET_SET: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGATT=0");
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+#if GSM_CFG_CONN_TRANSPARENT
+            if (gsm.transp.req) {
+                GSM_AT_PORT_SEND_CONST_STR("+CIPRXGET=0");  /* Device pushes data directly in data mode */
+            } else
+#endif /* GSM_CFG_CONN_TRANSPARENT */
+            {
+                GSM_AT_PORT_SEND_CONST_STR("+CIPRXGET=1");  /* Keep received data in device buffer */
+            }
+#else /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+            GSM_AT_PORT_SEND_CONST_STR("+CIPRXGET=0");
+#endif /* !GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CGATT_SET_1: {
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+        case GSM_CMD_CIPRXGET: {                /* Read data buffered in device */
+            gsm_conn_p c = msg->msg.ciprxget.conn;
+            if (!c->status.f.active || c->val_id != msg->msg.ciprxget.val_id) {
+                c->status.f.rx_reading = 0;     /* Connection was closed in between */
+                return gsmERR;
+            }
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CGATT=1");
+            GSM_AT_PORT_SEND_CONST_STR("+CIPRXGET=2");
+            send_number(GSM_U32(c->num), 0, 1);
+            send_number(GSM_U32(msg->msg.ciprxget.len), 0, 1);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIPMUX_SET: {
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE */
+        case GSM_CMD_CIPQSEND_SET: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPMUX=1");
+            GSM_AT_PORT_SEND_CONST_STR("+CIPQSEND=1");
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIPRXGET_SET: {
+        case GSM_CMD_CIPSRIP: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIPRXGET=0");
+            GSM_AT_PORT_SEND_CONST_STR("+CIPSRIP=");
+            send_number(GSM_U32(!!GSM_CFG_CONN_RECV_FROM), 0, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
         case GSM_CMD_CSTT_SET: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CSTT=");
+            GSM_AT_PORT_SEND_CONST_STR("+CSTT=");
             send_string(msg->msg.network_attach.apn, 1, 1, 0);
             send_string(msg->msg.network_attach.user, 1, 1, 1);
             send_string(msg->msg.network_attach.pass, 1, 1, 1);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIICR: {
+#endif /* GSM_CFG_NETWORK */
+#if GSM_CFG_HTTP || GSM_CFG_FTP
+        case GSM_CMD_SAPBR_SET: {
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+SAPBR=3,1,");
+            switch (msg->i) {                   /* Parameter is selected by step */
+                case 0:
+                    send_string("Contype", 0, 1, 0);
+                    send_string("GPRS", 0, 1, 1);
+                    break;
+                case 1:
+                    send_string("APN", 0, 1, 0);
+                    send_string(msg->msg.network_attach.apn, 1, 1, 1);
+                    break;
+                case 2:
+                    send_string("USER", 0, 1, 0);
+                    send_string(msg->msg.network_attach.user, 1, 1, 1);
+                    break;
+                default:
+                    send_string("PWD", 0, 1, 0);
+                    send_string(msg->msg.network_attach.pass, 1, 1, 1);
+                    break;
+            }
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+#endif /* GSM_CFG_HTTP || GSM_CFG_FTP */
+#if GSM_CFG_HTTP
+        case GSM_CMD_HTTPPARA_URL: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIICR");
+            GSM_AT_PORT_SEND_CONST_STR("+HTTPPARA=\"URL\",");
+            send_string(msg->msg.http_get.url, 0, 1, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
-        case GSM_CMD_CIFSR: {
+        case GSM_CMD_HTTPSSL: {
             GSM_AT_PORT_SEND_BEGIN();
-            GSM_AT_PORT_SEND_STR("+CIFSR");
+            GSM_AT_PORT_SEND_CONST_STR("+HTTPSSL=");
+            send_number(GSM_U32(msg->msg.http_get.ssl), 0, 0);
             GSM_AT_PORT_SEND_END();
             break;
         }
-#endif /* GSM_CFG_NETWORK */
+        case GSM_CMD_HTTPACTION: {
+            msg->msg.http_get.action = 0;
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+HTTPACTION=0");  /* GET method */
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_HTTPREAD: {
+            msg->msg.http_get.read = 0;
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+HTTPREAD=");
+            send_number(GSM_U32(msg->msg.http_get.offset), 0, 0);
+            send_number(GSM_U32(GSM_MIN(msg->msg.http_get.body_len - msg->msg.http_get.offset, GSM_CFG_HTTP_READ_LEN)), 0, 1);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_FTP
+        case GSM_CMD_FTPSERV: {
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+FTPSERV=");
+            send_string(msg->msg.ftp.server->host, 0, 1, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPPORT: {
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+FTPPORT=");
+            send_port(msg->msg.ftp.server->port ? msg->msg.ftp.server->port : 21, 0, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPUN: {
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+FTPUN=");
+            send_string(msg->msg.ftp.server->user, 0, 1, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPPW: {
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+FTPPW=");
+            send_string(msg->msg.ftp.server->pass, 0, 1, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPGETPATH:
+        case GSM_CMD_FTPPUTPATH: {
+            GSM_AT_PORT_SEND_BEGIN();
+            if (CMD_IS_CUR(GSM_CMD_FTPGETPATH)) {
+                GSM_AT_PORT_SEND_CONST_STR("+FTPGETPATH=");
+            } else {
+                GSM_AT_PORT_SEND_CONST_STR("+FTPPUTPATH=");
+            }
+            send_string(msg->msg.ftp.path, 0, 1, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPGETNAME:
+        case GSM_CMD_FTPPUTNAME: {
+            GSM_AT_PORT_SEND_BEGIN();
+            if (CMD_IS_CUR(GSM_CMD_FTPGETNAME)) {
+                GSM_AT_PORT_SEND_CONST_STR("+FTPGETNAME=");
+            } else {
+                GSM_AT_PORT_SEND_CONST_STR("+FTPPUTNAME=");
+            }
+            send_string(msg->msg.ftp.name, 0, 1, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPGET_OPEN:
+        case GSM_CMD_FTPPUT_OPEN: {
+            msg->msg.ftp.ok = 0;
+            msg->msg.ftp.wait = 1;              /* Wait for session status */
+            msg->msg.ftp.start = gsm_sys_now();
+            GSM_AT_PORT_SEND_BEGIN();
+            if (CMD_IS_CUR(GSM_CMD_FTPGET_OPEN)) {
+                GSM_AT_PORT_SEND_CONST_STR("+FTPGET=1");
+            } else {
+                GSM_AT_PORT_SEND_CONST_STR("+FTPPUT=1");
+            }
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPGET_READ: {
+            msg->msg.ftp.ok = 0;
+            msg->msg.ftp.wait = 0;
+            msg->msg.ftp.read = 0;
+            gsmi_ftp_chunk_start(msg);
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+FTPGET=2,");
+            send_number(GSM_U32(GSM_CFG_FTP_READ_LEN), 0, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+        case GSM_CMD_FTPPUT_WRITE: {
+            msg->msg.ftp.ok = 0;
+            msg->msg.ftp.wait = 1;              /* Wait until device is ready for next chunk */
+            gsmi_ftp_chunk_start(msg);
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+FTPPUT=2,");
+            send_number(GSM_U32(msg->msg.ftp.len), 0, 0);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+#endif /* GSM_CFG_FTP */
+#if GSM_CFG_PING
+        case GSM_CMD_CIPPING: {
+            GSM_AT_PORT_SEND_BEGIN();
+            GSM_AT_PORT_SEND_CONST_STR("+CIPPING=");
+            send_string(msg->msg.ping.host, 0, 1, 0);
+            send_number(GSM_U32(msg->msg.ping.count), 0, 1);
+            send_number(32, 0, 1);              /* Default data length */
+            send_number(GSM_U32(GSM_CFG_PING_TIMEOUT / 100), 0, 1);
+            GSM_AT_PORT_SEND_END();
+            break;
+        }
+#endif /* GSM_CFG_PING */
         default: 
             return gsmERR;                      /* Invalid command */
     }
     return gsmOK;                               /* Valid command */
 }
 
+/**
+ * \brief           Get producer queue lane for command
+ * \param[in]       cmd: Default command of message
+ * \return          Member of \ref gsm_msg_prio_t enumeration
+ */
+static gsm_msg_prio_t
+gsmi_get_msg_prio(gsm_cmd_t cmd) {
+    switch (cmd) {
+        case GSM_CMD_RESET:
+#if GSM_CFG_WARM_START
+        case GSM_CMD_WARM_START:
+#endif /* GSM_CFG_WARM_START */
+#if GSM_CFG_CALL
+        case GSM_CMD_ATA:
+        case GSM_CMD_ATH:
+#endif /* GSM_CFG_CALL */
+            return GSM_MSG_PRIO_URGENT;
+        /*
+         * SMS and phonebook listing stay in data lane,
+         * otherwise they may overtake delete and write requests queued before them
+         */
+        case GSM_CMD_COPS_GET_OPT:
+            return GSM_MSG_PRIO_BACKGROUND;
+        default:
+            return GSM_MSG_PRIO_DATA;
+    }
+}
+
+/**
+ * \brief           Get coalesce slot for idempotent status query
+ *
+ * Query commands without input parameters return the same result
+ * for all callers, therefore duplicate requests may share single execution
+ *
+ * \param[in]       cmd: Default command of message
+ * \return          Slot index in `msg_coalesce_pending` or `-1` if command cannot be coalesced
+ */
+static int8_t
+gsmi_get_msg_coalesce_idx(gsm_cmd_t cmd) {
+    switch (cmd) {
+        case GSM_CMD_CSQ_GET:
+            return 0;
+#if GSM_CFG_CONN
+        case GSM_CMD_CIPSTATUS:
+            return 1;
+#endif /* GSM_CFG_CONN */
+        case GSM_CMD_COPS_GET:
+            return 2;
+        case GSM_CMD_CREG_GET:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * \brief           Complete all duplicate queries attached to message
+ * \note            Function must be called with core protected,
+ *                  after message processing finished and before message is released
+ * \param[in]       msg: Message which was processed
+ * \param[in]       res: Processing result of message
+ */
+void
+gsmi_msg_coalesce_finish(gsm_msg_t* msg, gsmr_t res) {
+    gsm_msg_t *m, *next;
+
+    GSM_PRODUCER_PROTECT();                     /* Attached list is shared with API threads */
+    for (m = msg->coalesce_list; m != NULL; m = next) {
+        next = m->coalesce_next;
+        m->coalesce_next = NULL;
+        m->coalesce_owner = NULL;
+        m->res = res != gsmOK ? res : msg->res;
+        if (m->res == gsmOK) {                  /* Copy result from shared execution */
+            if (m->cmd_def == GSM_CMD_CSQ_GET && m->msg.csq.rssi != NULL) {
+                *m->msg.csq.rssi = gsm.rssi;
+            } else if (m->cmd_def == GSM_CMD_COPS_GET && m->msg.cops_get.curr != NULL) {
+                *m->msg.cops_get.curr = gsm.network.curr_operator;
+            } else if (m->cmd_def == GSM_CMD_CREG_GET && m->msg.creg_get.status != NULL) {
+                *m->msg.creg_get.status = gsm.network.status;
+            }
+        }
+#if GSM_CFG_CMD_EVT
+        gsmi_msg_cmd_evt(m);                    /* Notify completion of attached query */
+#endif /* GSM_CFG_CMD_EVT */
+        if (m->is_blocking) {
+            gsm_sys_sem_release(&m->sem);       /* Wake up waiting thread */
+        } else {
+            GSM_MSG_VAR_FREE(m);                /* Release message structure */
+        }
+    }
+    msg->coalesce_list = NULL;
+    GSM_PRODUCER_UNPROTECT();
+}
+
+#if GSM_CFG_CMD_EVT || __DOXYGEN__
+
+/**
+ * \brief           Call completion callback of message once its result is known
+ * \param[in]       msg: Message with final result
+ */
+void
+gsmi_msg_cmd_evt(gsm_msg_t* msg) {
+    gsm_api_cmd_evt_fn fn = msg->evt_fn;
+
+    if (fn != NULL) {
+        msg->evt_fn = NULL;                     /* Call it only once */
+        fn(msg->res, msg->evt_arg);
+    }
+}
+
+#endif /* GSM_CFG_CMD_EVT || __DOXYGEN__ */
+
+/**
+ * \brief           Get message with highest priority from producer lanes
+ * \note            Function must be called from producer thread with core protected,
+ *                  after entry from wakeup queue was received
+ * \return          Pointer to message or `NULL` if all lanes are empty
+ */
+gsm_msg_t *
+gsmi_get_msg_from_producer_lanes(void) {
+    gsm_msg_lane_stats_t* stats;
+    gsm_msg_t* msg;
+    uint32_t wait;
+    size_t i;
+
+    for (i = 0; i < GSM_MSG_PRIO_END; i++) {
+        if (gsm_sys_mbox_getnow(&gsm.mbox_producer_lane[i], (void **)&msg) && msg != NULL) {
+            GSM_PRODUCER_PROTECT();
+            stats = &gsm.producer_lane_stats[i];
+            wait = gsm_sys_now() - msg->queue_time;
+#if GSM_CFG_CMD_STATS
+            msg->dispatch_time = msg->queue_time + wait;
+#endif /* GSM_CFG_CMD_STATS */
+            stats->depth--;
+            stats->count++;
+            stats->wait_total += wait;
+            if (wait > stats->wait_max) {
+                stats->wait_max = wait;
+            }
+            for (size_t j = 0; j < GSM_ARRAYSIZE(gsm.msg_coalesce_pending); j++) {
+                if (gsm.msg_coalesce_pending[j] == msg) { /* Execution starts, no more attaching */
+                    gsm.msg_coalesce_pending[j] = NULL;
+                }
+            }
+            GSM_PRODUCER_UNPROTECT();
+            return msg;
+        }
+    }
+    return NULL;
+}
+
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+
+/**
+ * \brief           Add time to command latency histogram
+ * \param[in]       hist: Histogram to update
+ * \param[in]       time: Time in units of milliseconds
+ */
+static void
+gsmi_cmd_hist_add(gsm_cmd_hist_t* hist, uint32_t time) {
+    uint32_t limit = GSM_CFG_CMD_STATS_BUCKET_MS;
+    size_t idx = 0;
+
+    while (idx < GSM_CFG_CMD_STATS_BUCKETS - 1 && time >= limit) {
+        idx++;
+        limit <<= 1;
+    }
+    hist->bucket[idx]++;
+    if (time > hist->max) {
+        hist->max = time;
+    }
+}
+
+/**
+ * \brief           Mark command start, right before its processing function is called
+ * \note            Function must be called from producer thread with core protected
+ * \param[in]       msg: Message being started
+ */
+void
+gsmi_cmd_stats_start(gsm_msg_t* msg) {
+    msg->start_time = gsm_sys_now();
+    msg->rsp_received = 0;
+}
+
+/**
+ * \brief           Add completed command to latency statistics
+ * \note            Function must be called from producer thread with core protected
+ * \param[in]       msg: Completed message
+ * \param[in]       res: Result of producer thread, \ref gsmOK if command was started and finished in time
+ */
+void
+gsmi_cmd_stats_finish(gsm_msg_t* msg, gsmr_t res) {
+    gsm_cmd_stats_t* stats = NULL;
+    uint32_t now = gsm_sys_now();
+
+    for (size_t i = 0; i < gsm.cmd_stats_num; i++) {
+        if (gsm.cmd_stats[i].cmd == (uint16_t)msg->cmd_def) {
+            stats = &gsm.cmd_stats[i];
+            break;
+        }
+    }
+    if (stats == NULL) {
+        if (gsm.cmd_stats_num >= GSM_ARRAYSIZE(gsm.cmd_stats)) {
+            return;                             /* No more space, command is not tracked */
+        }
+        stats = &gsm.cmd_stats[gsm.cmd_stats_num++];
+        stats->cmd = (uint16_t)msg->cmd_def;
+    }
+    if (res == gsmOK) {
+        res = msg->res;                         /* Command finished, use its result */
+    }
+    stats->count++;
+    if (res == gsmTIMEOUT) {
+        stats->timeouts++;
+    } else if (res != gsmOK) {
+        stats->errors++;
+    }
+    gsmi_cmd_hist_add(&stats->queue, msg->dispatch_time - msg->queue_time);
+    gsmi_cmd_hist_add(&stats->sync, msg->start_time - msg->dispatch_time);
+    if (msg->rsp_received) {
+        gsmi_cmd_hist_add(&stats->response, msg->rsp_time - msg->start_time);
+    }
+    gsmi_cmd_hist_add(&stats->total, now - msg->queue_time);
+}
+
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
+
 /**
  * \brief           Send message from API function to producer queue for further processing
  * \param[in]       msg: New message to process
@@ -1859,25 +4527,49 @@ gsmi_initiate_cmd(gsm_msg_t* msg) {
 gsmr_t
 gsmi_send_msg_to_producer_mbox(gsm_msg_t* msg, gsmr_t (*process_fn)(gsm_msg_t *), uint32_t block, uint32_t max_block_time) {
     gsmr_t res = msg->res = gsmOK;
+    gsm_sys_mbox_t* lane;
+    gsm_msg_lane_stats_t* stats;
+    gsm_msg_t* owner = NULL;
+    int8_t cidx;
 
-    /* Check here if stack is even enabled or shall we disable new command entry? */
+    /*
+     * Check here if stack is even enabled or shall we disable new command entry?
+     *
+     * With separate lock domains, flag is read without core lock,
+     * so that API threads never wait for processing thread here
+     */
+#if !GSM_CFG_LOCK_DOMAINS
     GSM_CORE_PROTECT();
+#endif /* !GSM_CFG_LOCK_DOMAINS */
     if (!gsm.status.f.dev_present) {
         if (!CMD_IS_DEF(GSM_CMD_RESET)) {       /* Only reset is allowed */
             res = gsmERRNODEVICE;               /* No device connected */
         }
     }
+#if !GSM_CFG_LOCK_DOMAINS
     GSM_CORE_UNPROTECT();
+#endif /* !GSM_CFG_LOCK_DOMAINS */
     if (res != gsmOK) {
         GSM_MSG_VAR_FREE(msg);                  /* Free memory and return */
         return res;
     }
 
     if (block) {                                /* In case message is blocking */
+#if GSM_CFG_THREAD_SEM_CACHE
+        if (!sem_cache_valid) {                 /* First blocking call of this thread? */
+            if (!gsm_sys_sem_create(&sem_cache, 0)) {
+                GSM_MSG_VAR_FREE(msg);          /* Release memory and return */
+                return gsmERRMEM;
+            }
+            sem_cache_valid = 1;
+        }
+        msg->sem = sem_cache;                   /* Reuse locked semaphore of this thread */
+#else /* GSM_CFG_THREAD_SEM_CACHE */
         if (!gsm_sys_sem_create(&msg->sem, 0)) {/* Create semaphore and lock it immediatelly */
             GSM_MSG_VAR_FREE(msg);              /* Release memory and return */
             return gsmERRMEM;
         }
+#endif /* !GSM_CFG_THREAD_SEM_CACHE */
     }
     if (!msg->cmd) {                            /* Set start command if not set by user */
         msg->cmd = msg->cmd_def;                /* Set it as default */
@@ -1885,12 +4577,45 @@ gsmi_send_msg_to_producer_mbox(gsm_msg_t* msg, gsmr_t (*process_fn)(gsm_msg_t *)
     msg->is_blocking = block;                   /* Set status if message is blocking */
     msg->block_time = max_block_time;           /* Set blocking status if necessary */
     msg->fn = process_fn;                       /* Save processing function to be called as callback */
-    if (block) {
-        gsm_sys_mbox_put(&gsm.mbox_producer, msg);  /* Write message to producer queue and wait until written */
+    msg->prio = gsmi_get_msg_prio(msg->cmd_def);/* Select producer lane */
+    msg->queue_time = gsm_sys_now();
+    lane = &gsm.mbox_producer_lane[msg->prio];
+    stats = &gsm.producer_lane_stats[msg->prio];
+    cidx = gsmi_get_msg_coalesce_idx(msg->cmd_def);
+    GSM_PRODUCER_PROTECT();
+    if (cidx >= 0 && gsm.msg_coalesce_pending[cidx] != NULL) {
+        owner = gsm.msg_coalesce_pending[cidx]; /* Same query is already queued, wait for its result */
+        msg->coalesce_owner = owner;
+        msg->coalesce_next = owner->coalesce_list;
+        owner->coalesce_list = msg;
     } else {
-        if (!gsm_sys_mbox_putnow(&gsm.mbox_producer, msg)) {    /* Write message to producer queue immediatelly */
-            GSM_MSG_VAR_FREE(msg);              /* Release message */
-            res = gsmERR;
+        if (cidx >= 0) {
+            gsm.msg_coalesce_pending[cidx] = msg; /* Allow next duplicates to attach to this message */
+        }
+        if (++stats->depth > stats->max_depth) {/* Count message before producer can take it */
+            stats->max_depth = stats->depth;
+        }
+    }
+    GSM_PRODUCER_UNPROTECT();
+    if (owner == NULL) {
+        if (block) {
+            gsm_sys_mbox_put(lane, msg);        /* Write message to producer queue and wait until written */
+        } else {
+            if (!gsm_sys_mbox_putnow(lane, msg)) {  /* Write message to producer queue immediatelly */
+                GSM_PRODUCER_PROTECT();
+                stats->depth--;
+                stats->dropped++;
+                if (cidx >= 0 && gsm.msg_coalesce_pending[cidx] == msg) {
+                    gsm.msg_coalesce_pending[cidx] = NULL;
+                }
+                gsmi_msg_coalesce_finish(msg, gsmERR);  /* Fail queries attached in the meantime */
+                GSM_PRODUCER_UNPROTECT();
+                GSM_MSG_VAR_FREE(msg);          /* Release message */
+                res = gsmERR;
+            }
+        }
+        if (res == gsmOK) {
+            gsm_sys_mbox_putnow(&gsm.mbox_producer, NULL);  /* Wakeup producer, queue has space for all lane entries */
         }
     }
     if (block && res == gsmOK) {                /* In case we have blocking request */
@@ -1898,8 +4623,36 @@ gsmi_send_msg_to_producer_mbox(gsm_msg_t* msg, gsmr_t (*process_fn)(gsm_msg_t *)
         time = gsm_sys_sem_wait(&msg->sem, max_block_time); /* Wait forever for semaphore access for max block time */
         if (GSM_SYS_TIMEOUT == time) {          /* If semaphore was not accessed in given time */
             res = gsmERR;                       /* Semaphore not released in time */
+            GSM_PRODUCER_PROTECT();
+            if (msg->coalesce_owner != NULL) {  /* Still attached? Detach from owner message */
+                gsm_msg_t** pp;
+                for (pp = &msg->coalesce_owner->coalesce_list; *pp != NULL; pp = &(*pp)->coalesce_next) {
+                    if (*pp == msg) {
+                        *pp = msg->coalesce_next;
+                        break;
+                    }
+                }
+                msg->coalesce_owner = NULL;
+            } else {
+                if (cidx >= 0 && gsm.msg_coalesce_pending[cidx] == msg) {
+                    gsm.msg_coalesce_pending[cidx] = NULL;
+                }
+                gsmi_msg_coalesce_finish(msg, gsmERR);  /* Message is released, fail attached queries */
+            }
+            GSM_PRODUCER_UNPROTECT();
+#if GSM_CFG_THREAD_SEM_CACHE
+            /*
+             * Message may still be released later by producer thread,
+             * cached semaphore cannot be trusted to stay locked anymore.
+             * Delete it below and create new one on next blocking call
+             */
+            sem_cache_valid = 0;
+#endif /* GSM_CFG_THREAD_SEM_CACHE */
         } else {
             res = msg->res;                     /* Set rgsmonse status from message rgsmonse */
+#if GSM_CFG_THREAD_SEM_CACHE
+            gsm_sys_sem_invalid(&msg->sem);     /* Semaphore is locked again, keep it for next call */
+#endif /* GSM_CFG_THREAD_SEM_CACHE */
         }
         if (gsm_sys_sem_isvalid(&msg->sem)) {   /* In case we have valid semaphore */
             gsm_sys_sem_delete(&msg->sem);      /* Delete semaphore object */
@@ -33,30 +33,272 @@
 #include "gsm/gsm_private.h"
 #include "gsm/gsm_mem.h"
 
+/**
+ * \brief           Memory alignment bits and absolute number
+ */
+#define MEM_ALIGN_BITS              GSM_SZ(GSM_CFG_MEM_ALIGNMENT - 1)
+#define MEM_ALIGN_NUM               GSM_SZ(GSM_CFG_MEM_ALIGNMENT)
+#define MEM_ALIGN(x)                GSM_MEM_ALIGN(x)
+
+/**
+ * \brief           Allocation tag is kept in upper bits of block size, below allocated bit
+ */
+#define MEM_TAG_BITS                4
+#define MEM_TAG_POS                 (sizeof(size_t) * 8 - 1 - MEM_TAG_BITS)
+#define MEM_TAG_MASK                (GSM_SZ((1 << MEM_TAG_BITS) - 1) << MEM_TAG_POS)
+#define MEM_TAG_TO_SIZE(tag)        (GSM_SZ(tag) << MEM_TAG_POS)
+#define MEM_TAG_FROM_SIZE(size)     ((gsm_mem_tag_t)(((size) & MEM_TAG_MASK) >> MEM_TAG_POS))
+#define MEM_SIZE_LIMIT              (GSM_SZ(1) << MEM_TAG_POS)
+
+#if GSM_MEM_TAG_END > (1 << MEM_TAG_BITS)
+#error "Too many memory tags for MEM_TAG_BITS"
+#endif /* GSM_MEM_TAG_END > (1 << MEM_TAG_BITS) */
+
 #if !__DOXYGEN__
+#if GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_FIRST_FIT
 typedef struct mem_block {
     struct mem_block* next;                         /*!< Pointer to next free block */
     size_t size;                                    /*!< Size of block */
 } mem_block_t;
+#elif GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_TLSF
+typedef struct tlsf_block {
+    struct tlsf_block* prev_phys;                   /*!< Previous physical block in region, `NULL` for first block */
+    size_t size;                                    /*!< Size of block including metadata, lowest bit is set when block is free */
+    struct tlsf_block* next_free;                   /*!< Next free block in the same list. Valid only when block is free */
+    struct tlsf_block* prev_free;                   /*!< Previous free block in the same list. Valid only when block is free */
+} tlsf_block_t;
+#endif /* GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_TLSF */
 #endif /* !__DOXYGEN__ */
 
 /**
- * \brief           Memory alignment bits and absolute number
+ * \brief           Size class configuration
+ *
+ * Each power of 2 range (first level) is split to \ref TLSF_SL_COUNT linear lists (second level).
+ * Blocks smaller than \ref TLSF_SMALL_SIZE are kept in first level list `0`.
+ * Blocks can be up to `2 ^ TLSF_FL_MAX_LOG2` bytes long, bigger regions are truncated
  */
-#define MEM_ALIGN_BITS              GSM_SZ(GSM_CFG_MEM_ALIGNMENT - 1)
-#define MEM_ALIGN_NUM               GSM_SZ(GSM_CFG_MEM_ALIGNMENT)
-#define MEM_ALIGN(x)                GSM_MEM_ALIGN(x)
+#define TLSF_SL_LOG2                3
+#define TLSF_SL_COUNT               (1 << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT               (TLSF_SL_LOG2 + 2)
+#define TLSF_FL_MAX_LOG2            24
+#define TLSF_FL_COUNT               (TLSF_FL_MAX_LOG2 - TLSF_FL_SHIFT + 1)
+
+#if !__DOXYGEN__
+/**
+ * \brief           Heap of single instance
+ */
+typedef struct {
+    size_t total_size;                              /*!< Total size of heap memory for allocation */
+    size_t available_bytes;                         /*!< Number of available bytes for allocations */
+    size_t min_available_bytes;                     /*!< Minimum number of bytes ever */
+    uint32_t alloc_failures;                        /*!< Number of failed heap allocations */
+    gsm_mem_tag_stats_t tag_stats[GSM_MEM_TAG_END]; /*!< Heap usage per tag */
+#if GSM_CFG_MAX_INSTANCES > 1
+    uint8_t* start_addr;                            /*!< Start address of first region */
+    uint8_t* end_addr;                              /*!< End address of last region */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+#if GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_FIRST_FIT
+    mem_block_t start_block;                        /*!< First block data for allocations */
+    mem_block_t* end_block;                         /*!< Pointer to last block in linked list */
+#elif GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_TLSF
+    uint32_t fl_bitmap;                             /*!< Bit is set when first level has at least one free block */
+    uint8_t sl_bitmap[TLSF_FL_COUNT];               /*!< Bit is set when second level list is not empty */
+    tlsf_block_t* blocks[TLSF_FL_COUNT][TLSF_SL_COUNT]; /*!< Heads of free lists */
+    size_t free_blocks;                             /*!< Number of free blocks in all lists */
+#endif /* GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_TLSF */
+} mem_heap_t;
+#endif /* !__DOXYGEN__ */
+
+static mem_heap_t mem_heaps[GSM_CFG_MAX_INSTANCES]; /*!< Heap for each instance */
+static mem_heap_t* heap = &mem_heaps[0];            /*!< Active heap, valid only while memory is protected */
+
+/**
+ * \brief           Set active heap for next operation
+ * \note            Memory must be protected by caller
+ * \param[in]       ptr: Memory to operate on. Its region decides the heap.
+ *                      Set to `NULL` to use heap of currently selected instance
+ */
+static void
+mem_heap_select(const void* ptr) {
+#if GSM_CFG_MAX_INSTANCES > 1
+    heap = &mem_heaps[gsm_instance_get_index(NULL)];
+    if (ptr != NULL) {
+        for (size_t i = 0; i < GSM_CFG_MAX_INSTANCES; i++) {
+            if ((const uint8_t *)ptr >= mem_heaps[i].start_addr
+                && (const uint8_t *)ptr < mem_heaps[i].end_addr) {
+                heap = &mem_heaps[i];               /* Memory was allocated from this heap */
+                break;
+            }
+        }
+    }
+#else /* GSM_CFG_MAX_INSTANCES > 1 */
+    GSM_UNUSED(ptr);
+#endif /* !(GSM_CFG_MAX_INSTANCES > 1) */
+}
+
+/**
+ * \brief           Update statistics after block was allocated
+ * \param[in]       tag: Block tag
+ * \param[in]       size: Block size including metadata
+ */
+static void
+mem_stats_alloc(gsm_mem_tag_t tag, size_t size) {
+    gsm_mem_tag_stats_t* ts = &heap->tag_stats[tag];
+
+    ts->current += size;
+    if (ts->current > ts->peak) {
+        ts->peak = ts->current;
+    }
+    if (heap->available_bytes < heap->min_available_bytes) {    /* Check if current available memory is less than ever before */
+        heap->min_available_bytes = heap->available_bytes;  /* Update minimal available memory */
+    }
+}
+
+/**
+ * \brief           Update statistics after block was freed
+ * \param[in]       tag: Block tag
+ * \param[in]       size: Block size including metadata
+ */
+static void
+mem_stats_free(gsm_mem_tag_t tag, size_t size) {
+    heap->tag_stats[tag].current -= size;
+}
+
+/**
+ * \brief           Update statistics after allocation failed
+ * \param[in]       tag: Requested tag
+ */
+static void
+mem_stats_fail(gsm_mem_tag_t tag) {
+    heap->alloc_failures++;
+    heap->tag_stats[tag].failures++;
+}
+
+#if !__DOXYGEN__
+typedef union {
+    uint64_t u64;                                   /*!< Force alignment of pool memory */
+    size_t sz;
+    void* ptr;
+} mem_pool_word_t;
+
+typedef struct mem_pool_item {
+    struct mem_pool_item* next;                     /*!< Pointer to next free item */
+} mem_pool_item_t;
+
+typedef struct {
+    uint8_t* mem;                                   /*!< Pool memory */
+    size_t item_size;                               /*!< Size of single item, aligned */
+    size_t count;                                   /*!< Number of items in pool */
+    mem_pool_item_t* first_free;                    /*!< First free item in pool */
+    size_t used;                                    /*!< Number of items currently in use */
+    size_t peak;                                    /*!< Maximal number of items in use at the same time */
+    uint8_t initialized;                            /*!< Set to 1 when free list is created */
+} mem_pool_desc_t;
+#endif /* !__DOXYGEN__ */
+
+/**
+ * \brief           Define memory for pool
+ * \param[in]       name: Variable name
+ * \param[in]       size: Size of single item
+ * \param[in]       cnt: Number of items
+ */
+#define MEM_POOL_DEFINE(name, size, cnt)    static mem_pool_word_t name[(MEM_ALIGN(GSM_MAX(size, sizeof(mem_pool_item_t))) * (cnt) + sizeof(mem_pool_word_t) - 1) / sizeof(mem_pool_word_t)]
+#define MEM_POOL_ENTRY(name, size, cnt)     { (uint8_t *)(name), MEM_ALIGN(GSM_MAX(size, sizeof(mem_pool_item_t))), (cnt), NULL, 0, 0, 0 }
+#define MEM_POOL_ENTRY_EMPTY()              { NULL, 0, 0, NULL, 0, 0, 0 }
+
+#if GSM_CFG_MSG_POOL_SIZE
+MEM_POOL_DEFINE(mem_pool_msg, sizeof(gsm_msg_t), GSM_CFG_MSG_POOL_SIZE);
+#endif /* GSM_CFG_MSG_POOL_SIZE */
+#if GSM_CFG_PBUF_POOL_SIZE
+MEM_POOL_DEFINE(mem_pool_pbuf, MEM_ALIGN(sizeof(gsm_pbuf_t)) + GSM_CFG_PBUF_POOL_BUFF_SIZE, GSM_CFG_PBUF_POOL_SIZE);
+#endif /* GSM_CFG_PBUF_POOL_SIZE */
+#if GSM_CFG_TX_CHUNK_POOL_SIZE
+MEM_POOL_DEFINE(mem_pool_tx_chunk, GSM_CFG_CONN_MAX_DATA_LEN, GSM_CFG_TX_CHUNK_POOL_SIZE);
+#endif /* GSM_CFG_TX_CHUNK_POOL_SIZE */
+
+/**
+ * \brief           List of pools, in order of \ref gsm_mem_pool_t enumeration
+ */
+static mem_pool_desc_t
+mem_pools[GSM_MEM_POOL_END] = {
+#if GSM_CFG_MSG_POOL_SIZE
+    MEM_POOL_ENTRY(mem_pool_msg, sizeof(gsm_msg_t), GSM_CFG_MSG_POOL_SIZE),
+#else
+    MEM_POOL_ENTRY_EMPTY(),
+#endif /* !GSM_CFG_MSG_POOL_SIZE */
+#if GSM_CFG_PBUF_POOL_SIZE
+    MEM_POOL_ENTRY(mem_pool_pbuf, MEM_ALIGN(sizeof(gsm_pbuf_t)) + GSM_CFG_PBUF_POOL_BUFF_SIZE, GSM_CFG_PBUF_POOL_SIZE),
+#else
+    MEM_POOL_ENTRY_EMPTY(),
+#endif /* !GSM_CFG_PBUF_POOL_SIZE */
+#if GSM_CFG_TX_CHUNK_POOL_SIZE
+    MEM_POOL_ENTRY(mem_pool_tx_chunk, GSM_CFG_CONN_MAX_DATA_LEN, GSM_CFG_TX_CHUNK_POOL_SIZE),
+#else
+    MEM_POOL_ENTRY_EMPTY(),
+#endif /* !GSM_CFG_TX_CHUNK_POOL_SIZE */
+};
+
+/**
+ * \brief           Get item from memory pool
+ * \param[in]       pool: Pool descriptor
+ * \param[in]       size: Requested size in units of bytes
+ * \return          Pointer to item on success, `NULL` if pool is empty or size is too big
+ */
+static void *
+mem_pool_get(mem_pool_desc_t* pool, size_t size) {
+    mem_pool_item_t* item;
+
+    if (!pool->count || size > pool->item_size) {
+        return NULL;
+    }
+    if (!pool->initialized) {                       /* Create free list on first use */
+        for (size_t i = 0; i < pool->count; i++) {
+            item = (mem_pool_item_t *)(pool->mem + i * pool->item_size);
+            item->next = (i + 1) < pool->count ? (mem_pool_item_t *)(pool->mem + (i + 1) * pool->item_size) : NULL;
+        }
+        pool->first_free = (mem_pool_item_t *)pool->mem;
+        pool->initialized = 1;
+    }
+    item = pool->first_free;
+    if (item != NULL) {
+        pool->first_free = item->next;              /* Remove item from free list */
+        if (++pool->used > pool->peak) {
+            pool->peak = pool->used;
+        }
+    }
+    return item;
+}
+
+/**
+ * \brief           Return memory to pool if it belongs to any
+ * \param[in]       ptr: Memory to free
+ * \return          `1` if memory was part of pool, `0` otherwise
+ */
+static uint8_t
+mem_pool_put(void* ptr) {
+    mem_pool_item_t* item = ptr;
+
+    for (size_t i = 0; i < GSM_MEM_POOL_END; i++) {
+        mem_pool_desc_t* pool = &mem_pools[i];
+        if (pool->count && (uint8_t *)ptr >= pool->mem
+            && (uint8_t *)ptr < (pool->mem + pool->count * pool->item_size)) {
+            item->next = pool->first_free;          /* Put item back to free list */
+            pool->first_free = item;
+            pool->used--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+#if GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_FIRST_FIT || __DOXYGEN__
 
 #define MEMBLOCK_METASIZE           MEM_ALIGN(sizeof(mem_block_t))
 
 #define MEM_BLOCK_FROM_PTR(ptr)     ((mem_block_t *)(((uint8_t *)(ptr)) - MEMBLOCK_METASIZE))
-#define MEM_BLOCK_USER_SIZE(ptr)    ((MEM_BLOCK_FROM_PTR(ptr)->size & ~mem_alloc_bit) - MEMBLOCK_METASIZE)
-    
-static mem_block_t start_block;                     /*!< First block data for allocations */
-static mem_block_t* end_block = NULL;               /*!< Pointer to last block in linked list */
-static size_t mem_total_size = 0;                   /*!< Total size of heap memory for allocation */
-static size_t mem_available_bytes = 0;              /*!< Number of available bytes for allocations */
-static size_t mem_min_available_bytes = 0;          /*!< Minimum number of bytes ever */
+#define MEM_BLOCK_SIZE(block)       ((block)->size & ~(mem_alloc_bit | MEM_TAG_MASK))
+#define MEM_BLOCK_USER_SIZE(ptr)    (MEM_BLOCK_SIZE(MEM_BLOCK_FROM_PTR(ptr)) - MEMBLOCK_METASIZE)
+
 static size_t mem_alloc_bit = 0;                    /*!< Bit indicating block is allocated */
 
 /**
@@ -69,7 +311,7 @@ mem_insertfreeblock(mem_block_t* nb) {
     uint8_t* addr;
 
     /* Find block position to insert new block between */
-    for (ptr = &start_block; ptr != NULL && ptr->next < nb; ptr = ptr->next);
+    for (ptr = &heap->start_block; ptr != NULL && ptr->next < nb; ptr = ptr->next);
 
     /*
      * If the new inserted block and block before create a one big block (contiguous)
@@ -84,8 +326,8 @@ mem_insertfreeblock(mem_block_t* nb) {
     /* Check if new block and its size is the same address as next free block newBlock points to */
     addr = (uint8_t *)nb;
     if ((uint8_t *)(addr + nb->size) == (uint8_t *)ptr->next) {
-        if (ptr->next == end_block) {               /* Does it points to the end? */
-            nb->next = end_block;                   /* Set end block pointer */
+        if (ptr->next == heap->end_block) {         /* Does it points to the end? */
+            nb->next = heap->end_block;             /* Set end block pointer */
         } else {
             nb->size += ptr->next->size;            /* Expand of current block for size of next free block which is right behind new block */
             nb->next = ptr->next->next;             /* Next free is pointed to the next one of previous next */
@@ -119,7 +361,7 @@ mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
     mem_block_t* prev_end_block = NULL;
     size_t i;
     
-    if (end_block != NULL) {                        /* Regions already defined */
+    if (heap->end_block != NULL) {                  /* Regions already defined */
         return 0;
     }
     
@@ -153,6 +395,9 @@ mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
         if (mem_size & MEM_ALIGN_BITS) {
             mem_size &= ~MEM_ALIGN_BITS;            /* Clear lower bits of memory size only */
         }
+        if (mem_size >= MEM_SIZE_LIMIT) {           /* Upper bits of size are used for tag */
+            mem_size = MEM_SIZE_LIMIT - MEM_ALIGN_NUM;
+        }
 
         /*
          * StartBlock is fixed variable for start list of free blocks
@@ -161,20 +406,20 @@ mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
          *
          * Set Start block only if end block is not yet defined = first run
          */
-        if (end_block == NULL) {
-            start_block.next = (mem_block_t *)mem_start_addr;
-            start_block.size = 0;
+        if (heap->end_block == NULL) {
+            heap->start_block.next = (mem_block_t *)mem_start_addr;
+            heap->start_block.size = 0;
         }
         
-        prev_end_block = end_block;                 /* Save previous end block to set next block later */
+        prev_end_block = heap->end_block;           /* Save previous end block to set next block later */
         
         /*
          * Set pointer to end of free memory - block region memory
          * Calculate new end block in region
          */
-        end_block = (mem_block_t *)((uint8_t *)mem_start_addr + mem_size - MEMBLOCK_METASIZE);
-        end_block->next = NULL;                     /* No more free blocks after end is reached */
-        end_block->size = 0;                        /* Empty block */
+        heap->end_block = (mem_block_t *)((uint8_t *)mem_start_addr + mem_size - MEMBLOCK_METASIZE);
+        heap->end_block->next = NULL;               /* No more free blocks after end is reached */
+        heap->end_block->size = 0;                  /* Empty block */
 
         /*
          * Initialize start of region memory
@@ -182,7 +427,7 @@ mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
          */
         first_block = (mem_block_t *)mem_start_addr;
         first_block->size = mem_size - MEMBLOCK_METASIZE; /* Exclude end block in chain */
-        first_block->next = end_block;              /* Last block is next free in chain */
+        first_block->next = heap->end_block;        /* Last block is next free in chain */
 
         /*
          * If we have previous end block
@@ -195,11 +440,12 @@ mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
         }
         
         /* Set number of free bytes available to allocate in region */
-        mem_available_bytes += first_block->size;
+        heap->available_bytes += first_block->size;
+        heap->total_size += first_block->size;
         
         regions++;                                  /* Go to next region */
     }
-    mem_min_available_bytes = mem_available_bytes;  /* Save minimum ever available bytes in region */
+    heap->min_available_bytes = heap->available_bytes;  /* Save minimum ever available bytes in region */
     
     /* Set upper bit in memory allocation bit */
     mem_alloc_bit = GSM_SZ(GSM_SZ(1) << (sizeof(size_t) * 8 - 1));
@@ -210,23 +456,24 @@ mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
 /**
  * \brief           Allocate memory of specific size
  * \param[in]       size: Number of bytes to allocate
+ * \param[in]       tag: Allocation tag
  * \return          NULL on failure or memory address on success
  */
 static void *
-mem_alloc(size_t size) {
+mem_alloc(size_t size, gsm_mem_tag_t tag) {
     mem_block_t *prev, *curr, *next;
     void* retval = 0;
 
-    if (end_block == NULL) {                        /* If end block is not yet defined */
+    if (heap->end_block == NULL) {                  /* If end block is not yet defined */
         return NULL;                                /* Invalid, not initialized */
     }
       
-    if (!size || size >= mem_alloc_bit) {           /* Check input parameters */
+    if (!size || size >= MEM_SIZE_LIMIT) {          /* Check input parameters */
         return 0;
     }
 
     size = MEM_ALIGN(size) + MEMBLOCK_METASIZE;     /* Increase size for metadata */
-    if (size > mem_available_bytes) {               /* Check if we have enough memory available */
+    if (size > heap->available_bytes) {             /* Check if we have enough memory available */
         return 0;
     }
 
@@ -235,7 +482,7 @@ mem_alloc(size_t size) {
      * Go through free blocks until enough memory is found
      * or end block is reached (no next free block)
      */
-    prev = &start_block;                            /* Set first first block as previous */
+    prev = &heap->start_block;                      /* Set first first block as previous */
     curr = prev->next;                              /* Set next block as current */
     while ((curr->size < size) && (curr->next != NULL)) {
         prev = curr;
@@ -248,7 +495,7 @@ mem_alloc(size_t size) {
      * 
      * Feature may be very risky later because of fragmentation
      */
-    if (curr != end_block) {                        /* We found empty block of enough memory available */
+    if (curr != heap->end_block) {                  /* We found empty block of enough memory available */
         retval = (void *)((uint8_t *)prev->next + MEMBLOCK_METASIZE);    /* Set return value */
         prev->next = curr->next;  /* Since block is now allocated, remove it from free chain */
 
@@ -268,13 +515,10 @@ mem_alloc(size_t size) {
              */
             mem_insertfreeblock(next);              /* Insert free memory block to list of free memory blocks (linked list chain) */
         }
-        curr->size |= mem_alloc_bit;                /* Set allocated bit = memory is allocated */
+        heap->available_bytes -= curr->size;        /* Decrease available memory, block may be bigger than requested */
+        mem_stats_alloc(tag, curr->size);
+        curr->size |= mem_alloc_bit | MEM_TAG_TO_SIZE(tag); /* Set allocated bit = memory is allocated */
         curr->next = NULL;                          /* Clear next free block pointer as there is no one */
-
-        mem_available_bytes -= size;                /* Decrease available memory */
-        if (mem_available_bytes < mem_min_available_bytes) {    /* Check if current available memory is less than ever before */
-            mem_min_available_bytes = mem_available_bytes;  /* Update minimal available memory */
-        }
     } else {
         /* Allocation failed, no free blocks of required size */
     }
@@ -304,8 +548,9 @@ mem_free(void* ptr) {
          * Clear allocated bit before entering back to free list
          * List will automatically take care for fragmentation and mix segments back
          */
-        block->size &= ~mem_alloc_bit;              /* Clear allocated bit */
-        mem_available_bytes += block->size;         /* Increase available bytes back */
+        mem_stats_free(MEM_TAG_FROM_SIZE(block->size), MEM_BLOCK_SIZE(block));
+        block->size = MEM_BLOCK_SIZE(block);        /* Clear allocated bit and tag */
+        heap->available_bytes += block->size;       /* Increase available bytes back */
         /* memset(ptr, 0x00, block->size - MEMBLOCK_METASIZE); */ 
         mem_insertfreeblock(block);                 /* Insert block to list of free blocks */
     }
@@ -324,18 +569,401 @@ mem_getusersize(void* ptr) {
     return MEM_BLOCK_USER_SIZE(ptr);
 }
 
+/**
+ * \brief           Get tag of allocated block
+ * \param[in]       ptr: Memory address
+ * \return          Block tag
+ */
+static gsm_mem_tag_t
+mem_gettag(void* ptr) {
+    return MEM_TAG_FROM_SIZE(MEM_BLOCK_FROM_PTR(ptr)->size);
+}
+
+/**
+ * \brief           Get number of free blocks and size of largest one
+ * \param[out]      largest: Size of largest free block, including metadata
+ * \return          Number of free blocks
+ */
+static size_t
+mem_getfreeblocks(size_t* largest) {
+    mem_block_t* b;
+    size_t cnt = 0;
+
+    *largest = 0;
+    if (heap->end_block == NULL) {
+        return 0;
+    }
+    for (b = heap->start_block.next; b != NULL; b = b->next) {
+        if (b->size) {                              /* End blocks of regions are empty */
+            cnt++;
+            *largest = GSM_MAX(*largest, b->size);
+        }
+    }
+    return cnt;
+}
+
+#elif GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_TLSF
+
+/**
+ * \brief           Alignment of blocks, at least size of pointer to keep metadata aligned
+ */
+#define TLSF_ALIGN_NUM              GSM_MAX(MEM_ALIGN_NUM, GSM_SZ(sizeof(void *)))
+#define TLSF_ALIGN(x)               ((GSM_SZ(x) + (TLSF_ALIGN_NUM - 1)) & ~(TLSF_ALIGN_NUM - 1))
+
+#define TLSF_BLOCK_METASIZE         TLSF_ALIGN(sizeof(tlsf_block_t *) + sizeof(size_t))  /* Used block keeps only first 2 members */
+#define TLSF_BLOCK_MIN_SIZE         TLSF_ALIGN(sizeof(tlsf_block_t))
+#define TLSF_BLOCK_FREE_BIT         GSM_SZ(0x01)
+
+#define TLSF_BLOCK_SIZE(b)          ((b)->size & ~(TLSF_BLOCK_FREE_BIT | MEM_TAG_MASK))
+#define TLSF_BLOCK_IS_FREE(b)       ((b)->size & TLSF_BLOCK_FREE_BIT)
+#define TLSF_BLOCK_NEXT(b)          ((tlsf_block_t *)((uint8_t *)(b) + TLSF_BLOCK_SIZE(b)))
+#define TLSF_BLOCK_FROM_PTR(ptr)    ((tlsf_block_t *)((uint8_t *)(ptr) - TLSF_BLOCK_METASIZE))
+#define TLSF_BLOCK_TO_PTR(b)        ((void *)((uint8_t *)(b) + TLSF_BLOCK_METASIZE))
+
+#define TLSF_SMALL_SIZE             (GSM_SZ(1) << TLSF_FL_SHIFT)
+#define TLSF_BLOCK_MAX_SIZE         ((GSM_SZ(1) << TLSF_FL_MAX_LOG2) - TLSF_ALIGN_NUM)
+
+/**
+ * \brief           Get index of most significant set bit
+ * \param[in]       x: Input value, must not be `0`
+ * \return          Bit index
+ */
+static uint8_t
+tlsf_fls(size_t x) {
+#if defined(__GNUC__)
+    return (uint8_t)(sizeof(unsigned long) * 8 - 1 - __builtin_clzl((unsigned long)x));
+#else
+    uint8_t bit = 0;
+    while (x >>= 1) {
+        bit++;
+    }
+    return bit;
+#endif /* !defined(__GNUC__) */
+}
+
+/**
+ * \brief           Get index of least significant set bit
+ * \param[in]       x: Input value, must not be `0`
+ * \return          Bit index
+ */
+static uint8_t
+tlsf_ffs(uint32_t x) {
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctz(x);
+#else
+    uint8_t bit = 0;
+    while (!(x & 0x01)) {
+        x >>= 1;
+        bit++;
+    }
+    return bit;
+#endif /* !defined(__GNUC__) */
+}
+
+/**
+ * \brief           Get first and second level list indexes for block size
+ * \param[in]       size: Block size in units of bytes
+ * \param[out]      fl: First level index
+ * \param[out]      sl: Second level index
+ */
+static void
+tlsf_mapping(size_t size, uint8_t* fl, uint8_t* sl) {
+    if (size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = (uint8_t)(size / (TLSF_SMALL_SIZE / TLSF_SL_COUNT));
+    } else {
+        uint8_t f = tlsf_fls(size);
+        *sl = (uint8_t)((size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT);
+        *fl = (uint8_t)(f - (TLSF_FL_SHIFT - 1));
+    }
+}
+
+/**
+ * \brief           Insert free block to its size class list
+ * \param[in]       b: Block to insert
+ */
+static void
+tlsf_insert(tlsf_block_t* b) {
+    uint8_t fl, sl;
+
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+    b->prev_free = NULL;
+    b->next_free = heap->blocks[fl][sl];
+    if (b->next_free != NULL) {
+        b->next_free->prev_free = b;
+    }
+    heap->blocks[fl][sl] = b;
+    heap->fl_bitmap |= GSM_U32(1) << fl;
+    heap->sl_bitmap[fl] |= (uint8_t)(1 << sl);
+    heap->free_blocks++;
+}
+
+/**
+ * \brief           Remove free block from its size class list
+ * \param[in]       b: Block to remove
+ */
+static void
+tlsf_remove(tlsf_block_t* b) {
+    uint8_t fl, sl;
+
+    tlsf_mapping(TLSF_BLOCK_SIZE(b), &fl, &sl);
+    heap->free_blocks--;
+    if (b->next_free != NULL) {
+        b->next_free->prev_free = b->prev_free;
+    }
+    if (b->prev_free != NULL) {
+        b->prev_free->next_free = b->next_free;
+    } else {
+        heap->blocks[fl][sl] = b->next_free;
+        if (b->next_free == NULL) {                 /* List is now empty */
+            heap->sl_bitmap[fl] &= (uint8_t)~(1 << sl);
+            if (!heap->sl_bitmap[fl]) {
+                heap->fl_bitmap &= ~(GSM_U32(1) << fl);
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Find free block with at least `size` bytes
+ * \note            When no list guarantees enough memory, list of requested
+ *                  size is searched linearly before allocation fails
+ * \param[in]       size: Block size including metadata
+ * \return          Pointer to free block or `NULL` if not available
+ */
+static tlsf_block_t *
+tlsf_find(size_t size) {
+    tlsf_block_t* b;
+    size_t rsize = size;
+    uint8_t fl, sl;
+    uint32_t map;
+
+    /*
+     * Round size up to next list, so that
+     * any block in found list is big enough
+     */
+    if (rsize >= TLSF_SMALL_SIZE) {
+        rsize += (GSM_SZ(1) << (tlsf_fls(rsize) - TLSF_SL_LOG2)) - 1;
+    }
+    if (rsize <= TLSF_BLOCK_MAX_SIZE) {
+        tlsf_mapping(rsize, &fl, &sl);
+        map = heap->sl_bitmap[fl] & (~GSM_U32(0) << sl);
+        if (!map) {                                 /* No block in this first level, go to bigger one */
+            map = fl + 1 < TLSF_FL_COUNT ? (heap->fl_bitmap & (~GSM_U32(0) << (fl + 1))) : 0;
+            if (map) {
+                fl = tlsf_ffs(map);
+                map = heap->sl_bitmap[fl];
+            }
+        }
+        if (map) {
+            return heap->blocks[fl][tlsf_ffs(map)];
+        }
+    }
+
+    /* Last chance, check blocks in list of not rounded size */
+    tlsf_mapping(size, &fl, &sl);
+    for (b = heap->blocks[fl][sl]; b != NULL && TLSF_BLOCK_SIZE(b) < size; b = b->next_free);
+    return b;
+}
+
+/**
+ * \brief           Assign memory for HEAP allocations
+ * \param[in]       regions: Pointer to list of regions.
+ *                  Set regions in ascending order by address
+ * \param[in]       len: Number of regions to assign
+ */
+static uint8_t
+mem_assignmem(const gsm_mem_region_t* regions, size_t len) {
+    uint8_t* mem_start_addr;
+    size_t mem_size, i;
+    tlsf_block_t *first_block, *last_block;
+
+    if (heap->total_size) {                         /* Regions already defined */
+        return 0;
+    }
+
+    /* Check if region address are linear and rising */
+    mem_start_addr = (uint8_t *)0;
+    for (i = 0; i < len; i++) {
+        if (mem_start_addr >= (uint8_t *)regions[i].start_addr) {
+            return 0;
+        }
+        mem_start_addr = (uint8_t *)regions[i].start_addr;
+    }
+
+    for (; len--; regions++) {
+        /* Align start address and size of region */
+        mem_start_addr = (uint8_t *)TLSF_ALIGN(regions->start_addr);
+        if (GSM_SZ(mem_start_addr - (uint8_t *)regions->start_addr) >= regions->size) {
+            continue;
+        }
+        mem_size = (regions->size - GSM_SZ(mem_start_addr - (uint8_t *)regions->start_addr)) & ~(TLSF_ALIGN_NUM - 1);
+        if (mem_size < (TLSF_BLOCK_MIN_SIZE + TLSF_BLOCK_METASIZE)) {
+            continue;
+        }
+        mem_size -= TLSF_BLOCK_METASIZE;            /* Reserve space for last block in region */
+        if (mem_size > TLSF_BLOCK_MAX_SIZE) {
+            mem_size = TLSF_BLOCK_MAX_SIZE;
+        }
+
+        /* Create one free block over entire region */
+        first_block = (tlsf_block_t *)mem_start_addr;
+        first_block->prev_phys = NULL;
+        first_block->size = mem_size | TLSF_BLOCK_FREE_BIT;
+
+        /* Last block has size 0 and is never free, so blocks never merge across regions */
+        last_block = TLSF_BLOCK_NEXT(first_block);
+        last_block->prev_phys = first_block;
+        last_block->size = 0;
+
+        tlsf_insert(first_block);
+        heap->available_bytes += mem_size;
+        heap->total_size += mem_size;
+    }
+    heap->min_available_bytes = heap->available_bytes;  /* Save minimum ever available bytes in region */
+
+    return 1;
+}
+
 /**
  * \brief           Allocate memory of specific size
  * \param[in]       size: Number of bytes to allocate
+ * \param[in]       tag: Allocation tag
+ * \return          NULL on failure or memory address on success
+ */
+static void *
+mem_alloc(size_t size, gsm_mem_tag_t tag) {
+    tlsf_block_t *block, *rem;
+
+    if (!heap->total_size || !size || size > TLSF_BLOCK_MAX_SIZE) {
+        return NULL;
+    }
+    size = GSM_MAX(TLSF_ALIGN(size) + TLSF_BLOCK_METASIZE, TLSF_BLOCK_MIN_SIZE);
+    if (size > TLSF_BLOCK_MAX_SIZE || size > heap->available_bytes
+        || (block = tlsf_find(size)) == NULL) {
+        return NULL;
+    }
+    tlsf_remove(block);
+
+    /* Split block if remaining part is big enough for new block */
+    if ((TLSF_BLOCK_SIZE(block) - size) >= TLSF_BLOCK_MIN_SIZE) {
+        rem = (tlsf_block_t *)((uint8_t *)block + size);
+        rem->size = TLSF_BLOCK_SIZE(block) - size;
+        rem->prev_phys = block;
+        TLSF_BLOCK_NEXT(rem)->prev_phys = rem;
+        rem->size |= TLSF_BLOCK_FREE_BIT;
+        tlsf_insert(rem);
+        block->size = size;
+    } else {
+        block->size = TLSF_BLOCK_SIZE(block);       /* Clear free bit */
+    }
+
+    heap->available_bytes -= block->size;
+    mem_stats_alloc(tag, block->size);
+    block->size |= MEM_TAG_TO_SIZE(tag);
+    return TLSF_BLOCK_TO_PTR(block);
+}
+
+/**
+ * \brief           Free memory
+ * \param[in]       ptr: Pointer to memory previously returned using \ref gsm_mem_alloc, \ref gsm_mem_calloc or \ref gsm_mem_realloc functions
+ */
+static void
+mem_free(void* ptr) {
+    tlsf_block_t *block, *prev, *next;
+
+    if (ptr == NULL) {
+        return;
+    }
+    block = TLSF_BLOCK_FROM_PTR(ptr);
+    if (TLSF_BLOCK_IS_FREE(block) || TLSF_BLOCK_SIZE(block) < TLSF_BLOCK_MIN_SIZE) {
+        return;                                     /* Block is not allocated */
+    }
+    mem_stats_free(MEM_TAG_FROM_SIZE(block->size), TLSF_BLOCK_SIZE(block));
+    block->size = TLSF_BLOCK_SIZE(block);           /* Clear tag */
+    heap->available_bytes += block->size;
+
+    /* Merge with previous and next physical blocks if they are free */
+    prev = block->prev_phys;
+    if (prev != NULL && TLSF_BLOCK_IS_FREE(prev)) {
+        tlsf_remove(prev);
+        prev->size = TLSF_BLOCK_SIZE(prev) + block->size;
+        block = prev;
+    }
+    next = TLSF_BLOCK_NEXT(block);
+    if (TLSF_BLOCK_IS_FREE(next)) {
+        tlsf_remove(next);
+        block->size += TLSF_BLOCK_SIZE(next);
+        next = TLSF_BLOCK_NEXT(block);
+    }
+    next->prev_phys = block;
+    block->size |= TLSF_BLOCK_FREE_BIT;
+    tlsf_insert(block);
+}
+
+/**
+ * \brief           Get block size in units of bytes
+ * \param[in]       ptr: Memory address
+ * \return          0 on failure or number of bytes on success
+ */
+static size_t
+mem_getusersize(void* ptr) {
+    if (ptr == NULL) {
+        return 0;
+    }
+    return TLSF_BLOCK_SIZE(TLSF_BLOCK_FROM_PTR(ptr)) - TLSF_BLOCK_METASIZE;
+}
+
+/**
+ * \brief           Get tag of allocated block
+ * \param[in]       ptr: Memory address
+ * \return          Block tag
+ */
+static gsm_mem_tag_t
+mem_gettag(void* ptr) {
+    return MEM_TAG_FROM_SIZE(TLSF_BLOCK_FROM_PTR(ptr)->size);
+}
+
+/**
+ * \brief           Get number of free blocks and size of largest one
+ * \param[out]      largest: Size of largest free block, including metadata
+ * \return          Number of free blocks
+ */
+static size_t
+mem_getfreeblocks(size_t* largest) {
+    tlsf_block_t* b;
+    uint8_t fl;
+
+    *largest = 0;
+    if (heap->fl_bitmap) {                          /* Largest block is in highest non-empty list */
+        fl = tlsf_fls(heap->fl_bitmap);
+        for (b = heap->blocks[fl][tlsf_fls(heap->sl_bitmap[fl])]; b != NULL; b = b->next_free) {
+            *largest = GSM_MAX(*largest, TLSF_BLOCK_SIZE(b));
+        }
+    }
+    return heap->free_blocks;
+}
+
+#else
+#error "GSM_CFG_MEM_ALLOCATOR has invalid value"
+#endif /* GSM_CFG_MEM_ALLOCATOR == GSM_MEM_ALLOCATOR_TLSF */
+
+/**
+ * \brief           Allocate memory of specific size
+ * \param[in]       num: Number of elements to allocate
+ * \param[in]       size: Size of each element
+ * \param[in]       tag: Allocation tag
  * \return          NULL on failure or memory address on success
  */
 static void *
-mem_calloc(size_t num, size_t size) {
+mem_calloc(size_t num, size_t size, gsm_mem_tag_t tag) {
     void* ptr;
     size_t tot_len = num * size;
     
-    if ((ptr = mem_alloc(tot_len)) != NULL) {       /* Try to allocate memory */
+    if ((ptr = mem_alloc(tot_len, tag)) != NULL) {  /* Try to allocate memory */
         memset(ptr, 0x00, tot_len);                 /* Reset entire memory */
+    } else {
+        mem_stats_fail(tag);
     }
     return ptr;
 }
@@ -351,18 +979,24 @@ static void *
 mem_realloc(void* ptr, size_t size) {
     void* newPtr;
     size_t oldSize;
+    gsm_mem_tag_t tag;
     
     if (ptr == NULL) {                              /* If pointer is not valid */
-        return mem_alloc(size);                     /* Only allocate memory */
+        if ((newPtr = mem_alloc(size, GSM_MEM_TAG_USER)) == NULL) { /* Only allocate memory */
+            mem_stats_fail(GSM_MEM_TAG_USER);
+        }
+        return newPtr;
     }
     
     oldSize = mem_getusersize(ptr);                 /* Get size of old pointer */
-    newPtr = mem_alloc(size);                       /* Try to allocate new memory block */
+    tag = mem_gettag(ptr);
+    newPtr = mem_alloc(size, tag);                  /* Try to allocate new memory block with the same tag */
     if (newPtr != NULL) {                           /* Check success */
         memcpy(newPtr, ptr, size > oldSize ? oldSize : size);   /* Copy old data to new array */
         mem_free(ptr);                              /* Free old pointer */
         return newPtr;                              /* Return new pointer */
     }
+    mem_stats_fail(tag);
     return NULL;
 }
 
@@ -372,7 +1006,7 @@ mem_realloc(void* ptr, size_t size) {
  */
 static size_t
 mem_getfree(void) {
-    return mem_available_bytes;                     /* Return free bytes available for allocation */
+    return heap->available_bytes;                   /* Return free bytes available for allocation */
 }
 
 /**
@@ -381,7 +1015,7 @@ mem_getfree(void) {
  */
 static size_t
 mem_getfull(void) {
-    return mem_total_size - mem_available_bytes;    /* Return remaining bytes */
+    return heap->total_size - heap->available_bytes;    /* Return remaining bytes */
 }
 
 /**
@@ -390,7 +1024,7 @@ mem_getfull(void) {
  */
 static size_t
 mem_getminfree(void) {
-    return mem_min_available_bytes;                 /* Return minimal bytes ever available */
+    return heap->min_available_bytes;               /* Return minimal bytes ever available */
 }
 
 /**
@@ -400,27 +1034,71 @@ mem_getminfree(void) {
  */
 void *
 gsm_mem_alloc(uint32_t size) {
+    return gsm_mem_alloc_tag(GSM_MEM_TAG_USER, size);
+}
+
+/**
+ * \brief           Allocate memory of specific size and account it to subsystem
+ * \note            Memory is set to zero
+ * \param[in]       tag: Subsystem tag. Member of \ref gsm_mem_tag_t enumeration
+ * \param[in]       size: Number of bytes to allocate
+ * \return          NULL on failure or memory address on success
+ */
+void *
+gsm_mem_alloc_tag(gsm_mem_tag_t tag, size_t size) {
     void* ptr;
-    GSM_CORE_PROTECT();
-    ptr = mem_calloc(1, size);                      /* Allocate memory and return pointer */
-    GSM_CORE_UNPROTECT();
-    GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr == NULL, "MEM: Allocation failed: %d bytes\r\n", (int)size);
-    GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr != NULL, "MEM: Allocation OK: %d bytes, addr: %p\r\n", (int)size, ptr);
+
+    if (tag >= GSM_MEM_TAG_END) {
+        tag = GSM_MEM_TAG_USER;
+    }
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    ptr = mem_calloc(1, size, tag);                 /* Allocate memory and return pointer */
+    GSM_MEM_UNPROTECT();
+    GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr == NULL, "MEM: Allocation failed: %d bytes, tag: %d\r\n", (int)size, (int)tag);
+    GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr != NULL, "MEM: Allocation OK: %d bytes, tag: %d, addr: %p\r\n", (int)size, (int)tag, ptr);
     return ptr;
 }
 
+/**
+ * \brief           Allocate memory from pool, or from heap if pool is empty
+ * \note            Memory is set to zero and must be freed with \ref gsm_mem_free
+ * \param[in]       pool: Pool to allocate from. Member of \ref gsm_mem_pool_t enumeration
+ * \param[in]       tag: Subsystem tag used when memory is allocated from heap
+ * \param[in]       size: Number of bytes to allocate
+ * \return          NULL on failure or memory address on success
+ */
+void *
+gsm_mem_pool_alloc(gsm_mem_pool_t pool, gsm_mem_tag_t tag, size_t size) {
+    void* ptr = NULL;
+
+    if (pool < GSM_MEM_POOL_END) {
+        GSM_MEM_PROTECT();
+        ptr = mem_pool_get(&mem_pools[pool], size);
+        GSM_MEM_UNPROTECT();
+    }
+    if (ptr != NULL) {
+        GSM_MEMSET(ptr, 0x00, size);
+        GSM_DEBUGF(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, "MEM: Pool %d allocation OK: %d bytes, addr: %p\r\n", (int)pool, (int)size, ptr);
+        return ptr;
+    }
+    return gsm_mem_alloc_tag(tag, size);            /* Use heap as fallback */
+}
+
 /**
  * \brief           Reallocate memory to specific size
  * \note            After new memory is allocated, content of old one is copied to new memory
+ * \note            Memory allocated from pool can not be reallocated
  * \param[in]       ptr: Pointer to current allocated memory to resize, returned using \ref gsm_mem_alloc, \ref gsm_mem_calloc or \ref gsm_mem_realloc functions
  * \param[in]       size: Number of bytes to allocate on new memory
  * \return          NULL on failure or memory address on success
  */
 void *
 gsm_mem_realloc(void* ptr, size_t size) {
-    GSM_CORE_PROTECT();
+    GSM_MEM_PROTECT();
+    mem_heap_select(ptr);                           /* New memory is allocated from the same heap */
     ptr = mem_realloc(ptr, size);                   /* Reallocate and return pointer */
-    GSM_CORE_UNPROTECT();
+    GSM_MEM_UNPROTECT();
     GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr == NULL, "MEM: Reallocation failed: %d bytes\r\n", (int)size);
     GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr != NULL, "MEM: Reallocation OK: %d bytes, addr: %p\r\n", (int)size, ptr);
     return ptr;
@@ -435,9 +1113,10 @@ gsm_mem_realloc(void* ptr, size_t size) {
 void *
 gsm_mem_calloc(size_t num, size_t size) {
     void* ptr;
-    GSM_CORE_PROTECT();
-    ptr = mem_calloc(num, size);                   /* Allocate memory and clear it to 0. Then return pointer */
-    GSM_CORE_UNPROTECT();
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    ptr = mem_calloc(num, size, GSM_MEM_TAG_USER); /* Allocate memory and clear it to 0. Then return pointer */
+    GSM_MEM_UNPROTECT();
     GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr == NULL, "MEM: Callocation failed: %d bytes\r\n", (int)size * (int)num);
     GSM_DEBUGW(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, ptr != NULL, "MEM: Callocation OK: %d bytes, addr: %p\r\n", (int)size * (int)num, ptr);
     return ptr;
@@ -449,11 +1128,19 @@ gsm_mem_calloc(size_t num, size_t size) {
  */
 void
 gsm_mem_free(void* ptr) {
-    GSM_DEBUGF(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, "MEM: Free size: %d, address: %p\r\n",
-        (int)MEM_BLOCK_USER_SIZE(ptr), ptr);
-    GSM_CORE_PROTECT();
-    mem_free(ptr);                                  /* Free already allocated memory */
-    GSM_CORE_UNPROTECT();
+    if (ptr == NULL) {
+        return;
+    }
+    GSM_MEM_PROTECT();
+    if (mem_pool_put(ptr)) {                        /* Was memory part of pool? */
+        GSM_DEBUGF(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, "MEM: Free to pool, address: %p\r\n", ptr);
+    } else {
+        mem_heap_select(ptr);                       /* Return memory to heap it was allocated from */
+        GSM_DEBUGF(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE, "MEM: Free size: %d, address: %p\r\n",
+            (int)mem_getusersize(ptr), ptr);
+        mem_free(ptr);                              /* Free already allocated memory */
+    }
+    GSM_MEM_UNPROTECT();
 }
 
 /**
@@ -462,7 +1149,13 @@ gsm_mem_free(void* ptr) {
  */
 size_t
 gsm_mem_getfree(void) {
-    return mem_getfree();                           /* Get free bytes available to allocate */
+    size_t res;
+
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    res = mem_getfree();                           /* Get free bytes available to allocate */
+    GSM_MEM_UNPROTECT();
+    return res;
 }
 
 /**
@@ -471,7 +1164,13 @@ gsm_mem_getfree(void) {
  */
 size_t
 gsm_mem_getfull(void) {
-    return mem_getfull();                           /* Get number of bytes allocated already */
+    size_t res;
+
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    res = mem_getfull();                           /* Get number of bytes allocated already */
+    GSM_MEM_UNPROTECT();
+    return res;
 }
 
 /**
@@ -480,12 +1179,76 @@ gsm_mem_getfull(void) {
  */
 size_t
 gsm_mem_getminfree(void) {
-    return mem_getminfree();                        /* Get minimal number of bytes ever available for allocation */
+    size_t res;
+
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    res = mem_getminfree();                        /* Get minimal number of bytes ever available for allocation */
+    GSM_MEM_UNPROTECT();
+    return res;
+}
+
+/**
+ * \brief           Get heap and pool statistics
+ * \note            Function walks free blocks to find largest one
+ *                  and is intended for periodic polling
+ * \note            Heap statistics are for currently selected instance,
+ *                  pools are shared between all instances
+ * \param[out]      stats: Pointer to structure to fill
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsm_mem_getstats(gsm_mem_stats_t* stats) {
+    size_t i;
+
+    if (stats == NULL) {
+        return 0;
+    }
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    stats->total = heap->total_size;
+    stats->free = heap->available_bytes;
+    stats->min_free = heap->min_available_bytes;
+    stats->free_blocks = mem_getfreeblocks(&stats->largest_free_block);
+    stats->alloc_failures = heap->alloc_failures;
+    for (i = 0; i < GSM_MEM_TAG_END; i++) {
+        stats->tags[i] = heap->tag_stats[i];
+    }
+    for (i = 0; i < GSM_MEM_POOL_END; i++) {
+        stats->pools[i].count = mem_pools[i].count;
+        stats->pools[i].used = mem_pools[i].used;
+        stats->pools[i].peak = mem_pools[i].peak;
+    }
+    GSM_MEM_UNPROTECT();
+    return 1;
+}
+
+/**
+ * \brief           Restart peak tracking from current heap and pool usage
+ *
+ *                  Use it to measure peak usage of single part of application,
+ *                  such as one benchmark scenario
+ */
+void
+gsm_mem_reset_peak(void) {
+    size_t i;
+
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
+    heap->min_available_bytes = heap->available_bytes;
+    for (i = 0; i < GSM_MEM_TAG_END; i++) {
+        heap->tag_stats[i].peak = heap->tag_stats[i].current;
+    }
+    for (i = 0; i < GSM_MEM_POOL_END; i++) {
+        mem_pools[i].peak = mem_pools[i].used;
+    }
+    GSM_MEM_UNPROTECT();
 }
 
 /**
  * \brief           Assign memory region(s) for allocation functions
  * \note            You can allocate multiple regions by assigning start address and region size in units of bytes
+ * \note            Regions are assigned to heap of currently selected instance
  * \param[in]       regions: Pointer to list of regions to use for allocations
  * \param[in]       len: Number of regions to use
  * \return          1 on success, 0 otherwise
@@ -493,6 +1256,16 @@ gsm_mem_getminfree(void) {
 uint8_t
 gsm_mem_assignmemory(const gsm_mem_region_t* regions, size_t len) {
     uint8_t ret;
+
+    GSM_MEM_PROTECT();
+    mem_heap_select(NULL);
     ret = mem_assignmem(regions, len);              /* Assign memory */
-    return ret;                                     
+#if GSM_CFG_MAX_INSTANCES > 1
+    if (ret && len) {                               /* Keep address range to find heap on free */
+        heap->start_addr = (uint8_t *)regions[0].start_addr;
+        heap->end_addr = (uint8_t *)regions[len - 1].start_addr + regions[len - 1].size;
+    }
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    GSM_MEM_UNPROTECT();
+    return ret;
 }
@@ -71,6 +71,11 @@ gsm_network_detach(uint32_t blocking) {
 
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_NETWORK_DETACH;
+#if GSM_CFG_NETWORK_REATTACH
+    GSM_CORE_PROTECT();
+    gsm.reattach.valid = 0;                     /* Application does not want network anymore */
+    GSM_CORE_UNPROTECT();
+#endif /* GSM_CFG_NETWORK_REATTACH */
 #if GSM_CFG_CONN
     /* GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CIPSTATUS; */
 #endif /* GSM_CFG_CONN */
@@ -78,6 +83,33 @@ gsm_network_detach(uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+
+/**
+ * \brief           Restart IP stack with credentials of last successful attach
+ *
+ * GPRS attach and application mode settings are kept by device after PDP deactivation,
+ * only `CIPSHUT`, `CSTT`, `CIICR` and `CIFSR` are sent
+ *
+ * \note            Command is always non-blocking, function is called from processing thread
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_network_reattach(void) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_NETWORK_REATTACH;
+    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CIPSHUT; /* Closed connections are processed on PDP deactivation */
+    GSM_MSG_VAR_REF(msg).msg.network_attach.apn = gsm.reattach.apn;
+    GSM_MSG_VAR_REF(msg).msg.network_attach.user = gsm.reattach.user;
+    GSM_MSG_VAR_REF(msg).msg.network_attach.pass = gsm.reattach.pass;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, 0, 200000); /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+
 gsmr_t
 gsm_network_check_status(uint32_t blocking) {
     GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
@@ -88,35 +120,64 @@ gsm_network_check_status(uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
-/**
- * \brief           Copy IP address from internal value to user variable
- * \param[out]      ip: Pointer to output IP variable
- * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
- */
-gsmr_t
-gsm_network_copy_ip(gsm_ip_t* ip) {
-    if (gsm_network_is_attached()) {
-        GSM_CORE_PROTECT();
-        memcpy(ip, &gsm.network.ip_addr, sizeof(*ip));
-        GSM_CORE_UNPROTECT();
-        return gsmOK;
-    }
-    return gsmERR;
+/**
+ * \brief           Copy IP address from internal value to user variable
+ * \param[out]      ip: Pointer to output IP variable
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_network_copy_ip(gsm_ip_t* ip) {
+    if (gsm_network_is_attached()) {
+        GSM_CORE_PROTECT();
+        memcpy(ip, &gsm.network.ip_addr, sizeof(*ip));
+        GSM_CORE_UNPROTECT();
+        return gsmOK;
+    }
+    return gsmERR;
 }
 
 /**
- * \brief           Check if device is attached to network and PDP context is active
+ * \brief           Check if device is attached to network and PDP context is active
  * \return          `1` on success, `0` otherwise
  */
 uint8_t
 gsm_network_is_attached(void) {
-    uint8_t res;
-    GSM_CORE_PROTECT();
-    res = GSM_U8(gsm.network.is_attached);
-    GSM_CORE_UNPROTECT();
+    uint8_t res;
+    GSM_CORE_PROTECT();
+    res = GSM_U8(gsm.network.is_attached);
+    GSM_CORE_UNPROTECT();
     return res;
 }
 
+#if GSM_CFG_HTTP || GSM_CFG_FTP || __DOXYGEN__
+
+/**
+ * \brief           Configure and open bearer used by device HTTP and FTP services
+ * \note            Bearer is closed first in case it was opened before
+ * \param[in]       apn: APN name
+ * \param[in]       user: User name. Set to `NULL` if not used
+ * \param[in]       pass: User password. Set to `NULL` if not used
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_network_bearer_open(const char* apn, const char* user, const char* pass, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("apn != NULL", apn != NULL);     /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_BEARER_OPEN;
+    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_SAPBR_CLOSE;
+    GSM_MSG_VAR_REF(msg).msg.network_attach.apn = apn;
+    GSM_MSG_VAR_REF(msg).msg.network_attach.user = user;
+    GSM_MSG_VAR_REF(msg).msg.network_attach.pass = pass;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 200000);  /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_HTTP || GSM_CFG_FTP || __DOXYGEN__ */
+
 #endif /* GSM_CFG_NETWORK || __DOXYGEN__ */
 
 /**
@@ -136,6 +197,33 @@ gsm_network_rssi(int16_t* rssi, uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 120000);  /* Send message to producer queue */
 }
 
+/**
+ * \brief           Get RSSI signal, using cached value when fresh enough
+ *
+ * When cached value is older than `max_age`, single refresh is queued
+ * and shared by all callers requesting the same value at the same time
+ *
+ * \param[out]      rssi: RSSI output variable. When set to `0`, RSSI is not valid
+ * \param[in]       max_age: Maximal age of cached value in units of milliseconds
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_network_rssi_cached(int16_t* rssi, uint32_t max_age, uint32_t blocking) {
+    uint8_t fresh;
+
+    GSM_CORE_PROTECT();
+    fresh = gsmi_value_age_is_fresh(&gsm.rssi_age, max_age);
+    if (fresh && rssi != NULL) {
+        *rssi = gsm.rssi;
+    }
+    GSM_CORE_UNPROTECT();
+    if (fresh) {
+        return gsmOK;
+    }
+    return gsm_network_rssi(rssi, blocking);
+}
+
 /**
  * \brief           Get network registration status
  * \return          Member of \ref gsm_network_reg_status_t enumeration
@@ -149,3 +237,36 @@ gsm_network_get_reg_status(void) {
     GSM_CORE_UNPROTECT();
     return ret;
 }
+
+/**
+ * \brief           Get network registration status, using cached value when fresh enough
+ *
+ * When cached value is older than `max_age`, single `AT+CREG?` query is queued
+ * and shared by all callers requesting the same value at the same time
+ *
+ * \param[out]      status: Output variable for registration status
+ * \param[in]       max_age: Maximal age of cached value in units of milliseconds
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_network_reg_status_cached(gsm_network_reg_status_t* status, uint32_t max_age, uint32_t blocking) {
+    uint8_t fresh;
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_CORE_PROTECT();
+    fresh = gsmi_value_age_is_fresh(&gsm.network.status_age, max_age);
+    if (fresh && status != NULL) {
+        *status = gsm.network.status;
+    }
+    GSM_CORE_UNPROTECT();
+    if (fresh) {
+        return gsmOK;
+    }
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CREG_GET;
+    GSM_MSG_VAR_REF(msg).msg.creg_get.status = status;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 2000);    /* Send message to producer queue */
+}
@@ -51,6 +51,33 @@ gsm_operator_get(gsm_operator_curr_t* curr, uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 2000);    /* Send message to producer queue */
 }
 
+/**
+ * \brief           Get current operator, using cached value when fresh enough
+ *
+ * When cached value is older than `max_age`, single `AT+COPS?` query is queued
+ * and shared by all callers requesting the same value at the same time
+ *
+ * \param[out]      curr: Pointer to output current operator variable
+ * \param[in]       max_age: Maximal age of cached value in units of milliseconds
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_operator_get_cached(gsm_operator_curr_t* curr, uint32_t max_age, uint32_t blocking) {
+    uint8_t fresh;
+
+    GSM_CORE_PROTECT();
+    fresh = gsmi_value_age_is_fresh(&gsm.network.curr_operator_age, max_age);
+    if (fresh && curr != NULL) {
+        *curr = gsm.network.curr_operator;
+    }
+    GSM_CORE_UNPROTECT();
+    if (fresh) {
+        return gsmOK;
+    }
+    return gsm_operator_get(curr, blocking);
+}
+
 /**
  * \brief           Set current operator
  * \param[in]       blocking: Status whether command should be blocking or not
@@ -80,6 +107,11 @@ gsm_operator_set(gsm_operator_mode_t mode, gsm_operator_format_t format, const c
 
 /**
  * \brief           Scan for available operators
+ *
+ * Scan may take several minutes. Each operator is reported with \ref GSM_EVT_NETWORK_OPERATOR_SCAN
+ * event as soon as it is received, also when array is already full.
+ * Scan waits in producer queue until all other commands are executed, see \ref gsm_msg_prio_t
+ *
  * \param[in]       ops: Pointer to array to write found operators
  * \param[in]       opsl: Length of input array in units of elements
  * \param[out]      opf: Pointer to ouput variable to save number of operators found
@@ -102,3 +134,43 @@ gsm_operator_scan(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t blocki
 
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 120000);  /* Send message to producer queue */
 }
+
+#if GSM_CFG_OPERATOR_SCAN_CACHE_LEN || __DOXYGEN__
+
+/**
+ * \brief           Get available operators, using result of last scan when fresh enough
+ *
+ * When last complete scan is older than `max_age`, new scan is started with \ref gsm_operator_scan.
+ * Cache keeps up to \ref GSM_CFG_OPERATOR_SCAN_CACHE_LEN operators
+ *
+ * \param[in]       ops: Pointer to array to write found operators
+ * \param[in]       opsl: Length of input array in units of elements
+ * \param[out]      opf: Pointer to ouput variable to save number of operators found
+ * \param[in]       max_age: Maximal age of last scan in units of milliseconds
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_operator_scan_cached(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t max_age, uint32_t blocking) {
+    uint8_t fresh;
+    size_t len;
+
+    GSM_CORE_PROTECT();
+    fresh = gsmi_value_age_is_fresh(&gsm.network.scan_cache_age, max_age);
+    if (fresh) {
+        len = GSM_MIN(opsl, gsm.network.scan_cache_len);
+        if (ops != NULL && len) {
+            GSM_MEMCPY(ops, gsm.network.scan_cache, len * sizeof(*ops));
+        }
+        if (opf != NULL) {
+            *opf = len;
+        }
+    }
+    GSM_CORE_UNPROTECT();
+    if (fresh) {
+        return gsmOK;
+    }
+    return gsm_operator_scan(ops, opsl, opf, blocking);
+}
+
+#endif /* GSM_CFG_OPERATOR_SCAN_CACHE_LEN || __DOXYGEN__ */
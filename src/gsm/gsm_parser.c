@@ -314,6 +314,10 @@ gsmi_parse_creg(const char* str, uint8_t skip_first) {
         gsmi_parse_number(&str);
     }
     gsm.network.status = (gsm_network_reg_status_t)gsmi_parse_number(&str);
+    gsmi_value_age_update(&gsm.network.status_age);
+    if (CMD_IS_CUR(GSM_CMD_CREG_GET) && gsm.msg->msg.creg_get.status != NULL) {
+        *gsm.msg->msg.creg_get.status = gsm.network.status; /* Save to user variable */
+    }
 
     /*
      * In case we are connected to network,
@@ -355,7 +359,8 @@ gsmi_parse_csq(const char* str) {
         rssi = 0;
     }
     gsm.rssi = rssi;                            /* Save RSSI to global variable */
-    if (gsm.msg->cmd_def == GSM_CMD_CSQ_GET &&
+    gsmi_value_age_update(&gsm.rssi_age);
+    if (CMD_IS_DEF(GSM_CMD_CSQ_GET) &&
         gsm.msg->msg.csq.rssi != NULL) {
         *gsm.msg->msg.csq.rssi = rssi;          /* Save to user variable */
     }
@@ -397,7 +402,12 @@ gsmi_parse_cpin(const char* str, uint8_t send_evt) {
      * start with basic info about SIM
      */
     if (gsm.sim.state == GSM_SIM_STATE_READY) {
+#if GSM_CFG_WARM_START
+        gsm.warm.sim_info = 1;                  /* Query now or after warm start has finished */
+        gsmi_warm_release(0);
+#else /* GSM_CFG_WARM_START */
         gsmi_get_sim_info(0);
+#endif /* !GSM_CFG_WARM_START */
     }
 
     if (send_evt) {
@@ -437,6 +447,7 @@ gsmi_parse_cops(const char* str) {
     } else {
         gsm.network.curr_operator.format = GSM_OPERATOR_FORMAT_INVALID;
     }
+    gsmi_value_age_update(&gsm.network.curr_operator_age);
 
     if (CMD_IS_DEF(GSM_CMD_COPS_GET) &&
         gsm.msg->msg.cops_get.curr != NULL) {   /* Check and copy to user variable */
@@ -454,70 +465,79 @@ gsmi_parse_cops(const char* str) {
  */
 uint8_t
 gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
-    static union {
-        struct {
-            uint8_t bo:1;                       /*!< Bracket open flag (Bracket Open) */
-            uint8_t ccd:1;                      /*!< 2 consecutive commas detected in a row (Comma Comma Detected) */
-            uint8_t tn:2;                       /*!< Term number in response, 2 bits for 4 diff values */
-            uint8_t tp;                         /*!< Current term character position */
-            uint8_t ch_prev;                    /*!< Previous character */
-        } f;
-    } u;
+    struct gsm_cops_scan_state* f = &gsm.msg->msg.cops_scan.state;
 
     if (reset) {                                /* Check for reset status */
-        memset(&u, 0x00, sizeof(u));            /* Reset everything */
-        u.f.ch_prev = 0;
+        memset(f, 0x00, sizeof(*f));            /* Reset everything */
+#if GSM_CFG_OPERATOR_SCAN_CACHE_LEN
+        gsm.network.scan_cache_len = 0;         /* Previous scan result is not valid anymore */
+        gsm.network.scan_cache_age.valid = 0;
+#endif /* GSM_CFG_OPERATOR_SCAN_CACHE_LEN */
         return 1;
     }
 
-    if (!u.f.ch_prev) {                         /* Check if this is first character */
+    if (!f->ch_prev) {                          /* Check if this is first character */
         if (ch == ' ') {                        /* Skip leading spaces */
             return 1;
         } else if (ch == ',') {                 /* If first character is comma, no operators available */
-            u.f.ccd = 1;                        /* Fake double commas in a row */
+            f->ccd = 1;                         /* Fake double commas in a row */
         }
     }
  
-    if (u.f.ccd ||                              /* Ignore data after 2 commas in a row */
-        gsm.msg->msg.cops_scan.opsi >= gsm.msg->msg.cops_scan.opsl) {   /* or if array is full */
+    if (f->ccd) {                               /* Ignore data after 2 commas in a row */
         return 1;
     }
 
-    if (u.f.bo) {                               /* Bracket already open */
+    if (f->bo) {                                /* Bracket already open */
+        gsm_operator_t* op = &gsm.msg->msg.cops_scan.op;
+
         if (ch == ')') {                        /* Close bracket check */
-            u.f.bo = 0;                         /* Clear bracket open flag */
-            u.f.tn = 0;                         /* Go to next term */
-            u.f.tp = 0;                         /* Go to beginning of next term */
-            gsm.msg->msg.cops_scan.opsi++;      /* Increase index */
-            if (gsm.msg->msg.cops_scan.opf != NULL) {
-                *gsm.msg->msg.cops_scan.opf = gsm.msg->msg.cops_scan.opsi;
+            size_t i = gsm.msg->msg.cops_scan.opsi;
+
+            f->bo = 0;                          /* Clear bracket open flag */
+            f->tn = 0;                          /* Go to next term */
+            f->tp = 0;                          /* Go to beginning of next term */
+            if (i < gsm.msg->msg.cops_scan.opsl) {  /* Store to user array if not full */
+                gsm.msg->msg.cops_scan.ops[i] = *op;
+                if (gsm.msg->msg.cops_scan.opf != NULL) {
+                    *gsm.msg->msg.cops_scan.opf = i + 1;
+                }
+            }
+#if GSM_CFG_OPERATOR_SCAN_CACHE_LEN
+            if (gsm.network.scan_cache_len < GSM_CFG_OPERATOR_SCAN_CACHE_LEN) {
+                gsm.network.scan_cache[gsm.network.scan_cache_len++] = *op;
             }
+#endif /* GSM_CFG_OPERATOR_SCAN_CACHE_LEN */
+            gsm.msg->msg.cops_scan.opsi++;      /* Increase index */
+
+            gsm.evt.evt.operator_scan.op = op;
+            gsm.evt.evt.operator_scan.index = i;
+            gsmi_send_cb(GSM_EVT_NETWORK_OPERATOR_SCAN);    /* Report operator immediately */
         } else if (ch == ',') {
-            u.f.tn++;                           /* Go to next term */
-            u.f.tp = 0;                         /* Go to beginning of next term */
+            f->tn++;                            /* Go to next term */
+            f->tp = 0;                          /* Go to beginning of next term */
         } else if (ch != '"') {                 /* We have valid data */
-            size_t i = gsm.msg->msg.cops_scan.opsi;
-            switch (u.f.tn) {
+            switch (f->tn) {
                 case 0: {                       /* Parse status info */
-                    gsm.msg->msg.cops_scan.ops[i].stat = (gsm_operator_status_t)(10 * (size_t)gsm.msg->msg.cops_scan.ops[i].stat + (ch - '0'));
+                    op->stat = (gsm_operator_status_t)(10 * (size_t)op->stat + (ch - '0'));
                     break;
                 }
                 case 1: {                       /*!< Parse long name */
-                    if (u.f.tp < sizeof(gsm.msg->msg.cops_scan.ops[i].long_name) - 1) {
-                        gsm.msg->msg.cops_scan.ops[i].long_name[u.f.tp++] = ch;
-                        gsm.msg->msg.cops_scan.ops[i].long_name[u.f.tp] = 0;
+                    if (f->tp < sizeof(op->long_name) - 1) {
+                        op->long_name[f->tp++] = ch;
+                        op->long_name[f->tp] = 0;
                     }
                     break;
                 }
                 case 2: {                       /*!< Parse short name */
-                    if (u.f.tp < sizeof(gsm.msg->msg.cops_scan.ops[i].short_name) - 1) {
-                        gsm.msg->msg.cops_scan.ops[i].short_name[u.f.tp++] = ch;
-                        gsm.msg->msg.cops_scan.ops[i].short_name[u.f.tp] = 0;
+                    if (f->tp < sizeof(op->short_name) - 1) {
+                        op->short_name[f->tp++] = ch;
+                        op->short_name[f->tp] = 0;
                     }
                     break;
                 }
                 case 3: {                       /*!< Parse number */
-                    gsm.msg->msg.cops_scan.ops[i].num = (10 * gsm.msg->msg.cops_scan.ops[i].num) + (ch - '0');
+                    op->num = (10 * op->num) + (ch - '0');
                     break;
                 }
                 default: break;
@@ -525,12 +545,13 @@ gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
         }
     } else {
         if (ch == '(') {                        /* Check for opening bracket */
-            u.f.bo = 1;
-        } else if (ch == ',' && u.f.ch_prev == ',') {
-            u.f.ccd = 1;                        /* 2 commas in a row */
+            f->bo = 1;
+            GSM_MEMSET(&gsm.msg->msg.cops_scan.op, 0x00, sizeof(gsm.msg->msg.cops_scan.op));  /* Start new entry */
+        } else if (ch == ',' && f->ch_prev == ',') {
+            f->ccd = 1;                         /* 2 commas in a row */
         }
     }
-    u.f.ch_prev = ch;
+    f->ch_prev = ch;
     return 1;
 }
 
@@ -632,6 +653,13 @@ gsmi_parse_cmgs(const char* str, uint8_t send_evt) {
 
     num = gsmi_parse_number(&str);              /* Parse number */
 
+#if GSM_CFG_SMS_PDU
+    if (CMD_IS_DEF(GSM_CMD_CMGS) && !gsm.msg->msg.sms_send.format) {
+        /* Batch send reports all results in single event */
+        gsm.msg->msg.sms_send.rcpts[gsm.msg->msg.sms_send.ri].pos = num;
+        return 1;
+    }
+#endif /* GSM_CFG_SMS_PDU */
     if (send_evt) {
         gsm.evt.evt.sms_send.num = num;
         gsm.evt.evt.sms_send.res = gsmOK;
@@ -672,8 +700,8 @@ uint8_t
 gsmi_parse_cmgl(const char* str) {
     gsm_sms_entry_t* e;
 
-    if (!CMD_IS_DEF(GSM_CMD_CMGL) ||
-        gsm.msg->msg.sms_list.ei >= gsm.msg->msg.sms_list.etr) {
+    if (!CMD_IS_DEF(GSM_CMD_CMGL) || gsm.msg->msg.sms_list.stop
+        || (gsm.msg->msg.sms_list.fn == NULL && gsm.msg->msg.sms_list.ei >= gsm.msg->msg.sms_list.etr)) {
         return 0;
     }
 
@@ -681,7 +709,8 @@ gsmi_parse_cmgl(const char* str) {
         str += 7;
     }
 
-    e = &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei];
+    /* Callback mode reuses single entry */
+    e = &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.fn != NULL ? 0 : gsm.msg->msg.sms_list.ei];
     e->mem = gsm.msg->msg.sms_list.mem;         /* Manually set memory */
     e->pos = GSM_SZ(gsmi_parse_number(&str));   /* Scan position */
     gsmi_parse_sms_status(&str, &e->status);
@@ -882,13 +911,7 @@ gsmi_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* contin
             tmp_pdp_state = 0;
         }
 
-        /* Check if we have to update status for application */
-        if (gsm.network.is_attached != tmp_pdp_state) {
-            gsm.network.is_attached = tmp_pdp_state;
-
-            /* Notify upper layer */
-            gsmi_send_cb(gsm.network.is_attached ? GSM_EVT_NETWORK_ATTACHED : GSM_EVT_NETWORK_DETACHED);
-        }
+        gsmi_network_set_attached(tmp_pdp_state);   /* Notify upper layer on change */
 
         return 1;
     }
@@ -901,6 +924,9 @@ gsmi_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* contin
     gsmi_parse_string(&str, s_tmp, sizeof(s_tmp), 1);   /* Parse TCP/UPD */
     if (strlen(s_tmp)) {
         if (!strcmp(s_tmp, "TCP")) {
+#if GSM_CFG_CONN_SSL
+            if (conn->type != GSM_CONN_TYPE_SSL)    /* Device reports TLS connections as TCP */
+#endif /* GSM_CFG_CONN_SSL */
             conn->type = GSM_CONN_TYPE_TCP;
         } else if (!strcmp(s_tmp, "UDP")) {
             conn->type = GSM_CONN_TYPE_UDP;
@@ -935,6 +961,35 @@ gsmi_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* contin
     return 1;
 }
 
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+/**
+ * \brief           Parse +CDNSGIP statement with resolved host name
+ * \param[in]       str: Input string
+ * \param[out]      ip: Output variable for first resolved IP address
+ * \return          `1` if host was resolved, `0` otherwise
+ */
+uint8_t
+gsmi_parse_cdnsgip(const char* str, gsm_ip_t* ip) {
+    if (*str == '+') {
+        str += 10;                              /* Advance for "+CDNSGIP: " */
+    }
+    if (gsmi_parse_number(&str) != 1) {         /* Check if resolving succeeded */
+        return 0;
+    }
+    gsmi_parse_string(&str, NULL, 0, 1);        /* Skip host name */
+    if (*str == ',') {
+        str++;
+    }
+    if (*str == '"') {
+        str++;
+    }
+    if (!GSM_CHARISNUM(*str)) {
+        return 0;
+    }
+    return gsmi_parse_ip(&str, ip);
+}
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
+
 /**
  * \brief           Parse IPD or RECEIVE statements
  * \param[in]       str: Input string
@@ -962,6 +1017,23 @@ gsmi_parse_ipd(const char* str) {
     if (c == NULL) {                            /* Invalid connection number */
         return 0;
     }
+    if (!c->status.f.active) {                  /* Data for connection we do not know is active */
+        gsm.conns_status_valid = 0;             /* Some notification has been missed */
+    }
+
+#if GSM_CFG_CONN_RECV_FROM
+    if (*str == ',') {                          /* Remote address follows in "ip:port" format */
+        gsmi_parse_ip(&str, &gsm.ipd.ip);
+        gsm.ipd.port = gsmi_parse_number(&str);
+    } else if (!gsm.ipd.from_valid)             /* Keep address from "RECV FROM" line */
+#endif /* GSM_CFG_CONN_RECV_FROM */
+    {
+        GSM_MEMCPY(&gsm.ipd.ip, &c->remote_ip, sizeof(gsm.ipd.ip));
+        gsm.ipd.port = c->remote_port;
+    }
+#if GSM_CFG_CONN_RECV_FROM
+    gsm.ipd.from_valid = 0;
+#endif /* GSM_CFG_CONN_RECV_FROM */
 
     gsm.ipd.read = 1;                           /* Start reading network data */
     gsm.ipd.tot_len = len;                      /* Total number of bytes in this received packet */
@@ -971,4 +1043,234 @@ gsmi_parse_ipd(const char* str) {
     return 1;
 }
 
+#if GSM_CFG_CONN_RECV_FROM || __DOXYGEN__
+
+/**
+ * \brief           Parse `RECV FROM` statement with remote address of next received packet
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gsmi_parse_recv_from(const char* str) {
+    str += 10;                                  /* Advance for "RECV FROM:" */
+    gsmi_parse_ip(&str, &gsm.ipd.ip);
+    gsm.ipd.port = gsmi_parse_number(&str);
+    gsm.ipd.from_valid = 1;                     /* Address belongs to next received packet */
+    return 1;
+}
+
+#endif /* GSM_CFG_CONN_RECV_FROM || __DOXYGEN__ */
+
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+
+/**
+ * \brief           Parse `+CIPRXGET` statement in manual receive mode
+ *
+ * Mode `1` notifies about new data in device buffer.
+ * Mode `2` is header of read response, followed by data
+ *
+ * \param[in]       str: Input string
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gsmi_parse_ciprxget(const char* str) {
+    uint8_t mode, conn;
+    size_t len, rem;
+    gsm_conn_p c;
+
+    if (*str == '+') {
+        str += 11;                              /* Advance for "+CIPRXGET: " */
+    }
+    mode = gsmi_parse_number(&str);
+    conn = gsmi_parse_number(&str);
+    c = conn < GSM_CFG_MAX_CONNS ? &gsm.conns[conn] : NULL; /* Get connection handle */
+    if (c == NULL) {                            /* Invalid connection number */
+        return 0;
+    }
+
+    if (mode == 1) {                            /* New data available */
+        c->status.f.rx_pending = 1;
+        gsmi_conn_manual_tcp_try_read_data(c);
+    } else if (mode == 2) {                     /* Data follow in next line */
+        len = gsmi_parse_number(&str);          /* Number of bytes in this response */
+        rem = gsmi_parse_number(&str);          /* Number of bytes left in device buffer */
+        c->status.f.rx_pending = rem > 0;
+        if (len > 0) {
+            gsm.ipd.read = 1;                   /* Start reading network data */
+            gsm.ipd.tot_len = len;
+            gsm.ipd.rem_len = len;
+            gsm.ipd.conn = c;
+        }
+    }
+    return 1;
+}
+
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
+
 #endif /* GSM_CFG_CONN */
+
+#if GSM_CFG_HTTP || __DOXYGEN__
+
+/**
+ * \brief           Parse received +HTTPACTION result of HTTP request
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_httpaction(const char* str) {
+    uint16_t code;
+    size_t len;
+
+    if (!CMD_IS_CUR(GSM_CMD_HTTPACTION)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 13;                              /* Advance for "+HTTPACTION: " */
+    }
+    gsmi_parse_number(&str);                    /* Skip method */
+    code = GSM_U16(gsmi_parse_number(&str));
+    len = GSM_SZ(gsmi_parse_number(&str));
+
+    gsm.msg->msg.http_get.code = code;
+    gsm.msg->msg.http_get.body_len = len;
+    gsm.msg->msg.http_get.action = 1;
+    if (code >= 600) {                          /* Codes above 600 are device or network errors */
+        gsm.msg->msg.http_get.err = 1;
+    }
+    if (gsm.msg->msg.http_get.status != NULL) {
+        *gsm.msg->msg.http_get.status = code;
+    }
+    if (gsm.msg->msg.http_get.len != NULL) {
+        *gsm.msg->msg.http_get.len = len;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Parse received +HTTPREAD header of body data
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_httpread(const char* str) {
+    size_t len;
+
+    if (!CMD_IS_CUR(GSM_CMD_HTTPREAD)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 11;                              /* Advance for "+HTTPREAD: " */
+    }
+    len = GSM_SZ(gsmi_parse_number(&str));
+    if (len > 0) {
+        gsm.msg->msg.http_get.rem = len;
+        gsm.msg->msg.http_get.read = 1;         /* Data follow in next line */
+    } else {
+        gsm.msg->msg.http_get.body_len = gsm.msg->msg.http_get.offset;  /* No more data on device */
+    }
+    return 1;
+}
+
+#endif /* GSM_CFG_HTTP || __DOXYGEN__ */
+
+#if GSM_CFG_FTP || __DOXYGEN__
+
+/**
+ * \brief           Parse received +FTPGET status or data header
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_ftpget(const char* str) {
+    int32_t mode, val;
+
+    if (!CMD_IS_DEF(GSM_CMD_FTP_GET)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 9;                               /* Advance for "+FTPGET: " */
+    }
+    mode = gsmi_parse_number(&str);
+    val = gsmi_parse_number(&str);
+    if (mode == 1) {                            /* Session status */
+        gsm.msg->msg.ftp.wait = 0;
+        if (val == 0) {
+            gsm.msg->msg.ftp.finished = 1;      /* All data were received */
+        } else if (val != 1) {
+            gsm.msg->msg.ftp.err = 1;           /* Error code */
+        }
+    } else if (mode == 2) {                     /* Data header */
+        if (val > 0) {
+            gsm.msg->msg.ftp.rem = GSM_SZ(val);
+            gsm.msg->msg.ftp.read = 1;          /* Data follow in next line */
+        } else if (!gsm.msg->msg.ftp.finished) {
+            gsm.msg->msg.ftp.wait = 1;          /* No data yet, wait for next status */
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Parse received +FTPPUT status or write confirmation
+ * \note            Chunk data are sent to device when write is confirmed
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_ftpput(const char* str) {
+    int32_t mode, val;
+
+    if (!CMD_IS_DEF(GSM_CMD_FTP_PUT)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 9;                               /* Advance for "+FTPPUT: " */
+    }
+    mode = gsmi_parse_number(&str);
+    val = gsmi_parse_number(&str);
+    if (mode == 1) {                            /* Session status */
+        gsm.msg->msg.ftp.wait = 0;
+        if (val == 1) {
+            gsm.msg->msg.ftp.max_len = GSM_SZ(gsmi_parse_number(&str)); /* Device is ready for next chunk */
+        } else if (val == 0) {
+            gsm.msg->msg.ftp.finished = 1;      /* Upload is finished */
+        } else {
+            gsm.msg->msg.ftp.err = 1;           /* Error code */
+        }
+    } else if (mode == 2 && CMD_IS_CUR(GSM_CMD_FTPPUT_WRITE)) {
+        gsm.msg->msg.ftp.len = GSM_MIN(GSM_SZ(val), gsm.msg->msg.ftp.len);  /* Device may accept less */
+        if (gsm.msg->msg.ftp.len > 0) {
+            GSM_AT_PORT_SEND(gsm.msg->msg.ftp.data, gsm.msg->msg.ftp.len);  /* Device waits for chunk data */
+        }
+    }
+    return 1;
+}
+
+#endif /* GSM_CFG_FTP || __DOXYGEN__ */
+
+#if GSM_CFG_PING || __DOXYGEN__
+
+/**
+ * \brief           Parse received +CIPPING reply of single probe
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_cipping(const char* str) {
+    uint32_t time;
+
+    if (!CMD_IS_CUR(GSM_CMD_CIPPING)) {
+        return 0;
+    }
+    if (*str == '+') {
+        str += 10;                              /* Advance for "+CIPPING: " */
+    }
+    gsmi_parse_number(&str);                    /* Skip probe number */
+    gsmi_parse_string(&str, NULL, 0, 1);        /* Skip replying IP address */
+    time = GSM_U32(gsmi_parse_number(&str));    /* Reply time in units of 100 ms */
+
+    gsmi_ping_add(gsm.msg, time * 100, time >= GSM_CFG_PING_TIMEOUT / 100);
+    return 1;
+}
+
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
@@ -61,6 +61,34 @@ pbuf_skip(gsm_pbuf_p p, size_t off, size_t* new_off) {
     return p;
 }
 
+/**
+ * \brief           Compare memory with pbuf chain, walking chain forward only once
+ * \param[in]       p: Pbuf where compare starts
+ * \param[in]       off: Offset in units of bytes in first pbuf, may exceed its length
+ * \param[in]       d: Memory to compare with
+ * \param[in]       len: Length of memory in units of bytes
+ * \return          `1` if equal, `0` otherwise or if chain is too short
+ */
+static uint8_t
+pbuf_match(gsm_pbuf_p p, size_t off, const uint8_t* d, size_t len) {
+    size_t l;
+
+    for (; p != NULL && len; p = p->next) {
+        if (off < p->len) {
+            l = GSM_MIN(p->len - off, len);     /* Compare linear part of current pbuf */
+            if (memcmp(&p->payload[off], d, l)) {
+                return 0;
+            }
+            d += l;
+            len -= l;
+            off = 0;
+        } else {
+            off -= p->len;                      /* Offset starts in one of next pbufs */
+        }
+    }
+    return len == 0;
+}
+
 /**
  * \brief           Allocate packet buffer for network data of specific size
  * \param[in]       len: Length of payload memory to allocate
@@ -70,7 +98,7 @@ gsm_pbuf_p
 gsm_pbuf_new(size_t len) {
     gsm_pbuf_p p;
     
-    p = gsm_mem_alloc(SIZEOF_PBUF_STRUCT + sizeof(*p->payload) * len);  /* Allocate memory for packet buffer */
+    p = gsm_mem_pool_alloc(GSM_MEM_POOL_PBUF, GSM_MEM_TAG_PBUF, SIZEOF_PBUF_STRUCT + sizeof(*p->payload) * len);  /* Allocate memory for packet buffer */
     GSM_DEBUGW(GSM_CFG_DBG_PBUF | GSM_DBG_TYPE_TRACE, p == NULL,
         "[PBUF] Failed to allocate %d bytes\r\n", (int)len);
     GSM_DEBUGW(GSM_CFG_DBG_PBUF | GSM_DBG_TYPE_TRACE, p != NULL,
@@ -81,10 +109,44 @@ gsm_pbuf_new(size_t len) {
         p->len = len;                           /* Set payload length */
         p->payload = (uint8_t *)(((char *)p) + SIZEOF_PBUF_STRUCT); /* Set pointer to payload data */
         p->ref = 1;                             /* Single reference is used on this pbuf */
+#if GSM_CFG_IPD_ZERO_COPY
+        p->payload_mem = NULL;
+#endif /* GSM_CFG_IPD_ZERO_COPY */
     }
     return p;
 }
 
+#if GSM_CFG_IPD_ZERO_COPY || __DOXYGEN__
+
+/**
+ * \brief           Copy payload of zero-copy packet buffer out of receive buffer
+ *
+ *                  Payload is moved to separately allocated memory, freed together with packet buffer.
+ *                  Receive buffer memory is not referenced by packet buffer anymore
+ *
+ * \note            Packet buffer handle stays the same, only its payload pointer changes
+ * \param[in]       pbuf: Single packet buffer with payload in receive buffer
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_pbuf_copy_payload(gsm_pbuf_p pbuf) {
+    uint8_t* mem;
+
+    if (pbuf->payload_mem != NULL || pbuf->payload == (uint8_t *)(((char *)pbuf) + SIZEOF_PBUF_STRUCT)) {
+        return gsmOK;                           /* Payload is already owned by packet buffer */
+    }
+    if ((mem = gsm_mem_alloc_tag(GSM_MEM_TAG_PBUF, GSM_MAX(pbuf->len, 1))) == NULL) {
+        GSM_DEBUGF(GSM_CFG_DBG_PBUF | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+            "[PBUF] Failed to copy %d bytes out of receive buffer\r\n", (int)pbuf->len);
+        return gsmERRMEM;
+    }
+    GSM_MEMCPY(mem, pbuf->payload, pbuf->len);
+    pbuf->payload = pbuf->payload_mem = mem;
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_IPD_ZERO_COPY || __DOXYGEN__ */
+
 /**
  * \brief           Free previously allocated packet buffer
  * \param[in]       pbuf: Packet buffer to free
@@ -103,13 +165,18 @@ gsm_pbuf_free(gsm_pbuf_p pbuf) {
      */
     cnt = 0;
     for (p = pbuf; p != NULL;) {
-        GSM_CORE_PROTECT();                     /* Protect core */
+        GSM_MEM_PROTECT();                      /* Protect reference counter */
         ref = --p->ref;                         /* Decrease current value and save it */
-        GSM_CORE_UNPROTECT();                   /* Unprotect core */
+        GSM_MEM_UNPROTECT();                    /* Unprotect reference counter */
         if (ref == 0) {                         /* Did we reach 0 and are ready to free it? */
             GSM_DEBUGF(GSM_CFG_DBG_PBUF | GSM_DBG_TYPE_TRACE,
                 "[PBUF] Deallocating %p with len/tot_len: %d/%d\r\n", p, (int)p->len, (int)p->tot_len);
             pn = p->next;                       /* Save next entry */
+#if GSM_CFG_IPD_ZERO_COPY
+            if (p->payload_mem != NULL) {
+                gsm_mem_free(p->payload_mem);   /* Free payload copied out of receive buffer */
+            }
+#endif /* GSM_CFG_IPD_ZERO_COPY */
             gsm_mem_free(p);                    /* Free memory for pbuf */
             p = pn;                             /* Restore with next entry */
             cnt++;                              /* Increase number of freed pbufs */
@@ -203,9 +270,9 @@ gsmr_t
 gsm_pbuf_ref(gsm_pbuf_p pbuf) {
     GSM_ASSERT("pbuf != NULL", pbuf != NULL);   /* Assert input parameters */
     
-    GSM_CORE_PROTECT();                         /* Protect core */
+    GSM_MEM_PROTECT();                          /* Protect reference counter */
     pbuf->ref++;                                /* Increase reference count for pbuf */
-    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_MEM_UNPROTECT();                        /* Unprotect reference counter */
     return gsmOK;
 }
 
@@ -334,16 +401,36 @@ gsm_pbuf_get_at(const gsm_pbuf_p pbuf, size_t pos, uint8_t* el) {
  */
 size_t
 gsm_pbuf_memfind(const gsm_pbuf_p pbuf, const void* needle, size_t len, size_t off) {
-    if (pbuf != NULL && needle != NULL && pbuf->tot_len >= (len + off)) {   /* Check if valid entries */
-        /*
-         * Try entire buffer element by element
-         * and in case we have a match, report it
-         */
-        for (size_t i = off; i <= pbuf->tot_len - len; i++) {
-            if (!gsm_pbuf_memcmp(pbuf, needle, len, i)) {   /* Check if identical */
-                return i;                       /* We have a match! */
-            }
+    const uint8_t* n = needle;
+    const uint8_t* d;
+    gsm_pbuf_p p;
+    size_t pos, base, last;
+
+    if (pbuf == NULL || needle == NULL || !len || pbuf->tot_len < (len + off)) {   /* Check if valid entries */
+        return GSM_SIZET_MAX;
+    }
+
+    /*
+     * Walk chain only once, starting at first pbuf with offset.
+     * Candidates are found by first needle byte with memchr in each linear part,
+     * remaining needle bytes are compared from candidate forward, across pbufs if needed
+     */
+    last = pbuf->tot_len - len;                 /* Last position where match may start */
+    p = pbuf_skip(pbuf, off, &pos);
+    base = off - pos;                           /* Position of first byte of current pbuf in chain */
+    while (p != NULL && base + pos <= last) {
+        d = memchr(&p->payload[pos], n[0], GSM_MIN(p->len - pos, last - (base + pos) + 1));
+        if (d == NULL) {                        /* No candidate in this pbuf, go to next */
+            base += p->len;
+            pos = 0;
+            p = p->next;
+            continue;
         }
+        pos = (size_t)(d - p->payload);
+        if (pbuf_match(p, pos + 1, n + 1, len - 1)) {
+            return base + pos;                  /* We have a match! */
+        }
+        ++pos;
     }
     return GSM_SIZET_MAX;                       /* Return maximal value of size_t variable to indicate error */
 }
@@ -374,32 +461,20 @@ gsm_pbuf_strfind(const gsm_pbuf_p pbuf, const char* str, size_t off) {
 size_t
 gsm_pbuf_memcmp(const gsm_pbuf_p pbuf, const void* data, size_t len, size_t offset) {
     gsm_pbuf_p p;
-    uint8_t el;
-    const uint8_t* d = data;
-    
+    size_t off;
+
     if (pbuf == NULL || data == NULL || !len || /* Input parameters check */
         pbuf->tot_len < (offset + len)) {       /* Check of valid ranges */
         return GSM_SIZET_MAX;                   /* Invalid check here */
     }
-    
-    /*
-     * Find start pbuf to have more optimized search at the end
-     * Since we had a check on beginning, we must pass this for loop without any problems
-     */
-    for (p = pbuf; p != NULL && p->len <= offset; p = p->next) {
-        offset -= p->len;                       /* Decrease offset by length of pbuf */
-    }
-    
+
     /*
-     * We have known starting pbuf.
-     * Now it is time to check byte by byte from pbuf and memory
-     *
-     * Use byte by byte read function to inspect bytes separatelly
+     * Find start pbuf once, then compare
+     * linear parts of chain with memory
      */
-    for (size_t i = 0; i < len; i++) {
-        if (!gsm_pbuf_get_at(p, offset + i, &el) || el != d[i]) {   /* Get value from pbuf at specific offset */
-            return offset + 1;                  /* Return value from offset where it failed */
-        }
+    p = pbuf_skip(pbuf, offset, &off);
+    if (!pbuf_match(p, off, data, len)) {
+        return offset + 1;                      /* Return value from offset where it failed */
     }
     return 0;                                   /* Memory matches at this point */
 }
@@ -447,6 +522,42 @@ gsm_pbuf_get_linear_addr(const gsm_pbuf_p pbuf, size_t offset, size_t* new_len)
     return &p->payload[offset];                 /* Return memory at desired offset */
 }
 
+/**
+ * \brief           Iterate over linear memory parts of pbuf chain
+ *
+ *                  Callback is called for every part of chain between `offset` and `offset + len`,
+ *                  in order, without copying data
+ *
+ * \param[in]       pbuf: Pbuf chain to iterate
+ * \param[in]       offset: Start offset in chain
+ * \param[in]       len: Maximal number of bytes to iterate, use `GSM_SIZET_MAX` for rest of chain
+ * \param[in]       fn: Callback function called for every segment
+ * \param[in]       arg: User argument passed to callback
+ * \return          Number of bytes passed to callback, including segment which stopped iteration
+ */
+size_t
+gsm_pbuf_foreach_segment(const gsm_pbuf_p pbuf, size_t offset, size_t len, gsm_pbuf_segment_fn fn, void* arg) {
+    gsm_pbuf_p p;
+    size_t l, tot = 0;
+
+    if (pbuf == NULL || fn == NULL || pbuf->tot_len <= offset) {
+        return 0;
+    }
+    len = GSM_MIN(len, pbuf->tot_len - offset);
+    for (p = pbuf_skip(pbuf, offset, &offset); p != NULL && len; p = p->next, offset = 0) {
+        l = GSM_MIN(p->len - offset, len);
+        if (!l) {
+            continue;                           /* Skip empty pbufs */
+        }
+        tot += l;
+        len -= l;
+        if (!fn(&p->payload[offset], l, arg)) {
+            break;
+        }
+    }
+    return tot;
+}
+
 /**
  * \brief           Get data pointer from packet buffer
  * \param[in]       pbuf: Packet buffer
@@ -482,6 +593,27 @@ gsm_pbuf_set_ip(gsm_pbuf_p pbuf, const gsm_ip_t* ip, gsm_port_t port) {
     }
 }
 
+/**
+ * \brief           Get IP address and port number of received data
+ * \param[in]       pbuf: Packet buffer
+ * \param[out]      ip: Output variable to save remote IP address
+ * \param[out]      port: Output variable to save remote port number
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gsm_pbuf_ip(const gsm_pbuf_p pbuf, gsm_ip_t* ip, gsm_port_t* port) {
+    if (pbuf != NULL) {
+        if (ip != NULL) {
+            GSM_MEMCPY(ip, &pbuf->ip, sizeof(*ip));
+        }
+        if (port != NULL) {
+            *port = pbuf->port;
+        }
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * \brief           Advance pbuf payload pointer by number of len bytes.
  *                  It can only advance single pbuf in a chain
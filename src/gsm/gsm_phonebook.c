@@ -302,4 +302,335 @@ gsm_pb_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Normalize phone number to trailing digits used for comparison
+ * \param[in]       num: Phone number
+ * \param[out]      out: Output buffer, at least \ref GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS + 1 bytes
+ * \return          Number of digits written to output
+ */
+static size_t
+pb_cache_num_norm(const char* num, char* out) {
+    size_t len = 0, i;
+
+    for (; *num != '\0'; num++) {
+        if (GSM_CHARISNUM(*num)) {
+            if (len == GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS) {
+                for (i = 1; i < len; i++) {     /* Keep trailing digits only */
+                    out[i - 1] = out[i];
+                }
+                len--;
+            }
+            out[len++] = *num;
+        }
+    }
+    out[len] = '\0';
+    return len;
+}
+
+/**
+ * \brief           Get hash table slot for normalized number
+ * \param[in]       norm: Normalized number
+ * \return          Start slot in hash table
+ */
+static size_t
+pb_cache_num_slot(const char* norm) {
+    uint32_t h = 2166136261UL;                  /* FNV-1a */
+
+    for (; *norm != '\0'; norm++) {
+        h = (h ^ GSM_U8(*norm)) * 16777619UL;
+    }
+    return h % (2 * gsm.pb.cache.size);
+}
+
+/**
+ * \brief           Compare entry names, case insensitive
+ * \param[in]       a: First name
+ * \param[in]       b: Second name
+ * \param[in]       len: Maximal number of characters to compare
+ * \return          `0` on match, negative or positive value as with `strncmp` otherwise
+ */
+static int
+pb_cache_name_cmp(const char* a, const char* b, size_t len) {
+    int ca, cb;
+
+    for (; len > 0; len--, a++, b++) {
+        ca = GSM_U8(*a);
+        cb = GSM_U8(*b);
+        if (ca >= 'A' && ca <= 'Z') {
+            ca += 'a' - 'A';
+        }
+        if (cb >= 'A' && cb <= 'Z') {
+            cb += 'a' - 'A';
+        }
+        if (ca != cb || ca == '\0') {
+            return ca - cb;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Rebuild number and name indexes of cache
+ */
+static void
+pb_cache_index(void) {
+    gsm_pb_cache_t* c = &gsm.pb.cache;
+    char norm[GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS + 1];
+    size_t i, j, slot;
+    uint16_t idx;
+
+    memset(c->num_idx, 0x00, sizeof(*c->num_idx) * 2 * c->size);
+    for (i = 0; i < c->count; i++) {
+        pb_cache_num_norm(c->entries[i].number, norm);
+        for (slot = pb_cache_num_slot(norm); c->num_idx[slot]; slot = (slot + 1) % (2 * c->size)) {}
+        c->num_idx[slot] = (uint16_t)(i + 1);
+
+        /* Insertion sort by name */
+        idx = (uint16_t)i;
+        for (j = i; j > 0 && pb_cache_name_cmp(c->entries[c->name_idx[j - 1]].name,
+                c->entries[idx].name, sizeof(c->entries[idx].name)) > 0; j--) {
+            c->name_idx[j] = c->name_idx[j - 1];
+        }
+        c->name_idx[j] = idx;
+    }
+}
+
+/**
+ * \brief           Get memory used by phonebook message
+ * \param[in]       mem: Memory from message
+ * \return          Device memory
+ */
+static gsm_mem_t
+pb_cache_mem(gsm_mem_t mem) {
+    return mem == GSM_MEM_CURRENT ? gsm.pb.mem.current : mem;
+}
+
+/**
+ * \brief           Finish phonebook cache load
+ * \note            Called from processing thread when `+CPBR` finishes
+ * \param[in]       msg: List message which loaded cache
+ * \param[in]       is_ok: Status of list command
+ */
+void
+gsmi_pb_cache_loaded(gsm_msg_t* msg, uint8_t is_ok) {
+    gsm_pb_cache_t* c = &gsm.pb.cache;
+
+    if (c->entries != msg->msg.pb_list.entries) {   /* Cache was cleared or reloaded meanwhile */
+        return;
+    }
+    c->mem = pb_cache_mem(msg->msg.pb_list.mem);
+    c->count = msg->msg.pb_list.ei;
+    for (size_t i = 0; i < c->count; i++) {
+        c->entries[i].mem = c->mem;
+    }
+    pb_cache_index();
+    c->valid = is_ok;
+}
+
+/**
+ * \brief           Apply successful phonebook write to cache
+ * \note            Called from processing thread when `+CPBW` finishes
+ * \param[in]       msg: Write message
+ */
+void
+gsmi_pb_cache_write(gsm_msg_t* msg) {
+    gsm_pb_cache_t* c = &gsm.pb.cache;
+    gsm_pb_entry_t* e;
+    size_t i, pos = msg->msg.pb_write.pos;
+
+    if (!c->valid || pb_cache_mem(msg->msg.pb_write.mem) != c->mem) {
+        return;
+    }
+    if (pos == 0) {                             /* Device took first free position */
+        for (pos = 1, i = 0; i < c->count; ) {
+            if (c->entries[i].pos == pos) {
+                pos++;
+                i = 0;                          /* Position used, check again */
+            } else {
+                i++;
+            }
+        }
+    }
+    for (i = 0; i < c->count && c->entries[i].pos != pos; i++) {}
+    if (msg->msg.pb_write.del) {
+        if (i < c->count) {
+            c->entries[i] = c->entries[--c->count]; /* Move last entry to free slot */
+        }
+    } else {
+        if (i == c->count) {
+            if (c->count == c->size) {
+                c->valid = 0;                   /* Cache cannot mirror memory anymore */
+                return;
+            }
+            c->count++;
+        }
+        e = &c->entries[i];
+        e->mem = c->mem;
+        e->pos = pos;
+        strncpy(e->name, msg->msg.pb_write.name, sizeof(e->name) - 1);
+        e->name[sizeof(e->name) - 1] = '\0';
+        strncpy(e->number, msg->msg.pb_write.num, sizeof(e->number) - 1);
+        e->number[sizeof(e->number) - 1] = '\0';
+        e->type = msg->msg.pb_write.type;
+    }
+    pb_cache_index();
+}
+
+/**
+ * \brief           Load phonebook memory to local cache
+ *
+ *                  Entries at positions `1` to `size` are listed from device to user array
+ *                  and indexed for local search. Cache is updated on every successful
+ *                  \ref gsm_pb_add, \ref gsm_pb_edit and \ref gsm_pb_delete on the same memory.
+ *
+ * \note            Array must stay valid until \ref gsm_pb_cache_clear is called
+ * \param[in]       mem: Memory to cache. Use \ref GSM_MEM_CURRENT to use current memory
+ * \param[in]       entries: User array used as cache storage
+ * \param[in]       size: Number of entries in array, should be at least memory size
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_cache_load(gsm_mem_t mem, gsm_pb_entry_t* entries, size_t size, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    uint16_t *num_idx, *name_idx;
+
+    GSM_ASSERT("entries != NULL", entries != NULL); /* Assert input parameters */
+    GSM_ASSERT("size > 0 && size < 0xFFFF", size > 0 && size < 0xFFFF); /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    num_idx = gsm_mem_alloc_tag(GSM_MEM_TAG_CORE, sizeof(*num_idx) * 2 * size);
+    name_idx = gsm_mem_alloc_tag(GSM_MEM_TAG_CORE, sizeof(*name_idx) * size);
+    if (num_idx == NULL || name_idx == NULL) {
+        gsm_mem_free(num_idx);
+        gsm_mem_free(name_idx);
+        GSM_MSG_VAR_FREE(msg);
+        return gsmERRMEM;
+    }
+
+    gsm_pb_cache_clear();                       /* Release previous cache */
+    GSM_CORE_PROTECT();                         /* Protect core */
+    gsm.pb.cache.entries = entries;
+    gsm.pb.cache.size = size;
+    gsm.pb.cache.num_idx = num_idx;
+    gsm.pb.cache.name_idx = name_idx;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+
+    memset(entries, 0x00, sizeof(*entries) * size); /* Reset data structure */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBR;
+    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
+        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_GET;    /* First get memory */
+    } else {
+        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_SET;    /* First set memory */
+    }
+
+    GSM_MSG_VAR_REF(msg).msg.pb_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.start_index = 1;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.entries = entries;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.etr = size;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.cache = 1;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Clear phonebook cache and release index memory
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_cache_clear(void) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    gsm_mem_free(gsm.pb.cache.num_idx);
+    gsm_mem_free(gsm.pb.cache.name_idx);
+    memset(&gsm.pb.cache, 0x00, sizeof(gsm.pb.cache));
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+/**
+ * \brief           Find entry by phone number in local cache
+ * \note            Numbers are compared by last \ref GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS digits
+ * \param[in]       num: Phone number to search for
+ * \param[out]      entry: Pointer to entry to copy found data to. Set to `NULL` if not used
+ * \return          \ref gsmOK if found, \ref gsmERR if not found
+ *                      or \ref gsmERRNOTENABLED if cache is not loaded
+ */
+gsmr_t
+gsm_pb_cache_find_number(const char* num, gsm_pb_entry_t* entry) {
+    gsm_pb_cache_t* c = &gsm.pb.cache;
+    char norm[GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS + 1], e_norm[GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS + 1];
+    gsmr_t res = gsmERR;
+    size_t slot;
+
+    GSM_ASSERT("num != NULL", num != NULL);     /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (!c->valid) {
+        res = gsmERRNOTENABLED;
+    } else if (pb_cache_num_norm(num, norm) > 0) {
+        for (slot = pb_cache_num_slot(norm); c->num_idx[slot]; slot = (slot + 1) % (2 * c->size)) {
+            pb_cache_num_norm(c->entries[c->num_idx[slot] - 1].number, e_norm);
+            if (!strcmp(norm, e_norm)) {
+                if (entry != NULL) {
+                    *entry = c->entries[c->num_idx[slot] - 1];
+                }
+                res = gsmOK;
+                break;
+            }
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Search entries by name prefix in local cache
+ * \note            Search is case insensitive, entries are returned sorted by name
+ * \param[in]       name: Name prefix to search for. Use empty string to get all entries
+ * \param[out]      entries: Pointer to array to save entries
+ * \param[in]       etr: Number of entries to read
+ * \param[out]      er: Pointer to output variable to save entries found
+ * \return          \ref gsmOK on success, \ref gsmERRNOTENABLED if cache is not loaded
+ */
+gsmr_t
+gsm_pb_cache_search(const char* name, gsm_pb_entry_t* entries, size_t etr, size_t* er) {
+    gsm_pb_cache_t* c = &gsm.pb.cache;
+    size_t len, lo, hi, mid, n = 0;
+    gsmr_t res = gsmOK;
+
+    GSM_ASSERT("name != NULL", name != NULL);   /* Assert input parameters */
+    GSM_ASSERT("entries != NULL", entries != NULL); /* Assert input parameters */
+    GSM_ASSERT("etr > 0", etr > 0);             /* Assert input parameters */
+
+    len = strlen(name);
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (c->valid) {
+        for (lo = 0, hi = c->count; lo < hi; ) {/* Find first entry not below prefix */
+            mid = (lo + hi) / 2;
+            if (pb_cache_name_cmp(c->entries[c->name_idx[mid]].name, name, len) < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        for (; lo < c->count && n < etr
+            && !pb_cache_name_cmp(c->entries[c->name_idx[lo]].name, name, len); lo++) {
+            entries[n++] = c->entries[c->name_idx[lo]];
+        }
+    } else {
+        res = gsmERRNOTENABLED;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    if (er != NULL) {
+        *er = n;
+    }
+    return res;
+}
+
+#endif /* GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__ */
+
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
@@ -33,7 +33,183 @@
 #include "gsm/gsm_private.h"
 #include "gsm/gsm_ping.h"
 #include "gsm/gsm_mem.h"
+#include "gsm/gsm_timeout.h"
 
 #if GSM_CFG_PING || __DOXYGEN__
 
+static void ping_monitor_fn(void* arg);
+
+/**
+ * \brief           Add result of single probe to statistics
+ * \param[in]       msg: Ping message
+ * \param[in]       rtt: Round-trip time in units of milliseconds
+ * \param[in]       lost: Set to `1` when probe has not been replied
+ */
+void
+gsmi_ping_add(gsm_msg_t* msg, uint32_t rtt, uint8_t lost) {
+    gsm_ping_stats_t* s = msg->msg.ping.stats;
+    size_t idx;
+
+    s->sent++;
+    if (lost) {
+        return;
+    }
+    if (!s->received || rtt < s->min) {
+        s->min = rtt;
+    }
+    if (rtt > s->max) {
+        s->max = rtt;
+    }
+    if (s->received) {
+        msg->msg.ping.rtt_diff_sum += rtt > msg->msg.ping.rtt_prev ?
+            rtt - msg->msg.ping.rtt_prev : msg->msg.ping.rtt_prev - rtt;
+    }
+    msg->msg.ping.rtt_prev = rtt;
+    msg->msg.ping.rtt_sum += rtt;
+    s->received++;
+
+    idx = GSM_MIN(GSM_SZ(rtt / GSM_CFG_PING_HIST_BUCKET_MS), GSM_CFG_PING_HIST_BUCKETS - 1);
+    s->hist[idx]++;
+}
+
+/**
+ * \brief           Calculate final statistics when ping command finishes
+ * \note            Function is called from processing thread
+ * \param[in]       msg: Ping message
+ * \param[in]       is_ok: Set to `1` when command finished successfully
+ */
+void
+gsmi_ping_finish(gsm_msg_t* msg, uint8_t is_ok) {
+    gsm_ping_stats_t* s = msg->msg.ping.stats;
+
+    if (s->received) {
+        s->avg = msg->msg.ping.rtt_sum / s->received;
+    }
+    if (s->received > 1) {
+        s->jitter = msg->msg.ping.rtt_diff_sum / (s->received - 1);
+    }
+
+    if (msg->msg.ping.monitor) {
+        gsm.evt.evt.link_quality.host = msg->msg.ping.host;
+        gsm.evt.evt.link_quality.stats = s;
+        gsm.evt.evt.link_quality.res = is_ok ? gsmOK : gsmERR;
+        gsmi_send_cb(GSM_EVT_LINK_QUALITY);     /* Notify user about finished round */
+
+        GSM_CORE_PROTECT();
+        if (gsm.ping_mon.active) {              /* Schedule next round */
+            gsm_timeout_start(gsm.ping_mon.interval, ping_monitor_fn, NULL, &gsm.ping_mon.timeout);
+        }
+        GSM_CORE_UNPROTECT();
+    }
+}
+
+/**
+ * \brief           Send ping message to producer queue
+ * \param[in]       host: Host name or IP address to ping
+ * \param[in]       count: Number of probes
+ * \param[out]      stats: Pointer to output statistics
+ * \param[in]       monitor: Set to `1` when ping is started by background monitor
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+ping_send(const char* host, uint8_t count, gsm_ping_stats_t* stats, uint8_t monitor, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CIPPING;
+    GSM_MSG_VAR_REF(msg).msg.ping.host = host;
+    GSM_MSG_VAR_REF(msg).msg.ping.count = count;
+    GSM_MSG_VAR_REF(msg).msg.ping.stats = stats;
+    GSM_MSG_VAR_REF(msg).msg.ping.monitor = monitor;
+    GSM_MEMSET(stats, 0x00, sizeof(*stats));
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking,
+        GSM_U32(count) * GSM_CFG_PING_TIMEOUT + 10000); /* Send message to producer queue */
+}
+
+/**
+ * \brief           Timeout callback to start next monitor round
+ * \param[in]       arg: Unused
+ */
+static void
+ping_monitor_fn(void* arg) {
+    GSM_UNUSED(arg);
+
+    GSM_CORE_PROTECT();
+    if (gsm.ping_mon.active
+        && ping_send(gsm.ping_mon.host, gsm.ping_mon.count, &gsm.ping_mon.stats, 1, 0) != gsmOK) {
+        gsm_timeout_start(gsm.ping_mon.interval, ping_monitor_fn, NULL, &gsm.ping_mon.timeout); /* Retry later */
+    }
+    GSM_CORE_UNPROTECT();
+}
+
+/**
+ * \brief           Send ping probes to remote host and collect round-trip time statistics
+ * \note            Device must be attached to network with \ref gsm_network_attach
+ * \param[in]       host: Host name or IP address to ping
+ * \param[in]       count: Number of probes, between `1` and `100`
+ * \param[out]      stats: Pointer to output statistics. Must stay valid until command finishes
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ping(const char* host, uint8_t count, gsm_ping_stats_t* stats, uint32_t blocking) {
+    GSM_ASSERT("host != NULL", host != NULL);   /* Assert input parameters */
+    GSM_ASSERT("count > 0 && count <= 100", count > 0 && count <= 100); /* Assert input parameters */
+    GSM_ASSERT("stats != NULL", stats != NULL); /* Assert input parameters */
+
+    return ping_send(host, count, stats, 0, blocking);
+}
+
+/**
+ * \brief           Start background link quality monitor
+ *
+ * First probe round starts immediately. After each round, \ref GSM_EVT_LINK_QUALITY event
+ * is sent and next round is scheduled after `interval` milliseconds
+ *
+ * \param[in]       host: Host name or IP address to ping. Must stay valid until monitor is stopped
+ * \param[in]       count: Number of probes in each round, between `1` and `100`
+ * \param[in]       interval: Time between end of round and start of next one in units of milliseconds
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ping_monitor_start(const char* host, uint8_t count, uint32_t interval) {
+    gsmr_t res;
+
+    GSM_ASSERT("host != NULL", host != NULL);   /* Assert input parameters */
+    GSM_ASSERT("count > 0 && count <= 100", count > 0 && count <= 100); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();
+    if (gsm.ping_mon.active) {
+        GSM_CORE_UNPROTECT();
+        return gsmERR;                          /* Monitor is already running */
+    }
+    gsm.ping_mon.host = host;
+    gsm.ping_mon.count = count;
+    gsm.ping_mon.interval = interval;
+    res = gsm_timeout_start(0, ping_monitor_fn, NULL, &gsm.ping_mon.timeout);
+    gsm.ping_mon.active = res == gsmOK;
+    GSM_CORE_UNPROTECT();
+    return res;
+}
+
+/**
+ * \brief           Stop background link quality monitor
+ * \note            Probe round in progress still finishes and sends its event
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ping_monitor_stop(void) {
+    GSM_CORE_PROTECT();
+    if (!gsm.ping_mon.active) {
+        GSM_CORE_UNPROTECT();
+        return gsmERR;                          /* Monitor is not running */
+    }
+    gsm.ping_mon.active = 0;
+    gsm_timeout_stop(gsm.ping_mon.timeout);     /* Next round may not be scheduled yet */
+    GSM_CORE_UNPROTECT();
+    return gsmOK;
+}
+
 #endif /* GSM_CFG_PING || __DOXYGEN__ */
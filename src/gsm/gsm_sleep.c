@@ -0,0 +1,225 @@
+/**	
+ * \file            gsm_sleep.c
+ * \brief           Sleep and power saving API
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sleep.h"
+#include "gsm/gsm_mem.h"
+
+#if GSM_CFG_SLEEP || __DOXYGEN__
+
+/**
+ * \brief           Get time producer may wait for new message before device is put to sleep
+ * \note            Core must be protected when calling this function
+ * \return          Idle time in units of milliseconds, `0` to wait without limit
+ */
+uint32_t
+gsmi_sleep_idle_time(void) {
+    if (gsm.sleep.mode && !gsm.sleep.asleep && gsm.status.f.dev_present) {
+        return gsm.sleep.idle_time;
+    }
+    return 0;
+}
+
+/**
+ * \brief           Allow device to enter sleep mode after producer queue was idle
+ * \note            Function is called from producer thread with core protected
+ */
+void
+gsmi_sleep_enter(void) {
+    if (!gsm.sleep.mode || gsm.sleep.asleep) {
+        return;
+    }
+    if (gsm.sleep.mode == 1 && gsm.ll.wake_fn != NULL) {
+        gsm.ll.wake_fn(0);                      /* Release DTR line, device may sleep */
+    }
+    gsm.sleep.asleep = 1;
+    GSM_DEBUGF(GSM_CFG_DBG_VAR | GSM_DBG_TYPE_TRACE,
+        "[SLEEP] Device allowed to sleep\r\n");
+}
+
+/**
+ * \brief           Wake device up before next command is sent
+ * \note            Function is called from producer thread with core protected exactly once.
+ *                  Core is released during wakeup delay so that reply to preamble is processed
+ *                  before next command starts
+ */
+void
+gsmi_sleep_wake(void) {
+    if (!gsm.sleep.asleep) {
+        return;
+    }
+    gsm.sleep.asleep = 0;
+    if (gsm.sleep.mode == 1 && gsm.ll.wake_fn != NULL) {
+        gsm.ll.wake_fn(1);                      /* Drive DTR line, device wakes up */
+    } else {
+        GSM_AT_PORT_SEND(GSM_CFG_SLEEP_WAKE_PREAMBLE, sizeof(GSM_CFG_SLEEP_WAKE_PREAMBLE) - 1);
+    }
+    GSM_CORE_UNPROTECT();
+    gsm_delay(GSM_CFG_SLEEP_WAKE_DELAY);
+    GSM_CORE_PROTECT();
+    GSM_DEBUGF(GSM_CFG_DBG_VAR | GSM_DBG_TYPE_TRACE,
+        "[SLEEP] Device woken up\r\n");
+}
+
+/**
+ * \brief           Encode time to 3GPP TS 24.008 GPRS timer value
+ * \param[in]       time: Time in units of seconds
+ * \param[in]       units: List of unit lengths in units of seconds, indexed by unit code
+ * \param[in]       units_len: Number of entries in unit list
+ * \param[out]      out: Encoded 8-bit timer value
+ * \return          `1` on success, `0` if time cannot be encoded
+ */
+static uint8_t
+encode_timer(uint32_t time, const uint32_t* units, size_t units_len, uint8_t* out) {
+    uint8_t best = 0xFF;
+    uint32_t val = 0;
+
+    /* Use smallest unit which can represent time, rounding up */
+    for (size_t i = 0; i < units_len; i++) {
+        uint32_t v = (time + units[i] - 1) / units[i];
+
+        if (v <= 0x1F && (best == 0xFF || units[i] < units[best])) {
+            best = (uint8_t)i;
+            val = v;
+        }
+    }
+    if (best == 0xFF) {
+        return 0;
+    }
+    *out = GSM_U8((best << 5) | val);
+    return 1;
+}
+
+/**
+ * \brief           Enable sleep mode of device
+ *
+ * When gsm_ll_t.wake_fn is set, device uses DTR controlled sleep (`AT+CSCLK=1`)
+ * and is allowed to sleep by releasing DTR line.
+ * Otherwise device sleeps automatically when AT port is idle (`AT+CSCLK=2`)
+ * and is woken up with \ref GSM_CFG_SLEEP_WAKE_PREAMBLE.
+ *
+ * Device is put to sleep when no command is sent for `idle_time` milliseconds
+ * and woken up automatically before next command.
+ *
+ * \note            Sleep mode is disabled on device reset
+ * \param[in]       idle_time: Idle time before sleep in units of milliseconds
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sleep_enable(uint32_t idle_time, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("idle_time > 0", idle_time > 0); /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CSCLK_SET;
+    GSM_MSG_VAR_REF(msg).msg.sleep.mode = gsm.ll.wake_fn != NULL ? 1 : 2;
+    GSM_MSG_VAR_REF(msg).msg.sleep.idle_time = idle_time;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Disable sleep mode of device
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sleep_disable(uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CSCLK_SET;
+    GSM_MSG_VAR_REF(msg).msg.sleep.mode = 0;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Set power saving mode (PSM) with `AT+CPSMS` command
+ *
+ * Requested timers are rounded up to nearest value network accepts.
+ * Network may assign different values
+ *
+ * \param[in]       en: Set to `1` to enable PSM, `0` to disable it
+ * \param[in]       tau: Requested periodic TAU time (T3412) in units of seconds
+ * \param[in]       active_time: Requested active time (T3324) in units of seconds
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sleep_set_psm(uint8_t en, uint32_t tau, uint32_t active_time, uint32_t blocking) {
+    /* Unit lengths of T3412 extended value and T3324 value, indexed by unit code */
+    static const uint32_t tau_units[] = { 600, 3600, 36000, 2, 30, 60, 1152000 };
+    static const uint32_t active_units[] = { 2, 60, 360 };
+    uint8_t tau_val = 0, active_val = 0;
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    if (en && (!encode_timer(tau, tau_units, GSM_ARRAYSIZE(tau_units), &tau_val)
+        || !encode_timer(active_time, active_units, GSM_ARRAYSIZE(active_units), &active_val))) {
+        return gsmPARERR;
+    }
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPSMS_SET;
+    GSM_MSG_VAR_REF(msg).msg.psm.en = GSM_U8(!!en);
+    GSM_MSG_VAR_REF(msg).msg.psm.tau = tau_val;
+    GSM_MSG_VAR_REF(msg).msg.psm.active = active_val;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Set extended discontinuous reception (eDRX) with `AT+CEDRXS` command
+ * \param[in]       en: Set to `1` to enable eDRX, `0` to disable it
+ * \param[in]       act: Access technology type, `4` for LTE Cat-M1, `5` for NB-IoT
+ * \param[in]       cycle: Requested eDRX cycle value, between `0` and `15`, as defined in 3GPP TS 24.008
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sleep_set_edrx(uint8_t en, uint8_t act, uint8_t cycle, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("cycle <= 15", cycle <= 15);     /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CEDRXS_SET;
+    GSM_MSG_VAR_REF(msg).msg.edrx.en = GSM_U8(!!en);
+    GSM_MSG_VAR_REF(msg).msg.edrx.act = act;
+    GSM_MSG_VAR_REF(msg).msg.edrx.cycle = cycle;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 1000);   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
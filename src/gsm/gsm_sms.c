@@ -33,6 +33,7 @@
 #include "gsm/gsm_private.h"
 #include "gsm/gsm_sms.h"
 #include "gsm/gsm_mem.h"
+#include "gsm/gsm_sms_pdu.h"
 
 #if GSM_CFG_SMS || __DOXYGEN__
 
@@ -88,6 +89,22 @@ check_sms_mem(gsm_mem_t mem, uint8_t can_curr) {
     return res;
 }
 
+/**
+ * \brief           Get first command for operation on SMS memory
+ * \param[in]       mem: Memory used for operation
+ * \param[in]       cmd: Command to start with when memory is already active
+ * \return          \ref GSM_CMD_CPMS_SET when memory must be selected first, `cmd` otherwise
+ */
+static gsm_cmd_t
+sms_mem_first_cmd(gsm_mem_t mem, gsm_cmd_t cmd) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (mem != GSM_MEM_CURRENT && mem != gsm.sms.mem[GSM_SMS_OPERATION_IDX].current) {
+        cmd = GSM_CMD_CPMS_SET;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return cmd;
+}
+
 /**
  * \brief           Enable SMS functionality
  * \param[in]       blocking: Status whether command should be blocking or not
@@ -143,6 +160,63 @@ gsm_sms_send(const char* num, const char* text, uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Send SMS text to multiple recipients in PDU mode
+ *
+ *                  Text longer than single message is split to concatenated messages.
+ *                  All recipients are processed back-to-back by single request and results
+ *                  are reported with single \ref GSM_EVT_SMS_SEND_BATCH event.
+ *
+ * \note            Recipients array and text must stay valid until command finishes.
+ *                  `res` and `pos` fields of every entry are written by stack
+ * \param[in,out]   rcpts: Array of recipients
+ * \param[in]       count: Number of recipients in array
+ * \param[in]       text: UTF-8 text to send
+ * \param[in]       enc: Text encoding, use \ref GSM_SMS_ENC_AUTO to select automatically
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK if all recipients received message, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send_batch(gsm_sms_recipient_t* rcpts, size_t count, const char* text, gsm_sms_enc_t enc, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    size_t len, parts, i;
+
+    GSM_ASSERT("rcpts != NULL", rcpts != NULL); /* Assert input parameters */
+    GSM_ASSERT("count > 0", count > 0);         /* Assert input parameters */
+    GSM_ASSERT("text != NULL", text != NULL);   /* Assert input parameters */
+    for (i = 0; i < count; i++) {
+        GSM_ASSERT("rcpts[i].num != NULL", rcpts[i].num != NULL);   /* Assert input parameters */
+        rcpts[i].res = gsmERR;
+        rcpts[i].pos = 0;
+    }
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    len = strlen(text);
+    if (enc == GSM_SMS_ENC_AUTO) {
+        enc = gsmi_sms_pdu_encoding(text, len);
+    }
+    parts = gsmi_sms_pdu_parts(text, len, enc);
+    GSM_ASSERT("parts <= 255", parts <= 255);   /* Concatenated reference allows up to 255 parts */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGS;
+    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CMGF;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.text = text;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.text_len = len;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = 0;   /* Send in PDU mode */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.enc = enc;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.rcpts = rcpts;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.rcpts_len = count;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.parts = parts;
+
+    /* Allow time for every message on top of base timeout */
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000 + 10000 * GSM_U32(count * parts));   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
 /**
  * \brief           Read SMS entry at specific memory and position
  * \param[in]       mem: Memory used to read message from
@@ -167,11 +241,7 @@ gsm_sms_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update,
     entry->mem = mem;                           /* Set memory */
     entry->pos = pos;                           /* Set device position */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGR;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).cmd = sms_mem_first_cmd(mem, GSM_CMD_CMGF);  /* Select memory only when not active */
     GSM_MSG_VAR_REF(msg).msg.sms_read.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.sms_read.pos = pos;
     GSM_MSG_VAR_REF(msg).msg.sms_read.entry = entry;
@@ -197,17 +267,55 @@ gsm_sms_delete(gsm_mem_t mem, size_t pos, uint32_t blocking) {
 
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGD;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).cmd = sms_mem_first_cmd(mem, GSM_CMD_CMGD);  /* Select memory only when not active */
     GSM_MSG_VAR_REF(msg).msg.sms_delete.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.sms_delete.pos = pos;
 
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+/**
+ * \brief           Delete all SMS entries with specific status from SMS memory
+ *
+ *                  Messages are deleted with single `AT+CMGD` command using delete flag.
+ *                  Flags are cumulative, deleting status also deletes all statuses before it:
+ *
+ *                      - \ref GSM_SMS_STATUS_READ: Delete read messages
+ *                      - \ref GSM_SMS_STATUS_SENT: Delete read and sent messages
+ *                      - \ref GSM_SMS_STATUS_UNSENT: Delete read, sent and unsent messages
+ *                      - \ref GSM_SMS_STATUS_ALL: Delete all messages, including unread
+ *
+ * \param[in]       mem: Memory to delete from. Use \ref GSM_MEM_CURRENT to delete from current memory
+ * \param[in]       stat: SMS status filter. \ref GSM_SMS_STATUS_UNREAD is not supported
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_delete_all(gsm_mem_t mem, gsm_sms_status_t stat, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    uint8_t delflag;
+
+    switch (stat) {
+        case GSM_SMS_STATUS_READ:   delflag = 1; break;
+        case GSM_SMS_STATUS_SENT:   delflag = 2; break;
+        case GSM_SMS_STATUS_UNSENT: delflag = 3; break;
+        case GSM_SMS_STATUS_ALL:    delflag = 4; break;
+        default:                    delflag = 0; break;
+    }
+    GSM_ASSERT("delflag > 0", delflag > 0);     /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGD;
+    GSM_MSG_VAR_REF(msg).cmd = sms_mem_first_cmd(mem, GSM_CMD_CMGD);  /* Select memory only when not active */
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.pos = 1;    /* Index is ignored with delete flag */
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.delflag = delflag;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
 /**
  * \brief           List SMS from SMS memory
  * \param[in]       mem: Memory to read entries from. Use \ref GSM_MEM_CURRENT to read from current memory
@@ -235,11 +343,7 @@ gsm_sms_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, siz
     }
     memset(entries, 0x00, sizeof(*entries) * etr);  /* Reset data structure */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGL;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).cmd = sms_mem_first_cmd(mem, GSM_CMD_CMGF);  /* Select memory only when not active */
     GSM_MSG_VAR_REF(msg).msg.sms_list.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.sms_list.status = stat;
     GSM_MSG_VAR_REF(msg).msg.sms_list.entries = entries;
@@ -251,6 +355,49 @@ gsm_sms_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, siz
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+/**
+ * \brief           List SMS from SMS memory with callback for every entry
+ *
+ *                  Single entry structure is reused for all entries, regardless of number of messages in memory.
+ *                  Callback may stop listing with \ref GSM_SMS_LIST_STOP and mark entry for delete with \ref GSM_SMS_LIST_DELETE.
+ *                  Marked entries are deleted after list command finishes, as part of the same request.
+ *
+ * \note            Callback is called from processing thread and must not call blocking API functions
+ * \param[in]       mem: Memory to read entries from. Use \ref GSM_MEM_CURRENT to read from current memory
+ * \param[in]       stat: SMS status to read, either `read`, `unread`, `sent`, `unsent` or `all`
+ * \param[in]       entry: Pointer to entry used as working memory. It must be valid until command finishes
+ * \param[in]       fn: Callback function called for every parsed entry
+ * \param[in]       arg: User argument passed to callback function
+ * \param[in]       update: Flag indicates update. Set to `1` to change `UNREAD` messages to `READ` or `0` to leave as is
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_list_stream(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entry, gsm_sms_list_fn fn, void* arg, uint8_t update, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("entry != NULL", entry != NULL); /* Assert input parameters */
+    GSM_ASSERT("fn != NULL", fn != NULL);       /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+
+    memset(entry, 0x00, sizeof(*entry));        /* Reset data structure */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGL;
+    GSM_MSG_VAR_REF(msg).cmd = sms_mem_first_cmd(mem, GSM_CMD_CMGF);  /* Select memory only when not active */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.status = stat;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.entries = entry;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.etr = 1;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.fn = fn;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.arg = arg;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.update = update;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.format = 1;   /* Send as plain text */
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
 /**
  * \brief           Set preferred storage for SMS
  * \param[in]       mem1: Preferred memory for read/delete SMS operations. Use \ref GSM_MEM_CURRENT to keep it as is
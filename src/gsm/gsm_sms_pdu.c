@@ -0,0 +1,326 @@
+/**	
+ * \file            gsm_sms_pdu.c
+ * \brief           SMS PDU mode encoder
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sms_pdu.h"
+#include "gsm/gsm_unicode.h"
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+#define SMS_PDU_GSM7_SINGLE         160         /*!< Septets in single GSM 7-bit message */
+#define SMS_PDU_GSM7_CONCAT         153         /*!< Septets in concatenated GSM 7-bit part */
+#define SMS_PDU_UCS2_SINGLE         70          /*!< Characters in single UCS2 message */
+#define SMS_PDU_UCS2_CONCAT         67          /*!< Characters in concatenated UCS2 part */
+#define SMS_PDU_UDH_LEN             6           /*!< Length of concatenation user data header, incl. UDHL */
+#define SMS_PDU_UDH_SEPTETS         7           /*!< User data header length in septets, incl. fill bit */
+#define SMS_PDU_GSM7_ESC            0x1B        /*!< Escape to GSM 7-bit extension table */
+
+/**
+ * \brief           Get next unicode code point from UTF-8 text
+ * \param[in]       text: UTF-8 text
+ * \param[in]       len: Length of text in units of bytes
+ * \param[in,out]   pos: Current position in text, advanced past decoded sequence
+ * \return          Code point or `?` for invalid sequence
+ */
+static uint32_t
+sms_pdu_next_cp(const char* text, size_t len, size_t* pos) {
+    gsm_unicode_t uni = { 0 };
+    gsmr_t res;
+    uint32_t cp;
+    uint8_t i;
+
+    do {
+        res = gsmi_unicode_decode(&uni, GSM_U8(text[*pos]));
+        (*pos)++;
+    } while (res == gsmINPROG && *pos < len);
+    if (res != gsmOK) {
+        return '?';
+    }
+    if (uni.t == 1) {
+        return uni.ch[0];
+    }
+    cp = uni.ch[0] & (0x7F >> uni.t);           /* Lead byte payload bits */
+    for (i = 1; i < uni.t; i++) {
+        cp = (cp << 6) | (uni.ch[i] & 0x3F);
+    }
+    return cp;
+}
+
+/**
+ * \brief           Map code point to GSM 7-bit default alphabet
+ * \param[in]       cp: Code point to map
+ * \param[out]      out: Output septets, at least `2` entries
+ * \return          Number of septets, `0` if character is not available in alphabet
+ */
+static uint8_t
+sms_pdu_gsm7(uint32_t cp, uint8_t* out) {
+    switch (cp) {
+        case '@':   out[0] = 0x00; return 1;
+        case 0xA3:  out[0] = 0x01; return 1;    /* Pound sign */
+        case '$':   out[0] = 0x02; return 1;
+        case '_':   out[0] = 0x11; return 1;
+        case '^':   out[1] = 0x14; break;
+        case '{':   out[1] = 0x28; break;
+        case '}':   out[1] = 0x29; break;
+        case '\\':  out[1] = 0x2F; break;
+        case '[':   out[1] = 0x3C; break;
+        case '~':   out[1] = 0x3D; break;
+        case ']':   out[1] = 0x3E; break;
+        case '|':   out[1] = 0x40; break;
+        case 0x20AC:out[1] = 0x65; break;       /* Euro sign */
+        case '`':   return 0;
+        default:
+            if (cp == '\n' || cp == '\r' || (cp >= 0x20 && cp < 0x7F)) {
+                out[0] = GSM_U8(cp);            /* Same as ASCII */
+                return 1;
+            }
+            return 0;
+    }
+    out[0] = SMS_PDU_GSM7_ESC;                  /* Extension table character */
+    return 2;
+}
+
+/**
+ * \brief           Send single byte as 2 hex characters to AT port
+ * \param[in]       b: Byte to send
+ */
+static void
+sms_pdu_send_byte(uint8_t b) {
+    static const char hex[] = "0123456789ABCDEF";
+    char h[2];
+
+    h[0] = hex[b >> 4];
+    h[1] = hex[b & 0x0F];
+    gsmi_at_tx_add(h, 2);
+}
+
+/**
+ * \brief           Get number of digits in phone number, ignoring `+` and separators
+ * \param[in]       num: Phone number
+ * \return          Number of digits
+ */
+static size_t
+sms_pdu_num_digits(const char* num) {
+    size_t digits = 0;
+
+    for (; *num != '\0'; num++) {
+        if (GSM_CHARISNUM(*num)) {
+            digits++;
+        }
+    }
+    return digits;
+}
+
+/**
+ * \brief           Select encoding for text
+ * \param[in]       text: UTF-8 text
+ * \param[in]       len: Length of text in units of bytes
+ * \return          \ref GSM_SMS_ENC_GSM7 if all characters are in default alphabet, \ref GSM_SMS_ENC_UCS2 otherwise
+ */
+gsm_sms_enc_t
+gsmi_sms_pdu_encoding(const char* text, size_t len) {
+    uint8_t s[2];
+    size_t pos = 0;
+
+    while (pos < len) {
+        if (!sms_pdu_gsm7(sms_pdu_next_cp(text, len, &pos), s)) {
+            return GSM_SMS_ENC_UCS2;
+        }
+    }
+    return GSM_SMS_ENC_GSM7;
+}
+
+/**
+ * \brief           Find end of message part starting at specific position
+ * \note            Extension table characters are never split between parts
+ * \param[in]       text: UTF-8 text
+ * \param[in]       len: Length of text in units of bytes
+ * \param[in]       start: Start position of part in text
+ * \param[in]       enc: Encoding, \ref GSM_SMS_ENC_GSM7 or \ref GSM_SMS_ENC_UCS2
+ * \param[in]       concat: Set to `1` if part is in concatenated message and needs header space
+ * \param[out]      units: Number of septets (GSM 7-bit) or characters (UCS2) in part
+ * \return          End position of part in text
+ */
+size_t
+gsmi_sms_pdu_part(const char* text, size_t len, size_t start, gsm_sms_enc_t enc, uint8_t concat, size_t* units) {
+    size_t max, pos = start, next, u = 0;
+    uint8_t s[2], n;
+
+    if (enc == GSM_SMS_ENC_UCS2) {
+        max = concat ? SMS_PDU_UCS2_CONCAT : SMS_PDU_UCS2_SINGLE;
+    } else {
+        max = concat ? SMS_PDU_GSM7_CONCAT : SMS_PDU_GSM7_SINGLE;
+    }
+    while (pos < len) {
+        next = pos;
+        n = sms_pdu_gsm7(sms_pdu_next_cp(text, len, &next), s);
+        if (enc == GSM_SMS_ENC_UCS2 || n == 0) {
+            n = 1;                              /* Single unit, replaced if not available */
+        }
+        if (u + n > max) {
+            break;
+        }
+        u += n;
+        pos = next;
+    }
+    *units = u;
+    return pos;
+}
+
+/**
+ * \brief           Get number of messages needed to send text
+ * \param[in]       text: UTF-8 text
+ * \param[in]       len: Length of text in units of bytes
+ * \param[in]       enc: Encoding, \ref GSM_SMS_ENC_GSM7 or \ref GSM_SMS_ENC_UCS2
+ * \return          Number of parts, `1` for text to fit single message
+ */
+size_t
+gsmi_sms_pdu_parts(const char* text, size_t len, gsm_sms_enc_t enc) {
+    size_t pos, units, parts = 0;
+
+    if (gsmi_sms_pdu_part(text, len, 0, enc, 0, &units) == len) {
+        return 1;
+    }
+    for (pos = 0; pos < len; parts++) {
+        pos = gsmi_sms_pdu_part(text, len, pos, enc, 1, &units);
+    }
+    return parts;
+}
+
+/**
+ * \brief           Get TPDU length in units of bytes, used by `AT+CMGS` command in PDU mode
+ * \param[in]       num: Destination phone number
+ * \param[in]       enc: Encoding, \ref GSM_SMS_ENC_GSM7 or \ref GSM_SMS_ENC_UCS2
+ * \param[in]       units: Number of units in part, as returned by \ref gsmi_sms_pdu_part
+ * \param[in]       concat: Set to `1` if part is in concatenated message
+ * \return          Length of TPDU, excluding service center address
+ */
+size_t
+gsmi_sms_pdu_tpdu_len(const char* num, gsm_sms_enc_t enc, size_t units, uint8_t concat) {
+    size_t ud;
+
+    if (enc == GSM_SMS_ENC_UCS2) {
+        ud = 2 * units + (concat ? SMS_PDU_UDH_LEN : 0);
+    } else {
+        ud = (7 * (units + (concat ? SMS_PDU_UDH_SEPTETS : 0)) + 7) / 8;
+    }
+    /* First octet, MR, DA length, DA type, DA digits, PID, DCS, UDL and user data */
+    return 4 + (sms_pdu_num_digits(num) + 1) / 2 + 3 + ud;
+}
+
+/**
+ * \brief           Send SMS-SUBMIT PDU for single message part as hex string to AT port
+ * \param[in]       num: Destination phone number
+ * \param[in]       text: UTF-8 text
+ * \param[in]       start: Start position of part in text
+ * \param[in]       end: End position of part in text
+ * \param[in]       enc: Encoding, \ref GSM_SMS_ENC_GSM7 or \ref GSM_SMS_ENC_UCS2
+ * \param[in]       units: Number of units in part, as returned by \ref gsmi_sms_pdu_part
+ * \param[in]       ref: Concatenated message reference number
+ * \param[in]       total: Number of parts in message. Header is not included when `1`
+ * \param[in]       seq: Part sequence number, starting with `1`
+ */
+void
+gsmi_sms_pdu_send(const char* num, const char* text, size_t start, size_t end, gsm_sms_enc_t enc, size_t units, uint8_t ref, uint8_t total, uint8_t seq) {
+    uint8_t concat = total > 1, s[2], n, b = 0, i;
+    uint32_t acc = 0, cp;
+    size_t nbits = 0, digits;
+
+    sms_pdu_send_byte(0x00);                    /* Use service center from SIM */
+    sms_pdu_send_byte(concat ? 0x41 : 0x01);    /* SMS-SUBMIT, UDHI flag for concatenated message */
+    sms_pdu_send_byte(0x00);                    /* Message reference, set by device */
+
+    /* Destination address in swapped semi-octets */
+    digits = sms_pdu_num_digits(num);
+    sms_pdu_send_byte(GSM_U8(digits));
+    sms_pdu_send_byte(*num == '+' ? 0x91 : 0x81);   /* International or unknown number type */
+    for (i = 0; *num != '\0'; num++) {
+        if (GSM_CHARISNUM(*num)) {
+            if (i++ & 0x01) {
+                sms_pdu_send_byte(GSM_U8(b | (GSM_CHARTONUM(*num) << 4)));
+            } else {
+                b = GSM_U8(GSM_CHARTONUM(*num));
+            }
+        }
+    }
+    if (i & 0x01) {
+        sms_pdu_send_byte(GSM_U8(b | 0xF0));    /* Odd number of digits */
+    }
+
+    sms_pdu_send_byte(0x00);                    /* Protocol identifier */
+    sms_pdu_send_byte(enc == GSM_SMS_ENC_UCS2 ? 0x08 : 0x00);   /* Data coding scheme */
+    if (enc == GSM_SMS_ENC_UCS2) {
+        sms_pdu_send_byte(GSM_U8(2 * units + (concat ? SMS_PDU_UDH_LEN : 0)));
+    } else {
+        sms_pdu_send_byte(GSM_U8(units + (concat ? SMS_PDU_UDH_SEPTETS : 0)));
+    }
+    if (concat) {                               /* Concatenated message header, 8-bit reference */
+        sms_pdu_send_byte(SMS_PDU_UDH_LEN - 1);
+        sms_pdu_send_byte(0x00);
+        sms_pdu_send_byte(0x03);
+        sms_pdu_send_byte(ref);
+        sms_pdu_send_byte(total);
+        sms_pdu_send_byte(seq);
+        nbits = 1;                              /* Fill bit to septet boundary */
+    }
+
+    while (start < end) {
+        cp = sms_pdu_next_cp(text, end, &start);
+        if (enc == GSM_SMS_ENC_UCS2) {
+            if (cp > 0xFFFF) {
+                cp = 0xFFFD;                    /* Replacement character, outside basic plane */
+            }
+            sms_pdu_send_byte(GSM_U8(cp >> 8));
+            sms_pdu_send_byte(GSM_U8(cp));
+            continue;
+        }
+        n = sms_pdu_gsm7(cp, s);
+        if (n == 0) {
+            s[0] = '?';
+            n = 1;
+        }
+        for (i = 0; i < n; i++) {               /* Pack septets, LSB first */
+            acc |= (uint32_t)s[i] << nbits;
+            nbits += 7;
+            while (nbits >= 8) {
+                sms_pdu_send_byte(GSM_U8(acc));
+                acc >>= 8;
+                nbits -= 8;
+            }
+        }
+    }
+    if (nbits > 0) {
+        sms_pdu_send_byte(GSM_U8(acc));
+    }
+}
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
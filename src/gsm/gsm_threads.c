@@ -47,16 +47,31 @@ gsm_thread_producer(void* const arg) {
     gsm_t* e = arg;                             /* Thread argument is main structure */
     gsm_msg_t* msg;                             /* Message structure */
     gsmr_t res;
-    uint32_t time;
+    uint32_t time, idle = 0;
     
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsmi_inst = e;                              /* Thread works for instance it was created for */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
     GSM_CORE_PROTECT();                         /* Protect system */
     while (1) {
+#if GSM_CFG_SLEEP
+        idle = gsmi_sleep_idle_time();          /* Limit wait time when device may go to sleep */
+#endif /* GSM_CFG_SLEEP */
         GSM_CORE_UNPROTECT();                   /* Unprotect system */
-        time = gsm_sys_mbox_get(&gsm.mbox_producer, (void **)&msg, 0);  /* Get message from queue */
+        time = gsm_sys_mbox_get(&gsm.mbox_producer, (void **)&msg, idle);   /* Wait for message in any lane */
         GSM_CORE_PROTECT();                     /* Protect system */
-        if (time == GSM_SYS_TIMEOUT || msg == NULL) {   /* Check valid message */
+        if (time == GSM_SYS_TIMEOUT) {
+#if GSM_CFG_SLEEP
+            gsmi_sleep_enter();                 /* No command for idle time, device may sleep */
+#endif /* GSM_CFG_SLEEP */
+            continue;
+        }
+        if ((msg = gsmi_get_msg_from_producer_lanes()) == NULL) {   /* Get message with highest priority */
             continue;
         }
+#if GSM_CFG_SLEEP
+        gsmi_sleep_wake();                      /* Wake device before command is sent */
+#endif /* GSM_CFG_SLEEP */
 
         /* For reset message, we can have delay! */
         if (CMD_IS_DEF(GSM_CMD_RESET) && msg->msg.reset.delay) {
@@ -72,6 +87,9 @@ gsm_thread_producer(void* const arg) {
             GSM_CORE_UNPROTECT();               /* Release protection, think if this is necessary, probably shouldn't be here */
             gsm_sys_sem_wait(&e->sem_sync, 0000);	/* Lock semaphore, should be unlocked before! */
             GSM_CORE_PROTECT();                 /* Protect system again, think if this is necessary, probably shouldn't be here */
+#if GSM_CFG_CMD_STATS
+            gsmi_cmd_stats_start(msg);
+#endif /* GSM_CFG_CMD_STATS */
             res = msg->fn(msg);                 /* Process this message, check if command started at least */
             if (res == gsmOK) {                 /* We have valid data and data were sent */
                 GSM_CORE_UNPROTECT();           /* Release protection */
@@ -80,6 +98,9 @@ gsm_thread_producer(void* const arg) {
                 gsm_sys_sem_release(&e->sem_sync);  /* Release protection and start over later */
                 if (time == GSM_SYS_TIMEOUT) {  /* Sync timeout occurred? */
                     res = gsmTIMEOUT;           /* Timeout on command */
+#if GSM_CFG_CONN
+                    gsm.conns_status_valid = 0; /* Responses may have been missed, query full status next time */
+#endif /* GSM_CFG_CONN */
                 }
             } else {
                 gsm_sys_sem_release(&e->sem_sync);  /* We failed, release semaphore automatically */
@@ -93,6 +114,18 @@ gsm_thread_producer(void* const arg) {
          * release semaphore and notify finished with processing
          * otherwise directly free memory of message structure
          */
+#if GSM_CFG_CMD_STATS
+        if (msg->fn != NULL) {
+            gsmi_cmd_stats_finish(msg, res);    /* Add latencies before message is released */
+        }
+#endif /* GSM_CFG_CMD_STATS */
+        gsmi_msg_coalesce_finish(msg, res);     /* Complete duplicate queries attached to this message */
+#if GSM_CFG_CMD_EVT
+        if (res != gsmOK) {                     /* Command did not start or timed out */
+            msg->res = res;
+        }
+        gsmi_msg_cmd_evt(msg);                  /* Notify user about command result */
+#endif /* GSM_CFG_CMD_EVT */
         if (msg->is_blocking) {
             gsm_sys_sem_release(&msg->sem);     /* Release semaphore only */
         } else {
@@ -115,6 +148,11 @@ gsm_thread_process(void* const arg) {
     gsm_msg_t* msg;
     uint32_t time;
     
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsmi_inst = arg;                            /* Thread works for instance it was created for */
+#else
+    GSM_UNUSED(arg);
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
 #if !GSM_CFG_INPUT_USE_PROCESS
     GSM_CORE_PROTECT();                         /* Protect system */
     while (1) {
@@ -139,3 +177,31 @@ gsm_thread_process(void* const arg) {
 #endif /* !GSM_CFG_INPUT_USE_PROCESS */
     }
 }
+
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+
+/**
+ * \brief           Thread for calling user callbacks of deferred events
+ *
+ *                  Processing thread only writes event copy to queue,
+ *                  so that slow user callback does not block parsing of received data
+ *
+ * \sa              GSM_CFG_EVT_DEFERRED
+ */
+void
+gsm_thread_evt(void* const arg) {
+    gsm_evt_deferred_t* e;
+
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsmi_inst = arg;                            /* Thread works for instance it was created for */
+#else
+    GSM_UNUSED(arg);
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    while (1) {
+        if (gsm_sys_mbox_get(&gsm.mbox_evt, (void **)&e, 0) != GSM_SYS_TIMEOUT && e != NULL) {
+            gsmi_evt_deferred_dispatch(e);      /* Call user callbacks and release event */
+        }
+    }
+}
+
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
@@ -32,10 +32,101 @@
  */
 #include "gsm/gsm_private.h"
 #include "gsm/gsm_timeout.h"
-#include "gsm/gsm_mem.h"
 
-static gsm_timeout_t* first_timeout;
-static uint32_t last_timeout_time;
+#if GSM_CFG_MAX_TIMEOUTS > 0xFE
+#error "GSM_CFG_MAX_TIMEOUTS must not be greater than 254"
+#endif /* GSM_CFG_MAX_TIMEOUTS > 0xFE */
+
+#define TIMEOUT_IDX_NONE            0xFF
+#define TIMEOUT_ID(idx, seq)        ((gsm_timeout_id_t)(((uint32_t)(seq) << 8) | (uint32_t)(idx)))
+#define TIMEOUT_ID_IDX(id)          ((uint8_t)((id) & 0xFF))
+#define TIMEOUT_ID_SEQ(id)          ((uint32_t)(id) >> 8)
+
+/**
+ * \brief           Check if first timeout expires before second one
+ * \param[in]       a: Index of first timeout
+ * \param[in]       b: Index of second timeout
+ * \return          `1` if `a` expires first, `0` otherwise
+ */
+static uint8_t
+timeout_before(uint8_t a, uint8_t b) {
+    return (int32_t)(gsm.timeouts.entries[a].time - gsm.timeouts.entries[b].time) < 0;
+}
+
+/**
+ * \brief           Put timeout to heap position
+ * \param[in]       pos: Position in heap
+ * \param[in]       idx: Timeout index
+ */
+static void
+heap_set(size_t pos, uint8_t idx) {
+    gsm.timeouts.heap[pos] = idx;
+    gsm.timeouts.entries[idx].heap_idx = (uint8_t)pos;
+}
+
+/**
+ * \brief           Move timeout up the heap until order is valid
+ * \param[in]       pos: Position of timeout in heap
+ */
+static void
+heap_up(size_t pos) {
+    uint8_t idx = gsm.timeouts.heap[pos];
+    size_t parent;
+
+    while (pos > 0) {
+        parent = (pos - 1) / 2;
+        if (!timeout_before(idx, gsm.timeouts.heap[parent])) {
+            break;
+        }
+        heap_set(pos, gsm.timeouts.heap[parent]);
+        pos = parent;
+    }
+    heap_set(pos, idx);
+}
+
+/**
+ * \brief           Move timeout down the heap until order is valid
+ * \param[in]       pos: Position of timeout in heap
+ */
+static void
+heap_down(size_t pos) {
+    uint8_t idx = gsm.timeouts.heap[pos];
+    size_t child;
+
+    while ((child = 2 * pos + 1) < gsm.timeouts.heap_len) {
+        if ((child + 1) < gsm.timeouts.heap_len && timeout_before(gsm.timeouts.heap[child + 1], gsm.timeouts.heap[child])) {
+            child++;                                /* Use child which expires first */
+        }
+        if (!timeout_before(gsm.timeouts.heap[child], idx)) {
+            break;
+        }
+        heap_set(pos, gsm.timeouts.heap[child]);
+        pos = child;
+    }
+    heap_set(pos, idx);
+}
+
+/**
+ * \brief           Remove timeout from heap and return it to free stack
+ * \param[in]       idx: Timeout index
+ */
+static void
+timeout_release(uint8_t idx) {
+    size_t pos = gsm.timeouts.entries[idx].heap_idx;
+
+    gsm.timeouts.heap_len--;
+    if (pos != gsm.timeouts.heap_len) {             /* Move last entry to empty place */
+        heap_set(pos, gsm.timeouts.heap[gsm.timeouts.heap_len]);
+        if (pos > 0 && timeout_before(gsm.timeouts.heap[pos], gsm.timeouts.heap[(pos - 1) / 2])) {
+            heap_up(pos);
+        } else {
+            heap_down(pos);
+        }
+    }
+    gsm.timeouts.entries[idx].heap_idx = TIMEOUT_IDX_NONE;
+    gsm.timeouts.entries[idx].fn = NULL;
+    gsm.timeouts.free[gsm.timeouts.free_len++] = idx;
+}
 
 /**
  * \brief           Get time we have to wait before we can process next timeout
@@ -43,48 +134,62 @@ static uint32_t last_timeout_time;
  */
 static uint32_t
 get_next_timeout_diff(void) {
-    uint32_t diff;
-    if (!first_timeout) {
+    int32_t diff;
+
+    if (!gsm.timeouts.heap_len) {
         return 0xFFFFFFFF;
     }
-    diff = gsm_sys_now() - last_timeout_time;   /* Get difference between current time and last process time */
-    if (diff >= first_timeout->time) {          /* Are we over already? */
-        return 0;                               /* We have to immediatelly process this timeout */
-    }
-    return first_timeout->time - diff;          /* Return remaining time for sleep */
+    diff = (int32_t)(gsm.timeouts.entries[gsm.timeouts.heap[0]].time - gsm_sys_now());
+    return diff > 0 ? (uint32_t)diff : 0;
 }
 
 /**
- * \brief           Process next timeout in a linked list
+ * \brief           Process all expired timeouts
  */
 static void
-process_next_timeout(void) {
+process_timeouts(void) {
+    gsm_timeout_fn fn;
+    void* arg;
+    uint8_t idx;
     uint32_t time;
-    
+
     time = gsm_sys_now();
-    
-    /*
-     * Before calling timeout callback, update variable
-     * to make sure we have correct timing in case 
-     * callback creates timeout value again
-     */
-    last_timeout_time = time;                   /* Reset variable when we were last processed */
-    
-    if (first_timeout != NULL) {
-        gsm_timeout_t* to = first_timeout;
-        
+    while (gsm.timeouts.heap_len) {
+        idx = gsm.timeouts.heap[0];
+        if ((int32_t)(time - gsm.timeouts.entries[idx].time) < 0) {
+            break;                                  /* First timeout did not expire yet */
+        }
+
         /*
-         * Before calling callback remove current timeout from list
-         * to make sure we are safe in case callback function
-         * adds a new timeout entry to list
+         * Before calling callback remove current timeout
+         * to make sure it can be used again in case
+         * callback function adds a new timeout
          */
-        first_timeout = first_timeout->next;    /* Set next timeout on a list as first timeout */
-        to->fn(to->arg);                        /* Call user callback function */
-        gsm_mem_free(to);                       /* Free timeout memory */
-        to = NULL;
+        fn = gsm.timeouts.entries[idx].fn;
+        arg = gsm.timeouts.entries[idx].arg;
+        timeout_release(idx);
+        fn(arg);                                    /* Call user callback function */
     }
 }
 
+/**
+ * \brief           Wait for processing thread wakeup
+ * \param[in]       b: Pointer to message queue to get element
+ * \param[out]      m: Pointer to pointer to output variable
+ * \param[in]       timeout: Maximal time to wait (0 = wait forever)
+ * \return          Time in milliseconds waited or \ref GSM_SYS_TIMEOUT
+ */
+static uint32_t
+process_wait(gsm_sys_mbox_t* b, void** m, uint32_t timeout) {
+#if GSM_SYS_THREAD_NOTIFY
+    GSM_UNUSED(b);
+    *m = NULL;
+    return gsm_sys_thread_notify_wait(timeout); /* Port wakes thread with notification, queue is not used */
+#else
+    return gsm_sys_mbox_get(b, m, timeout);
+#endif /* GSM_SYS_THREAD_NOTIFY */
+}
+
 /**
  * \brief           Get next entry from message queue
  * \param[in]       b: Pointer to message queue to get element
@@ -95,132 +200,135 @@ process_next_timeout(void) {
 uint32_t
 gsmi_get_from_mbox_with_timeout_checks(gsm_sys_mbox_t* b, void** m, uint32_t timeout) {
     uint32_t wait_time;
-    do {
-        if (first_timeout == NULL) {            /* We have no timeouts ready? */
-            return gsm_sys_mbox_get(b, m, timeout); /* Get entry from message queue */
-        }
-        wait_time = get_next_timeout_diff();    /* Get time to wait for next timeout execution */
-        if (wait_time == 0 || gsm_sys_mbox_get(b, m, wait_time) == GSM_SYS_TIMEOUT) {
-            GSM_CORE_PROTECT();
-            process_next_timeout();             /* Process with next timeout */
-            GSM_CORE_UNPROTECT();
-        }
-        break;
-    } while (1);
+
+    GSM_CORE_PROTECT();
+    wait_time = get_next_timeout_diff();            /* Get time to wait for next timeout execution */
+    GSM_CORE_UNPROTECT();
+    if (wait_time == 0xFFFFFFFF) {                  /* We have no timeouts ready? */
+        return process_wait(b, m, timeout);         /* Get entry from message queue */
+    }
+    *m = NULL;
+    if (wait_time == 0 || process_wait(b, m, wait_time) == GSM_SYS_TIMEOUT) {
+        GSM_CORE_PROTECT();
+        process_timeouts();                         /* Process expired timeouts */
+        GSM_CORE_UNPROTECT();
+    }
     return wait_time;
 }
 
 /**
- * \brief           Add new timeout to processing list
+ * \brief           Start new timeout
+ * \note            Timeout entries are preallocated, see \ref GSM_CFG_MAX_TIMEOUTS
  * \param[in]       time: Time in units of milliseconds for timeout execution
  * \param[in]       fn: Callback function to call when timeout expires
  * \param[in]       arg: Pointer to user specific argument to call when timeout callback function is executed
+ * \param[out]      id: Pointer to output timeout ID, used with \ref gsm_timeout_stop. Set to `NULL` if not used
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
  */
 gsmr_t
-gsm_timeout_add(uint32_t time, gsm_timeout_fn fn, void* arg) {
+gsm_timeout_start(uint32_t time, gsm_timeout_fn fn, void* arg, gsm_timeout_id_t* id) {
     gsm_timeout_t* to;
-    uint32_t now, diff = 0;
-    
-    to = gsm_mem_calloc(1, sizeof(*to));        /* Allocate memory for timeout structure */
-    if (to == NULL) {
-        return gsmERR;
-    }
-    
-    now = gsm_sys_now();                        /* Get current time */
-    if (first_timeout) {
-        diff = now - last_timeout_time;         /* Get difference between current and last processed time */
-    }
-    
-    /*
-     * Since we want timeout value to start from NOW,
-     * we have to add time when we last processed our timeouts
-     */
-    to->time = time + diff;
-    to->arg = arg;
-    to->fn = fn;
-    
-    /*
-     * Add new timeout to proper place on linked list
-     * and align times to have correct values between timeouts
-     */
-    if (first_timeout == NULL) {
-        first_timeout = to;                     /* Set as first element */
-        last_timeout_time = gsm_sys_now();      /* Reset last timeout time to current time */
-    } else {                                    /* Find where to place a new timeout */
-        gsm_timeout_t* t;
-        /*
-         * First check if we have to put new timeout
-         * to beginning of linked list.
-         * In this case just align new value for current first element
-         */
-        if (first_timeout->time > to->time) {
-            first_timeout->time -= time;        /* Decrease first timeout value to match difference */
-            to->next = first_timeout;           /* Set first timeout as next of new one */
-            first_timeout = to;                 /* Set new timeout as first */
-        } else {                                /* Go somewhere in between current list */
-            for (t = first_timeout; t != NULL; t = t->next) {
-                to->time -= t->time;            /* Decrease new timeout time by time in a linked list */
-                /*
-                 * Enter between 2 entries on a list in case:
-                 * 
-                 * - We reached end of linked list
-                 * - Our time is less than diff between 2 entries in list
-                 */
-                if (t->next == NULL || t->next->time > to->time) {
-                    if (t->next != NULL) {      /* Check if there is next element */
-                        t->next->time -= to->time;  /* Decrease difference time to next one */
-                    } else if (to->time > time) {
-                        to->time = time + first_timeout->time;
-                    }
-                    to->next = t->next;         /* Change order of elements */
-                    t->next = to;               /* Add new element to linked list */
-                    break;
-                }
-            }
+    uint8_t idx, wakeup;
+
+    if (fn == NULL) {
+        return gsmPARERR;
+    }
+
+    GSM_CORE_PROTECT();
+    if (!gsm.timeouts.initialized) {                /* Create free stack on first use */
+        for (idx = 0; idx < GSM_CFG_MAX_TIMEOUTS; idx++) {
+            gsm.timeouts.entries[idx].heap_idx = TIMEOUT_IDX_NONE;
+            gsm.timeouts.free[idx] = GSM_CFG_MAX_TIMEOUTS - 1 - idx;
         }
+        gsm.timeouts.free_len = GSM_CFG_MAX_TIMEOUTS;
+        gsm.timeouts.initialized = 1;
+    }
+    if (!gsm.timeouts.free_len) {
+        GSM_CORE_UNPROTECT();
+        GSM_DEBUGF(GSM_CFG_DBG_MEM | GSM_DBG_TYPE_TRACE | GSM_DBG_LVL_WARNING,
+            "[TIMEOUT] No free timeout entry, increase GSM_CFG_MAX_TIMEOUTS\r\n");
+        return gsmERRMEM;
+    }
+    idx = gsm.timeouts.free[--gsm.timeouts.free_len];
+    to = &gsm.timeouts.entries[idx];
+
+    if (++gsm.timeouts.seq > 0x00FFFFFF) {          /* Sequence number is 24-bit and never 0 */
+        gsm.timeouts.seq = 1;
+    }
+    to->seq = gsm.timeouts.seq;
+    to->time = gsm_sys_now() + time;                /* Expiry time, starting from now */
+    to->fn = fn;
+    to->arg = arg;
+    heap_set(gsm.timeouts.heap_len++, idx);
+    heap_up(to->heap_idx);
+    if (id != NULL) {
+        *id = TIMEOUT_ID(idx, to->seq);
+    }
+    wakeup = gsm.timeouts.heap[0] == idx;
+    GSM_CORE_UNPROTECT();
+
+    if (wakeup) {                                   /* Process thread must recalculate wait time */
+        GSMI_PROCESS_WAKEUP();                      /* Wakeup process thread */
     }
-    gsm_sys_mbox_putnow(&gsm.mbox_process, NULL);   /* Insert dummy value to wakeup process thread */
     return gsmOK;
 }
 
+/**
+ * \brief           Stop timeout before it expires
+ * \param[in]       id: Timeout ID returned by \ref gsm_timeout_start
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise.
+ *                  \ref gsmERR is returned when timeout already expired or was stopped
+ */
+gsmr_t
+gsm_timeout_stop(gsm_timeout_id_t id) {
+    gsmr_t res = gsmERR;
+    uint8_t idx = TIMEOUT_ID_IDX(id);
+
+    if (idx >= GSM_CFG_MAX_TIMEOUTS) {
+        return gsmPARERR;
+    }
+    GSM_CORE_PROTECT();
+    if (gsm.timeouts.initialized && gsm.timeouts.entries[idx].heap_idx != TIMEOUT_IDX_NONE
+        && gsm.timeouts.entries[idx].seq == TIMEOUT_ID_SEQ(id)) {
+        timeout_release(idx);
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();
+    return res;
+}
+
+/**
+ * \brief           Add new timeout to processing list
+ * \param[in]       time: Time in units of milliseconds for timeout execution
+ * \param[in]       fn: Callback function to call when timeout expires
+ * \param[in]       arg: Pointer to user specific argument to call when timeout callback function is executed
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_timeout_add(uint32_t time, gsm_timeout_fn fn, void* arg) {
+    return gsm_timeout_start(time, fn, arg, NULL);
+}
+
 /**
  * \brief           Remove callback from timeout list
+ * \note            First active timeout with matching callback is removed.
+ *                  Use \ref gsm_timeout_stop to remove specific timeout
  * \param[in]       fn: Callback function to identify timeout to remove
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
  */
 gsmr_t
 gsm_timeout_remove(gsm_timeout_fn fn) {
-    gsm_timeout_t *t, *t_prev;
-    
-    for (t = first_timeout, t_prev = NULL; t != NULL;
-            t_prev = t, t = t->next) {          /* Check all entries */
-        if (t->fn == fn) {                      /* Do we have a match from callback point of view? */
-            
-            /*
-             * We have to first increase
-             * difference time between current and next one
-             * to be aligned for correct wait time
-             */
-            if (t->next != NULL) {              /* Do we have next element? */
-                t->next->time += t->time;       /* Increase timeout time for next element */
-            }
-            
-            /*
-             * In case we have previous element on a list,
-             * set next element of previous to next of current one
-             * otherwise we were first element so simply set 
-             * next of current as first one
-             */
-            if (t_prev != NULL) {
-                t_prev->next = t->next;
-            } else {
-                first_timeout = t->next;
-            }
-            gsm_mem_free(t);
-            t = NULL;
-            return gsmOK;
+    gsmr_t res = gsmERR;
+    size_t i;
+
+    GSM_CORE_PROTECT();
+    for (i = 0; i < gsm.timeouts.heap_len; i++) {
+        if (gsm.timeouts.entries[gsm.timeouts.heap[i]].fn == fn) { /* Do we have a match from callback point of view? */
+            timeout_release(gsm.timeouts.heap[i]);
+            res = gsmOK;
+            break;
         }
     }
-    return gsmERR;
+    GSM_CORE_UNPROTECT();
+    return res;
 }
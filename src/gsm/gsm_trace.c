@@ -0,0 +1,221 @@
+/**
+ * \file            gsm_trace.c
+ * \brief           Binary trace ring for debug messages
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_trace.h"
+#include "stdio.h"
+
+#if (GSM_CFG_DBG && GSM_CFG_DBG_TRACE) || __DOXYGEN__
+
+#define TRACE_MASK              (GSM_CFG_DBG_TRACE_SIZE - 1)
+#define TRACE_LINE_LEN          128
+
+/*
+ * Writers reserve record with atomic increment of head index.
+ * Sequence number of record is cleared while record is written
+ * and set to `index + 1` after barrier, when record is complete.
+ * Single reader checks sequence number before and after copy
+ * and drops records overwritten in the meantime.
+ */
+static gsm_trace_rec_t trace_ring[GSM_CFG_DBG_TRACE_SIZE];
+static uint32_t trace_head;                     /*!< Index of next record to write */
+static uint32_t trace_tail;                     /*!< Index of next record to read */
+static uint32_t trace_lost;                     /*!< Number of records overwritten before read */
+
+/**
+ * \brief           Write record to trace ring
+ * \note            Function is called by \ref GSM_DEBUGF and never blocks
+ * \param[in]       type: Debug type and level flags
+ * \param[in]       fmt: Format string, must be constant
+ * \param[in]       argc: Number of arguments
+ * \param[in]       argv: Arguments converted to integers
+ */
+void
+gsm_trace_write(uint8_t type, const char* fmt, size_t argc, const uintptr_t* argv) {
+    uint32_t idx = GSM_CFG_DBG_TRACE_FETCH_ADD(&trace_head, 1);
+    gsm_trace_rec_t* r = &trace_ring[idx & TRACE_MASK];
+
+    *(volatile uint32_t *)&r->seq = 0;          /* Record is not valid while written */
+    GSM_CFG_MEMORY_BARRIER();
+    r->time = gsm_sys_now();
+    r->fmt = fmt;
+    r->type = type;
+    r->argc = GSM_U8(GSM_MIN(argc, GSM_TRACE_ARGS_MAX));
+    for (size_t i = 0; i < r->argc; i++) {
+        r->args[i] = argv[i];
+    }
+    GSM_CFG_MEMORY_BARRIER();
+    *(volatile uint32_t *)&r->seq = idx + 1;    /* Publish record to reader */
+}
+
+/**
+ * \brief           Read oldest record from trace ring
+ * \note            Only one thread may read records
+ * \param[out]      rec: Output record
+ * \return          `1` if record was read, `0` if there is no complete record
+ */
+uint8_t
+gsm_trace_read(gsm_trace_rec_t* rec) {
+    uint32_t head, seq;
+    gsm_trace_rec_t* r;
+
+    head = *(volatile uint32_t *)&trace_head;
+    if (head - trace_tail > GSM_CFG_DBG_TRACE_SIZE) {   /* Reader is behind by more than ring size */
+        trace_lost += head - trace_tail - GSM_CFG_DBG_TRACE_SIZE;
+        trace_tail = head - GSM_CFG_DBG_TRACE_SIZE;
+    }
+    for (; trace_tail != head; trace_tail++, trace_lost++) {
+        r = &trace_ring[trace_tail & TRACE_MASK];
+        seq = *(volatile uint32_t *)&r->seq;
+        if (seq != trace_tail + 1) {
+            if ((int32_t)(seq - (trace_tail + 1)) > 0) {
+                continue;                       /* Overwritten by newer record */
+            }
+            return 0;                           /* Record is still being written */
+        }
+        GSM_CFG_MEMORY_BARRIER();
+        *rec = *r;
+        GSM_CFG_MEMORY_BARRIER();
+        if (*(volatile uint32_t *)&r->seq == seq) {
+            trace_tail++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Format trace record to string
+ * \param[in]       rec: Record to format
+ * \param[out]      out: Output memory
+ * \param[in]       out_len: Length of output memory in units of bytes
+ * \return          Length of formatted string, without terminating `0`
+ */
+size_t
+gsm_trace_format(const gsm_trace_rec_t* rec, char* out, size_t out_len) {
+    char spec[16];
+    const char* f;
+    size_t o = 0, a = 0, s;
+    int stars[2], starc, n;
+    uintptr_t v;
+
+    if (rec == NULL || out == NULL || !out_len) {
+        return 0;
+    }
+    out[0] = 0;
+    for (f = rec->fmt; *f != '\0' && o < out_len - 1; f++) {
+        if (*f != '%' || f[1] == '%') {         /* Copy plain characters */
+            out[o++] = *f;
+            f += *f == '%';
+            continue;
+        }
+
+        /* Copy conversion specification without length modifiers */
+        spec[0] = '%';
+        for (s = 1, starc = 0, f++; *f != '\0' && strchr("diuxXocps", *f) == NULL; f++) {
+            if (*f == '*') {
+                stars[starc < 2 ? starc++ : 1] = (int)(a < rec->argc ? rec->args[a] : 0);
+                a++;
+            } else if (strchr("hlzjtL", *f) != NULL) {
+                continue;
+            }
+            if (s < sizeof(spec) - 3) {
+                spec[s++] = *f;
+            }
+        }
+        if (*f == '\0') {
+            break;
+        }
+        v = a < rec->argc ? rec->args[a] : 0;
+        a++;
+        if (*f == 's') {                        /* String may not exist anymore, print address */
+            GSM_MEMCPY(spec, "<%p>", 5);
+        } else {
+            spec[s++] = *f;
+            spec[s] = '\0';
+        }
+
+        /* Call formatter with argument of type matching conversion */
+        if (*f == 'p' || *f == 's') {
+            n = starc == 0 || *f == 's' ? snprintf(&out[o], out_len - o, spec, (void *)v) :
+                starc == 1 ? snprintf(&out[o], out_len - o, spec, stars[0], (void *)v) :
+                snprintf(&out[o], out_len - o, spec, stars[0], stars[1], (void *)v);
+        } else if (strchr("dic", *f) != NULL) {
+            n = starc == 0 ? snprintf(&out[o], out_len - o, spec, (int)v) :
+                starc == 1 ? snprintf(&out[o], out_len - o, spec, stars[0], (int)v) :
+                snprintf(&out[o], out_len - o, spec, stars[0], stars[1], (int)v);
+        } else {
+            n = starc == 0 ? snprintf(&out[o], out_len - o, spec, (unsigned)v) :
+                starc == 1 ? snprintf(&out[o], out_len - o, spec, stars[0], (unsigned)v) :
+                snprintf(&out[o], out_len - o, spec, stars[0], stars[1], (unsigned)v);
+        }
+        if (n > 0) {
+            o = GSM_MIN(o + (size_t)n, out_len - 1);
+        }
+    }
+    out[o] = '\0';
+    return o;
+}
+
+/**
+ * \brief           Read records from trace ring and print them with \ref GSM_CFG_DBG_OUT
+ *
+ *                  Each record is printed with its timestamp in front of formatted message.
+ *                  Call function periodically from low priority thread
+ *
+ * \param[in]       max: Maximal number of records to print, `0` to print all available
+ * \return          Number of printed records
+ */
+size_t
+gsm_trace_drain(size_t max) {
+    gsm_trace_rec_t rec;
+    char line[TRACE_LINE_LEN];
+    size_t cnt;
+
+    for (cnt = 0; (!max || cnt < max) && gsm_trace_read(&rec); cnt++) {
+        gsm_trace_format(&rec, line, sizeof(line));
+        GSM_CFG_DBG_OUT("%u %s", (unsigned)rec.time, line);
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Get number of records overwritten before they were read
+ * \return          Number of lost records
+ */
+uint32_t
+gsm_trace_get_lost(void) {
+    return trace_lost;
+}
+
+#endif /* (GSM_CFG_DBG && GSM_CFG_DBG_TRACE) || __DOXYGEN__ */
@@ -57,6 +57,80 @@ extern "C" {
 #define GSM_CFG_MQTT_MAX_REQUESTS       8
 #endif
 
+/**
+ * \brief           Timeout in units of milliseconds to wait server acknowledge for request with packet ID
+ *
+ *                  Request is failed with error event when there is no acknowledge in this time.
+ *                  Set to `0` to disable timeout
+ *
+ * \note            This is default value. To change it, override value in `gsm_config.h` configuration file
+ */
+#ifndef GSM_CFG_MQTT_REQUEST_TIMEOUT
+#define GSM_CFG_MQTT_REQUEST_TIMEOUT    0
+#endif
+
+/**
+ * \brief           Maximal delay in units of milliseconds before packets are sent to connection
+ *
+ *                  When enabled, publish packets are collected in output buffer and sent with single send,
+ *                  either after this delay or when \ref GSM_CFG_MQTT_TX_COALESCE_MAX_BYTES bytes are waiting.
+ *                  Use \ref gsm_mqtt_client_flush to send immediately.
+ *                  Set to `0` to send every packet immediately
+ *
+ * \note            This is default value. To change it, override value in `gsm_config.h` configuration file
+ */
+#ifndef GSM_CFG_MQTT_TX_COALESCE_DELAY
+#define GSM_CFG_MQTT_TX_COALESCE_DELAY  0
+#endif
+
+/**
+ * \brief           Number of bytes waiting in output buffer which force immediate send
+ *                  when \ref GSM_CFG_MQTT_TX_COALESCE_DELAY is enabled
+ *
+ * \note            This is default value. To change it, override value in `gsm_config.h` configuration file
+ */
+#ifndef GSM_CFG_MQTT_TX_COALESCE_MAX_BYTES
+#define GSM_CFG_MQTT_TX_COALESCE_MAX_BYTES  GSM_CFG_CONN_MAX_DATA_LEN
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` offline publish queue
+ *
+ *                  When enabled and queue is set with \ref gsm_mqtt_client_set_queue,
+ *                  publish packets with quality of service above `0` are stored to queue
+ *                  while client is not connected and are sent after connection is accepted again
+ *
+ * \note            This is default value. To change it, override value in `gsm_config.h` configuration file
+ */
+#ifndef GSM_CFG_MQTT_OFFLINE_QUEUE
+#define GSM_CFG_MQTT_OFFLINE_QUEUE      0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` MQTT 5.0 protocol support
+ *
+ *                  When enabled, protocol version is selected with `protocol_version`
+ *                  member of \ref gsm_mqtt_client_info_t
+ *
+ * \note            This is default value. To change it, override value in `gsm_config.h` configuration file
+ */
+#ifndef GSM_CFG_MQTT_V5
+#define GSM_CFG_MQTT_V5                 0
+#endif
+
+/**
+ * \brief           Maximal number of topic aliases used by client for publish with MQTT 5.0
+ *
+ *                  Topics are assigned to aliases on publish, least recently used alias is reassigned.
+ *                  Number of used aliases is limited by `Topic Alias Maximum` received from server.
+ *                  Set to `0` to disable topic aliases
+ *
+ * \note            This is default value. To change it, override value in `gsm_config.h` configuration file
+ */
+#ifndef GSM_CFG_MQTT_TOPIC_ALIAS_MAX
+#define GSM_CFG_MQTT_TOPIC_ALIAS_MAX    4
+#endif
+
 /**
  * \brief           Quality of service enumeration
  */
@@ -99,12 +173,66 @@ typedef struct {
     const char* will_topic;                     /*!< Will topic */
     const char* will_message;                   /*!< Will message */
     gsm_mqtt_qos_t will_qos;                    /*!< Will topic quality of service */
+#if GSM_CFG_MQTT_V5 || __DOXYGEN__
+    uint8_t protocol_version;                   /*!< Protocol version, set to `5` for MQTT 5.0.
+                                                    Any other value selects MQTT 3.1.1 */
+#endif /* GSM_CFG_MQTT_V5 || __DOXYGEN__ */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+    uint8_t use_ssl;                            /*!< Set to `1` to connect with TLS handled by device */
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
 } gsm_mqtt_client_info_t;
 
+#if GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+
 /**
- * \brief           MQTT request object
+ * \brief           Offline queue storage write function
+ * \param[in]       arg: User argument from \ref gsm_mqtt_client_queue_t
+ * \param[in]       addr: Byte offset in storage to write to
+ * \param[in]       data: Data to write
+ * \param[in]       len: Number of bytes to write
+ * \return          `1` on success, `0` otherwise
+ */
+typedef uint8_t     (*gsm_mqtt_client_queue_write_fn)(void* arg, size_t addr, const void* data, size_t len);
+
+/**
+ * \brief           Offline queue storage read function
+ * \param[in]       arg: User argument from \ref gsm_mqtt_client_queue_t
+ * \param[in]       addr: Byte offset in storage to read from
+ * \param[out]      data: Memory to read data to
+ * \param[in]       len: Number of bytes to read
+ * \return          `1` on success, `0` otherwise
+ */
+typedef uint8_t     (*gsm_mqtt_client_queue_read_fn)(void* arg, size_t addr, void* data, size_t len);
+
+/**
+ * \brief           Offline publish queue, ring buffer in RAM or in user storage
+ *
+ * Structure is owned by user and must stay valid while set to client.
+ * Ring positions are part of structure and can be saved by user
+ * together with storage content to keep queue over device reset
  */
 typedef struct {
+    uint8_t* mem;                               /*!< RAM ring memory. Used when `write_fn` is set to `NULL` */
+    gsm_mqtt_client_queue_write_fn write_fn;    /*!< Storage write function, set to `NULL` to use RAM memory */
+    gsm_mqtt_client_queue_read_fn read_fn;      /*!< Storage read function, used with `write_fn` */
+    void* arg;                                  /*!< User argument for storage functions */
+    size_t size;                                /*!< Size of ring in units of bytes */
+
+    size_t r;                                   /*!< Ring position of oldest entry not yet acknowledged by server */
+    size_t w;                                   /*!< Ring position for new entry */
+    size_t used;                                /*!< Number of used bytes in ring */
+} gsm_mqtt_client_queue_t;
+
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
+/**
+ * \brief           MQTT request object
+ */
+typedef struct gsm_mqtt_request {
+    struct gsm_mqtt_request* next;              /*!< Next request in free list or in packet ID hash chain */
+    struct gsm_mqtt_request* list_prev;         /*!< Previous pending request in order of creation */
+    struct gsm_mqtt_request* list_next;         /*!< Next pending request in order of creation */
+
     uint8_t status;                             /*!< Entry status flag for in use or pending bit */
     uint16_t packet_id;                         /*!< Packet ID generated by client on publish */
     
@@ -113,6 +241,9 @@ typedef struct {
                                                     on connection before we can say "packet was sent". */
     
     uint32_t timeout_start_time;                /*!< Timeout start time in units of milliseconds */
+#if GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+    size_t queue_len;                           /*!< Size of offline queue entry sent with this request */
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
 } gsm_mqtt_request_t;
 
 /**
@@ -169,8 +300,15 @@ typedef struct {
             size_t topic_len;                   /*!< Length of topic */
             const void* payload;                /*!< Topic payload */
             size_t payload_len;                 /*!< Length of topic payload */
+            size_t payload_offset;              /*!< Offset of this payload part in entire payload */
+            size_t payload_total;               /*!< Length of entire payload. When larger than `payload_len`,
+                                                    payload is delivered in multiple events */
+            gsm_pbuf_p pbuf;                    /*!< Packet buffer holding topic and payload memory,
+                                                    `NULL` when data are copied to MQTT RX buffer */
             uint8_t dup;                        /*!< Duplicate flag if message was sent again */
             gsm_mqtt_qos_t qos;                 /*!< Received packet quality of service */
+            gsmr_t res;                         /*!< Receive status. \ref gsmERRMEM when packet did not fit to RX buffer
+                                                    and was ignored; topic and payload are not available */
         } publish_recv;                         /*!< Publish received event */
     } evt;                                      /*!< Event data parameters */
 } gsm_mqtt_evt_t;
@@ -188,12 +326,17 @@ void                gsm_mqtt_client_delete(gsm_mqtt_client_p client);
 gsmr_t              gsm_mqtt_client_connect(gsm_mqtt_client_p client, const char* host, gsm_port_t port, gsm_mqtt_evt_fn evt_fn, const gsm_mqtt_client_info_t* info);
 gsmr_t              gsm_mqtt_client_disconnect(gsm_mqtt_client_p client);
 uint8_t             gsm_mqtt_client_is_connected(gsm_mqtt_client_p client);
+gsmr_t              gsm_mqtt_client_flush(gsm_mqtt_client_p client);
 
 gsmr_t              gsm_mqtt_client_subscribe(gsm_mqtt_client_p client, const char* topic, gsm_mqtt_qos_t qos, void* arg);
 gsmr_t              gsm_mqtt_client_unsubscribe(gsm_mqtt_client_p client, const char* topic, void* arg);
 
 gsmr_t              gsm_mqtt_client_publish(gsm_mqtt_client_p client, const char* topic, const void* payload, uint16_t len, gsm_mqtt_qos_t qos, uint8_t retain, void* arg);
 
+#if GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__
+gsmr_t              gsm_mqtt_client_set_queue(gsm_mqtt_client_p client, gsm_mqtt_client_queue_t* queue);
+#endif /* GSM_CFG_MQTT_OFFLINE_QUEUE || __DOXYGEN__ */
+
 void*               gsm_mqtt_client_get_arg(gsm_mqtt_client_p client);
 void                gsm_mqtt_client_set_arg(gsm_mqtt_client_p client, void* arg);
     
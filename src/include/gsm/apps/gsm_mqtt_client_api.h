@@ -62,8 +62,20 @@ typedef struct gsm_mqtt_client_api_buf {
     const uint8_t* payload;                     /*!< Payload data */
     size_t payload_len;                         /*!< Payload length */
     gsm_mqtt_qos_t qos;                         /*!< Quality of service */
+    gsm_pbuf_p pbuf;                            /*!< Packet buffer referenced by payload, `NULL` when payload is copied.
+                                                    Used with \ref GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY */
+    void* pool;                                 /*!< Internal: buffer pool class, `NULL` when allocated from heap */
+    struct gsm_mqtt_client_api_buf* next;       /*!< Internal: next free buffer in pool class */
 } gsm_mqtt_client_api_buf_t;
 
+/**
+ * \brief           Receive buffer pool size class, used with \ref gsm_mqtt_client_api_new_ex
+ */
+typedef struct {
+    size_t size;                                /*!< Maximal sum of topic and payload length of buffer in class */
+    size_t count;                               /*!< Number of preallocated buffers in class */
+} gsm_mqtt_client_api_pool_cfg_t;
+
 /**
  * \brief           Pointer to \ref gsm_mqtt_client_api_t structure
  */
@@ -74,13 +86,30 @@ typedef struct gsm_mqtt_client_api* gsm_mqtt_client_api_p;
  */
 typedef struct gsm_mqtt_client_api_buf* gsm_mqtt_client_api_buf_p;
 
+/**
+ * \brief           Subscription callback function, called for every received publish matching subscription topic filter
+ *
+ * \note            Function is called from GSM stack thread with core locked.
+ *                  It must not call blocking MQTT API functions.
+ *                  Buffer is valid only for the time of callback and must not be freed by user
+ *
+ * \param[in]       client: MQTT API client handle
+ * \param[in]       buf: Received publish buffer
+ * \param[in]       arg: User argument passed at subscription
+ */
+typedef void (*gsm_mqtt_client_api_sub_fn)(gsm_mqtt_client_api_p client, gsm_mqtt_client_api_buf_p buf, void* arg);
+
 gsm_mqtt_client_api_p   gsm_mqtt_client_api_new(size_t tx_buff_len, size_t rx_buff_len);
+gsm_mqtt_client_api_p   gsm_mqtt_client_api_new_ex(size_t tx_buff_len, size_t rx_buff_len, const gsm_mqtt_client_api_pool_cfg_t* pool, size_t pool_len);
 void                    gsm_mqtt_client_api_delete(gsm_mqtt_client_api_p client);
 gsm_mqtt_conn_status_t  gsm_mqtt_client_api_connect(gsm_mqtt_client_api_p client, const char* host, gsm_port_t port, const gsm_mqtt_client_info_t* info);
 gsmr_t                  gsm_mqtt_client_api_close(gsm_mqtt_client_api_p client);
 gsmr_t                  gsm_mqtt_client_api_subscribe(gsm_mqtt_client_api_p client, const char* topic, gsm_mqtt_qos_t qos);
+gsmr_t                  gsm_mqtt_client_api_subscribe_cb(gsm_mqtt_client_api_p client, const char* topic, gsm_mqtt_qos_t qos, gsm_mqtt_client_api_sub_fn fn, void* arg);
 gsmr_t                  gsm_mqtt_client_api_unsubscribe(gsm_mqtt_client_api_p client, const char* topic);
 gsmr_t                  gsm_mqtt_client_api_publish(gsm_mqtt_client_api_p client, const char* topic, const void* data, size_t btw, gsm_mqtt_qos_t qos, uint8_t retain);
+gsmr_t                  gsm_mqtt_client_api_publish_async(gsm_mqtt_client_api_p client, const char* topic, const void* data, size_t btw, gsm_mqtt_qos_t qos, uint8_t retain, void* arg);
+gsmr_t                  gsm_mqtt_client_api_publish_get_result(gsm_mqtt_client_api_p client, void** arg, gsmr_t* res, uint32_t timeout);
 gsmr_t                  gsm_mqtt_client_api_receive(gsm_mqtt_client_api_p client, gsm_mqtt_client_api_buf_p* p, uint32_t timeout);
 void                    gsm_mqtt_client_api_buf_free(gsm_mqtt_client_api_buf_p p);
     
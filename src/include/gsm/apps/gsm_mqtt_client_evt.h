@@ -189,6 +189,42 @@ extern "C" {
  */
 #define gsm_mqtt_client_evt_publish_recv_get_payload_len(client, evt)   (GSM_SZ((evt)->evt.publish_recv.payload_len))
 
+/**
+ * \brief           Get offset of payload part in entire payload
+ *
+ *                  Payloads larger than RX buffer are delivered in multiple events,
+ *                  each with part of payload. Topic is valid in every event
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Payload offset
+ * \hideinitializer
+ */
+#define gsm_mqtt_client_evt_publish_recv_get_payload_offset(client, evt)    (GSM_SZ((evt)->evt.publish_recv.payload_offset))
+
+/**
+ * \brief           Get length of entire payload of received publish packet
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Entire payload length
+ * \hideinitializer
+ */
+#define gsm_mqtt_client_evt_publish_recv_get_payload_total(client, evt) (GSM_SZ((evt)->evt.publish_recv.payload_total))
+
+/**
+ * \brief           Get packet buffer which holds topic and payload memory of received publish packet
+ *
+ *                  When entire packet is received in single linear packet buffer part,
+ *                  topic and payload point directly to its memory.
+ *                  Use \ref gsm_pbuf_ref to keep data valid after event callback returns
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          Packet buffer handle or `NULL` if data are in MQTT RX buffer
+ * \hideinitializer
+ */
+#define gsm_mqtt_client_evt_publish_recv_get_pbuf(client, evt)      ((gsm_pbuf_p)(evt)->evt.publish_recv.pbuf)
+
 /**
  * \brief           Check if packet is duplicated
  * \param[in]       client: MQTT client
@@ -207,6 +243,19 @@ extern "C" {
  */
 #define gsm_mqtt_client_evt_publish_recv_get_qos(client, evt)       ((evt)->evt.publish_recv.qos)
 
+/**
+ * \brief           Get receive result of publish packet
+ *
+ *                  Packet which does not fit to RX buffer is acknowledged to server and ignored.
+ *                  Event is then reported with \ref gsmERRMEM result, without topic and payload
+ *
+ * \param[in]       client: MQTT client
+ * \param[in]       evt: Event handle
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ * \hideinitializer
+ */
+#define gsm_mqtt_client_evt_publish_recv_get_result(client, evt)    ((gsmr_t)(evt)->evt.publish_recv.res)
+
 /**
  * \}
  */
@@ -47,6 +47,10 @@ extern "C" {
  */
 
 gsmr_t      gsm_init(gsm_evt_fn evt_func, uint32_t blocking);
+#if GSM_CFG_WARM_START || __DOXYGEN__
+gsmr_t      gsm_init_warm(gsm_evt_fn evt_func, const gsm_warm_state_t* state, uint32_t blocking);
+gsmr_t      gsm_warm_state_get(gsm_warm_state_t* state);
+#endif /* GSM_CFG_WARM_START || __DOXYGEN__ */
 gsmr_t      gsm_reset(uint32_t blocking);
 gsmr_t      gsm_reset_with_delay(uint32_t delay, uint32_t blocking);
 gsmr_t      gsm_set_at_baudrate(uint32_t baud, uint32_t blocking);
@@ -57,13 +61,37 @@ gsmr_t      gsm_core_lock(void);
 gsmr_t      gsm_core_unlock(void);
 
 gsmr_t      gsm_evt_register(gsm_evt_fn fn);
+gsmr_t      gsm_evt_register_mask(gsm_evt_fn fn, gsm_evt_mask_t mask);
 gsmr_t      gsm_evt_unregister(gsm_evt_fn fn);
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+gsmr_t      gsm_evt_set_deferred(gsm_evt_type_t type, uint8_t deferred);
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
+
+gsmr_t      gsm_get_msg_lane_stats(gsm_msg_prio_t prio, gsm_msg_lane_stats_t* stats);
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+gsmr_t      gsm_get_cmd_stats(size_t index, gsm_cmd_stats_t* stats);
+gsmr_t      gsm_reset_cmd_stats(void);
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
+#if GSM_SYS_RUNTIME_STATS || __DOXYGEN__
+gsmr_t      gsm_get_runtime_stats(gsm_runtime_stats_t* stats);
+#endif /* GSM_SYS_RUNTIME_STATS || __DOXYGEN__ */
 
 gsmr_t      gsm_device_set_present(uint8_t present, uint32_t blocking);
 uint8_t     gsm_device_is_present(void);
 
 void        gsm_delay(uint32_t ms);
 
+#if GSM_CFG_CMD_EVT || __DOXYGEN__
+gsmr_t      gsm_set_cmd_evt(gsm_api_cmd_evt_fn fn, void* arg);
+#endif /* GSM_CFG_CMD_EVT || __DOXYGEN__ */
+
+#if GSM_CFG_MAX_INSTANCES > 1 || __DOXYGEN__
+gsm_instance_p  gsm_instance_get(size_t index);
+gsm_instance_p  gsm_instance_select(gsm_instance_p inst);
+gsm_instance_p  gsm_instance_current(void);
+size_t          gsm_instance_get_index(gsm_instance_p inst);
+#endif /* GSM_CFG_MAX_INSTANCES > 1 || __DOXYGEN__ */
+
 /**
  * \}
  */
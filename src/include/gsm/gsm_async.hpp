@@ -0,0 +1,228 @@
+/**
+ * \file            gsm_async.hpp
+ * \brief           C++20 coroutine wrapper for GSM commands
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_ASYNC_HPP
+#define __GSM_ASYNC_HPP
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include "gsm/gsm.h"
+
+#if !GSM_CFG_CMD_EVT
+#error GSM_CFG_CMD_EVT must be enabled to use gsm_async.hpp
+#endif /* !GSM_CFG_CMD_EVT */
+
+/**
+ * \ingroup         GSM
+ * \defgroup        GSM_ASYNC C++ coroutine wrapper
+ * \brief           Await GSM commands from C++20 coroutines
+ *
+ * Any API function is started in non-blocking mode and its result
+ * is delivered through completion callback set with \ref gsm_set_cmd_evt.
+ * Suspended coroutines are resumed by \ref gsm::executor,
+ * so thousands of operations can share single application thread.
+ *
+ * \code{cpp}
+gsm::executor exec;
+
+gsm::task
+send_sms(gsm::executor& e) {
+    gsmr_t res = co_await gsm::async(e, [] {
+        return gsm_sms_send("+000000000", "Hello", 0);
+    });
+}
+
+send_sms(exec);
+exec.run();
+\endcode
+ * \{
+ */
+
+namespace gsm {
+
+/**
+ * \brief           Queue of coroutines ready to be resumed
+ *
+ *                  Completion callbacks only post handles here,
+ *                  coroutines always continue in thread which calls \ref run or \ref run_one
+ */
+class executor {
+public:
+    /**
+     * \brief           Put coroutine to ready queue
+     * \note            Safe to call from any thread, including GSM producer thread
+     * \param[in]       h: Coroutine handle to resume
+     */
+    void
+    post(std::coroutine_handle<> h) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            ready_.push_back(h);
+        }
+        cv_.notify_one();
+    }
+
+    /**
+     * \brief           Resume one ready coroutine, wait for it if none is ready
+     * \return          `false` if \ref stop was called, `true` otherwise
+     */
+    bool
+    run_one() {
+        std::coroutine_handle<> h;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [this] { return stopped_ || !ready_.empty(); });
+            if (ready_.empty()) {
+                return false;
+            }
+            h = ready_.front();
+            ready_.pop_front();
+        }
+        h.resume();
+        return true;
+    }
+
+    /**
+     * \brief           Resume ready coroutines until \ref stop is called
+     */
+    void
+    run() {
+        while (run_one()) {}
+    }
+
+    /**
+     * \brief           Stop \ref run once ready queue is empty
+     */
+    void
+    stop() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> ready_;
+    bool stopped_ = false;
+};
+
+/**
+ * \brief           Awaitable GSM command
+ *
+ *                  Start function must call single GSM API function with `blocking` set to `0`
+ *                  and return its result. Result of `co_await` is final command result
+ *
+ * \tparam          F: Callable type returning \ref gsmr_t
+ */
+template<typename F>
+class cmd_awaitable {
+public:
+    cmd_awaitable(executor& e, F start) : exec_(e), start_(std::move(start)) {}
+
+    bool
+    await_ready() const noexcept {
+        return false;
+    }
+
+    bool
+    await_suspend(std::coroutine_handle<> h) {
+        handle_ = h;
+        gsm_set_cmd_evt(&cmd_awaitable::on_done, this);
+        gsmr_t r = start_();                    /* Callback may already write result before return */
+        if (r != gsmOK) {
+            gsm_set_cmd_evt(NULL, NULL);        /* Command was not queued, callback may be pending */
+            res_ = r;
+            return false;                       /* Continue immediately with error */
+        }
+        return true;                            /* Object must not be touched anymore, callback may already run */
+    }
+
+    gsmr_t
+    await_resume() const noexcept {
+        return res_;
+    }
+
+private:
+    static void
+    on_done(gsmr_t res, void* arg) {
+        cmd_awaitable* self = static_cast<cmd_awaitable*>(arg);
+        self->res_ = res;
+        self->exec_.post(self->handle_);
+    }
+
+    executor& exec_;
+    F start_;
+    std::coroutine_handle<> handle_;
+    gsmr_t res_ = gsmOK;
+};
+
+/**
+ * \brief           Create awaitable for GSM command
+ * \param[in]       e: Executor to resume coroutine on
+ * \param[in]       start: Callable which starts command in non-blocking mode
+ * \return          Awaitable object to use with `co_await`
+ */
+template<typename F>
+cmd_awaitable<F>
+async(executor& e, F start) {
+    return cmd_awaitable<F>(e, std::move(start));
+}
+
+/**
+ * \brief           Fire-and-forget coroutine type
+ *
+ *                  Coroutine starts immediately and frees itself when finished
+ */
+struct task {
+    struct promise_type {
+        task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+} /* namespace gsm */
+
+/**
+ * \}
+ */
+
+#endif /* __GSM_ASYNC_HPP */
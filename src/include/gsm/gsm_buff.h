@@ -58,6 +58,22 @@ size_t      gsm_buff_peek(gsm_buff_t* buff, size_t skip_count, void* data, size_
 void *      gsm_buff_get_linear_block_address(gsm_buff_t* buff);
 size_t      gsm_buff_get_linear_block_length(gsm_buff_t* buff);
 size_t      gsm_buff_skip(gsm_buff_t* buff, size_t len);
+void *      gsm_buff_get_linear_block_write_address(gsm_buff_t* buff);
+size_t      gsm_buff_get_linear_block_write_length(gsm_buff_t* buff);
+size_t      gsm_buff_advance(gsm_buff_t* buff, size_t len);
+size_t      gsm_buff_get_read_views(gsm_buff_t* buff, gsm_iovec_t* views);
+
+#if GSM_CFG_BUFF_POW2 || __DOXYGEN__
+uint8_t     gsm_buff_init_pow2(gsm_buff_t* buff, size_t len);
+size_t      gsm_buff_write_pow2(gsm_buff_t* buff, const void* data, size_t count);
+size_t      gsm_buff_get_free_pow2(gsm_buff_t* buff);
+size_t      gsm_buff_get_full_pow2(gsm_buff_t* buff);
+size_t      gsm_buff_skip_pow2(gsm_buff_t* buff, size_t len);
+void *      gsm_buff_get_linear_block_write_address_pow2(gsm_buff_t* buff);
+size_t      gsm_buff_get_linear_block_write_length_pow2(gsm_buff_t* buff);
+size_t      gsm_buff_advance_pow2(gsm_buff_t* buff, size_t len);
+size_t      gsm_buff_get_read_views_pow2(gsm_buff_t* buff, gsm_iovec_t* views);
+#endif /* GSM_CFG_BUFF_POW2 || __DOXYGEN__ */
 
 /**
  * \}
@@ -0,0 +1,79 @@
+/**	
+ * \file            gsm_capture.h
+ * \brief           AT port traffic capture
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_CAPTURE_H
+#define __GSM_CAPTURE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM
+ * \defgroup        GSM_CAPTURE AT port capture
+ * \brief           Capture of raw AT port traffic for later replay
+ *
+ * Capture stream starts with \ref GSM_CAPTURE_MAGIC, followed by records.
+ * Each record has \ref GSM_CAPTURE_HDR_LEN bytes long header, followed by data:
+ *
+ *  - `4` bytes: time since capture start in units of milliseconds, little endian
+ *  - `1` byte: direction, `T` for data sent to device, `R` for data received from device
+ *  - `4` bytes: length of data in units of bytes, little endian
+ *
+ * Use \ref gsm_capture_hdr_encode and \ref gsm_capture_hdr_decode to build and parse headers.
+ *
+ * \{
+ */
+
+#define GSM_CAPTURE_MAGIC                   "GSMCAP1\n" /*!< Capture stream start */
+#define GSM_CAPTURE_MAGIC_LEN               8           /*!< Length of capture stream start */
+#define GSM_CAPTURE_HDR_LEN                 9           /*!< Length of record header */
+
+gsmr_t      gsm_capture_start(gsm_capture_fn fn, void* arg);
+gsmr_t      gsm_capture_stop(void);
+
+size_t      gsm_capture_hdr_encode(uint8_t* hdr, gsm_capture_dir_t dir, uint32_t time, size_t len);
+uint8_t     gsm_capture_hdr_decode(const uint8_t* hdr, gsm_capture_dir_t* dir, uint32_t* time, size_t* len);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSM_CAPTURE_H */
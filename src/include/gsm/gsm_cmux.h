@@ -0,0 +1,66 @@
+/**	
+ * \file            gsm_cmux.h
+ * \brief           GSM 07.10 multiplexer
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_CMUX_H
+#define __GSM_CMUX_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM
+ * \defgroup        GSM_CMUX Multiplexer
+ * \brief           GSM 07.10 multiplexer with virtual channels on single serial port
+ * \{
+ */
+
+gsmr_t      gsm_cmux_start(const uint32_t blocking);
+gsmr_t      gsm_cmux_stop(const uint32_t blocking);
+gsmr_t      gsm_cmux_channel_open(uint8_t dlci, gsm_cmux_recv_fn fn, void* const arg, const uint32_t blocking);
+gsmr_t      gsm_cmux_channel_close(uint8_t dlci, const uint32_t blocking);
+gsmr_t      gsm_cmux_channel_write(uint8_t dlci, const void* data, size_t len);
+uint8_t     gsm_cmux_is_active(void);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSM_CMUX_H */
@@ -79,6 +79,65 @@
 #define GSM_CFG_MEM_ALIGNMENT               4
 #endif
 
+/**
+ * \brief           Allocator used for dynamic memory allocations
+ *
+ *                  Parameter can be a value of \ref GSM_MEM_ALLOCATORS choices
+ *
+ * \note            \ref GSM_MEM_ALLOCATOR_TLSF allocates and frees memory in constant time,
+ *                  regardless of heap fragmentation. It uses some more RAM for size class lists
+ *                  and limits single region to `16 MB`
+ */
+#ifndef GSM_CFG_MEM_ALLOCATOR
+#define GSM_CFG_MEM_ALLOCATOR               GSM_MEM_ALLOCATOR_FIRST_FIT
+#endif
+
+/**
+ * \defgroup        GSM_CONF_MEM_POOL Memory pools
+ * \brief           Fixed size object pools
+ * \{
+ *
+ * Pools are statically allocated and used before heap memory.
+ * When pool is empty or requested size is too big, memory is allocated from heap.
+ * Pointers from pools are freed with \ref gsm_mem_free as any other memory.
+ *
+ * Set pool size to `0` to disable the pool
+ */
+
+/**
+ * \brief           Number of message objects in pool, used for every API command
+ */
+#ifndef GSM_CFG_MSG_POOL_SIZE
+#define GSM_CFG_MSG_POOL_SIZE               0
+#endif
+
+/**
+ * \brief           Number of packet buffers in pool
+ * \note            Each entry holds packet buffer structure and \ref GSM_CFG_PBUF_POOL_BUFF_SIZE bytes of payload
+ */
+#ifndef GSM_CFG_PBUF_POOL_SIZE
+#define GSM_CFG_PBUF_POOL_SIZE              0
+#endif
+
+/**
+ * \brief           Maximal payload size of packet buffer allocated from pool
+ */
+#ifndef GSM_CFG_PBUF_POOL_BUFF_SIZE
+#define GSM_CFG_PBUF_POOL_BUFF_SIZE         GSM_CFG_IPD_MAX_BUFF_SIZE
+#endif
+
+/**
+ * \brief           Number of connection write buffers in pool
+ * \note            Each entry is \ref GSM_CFG_CONN_MAX_DATA_LEN bytes long
+ */
+#ifndef GSM_CFG_TX_CHUNK_POOL_SIZE
+#define GSM_CFG_TX_CHUNK_POOL_SIZE          0
+#endif
+
+/**
+ * \}
+ */
+
 /**
  * \brief           Maximal number of connections AT software can support on GSM device
  *
@@ -87,6 +146,20 @@
 #define GSM_CFG_MAX_CONNS                   6
 #endif
 
+/**
+ * \brief           Maximal number of timeouts active at the same time
+ *
+ *                  Timeout entries are statically allocated.
+ *                  Default value reserves one entry per connection, entries for internal modules
+ *                  and `3` entries per MQTT client (keep-alive, request timeout and delayed send),
+ *                  see \ref GSM_CFG_MQTT_MAX_CLIENTS
+ *
+ * \note            Value can not exceed `254`
+ */
+#ifndef GSM_CFG_MAX_TIMEOUTS
+#define GSM_CFG_MAX_TIMEOUTS                (GSM_CFG_MAX_CONNS + 4 + 3 * GSM_CFG_MQTT_MAX_CLIENTS)
+#endif
+
 /**
  * \brief           Maximal number of bytes we can send at single command to GSM
  * \note            Value can not exceed `2048` bytes or no data will be ever send
@@ -109,6 +182,72 @@
 #define GSM_CFG_MAX_SEND_RETRIES            3
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` quick send mode for connections
+ *
+ *                  When enabled, `AT+CIPQSEND=1` is set during network attach.
+ *                  When disabled, command is not sent and device stays in default `SEND OK` mode.
+ *                  Device reports `DATA ACCEPT` as soon as data are copied to its internal
+ *                  buffer and next packet is sent immediately,
+ *                  without waiting remote side to acknowledge previous one with `SEND OK`.
+ *
+ * \note            Device internal buffer is used as send window.
+ *                  Data sent event only means data were accepted by device
+ */
+#ifndef GSM_CFG_CONN_QUICK_SEND
+#define GSM_CFG_CONN_QUICK_SEND             0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` remote address report for received data
+ *
+ *                  When enabled, `AT+CIPSRIP=1` is set during network attach.
+ *                  Device reports IP address and port of remote side for each received packet,
+ *                  which are then available in packet buffer with \ref gsm_pbuf_ip.
+ *                  This is mostly useful for UDP connections receiving from multiple peers
+ *
+ * \note            When disabled, packet buffer holds remote address of connection
+ */
+#ifndef GSM_CFG_CONN_RECV_FROM
+#define GSM_CFG_CONN_RECV_FROM              0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` support for transparent data mode
+ *
+ *                  When enabled and requested with \ref gsm_conn_set_transparent,
+ *                  `AT+CIPMUX=0` and `AT+CIPMODE=1` are set during network attach.
+ *                  Only one connection may be active and after it is connected,
+ *                  data are exchanged with device without `+CIPSEND` and `+RECEIVE` framing.
+ *
+ * \note            Device accepts application mode change only in `IP INITIAL` state,
+ *                  mode is therefore applied on next \ref gsm_network_attach call
+ */
+#ifndef GSM_CFG_CONN_TRANSPARENT
+#define GSM_CFG_CONN_TRANSPARENT            0
+#endif
+
+/**
+ * \brief           Guard time in units of milliseconds around `+++` escape sequence
+ *
+ *                  Device returns to command mode only if there was no data on UART
+ *                  for at least guard time before and after escape sequence
+ */
+#ifndef GSM_CFG_CONN_TRANSPARENT_GUARD_TIME
+#define GSM_CFG_CONN_TRANSPARENT_GUARD_TIME 1000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` TLS connections handled by device
+ *
+ *                  Connections of type \ref GSM_CONN_TYPE_SSL are started with `AT+CIPSSL=1`
+ *                  and all encryption is done by device TLS stack.
+ *                  Certificate is stored to device file system and selected with \ref gsm_conn_ssl_set_cert
+ */
+#ifndef GSM_CFG_CONN_SSL
+#define GSM_CFG_CONN_SSL                    0
+#endif
+
 /**
  * \brief           Maximal data buffer for Input Data Packet, used on TCP/IP commands
  *
@@ -119,6 +258,56 @@
 #define GSM_CFG_IPD_MAX_BUFF_SIZE           1460
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` manual receive mode for connections
+ *
+ * When enabled, device is configured with `AT+CIPRXGET=1` and keeps received data in its own buffer.
+ * Stack reads data with `AT+CIPRXGET=2` only when application confirmed
+ * previous data with \ref gsm_conn_recved, giving end-to-end backpressure.
+ *
+ * \note            Application using raw connection API must call \ref gsm_conn_recved
+ *                  for every received packet buffer, otherwise reception stops.
+ *                  Netconn and MQTT client do this internally
+ *
+ * \note            Mode is not used when connection is in transparent mode
+ */
+#ifndef GSM_CFG_CONN_MANUAL_TCP_RECEIVE
+#define GSM_CFG_CONN_MANUAL_TCP_RECEIVE     0
+#endif
+
+/**
+ * \brief           Maximal number of bytes delivered to application and not yet confirmed with \ref gsm_conn_recved
+ *
+ * Each read from device is limited to remaining window and \ref GSM_CFG_IPD_MAX_BUFF_SIZE
+ */
+#ifndef GSM_CFG_CONN_MANUAL_TCP_RECEIVE_WINDOW
+#define GSM_CFG_CONN_MANUAL_TCP_RECEIVE_WINDOW  (2 * GSM_CFG_IPD_MAX_BUFF_SIZE)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` zero-copy receive of connection data
+ *
+ *                  When enabled, received network data are not copied to new packet buffer.
+ *                  Packet buffer payload points directly to receive buffer memory instead.
+ *                  Data are split to multiple packet buffers when wrapped in receive buffer.
+ *
+ * \note            If application keeps packet buffer after \ref GSM_EVT_CONN_DATA_RECV event
+ *                  (with \ref gsm_pbuf_ref), its payload is copied to heap memory
+ *                  once callback returns and payload pointer changes.
+ *                  Only when there is no memory for copy, processing of received data is paused
+ *                  until packet buffer is freed.
+ *
+ * \note            Netconn and deferred events copy payload before packet buffer is passed to other thread,
+ *                  application callback must not pass packet buffer to other thread itself.
+ *                  When there is no memory for copy, netconn drops received data and deferred event
+ *                  is delivered directly instead, so receive buffer is never held by other thread
+ *
+ * \note            This mode requires \ref GSM_CFG_INPUT_USE_PROCESS to be disabled
+ */
+#ifndef GSM_CFG_IPD_ZERO_COPY
+#define GSM_CFG_IPD_ZERO_COPY               0
+#endif
+
 /**
  * \brief           Default baudrate used for AT port
  *
@@ -128,6 +317,40 @@
 #define GSM_CFG_AT_PORT_BAUDRATE            115200
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` automatic AT port baudrate escalation on reset
+ *
+ * When enabled, reset sequence tries baudrates from \ref GSM_CFG_AT_PORT_BAUDRATE_LIST
+ * after basic device setup. Each candidate is set with `AT+IPR`, host port is reconfigured
+ * with \ref gsm_ll_init and link is verified with sync `AT` command.
+ * On failure, previous baudrate is restored and next candidate is tried.
+ *
+ * Final baudrate is reported with \ref GSM_EVT_AT_BAUDRATE event
+ *
+ * \note            Low-level driver must support baudrate change on subsequent \ref gsm_ll_init calls
+ */
+#ifndef GSM_CFG_AT_PORT_BAUDRATE_AUTO
+#define GSM_CFG_AT_PORT_BAUDRATE_AUTO       0
+#endif
+
+/**
+ * \brief           Comma separated list of baudrates to try when \ref GSM_CFG_AT_PORT_BAUDRATE_AUTO is enabled
+ *
+ * List must be ordered from highest to lowest baudrate.
+ * First candidate which passes sync check is used,
+ * candidates lower or equal to current baudrate are skipped
+ */
+#ifndef GSM_CFG_AT_PORT_BAUDRATE_LIST
+#define GSM_CFG_AT_PORT_BAUDRATE_LIST       921600, 460800, 230400
+#endif
+
+/**
+ * \brief           Time in units of milliseconds to wait for response on sync `AT` command after baudrate change
+ */
+#ifndef GSM_CFG_AT_PORT_BAUDRATE_SYNC_TIMEOUT
+#define GSM_CFG_AT_PORT_BAUDRATE_SYNC_TIMEOUT   500
+#endif
+
 /**
  * \brief           Buffer size for received data waiting to be processed
  * \note            When server mode is active and a lot of connections are in queue
@@ -143,6 +366,113 @@
 #define GSM_CFG_RCV_BUFF_SIZE               0x400
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` power-of-two mode of input ring buffer
+ *
+ * Buffer pointers run freely and are masked with buffer size on memory access,
+ * which removes wrap-around checks and lets buffer use its entire memory.
+ *
+ * \note            Only input buffer uses this mode and \ref GSM_CFG_RCV_BUFF_SIZE must be power of two.
+ *                  Other ring buffers keep their size and default mode
+ */
+#ifndef GSM_CFG_BUFF_POW2
+#define GSM_CFG_BUFF_POW2                   0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` hardware flow control hooks on AT port
+ *
+ * When enabled, stack calls \ref gsm_ll_t.rx_flow_fn to pause reception
+ * once input buffer reaches \ref GSM_CFG_AT_PORT_FLOW_HIGH_WATERMARK
+ * and to resume it when processing drains buffer to \ref GSM_CFG_AT_PORT_FLOW_LOW_WATERMARK.
+ * Before data are sent, \ref gsm_ll_t.tx_ready_fn is polled
+ * for maximum of \ref GSM_CFG_AT_PORT_TX_READY_TIMEOUT milliseconds.
+ *
+ * Callbacks are optional, set to `NULL` in \ref gsm_ll_init if not supported by port
+ *
+ * \note            Input buffer watermarks have no meaning when \ref GSM_CFG_INPUT_USE_PROCESS is enabled
+ */
+#ifndef GSM_CFG_AT_PORT_FLOW_CONTROL
+#define GSM_CFG_AT_PORT_FLOW_CONTROL        0
+#endif
+
+/**
+ * \brief           Number of bytes in input buffer when reception is paused
+ *
+ * Leave enough room for bytes device sends after pause request
+ */
+#ifndef GSM_CFG_AT_PORT_FLOW_HIGH_WATERMARK
+#define GSM_CFG_AT_PORT_FLOW_HIGH_WATERMARK (GSM_CFG_RCV_BUFF_SIZE * 3 / 4)
+#endif
+
+/**
+ * \brief           Number of bytes in input buffer when paused reception is resumed
+ */
+#ifndef GSM_CFG_AT_PORT_FLOW_LOW_WATERMARK
+#define GSM_CFG_AT_PORT_FLOW_LOW_WATERMARK  (GSM_CFG_RCV_BUFF_SIZE / 4)
+#endif
+
+/**
+ * \brief           Maximal time in units of milliseconds to wait for device to accept data
+ *
+ * Data are sent anyway when time expires
+ */
+#ifndef GSM_CFG_AT_PORT_TX_READY_TIMEOUT
+#define GSM_CFG_AT_PORT_TX_READY_TIMEOUT    1000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` capture of raw AT port traffic
+ *
+ * When enabled, every block sent to and received from device
+ * is passed to function set with \ref gsm_capture_start, together with timestamp.
+ * Records may be written in \ref GSM_CAPTURE format and replayed later.
+ */
+#ifndef GSM_CFG_AT_CAPTURE
+#define GSM_CFG_AT_CAPTURE                  0
+#endif
+
+/**
+ * \brief           Memory barrier between writer and reader of ring buffer
+ *
+ *                  Input buffer may be written from interrupt or DMA context while processing thread reads it.
+ *                  Barrier makes sure data memory is accessed before buffer pointer is updated.
+ *
+ * \note            Default is selected for GCC compatible, Keil ARMCC, IAR, MSVC on x86 and C11 compilers.
+ *                  For other compilers it must be defined to target specific instruction,
+ *                  such as `__DMB()` on Cortex-M, otherwise compilation fails
+ */
+#ifndef GSM_CFG_MEMORY_BARRIER
+#if defined(__GNUC__)
+#define GSM_CFG_MEMORY_BARRIER()            __sync_synchronize()
+#elif defined(__CC_ARM)
+#define GSM_CFG_MEMORY_BARRIER()            __dmb(0xF)
+#elif defined(__ICCARM__)
+#include "intrinsics.h"
+#define GSM_CFG_MEMORY_BARRIER()            __DMB()
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include "intrin.h"
+#define GSM_CFG_MEMORY_BARRIER()            _ReadWriteBarrier() /* Stores are not reordered on x86, compiler barrier is enough */
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#include "stdatomic.h"
+#define GSM_CFG_MEMORY_BARRIER()            atomic_thread_fence(memory_order_seq_cst)
+#else
+#error "GSM_CFG_MEMORY_BARRIER must be defined for this compiler!"
+#endif
+#endif
+
+/**
+ * \brief           Buffer size for AT command line assembly before it is sent to low-level driver
+ *
+ * Command line is built in this buffer and passed to low-level send function once per line.
+ * Longer lines are still sent correctly, buffer is flushed when full.
+ *
+ * \note            Connection and SMS payload data are sent directly from user memory
+ */
+#ifndef GSM_CFG_AT_TX_BUFF_SIZE
+#define GSM_CFG_AT_TX_BUFF_SIZE             0x80
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` reset sequence after \ref gsm_init call
  *
@@ -160,6 +490,51 @@
 #define GSM_CFG_RESET_DELAY_DEFAULT         1000
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` warm start with \ref gsm_init_warm
+ *
+ *                  On warm start, device identity is restored from state saved with \ref gsm_warm_state_get.
+ *                  Device is only checked with single `AT` command and reset sequence is skipped.
+ *                  SIM information queries are deferred until after \ref GSM_EVT_INIT_FINISH event
+ *
+ * \note            Full reset sequence is used when saved state is not valid or device does not respond as expected
+ */
+#ifndef GSM_CFG_WARM_START
+#define GSM_CFG_WARM_START                  0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` device sleep management
+ *
+ *                  When enabled with \ref gsm_sleep_enable, device is put to sleep
+ *                  after producer queue is idle for configured time
+ *                  and woken up before next command is sent.
+ *                  PSM and eDRX timers are set with \ref gsm_sleep_set_psm and \ref gsm_sleep_set_edrx
+ *
+ * \note            Device is controlled with DTR line when \ref gsm_ll_t.wake_fn is set,
+ *                  otherwise it sleeps automatically and is woken up with \ref GSM_CFG_SLEEP_WAKE_PREAMBLE
+ */
+#ifndef GSM_CFG_SLEEP
+#define GSM_CFG_SLEEP                       0
+#endif
+
+/**
+ * \brief           Data sent to device to wake it up from sleep mode
+ *
+ *                  Device may lose first characters and replies to preamble
+ *                  before actual command is sent
+ */
+#ifndef GSM_CFG_SLEEP_WAKE_PREAMBLE
+#define GSM_CFG_SLEEP_WAKE_PREAMBLE         "AT\r\n"
+#endif
+
+/**
+ * \brief           Time in units of milliseconds device needs after wakeup before it accepts commands
+ */
+#ifndef GSM_CFG_SLEEP_WAKE_DELAY
+#define GSM_CFG_SLEEP_WAKE_DELAY            100
+#endif
+
 /**
  * \defgroup        GSM_CONF_DBG Debugging
  * \brief           Debugging configurations
@@ -185,6 +560,40 @@
 #define GSM_CFG_DBG_OUT(fmt, ...)           do { extern int printf( const char * format, ... ); printf(fmt, ## __VA_ARGS__); } while (0)
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` binary trace ring for debug messages
+ *
+ *                  Enabled debug messages are not formatted when they occur.
+ *                  Format string pointer, timestamp and up to \ref GSM_TRACE_ARGS_MAX arguments
+ *                  are written to RAM ring without locking instead,
+ *                  and formatted later with \ref gsm_trace_drain from low priority thread
+ *
+ * \note            Debug output must still be enabled with \ref GSM_CFG_DBG and debug types
+ */
+#ifndef GSM_CFG_DBG_TRACE
+#define GSM_CFG_DBG_TRACE                   0
+#endif
+
+/**
+ * \brief           Number of records in trace ring, must be power of `2`
+ *
+ *                  When ring is full, oldest records are overwritten
+ */
+#ifndef GSM_CFG_DBG_TRACE_SIZE
+#define GSM_CFG_DBG_TRACE_SIZE              256
+#endif
+
+/**
+ * \brief           Atomically add value to 32-bit trace ring index and return previous value
+ *
+ * \note            Define it to target specific implementation when compiler has no atomic builtins
+ */
+#ifndef GSM_CFG_DBG_TRACE_FETCH_ADD
+#if defined(__GNUC__)
+#define GSM_CFG_DBG_TRACE_FETCH_ADD(ptr, val)   __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+#endif
+#endif
+
 /**
  * \brief           Minimal debug level
  *
@@ -284,6 +693,15 @@
 #define GSM_CFG_DBG_NETCONN                 GSM_DBG_OFF
 #endif
 
+/**
+ * \brief           Set debug level for multiplexer layer
+ *
+ *                  Possible values are \ref GSM_DBG_ON or \ref GSM_DBG_OFF
+ */
+#ifndef GSM_CFG_DBG_CMUX
+#define GSM_CFG_DBG_CMUX                    GSM_DBG_OFF
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` echo mode on AT commands
  *                  sent to GSM device.
@@ -308,6 +726,11 @@
  * \brief           Set number of message queue entries for procuder thread
  *
  *                  Message queue is used for storing memory address to command data
+ *
+ * \note            Producer has one queue for each entry of \ref gsm_msg_prio_t
+ *                  and value sets number of entries in each of them.
+ *                  Queues are not ordered between each other: \ref gsm_reset and call control
+ *                  overtake queued data and \ref gsm_operator_scan waits for all other commands
  */
 #ifndef GSM_CFG_THREAD_PRODUCER_MBOX_SIZE
 #define GSM_CFG_THREAD_PRODUCER_MBOX_SIZE   16
@@ -322,6 +745,32 @@
 #define GSM_CFG_THREAD_PROCESS_MBOX_SIZE    16
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` deferred event dispatcher thread
+ *
+ *                  Event types selected with \ref gsm_evt_set_deferred are copied to queue
+ *                  and user callbacks are called from separate thread,
+ *                  so slow callback does not block processing of received data.
+ *                  All other event types are still called directly from processing thread.
+ *                  Events pointing to transient command data cannot be deferred, see \ref gsm_evt_set_deferred
+ *
+ * \note            This mode can only be used when \ref GSM_CFG_OS is enabled
+ */
+#ifndef GSM_CFG_EVT_DEFERRED
+#define GSM_CFG_EVT_DEFERRED                0
+#endif
+
+/**
+ * \brief           Set number of message queue entries for deferred event dispatcher thread
+ *
+ *                  When queue is full, event is called directly from processing thread
+ *
+ * \note            This parameter has no meaning when \ref GSM_CFG_EVT_DEFERRED is disabled
+ */
+#ifndef GSM_CFG_THREAD_EVT_MBOX_SIZE
+#define GSM_CFG_THREAD_EVT_MBOX_SIZE        16
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` direct support for processing input data
  *
@@ -339,6 +788,123 @@
 #define GSM_CFG_INPUT_USE_PROCESS           0
 #endif
  
+/**
+ * \brief           Enables `1` or disables `0` separate locks for independent parts of stack
+ *
+ *                  By default, single recursive system mutex protects everything.
+ *                  When enabled, core state and parser, event listener list,
+ *                  producer queues, memory allocator and write buffer of each connection
+ *                  have their own locks, so that application threads writing to
+ *                  connections or registering events do not wait for processing thread.
+ *
+ * \note            Locks are always taken in order: core, event list, connection write buffer,
+ *                  producer queues, memory.
+ *                  Low-level system port must provide recursive mutexes
+ */
+#ifndef GSM_CFG_LOCK_DOMAINS
+#define GSM_CFG_LOCK_DOMAINS                0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` command completion callbacks
+ *
+ *                  Completion callback is set with \ref gsm_set_cmd_evt
+ *                  and is attached to next command started by the same thread.
+ *                  It is called with command result once result is known,
+ *                  so that non-blocking calls can be used without polling
+ *
+ * \note            Pending callback is kept per thread with \ref GSM_CFG_THREAD_LOCAL specifier
+ */
+#ifndef GSM_CFG_CMD_EVT
+#define GSM_CFG_CMD_EVT                     0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` reuse of synchronization semaphore for blocking calls
+ *
+ *                  By default, semaphore is created and deleted for every blocking API call.
+ *                  When enabled, each calling thread creates its semaphore on first blocking call
+ *                  and keeps it with \ref GSM_CFG_THREAD_LOCAL specifier for all next calls
+ *
+ * \note            Semaphore is not deleted when thread exits
+ */
+#ifndef GSM_CFG_THREAD_SEM_CACHE
+#define GSM_CFG_THREAD_SEM_CACHE            0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` command latency statistics
+ *
+ *                  Each message is timestamped when it is written to producer queue,
+ *                  when producer thread takes it, when command is started,
+ *                  when first byte of response is received and when it completes.
+ *                  Times are collected to histograms for each API command
+ *
+ * \sa              gsm_get_cmd_stats
+ */
+#ifndef GSM_CFG_CMD_STATS
+#define GSM_CFG_CMD_STATS                   0
+#endif
+
+/**
+ * \brief           Number of different API commands with latency statistics
+ *
+ *                  Commands are added on first completion, later commands are not tracked
+ */
+#ifndef GSM_CFG_CMD_STATS_NUM
+#define GSM_CFG_CMD_STATS_NUM               16
+#endif
+
+/**
+ * \brief           Number of buckets in command latency histogram
+ *
+ *                  Bucket widths double, last bucket counts all times from
+ *                  `GSM_CFG_CMD_STATS_BUCKET_MS << (GSM_CFG_CMD_STATS_BUCKETS - 2)` milliseconds on
+ */
+#ifndef GSM_CFG_CMD_STATS_BUCKETS
+#define GSM_CFG_CMD_STATS_BUCKETS           12
+#endif
+
+/**
+ * \brief           Upper limit of first command latency histogram bucket in units of milliseconds
+ */
+#ifndef GSM_CFG_CMD_STATS_BUCKET_MS
+#define GSM_CFG_CMD_STATS_BUCKET_MS         10
+#endif
+
+/**
+ * \brief           Set maximal number of GSM device instances
+ *
+ *                  Each instance has its own device state, threads and message queues
+ *                  and talks to its own device over separate low-level AT port.
+ *                  When set to `1`, library operates with single global instance
+ *
+ * \note            When greater than `1`, every thread calling GSM API
+ *                  must first select instance with \ref gsm_instance_select.
+ *                  Threads which never select any instance operate on default instance (index `0`)
+ *
+ * \note            When greater than `1`, \ref GSM_CFG_LOCK_DOMAINS must be enabled
+ *                  so that each instance protects its core state with its own lock.
+ *                  Each instance allocates from its own heap regions, assigned with \ref gsm_mem_assignmemory
+ *                  while instance is selected. Memory pools are shared between instances
+ */
+#ifndef GSM_CFG_MAX_INSTANCES
+#define GSM_CFG_MAX_INSTANCES               1
+#endif
+
+/**
+ * \brief           Compiler storage class specifier for thread local variables
+ *
+ *                  Used to keep pointer to currently selected instance,
+ *                  pending command completion callback and cached semaphore separate for each thread
+ *
+ * \note            This parameter has no meaning when \ref GSM_CFG_MAX_INSTANCES is `1`,
+ *                  \ref GSM_CFG_CMD_EVT and \ref GSM_CFG_THREAD_SEM_CACHE are disabled
+ */
+#ifndef GSM_CFG_THREAD_LOCAL
+#define GSM_CFG_THREAD_LOCAL                __thread
+#endif
+
 /**
  * \}
  */
@@ -382,7 +948,9 @@
 /**
  * \brief           Accept queue length for new client when netconn server is used
  *
- *                  Defines number of maximal clients waiting in accept queue of server connection
+ *                  Defines number of maximal clients waiting in accept queue of server connection.
+ *                  Same number of netconns with receive queues is allocated by \ref gsm_netconn_bind,
+ *                  accepting a client does not allocate memory
  */
 #ifndef GSM_CFG_NETCONN_ACCEPT_QUEUE_LEN
 #define GSM_CFG_NETCONN_ACCEPT_QUEUE_LEN    5
@@ -397,6 +965,22 @@
 #define GSM_CFG_NETCONN_RECEIVE_QUEUE_LEN   8
 #endif
 
+/**
+ * \brief           Default receive window of netconn in units of bytes
+ *
+ *                  Maximal number of bytes queued in receive mbox and not yet read with \ref gsm_netconn_receive.
+ *                  When window is full, stack stops reading data from device
+ *                  and resumes once application reads data.
+ *                  Window is additionally limited by \ref GSM_CFG_NETCONN_RECEIVE_QUEUE_LEN,
+ *                  so that receive mbox never overflows
+ *
+ * \note            Window is used only when \ref GSM_CFG_CONN_MANUAL_TCP_RECEIVE is enabled.
+ *                  Otherwise device pushes data and packets are dropped when receive mbox is full
+ */
+#ifndef GSM_CFG_NETCONN_RECEIVE_WINDOW
+#define GSM_CFG_NETCONN_RECEIVE_WINDOW      GSM_CFG_CONN_MANUAL_TCP_RECEIVE_WINDOW
+#endif
+
 /**
  * \}
  */
@@ -426,6 +1010,28 @@
 #define GSM_CFG_DBG_MQTT_API                GSM_DBG_OFF
 #endif
 
+/**
+ * \brief           Maximal number of MQTT clients connected at the same time
+ *
+ *                  Value is only used to size default \ref GSM_CFG_MAX_TIMEOUTS.
+ *                  Set to `0` when MQTT client is not used
+ */
+#ifndef GSM_CFG_MQTT_MAX_CLIENTS
+#define GSM_CFG_MQTT_MAX_CLIENTS            1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` zero-copy receive in MQTT API client module
+ *
+ *                  When enabled and received publish packet is in single linear part of packet buffer,
+ *                  MQTT API buffer only references packet buffer and payload is not copied.
+ *
+ * \note            Payload is not `NULL` terminated when it references packet buffer memory
+ */
+#ifndef GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY
+#define GSM_CFG_MQTT_API_RECEIVE_ZERO_COPY  0
+#endif
+
 /**
  * \}
  */
@@ -441,6 +1047,59 @@
 #define GSM_CFG_NETWORK                     1
 #endif
 
+/**
+ * \brief           Enables (`1`) or disables (`0`) extended unsolicited network reports
+ *
+ *                  When enabled, device is configured with `AT+CREG=2` to report
+ *                  registration and cell changes and with `AT+AUTOCSQ=1,1` to report signal
+ *                  strength changes. Cached values returned by \ref gsm_network_rssi_cached,
+ *                  \ref gsm_network_reg_status_cached and \ref gsm_operator_get_cached
+ *                  then stay current without polling.
+ *
+ * \note            Devices without `AT+AUTOCSQ` command ignore signal strength part
+ */
+#ifndef GSM_CFG_NETWORK_URC
+#define GSM_CFG_NETWORK_URC                 0
+#endif
+
+/**
+ * \brief           Enables (`1`) or disables (`0`) automatic network reattach after PDP deactivation
+ *
+ *                  APN credentials of last successful \ref gsm_network_attach are kept.
+ *                  When device reports `+PDP: DEACT`, only IP stack is restarted with them
+ *                  (`CIPSHUT`, `CSTT`, `CIICR`, `CIFSR`), without GPRS detach and application mode setup.
+ *
+ *                  Client connections marked with \ref gsm_conn_set_resume are reopened
+ *                  after reattach and their owners get single \ref GSM_EVT_CONN_ACTIVE event on success,
+ *                  or single \ref GSM_EVT_CONN_ERROR event on failure, instead of \ref GSM_EVT_CONN_CLOSED event
+ *
+ * \note            Explicit \ref gsm_network_detach call disables reattach until next successful attach
+ */
+#ifndef GSM_CFG_NETWORK_REATTACH
+#define GSM_CFG_NETWORK_REATTACH            0
+#endif
+
+/**
+ * \brief           Maximal length of host name, including `NULL` termination,
+ *                  kept for connection resume after network reattach
+ *
+ * \note            Connections with longer host names cannot be resumed
+ */
+#ifndef GSM_CFG_NETWORK_REATTACH_HOST_LEN
+#define GSM_CFG_NETWORK_REATTACH_HOST_LEN   64
+#endif
+
+/**
+ * \brief           Number of operators kept in cache of last operator scan
+ *
+ *                  Operators found by \ref gsm_operator_scan are stored to cache
+ *                  and \ref gsm_operator_scan_cached returns them without new scan
+ *                  while they are fresh enough. Set to `0` to disable cache
+ */
+#ifndef GSM_CFG_OPERATOR_SCAN_CACHE_LEN
+#define GSM_CFG_OPERATOR_SCAN_CACHE_LEN     8
+#endif
+
 /**
  * \brief           Enables (`1`) or disables (`0`) connection API.
  *
@@ -458,6 +1117,28 @@
 #define GSM_CFG_SMS                         0
 #endif
 
+/**
+ * \brief           Maximal SMS memory position which can be marked for delete
+ *                  by \ref gsm_sms_list_stream callback function
+ *
+ *                  Marked positions are kept in bitmap of message, size is `(value + 8) / 8` bytes
+ */
+#ifndef GSM_CFG_SMS_LIST_DELETE_MAX_POS
+#define GSM_CFG_SMS_LIST_DELETE_MAX_POS     255
+#endif
+
+/**
+ * \brief           Enables (`1`) or disables (`0`) SMS PDU mode and batch send API
+ *
+ *                  When enabled, \ref gsm_sms_send_batch sends UTF-8 text in GSM 7-bit or UCS2 encoding
+ *                  to multiple recipients, splitting long text to concatenated messages
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_PDU
+#define GSM_CFG_SMS_PDU                     0
+#endif
+
 /**
  * \brief           Enables (`1`) or disables (`0`) call API.
  *
@@ -474,6 +1155,29 @@
 #define GSM_CFG_PHONEBOOK                   0
 #endif
 
+/**
+ * \brief           Enables (`1`) or disables (`0`) local phonebook cache
+ *
+ *                  Cache mirrors single phonebook memory in user array, loaded with \ref gsm_pb_cache_load.
+ *                  It is updated by \ref gsm_pb_add, \ref gsm_pb_edit and \ref gsm_pb_delete
+ *                  and indexed by phone number and name to search without modem communication
+ *
+ * \note            \ref GSM_CFG_PHONEBOOK must be enabled to use this feature
+ */
+#ifndef GSM_CFG_PHONEBOOK_CACHE
+#define GSM_CFG_PHONEBOOK_CACHE             0
+#endif
+
+/**
+ * \brief           Number of trailing digits used to compare phone numbers in phonebook cache
+ *
+ *                  Matches national and international format of the same number,
+ *                  such as `+38640123456` and `040123456`
+ */
+#ifndef GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS
+#define GSM_CFG_PHONEBOOK_CACHE_NUM_DIGITS  8
+#endif
+
 /**
  * \brief           Enables (`1`) or disables (`0`) HTTP API.
  *
@@ -483,6 +1187,32 @@
 #define GSM_CFG_HTTP                        0
 #endif
 
+/**
+ * \brief           Number of bytes requested with single `AT+HTTPREAD` command
+ *
+ *                  Response body is read from device in windows of this size.
+ *                  Window does not need to fit in memory as it is delivered
+ *                  in packet buffers of \ref GSM_CFG_HTTP_BUFF_SIZE bytes
+ */
+#ifndef GSM_CFG_HTTP_READ_LEN
+#define GSM_CFG_HTTP_READ_LEN               4096
+#endif
+
+/**
+ * \brief           Maximal size of packet buffer passed to HTTP sink function
+ */
+#ifndef GSM_CFG_HTTP_BUFF_SIZE
+#define GSM_CFG_HTTP_BUFF_SIZE              1024
+#endif
+
+/**
+ * \brief           Maximal time in units of milliseconds for entire HTTP request,
+ *                  including download of response body
+ */
+#ifndef GSM_CFG_HTTP_TIMEOUT
+#define GSM_CFG_HTTP_TIMEOUT                600000
+#endif
+
 /**
  * \brief           Enables (`1`) or disables (`0`) FTP API.
  *
@@ -492,6 +1222,24 @@
 #define GSM_CFG_FTP                         0
 #endif
 
+/**
+ * \brief           Number of bytes requested with single `AT+FTPGET=2` command
+ *
+ *                  Each response is delivered to sink function as one packet buffer
+ *
+ * \note            Devices do not return more than `1460` bytes at a time
+ */
+#ifndef GSM_CFG_FTP_READ_LEN
+#define GSM_CFG_FTP_READ_LEN                1460
+#endif
+
+/**
+ * \brief           Maximal time in units of milliseconds for entire FTP transfer
+ */
+#ifndef GSM_CFG_FTP_TIMEOUT
+#define GSM_CFG_FTP_TIMEOUT                 3600000
+#endif
+
 /**
  * \brief           Enables (`1`) or disables (`0`) PING API.
  *
@@ -502,20 +1250,138 @@
 #endif
 
 /**
- * \}
+ * \brief           Maximal time in units of milliseconds to wait for single ping reply
+ *
+ *                  Value is sent to device in units of `100` milliseconds
+ *                  and must be between `100` and `60000`.
+ *                  Probes without reply within this time are reported as lost
+ */
+#ifndef GSM_CFG_PING_TIMEOUT
+#define GSM_CFG_PING_TIMEOUT                10000
+#endif
+
+/**
+ * \brief           Number of buckets in ping round-trip time histogram
+ *
+ *                  Last bucket counts all replies longer than
+ *                  `(GSM_CFG_PING_HIST_BUCKETS - 1) * GSM_CFG_PING_HIST_BUCKET_MS`
+ */
+#ifndef GSM_CFG_PING_HIST_BUCKETS
+#define GSM_CFG_PING_HIST_BUCKETS           8
+#endif
+
+/**
+ * \brief           Width of single ping histogram bucket in units of milliseconds
+ *
+ * \note            Device reports reply time in units of `100` milliseconds,
+ *                  narrower buckets stay empty
+ */
+#ifndef GSM_CFG_PING_HIST_BUCKET_MS
+#define GSM_CFG_PING_HIST_BUCKET_MS         100
+#endif
+
+/**
+ * \brief           Enables (`1`) or disables (`0`) GSM 07.10 multiplexer
+ *
+ *                  When started with \ref gsm_cmux_start, serial port is split to
+ *                  virtual channels. AT commands use \ref GSM_CFG_CMUX_AT_DLCI channel,
+ *                  transparent connection uses \ref GSM_CFG_CMUX_DATA_DLCI channel when
+ *                  \ref GSM_CFG_CONN_TRANSPARENT is enabled, so AT commands are not blocked in data mode.
+ *                  Other channels are available to application with \ref gsm_cmux_channel_write
+ */
+#ifndef GSM_CFG_CMUX
+#define GSM_CFG_CMUX                        0
+#endif
+
+/**
+ * \brief           Maximal number of multiplexer data channels, excluding control channel
+ */
+#ifndef GSM_CFG_CMUX_MAX_CHANNELS
+#define GSM_CFG_CMUX_MAX_CHANNELS           3
+#endif
+
+/**
+ * \brief           Channel number used by AT command engine when multiplexer is active
+ */
+#ifndef GSM_CFG_CMUX_AT_DLCI
+#define GSM_CFG_CMUX_AT_DLCI                1
+#endif
+
+/**
+ * \brief           Channel number used by transparent connection when multiplexer is active
+ *
+ *                  Connection is started and its data are sent and received on this channel,
+ *                  while AT command channel stays in command mode.
+ *                  Channel is opened with \ref gsm_cmux_start when \ref GSM_CFG_CONN_TRANSPARENT is enabled.
+ *                  If device refuses it, connection data share AT command channel
  */
+#ifndef GSM_CFG_CMUX_DATA_DLCI
+#define GSM_CFG_CMUX_DATA_DLCI              2
+#endif
 
 /**
- * \brief           Poll interval for connections in units of milliseconds
+ * \brief           Maximal information field size of multiplexer frame in units of bytes
  *
- *                  Value indicates interval time to call poll event on active connections.
+ *                  Value is set to device as `N1` parameter with `AT+CMUX` command.
+ *                  Receive frame buffer of this size is part of global structure
+ */
+#ifndef GSM_CFG_CMUX_FRAME_SIZE
+#define GSM_CFG_CMUX_FRAME_SIZE             127
+#endif
+
+/**
+ * \}
+ */
+
+/**
+ * \brief           Default poll interval for connections in units of milliseconds
  *
- * \note            Single poll interval applies for all connections
+ *                  Polling is disabled for new connections and enabled per connection
+ *                  with \ref gsm_conn_set_poll_interval. Built-in netconn and MQTT client
+ *                  use this value when they need poll events.
  */
 #ifndef GSM_CFG_CONN_POLL_INTERVAL
 #define GSM_CFG_CONN_POLL_INTERVAL          500
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` DNS cache for \ref gsm_conn_start
+ *
+ *                  Host name is resolved with `AT+CDNSGIP` command before connection is started
+ *                  and resolved IP address is used for `AT+CIPSTART` command.
+ *                  Later connections to the same host skip DNS lookup until entry expires.
+ *
+ * \note            Cache is flushed when PDP context is deactivated by network
+ */
+#ifndef GSM_CFG_DNS_CACHE
+#define GSM_CFG_DNS_CACHE                   0
+#endif
+
+/**
+ * \brief           Number of host names in DNS cache
+ *
+ *                  Least recently resolved entry is replaced when cache is full
+ */
+#ifndef GSM_CFG_DNS_CACHE_SIZE
+#define GSM_CFG_DNS_CACHE_SIZE              4
+#endif
+
+/**
+ * \brief           Maximal host name length in DNS cache, including `NULL` termination.
+ *
+ *                  Longer host names are resolved by device on every connection
+ */
+#ifndef GSM_CFG_DNS_CACHE_HOST_LEN
+#define GSM_CFG_DNS_CACHE_HOST_LEN          64
+#endif
+
+/**
+ * \brief           Time in units of milliseconds resolved address stays valid in DNS cache
+ */
+#ifndef GSM_CFG_DNS_CACHE_TTL
+#define GSM_CFG_DNS_CACHE_TTL               3600000
+#endif
+
 /**
  * \defgroup        GSM_CONF_STD_LIB Standard library
  * \brief           Standard C library configuration
@@ -578,6 +1444,100 @@ void *  my_memset(void* dst, int b, size_t len);
     #endif /* GSM_CFG_INPUT_USE_PROCESS */
 #endif /* !GSM_CFG_OS */
 
+#if GSM_CFG_IPD_ZERO_COPY && GSM_CFG_INPUT_USE_PROCESS
+#error "GSM_CFG_IPD_ZERO_COPY may only be enabled when GSM_CFG_INPUT_USE_PROCESS is disabled!"
+#endif /* GSM_CFG_IPD_ZERO_COPY && GSM_CFG_INPUT_USE_PROCESS */
+
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE && !GSM_CFG_CONN
+#error "GSM_CFG_CONN_MANUAL_TCP_RECEIVE may only be enabled when GSM_CFG_CONN is enabled!"
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE && !GSM_CFG_CONN */
+
+#if GSM_CFG_CONN_TRANSPARENT && !GSM_CFG_CONN
+#error "GSM_CFG_CONN_TRANSPARENT may only be enabled when GSM_CFG_CONN is enabled!"
+#endif /* GSM_CFG_CONN_TRANSPARENT && !GSM_CFG_CONN */
+
+#if GSM_CFG_SMS_PDU && !GSM_CFG_SMS
+#error "GSM_CFG_SMS_PDU may only be enabled when GSM_CFG_SMS is enabled!"
+#endif /* GSM_CFG_SMS_PDU && !GSM_CFG_SMS */
+
+#if GSM_CFG_PHONEBOOK_CACHE && !GSM_CFG_PHONEBOOK
+#error "GSM_CFG_PHONEBOOK_CACHE may only be enabled when GSM_CFG_PHONEBOOK is enabled!"
+#endif /* GSM_CFG_PHONEBOOK_CACHE && !GSM_CFG_PHONEBOOK */
+
+#if GSM_CFG_HTTP && !GSM_CFG_NETWORK
+#error "GSM_CFG_HTTP may only be enabled when GSM_CFG_NETWORK is enabled!"
+#endif /* GSM_CFG_HTTP && !GSM_CFG_NETWORK */
+
+#if GSM_CFG_FTP && !GSM_CFG_NETWORK
+#error "GSM_CFG_FTP may only be enabled when GSM_CFG_NETWORK is enabled!"
+#endif /* GSM_CFG_FTP && !GSM_CFG_NETWORK */
+
+#if GSM_CFG_PING && !GSM_CFG_NETWORK
+#error "GSM_CFG_PING may only be enabled when GSM_CFG_NETWORK is enabled!"
+#endif /* GSM_CFG_PING && !GSM_CFG_NETWORK */
+
+#if GSM_CFG_CONN_SSL && !GSM_CFG_CONN
+#error "GSM_CFG_CONN_SSL may only be enabled when GSM_CFG_CONN is enabled!"
+#endif /* GSM_CFG_CONN_SSL && !GSM_CFG_CONN */
+
+#if GSM_CFG_DNS_CACHE && !GSM_CFG_CONN
+#error "GSM_CFG_DNS_CACHE may only be enabled when GSM_CFG_CONN is enabled!"
+#endif /* GSM_CFG_DNS_CACHE && !GSM_CFG_CONN */
+
+#if GSM_CFG_NETWORK_REATTACH && !GSM_CFG_NETWORK
+#error "GSM_CFG_NETWORK_REATTACH may only be enabled when GSM_CFG_NETWORK is enabled!"
+#endif /* GSM_CFG_NETWORK_REATTACH && !GSM_CFG_NETWORK */
+
+#if GSM_CFG_PING && (GSM_CFG_PING_TIMEOUT < 100 || GSM_CFG_PING_TIMEOUT > 60000)
+#error "GSM_CFG_PING_TIMEOUT must be between 100 and 60000 milliseconds!"
+#endif /* GSM_CFG_PING && (GSM_CFG_PING_TIMEOUT < 100 || GSM_CFG_PING_TIMEOUT > 60000) */
+
+#if GSM_CFG_PING && (GSM_CFG_PING_HIST_BUCKETS < 1 || GSM_CFG_PING_HIST_BUCKET_MS < 1)
+#error "GSM_CFG_PING_HIST_BUCKETS and GSM_CFG_PING_HIST_BUCKET_MS must be at least 1!"
+#endif /* GSM_CFG_PING && (GSM_CFG_PING_HIST_BUCKETS < 1 || GSM_CFG_PING_HIST_BUCKET_MS < 1) */
+
+#if GSM_CFG_CMD_STATS && (GSM_CFG_CMD_STATS_NUM < 1 || GSM_CFG_CMD_STATS_BUCKETS < 2 || GSM_CFG_CMD_STATS_BUCKET_MS < 1)
+#error "GSM_CFG_CMD_STATS_NUM and GSM_CFG_CMD_STATS_BUCKET_MS must be at least 1, GSM_CFG_CMD_STATS_BUCKETS at least 2!"
+#endif /* GSM_CFG_CMD_STATS && (GSM_CFG_CMD_STATS_NUM < 1 || GSM_CFG_CMD_STATS_BUCKETS < 2 || GSM_CFG_CMD_STATS_BUCKET_MS < 1) */
+
+#if GSM_CFG_DBG_TRACE
+    #if GSM_CFG_DBG_TRACE_SIZE < 2 || (GSM_CFG_DBG_TRACE_SIZE & (GSM_CFG_DBG_TRACE_SIZE - 1))
+    #error "GSM_CFG_DBG_TRACE_SIZE must be power of 2!"
+    #endif /* GSM_CFG_DBG_TRACE_SIZE < 2 || (GSM_CFG_DBG_TRACE_SIZE & (GSM_CFG_DBG_TRACE_SIZE - 1)) */
+    #if !defined(GSM_CFG_DBG_TRACE_FETCH_ADD)
+    #error "GSM_CFG_DBG_TRACE_FETCH_ADD must be defined for this compiler!"
+    #endif /* !defined(GSM_CFG_DBG_TRACE_FETCH_ADD) */
+#endif /* GSM_CFG_DBG_TRACE */
+
+#if GSM_CFG_BUFF_POW2 && (GSM_CFG_RCV_BUFF_SIZE & (GSM_CFG_RCV_BUFF_SIZE - 1))
+#error "GSM_CFG_RCV_BUFF_SIZE must be power of 2 when GSM_CFG_BUFF_POW2 is enabled!"
+#endif /* GSM_CFG_BUFF_POW2 && (GSM_CFG_RCV_BUFF_SIZE & (GSM_CFG_RCV_BUFF_SIZE - 1)) */
+
+#if GSM_CFG_MAX_INSTANCES < 1 || GSM_CFG_MAX_INSTANCES > 0xFF
+#error "GSM_CFG_MAX_INSTANCES must be between 1 and 255!"
+#endif /* GSM_CFG_MAX_INSTANCES < 1 || GSM_CFG_MAX_INSTANCES > 0xFF */
+
+#if GSM_CFG_MAX_INSTANCES > 1 && !GSM_CFG_LOCK_DOMAINS
+#error "GSM_CFG_LOCK_DOMAINS must be enabled when GSM_CFG_MAX_INSTANCES is greater than 1!"
+#endif /* GSM_CFG_MAX_INSTANCES > 1 && !GSM_CFG_LOCK_DOMAINS */
+
+#if GSM_CFG_CMUX
+    #if GSM_CFG_IPD_ZERO_COPY
+    #error "GSM_CFG_IPD_ZERO_COPY may only be enabled when GSM_CFG_CMUX is disabled!"
+    #endif /* GSM_CFG_IPD_ZERO_COPY */
+    #if GSM_CFG_CMUX_AT_DLCI < 1 || GSM_CFG_CMUX_AT_DLCI > GSM_CFG_CMUX_MAX_CHANNELS
+    #error "GSM_CFG_CMUX_AT_DLCI must be between 1 and GSM_CFG_CMUX_MAX_CHANNELS!"
+    #endif /* GSM_CFG_CMUX_AT_DLCI < 1 || GSM_CFG_CMUX_AT_DLCI > GSM_CFG_CMUX_MAX_CHANNELS */
+    #if GSM_CFG_CONN_TRANSPARENT
+        #if GSM_CFG_CMUX_DATA_DLCI < 1 || GSM_CFG_CMUX_DATA_DLCI > GSM_CFG_CMUX_MAX_CHANNELS
+        #error "GSM_CFG_CMUX_DATA_DLCI must be between 1 and GSM_CFG_CMUX_MAX_CHANNELS!"
+        #endif /* GSM_CFG_CMUX_DATA_DLCI < 1 || GSM_CFG_CMUX_DATA_DLCI > GSM_CFG_CMUX_MAX_CHANNELS */
+        #if GSM_CFG_CMUX_DATA_DLCI == GSM_CFG_CMUX_AT_DLCI
+        #error "GSM_CFG_CMUX_DATA_DLCI must not be equal to GSM_CFG_CMUX_AT_DLCI!"
+        #endif /* GSM_CFG_CMUX_DATA_DLCI == GSM_CFG_CMUX_AT_DLCI */
+    #endif /* GSM_CFG_CONN_TRANSPARENT */
+#endif /* GSM_CFG_CMUX */
+
 #endif /* !__DOXYGEN__ */
 
 #endif /* __GSM_DEFAULT_CONFIG_H */
@@ -49,8 +49,12 @@ extern "C" {
  
 gsmr_t      gsm_conn_start(gsm_conn_p* conn, gsm_conn_type_t type, const char* const host, gsm_port_t port, void* const arg, gsm_evt_fn cb_func, const uint32_t blocking);
 gsmr_t      gsm_conn_close(gsm_conn_p conn, const uint32_t blocking);
+gsmr_t      gsm_set_server(uint8_t en, gsm_port_t port, gsm_evt_fn cb_func, const uint32_t blocking);
 gsmr_t      gsm_conn_send(gsm_conn_p conn, const void* data, size_t btw, size_t* const bw, const uint32_t blocking);
 gsmr_t      gsm_conn_sendto(gsm_conn_p conn, const gsm_ip_t* const ip, gsm_port_t port, const void* data, size_t btw, size_t* bw, const uint32_t blocking);
+gsmr_t      gsm_conn_sendto_batch(gsm_conn_p conn, const gsm_dgram_t* dgrams, size_t dgramcnt, size_t* const sent, const uint32_t blocking);
+gsmr_t      gsm_conn_sendv(gsm_conn_p conn, const gsm_iovec_t* iov, size_t iovcnt, size_t* const bw, const uint32_t blocking);
+gsmr_t      gsm_conn_send_pbuf(gsm_conn_p conn, gsm_pbuf_p pbuf, size_t* const bw, const uint32_t blocking);
 gsmr_t      gsm_conn_set_arg(gsm_conn_p conn, void* const arg);
 void *      gsm_conn_get_arg(gsm_conn_p conn);
 uint8_t     gsm_conn_is_client(gsm_conn_p conn);
@@ -62,11 +66,31 @@ gsmr_t      gsm_get_conns_status(uint32_t blocking);
 gsm_conn_p  gsm_conn_get_from_evt(gsm_evt_t* evt);
 gsmr_t      gsm_conn_write(gsm_conn_p conn, const void* data, size_t btw, uint8_t flush, size_t* const mem_available);
 gsmr_t      gsm_conn_recved(gsm_conn_p conn, gsm_pbuf_p pbuf);
+gsmr_t      gsm_conn_set_receive_window(gsm_conn_p conn, size_t bytes, size_t pkts);
+gsmr_t      gsm_conn_set_poll_interval(gsm_conn_p conn, uint32_t interval);
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+gsmr_t      gsm_conn_dns_cache_flush(void);
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+gsmr_t      gsm_conn_ssl_set_cert(const char* name, const void* data, size_t len, const uint32_t blocking);
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
 size_t      gsm_conn_get_total_recved_count(gsm_conn_p conn);
+gsmr_t      gsm_conn_get_stats(gsm_conn_p conn, gsm_conn_stats_t* stats);
 
 uint8_t     gsm_conn_get_remote_ip(gsm_conn_p conn, gsm_ip_t* ip);
 gsm_port_t  gsm_conn_get_remote_port(gsm_conn_p conn);
 gsm_port_t  gsm_conn_get_local_port(gsm_conn_p conn);
+
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+gsmr_t      gsm_conn_set_resume(gsm_conn_p conn, uint8_t en);
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+gsmr_t      gsm_conn_set_transparent(uint8_t enable);
+uint8_t     gsm_conn_is_transparent(void);
+gsmr_t      gsm_conn_transparent_pause(const uint32_t blocking);
+gsmr_t      gsm_conn_transparent_resume(const uint32_t blocking);
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
  
 /**
  * \}
@@ -84,8 +84,18 @@ extern "C" {
 #endif
     
 #if (GSM_CFG_DBG && defined(GSM_CFG_DBG_OUT)) || __DOXYGEN__
+#if GSM_CFG_DBG_TRACE && !__DOXYGEN__
+#include "gsm/gsm_trace.h"
+
+#define GSM_DEBUGF(c, fmt, ...)         do {\
+    if (((c) & (GSM_DBG_ON)) && ((c) & (GSM_CFG_DBG_TYPES_ON)) && ((c) & GSM_DBG_LVL_MASK) >= (GSM_CFG_DBG_LVL_MIN)) {    \
+        gsm_trace_write((c), (fmt), GSM_TRACE_NARGS(__VA_ARGS__), GSM_TRACE_ARGV(__VA_ARGS__)); \
+    }                                       \
+} while (0)
+#else /* GSM_CFG_DBG_TRACE && !__DOXYGEN__ */
 /**
  * \brief           Print message to the debug "window" if enabled
+ * \note            With \ref GSM_CFG_DBG_TRACE enabled, message is written to trace ring instead
  * \param[in]       c: Condition if debug of specific type is enabled
  * \param[in]       fmt: Formatted string for debug
  * \param[in]       ...: Variable parameters for formatted string
@@ -95,6 +105,7 @@ extern "C" {
         GSM_CFG_DBG_OUT(fmt, ## __VA_ARGS__); \
     }                                       \
 } while (0)
+#endif /* !(GSM_CFG_DBG_TRACE && !__DOXYGEN__) */
 
 /**
  * \brief           Print message to the debug "window" if enabled when specific condition is met
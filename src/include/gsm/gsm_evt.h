@@ -57,6 +57,19 @@ gsm_evt_type_t  gsm_evt_get_type(gsm_evt_t* cc);
 
 uint8_t         gsm_evt_reset_is_forced(gsm_evt_t* cc);
  
+/**
+ * \}
+ */
+
+/**
+ * \name            GSM_EVT_AT_BAUDRATE
+ * \anchor          GSM_EVT_AT_BAUDRATE
+ * \brief           Event helper functions for \ref GSM_EVT_AT_BAUDRATE event
+ */
+
+uint32_t        gsm_evt_at_baudrate_get_baudrate(gsm_evt_t* cc);
+gsmr_t          gsm_evt_at_baudrate_get_result(gsm_evt_t* cc);
+
 /**
  * \}
  */
@@ -69,6 +82,19 @@ uint8_t         gsm_evt_reset_is_forced(gsm_evt_t* cc);
 
 const gsm_operator_curr_t*  gsm_evt_network_operator_get_current(gsm_evt_t* cc);
  
+/**
+ * \}
+ */
+
+/**
+ * \name            GSM_EVT_NETWORK_OPERATOR_SCAN
+ * \anchor          GSM_EVT_NETWORK_OPERATOR_SCAN
+ * \brief           Event helper functions for \ref GSM_EVT_NETWORK_OPERATOR_SCAN event
+ */
+
+const gsm_operator_t*   gsm_evt_network_operator_scan_get_operator(gsm_evt_t* cc);
+size_t      gsm_evt_network_operator_scan_get_index(gsm_evt_t* cc);
+
 /**
  * \}
  */
@@ -218,6 +244,42 @@ size_t  gsm_evt_sms_send_get_pos(gsm_evt_t* cc);
  * \}
  */
 
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \name            GSM_EVT_SMS_SEND_BATCH
+ * \anchor          GSM_EVT_SMS_SEND_BATCH
+ * \brief           Event helper functions for \ref GSM_EVT_SMS_SEND_BATCH event
+ */
+
+gsm_sms_recipient_t*    gsm_evt_sms_send_batch_get_recipients(gsm_evt_t* cc);
+size_t  gsm_evt_sms_send_batch_get_count(gsm_evt_t* cc);
+size_t  gsm_evt_sms_send_batch_get_sent(gsm_evt_t* cc);
+
+/**
+ * \}
+ */
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
+#if GSM_CFG_PING || __DOXYGEN__
+
+/**
+ * \name            GSM_EVT_LINK_QUALITY
+ * \anchor          GSM_EVT_LINK_QUALITY
+ * \brief           Event helper functions for \ref GSM_EVT_LINK_QUALITY event
+ */
+
+const char* gsm_evt_link_quality_get_host(gsm_evt_t* cc);
+const gsm_ping_stats_t* gsm_evt_link_quality_get_stats(gsm_evt_t* cc);
+gsmr_t  gsm_evt_link_quality_get_result(gsm_evt_t* cc);
+
+/**
+ * \}
+ */
+
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
+
 /**
  * \}
  */
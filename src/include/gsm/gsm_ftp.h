@@ -45,11 +45,23 @@ extern "C" {
  * \defgroup        GSM_FTP File transfer protocol
  * \brief           File Transfer Protocol (FTP) manager
  *
- * Currently it is under development
+ * FTP client runs on device with `AT+FTPGET` and `AT+FTPPUT` commands
+ * over bearer opened with \ref gsm_network_bearer_open.
+ *
+ * Files are streamed in both directions. Downloaded data are passed to sink function
+ * as soon as each chunk of up to \ref GSM_CFG_FTP_READ_LEN bytes is received and next
+ * chunk is requested immediately. For upload, source function is asked for next chunk
+ * as soon as device reports free space, with maximal length reported by device,
+ * so that device transfer buffer never runs empty while application has data.
  *
  * \{
  */
-    
+
+gsmr_t      gsm_ftp_get(const gsm_ftp_server_t* server, const char* path, const char* name,
+                gsm_ftp_sink_fn fn, void* arg, gsm_ftp_stats_t* stats, uint32_t blocking);
+gsmr_t      gsm_ftp_put(const gsm_ftp_server_t* server, const char* path, const char* name,
+                gsm_ftp_source_fn fn, void* arg, gsm_ftp_stats_t* stats, uint32_t blocking);
+
 /**
  * \}
  */
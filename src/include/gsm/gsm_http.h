@@ -46,10 +46,19 @@ extern "C" {
  * \brief           Hyper Text Transfer Protocol (HTTP) manager
  * \{
  *
- * Currently it is under development
+ * HTTP client runs on device with `AT+HTTP` commands over bearer
+ * opened with \ref gsm_network_bearer_open.
  *
+ * Response body is read in windows of \ref GSM_CFG_HTTP_READ_LEN bytes and passed
+ * to sink function in packet buffers of up to \ref GSM_CFG_HTTP_BUFF_SIZE bytes,
+ * so that body of any size can be processed without keeping it in memory.
+ * Next window is requested as soon as previous one is received, application may
+ * keep packet buffers with \ref gsm_pbuf_ref and process them in another thread
+ * while next part of body is transferred.
  */
-    
+
+gsmr_t      gsm_http_get(const char* url, gsm_http_sink_fn fn, void* arg, uint16_t* status, size_t* len, uint32_t blocking);
+
 /**
  * \}
  */
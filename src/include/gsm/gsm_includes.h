@@ -68,6 +68,22 @@ extern "C" {
 #if GSM_CFG_NETCONN
 #include "gsm/gsm_netconn.h"
 #endif /* GSM_CFG_NETCONN */
+#if GSM_CFG_CMUX
+#include "gsm/gsm_cmux.h"
+#endif /* GSM_CFG_CMUX */
+#if GSM_CFG_HTTP
+#include "gsm/gsm_http.h"
+#endif /* GSM_CFG_HTTP */
+#if GSM_CFG_FTP
+#include "gsm/gsm_ftp.h"
+#endif /* GSM_CFG_FTP */
+#if GSM_CFG_PING
+#include "gsm/gsm_ping.h"
+#endif /* GSM_CFG_PING */
+#if GSM_CFG_SLEEP
+#include "gsm/gsm_sleep.h"
+#endif /* GSM_CFG_SLEEP */
+#include "gsm/gsm_capture.h"
 
 #ifdef __cplusplus
 }
@@ -48,6 +48,8 @@ extern "C" {
  */
 
 gsmr_t      gsm_input(const void* data, size_t len);
+gsmr_t      gsm_input_get_write_block(void** addr, size_t* len);
+gsmr_t      gsm_input_advance(size_t len);
 gsmr_t      gsm_input_process(const void* data, size_t len);
 
 /**
@@ -55,13 +55,94 @@ typedef struct {
     size_t size;                                /*!< Size in units of bytes of region */
 } gsm_mem_region_t;
 
+/**
+ * \name            GSM_MEM_ALLOCATORS Memory allocators
+ * \anchor          GSM_MEM_ALLOCATORS
+ * \{
+ *
+ * List of available heap allocators.
+ * Configure \ref GSM_CFG_MEM_ALLOCATOR with one of these values
+ */
+
+#define GSM_MEM_ALLOCATOR_FIRST_FIT         1   /*!< First-fit allocator with single address ordered free list.
+                                                    Allocation time depends on number of free blocks */
+#define GSM_MEM_ALLOCATOR_TLSF              2   /*!< Two-level segregated fit allocator.
+                                                    Allocation and free execute in constant time */
+
+/**
+ * \}
+ */
+
+/**
+ * \brief           List of memory pools
+ * \sa              GSM_CONF_MEM_POOL
+ */
+typedef enum {
+    GSM_MEM_POOL_MSG,                           /*!< Pool for API messages */
+    GSM_MEM_POOL_PBUF,                          /*!< Pool for packet buffers */
+    GSM_MEM_POOL_TX_CHUNK,                      /*!< Pool for connection write buffers */
+    GSM_MEM_POOL_END,                           /*!< Last entry, number of pools */
+} gsm_mem_pool_t;
+
+/**
+ * \brief           List of allocation tags, used to account heap usage per subsystem
+ */
+typedef enum {
+    GSM_MEM_TAG_USER,                           /*!< Untagged allocations, used by \ref gsm_mem_alloc and \ref gsm_mem_calloc */
+    GSM_MEM_TAG_CORE,                           /*!< Core stack objects: buffers, timeouts, event callbacks */
+    GSM_MEM_TAG_MSG,                            /*!< API messages */
+    GSM_MEM_TAG_PBUF,                           /*!< Packet buffers */
+    GSM_MEM_TAG_CONN,                           /*!< Connection write buffers */
+    GSM_MEM_TAG_NETCONN,                        /*!< Netconn objects and write buffers */
+    GSM_MEM_TAG_MQTT,                           /*!< MQTT client objects and buffers */
+    GSM_MEM_TAG_END,                            /*!< Last entry, number of tags */
+} gsm_mem_tag_t;
+
+/**
+ * \brief           Heap usage of single tag
+ */
+typedef struct {
+    size_t current;                             /*!< Number of bytes currently allocated, including block metadata */
+    size_t peak;                                /*!< Maximal number of bytes allocated at the same time */
+    uint32_t failures;                          /*!< Number of failed allocations */
+} gsm_mem_tag_stats_t;
+
+/**
+ * \brief           Usage of single memory pool
+ */
+typedef struct {
+    size_t count;                               /*!< Number of items in pool */
+    size_t used;                                /*!< Number of items currently in use */
+    size_t peak;                                /*!< Maximal number of items in use at the same time */
+} gsm_mem_pool_stats_t;
+
+/**
+ * \brief           Memory statistics
+ * \sa              gsm_mem_getstats
+ */
+typedef struct {
+    size_t total;                               /*!< Total heap size available for allocations */
+    size_t free;                                /*!< Number of free bytes */
+    size_t min_free;                            /*!< Minimal number of free bytes ever */
+    size_t largest_free_block;                  /*!< Size of largest free block, including metadata.
+                                                    When much smaller than `free`, heap is fragmented */
+    size_t free_blocks;                         /*!< Number of free blocks */
+    uint32_t alloc_failures;                    /*!< Number of failed heap allocations */
+    gsm_mem_tag_stats_t tags[GSM_MEM_TAG_END];  /*!< Heap usage per tag */
+    gsm_mem_pool_stats_t pools[GSM_MEM_POOL_END];   /*!< Usage of fixed size pools */
+} gsm_mem_stats_t;
+
 void*   gsm_mem_alloc(uint32_t size);
+void*   gsm_mem_alloc_tag(gsm_mem_tag_t tag, size_t size);
+void*   gsm_mem_pool_alloc(gsm_mem_pool_t pool, gsm_mem_tag_t tag, size_t size);
 void*   gsm_mem_realloc(void* ptr, size_t size);
 void*   gsm_mem_calloc(size_t num, size_t size);
 void    gsm_mem_free(void* ptr);
 size_t  gsm_mem_getfree(void);
 size_t  gsm_mem_getfull(void);
 size_t  gsm_mem_getminfree(void);
+uint8_t gsm_mem_getstats(gsm_mem_stats_t* stats);
+void    gsm_mem_reset_peak(void);
 
 uint8_t gsm_mem_assignmemory(const gsm_mem_region_t* regions, size_t size);
     
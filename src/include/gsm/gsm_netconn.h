@@ -59,19 +59,42 @@ typedef struct gsm_netconn* gsm_netconn_p;
 typedef enum {
     GSM_NETCONN_TYPE_TCP = GSM_CONN_TYPE_TCP,   /*!< TCP connection */
     GSM_NETCONN_TYPE_UDP = GSM_CONN_TYPE_UDP,   /*!< UDP connection */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+    GSM_NETCONN_TYPE_SSL = GSM_CONN_TYPE_SSL,   /*!< TCP connection with TLS handled by device */
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
 } gsm_netconn_type_t;
 
+#define GSM_NETCONN_POLL_RECV       0x01        /*!< Netconn has received data ready to read */
+#define GSM_NETCONN_POLL_CLOSED     0x02        /*!< Connection was closed by remote side */
+
+/**
+ * \brief           Netconn poll set entry, used with \ref gsm_netconn_poll
+ */
+typedef struct {
+    gsm_netconn_p nc;                           /*!< Netconn to check */
+    uint8_t events;                             /*!< Events to wait for, combination of `GSM_NETCONN_POLL_*` flags */
+    uint8_t revents;                            /*!< Events currently active on netconn, set by \ref gsm_netconn_poll */
+} gsm_netconn_poll_t;
+
 gsm_netconn_p   gsm_netconn_new(gsm_netconn_type_t type);
 gsmr_t          gsm_netconn_delete(gsm_netconn_p nc);
 gsmr_t          gsm_netconn_connect(gsm_netconn_p nc, const char* host, gsm_port_t port);
+gsmr_t          gsm_netconn_bind(gsm_netconn_p nc, gsm_port_t port);
+gsmr_t          gsm_netconn_listen(gsm_netconn_p nc);
+gsmr_t          gsm_netconn_set_listen_conn_timeout(gsm_netconn_p nc, uint16_t timeout);
+gsmr_t          gsm_netconn_accept(gsm_netconn_p nc, gsm_netconn_p* client);
 gsmr_t          gsm_netconn_receive(gsm_netconn_p nc, gsm_pbuf_p* pbuf);
+gsmr_t          gsm_netconn_read(gsm_netconn_p nc, void* data, size_t len, size_t* br, uint32_t timeout);
+gsmr_t          gsm_netconn_poll(gsm_netconn_poll_t* set, size_t count, uint32_t timeout);
 gsmr_t          gsm_netconn_close(gsm_netconn_p nc);
 int8_t          gsm_netconn_getconnnum(gsm_netconn_p nc);
 void            gsm_netconn_set_receive_timeout(gsm_netconn_p nc, uint32_t timeout);
 uint32_t        gsm_netconn_get_receive_timeout(gsm_netconn_p nc);
+gsmr_t          gsm_netconn_set_receive_window(gsm_netconn_p nc, size_t size);
 
 /* TCP only */
 gsmr_t          gsm_netconn_write(gsm_netconn_p nc, const void* data, size_t btw);
+gsmr_t          gsm_netconn_writev(gsm_netconn_p nc, const gsm_iovec_t* iov, size_t iovcnt);
 gsmr_t          gsm_netconn_flush(gsm_netconn_p nc);
 
 /* UDP only */
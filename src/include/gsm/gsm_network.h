@@ -50,6 +50,8 @@ extern "C" {
 /* Basic commands, always available */
 gsmr_t      gsm_network_rssi(int16_t* rssi, uint32_t blocking);
 gsm_network_reg_status_t    gsm_network_get_reg_status(void);
+gsmr_t      gsm_network_rssi_cached(int16_t* rssi, uint32_t max_age, uint32_t blocking);
+gsmr_t      gsm_network_reg_status_cached(gsm_network_reg_status_t* status, uint32_t max_age, uint32_t blocking);
 
 /* TCP/IP related commands */
 gsmr_t      gsm_network_attach(const char* apn, const char* user, const char* pass, uint32_t blocking);
@@ -57,6 +59,9 @@ gsmr_t      gsm_network_detach(uint32_t blocking);
 uint8_t     gsm_network_is_attached(void);
 gsmr_t      gsm_network_copy_ip(gsm_ip_t* ip);
 gsmr_t      gsm_network_check_status(uint32_t blocking);
+#if GSM_CFG_HTTP || GSM_CFG_FTP || __DOXYGEN__
+gsmr_t      gsm_network_bearer_open(const char* apn, const char* user, const char* pass, uint32_t blocking);
+#endif /* GSM_CFG_HTTP || GSM_CFG_FTP || __DOXYGEN__ */
 
 /**
  * \}
@@ -48,9 +48,13 @@ extern "C" {
  */
 
 gsmr_t      gsm_operator_get(gsm_operator_curr_t* curr, uint32_t blocking);
+gsmr_t      gsm_operator_get_cached(gsm_operator_curr_t* curr, uint32_t max_age, uint32_t blocking);
 gsmr_t      gsm_operator_set(gsm_operator_mode_t mode, gsm_operator_format_t format, const char* name, uint32_t num, uint32_t blocking);
 
 gsmr_t      gsm_operator_scan(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t blocking);
+#if GSM_CFG_OPERATOR_SCAN_CACHE_LEN || __DOXYGEN__
+gsmr_t      gsm_operator_scan_cached(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t max_age, uint32_t blocking);
+#endif /* GSM_CFG_OPERATOR_SCAN_CACHE_LEN || __DOXYGEN__ */
 
 /**
  * \}
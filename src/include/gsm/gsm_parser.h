@@ -67,6 +67,29 @@ uint8_t     gsmi_parse_cpbf(const char* str);
 uint8_t     gsmi_parse_cipstatus_conn(const char* str, uint8_t is_conn_line, uint8_t* continueScan);
 
 uint8_t     gsmi_parse_ipd(const char* str);
+#if GSM_CFG_CONN_RECV_FROM || __DOXYGEN__
+uint8_t     gsmi_parse_recv_from(const char* str);
+#endif /* GSM_CFG_CONN_RECV_FROM || __DOXYGEN__ */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+uint8_t     gsmi_parse_ciprxget(const char* str);
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+uint8_t     gsmi_parse_cdnsgip(const char* str, gsm_ip_t* ip);
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
+
+#if GSM_CFG_HTTP || __DOXYGEN__
+uint8_t     gsmi_parse_httpaction(const char* str);
+uint8_t     gsmi_parse_httpread(const char* str);
+#endif /* GSM_CFG_HTTP || __DOXYGEN__ */
+
+#if GSM_CFG_FTP || __DOXYGEN__
+uint8_t     gsmi_parse_ftpget(const char* str);
+uint8_t     gsmi_parse_ftpput(const char* str);
+#endif /* GSM_CFG_FTP || __DOXYGEN__ */
+
+#if GSM_CFG_PING || __DOXYGEN__
+uint8_t     gsmi_parse_cipping(const char* str);
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
 
 #if defined(__cplusplus)
 }
@@ -68,8 +68,10 @@ uint8_t         gsm_pbuf_advance(gsm_pbuf_p pbuf, int len);
 gsm_pbuf_p      gsm_pbuf_skip(gsm_pbuf_p pbuf, size_t offset, size_t* new_offset);
 
 const void *    gsm_pbuf_get_linear_addr(const gsm_pbuf_p pbuf, size_t offset, size_t* new_len);
+size_t          gsm_pbuf_foreach_segment(const gsm_pbuf_p pbuf, size_t offset, size_t len, gsm_pbuf_segment_fn fn, void* arg);
 
 void            gsm_pbuf_set_ip(gsm_pbuf_p pbuf, const gsm_ip_t* ip, gsm_port_t port);
+uint8_t         gsm_pbuf_ip(const gsm_pbuf_p pbuf, gsm_ip_t* ip, gsm_port_t* port);
     
 /**
  * \}
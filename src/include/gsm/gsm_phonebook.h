@@ -57,6 +57,13 @@ gsmr_t      gsm_pb_read(gsm_mem_t mem, size_t pos, gsm_pb_entry_t* entry, uint32
 gsmr_t      gsm_pb_list(gsm_mem_t mem, size_t start_index, gsm_pb_entry_t* entries, size_t etr, size_t* er, uint32_t blocking);
 gsmr_t      gsm_pb_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t etr, size_t* er, uint32_t blocking);
 
+#if GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__
+gsmr_t      gsm_pb_cache_load(gsm_mem_t mem, gsm_pb_entry_t* entries, size_t size, uint32_t blocking);
+gsmr_t      gsm_pb_cache_clear(void);
+gsmr_t      gsm_pb_cache_find_number(const char* num, gsm_pb_entry_t* entry);
+gsmr_t      gsm_pb_cache_search(const char* name, gsm_pb_entry_t* entries, size_t etr, size_t* er);
+#endif /* GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__ */
+
 /**
  * \}
  */
@@ -44,9 +44,21 @@ extern "C" {
  * \ingroup         GSM
  * \defgroup        GSM_PING PING API
  * \brief           PING manager
+ *
+ * Probes are sent by device with `AT+CIPPING` command over attached network,
+ * see \ref gsm_network_attach. Round-trip times of all replies are collected
+ * into minimal, average and maximal time, jitter and fixed bucket histogram.
+ *
+ * Background monitor repeats probe rounds on timeout subsystem
+ * and reports each finished round with \ref GSM_EVT_LINK_QUALITY event.
+ *
  * \{
  */
-    
+
+gsmr_t      gsm_ping(const char* host, uint8_t count, gsm_ping_stats_t* stats, uint32_t blocking);
+gsmr_t      gsm_ping_monitor_start(const char* host, uint8_t count, uint32_t interval);
+gsmr_t      gsm_ping_monitor_stop(void);
+
 /**
  * \}
  */
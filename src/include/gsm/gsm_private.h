@@ -55,11 +55,20 @@ typedef enum {
     /* Basic AT commands */
     GSM_CMD_RESET,                              /*!< Reset device */
     GSM_CMD_RESET_DEVICE_FIRST_CMD,             /*!< Reset device first driver specific command */
+#if GSM_CFG_WARM_START || __DOXYGEN__
+    GSM_CMD_WARM_START,                         /*!< Check device with `AT` and SIM state, no reset */
+#endif /* GSM_CFG_WARM_START || __DOXYGEN__ */
     GSM_CMD_ATE0,                               /*!< Disable ECHO mode on AT commands */
     GSM_CMD_ATE1,                               /*!< Enable ECHO mode on AT commands */
     GSM_CMD_GSLP,                               /*!< Set GSM to sleep mode */
+#if GSM_CFG_SLEEP || __DOXYGEN__
+    GSM_CMD_CSCLK_SET,                          /*!< Set slow clock (sleep) mode */
+    GSM_CMD_CPSMS_SET,                          /*!< Set power saving mode timers */
+    GSM_CMD_CEDRXS_SET,                         /*!< Set extended discontinuous reception */
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
     GSM_CMD_RESTORE,                            /*!< Restore GSM internal settings to default values */
-    GSM_CMD_UART,
+    GSM_CMD_UART,                               /*!< Set AT port baudrate and reconfigure low-level port */
+    GSM_CMD_AT_SYNC,                            /*!< Verify AT link with plain `AT` command after baudrate change */
 
     GSM_CMD_CGACT_SET_0,
     GSM_CMD_CGACT_SET_1,
@@ -67,9 +76,22 @@ typedef enum {
     GSM_CMD_CGATT_SET_1,
     GSM_CMD_NETWORK_ATTACH,                     /*!< Attach to a network */
     GSM_CMD_NETWORK_DETACH,                     /*!< Detach from network */
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+    GSM_CMD_NETWORK_REATTACH,                   /*!< Restart IP stack with last credentials after PDP deactivation */
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
 
     GSM_CMD_CIPMUX_SET,
+    GSM_CMD_CIPMODE_SET,
+#if GSM_CFG_CMUX || __DOXYGEN__
+    GSM_CMD_CMUX_SET,                           /*!< Enable multiplexer mode on device */
+    GSM_CMD_CMUX_SABM,                          /*!< Open multiplexer channel */
+    GSM_CMD_CMUX_DISC,                          /*!< Close multiplexer channel */
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+    GSM_CMD_TRANSP_ESCAPE,                      /*!< Escape from data mode with `+++` sequence */
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
     GSM_CMD_CIPRXGET_SET,
+    GSM_CMD_CIPQSEND_SET,
     GSM_CMD_CSTT_SET,
 
     /* AT commands according to the V.25TER */
@@ -168,6 +190,9 @@ typedef enum {
     GSM_CMD_CFUN_GET,                           /*!< Get Phone Functionality */
     GSM_CMD_CREG_SET,                           /*!< Network Registration set output */
     GSM_CMD_CREG_GET,                           /*!< Get current network registration status */
+#if GSM_CFG_NETWORK_URC || __DOXYGEN__
+    GSM_CMD_AUTOCSQ_SET,                        /*!< Enable automatic signal strength report */
+#endif /* GSM_CFG_NETWORK_URC || __DOXYGEN__ */
     GSM_CMD_CBC,                                /*!< Battery Charge */
     GSM_CMD_CNUM,                               /*!< Subscriber Number */
 
@@ -194,6 +219,13 @@ typedef enum {
     GSM_CMD_CSSN,                               /*!< Supplementary Services Notification 109 */
 
     GSM_CMD_CIPMUX,                             /*!< Start Up Multi-IP Connection */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+    GSM_CMD_CIPSSL,                             /*!< Enable or disable TLS for next connection */
+    GSM_CMD_FSDEL,                              /*!< Delete file on device file system */
+    GSM_CMD_FSCREATE,                           /*!< Create file on device file system */
+    GSM_CMD_FSWRITE,                            /*!< Write data to file on device file system */
+    GSM_CMD_SSLSETCERT,                         /*!< Select certificate file for TLS connections */
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
     GSM_CMD_CIPSTART,                           /*!< Start Up TCP or UDP Connection */
     GSM_CMD_CIPSEND,                            /*!< Send Data Through TCP or UDP Connection */
     GSM_CMD_CIPQSEND,                           /*!< Select Data Transmitting Mode */
@@ -224,6 +256,46 @@ typedef enum {
     GSM_CMD_CIPSGTXT,                           /*!< Select GPRS PDP context */
     GSM_CMD_CIPTKA,                             /*!< Set TCP Keepalive Parameters */
 
+#if GSM_CFG_HTTP || GSM_CFG_FTP || __DOXYGEN__
+    GSM_CMD_BEARER_OPEN,                        /*!< Configure and open bearer used by HTTP and FTP */
+    GSM_CMD_SAPBR_CLOSE,                        /*!< Close bearer */
+    GSM_CMD_SAPBR_SET,                          /*!< Set bearer parameter */
+    GSM_CMD_SAPBR_OPEN,                         /*!< Open bearer */
+#endif /* GSM_CFG_HTTP || GSM_CFG_FTP || __DOXYGEN__ */
+#if GSM_CFG_HTTP || __DOXYGEN__
+    GSM_CMD_HTTP_GET,                           /*!< Execute HTTP GET request and read response body */
+    GSM_CMD_HTTPINIT,                           /*!< Initialize HTTP service */
+    GSM_CMD_HTTPPARA_CID,                       /*!< Set bearer profile used by HTTP */
+    GSM_CMD_HTTPPARA_URL,                       /*!< Set HTTP request URL */
+    GSM_CMD_HTTPSSL,                            /*!< Enable or disable HTTPS */
+    GSM_CMD_HTTPACTION,                         /*!< Start HTTP request */
+    GSM_CMD_HTTPREAD,                           /*!< Read part of HTTP response body */
+    GSM_CMD_HTTPTERM,                           /*!< Terminate HTTP service */
+#endif /* GSM_CFG_HTTP || __DOXYGEN__ */
+#if GSM_CFG_FTP || __DOXYGEN__
+    GSM_CMD_FTP_GET,                            /*!< Download file from FTP server */
+    GSM_CMD_FTP_PUT,                            /*!< Upload file to FTP server */
+    GSM_CMD_FTPCID,                             /*!< Set bearer profile used by FTP */
+    GSM_CMD_FTPSERV,                            /*!< Set FTP server address */
+    GSM_CMD_FTPPORT,                            /*!< Set FTP server port */
+    GSM_CMD_FTPUN,                              /*!< Set FTP user name */
+    GSM_CMD_FTPPW,                              /*!< Set FTP password */
+    GSM_CMD_FTPTYPE,                            /*!< Set FTP transfer type */
+    GSM_CMD_FTPGETPATH,                         /*!< Set path of file to download */
+    GSM_CMD_FTPGETNAME,                         /*!< Set name of file to download */
+    GSM_CMD_FTPGET_OPEN,                        /*!< Open FTP download session */
+    GSM_CMD_FTPGET_READ,                        /*!< Read part of downloaded file */
+    GSM_CMD_FTPPUTPATH,                         /*!< Set path of file to upload */
+    GSM_CMD_FTPPUTNAME,                         /*!< Set name of file to upload */
+    GSM_CMD_FTPPUTOPT,                          /*!< Set upload operation */
+    GSM_CMD_FTPPUT_OPEN,                        /*!< Open FTP upload session */
+    GSM_CMD_FTPPUT_WRITE,                       /*!< Write part of uploaded file */
+    GSM_CMD_FTPQUIT,                            /*!< Quit FTP session */
+#endif /* GSM_CFG_FTP || __DOXYGEN__ */
+#if GSM_CFG_PING || __DOXYGEN__
+    GSM_CMD_CIPPING,                            /*!< Send ping probes to remote host */
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
+
     GSM_CMD_SMS_ENABLE,
     GSM_CMD_CMGD,                               /*!< Delete SMS Message */
     GSM_CMD_CMGF,                               /*!< Select SMS Message Format */
@@ -264,8 +336,29 @@ typedef struct gsm_conn {
                                                      and connection was closed and active again in between. */
     
     gsm_linbuff_t   buff;                       /*!< Linear buffer structure */
+#if GSM_CFG_LOCK_DOMAINS || __DOXYGEN__
+    gsm_sys_mutex_t tx_lock;                    /*!< Protects write buffer, used instead of core lock */
+#endif /* GSM_CFG_LOCK_DOMAINS || __DOXYGEN__ */
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+    struct {
+        char        host[GSM_CFG_NETWORK_REATTACH_HOST_LEN];    /*!< Host used on connection start, empty when too long */
+        gsm_port_t  port;                       /*!< Remote port used on connection start */
+        gsm_conn_type_t type;                   /*!< Connection type */
+        uint8_t     en;                         /*!< Set to `1` to reopen connection after network reattach */
+        uint8_t     pending;                    /*!< Connection was closed by PDP deactivation and waits to be reopened */
+    } resume;                                   /*!< Connection resume information, kept when connection is closed */
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
     
     size_t          total_recved;               /*!< Total number of bytes received */
+    gsm_conn_stats_t stats;                     /*!< Traffic statistics, derived fields are calculated on read */
+    uint32_t        poll_interval;              /*!< Poll event interval in units of milliseconds, `0` when disabled */
+    uint32_t        poll_next;                  /*!< Absolute time of next poll event */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+    size_t          tcp_not_ack_bytes;          /*!< Number of bytes delivered to application and not yet confirmed */
+    size_t          tcp_not_ack_pkts;           /*!< Number of packet buffers delivered to application and not yet confirmed */
+    size_t          tcp_rx_window;              /*!< Maximal number of not confirmed bytes */
+    size_t          tcp_rx_window_pkts;         /*!< Maximal number of not confirmed packet buffers, `0` for no limit */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
 
     union {
         struct {
@@ -275,6 +368,10 @@ typedef struct gsm_conn {
             uint8_t in_closing:1;               /*!< Status if connection is in closing mode.
                                                     When in closing mode, ignore any possible received data from function */
             uint8_t bearer:1;                   /*!< Bearer used. Can be `1` or `0` */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+            uint8_t rx_pending:1;               /*!< Device has received data waiting to be read */
+            uint8_t rx_reading:1;               /*!< Read command is in queue or in progress */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
         } f;
     } status;                                   /*!< Connection status union with flag bits */
 } gsm_conn_t;
@@ -291,6 +388,10 @@ typedef struct gsm_pbuf {
     uint8_t* payload;                           /*!< Pointer to payload memory */
     gsm_ip_t ip;                                /*!< Remote address for received IPD data */
     gsm_port_t port;                            /*!< Remote port for received IPD data */
+#if GSM_CFG_IPD_ZERO_COPY || __DOXYGEN__
+    uint8_t* payload_mem;                       /*!< Payload memory copied out of receive buffer and freed with packet buffer,
+                                                    `NULL` when payload is part of packet buffer or receive buffer */
+#endif /* GSM_CFG_IPD_ZERO_COPY || __DOXYGEN__ */
 } gsm_pbuf_t;
 
 /**
@@ -301,9 +402,19 @@ typedef struct {
     size_t              tot_len;                /*!< Total length of packet */
     size_t              rem_len;                /*!< Remaining bytes to read in current +IPD statement */
     gsm_conn_p          conn;                   /*!< Pointer to connection for network data */
+    gsm_ip_t            ip;                     /*!< Remote IP address of received data */
+    gsm_port_t          port;                   /*!< Remote port of received data */
+#if GSM_CFG_CONN_RECV_FROM || __DOXYGEN__
+    uint8_t             from_valid;             /*!< Set to 1 when address was reported with `RECV FROM` before data */
+#endif /* GSM_CFG_CONN_RECV_FROM || __DOXYGEN__ */
 
     size_t              buff_ptr;               /*!< Buffer pointer to save data to */
     gsm_pbuf_p          buff;                   /*!< Pointer to data buffer used for receiving data */
+#if GSM_CFG_IPD_ZERO_COPY || __DOXYGEN__
+    uint8_t             ignore;                 /*!< Set to 1 when remaining data shall be skipped */
+    gsm_pbuf_p          hold;                   /*!< Packet buffer still referencing receive buffer memory */
+    size_t              hold_off;               /*!< Offset of held payload from beginning of processed block */
+#endif /* GSM_CFG_IPD_ZERO_COPY || __DOXYGEN__ */
 } gsm_ipd_t;
 
 /**
@@ -327,8 +438,23 @@ typedef struct gsm_msg {
     uint8_t         is_blocking;                /*!< Status if command is blocking */
     uint8_t         is_device;                  /*!< Is message device specific? */
     uint32_t        block_time;                 /*!< Maximal blocking time in units of milliseconds. Use 0 to for non-blocking call */
+    gsm_msg_prio_t  prio;                       /*!< Producer queue lane, set from default command */
+    uint32_t        queue_time;                 /*!< Time when message was written to producer queue */
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+    uint32_t        dispatch_time;              /*!< Time when producer thread took message from queue */
+    uint32_t        start_time;                 /*!< Time when command was started */
+    uint32_t        rsp_time;                   /*!< Time when first byte of response was received */
+    uint8_t         rsp_received;               /*!< Set to `1` when \ref rsp_time is valid */
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
+    struct gsm_msg* coalesce_list;              /*!< List of duplicate queries waiting for result of this message */
+    struct gsm_msg* coalesce_next;              /*!< Next message in coalesce list of owner message */
+    struct gsm_msg* coalesce_owner;             /*!< Message this query is attached to or `NULL` if queued on its own */
     gsmr_t          res;                        /*!< Result of message operation */
     gsmr_t          (*fn)(struct gsm_msg *);    /*!< Processing callback function to process packet */
+#if GSM_CFG_CMD_EVT || __DOXYGEN__
+    gsm_api_cmd_evt_fn evt_fn;                  /*!< Completion callback or `NULL` if not used */
+    void*           evt_arg;                    /*!< Custom user argument for completion callback */
+#endif /* GSM_CFG_CMD_EVT || __DOXYGEN__ */
     union {
         struct {
             uint32_t delay;                     /*!< Delay to use before sending first reset AT command */
@@ -340,6 +466,22 @@ typedef struct gsm_msg {
         struct {
             uint8_t mode;                       /*!< Functionality mode */
         } cfun;                                 /*!< Set phone functionality */
+#if GSM_CFG_SLEEP || __DOXYGEN__
+        struct {
+            uint8_t mode;                       /*!< Slow clock mode, `0` = disabled, `1` = DTR controlled, `2` = automatic */
+            uint32_t idle_time;                 /*!< Producer idle time before sleep in units of milliseconds */
+        } sleep;                                /*!< Set sleep mode */
+        struct {
+            uint8_t en;                         /*!< Set to `1` to enable PSM */
+            uint8_t tau;                        /*!< Encoded periodic TAU timer (T3412) */
+            uint8_t active;                     /*!< Encoded active timer (T3324) */
+        } psm;                                  /*!< Set power saving mode */
+        struct {
+            uint8_t en;                         /*!< Set to `1` to enable eDRX */
+            uint8_t act;                        /*!< Access technology type */
+            uint8_t cycle;                      /*!< eDRX cycle value */
+        } edrx;                                 /*!< Set extended discontinuous reception */
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
         
         struct {
             const char* pin;                    /*!< Pin code to write */
@@ -363,15 +505,25 @@ typedef struct gsm_msg {
             int16_t* rssi;                      /*!< Pointer to RSSI variable */
         } csq;                                  /*!< Signal strength */
         struct {
-            uint8_t read;                       /*!< Flag indicating we can read the COPS actual data */
             gsm_operator_t* ops;                /*!< Pointer to operators array */
             size_t opsl;                        /*!< Length of operators array */
             size_t opsi;                        /*!< Current operator index array */
             size_t* opf;                        /*!< Pointer to number of operators found */
+            gsm_operator_t op;                  /*!< Operator currently being parsed */
+            struct gsm_cops_scan_state {
+                uint8_t bo:1;                   /*!< Bracket open flag (Bracket Open) */
+                uint8_t ccd:1;                  /*!< 2 consecutive commas detected in a row (Comma Comma Detected) */
+                uint8_t tn:2;                   /*!< Term number in response, 2 bits for 4 diff values */
+                uint8_t tp;                     /*!< Current term character position */
+                uint8_t ch_prev;                /*!< Previous character */
+            } state;                            /*!< Parser state */
         } cops_scan;                            /*!< Scan operators */
         struct {
             gsm_operator_curr_t* curr;          /*!< Pointer to output current operator */
         } cops_get;                             /*!< Get current operator info */
+        struct {
+            gsm_network_reg_status_t* status;   /*!< Pointer to output registration status */
+        } creg_get;                             /*!< Get network registration status */
         struct {
             gsm_operator_mode_t mode;           /*!< COPS mode */
             gsm_operator_format_t format;       /*!< Operator format to print */
@@ -390,7 +542,21 @@ typedef struct gsm_msg {
             gsm_evt_fn evt_func;                /*!< Callback function to use on connection */
             uint8_t num;                        /*!< Connection number used for start */
             gsm_conn_connect_res_t conn_res;    /*!< Connection result status */
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+            gsm_conn_t* resume;                 /*!< Connection to reopen after network reattach, `NULL` for new connection */
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+            gsm_ip_t ip;                        /*!< Resolved IP address of host */
+            uint8_t ip_valid;                   /*!< Set to `1` when connection is started with resolved IP address */
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
         } conn_start;                           /*!< Structure for starting new connection */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+        struct {
+            const char* name;                   /*!< Certificate file name on device */
+            const void* data;                   /*!< Certificate data to write, `NULL` to only select file */
+            size_t len;                         /*!< Length of certificate data in units of bytes */
+        } ssl_cert;                             /*!< Select certificate for TLS connections */
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
         struct {
             gsm_conn_t* conn;                   /*!< Pointer to connection to close */
             uint8_t val_id;                     /*!< Connection current validation ID when command was sent to queue */
@@ -404,12 +570,32 @@ typedef struct gsm_msg {
             size_t sent_all;                    /*!< Number of bytes sent all together */
             uint8_t tries;                      /*!< Number of tries used for last packet */
             uint8_t wait_send_ok_err;           /*!< Set to 1 when we wait for SEND OK or SEND ERROR */
+            uint32_t send_time;                 /*!< Time when data of last packet were written to device */
             const gsm_ip_t* remote_ip;          /*!< Remote IP address for UDP connection */
             gsm_port_t remote_port;             /*!< Remote port address for UDP connection */
             uint8_t fau;                        /*!< Free after use flag to free memory after data are sent (or not) */
             size_t* bw;                         /*!< Number of bytes written so far */
             uint8_t val_id;                     /*!< Connection current validation ID when command was sent to queue */
+            gsm_pbuf_p pbuf;                    /*!< Packet buffer to send data from instead of `data` pointer. Freed after use */
+            const gsm_iovec_t* iov;             /*!< Data vectors to send data from instead of `data` pointer, `ptr` is offset in all vectors */
+            size_t iovcnt;                      /*!< Number of entries in `iov` array */
+            const gsm_dgram_t* dgrams;          /*!< Array of datagrams to send one after another, `data` points to current one */
+            size_t dgramcnt;                    /*!< Number of entries in `dgrams` array */
+            size_t dgram;                       /*!< Index of datagram currently being sent */
+            size_t* dgram_sent;                 /*!< Number of datagrams fully sent so far */
         } conn_send;                            /*!< Structure to send data on connection */
+        struct {
+            gsm_port_t port;                    /*!< Port to listen on */
+            uint8_t en;                         /*!< Set to `1` to enable server, `0` to disable */
+            gsm_evt_fn cb;                      /*!< Callback for incoming connections */
+        } tcpip_server;                         /*!< Server configuration */
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+        struct {
+            gsm_conn_t* conn;                   /*!< Connection to read data for */
+            size_t len;                         /*!< Number of bytes to read */
+            uint8_t val_id;                     /*!< Connection current validation ID when command was sent to queue */
+        } ciprxget;                             /*!< Manually read received data from device */
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
 #endif /* GSM_CFG_CONN || __DOXYGEN__ */
 
 #if GSM_CFG_SMS || __DOXYGEN__
@@ -417,6 +603,20 @@ typedef struct gsm_msg {
             const char* num;                    /*!< Phone number */
             const char* text;                   /*!< SMS content to send */
             uint8_t format;                     /*!< SMS format, `0 = PDU`, `1 = text` */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+            size_t text_len;                    /*!< Length of text in units of bytes */
+            gsm_sms_enc_t enc;                  /*!< Text encoding, either GSM 7-bit or UCS2 */
+            gsm_sms_recipient_t* rcpts;         /*!< Recipients list, used in PDU mode */
+            size_t rcpts_len;                   /*!< Number of recipients */
+            size_t ri;                          /*!< Current recipient index */
+            size_t sent;                        /*!< Number of recipients sent successfully */
+            size_t parts;                       /*!< Number of parts for text */
+            size_t part;                        /*!< Current part index, starting with `0` */
+            size_t part_start;                  /*!< Start position of current part in text */
+            size_t part_end;                    /*!< End position of current part in text */
+            size_t part_units;                  /*!< Number of septets or characters in current part */
+            uint8_t ref;                        /*!< Concatenated message reference number */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
         } sms_send;                             /*!< Send SMS */
         struct {
             gsm_mem_t mem;                      /*!< Memory to read from */
@@ -429,6 +629,7 @@ typedef struct gsm_msg {
         struct {
             gsm_mem_t mem;                      /*!< Memory to delete from */
             size_t pos;                         /*!< SMS position in memory */
+            uint8_t delflag;                    /*!< Delete flag for multiple messages, `0` to delete at `pos` only */
         } sms_delete;                           /*!< Delete SMS message */
         struct {
             gsm_mem_t mem;                      /*!< Memory to use for read */
@@ -440,6 +641,12 @@ typedef struct gsm_msg {
             uint8_t update;                     /*!< Update SMS status after read operation */
             uint8_t format;                     /*!< SMS format, `0 = PDU`, `1 = text` */
             uint8_t read;                       /*!< Read the data flag */
+            gsm_sms_list_fn fn;                 /*!< Callback for every entry, `NULL` to fill entries array.
+                                                    When set, single entry at `entries` is reused */
+            void* arg;                          /*!< User argument for callback */
+            uint8_t stop;                       /*!< Set to `1` when callback stopped listing */
+            size_t del_pos;                     /*!< Position currently being deleted */
+            uint8_t del[(GSM_CFG_SMS_LIST_DELETE_MAX_POS + 8) / 8]; /*!< Bitmap of positions to delete after list */
         } sms_list;                             /*!< List SMS messages */
         struct {
             gsm_mem_t mem[3];                   /*!< Array of memories */
@@ -466,6 +673,9 @@ typedef struct gsm_msg {
             size_t etr;                         /*!< NUmber of entries to read */
             size_t ei;                          /*!< Current entry index */
             size_t* er;                         /*!< Final entries read pointer for user */
+#if GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__
+            uint8_t cache;                      /*!< Set to `1` when list loads phonebook cache */
+#endif /* GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__ */
         } pb_list;                              /*!< List phonebook entries */
         struct {
             gsm_mem_t mem;                      /*!< Memory to use */
@@ -483,6 +693,71 @@ typedef struct gsm_msg {
             const char* pass;
         } network_attach;
 #endif /* GSM_CFG_NETWORK || __DOXYGEN__ */
+#if GSM_CFG_CMUX || __DOXYGEN__
+        struct {
+            uint8_t dlci;                       /*!< Channel to open or close */
+            gsm_cmux_recv_fn fn;                /*!< Receive function for opened channel */
+            void* arg;                          /*!< Custom argument for receive function */
+        } cmux;                                 /*!< Multiplexer channel control */
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
+#if GSM_CFG_HTTP || __DOXYGEN__
+        struct {
+            const char* url;                    /*!< Request URL */
+            gsm_http_sink_fn fn;                /*!< Function called with response body data */
+            void* arg;                          /*!< Custom argument for sink function */
+            uint16_t* status;                   /*!< Pointer to output HTTP status code */
+            size_t* len;                        /*!< Pointer to output response body length */
+            uint16_t code;                      /*!< HTTP status code reported by device */
+            size_t body_len;                    /*!< Response body length reported by device */
+            size_t offset;                      /*!< Offset of next byte to read from body */
+            size_t rem;                         /*!< Remaining bytes in current read window */
+            gsm_pbuf_p buff;                    /*!< Packet buffer currently being filled */
+            size_t buff_ptr;                    /*!< Write pointer in packet buffer */
+            uint8_t ssl;                        /*!< Set to `1` for HTTPS request */
+            uint8_t action;                     /*!< Set to `1` when `+HTTPACTION` result was received */
+            uint8_t read;                       /*!< Set to `1` when body data follow */
+            uint8_t stop;                       /*!< Set to `1` when sink function stopped download */
+            uint8_t err;                        /*!< Set to `1` when request failed */
+            uint8_t done;                       /*!< Set to `1` when session is being terminated */
+        } http_get;                             /*!< HTTP GET request */
+#endif /* GSM_CFG_HTTP || __DOXYGEN__ */
+#if GSM_CFG_FTP || __DOXYGEN__
+        struct {
+            const gsm_ftp_server_t* server;     /*!< Server login information */
+            const char* path;                   /*!< File path on server */
+            const char* name;                   /*!< File name on server */
+            gsm_ftp_sink_fn sink;               /*!< Function called with downloaded data */
+            gsm_ftp_source_fn source;           /*!< Function called to get data to upload */
+            void* arg;                          /*!< Custom argument for sink or source function */
+            gsm_ftp_stats_t* stats;             /*!< Pointer to output transfer statistics */
+            size_t offset;                      /*!< Offset of next byte to transfer */
+            size_t rem;                         /*!< Remaining bytes of current download chunk */
+            gsm_pbuf_p buff;                    /*!< Packet buffer of current download chunk */
+            size_t buff_ptr;                    /*!< Write pointer in packet buffer */
+            const void* data;                   /*!< Data of current upload chunk */
+            size_t len;                         /*!< Length of current upload chunk */
+            size_t max_len;                     /*!< Maximal upload chunk length reported by device */
+            uint32_t start;                     /*!< Transfer start time */
+            uint32_t chunk_start;               /*!< Current chunk start time */
+            uint8_t ok;                         /*!< Set to `1` when `OK` for current command was received */
+            uint8_t wait;                       /*!< Set to `1` when current command waits for transfer status */
+            uint8_t read;                       /*!< Set to `1` when file data follow */
+            uint8_t finished;                   /*!< Set to `1` when device reported end of transfer */
+            uint8_t stop;                       /*!< Set to `1` when sink function stopped download */
+            uint8_t err;                        /*!< Set to `1` when transfer failed */
+        } ftp;                                  /*!< FTP file transfer */
+#endif /* GSM_CFG_FTP || __DOXYGEN__ */
+#if GSM_CFG_PING || __DOXYGEN__
+        struct {
+            const char* host;                   /*!< Host name or IP address to ping */
+            uint8_t count;                      /*!< Number of probes */
+            gsm_ping_stats_t* stats;            /*!< Pointer to output statistics */
+            uint32_t rtt_sum;                   /*!< Sum of all round-trip times */
+            uint32_t rtt_diff_sum;              /*!< Sum of differences between consecutive round-trip times */
+            uint32_t rtt_prev;                  /*!< Round-trip time of previous reply */
+            uint8_t monitor;                    /*!< Set to `1` when ping is started by background monitor */
+        } ping;                                 /*!< Ping probes */
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
     } msg;                                      /*!< Group of different possible message contents */
 } gsm_msg_t;
 
@@ -515,8 +790,19 @@ typedef struct {
 typedef struct gsm_evt_func {
     struct gsm_evt_func* next;                  /*!< Next function in the list */
     gsm_evt_fn fn;                              /*!< Function pointer itself */
+    gsm_evt_mask_t mask;                        /*!< Event types function is subscribed to */
 } gsm_evt_func_t;
 
+/**
+ * \brief           Event waiting in deferred event queue
+ */
+typedef struct {
+    gsm_evt_t evt;                              /*!< Copy of event data */
+    gsm_evt_fn fn;                              /*!< Connection callback function or `NULL` for global event */
+    gsm_conn_p conn;                            /*!< Connection for connection event */
+    uint8_t val_id;                             /*!< Connection validation ID when event was created */
+} gsm_evt_deferred_t;
+
 /**
  * \ingroup         GSM_SMS
  * \brief           SMS memory information
@@ -537,6 +823,9 @@ typedef struct {
     uint8_t enabled;                            /*!< Flag indicating feature enabled */
 
     gsm_sms_mem_t mem[3];                       /*!< 3 memory info for operation,receive,sent storage */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+    uint8_t pdu_ref;                            /*!< Last used concatenated message reference number */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
 } gsm_sms_t;
 
 /**
@@ -550,6 +839,20 @@ typedef struct {
     size_t used;                                /*!< Number of used entries */
 } gsm_pb_mem_t;
 
+/**
+ * \ingroup         GSM_PB
+ * \brief           Phonebook cache structure
+ */
+typedef struct {
+    gsm_pb_entry_t* entries;                    /*!< User array with cached entries */
+    size_t size;                                /*!< Size of entries array */
+    size_t count;                               /*!< Number of valid entries in array */
+    gsm_mem_t mem;                              /*!< Cached memory */
+    uint16_t* num_idx;                          /*!< Hash table by normalized number, `2 * size` slots of entry index + 1, `0` when empty */
+    uint16_t* name_idx;                         /*!< Entry indexes sorted by name */
+    uint8_t valid;                              /*!< Set to `1` when cache is loaded and coherent with device */
+} gsm_pb_cache_t;
+
 /**
  * \ingroup         GSM_PB
  * \brief           Phonebook structure
@@ -559,6 +862,9 @@ typedef struct {
     uint8_t enabled;                            /*!< Flag indicating feature enabled */
 
     gsm_pb_mem_t mem;                           /*!< Memory information */
+#if GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__
+    gsm_pb_cache_t cache;                       /*!< Local phonebook cache */
+#endif /* GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__ */
 } gsm_pb_t;
 
 /**
@@ -568,35 +874,167 @@ typedef struct {
     gsm_sim_state_t state;                      /*!< Current SIM status */
 } gsm_sim_t;
 
+/**
+ * \brief           Age of cached value received from device
+ */
+typedef struct {
+    uint32_t time;                              /*!< Time of last update in units of milliseconds */
+    uint8_t valid;                              /*!< Set to `1` when value was received at least once */
+} gsm_value_age_t;
+
 /**
  * \brief           Network info
  */
 typedef struct {
     gsm_network_reg_status_t status;            /*!< Network registration status */
+    gsm_value_age_t status_age;                 /*!< Age of registration status */
     gsm_operator_curr_t curr_operator;          /*!< Current operator information */
+    gsm_value_age_t curr_operator_age;          /*!< Age of current operator information */
+#if GSM_CFG_OPERATOR_SCAN_CACHE_LEN || __DOXYGEN__
+    gsm_operator_t scan_cache[GSM_CFG_OPERATOR_SCAN_CACHE_LEN]; /*!< Operators found in last scan */
+    size_t scan_cache_len;                      /*!< Number of valid entries in scan cache */
+    gsm_value_age_t scan_cache_age;             /*!< Age of scan cache, valid only after complete scan */
+#endif /* GSM_CFG_OPERATOR_SCAN_CACHE_LEN || __DOXYGEN__ */
 
     uint8_t is_attached;                        /*!< Flag indicating device is attached and PDP context is active */
     gsm_ip_t ip_addr;                           /*!< Device IP address when network PDP context is enabled */
 } gsm_network_t;
 
+#if GSM_CFG_CMUX || __DOXYGEN__
+
+/**
+ * \brief           Multiplexer virtual channel
+ */
+typedef struct {
+    uint8_t open;                               /*!< Channel is open on both sides */
+    gsm_cmux_recv_fn fn;                        /*!< Function to call with received channel data */
+    void* arg;                                  /*!< Custom argument for receive function */
+} gsm_cmux_ch_t;
+
+/**
+ * \brief           Multiplexer state
+ */
+typedef struct {
+    uint8_t active;                             /*!< Device is in multiplexer mode, all data are framed */
+    gsm_ll_send_fn send_fn;                     /*!< Low-level send function of physical port */
+    uint8_t tx_dlci;                            /*!< Channel where AT command engine sends current command */
+    gsm_cmux_ch_t ch[GSM_CFG_CMUX_MAX_CHANNELS + 1];    /*!< Channels, including control channel `0` */
+
+    struct {
+        uint8_t state;                          /*!< Frame decoder state */
+        uint8_t addr;                           /*!< Address field of current frame */
+        uint8_t ctrl;                           /*!< Control field of current frame */
+        uint8_t fcs;                            /*!< Running frame check sequence */
+        size_t len;                             /*!< Information field length */
+        size_t ptr;                             /*!< Number of information bytes received */
+        uint8_t data[GSM_CFG_CMUX_FRAME_SIZE];  /*!< Information field */
+    } rx;                                       /*!< Frame decoder */
+} gsm_cmux_t;
+
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
+
+/**
+ * \ingroup         GSM_UNICODE
+ * \brief           Unicode support structure
+ */
+typedef struct {
+    uint8_t ch[4];                              /*!< UTF-8 max characters */
+    uint8_t t;                                  /*!< Total expected length in UTF-8 sequence */
+    uint8_t r;                                  /*!< Remaining bytes in UTF-8 sequence */
+    gsmr_t res;                                 /*!< Current result of processing */
+} gsm_unicode_t;
+
+#define GSMI_LINE_FIRST                     0x01    /*!< Fragment is first part of line */
+#define GSMI_LINE_LAST                      0x02    /*!< Fragment is last part of line, including `CR LF` */
+
+/**
+ * \brief           Streamed line fragment handler function prototype
+ * \param[in]       data: Fragment of received line, `NULL` terminated
+ * \param[in]       len: Length of fragment in units of bytes
+ * \param[in]       flags: Bitwise OR of \ref GSMI_LINE_FIRST and \ref GSMI_LINE_LAST
+ */
+typedef void (*gsmi_line_fn)(const char* data, size_t len, uint8_t flags);
+
+/**
+ * \brief           Line streaming state of receive buffer
+ */
+typedef struct {
+    const struct gsmi_line_stream* entry;       /*!< Stream table entry of current command, `NULL` if command has none */
+    uint8_t             checked;                /*!< Set to `1` when current line was compared to stream prefix */
+    uint8_t             active;                 /*!< Set to `1` when current line is passed to handler in fragments */
+    uint8_t             first;                  /*!< Set to `1` until first fragment of line is passed to handler */
+    uint8_t             truncated;              /*!< Set to `1` when current line did not fit to receive buffer */
+} gsm_recv_stream_t;
+
 /**
- * \brief           GSM global structure
+ * \ingroup         GSM_TIMEOUT
+ * \brief           Timeout list of single device instance
  */
 typedef struct {
+    gsm_timeout_t       entries[GSM_CFG_MAX_TIMEOUTS];  /*!< Preallocated timeout entries */
+    uint8_t             heap[GSM_CFG_MAX_TIMEOUTS]; /*!< Active timeout indexes, min-heap ordered by expiry time */
+    uint8_t             free[GSM_CFG_MAX_TIMEOUTS]; /*!< Stack of free timeout indexes */
+    size_t              heap_len;               /*!< Number of active timeouts */
+    size_t              free_len;               /*!< Number of free timeouts */
+    uint8_t             initialized;            /*!< Set to `1` when free stack is created */
+    uint32_t            seq;                    /*!< Last used sequence number */
+} gsm_timeouts_t;
+
+/**
+ * \brief           GSM device instance structure
+ */
+typedef struct gsm_instance {
     gsm_sys_sem_t       sem_sync;               /*!< Synchronization semaphore between threads */
-    gsm_sys_mbox_t      mbox_producer;          /*!< Producer message queue handle */
+#if GSM_CFG_LOCK_DOMAINS || __DOXYGEN__
+    gsm_sys_mutex_t     lock_core;              /*!< Protects device state and parser */
+    gsm_sys_mutex_t     lock_evt;               /*!< Protects event listener list */
+    gsm_sys_mutex_t     lock_producer;          /*!< Protects producer queue statistics and coalesced queries */
+#endif /* GSM_CFG_LOCK_DOMAINS || __DOXYGEN__ */
+    gsm_sys_mbox_t      mbox_producer;          /*!< Producer wakeup queue, one entry for each message written to any lane */
+    gsm_sys_mbox_t      mbox_producer_lane[GSM_MSG_PRIO_END];   /*!< Producer message queues, one for each priority */
+    gsm_msg_lane_stats_t producer_lane_stats[GSM_MSG_PRIO_END]; /*!< Statistics of producer message queues */
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+    gsm_cmd_stats_t     cmd_stats[GSM_CFG_CMD_STATS_NUM];   /*!< Latency statistics of API commands */
+    size_t              cmd_stats_num;          /*!< Number of used entries in \ref cmd_stats */
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
     gsm_sys_mbox_t      mbox_process;           /*!< Consumer message queue handle */
     gsm_sys_thread_t    thread_producer;        /*!< Producer thread handle */
     gsm_sys_thread_t    thread_process;         /*!< Processing thread handle */
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+    gsm_sys_mbox_t      mbox_evt;               /*!< Deferred event queue handle */
+    gsm_sys_thread_t    thread_evt;             /*!< Deferred event dispatcher thread handle */
+    gsm_evt_mask_t      evt_deferred_mask;      /*!< Event types dispatched from deferred event thread */
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
 #if !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__
     gsm_buff_t          buff;                   /*!< Input processing buffer */
 #endif /* !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
     gsm_ll_t            ll;                     /*!< Low level functions */
+#if (GSM_CFG_AT_PORT_FLOW_CONTROL && !GSM_CFG_INPUT_USE_PROCESS) || __DOXYGEN__
+    volatile uint8_t    rx_paused;              /*!< Set to `1` when reception is paused with flow control */
+#endif /* (GSM_CFG_AT_PORT_FLOW_CONTROL && !GSM_CFG_INPUT_USE_PROCESS) || __DOXYGEN__ */
+#if GSM_CFG_CMUX || __DOXYGEN__
+    gsm_cmux_t          cmux;                   /*!< Multiplexer layer between AT engine and low level */
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
     
     gsm_msg_t*          msg;                    /*!< Pointer to current user message being executed */
 
     gsm_evt_t           evt;                    /*!< Callback processing structure */
     gsm_evt_func_t*     evt_func;               /*!< Callback function linked list */
+    gsm_evt_mask_t      evt_func_mask;          /*!< Union of masks of all registered functions */
+    gsm_evt_func_t      evt_func_def;           /*!< List entry of default callback function set in \ref gsm_init */
+
+    /* Receive and transmit processing */
+    gsm_recv_t          recv_buff;              /*!< Received line buffer */
+    gsm_recv_stream_t   recv_stream;            /*!< Streaming of lines longer than received line buffer */
+    uint8_t             recv_ch_prev1;          /*!< Previous received character */
+    uint8_t             recv_ch_prev2;          /*!< Character received before previous one */
+    gsm_unicode_t       recv_unicode;           /*!< UTF-8 decoder state of received data */
+    uint32_t            recv_total_len;         /*!< Total number of bytes received from AT port */
+    uint32_t            recv_calls;             /*!< Number of calls to input functions */
+    uint8_t             at_tx_buff[GSM_CFG_AT_TX_BUFF_SIZE];    /*!< Command line assembly buffer */
+    size_t              at_tx_len;              /*!< Number of bytes waiting in command line buffer */
+    gsm_msg_t*          msg_coalesce_pending[4];/*!< Queued status queries other requests can attach to */
+    gsm_timeouts_t      timeouts;               /*!< Timeout list */
 
     /* Device identification */
     char                model_manufacturer[20]; /*!< Device manufacturer */
@@ -606,14 +1044,62 @@ typedef struct {
     /* Network&operator specific */
     gsm_sim_t           sim;                    /*!< SIM data */
     gsm_network_t       network;                /*!< Network status */
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+    struct {
+        char            apn[32];                /*!< APN name of last successful attach */
+        char            user[32];               /*!< User name of last successful attach */
+        char            pass[32];               /*!< Password of last successful attach */
+        uint8_t         valid;                  /*!< Set to `1` when credentials may be used for reattach */
+        uint8_t         active;                 /*!< Set to `1` while reattach is in progress */
+    } reattach;                                 /*!< Network reattach information */
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
     int16_t             rssi;                   /*!< RSSI signal strength. `0` = invalid, `-53 % -113` = valid */
+    gsm_value_age_t     rssi_age;               /*!< Age of RSSI value */
+#if GSM_CFG_SLEEP || __DOXYGEN__
+    struct {
+        uint8_t         mode;                   /*!< Slow clock mode set on device, `0` when disabled */
+        uint32_t        idle_time;              /*!< Producer idle time before sleep in units of milliseconds */
+        uint8_t         asleep;                 /*!< Set to `1` when device is allowed to sleep */
+    } sleep;                                    /*!< Sleep management information */
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
+#if GSM_CFG_AT_CAPTURE || __DOXYGEN__
+    struct {
+        gsm_capture_fn  fn;                     /*!< Capture function, `NULL` when capture is not active */
+        void*           arg;                    /*!< Custom argument for capture function */
+        uint32_t        start;                  /*!< Time when capture started */
+    } capture;                                  /*!< AT port traffic capture */
+#endif /* GSM_CFG_AT_CAPTURE || __DOXYGEN__ */
 
     /* Device specific */
 #if GSM_CFG_CONN || __DOXYGEN__
     uint8_t             active_conns_cur_parse_num; /*!< Current connection number used for parsing */
+    uint8_t             conns_status_valid;     /*!< Set to `1` when connection states tracked from responses match device,
+                                                    `0` when full `CIPSTATUS` query is needed */
 
     gsm_conn_t          conns[GSM_CFG_MAX_CONNS];   /*!< Array of all connection structures */
+    gsm_evt_fn          evt_server;             /*!< Callback for incoming server connections, `NULL` when server is disabled */
+    gsm_port_t          server_port;            /*!< Port used by server */
+    gsm_timeout_id_t    conn_poll_timeout;      /*!< Single timeout for poll events of all connections */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+    uint8_t             conn_ssl;               /*!< TLS mode set on device with `AT+CIPSSL` */
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+    struct {
+        char            host[GSM_CFG_DNS_CACHE_HOST_LEN];   /*!< Host name */
+        gsm_ip_t        ip;                     /*!< Resolved IP address */
+        uint32_t        time;                   /*!< Time when host was resolved */
+        uint8_t         valid;                  /*!< Set to `1` when entry is used */
+    } dns_cache[GSM_CFG_DNS_CACHE_SIZE];        /*!< Resolved host names */
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
     gsm_ipd_t           ipd;                    /*!< Connection incoming data structure */
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+    struct {
+        uint8_t         req;                    /*!< Transparent mode is requested for next network attach */
+        uint8_t         active;                 /*!< Device is configured for single connection transparent mode */
+        uint8_t         data_mode;              /*!< Device is in data mode, all received bytes belong to connection */
+        uint8_t         close_match;            /*!< Number of matched bytes of closed marker in data stream */
+    } transp;                                   /*!< Transparent mode information */
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
 #endif /* GSM_CFG_CONNS || __DOXYGEN__ */
 #if GSM_CFG_SMS || __DOXYGEN__
     gsm_sms_t           sms;                    /*!< SMS information */
@@ -624,6 +1110,16 @@ typedef struct {
 #if GSM_CFG_CALL || __DOXYGEN__
     gsm_call_t          call;                   /*!< Call information */
 #endif /* GSM_CFG_CALL || __DOXYGEN__ */ 
+#if GSM_CFG_PING || __DOXYGEN__
+    struct {
+        const char*     host;                   /*!< Host name or IP address to ping */
+        uint8_t         count;                  /*!< Number of probes in each round */
+        uint32_t        interval;               /*!< Time between rounds in units of milliseconds */
+        uint8_t         active;                 /*!< Set to `1` when monitor is running */
+        gsm_timeout_id_t timeout;               /*!< Timeout ID of next round */
+        gsm_ping_stats_t stats;                 /*!< Statistics of last round */
+    } ping_mon;                                 /*!< Background link quality monitor */
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
     union {
         struct {
             uint8_t     initialized:1;          /*!< Flag indicating GSM library is initialized */
@@ -631,6 +1127,33 @@ typedef struct {
         } f;                                    /*!< Flags structure */
     } status;                                   /*!< Status structure */
     
+    struct {
+        uint32_t        target;                 /*!< Baudrate currently requested from device */
+        uint32_t        prev;                   /*!< Baudrate used before last change */
+        uint8_t         revert;                 /*!< Set to `1` when previous baudrate has been restored after failure */
+        gsmr_t          res;                    /*!< Result of last baudrate change */
+#if GSM_CFG_AT_PORT_BAUDRATE_AUTO || __DOXYGEN__
+        uint8_t         idx;                    /*!< Index of next candidate in escalation list */
+#endif /* GSM_CFG_AT_PORT_BAUDRATE_AUTO || __DOXYGEN__ */
+        gsm_timeout_id_t sync_timeout;          /*!< Timeout ID of sync command */
+    } baud;                                     /*!< AT port baudrate change information */
+
+#if GSM_CFG_WARM_START || __DOXYGEN__
+    struct {
+        uint8_t         hold;                   /*!< Pending warm start steps, see `GSM_WARM_HOLD_*` */
+        uint8_t         echo;                   /*!< Set to `1` when command echo was received on liveness check */
+        uint8_t         sim_info;               /*!< Set to `1` when SIM info query is deferred */
+    } warm;                                     /*!< Warm start information */
+#endif /* GSM_CFG_WARM_START || __DOXYGEN__ */
+
+#if GSM_CFG_NETCONN || __DOXYGEN__
+    struct {
+        struct gsm_netconn* list;               /*!< Linked list of netconn entries */
+        struct gsm_netconn* listen;             /*!< Netconn in listening mode, device supports one server */
+        gsm_sys_sem_t   poll_sem;               /*!< Readiness semaphore shared by all netconns of instance */
+    } netconn;                                  /*!< Netconn API state */
+#endif /* GSM_CFG_NETCONN || __DOXYGEN__ */
+
     uint8_t conn_val_id;                        /*!< Validation ID increased each time device connects to network */
 } gsm_t;
 
@@ -642,17 +1165,6 @@ typedef struct {
     const char* mem_str;                        /*!< Memory string */
 } gsm_dev_mem_map_t;
 
-/**
- * \ingroup         GSM_UNICODE
- * \brief           Unicode support structure
- */
-typedef struct {
-    uint8_t ch[4];                              /*!< UTF-8 max characters */
-    uint8_t t;                                  /*!< Total expected length in UTF-8 sequence */
-    uint8_t r;                                  /*!< Remaining bytes in UTF-8 sequence */
-    gsmr_t res;                                 /*!< Current result of processing */
-} gsm_unicode_t;
-
 /**
  * \}
  */
@@ -666,7 +1178,12 @@ typedef struct {
  * \{
  */
 
+#if GSM_CFG_MAX_INSTANCES > 1
+extern GSM_CFG_THREAD_LOCAL gsm_t*  gsmi_inst;
+#define gsm                 (*gsmi_inst)
+#else
 extern gsm_t                gsm;
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
 
 extern gsm_dev_mem_map_t    gsm_dev_mem_map[];
 extern size_t               gsm_dev_mem_map_size;
@@ -679,15 +1196,23 @@ extern size_t               gsm_dev_mem_map_size;
 #define CRLF                "\r\n"
 #define CRLF_LEN            2
 
+#if GSM_CFG_CMD_EVT
+#define GSMI_MSG_TAKE_CMD_EVT(msg)              gsmi_msg_take_cmd_evt(msg)
+#else
+#define GSMI_MSG_TAKE_CMD_EVT(msg)
+#endif /* GSM_CFG_CMD_EVT */
+
 #define GSM_MSG_VAR_DEFINE(name)                gsm_msg_t* name
 #define GSM_MSG_VAR_ALLOC(name)                 do {\
-    (name) = gsm_mem_alloc(sizeof(*(name)));          \
+    (name) = gsm_mem_pool_alloc(GSM_MEM_POOL_MSG, GSM_MEM_TAG_MSG, sizeof(*(name)));   \
     GSM_DEBUGW(GSM_CFG_DBG_VAR | GSM_DBG_TYPE_TRACE, (name) != NULL, "MSG VAR: Allocated %d bytes at %p\r\n", sizeof(*(name)), (name)); \
     GSM_DEBUGW(GSM_CFG_DBG_VAR | GSM_DBG_TYPE_TRACE, (name) == NULL, "MSG VAR: Error allocating %d bytes\r\n", sizeof(*(name))); \
     if (!(name)) {                                  \
+        GSMI_MSG_TAKE_CMD_EVT(NULL);                \
         return gsmERRMEM;                           \
     }                                               \
     memset(name, 0x00, sizeof(*(name)));            \
+    GSMI_MSG_TAKE_CMD_EVT(name);                    \
 } while (0)
 #define GSM_MSG_VAR_REF(name)                   (*(name))
 #define GSM_MSG_VAR_FREE(name)                  do {\
@@ -702,27 +1227,70 @@ extern size_t               gsm_dev_mem_map_size;
 #define GSM_CHARHEXTONUM(x)                 (((x) >= '0' && (x) <= '9') ? ((x) - '0') : (((x) >= 'a' && (x) <= 'f') ? ((x) - 'a' + 10) : (((x) >= 'A' && (x) <= 'F') ? ((x) - 'A' + 10) : 0)))
 #define GSM_ISVALIDASCII(x)                 (((x) >= 32 && (x) <= 126) || (x) == '\r' || (x) == '\n')
 
-#define RECV_ADD(ch)                        do { recv_buff.data[recv_buff.len++] = ch; recv_buff.data[recv_buff.len] = 0; } while (0)
-#define RECV_RESET()                        do { recv_buff.len = 0; recv_buff.data[0] = 0; } while (0)
-#define RECV_LEN()                          recv_buff.len
-#define RECV_IDX(index)                     recv_buff.data[index]
+#define RECV_ADD(ch)                        do { if (gsm.recv_buff.len < (sizeof(gsm.recv_buff.data) - 1)) { gsm.recv_buff.data[gsm.recv_buff.len++] = ch; gsm.recv_buff.data[gsm.recv_buff.len] = 0; } } while (0)
+#define RECV_RESET()                        do { gsm.recv_buff.len = 0; gsm.recv_buff.data[0] = 0; gsm.recv_stream.checked = gsm.recv_stream.active = gsm.recv_stream.first = gsm.recv_stream.truncated = 0; } while (0)
+#define RECV_LINE_MAX                       (sizeof(gsm.recv_buff.data) - 1 - CRLF_LEN)
+#define RECV_LEN()                          gsm.recv_buff.len
+#define RECV_IDX(index)                     gsm.recv_buff.data[index]
 
-#define GSM_AT_PORT_SEND_BEGIN()            do { GSM_AT_PORT_SEND_STR("AT"); } while (0)
-#define GSM_AT_PORT_SEND_END()              do { GSM_AT_PORT_SEND_STR(CRLF); } while (0)
+#define GSM_AT_PORT_SEND_BEGIN()            do { gsmi_at_tx_flush(); GSM_AT_PORT_SEND_CONST_STR("AT"); } while (0)
+#define GSM_AT_PORT_SEND_END()              do { GSM_AT_PORT_SEND_CONST_STR(CRLF); gsmi_at_tx_flush(); } while (0)
 
-#define GSM_AT_PORT_SEND_STR(str)           gsm.ll.send_fn((const uint8_t *)(str), (uint16_t)strlen(str))
-#define GSM_AT_PORT_SEND_CHR(ch)            gsm.ll.send_fn((const uint8_t *)(ch), (uint16_t)1)
-#define GSM_AT_PORT_SEND(d, l)              gsm.ll.send_fn((const uint8_t *)(d), (uint16_t)(l))
+#define GSM_AT_PORT_SEND_STR(str)           gsmi_at_tx_add((str), strlen(str))
+#define GSM_AT_PORT_SEND_CONST_STR(str)     gsmi_at_tx_add((str), sizeof(str) - 1)
+#define GSM_AT_PORT_SEND_CHR(ch)            gsmi_at_tx_add((ch), 1)
+#define GSM_AT_PORT_SEND(d, l)              do { gsmi_at_tx_flush(); gsmi_ll_send((const uint8_t *)(d), (size_t)(l)); } while (0)
 
-#define GSM_AT_PORT_SEND_QUOTE_COND(q)      do { if ((q)) { GSM_AT_PORT_SEND_STR("\""); } } while (0)
-#define GSM_AT_PORT_SEND_COMMA_COND(c)      do { if ((c)) { GSM_AT_PORT_SEND_STR(","); } } while (0)
-#define GSM_AT_PORT_SEND_EQUAL_COND(e)      do { if ((e)) { GSM_AT_PORT_SEND_STR("="); } } while (0)
+#define GSM_AT_PORT_SEND_QUOTE_COND(q)      do { if ((q)) { GSM_AT_PORT_SEND_CONST_STR("\""); } } while (0)
+#define GSM_AT_PORT_SEND_COMMA_COND(c)      do { if ((c)) { GSM_AT_PORT_SEND_CONST_STR(","); } } while (0)
+#define GSM_AT_PORT_SEND_EQUAL_COND(e)      do { if ((e)) { GSM_AT_PORT_SEND_CONST_STR("="); } } while (0)
 
-#define GSM_AT_PORT_SEND_CTRL_Z()           GSM_AT_PORT_SEND_STR("\x1A")
-#define GSM_AT_PORT_SEND_ESC()              GSM_AT_PORT_SEND_STR("\x1B")
+#define GSM_AT_PORT_SEND_CTRL_Z()           do { GSM_AT_PORT_SEND_CONST_STR("\x1A"); gsmi_at_tx_flush(); } while (0)
+#define GSM_AT_PORT_SEND_ESC()              do { GSM_AT_PORT_SEND_CONST_STR("\x1B"); gsmi_at_tx_flush(); } while (0)
 
 #define GSM_PORT2NUM(port)                  ((uint32_t)(port))
 
+#if GSM_CFG_WARM_START
+#define GSM_WARM_HOLD_SEQ                   0x01    /* Warm start command sequence is running */
+#define GSM_WARM_HOLD_INIT                  0x02    /* Init finish event has not been sent yet */
+#endif /* GSM_CFG_WARM_START */
+
+#if GSM_SYS_THREAD_NOTIFY
+#define GSMI_PROCESS_WAKEUP()               gsm_sys_thread_notify(&gsm.thread_process)
+#else
+#define GSMI_PROCESS_WAKEUP()               gsm_sys_mbox_putnow(&gsm.mbox_process, NULL)
+#endif /* GSM_SYS_THREAD_NOTIFY */
+
+/* Input buffer uses power-of-two buffer functions when enabled, other buffers always use generic ones */
+#if GSM_CFG_BUFF_POW2
+#define GSMI_BUFF_FN(fn)                    fn ## _pow2
+#else
+#define GSMI_BUFF_FN(fn)                    fn
+#endif /* GSM_CFG_BUFF_POW2 */
+
+#if GSM_CFG_LOCK_DOMAINS
+
+/**
+ * \brief           Protect (count up) core state of device instance and parser
+ */
+#define GSM_CORE_PROTECT()                  gsm_sys_mutex_lock(&gsm.lock_core)
+
+/**
+ * \brief           Unprotect (count down) core state of device instance and parser
+ */
+#define GSM_CORE_UNPROTECT()                gsm_sys_mutex_unlock(&gsm.lock_core)
+
+#define GSM_EVT_PROTECT()                   gsm_sys_mutex_lock(&gsm.lock_evt)
+#define GSM_EVT_UNPROTECT()                 gsm_sys_mutex_unlock(&gsm.lock_evt)
+#define GSM_PRODUCER_PROTECT()              gsm_sys_mutex_lock(&gsm.lock_producer)
+#define GSM_PRODUCER_UNPROTECT()            gsm_sys_mutex_unlock(&gsm.lock_producer)
+#define GSM_CONN_TX_PROTECT(conn)           gsm_sys_mutex_lock(&(conn)->tx_lock)
+#define GSM_CONN_TX_UNPROTECT(conn)         gsm_sys_mutex_unlock(&(conn)->tx_lock)
+#define GSM_MEM_PROTECT()                   gsm_sys_protect()
+#define GSM_MEM_UNPROTECT()                 gsm_sys_unprotect()
+
+#else
+
 /**
  * \brief           Protect (count up) OS protection (mutex)
  */
@@ -733,26 +1301,123 @@ extern size_t               gsm_dev_mem_map_size;
  */
 #define GSM_CORE_UNPROTECT()                gsm_sys_unprotect()
 
+#define GSM_EVT_PROTECT()                   GSM_CORE_PROTECT()
+#define GSM_EVT_UNPROTECT()                 GSM_CORE_UNPROTECT()
+#define GSM_PRODUCER_PROTECT()              GSM_CORE_PROTECT()
+#define GSM_PRODUCER_UNPROTECT()            GSM_CORE_UNPROTECT()
+#define GSM_CONN_TX_PROTECT(conn)           GSM_CORE_PROTECT()
+#define GSM_CONN_TX_UNPROTECT(conn)         GSM_CORE_UNPROTECT()
+#define GSM_MEM_PROTECT()                   GSM_CORE_PROTECT()
+#define GSM_MEM_UNPROTECT()                 GSM_CORE_UNPROTECT()
+
+#endif /* GSM_CFG_LOCK_DOMAINS */
+
 const char * gsmi_dbg_msg_to_string(gsm_cmd_t cmd);
 gsmr_t      gsmi_process(const void* data, size_t len);
+gsmr_t      gsmi_process_at(const void* data, size_t len);
+void        gsmi_process_cmd_result(uint8_t is_ok, uint16_t is_error);
 gsmr_t      gsmi_process_buffer(void);
 gsmr_t      gsmi_initiate_cmd(gsm_msg_t* msg);
 uint8_t     gsmi_is_valid_conn_ptr(gsm_conn_p conn);
 gsmr_t      gsmi_send_cb(gsm_evt_type_t type);
 gsmr_t      gsmi_send_conn_cb(gsm_conn_t* conn, gsm_evt_fn cb);
+void        gsmi_evt_deferred_dispatch(gsm_evt_deferred_t* e);
 void        gsmi_conn_init(void);
 gsmr_t      gsmi_send_msg_to_producer_mbox(gsm_msg_t* msg, gsmr_t (*process_fn)(gsm_msg_t *), uint32_t block, uint32_t max_block_time);
-gsmr_t      gsmi_send_device_msg_to_producer_mbox(gsm_msg_t* msg, uint32_t block, uint32_t max_block_time);
+gsm_msg_t*  gsmi_get_msg_from_producer_lanes(void);
+void        gsmi_msg_coalesce_finish(gsm_msg_t* msg, gsmr_t res);
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+void        gsmi_cmd_stats_start(gsm_msg_t* msg);
+void        gsmi_cmd_stats_finish(gsm_msg_t* msg, gsmr_t res);
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
+#if GSM_CFG_CMD_EVT
+void        gsmi_msg_take_cmd_evt(gsm_msg_t* msg);
+void        gsmi_cmd_evt_swap(gsm_api_cmd_evt_fn* fn, void** arg);
+void        gsmi_msg_cmd_evt(gsm_msg_t* msg);
+#endif /* GSM_CFG_CMD_EVT */
 uint32_t    gsmi_get_from_mbox_with_timeout_checks(gsm_sys_mbox_t* b, void** m, uint32_t timeout);
 uint8_t     gsmi_conn_closed_process(uint8_t conn_num, uint8_t forced);
-void        gsmi_conn_start_timeout(gsm_conn_p conn);
+void        gsmi_conn_closed_all(void);
+void        gsmi_network_set_attached(uint8_t attached);
+void        gsmi_conn_poll_schedule(void);
+#if GSM_CFG_DNS_CACHE || __DOXYGEN__
+uint8_t     gsmi_dns_cache_get(const char* host, gsm_ip_t* ip);
+void        gsmi_dns_cache_put(const char* host, const gsm_ip_t* ip);
+void        gsmi_dns_cache_remove(const char* host);
+uint8_t     gsmi_dns_cache_is_cacheable(const char* host);
+void        gsmi_dns_cache_flush(void);
+#endif /* GSM_CFG_DNS_CACHE || __DOXYGEN__ */
+#if GSM_CFG_IPD_ZERO_COPY
+gsmr_t      gsmi_pbuf_copy_payload(gsm_pbuf_p pbuf);
+#endif /* GSM_CFG_IPD_ZERO_COPY */
+gsmr_t      gsmi_conn_sendv(gsm_conn_p conn, const gsm_iovec_t* iov, size_t iovcnt, size_t off, size_t btw, size_t* const bw, const uint32_t blocking);
+#if GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__
+gsmr_t      gsmi_conn_manual_tcp_try_read_data(gsm_conn_p conn);
+#endif /* GSM_CFG_CONN_MANUAL_TCP_RECEIVE || __DOXYGEN__ */
+
+#if GSM_CFG_CMUX || __DOXYGEN__
+gsmr_t      gsmi_cmux_process(const void* data, size_t len);
+void        gsmi_cmux_activate(void);
+gsmr_t      gsmi_cmux_open_close(uint8_t dlci, uint8_t open);
+#if GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__
+void        gsmi_cmux_select_channel(uint8_t transp);
+uint8_t     gsmi_cmux_transp_separate(void);
+uint8_t     gsmi_cmux_transp_rx(void);
+#endif /* GSM_CFG_CONN_TRANSPARENT || __DOXYGEN__ */
+#endif /* GSM_CFG_CMUX || __DOXYGEN__ */
 
 gsmr_t      gsmi_get_sim_info(uint32_t blocking);
+#if GSM_CFG_NETWORK_REATTACH || __DOXYGEN__
+gsmr_t      gsmi_network_reattach(void);
+#if GSM_CFG_CONN || __DOXYGEN__
+gsmr_t      gsmi_conn_resume(gsm_conn_p conn);
+#endif /* GSM_CFG_CONN || __DOXYGEN__ */
+#endif /* GSM_CFG_NETWORK_REATTACH || __DOXYGEN__ */
+#if GSM_CFG_WARM_START || __DOXYGEN__
+void        gsmi_warm_release(uint8_t step);
+#endif /* GSM_CFG_WARM_START || __DOXYGEN__ */
+void        gsmi_value_age_update(gsm_value_age_t* age);
+uint8_t     gsmi_value_age_is_fresh(const gsm_value_age_t* age, uint32_t max_age);
+
+#if GSM_CFG_HTTP || __DOXYGEN__
+size_t      gsmi_http_recv(const void* data, size_t len);
+uint8_t     gsmi_http_read_next(gsm_msg_t* msg);
+#endif /* GSM_CFG_HTTP || __DOXYGEN__ */
+
+#if GSM_CFG_FTP || __DOXYGEN__
+size_t      gsmi_ftp_recv(const void* data, size_t len);
+void        gsmi_ftp_chunk_start(gsm_msg_t* msg);
+void        gsmi_ftp_chunk_done(gsm_msg_t* msg, size_t len);
+void        gsmi_ftp_put_next(gsm_msg_t* msg);
+#endif /* GSM_CFG_FTP || __DOXYGEN__ */
+
+#if GSM_CFG_SLEEP || __DOXYGEN__
+uint32_t    gsmi_sleep_idle_time(void);
+void        gsmi_sleep_enter(void);
+void        gsmi_sleep_wake(void);
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
+
+#if GSM_CFG_AT_CAPTURE || __DOXYGEN__
+void        gsmi_capture(gsm_capture_dir_t dir, const void* data, size_t len);
+#endif /* GSM_CFG_AT_CAPTURE || __DOXYGEN__ */
+
+#if GSM_CFG_PING || __DOXYGEN__
+void        gsmi_ping_add(gsm_msg_t* msg, uint32_t rtt, uint8_t lost);
+void        gsmi_ping_finish(gsm_msg_t* msg, uint8_t is_ok);
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
+
+#if GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__
+void        gsmi_pb_cache_loaded(gsm_msg_t* msg, uint8_t is_ok);
+void        gsmi_pb_cache_write(gsm_msg_t* msg);
+#endif /* GSM_CFG_PHONEBOOK_CACHE || __DOXYGEN__ */
 
 /* Send functions */
-void        byte_to_str(uint8_t num, char* str);
-void        number_to_str(uint32_t num, char* str);
-void        signed_number_to_str(int32_t num, char* str);
+size_t      byte_to_str(uint8_t num, char* str);
+size_t      number_to_str(uint32_t num, char* str);
+size_t      signed_number_to_str(int32_t num, char* str);
+void        gsmi_at_tx_add(const void* data, size_t len);
+void        gsmi_at_tx_flush(void);
+size_t      gsmi_ll_send(const void* data, size_t len);
 void        send_ip_mac(const void* d, uint8_t is_ip, uint8_t q, uint8_t c);
 void        send_string(const char* str, uint8_t e, uint8_t q, uint8_t c);
 void        send_number(uint32_t num, uint8_t q, uint8_t c);
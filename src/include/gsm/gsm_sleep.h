@@ -0,0 +1,69 @@
+/**	
+ * \file            gsm_sleep.h
+ * \brief           Sleep and power saving API
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_SLEEP_H
+#define __GSM_SLEEP_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM
+ * \defgroup        GSM_SLEEP Sleep API
+ * \brief           Sleep and power saving manager
+ *
+ * Device is put to sleep by stack when no command is sent for configured idle time.
+ * Before next command, device is woken up by \ref gsm_ll_t.wake_fn or wakeup preamble,
+ * so application never drives DTR line or sends `AT+CSCLK` itself.
+ *
+ * \{
+ */
+
+gsmr_t      gsm_sleep_enable(uint32_t idle_time, uint32_t blocking);
+gsmr_t      gsm_sleep_disable(uint32_t blocking);
+gsmr_t      gsm_sleep_set_psm(uint8_t en, uint32_t tau, uint32_t active_time, uint32_t blocking);
+gsmr_t      gsm_sleep_set_edrx(uint8_t en, uint8_t act, uint8_t cycle, uint32_t blocking);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSM_SLEEP_H */
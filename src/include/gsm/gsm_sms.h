@@ -51,9 +51,14 @@ gsmr_t      gsm_sms_enable(uint32_t blocking);
 gsmr_t      gsm_sms_disable(uint32_t blocking);
 
 gsmr_t      gsm_sms_send(const char* num, const char* text, uint32_t blocking);
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+gsmr_t      gsm_sms_send_batch(gsm_sms_recipient_t* rcpts, size_t count, const char* text, gsm_sms_enc_t enc, uint32_t blocking);
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
 gsmr_t      gsm_sms_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update, uint32_t blocking);
 gsmr_t      gsm_sms_delete(gsm_mem_t mem, size_t pos, uint32_t blocking);
+gsmr_t      gsm_sms_delete_all(gsm_mem_t mem, gsm_sms_status_t stat, uint32_t blocking);
 gsmr_t      gsm_sms_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, size_t etr, size_t* er, uint8_t update, uint32_t blocking);
+gsmr_t      gsm_sms_list_stream(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entry, gsm_sms_list_fn fn, void* arg, uint8_t update, uint32_t blocking);
 gsmr_t      gsm_sms_set_preferred_storage(gsm_mem_t mem1, gsm_mem_t mem2, gsm_mem_t mem3, uint32_t blocking);
 
 /**
@@ -0,0 +1,69 @@
+/**	
+ * \file            gsm_sms_pdu.h
+ * \brief           SMS PDU mode encoder
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_SMS_PDU_H
+#define __GSM_SMS_PDU_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM_SMS
+ * \defgroup        GSM_SMS_PDU PDU encoder
+ * \brief           SMS-SUBMIT PDU encoder with concatenated messages
+ * \{
+ */
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+gsm_sms_enc_t   gsmi_sms_pdu_encoding(const char* text, size_t len);
+size_t          gsmi_sms_pdu_part(const char* text, size_t len, size_t start, gsm_sms_enc_t enc, uint8_t concat, size_t* units);
+size_t          gsmi_sms_pdu_parts(const char* text, size_t len, gsm_sms_enc_t enc);
+size_t          gsmi_sms_pdu_tpdu_len(const char* num, gsm_sms_enc_t enc, size_t units, uint8_t concat);
+void            gsmi_sms_pdu_send(const char* num, const char* text, size_t start, size_t end, gsm_sms_enc_t enc, size_t units, uint8_t ref, uint8_t total, uint8_t seq);
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSM_SMS_PDU_H */
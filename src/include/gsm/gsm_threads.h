@@ -41,6 +41,9 @@ extern "C" {
 
 void    gsm_thread_producer(void* const arg);
 void    gsm_thread_process(void* const arg);
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+void    gsm_thread_evt(void* const arg);
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
 
 #ifdef __cplusplus
 }
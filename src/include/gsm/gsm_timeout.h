@@ -47,6 +47,8 @@ extern "C" {
  * \{
  */
 
+gsmr_t          gsm_timeout_start(uint32_t time, gsm_timeout_fn fn, void* arg, gsm_timeout_id_t* id);
+gsmr_t          gsm_timeout_stop(gsm_timeout_id_t id);
 gsmr_t          gsm_timeout_add(uint32_t time, gsm_timeout_fn fn, void* arg);
 gsmr_t          gsm_timeout_remove(gsm_timeout_fn fn);
     
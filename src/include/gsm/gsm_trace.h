@@ -0,0 +1,117 @@
+/**
+ * \file            gsm_trace.h
+ * \brief           Binary trace ring for debug messages
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#ifndef __GSM_TRACE_H
+#define __GSM_TRACE_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stdint.h"
+#include "stddef.h"
+
+/**
+ * \ingroup         GSM_DEBUG
+ * \defgroup        GSM_TRACE Trace ring
+ * \brief           Deferred formatting of debug messages
+ *
+ * When \ref GSM_CFG_DBG_TRACE is enabled, \ref GSM_DEBUGF writes compact binary record
+ * to RAM ring instead of calling \ref GSM_CFG_DBG_OUT. Record keeps pointer to format string,
+ * timestamp and integer arguments. Writers from any thread or interrupt never block,
+ * oldest records are overwritten when ring is full.
+ *
+ * Records are formatted later by single reader, with \ref gsm_trace_drain
+ * called from low priority thread, or copied out with \ref gsm_trace_read.
+ *
+ * \note            String arguments are recorded by address only
+ *                  and are formatted as pointers, as string may not exist anymore at formatting time
+ * \{
+ */
+
+/**
+ * \brief           Maximal number of arguments kept in single record, next arguments are ignored
+ */
+#define GSM_TRACE_ARGS_MAX          4
+
+/**
+ * \brief           Single trace record
+ */
+typedef struct {
+    uint32_t seq;                               /*!< Sequence number of record, increases by `1` for each record */
+    uint32_t time;                              /*!< Time of record in units of milliseconds */
+    const char* fmt;                            /*!< Format string, identifies record type */
+    uint8_t type;                               /*!< Debug type and level flags of record */
+    uint8_t argc;                               /*!< Number of valid entries in `args` */
+    uintptr_t args[GSM_TRACE_ARGS_MAX];         /*!< Integer and pointer arguments */
+} gsm_trace_rec_t;
+
+void        gsm_trace_write(uint8_t type, const char* fmt, size_t argc, const uintptr_t* argv);
+uint8_t     gsm_trace_read(gsm_trace_rec_t* rec);
+size_t      gsm_trace_format(const gsm_trace_rec_t* rec, char* out, size_t out_len);
+size_t      gsm_trace_drain(size_t max);
+uint32_t    gsm_trace_get_lost(void);
+
+/**
+ * \}
+ */
+
+#if !__DOXYGEN__
+
+/* Number of variadic macro arguments, up to 8 */
+#define GSM_TRACE_NARGS(...)        GSM_TRACE_NARGS_(0, ## __VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define GSM_TRACE_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...)    n
+
+/* Array of variadic macro arguments converted to integers */
+#define GSM_TRACE_ARGV(...)         ((const uintptr_t []){ 0 GSM_TRACE_CAT(GSM_TRACE_CAST_, GSM_TRACE_NARGS(__VA_ARGS__))(__VA_ARGS__) } + 1)
+#define GSM_TRACE_CAT(a, b)         GSM_TRACE_CAT_(a, b)
+#define GSM_TRACE_CAT_(a, b)        a ## b
+#define GSM_TRACE_CAST_0()
+#define GSM_TRACE_CAST_1(a)         , (uintptr_t)(a)
+#define GSM_TRACE_CAST_2(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_1(__VA_ARGS__)
+#define GSM_TRACE_CAST_3(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_2(__VA_ARGS__)
+#define GSM_TRACE_CAST_4(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_3(__VA_ARGS__)
+#define GSM_TRACE_CAST_5(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_4(__VA_ARGS__)
+#define GSM_TRACE_CAST_6(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_5(__VA_ARGS__)
+#define GSM_TRACE_CAST_7(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_6(__VA_ARGS__)
+#define GSM_TRACE_CAST_8(a, ...)    , (uintptr_t)(a) GSM_TRACE_CAST_7(__VA_ARGS__)
+
+#endif /* !__DOXYGEN__ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSM_TRACE_H */
@@ -53,6 +53,15 @@ extern "C" {
  * \}
  */
 
+struct gsm_instance;
+
+/**
+ * \ingroup         GSM_TYPEDEFS
+ * \brief           Handle of GSM device instance
+ * \sa              GSM_CFG_MAX_INSTANCES
+ */
+typedef struct gsm_instance* gsm_instance_p;
+
 /**
  * \ingroup         GSM_TYPEDEFS
  * \brief           Result enumeration used across application functions
@@ -135,6 +144,9 @@ typedef struct {
 typedef enum {
     GSM_CONN_TYPE_TCP,                          /*!< Connection type is TCP */
     GSM_CONN_TYPE_UDP,                          /*!< Connection type is UDP */
+#if GSM_CFG_CONN_SSL || __DOXYGEN__
+    GSM_CONN_TYPE_SSL,                          /*!< Connection type is TCP with TLS handled by device */
+#endif /* GSM_CFG_CONN_SSL || __DOXYGEN__ */
 } gsm_conn_type_t;
 
 /**
@@ -183,6 +195,47 @@ typedef struct {
     size_t length;                              /*!< Length of SMS data */
 } gsm_sms_entry_t;
 
+/**
+ * \ingroup         GSM_SMS
+ * \brief           Actions returned by SMS list callback function
+ */
+typedef enum {
+    GSM_SMS_LIST_CONTINUE = 0x00,               /*!< Continue with next entry */
+    GSM_SMS_LIST_STOP = 0x01,                   /*!< Stop listing, remaining entries are ignored */
+    GSM_SMS_LIST_DELETE = 0x02,                 /*!< Delete entry after list is finished. Can be combined with \ref GSM_SMS_LIST_STOP */
+} gsm_sms_list_action_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS list callback function, called for every listed entry
+ * \note            Function is called from processing thread with core locked
+ *                  and must not call blocking functions
+ * \param[in]       entry: Parsed SMS entry. Entry memory is reused for next entry
+ * \param[in]       arg: User argument
+ * \return          Bitwise OR of \ref gsm_sms_list_action_t values
+ */
+typedef uint8_t     (*gsm_sms_list_fn)(const gsm_sms_entry_t* entry, void* arg);
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS text encoding in PDU mode
+ */
+typedef enum {
+    GSM_SMS_ENC_AUTO = 0x00,                    /*!< GSM 7-bit if all characters are in default alphabet, UCS2 otherwise */
+    GSM_SMS_ENC_GSM7,                           /*!< GSM 7-bit default alphabet. Unsupported characters are replaced with `?` */
+    GSM_SMS_ENC_UCS2,                           /*!< UCS2 encoding */
+} gsm_sms_enc_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           Recipient entry for batch SMS send
+ */
+typedef struct {
+    const char* num;                            /*!< Recipient phone number */
+    gsmr_t res;                                 /*!< Send result, set by stack */
+    size_t pos;                                 /*!< Message reference of last sent part. Valid when `res == gsmOK` */
+} gsm_sms_recipient_t;
+
 /**
  * \ingroup         GSM_PB
  * \brief           Phonebook entry structure
@@ -333,6 +386,16 @@ typedef struct gsm_conn* gsm_conn_p;
  */
 typedef struct gsm_pbuf* gsm_pbuf_p;
 
+/**
+ * \ingroup         GSM_PBUF
+ * \brief           Packet buffer segment callback, called for every linear memory part of pbuf chain
+ * \param[in]       data: Pointer to segment memory
+ * \param[in]       len: Length of segment memory in units of bytes
+ * \param[in]       arg: User argument
+ * \return          `1` to continue with next segment, `0` to stop iteration
+ */
+typedef uint8_t     (*gsm_pbuf_segment_fn)(const void* data, size_t len, void* arg);
+
 /**
  * \ingroup         GSM_EVT
  * \brief           Event function prototype
@@ -341,6 +404,54 @@ typedef struct gsm_pbuf* gsm_pbuf_p;
  */
 typedef gsmr_t  (*gsm_evt_fn)(struct gsm_evt* evt);
 
+/**
+ * \ingroup         GSM
+ * \brief           Command completion callback prototype
+ * \note            Function is called from producer thread and must not block
+ * \param[in]       res: Command result
+ * \param[in]       arg: Custom user argument set with \ref gsm_set_cmd_evt
+ * \sa              GSM_CFG_CMD_EVT
+ */
+typedef void    (*gsm_api_cmd_evt_fn)(gsmr_t res, void* arg);
+
+/**
+ * \ingroup         GSM_EVT
+ * \brief           Bit mask of event types, one bit for each member of \ref gsm_evt_type_t
+ */
+typedef uint64_t gsm_evt_mask_t;
+
+/**
+ * \ingroup         GSM_EVT
+ * \brief           Get mask bit for event type
+ * \param[in]       type: Event type. Member of \ref gsm_evt_type_t enumeration
+ */
+#define GSM_EVT_MASK(type)                      ((gsm_evt_mask_t)1 << (type))
+
+/**
+ * \ingroup         GSM_EVT
+ * \brief           Mask with all event types enabled
+ */
+#define GSM_EVT_MASK_ALL                        ((gsm_evt_mask_t)-1)
+
+/**
+ * \ingroup         GSM_PING
+ * \brief           Ping statistics
+ *
+ *                  All times are in units of milliseconds and are calculated from received replies only.
+ *                  Jitter is mean absolute difference between round-trip times of consecutive replies
+ */
+typedef struct {
+    uint16_t sent;                              /*!< Number of sent probes */
+    uint16_t received;                          /*!< Number of received replies */
+    uint32_t min;                               /*!< Minimal round-trip time */
+    uint32_t avg;                               /*!< Average round-trip time */
+    uint32_t max;                               /*!< Maximal round-trip time */
+    uint32_t jitter;                            /*!< Round-trip time jitter */
+    uint16_t hist[GSM_CFG_PING_HIST_BUCKETS];   /*!< Round-trip time histogram, bucket `i` counts replies
+                                                    from `i * GSM_CFG_PING_HIST_BUCKET_MS` milliseconds on.
+                                                    Last bucket counts all longer replies */
+} gsm_ping_stats_t;
+
 /**
  * \ingroup         GSM_EVT
  * \brief           List of possible callback types received to user
@@ -351,12 +462,14 @@ typedef enum gsm_cb_type_t {
 
     GSM_EVT_DEVICE_PRESENT,                     /*!< Notification when device present status changes */
     GSM_EVT_DEVICE_IDENTIFIED,                  /*!< Device identified event */
+    GSM_EVT_AT_BAUDRATE,                        /*!< AT port baudrate change finished */
 
     GSM_EVT_INIT_FINISH,                        /*!< Initialization has been finished at this point */
 
     GSM_EVT_SIGNAL_STRENGTH,                    /*!< Signal strength event */
 
     GSM_EVT_NETWORK_OPERATOR_CURRENT,           /*!< Current operator event */
+    GSM_EVT_NETWORK_OPERATOR_SCAN,              /*!< Operator found during operator scan */
     GSM_EVT_NETWORK_REG,                        /*!< Network registration changed. Available even when \ref GSM_CFG_NETWORK is disabled */
 #if GSM_CFG_NETWORK || __DOXYGEN__
     GSM_EVT_NETWORK_ATTACHED,                   /*!< Attached to network, PDP context active and ready for TCP/IP application */
@@ -369,7 +482,7 @@ typedef enum gsm_cb_type_t {
     GSM_EVT_CONN_ACTIVE,                        /*!< Connection just became active */
     GSM_EVT_CONN_ERROR,                         /*!< Client connection start was not successful */
     GSM_EVT_CONN_CLOSED,                        /*!< Connection was just closed */
-    GSM_EVT_CONN_POLL,                          /*!< Poll for connection if there are any changes */
+    GSM_EVT_CONN_POLL,                          /*!< Poll for connection, enabled with \ref gsm_conn_set_poll_interval */
 #endif /* GSM_CFG_CONN || __DOXYGEN__ */
 
     GSM_EVT_CPIN,                               /*!< SIM event */
@@ -380,6 +493,9 @@ typedef enum gsm_cb_type_t {
     GSM_EVT_SMS_RECV,                           /*!< SMS received */
     GSM_EVT_SMS_READ,                           /*!< SMS read */
     GSM_EVT_SMS_LIST,                           /*!< SMS list */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+    GSM_EVT_SMS_SEND_BATCH,                     /*!< Batch SMS send finished */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
 #endif /* GSM_CFG_SMS || __DOXYGEN__ */
 #if GSM_CFG_CALL || __DOXYGEN__
     GSM_EVT_CALL_ENABLE,                        /*!< Call enable event */
@@ -394,6 +510,9 @@ typedef enum gsm_cb_type_t {
     GSM_EVT_PB_LIST,                            /*!< Phonebook list event */
     GSM_EVT_PB_SEARCH,                          /*!< Phonebook search event */
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
+#if GSM_CFG_PING || __DOXYGEN__
+    GSM_EVT_LINK_QUALITY,                       /*!< Background link quality probe finished */
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
 } gsm_evt_type_t;
 
 /**
@@ -406,6 +525,10 @@ typedef struct gsm_evt {
         struct {
             uint8_t forced;                     /*!< Set to `1` if reset forced by user */
         } reset;                                /*!< Reset occurred. Use with \ref GSM_EVT_RESET event */
+        struct {
+            uint32_t baudrate;                  /*!< Baudrate used on AT port after change */
+            gsmr_t res;                         /*!< Result of baudrate change */
+        } at_baudrate;                          /*!< AT port baudrate changed. Use with \ref GSM_EVT_AT_BAUDRATE event */
 
         struct {
             gsm_sim_state_t state;              /*!< SIM state */
@@ -413,6 +536,10 @@ typedef struct gsm_evt {
         struct {
             const gsm_operator_curr_t* operator_current;    /*!< Current operator info */
         } operator_current;                     /*!< Current operator event. Use with \ref GSM_EVT_NETWORK_OPERATOR_CURRENT event */
+        struct {
+            const gsm_operator_t* op;           /*!< Found operator */
+            size_t index;                       /*!< Index of operator in scan result */
+        } operator_scan;                        /*!< Operator found during scan. Use with \ref GSM_EVT_NETWORK_OPERATOR_SCAN event */
 
         struct {
             int16_t rssi;                       /*!< Strength in units of dBm */
@@ -425,7 +552,7 @@ typedef struct gsm_evt {
         } conn_data_recv;                       /*!< Network data received. Use with \ref GSM_EVT_CONN_DATA_RECV event */
         struct {
             gsm_conn_p conn;                    /*!< Connection where data were sent */
-            size_t sent;                        /*!< Number of bytes sent on connection */
+            size_t sent;                        /*!< Number of bytes sent on connection */
             gsmr_t res;                         /*!< Send data result */
         } conn_data_send;                       /*!< Data successfully sent. Use with \ref GSM_EVT_CONN_DATA_SEND event */
         struct {
@@ -466,6 +593,13 @@ typedef struct gsm_evt {
             size_t size;                        /*!< Number of valid entries */
             gsmr_t err;                         /*!< Error message if exists */
         } sms_list;                             /*!< SMS list. Use with \ref GSM_EVT_SMS_LIST event */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+        struct {
+            gsm_sms_recipient_t* rcpts;         /*!< Recipients with results */
+            size_t count;                       /*!< Number of recipients */
+            size_t sent;                        /*!< Number of recipients with successful send */
+        } sms_send_batch;                       /*!< Batch SMS send result. Use with \ref GSM_EVT_SMS_SEND_BATCH event */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
 #endif /* GSM_CFG_SMS || __DOXYGEN__ */
 #if GSM_CFG_CALL || __DOXYGEN__
         struct {
@@ -493,6 +627,13 @@ typedef struct gsm_evt {
             gsmr_t err;                         /*!< Error message if exists */
         } pb_search;                            /*!< Phonebok search list. Use with \ref GSM_EVT_PB_SEARCH event */
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
+#if GSM_CFG_PING || __DOXYGEN__
+        struct {
+            const char* host;                   /*!< Probed host */
+            const gsm_ping_stats_t* stats;      /*!< Probe statistics */
+            gsmr_t res;                         /*!< Probe result */
+        } link_quality;                         /*!< Link quality probe result. Use with \ref GSM_EVT_LINK_QUALITY event */
+#endif /* GSM_CFG_PING || __DOXYGEN__ */
     } evt;                                      /*!< Callback event union */
 } gsm_evt_t;
 
@@ -507,17 +648,229 @@ typedef struct gsm_evt {
  */
 typedef size_t  (*gsm_ll_send_fn)(const void* data, size_t len);
 
+/**
+ * \ingroup         GSM_LL
+ * \brief           Function prototype to pause or resume reception on AT port, usually by driving RTS line
+ * \param[in]       resume: Set to `1` when device may send data again, `0` to pause it
+ */
+typedef void    (*gsm_ll_rx_flow_fn)(uint8_t resume);
+
+/**
+ * \ingroup         GSM_LL
+ * \brief           Function prototype to check if device is ready to accept data, usually by reading CTS line
+ * \return          `1` if ready, `0` otherwise
+ */
+typedef uint8_t (*gsm_ll_tx_ready_fn)(void);
+
+/**
+ * \ingroup         GSM_CMUX
+ * \brief           Function prototype for data received on multiplexer channel
+ * \param[in]       dlci: Channel number data were received on
+ * \param[in]       data: Received data
+ * \param[in]       len: Number of bytes received
+ * \param[in]       arg: Custom argument set when channel was opened
+ */
+typedef void    (*gsm_cmux_recv_fn)(uint8_t dlci, const void* data, size_t len, void* arg);
+
+/**
+ * \ingroup         GSM_CAPTURE
+ * \brief           Direction of captured AT port data
+ */
+typedef enum {
+    GSM_CAPTURE_DIR_TX = 'T',                   /*!< Data sent from stack to device */
+    GSM_CAPTURE_DIR_RX = 'R',                   /*!< Data received from device */
+} gsm_capture_dir_t;
+
+/**
+ * \ingroup         GSM_CAPTURE
+ * \brief           Function prototype for captured AT port data
+ *
+ * \note            Function is called from thread which sends or receives data,
+ *                  also from interrupt context when low-level driver calls \ref gsm_input from it
+ *
+ * \param[in]       dir: Direction of data
+ * \param[in]       time: Time since capture start in units of milliseconds
+ * \param[in]       data: Captured data
+ * \param[in]       len: Number of captured bytes
+ * \param[in]       arg: Custom argument passed to \ref gsm_capture_start
+ */
+typedef void    (*gsm_capture_fn)(gsm_capture_dir_t dir, uint32_t time, const void* data, size_t len, void* arg);
+
+/**
+ * \ingroup         GSM_HTTP
+ * \brief           Function prototype for received HTTP response body data
+ *
+ * \note            Packet buffer is freed after function returns.
+ *                  Use \ref gsm_pbuf_ref to keep it for processing in another thread
+ *
+ * \param[in]       pbuf: Packet buffer with next part of response body
+ * \param[in]       offset: Offset of first byte in packet buffer from beginning of body
+ * \param[in]       arg: Custom argument passed to \ref gsm_http_get
+ * \return          \ref gsmOK to continue download, \ref gsmOKIGNOREMORE to stop
+ *                  with success or any other member of \ref gsmr_t to stop with error
+ */
+typedef gsmr_t  (*gsm_http_sink_fn)(gsm_pbuf_p pbuf, size_t offset, void* arg);
+
+/**
+ * \ingroup         GSM_FTP
+ * \brief           FTP server login information
+ */
+typedef struct {
+    const char* host;                           /*!< Server host name or IP address */
+    gsm_port_t port;                            /*!< Server port, `0` for default port `21` */
+    const char* user;                           /*!< User name */
+    const char* pass;                           /*!< User password */
+} gsm_ftp_server_t;
+
+/**
+ * \ingroup         GSM_FTP
+ * \brief           FTP transfer statistics
+ *
+ *                  Throughput in bytes per second is `bytes * 1000 / time`,
+ *                  average chunk latency is `chunk_time_total / chunks`
+ */
+typedef struct {
+    size_t bytes;                               /*!< Number of transferred bytes */
+    uint32_t chunks;                            /*!< Number of transferred chunks */
+    uint32_t time;                              /*!< Transfer time in units of milliseconds */
+    uint32_t chunk_time_total;                  /*!< Sum of all chunk times in units of milliseconds */
+    uint32_t chunk_time_max;                    /*!< Longest chunk time in units of milliseconds */
+} gsm_ftp_stats_t;
+
+/**
+ * \ingroup         GSM_FTP
+ * \brief           Function prototype for received FTP file data
+ *
+ * \note            Packet buffer is freed after function returns.
+ *                  Use \ref gsm_pbuf_ref to keep it for processing in another thread
+ *
+ * \param[in]       pbuf: Packet buffer with next part of file
+ * \param[in]       offset: Offset of first byte in packet buffer from beginning of file
+ * \param[in]       arg: Custom argument passed to \ref gsm_ftp_get
+ * \return          \ref gsmOK to continue download, \ref gsmOKIGNOREMORE to stop
+ *                  with success or any other member of \ref gsmr_t to stop with error
+ */
+typedef gsmr_t  (*gsm_ftp_sink_fn)(gsm_pbuf_p pbuf, size_t offset, void* arg);
+
+/**
+ * \ingroup         GSM_FTP
+ * \brief           Function prototype to provide next chunk of FTP file to upload
+ *
+ * \param[out]      data: Pointer to output pointer to chunk data.
+ *                      Data must stay valid until function is called again or upload finishes
+ * \param[in]       max_len: Maximal chunk length accepted by device
+ * \param[in]       offset: Offset of requested chunk from beginning of file
+ * \param[in]       arg: Custom argument passed to \ref gsm_ftp_put
+ * \return          Chunk length, up to `max_len` bytes. Return `0` at end of file
+ */
+typedef size_t  (*gsm_ftp_source_fn)(const void** data, size_t max_len, size_t offset, void* arg);
+
+/**
+ * \ingroup         GSM_LL
+ * \brief           Function prototype to allow device to sleep or wake it up, usually by driving DTR line
+ * \param[in]       wake: Set to `1` to wake up device, `0` to allow it to enter sleep mode
+ */
+typedef void    (*gsm_ll_wake_fn)(uint8_t wake);
+
 /**
  * \ingroup         GSM_LL
  * \brief           Low level user specific functions
  */
 typedef struct {
     gsm_ll_send_fn send_fn;                     /*!< Callback function to transmit data */
+#if GSM_CFG_AT_PORT_FLOW_CONTROL || __DOXYGEN__
+    gsm_ll_rx_flow_fn rx_flow_fn;               /*!< Optional callback to pause or resume reception */
+    gsm_ll_tx_ready_fn tx_ready_fn;             /*!< Optional callback to check if device accepts data */
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL || __DOXYGEN__ */
+#if GSM_CFG_SLEEP || __DOXYGEN__
+    gsm_ll_wake_fn wake_fn;                     /*!< Optional callback to drive DTR line for sleep mode */
+#endif /* GSM_CFG_SLEEP || __DOXYGEN__ */
     struct {
         uint32_t baudrate;                      /*!< UART baudrate value */
     } uart;                                     /*!< UART communication parameters */
 } gsm_ll_t;
 
+/**
+ * \ingroup         GSM
+ * \brief           Priority lanes of producer message queue
+ *
+ *                  Lanes are served in strict order, lower value first.
+ *                  Messages in the same lane are processed in FIFO order.
+ *
+ * \note            Messages of different lanes are not ordered between each other.
+ *                  Reset and call control overtake all messages queued before them,
+ *                  operator scan is executed after messages queued after it
+ */
+typedef enum {
+    GSM_MSG_PRIO_URGENT = 0x00,                 /*!< Device reset and call control */
+    GSM_MSG_PRIO_DATA,                          /*!< Connection data and all other commands */
+    GSM_MSG_PRIO_BACKGROUND,                    /*!< Long running operator scan */
+    GSM_MSG_PRIO_END,                           /*!< Last entry, number of lanes */
+} gsm_msg_prio_t;
+
+/**
+ * \ingroup         GSM
+ * \brief           Statistics of single producer queue lane
+ */
+typedef struct {
+    size_t depth;                               /*!< Number of messages currently waiting in lane */
+    size_t max_depth;                           /*!< Maximal number of messages ever waiting in lane */
+    uint32_t count;                             /*!< Number of messages taken from lane for processing */
+    uint32_t wait_max;                          /*!< Maximal time message spent in lane, in units of milliseconds */
+    uint32_t wait_total;                        /*!< Total time all messages spent in lane, in units of milliseconds */
+    uint32_t dropped;                           /*!< Number of non-blocking messages dropped because lane was full */
+} gsm_msg_lane_stats_t;
+
+#if GSM_CFG_CMD_STATS || __DOXYGEN__
+
+/**
+ * \ingroup         GSM
+ * \brief           Latency histogram of single command phase
+ *
+ *                  Bucket `0` counts times shorter than \ref GSM_CFG_CMD_STATS_BUCKET_MS,
+ *                  bucket `i` counts times from `GSM_CFG_CMD_STATS_BUCKET_MS << (i - 1)` milliseconds on.
+ *                  Last bucket counts all longer times
+ */
+typedef struct {
+    uint32_t bucket[GSM_CFG_CMD_STATS_BUCKETS]; /*!< Number of commands in each bucket */
+    uint32_t max;                               /*!< Maximal time in units of milliseconds */
+} gsm_cmd_hist_t;
+
+/**
+ * \ingroup         GSM
+ * \brief           Latency statistics of single API command
+ */
+typedef struct {
+    uint16_t cmd;                               /*!< Internal ID of first command sent by API function */
+    uint32_t count;                             /*!< Number of completed commands */
+    uint32_t timeouts;                          /*!< Number of commands completed with \ref gsmTIMEOUT */
+    uint32_t errors;                            /*!< Number of commands completed with any other error */
+    gsm_cmd_hist_t queue;                       /*!< Time from producer queue write to dispatch in producer thread */
+    gsm_cmd_hist_t sync;                        /*!< Time from dispatch to start, waiting for previous command to finish */
+    gsm_cmd_hist_t response;                    /*!< Time from start to first received byte, commands with response only */
+    gsm_cmd_hist_t total;                       /*!< Time from producer queue write to completion */
+} gsm_cmd_stats_t;
+
+#endif /* GSM_CFG_CMD_STATS || __DOXYGEN__ */
+
+/**
+ * \ingroup         GSM
+ * \brief           Device state for warm start
+ *
+ *                  Structure is filled with \ref gsm_warm_state_get,
+ *                  kept by application in retained or non-volatile memory
+ *                  and passed to \ref gsm_init_warm on next startup
+ */
+typedef struct {
+    uint32_t magic;                             /*!< Structure identification and version */
+    uint32_t cfg;                               /*!< Library configuration the state was saved with */
+    uint32_t baudrate;                          /*!< AT port baudrate */
+    char model_manufacturer[20];                /*!< Device manufacturer */
+    char model_number[20];                      /*!< Device model number */
+    char model_serial_number[20];               /*!< Device serial number */
+    uint32_t check;                             /*!< Checksum of all previous fields */
+} gsm_warm_state_t;
+
 /**
  * \ingroup         GSM_TIMEOUT
  * \brief           Timeout callback function prototype
@@ -525,15 +878,23 @@ typedef struct {
  */
 typedef void (*gsm_timeout_fn)(void * arg);
 
+/**
+ * \ingroup         GSM_TIMEOUT
+ * \brief           Timeout identifier, used to stop specific timeout
+ * \note            Value `0` is never used for valid timeout
+ */
+typedef uint32_t gsm_timeout_id_t;
+
 /**
  * \ingroup         GSM_TIMEOUT
  * \brief           Timeout structure
  */
 typedef struct gsm_timeout {
-    struct gsm_timeout* next;                   /*!< Pointer to next timeout entry */
-    uint32_t time;                              /*!< Time difference from previous entry */
+    uint32_t time;                              /*!< Absolute time when timeout expires */
     void* arg;                                  /*!< Argument to pass to callback function */
     gsm_timeout_fn fn;                          /*!< Callback function for timeout */
+    uint32_t seq;                               /*!< Sequence number, part of timeout ID */
+    uint8_t heap_idx;                           /*!< Position in heap of active timeouts */
 } gsm_timeout_t;
 
 /**
@@ -542,12 +903,56 @@ typedef struct gsm_timeout {
  */
 typedef struct {
     size_t size;                                /*!< Size of buffer in units of bytes */
-    size_t in;                                  /*!< Input pointer to save next value */
-    size_t out;                                 /*!< Output pointer to read next value */
+    volatile size_t in;                         /*!< Input pointer to save next value, modified by writer only.
+                                                    Runs freely in power-of-two mode */
+    volatile size_t out;                        /*!< Output pointer to read next value, modified by reader only.
+                                                    Runs freely in power-of-two mode */
     uint8_t* buff;                              /*!< Pointer to buffer data array */
     uint8_t flags;                              /*!< Flags for buffer */
 } gsm_buff_t;
 
+/**
+ * \ingroup         GSM_TYPEDEFS
+ * \brief           Data vector entry for scatter-gather send
+ */
+typedef struct {
+    const void* data;                           /*!< Pointer to data */
+    size_t len;                                 /*!< Length of data in units of bytes */
+} gsm_iovec_t;
+
+/**
+ * \ingroup         GSM_TYPEDEFS
+ * \brief           Datagram entry for batched UDP send
+ */
+typedef struct {
+    const gsm_ip_t* ip;                         /*!< Remote IP address, set to `NULL` to use connection remote */
+    gsm_port_t port;                            /*!< Remote port number, set to `0` to use connection remote */
+    const void* data;                           /*!< Pointer to datagram data */
+    size_t len;                                 /*!< Length of datagram in units of bytes */
+} gsm_dgram_t;
+
+/**
+ * \ingroup         GSM_CONN
+ * \brief           Connection traffic statistics
+ *
+ *                  Statistics are reset when connection becomes active and are kept after it is closed
+ */
+typedef struct {
+    size_t tx_bytes;                            /*!< Number of bytes confirmed sent by device */
+    uint32_t tx_chunks;                         /*!< Number of data chunks confirmed sent by device */
+    uint32_t tx_retries;                        /*!< Number of chunks sent again after `SEND FAIL` */
+    uint32_t tx_failed;                         /*!< Number of sends stopped after \ref GSM_CFG_MAX_SEND_RETRIES tries */
+    uint8_t tx_fill;                            /*!< Average chunk size in percent of \ref GSM_CFG_CONN_MAX_DATA_LEN */
+    uint32_t ack_time_total;                    /*!< Total time from chunk data write to device confirmation in units of milliseconds */
+    uint32_t ack_time_avg;                      /*!< Average time from chunk data write to device confirmation in units of milliseconds */
+    uint32_t ack_time_max;                      /*!< Maximal time from chunk data write to device confirmation in units of milliseconds */
+    size_t rx_bytes;                            /*!< Number of bytes delivered to application */
+    uint32_t rx_pbufs;                          /*!< Number of packet buffers delivered to application */
+    size_t rx_dropped;                          /*!< Number of received bytes not delivered, ignored by application,
+                                                    received in closing mode or without packet buffer memory */
+    uint32_t rx_alloc_fail;                     /*!< Number of failed packet buffer allocations for received data */
+} gsm_conn_stats_t;
+
 /**
  * \ingroup         GSM_TYPEDEFS
  * \brief           Linear buffer structure
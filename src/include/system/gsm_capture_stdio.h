@@ -0,0 +1,65 @@
+/**
+ * \file            gsm_capture_stdio.h
+ * \brief           Write AT port capture to file
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#ifndef __GSM_CAPTURE_STDIO_H
+#define __GSM_CAPTURE_STDIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM_CAPTURE
+ * \defgroup        GSM_CAPTURE_STDIO Capture to file
+ * \brief           Write AT port capture to file with standard C library
+ *
+ * Use together with any low-level driver on host, such as POSIX or Win32 port.
+ * Written file may be replayed with \ref GSM_LL_REPLAY driver.
+ *
+ * \{
+ */
+
+gsmr_t      gsm_capture_stdio_start(const char* path);
+gsmr_t      gsm_capture_stdio_stop(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GSM_CAPTURE_STDIO_H */
@@ -0,0 +1,83 @@
+/**
+ * \file            gsm_ll_replay.h
+ * \brief           Low-level driver replaying captured AT port traffic
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#ifndef __GSM_LL_REPLAY_H
+#define __GSM_LL_REPLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM_LL
+ * \defgroup        GSM_LL_REPLAY Capture replay
+ * \brief           Low-level driver feeding captured traffic back to stack
+ *
+ * Link `gsm_ll_replay.c` instead of hardware low-level driver to replay capture
+ * in \ref GSM_CAPTURE format. Received data are passed to stack
+ * only after stack sent all data captured before them, so command
+ * responses are never delivered before command itself.
+ *
+ * Replay runs at recorded speed or as fast as stack consumes data.
+ *
+ * \{
+ */
+
+/**
+ * \brief           Replay statistics
+ */
+typedef struct {
+    uint32_t records;                           /*!< Number of records processed */
+    size_t rx_bytes;                            /*!< Number of bytes passed to stack */
+    size_t tx_bytes;                            /*!< Number of bytes sent by stack */
+    size_t tx_expected;                         /*!< Number of bytes stack sent during capture */
+    uint32_t rx_time;                           /*!< Time spent in stack input function in units of milliseconds */
+    uint32_t tx_timeouts;                       /*!< Number of times stack did not send expected data in time */
+    uint8_t finished;                           /*!< Set to `1` when all records were processed */
+} gsm_ll_replay_stats_t;
+
+gsmr_t      gsm_ll_replay_set_file(const char* path, uint8_t realtime);
+gsmr_t      gsm_ll_replay_wait(uint32_t timeout);
+void        gsm_ll_replay_get_stats(gsm_ll_replay_stats_t* stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GSM_LL_REPLAY_H */
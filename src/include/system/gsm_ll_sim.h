@@ -0,0 +1,99 @@
+/**
+ * \file            gsm_ll_sim.h
+ * \brief           Virtual GSM device for host-side runs without hardware
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_LL_SIM_H
+#define __GSM_LL_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM_LL
+ * \defgroup        GSM_LL_SIM Virtual device
+ * \brief           Scriptable virtual device implementing low-level functions
+ *
+ * Link `gsm_ll_sim.c` instead of hardware low-level driver to run the stack
+ * on host without device. Virtual device answers commands sent by the stack
+ * with responses of SIM800 device. Answers may be changed with rules
+ * to simulate error paths, and data or URCs may be injected at any time.
+ *
+ * All responses and injected data are delivered in order from single thread,
+ * each after its own delay.
+ *
+ * \note            Functions may only be used after stack is initialized with \ref gsm_init.
+ *                  With multiple instances, functions operate on virtual device
+ *                  of instance selected with \ref gsm_instance_select
+ *
+ * \{
+ */
+
+/**
+ * \brief           Response rule for virtual device
+ */
+typedef struct {
+    const char* cmd;                            /*!< Command prefix after `AT` to match, e.g. `+CIPSTART=` */
+    const char* rsp;                            /*!< Raw response to send instead of default, `NULL` to not respond at all */
+    uint32_t delay;                             /*!< Delay before response in units of milliseconds */
+    uint32_t count;                             /*!< Number of matches to apply rule to, `0` to apply it forever */
+} gsm_ll_sim_rule_t;
+
+/**
+ * \brief           Virtual device statistics
+ */
+typedef struct {
+    size_t tx_bytes;                            /*!< Number of bytes sent by stack to device */
+    size_t rx_bytes;                            /*!< Number of bytes passed from device to stack */
+    uint32_t rx_time;                           /*!< Time spent in stack input function in units of milliseconds */
+    uint32_t cmds;                              /*!< Number of commands received */
+    uint32_t rules_hit;                         /*!< Number of commands answered by rules */
+} gsm_ll_sim_stats_t;
+
+gsmr_t      gsm_ll_sim_add_rule(const gsm_ll_sim_rule_t* rule);
+void        gsm_ll_sim_clear_rules(void);
+void        gsm_ll_sim_set_latency(uint32_t ms);
+gsmr_t      gsm_ll_sim_inject(const void* data, size_t len, uint32_t delay);
+gsmr_t      gsm_ll_sim_receive(uint8_t num, const void* data, size_t len, uint32_t delay);
+void        gsm_ll_sim_get_stats(gsm_ll_sim_stats_t* stats);
+void        gsm_ll_sim_reset_stats(void);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __GSM_LL_SIM_H */
@@ -62,6 +62,8 @@ typedef void (*gsm_sys_thread_fn)(void *);
  
 #define GSM_SYS_PORT_CMSIS_OS               1   /*!< CMSIS-OS based port for OS systems capable of ARM CMSIS standard */
 #define GSM_SYS_PORT_WIN32                  2   /*!< WIN32 based port to use GSM library with Windows applications */
+#define GSM_SYS_PORT_POSIX                  3   /*!< POSIX based port to use GSM library with Linux applications */
+#define GSM_SYS_PORT_CMSIS_OS2              4   /*!< CMSIS-RTOS2 based port with statically allocated kernel objects */
 #define GSM_SYS_PORT_USER                   99  /*!< User custom implementation.
                                                     When port is selected to user mode, user must provide "gsm_sys_user.h" file,
                                                     which is not provided with library. Refer to `system/gsm_sys_template.h` file for more information
@@ -76,6 +78,10 @@ typedef void (*gsm_sys_thread_fn)(void *);
 #include "system/gsm_sys_cmsis_os.h"
 #elif GSM_CFG_SYS_PORT == GSM_SYS_PORT_WIN32
 #include "system/gsm_sys_win32.h"
+#elif GSM_CFG_SYS_PORT == GSM_SYS_PORT_POSIX
+#include "system/gsm_sys_posix.h"
+#elif GSM_CFG_SYS_PORT == GSM_SYS_PORT_CMSIS_OS2
+#include "system/gsm_sys_cmsis_os2.h"
 #elif GSM_CFG_SYS_PORT == GSM_SYS_PORT_USER
 #include "gsm_sys_user.h"
 #endif
@@ -113,6 +119,69 @@ uint8_t     gsm_sys_thread_create(gsm_sys_thread_t* t, const char* name, gsm_sys
 uint8_t     gsm_sys_thread_terminate(gsm_sys_thread_t* t);
 uint8_t     gsm_sys_thread_yield(void);
 
+/*
+ * Optional thread notification, port sets GSM_SYS_THREAD_NOTIFY to `1` when it implements it.
+ * Processing thread is then woken up with notification instead of message queue entry.
+ * Notify function must be callable from interrupt context
+ */
+#ifndef GSM_SYS_THREAD_NOTIFY
+#define GSM_SYS_THREAD_NOTIFY               0
+#endif /* GSM_SYS_THREAD_NOTIFY */
+
+#if GSM_SYS_THREAD_NOTIFY || __DOXYGEN__
+uint8_t     gsm_sys_thread_notify(gsm_sys_thread_t* t);
+uint32_t    gsm_sys_thread_notify_wait(uint32_t timeout);
+#endif /* GSM_SYS_THREAD_NOTIFY || __DOXYGEN__ */
+
+/*
+ * Optional runtime statistics, port sets GSM_SYS_RUNTIME_STATS to `1` when it implements them.
+ * Values port cannot measure are reported as `0`
+ */
+#ifndef GSM_SYS_RUNTIME_STATS
+#define GSM_SYS_RUNTIME_STATS               0
+#endif /* GSM_SYS_RUNTIME_STATS */
+
+#if GSM_SYS_RUNTIME_STATS || __DOXYGEN__
+
+/**
+ * \brief           Runtime statistics of single thread
+ */
+typedef struct {
+    size_t stack_size;                          /*!< Stack size in units of bytes, `0` when unknown */
+    size_t stack_free_min;                      /*!< Minimal free stack ever, high-water mark, in units of bytes */
+    uint32_t run_time;                          /*!< Accumulated run time in units of milliseconds */
+} gsm_sys_thread_stats_t;
+
+/**
+ * \brief           Occupancy statistics of single message queue
+ */
+typedef struct {
+    size_t size;                                /*!< Number of entries queue can hold */
+    size_t used;                                /*!< Number of entries currently in queue */
+    size_t peak;                                /*!< Maximal number of entries ever in queue */
+} gsm_sys_mbox_stats_t;
+
+/**
+ * \brief           Runtime statistics of internal threads and message queues
+ */
+typedef struct {
+    gsm_sys_thread_stats_t thread_producer;     /*!< Producer thread */
+    gsm_sys_thread_stats_t thread_process;      /*!< Processing thread */
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+    gsm_sys_thread_stats_t thread_evt;          /*!< Deferred event dispatcher thread */
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
+    gsm_sys_mbox_stats_t mbox_producer;         /*!< Producer wakeup queue, see \ref gsm_get_msg_lane_stats for message lanes */
+    gsm_sys_mbox_stats_t mbox_process;          /*!< Processing thread queue, not used with thread notification */
+#if GSM_CFG_EVT_DEFERRED || __DOXYGEN__
+    gsm_sys_mbox_stats_t mbox_evt;              /*!< Deferred event queue */
+#endif /* GSM_CFG_EVT_DEFERRED || __DOXYGEN__ */
+} gsm_runtime_stats_t;
+
+uint8_t     gsm_sys_thread_get_stats(gsm_sys_thread_t* t, gsm_sys_thread_stats_t* stats);
+uint8_t     gsm_sys_mbox_get_stats(gsm_sys_mbox_t* b, gsm_sys_mbox_stats_t* stats);
+
+#endif /* GSM_SYS_RUNTIME_STATS || __DOXYGEN__ */
+
 /**
  * \}
  */
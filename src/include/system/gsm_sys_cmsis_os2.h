@@ -0,0 +1,123 @@
+/**
+ * \file            gsm_sys_cmsis_os2.h
+ * \brief           CMSIS-RTOS2 based system file with static allocation
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_SYSTEM_CMSIS_OS2_H
+#define __GSM_SYSTEM_CMSIS_OS2_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include "stdint.h"
+#include "stdlib.h"
+
+#include "gsm_config.h"
+
+#if GSM_CFG_OS && !__DOXYGEN__
+#include "cmsis_os2.h"
+
+typedef osMutexId_t         gsm_sys_mutex_t;
+typedef osSemaphoreId_t     gsm_sys_sem_t;
+typedef osMessageQueueId_t  gsm_sys_mbox_t;
+typedef osThreadId_t        gsm_sys_thread_t;
+typedef osPriority_t        gsm_sys_thread_prio_t;
+#define GSM_SYS_MBOX_NULL           (osMessageQueueId_t)0
+#define GSM_SYS_SEM_NULL            (osSemaphoreId_t)0
+#define GSM_SYS_MUTEX_NULL          (osMutexId_t)0
+#define GSM_SYS_TIMEOUT             ((uint32_t)osWaitForever)
+#define GSM_SYS_THREAD_PRIO         (osPriorityNormal)
+#define GSM_SYS_THREAD_SS           (1024)
+
+/* Processing thread is woken up with thread flag instead of message queue entry */
+#define GSM_SYS_THREAD_NOTIFY       1
+
+/* Stack and message queue statistics are available, run time is not part of CMSIS-RTOS2 API */
+#define GSM_SYS_RUNTIME_STATS       1
+
+/*
+ * All kernel objects are created in statically allocated memory.
+ * Number of objects of each type is fixed at compile time,
+ * creation fails when all slots are in use
+ */
+
+/* Number of mutexes, including system protection and lock domains */
+#ifndef GSM_SYS_CMSIS_OS2_MUTEX_NUM
+#define GSM_SYS_CMSIS_OS2_MUTEX_NUM         8
+#endif
+
+/* Number of semaphores, one for each concurrently blocking API call */
+#ifndef GSM_SYS_CMSIS_OS2_SEM_NUM
+#define GSM_SYS_CMSIS_OS2_SEM_NUM           8
+#endif
+
+/* Number of message queues */
+#ifndef GSM_SYS_CMSIS_OS2_MBOX_NUM
+#define GSM_SYS_CMSIS_OS2_MBOX_NUM          12
+#endif
+
+/* Maximal number of entries of single message queue */
+#ifndef GSM_SYS_CMSIS_OS2_MBOX_LEN
+#define GSM_SYS_CMSIS_OS2_MBOX_LEN          64
+#endif
+
+/* Memory for single message queue entry, must fit RTOS message header and pointer */
+#ifndef GSM_SYS_CMSIS_OS2_MBOX_ENTRY_SIZE
+#define GSM_SYS_CMSIS_OS2_MBOX_ENTRY_SIZE   16
+#endif
+
+/* Number of threads, producer and process threads plus optional threads */
+#ifndef GSM_SYS_CMSIS_OS2_THREAD_NUM
+#define GSM_SYS_CMSIS_OS2_THREAD_NUM        4
+#endif
+
+/* Stack size of each thread in units of bytes */
+#ifndef GSM_SYS_CMSIS_OS2_THREAD_STACK_SIZE
+#define GSM_SYS_CMSIS_OS2_THREAD_STACK_SIZE GSM_SYS_THREAD_SS
+#endif
+
+/* Control block size of each object, must not be smaller than RTOS requires */
+#ifndef GSM_SYS_CMSIS_OS2_CB_SIZE
+#define GSM_SYS_CMSIS_OS2_CB_SIZE           128
+#endif
+
+/* Thread flag used to wakeup processing thread */
+#ifndef GSM_SYS_CMSIS_OS2_WAKEUP_FLAG
+#define GSM_SYS_CMSIS_OS2_WAKEUP_FLAG       0x00000001U
+#endif
+
+#endif /* GSM_CFG_OS && !__DOXYGEN__ */
+
+#ifdef __cplusplus
+};
+#endif /* __cplusplus */
+
+#endif /* __GSM_SYSTEM_CMSIS_OS2_H */
@@ -0,0 +1,107 @@
+/**
+ * \file            gsm_capture_stdio.c
+ * \brief           Write AT port capture to file
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#include "system/gsm_capture_stdio.h"
+#include "system/gsm_sys.h"
+#include "gsm/gsm_capture.h"
+#include "stdio.h"
+
+#if GSM_CFG_AT_CAPTURE || __DOXYGEN__
+
+static FILE* file;                              /*!< Capture file, `NULL` when not capturing */
+static gsm_sys_mutex_t file_mutex;              /*!< Serializes records from send and receive threads */
+
+/**
+ * \brief           Write single record to capture file
+ * \param[in]       dir: Direction of data
+ * \param[in]       time: Time since capture start in units of milliseconds
+ * \param[in]       data: Captured data
+ * \param[in]       len: Number of captured bytes
+ * \param[in]       arg: Unused
+ */
+static void
+capture_write(gsm_capture_dir_t dir, uint32_t time, const void* data, size_t len, void* arg) {
+    uint8_t hdr[GSM_CAPTURE_HDR_LEN];
+
+    (void)arg;
+    gsm_capture_hdr_encode(hdr, dir, time, len);
+    gsm_sys_mutex_lock(&file_mutex);
+    if (file != NULL) {
+        fwrite(hdr, 1, sizeof(hdr), file);
+        fwrite(data, 1, len, file);
+    }
+    gsm_sys_mutex_unlock(&file_mutex);
+}
+
+/**
+ * \brief           Start capture of AT port traffic to file
+ * \param[in]       path: Path of file to create, existing file is overwritten
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_capture_stdio_start(const char* path) {
+    GSM_ASSERT("path != NULL", path != NULL);   /* Assert input parameters */
+
+    if (file != NULL) {
+        return gsmERR;                          /* Capture already active */
+    }
+    if (!gsm_sys_mutex_create(&file_mutex)) {
+        return gsmERRMEM;
+    }
+    if ((file = fopen(path, "wb")) == NULL) {
+        gsm_sys_mutex_delete(&file_mutex);
+        return gsmERR;
+    }
+    fwrite(GSM_CAPTURE_MAGIC, 1, GSM_CAPTURE_MAGIC_LEN, file);
+    return gsm_capture_start(capture_write, NULL);
+}
+
+/**
+ * \brief           Stop capture and close capture file
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_capture_stdio_stop(void) {
+    if (file == NULL) {
+        return gsmERR;
+    }
+    gsm_capture_stop();
+    gsm_sys_mutex_lock(&file_mutex);            /* Wait for record in progress */
+    fclose(file);
+    file = NULL;
+    gsm_sys_mutex_unlock(&file_mutex);
+    gsm_sys_mutex_delete(&file_mutex);
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_AT_CAPTURE || __DOXYGEN__ */
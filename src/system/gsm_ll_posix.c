@@ -0,0 +1,402 @@
+/**
+ * \file            gsm_ll_posix.c
+ * \brief           Low-level communication with GSM device for POSIX (Linux)
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* _GNU_SOURCE */
+#include "system/gsm_ll.h"
+#include "gsm/gsm.h"
+#include "gsm/gsm_mem.h"
+#include "gsm/gsm_input.h"
+#include "stdio.h"
+#include "errno.h"
+#include "fcntl.h"
+#include "poll.h"
+#include "pthread.h"
+#include "termios.h"
+#include "unistd.h"
+#include "sys/ioctl.h"
+#include "linux/serial.h"
+
+#if !__DOXYGEN__
+
+/* Serial device connected to GSM module */
+#ifndef GSM_LL_POSIX_DEVICE
+#define GSM_LL_POSIX_DEVICE                 "/dev/ttyUSB0"
+#endif
+
+/* Initializer of serial devices array, one device for each instance */
+#ifndef GSM_LL_POSIX_DEVICES
+#define GSM_LL_POSIX_DEVICES                { GSM_LL_POSIX_DEVICE }
+#endif
+
+/* Set to `1` to use RTS/CTS hardware flow control */
+#ifndef GSM_LL_POSIX_RTSCTS
+#define GSM_LL_POSIX_RTSCTS                 0
+#endif
+
+/*
+ * Set to `1` to return every received byte immediately and ask serial driver for low latency.
+ * Set to `0` to batch received bytes until 255 bytes are received or line is idle for 100 ms
+ */
+#ifndef GSM_LL_POSIX_LOW_LATENCY
+#define GSM_LL_POSIX_LOW_LATENCY            1
+#endif
+
+/* State of AT port owned by single instance */
+typedef struct {
+    uint8_t initialized;                        /*!< Set to `1` when serial device is opened */
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_p inst;                        /*!< Instance which owns serial device */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    int uart_fd;                                /*!< Serial device file descriptor */
+    int wake_fd[2];                             /*!< Pipe to wakeup reader thread */
+    pthread_t thread_handle;
+    volatile uint8_t thread_run;                /*!< Set to `0` to stop reader thread */
+    volatile uint8_t rx_paused;                 /*!< Set to `1` when reception is paused */
+    uint8_t data_buffer[0x1000];                /*!< Received data array */
+} ll_ctx_t;
+
+static const char* devices[GSM_CFG_MAX_INSTANCES] = GSM_LL_POSIX_DEVICES;
+static ll_ctx_t ll_ctx[GSM_CFG_MAX_INSTANCES];
+
+/**
+ * \brief           Get AT port state of instance selected for current thread
+ * \return          Pointer to AT port state
+ */
+static ll_ctx_t *
+ctx_get(void) {
+#if GSM_CFG_MAX_INSTANCES > 1
+    return &ll_ctx[gsm_instance_get_index(NULL)];
+#else /* GSM_CFG_MAX_INSTANCES > 1 */
+    return &ll_ctx[0];
+#endif /* !(GSM_CFG_MAX_INSTANCES > 1) */
+}
+
+/**
+ * \brief           Send data to GSM device, function called from GSM stack when we have data to send
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+send_data(const void* data, size_t len) {
+    ll_ctx_t* ctx = ctx_get();
+    const uint8_t* d = data;
+    size_t sent = 0;
+    ssize_t res;
+
+    while (ctx->initialized && sent < len) {
+        res = write(ctx->uart_fd, &d[sent], len - sent);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        sent += (size_t)res;
+    }
+    return sent;
+}
+
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+/**
+ * \brief           Pause or resume reading from serial device
+ *
+ * When reader is paused, kernel buffer fills up and with \ref GSM_LL_POSIX_RTSCTS
+ * enabled, driver deasserts RTS line to stop device
+ *
+ * \param[in]       resume: Set to `1` to resume reading
+ */
+static void
+rx_flow(uint8_t resume) {
+    ll_ctx_t* ctx = ctx_get();
+
+    ctx->rx_paused = !resume;
+    if (resume && ctx->initialized) {
+        uint8_t b = 0;
+        (void)write(ctx->wake_fd[1], &b, 1);    /* Wakeup reader thread */
+    }
+}
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+
+#if GSM_CFG_SLEEP
+/**
+ * \brief           Drive DTR line of serial device
+ *
+ * Asserted DTR line is low on device side and keeps device awake
+ *
+ * \param[in]       wake: Set to `1` to wake up device, `0` to allow it to sleep
+ */
+static void
+dtr_wake(uint8_t wake) {
+    ll_ctx_t* ctx = ctx_get();
+    int bits = TIOCM_DTR;
+
+    if (ctx->initialized) {
+        (void)ioctl(ctx->uart_fd, wake ? TIOCMBIS : TIOCMBIC, &bits);
+    }
+}
+#endif /* GSM_CFG_SLEEP */
+
+/**
+ * \brief           Get termios speed value for baudrate
+ * \param[in]       baudrate: Baudrate in units of bits per second
+ * \param[out]      speed: Termios speed value
+ * \return          `1` if baudrate is supported, `0` otherwise
+ */
+static uint8_t
+get_speed(uint32_t baudrate, speed_t* speed) {
+    static const struct {
+        uint32_t baudrate;
+        speed_t speed;
+    } speeds[] = {
+        { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 }, { 57600, B57600 },
+        { 115200, B115200 }, { 230400, B230400 }, { 460800, B460800 }, { 921600, B921600 },
+    };
+    size_t i;
+
+    for (i = 0; i < GSM_ARRAYSIZE(speeds); i++) {
+        if (speeds[i].baudrate == baudrate) {
+            *speed = speeds[i].speed;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Reader thread, blocks until data are received and passes them to stack in big chunks
+ * \param[in]       param: AT port state of instance which owns serial device
+ */
+static void*
+uart_thread(void* param) {
+    ll_ctx_t* ctx = param;
+    struct pollfd fds[2];
+    ssize_t len;
+
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_select(ctx->inst);             /* Received data belong to owner instance */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    fds[0].fd = ctx->wake_fd[0];
+    fds[0].events = POLLIN;
+    fds[1].fd = ctx->uart_fd;
+    fds[1].events = POLLIN;
+    while (ctx->thread_run) {
+        if (poll(fds, ctx->rx_paused ? 1 : 2, -1) < 0) {
+            continue;                           /* Interrupted by signal */
+        }
+        if (fds[0].revents & POLLIN) {          /* Flow or stop request */
+            uint8_t b[16];
+            (void)read(ctx->wake_fd[0], b, sizeof(b));
+        }
+        if (ctx->rx_paused || !(fds[1].revents & POLLIN)) {
+            continue;
+        }
+        len = read(ctx->uart_fd, ctx->data_buffer, sizeof(ctx->data_buffer));
+        if (len > 0) {
+            /* Send received data to input processing module */
+#if GSM_CFG_INPUT_USE_PROCESS
+            gsm_input_process(ctx->data_buffer, (size_t)len);
+#else /* GSM_CFG_INPUT_USE_PROCESS */
+            gsm_input(ctx->data_buffer, (size_t)len);
+#endif /* !GSM_CFG_INPUT_USE_PROCESS */
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Open and configure serial device
+ * \param[in]       ctx: AT port state of instance
+ * \param[in]       device: Path to serial device
+ * \param[in]       baudrate: Baudrate in units of bits per second
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+configure_uart(ll_ctx_t* ctx, const char* device, uint32_t baudrate) {
+    struct termios tio;
+    speed_t speed;
+
+    if (!get_speed(baudrate, &speed)) {
+        printf("Unsupported baudrate %u\r\n", (unsigned)baudrate);
+        return gsmERR;
+    }
+
+    /* On first call, open serial device */
+    if (!ctx->initialized) {
+        if (device == NULL) {
+            printf("No serial device for instance\r\n");
+            return gsmERR;
+        }
+        ctx->uart_fd = open(device, O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (ctx->uart_fd < 0) {
+            printf("Cannot open %s\r\n", device);
+            return gsmERR;
+        }
+#if GSM_LL_POSIX_LOW_LATENCY
+        {
+            struct serial_struct ser;
+            if (ioctl(ctx->uart_fd, TIOCGSERIAL, &ser) == 0) {
+                ser.flags |= ASYNC_LOW_LATENCY; /* Push received bytes to tty layer immediately */
+                ioctl(ctx->uart_fd, TIOCSSERIAL, &ser); /* Not all drivers support it */
+            }
+        }
+#endif /* GSM_LL_POSIX_LOW_LATENCY */
+    }
+
+    /* Configure serial device parameters, also when only baudrate changes */
+    if (tcgetattr(ctx->uart_fd, &tio) < 0) {
+        printf("Cannot get serial port attributes\r\n");
+        return gsmERR;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB);
+#if GSM_LL_POSIX_RTSCTS
+    tio.c_cflag |= CRTSCTS;
+#else /* GSM_LL_POSIX_RTSCTS */
+    tio.c_cflag &= ~CRTSCTS;
+#endif /* !GSM_LL_POSIX_RTSCTS */
+#if GSM_LL_POSIX_LOW_LATENCY
+    tio.c_cc[VMIN] = 1;                         /* Return as soon as any byte is available */
+    tio.c_cc[VTIME] = 0;
+#else /* GSM_LL_POSIX_LOW_LATENCY */
+    tio.c_cc[VMIN] = 255;                       /* Batch bytes ... */
+    tio.c_cc[VTIME] = 1;                        /* ... until line is idle for 100 ms */
+#endif /* !GSM_LL_POSIX_LOW_LATENCY */
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(ctx->uart_fd, ctx->initialized ? TCSADRAIN : TCSANOW, &tio) < 0) {
+        printf("Cannot set serial port attributes\r\n");
+        return gsmERR;
+    }
+
+    /* On first function call, create a thread to read data from serial device */
+    if (!ctx->initialized) {
+        if (pipe(ctx->wake_fd) < 0) {
+            close(ctx->uart_fd);
+            return gsmERR;
+        }
+        ctx->rx_paused = 0;
+        ctx->thread_run = 1;
+        if (pthread_create(&ctx->thread_handle, NULL, uart_thread, ctx)) {
+            close(ctx->wake_fd[0]);
+            close(ctx->wake_fd[1]);
+            close(ctx->uart_fd);
+            return gsmERR;
+        }
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           Callback function called from initialization process
+ *
+ * \note            This function may be called multiple times if AT baudrate is changed from application.
+ *                  It is important that every configuration except AT baudrate is configured only once!
+ *
+ * \note            This function may be called from different threads in GSM stack when using OS.
+ *                  When \ref GSM_CFG_INPUT_USE_PROCESS is set to 1, this function may be called from user UART thread.
+ *
+ * \note            Each instance opens its own device from `GSM_LL_POSIX_DEVICES` list.
+ *                  Memory is assigned to allocator once and shared by all instances
+ *
+ * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure to fill data for communication functions
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_init(gsm_ll_t* ll) {
+    /* Step 1: Configure memory for dynamic allocations */
+    static uint8_t memory[GSM_CFG_MAX_INSTANCES][0x10000];  /* Create memory for dynamic allocations with specific size */
+    ll_ctx_t* ctx = ctx_get();
+    size_t index = (size_t)(ctx - ll_ctx);
+    gsmr_t res;
+
+    /*
+     * Create memory region(s) of memory.
+     * If device has internal/external memory available,
+     * multiple memories may be used
+     */
+    gsm_mem_region_t mem_regions[] = {
+        { memory[index], sizeof(memory[0]) }
+    };
+    gsm_mem_assignmemory(mem_regions, GSM_ARRAYSIZE(mem_regions));  /* Assign memory to heap of instance, ignored when already assigned */
+
+    /* Step 2: Set AT port send function to use when we have data to transmit */
+    if (!ctx->initialized) {
+#if GSM_CFG_MAX_INSTANCES > 1
+        ctx->inst = gsm_instance_current();     /* Instance being initialized owns device */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+        ll->send_fn = send_data;                /* Set callback function to send data */
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+        ll->rx_flow_fn = rx_flow;               /* Pause reader, kernel drives RTS line */
+        ll->tx_ready_fn = NULL;                 /* Kernel waits for CTS line on write */
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+#if GSM_CFG_SLEEP
+        ll->wake_fn = dtr_wake;                 /* Drive DTR line for sleep mode */
+#endif /* GSM_CFG_SLEEP */
+    }
+
+    /* Step 3: Configure AT port to be able to send/receive data to/from GSM device */
+    res = configure_uart(ctx, devices[index], ll->uart.baudrate);   /* Initialize UART for communication */
+    if (res == gsmOK) {
+        ctx->initialized = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Stop reader thread and close serial device
+ * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_deinit(gsm_ll_t* ll) {
+    ll_ctx_t* ctx = ctx_get();
+    uint8_t b = 0;
+
+    (void)ll;
+    if (!ctx->initialized) {
+        return gsmERR;
+    }
+    ctx->initialized = 0;                       /* Stop sending before device is closed */
+    ctx->thread_run = 0;
+    (void)write(ctx->wake_fd[1], &b, 1);        /* Wakeup reader thread */
+    pthread_join(ctx->thread_handle, NULL);
+    close(ctx->wake_fd[0]);
+    close(ctx->wake_fd[1]);
+    close(ctx->uart_fd);
+    return gsmOK;
+}
+
+#endif /* !__DOXYGEN__ */
@@ -0,0 +1,300 @@
+/**
+ * \file            gsm_ll_replay.c
+ * \brief           Low-level driver replaying captured AT port traffic
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#include "system/gsm_ll.h"
+#include "system/gsm_ll_replay.h"
+#include "system/gsm_sys.h"
+#include "gsm/gsm.h"
+#include "gsm/gsm_mem.h"
+#include "gsm/gsm_input.h"
+#include "gsm/gsm_capture.h"
+#include "stdio.h"
+#include "string.h"
+
+#if !__DOXYGEN__
+
+/* Capture file replayed when application does not set it */
+#ifndef GSM_LL_REPLAY_FILE
+#define GSM_LL_REPLAY_FILE                  "capture.bin"
+#endif
+
+/* Maximal time in units of milliseconds to wait for stack to send captured data */
+#ifndef GSM_LL_REPLAY_TX_TIMEOUT
+#define GSM_LL_REPLAY_TX_TIMEOUT            10000
+#endif
+
+static uint8_t initialized = 0;
+static const char* replay_path = GSM_LL_REPLAY_FILE;
+static uint8_t replay_realtime;                 /*!< Set to `1` to replay at recorded speed */
+static FILE* file;
+static gsm_sys_thread_t replay_thread;
+#if GSM_CFG_MAX_INSTANCES > 1
+static gsm_instance_p replay_inst;              /*!< Instance which owns replay, capture holds single device */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+static volatile uint8_t thread_run;             /*!< Set to `0` to stop replay thread */
+static volatile uint8_t thread_running;         /*!< Set to `1` while replay thread is running */
+static volatile size_t tx_bytes;                /*!< Number of bytes sent by stack */
+static gsm_ll_replay_stats_t replay_stats;
+static uint8_t data_buffer[0x1000];             /*!< Record data read from file */
+
+/**
+ * \brief           Send data to GSM device, function called from GSM stack when we have data to send
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+send_data(const void* data, size_t len) {
+    (void)data;
+    tx_bytes += len;                            /* Only amount of data is used for synchronization */
+    return len;
+}
+
+/**
+ * \brief           Wait for stack to send data captured before next received record
+ * \return          `1` if stack sent data, `0` on timeout or stop request
+ */
+static uint8_t
+replay_wait_tx(void) {
+    uint32_t time = gsm_sys_now();
+
+    while (tx_bytes < replay_stats.tx_expected) {
+        if (!thread_run || (uint32_t)(gsm_sys_now() - time) >= GSM_LL_REPLAY_TX_TIMEOUT) {
+            return 0;
+        }
+        gsm_delay(1);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Replay thread, reads records and passes received data to stack
+ * \param[in]       arg: Unused
+ */
+static void
+replay_thread_fn(void* arg) {
+    uint8_t hdr[GSM_CAPTURE_HDR_LEN];
+    gsm_capture_dir_t dir;
+    uint32_t rec_time, start, time;
+    size_t len, part;
+
+    (void)arg;
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_select(replay_inst);           /* Replayed data belong to owner instance */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    start = gsm_sys_now();
+    while (thread_run && fread(hdr, 1, sizeof(hdr), file) == sizeof(hdr)
+        && gsm_capture_hdr_decode(hdr, &dir, &rec_time, &len)) {
+        if (dir == GSM_CAPTURE_DIR_TX) {        /* Data are produced by stack itself */
+            replay_stats.tx_expected += len;
+            if (fseek(file, (long)len, SEEK_CUR)) {
+                break;
+            }
+        } else {
+            if (!replay_wait_tx()) {            /* Stack diverged from capture, continue anyway */
+                replay_stats.tx_timeouts++;
+                printf("[REPLAY] Stack sent %d of %d byte(s) before record %d\r\n",
+                    (int)tx_bytes, (int)replay_stats.tx_expected, (int)replay_stats.records);
+            }
+            if (replay_realtime && (int32_t)(start + rec_time - gsm_sys_now()) > 0) {
+                gsm_delay(start + rec_time - gsm_sys_now());
+            }
+            for (; len > 0; len -= part) {
+                part = GSM_MIN(len, sizeof(data_buffer));
+                if (fread(data_buffer, 1, part, file) != part) {
+                    len = 0;
+                    break;
+                }
+                time = gsm_sys_now();
+#if GSM_CFG_INPUT_USE_PROCESS
+                gsm_input_process(data_buffer, part);
+#else /* GSM_CFG_INPUT_USE_PROCESS */
+                gsm_input(data_buffer, part);
+#endif /* !GSM_CFG_INPUT_USE_PROCESS */
+                replay_stats.rx_time += gsm_sys_now() - time;
+                replay_stats.rx_bytes += part;
+            }
+        }
+        replay_stats.records++;
+    }
+    replay_stats.finished = 1;
+    thread_running = 0;
+    gsm_sys_thread_terminate(NULL);
+}
+
+/**
+ * \brief           Set capture file to replay
+ * \note            Function must be called before \ref gsm_init
+ * \param[in]       path: Path of capture file, must stay valid during replay
+ * \param[in]       realtime: Set to `1` to replay at recorded speed,
+ *                      `0` to replay as fast as stack sends commands
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_replay_set_file(const char* path, uint8_t realtime) {
+    GSM_ASSERT("path != NULL", path != NULL);   /* Assert input parameters */
+
+    if (initialized) {
+        return gsmERR;
+    }
+    replay_path = path;
+    replay_realtime = realtime;
+    return gsmOK;
+}
+
+/**
+ * \brief           Wait for all records to be replayed
+ * \param[in]       timeout: Maximal time to wait in units of milliseconds, `0` to wait forever
+ * \return          \ref gsmOK when replay finished, \ref gsmTIMEOUT otherwise
+ */
+gsmr_t
+gsm_ll_replay_wait(uint32_t timeout) {
+    uint32_t time = gsm_sys_now();
+
+    while (!replay_stats.finished) {
+        if (timeout && (uint32_t)(gsm_sys_now() - time) >= timeout) {
+            return gsmTIMEOUT;
+        }
+        gsm_delay(1);
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           Get replay statistics
+ *
+ *                  Input throughput of stack is `rx_bytes * 1000 / rx_time` bytes per second.
+ *                  Use \ref gsm_mem_getstats for heap usage
+ *
+ * \param[out]      stats: Output variable to save statistics to
+ */
+void
+gsm_ll_replay_get_stats(gsm_ll_replay_stats_t* stats) {
+    if (stats != NULL) {
+        *stats = replay_stats;
+        stats->tx_bytes = tx_bytes;
+    }
+}
+
+/**
+ * \brief           Callback function called from initialization process
+ *
+ * \note            This function may be called multiple times if AT baudrate is changed from application.
+ *                  Replay ignores baudrate
+ *
+ * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure to fill data for communication functions
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_init(gsm_ll_t* ll) {
+    /* Step 1: Configure memory for dynamic allocations */
+    static uint8_t memory[0x10000];             /* Create memory for dynamic allocations with specific size */
+    char magic[GSM_CAPTURE_MAGIC_LEN];
+
+    /*
+     * Create memory region(s) of memory.
+     * If device has internal/external memory available,
+     * multiple memories may be used
+     */
+    gsm_mem_region_t mem_regions[] = {
+        { memory, sizeof(memory) }
+    };
+    if (initialized) {
+#if GSM_CFG_MAX_INSTANCES > 1
+        if (replay_inst != gsm_instance_current()) {
+            printf("[REPLAY] Capture is already replayed to other instance\r\n");
+            return gsmERR;
+        }
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+        return gsmOK;                           /* Nothing to reconfigure */
+    }
+    gsm_mem_assignmemory(mem_regions, GSM_ARRAYSIZE(mem_regions));  /* Assign memory for allocations to GSM library */
+
+    /* Step 2: Set AT port send function to use when we have data to transmit */
+    ll->send_fn = send_data;                    /* Set callback function to send data */
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+    ll->rx_flow_fn = NULL;                      /* Replay has no flow control lines */
+    ll->tx_ready_fn = NULL;
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+#if GSM_CFG_SLEEP
+    ll->wake_fn = NULL;                         /* Wakeup was captured as sent data */
+#endif /* GSM_CFG_SLEEP */
+
+    /* Step 3: Open capture and start replay thread instead of configuring AT port */
+    if ((file = fopen(replay_path, "rb")) == NULL) {
+        printf("[REPLAY] Cannot open %s\r\n", replay_path);
+        return gsmERR;
+    }
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic)
+        || memcmp(magic, GSM_CAPTURE_MAGIC, sizeof(magic))) {
+        printf("[REPLAY] %s is not a capture file\r\n", replay_path);
+        fclose(file);
+        return gsmERR;
+    }
+    memset(&replay_stats, 0x00, sizeof(replay_stats));
+    tx_bytes = 0;
+#if GSM_CFG_MAX_INSTANCES > 1
+    replay_inst = gsm_instance_current();
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    thread_run = thread_running = 1;
+    if (!gsm_sys_thread_create(&replay_thread, "gsm_ll_replay", replay_thread_fn, NULL, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO)) {
+        thread_run = thread_running = 0;
+        fclose(file);
+        return gsmERR;
+    }
+    initialized = 1;
+    return gsmOK;
+}
+
+/**
+ * \brief           Stop replay thread and close capture file
+ * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_deinit(gsm_ll_t* ll) {
+    (void)ll;
+    if (!initialized) {
+        return gsmERR;
+    }
+    thread_run = 0;
+    while (thread_running) {
+        gsm_delay(1);
+    }
+    fclose(file);
+    file = NULL;
+    initialized = 0;
+    return gsmOK;
+}
+
+#endif /* !__DOXYGEN__ */
@@ -0,0 +1,665 @@
+/**
+ * \file            gsm_ll_sim.c
+ * \brief           Virtual GSM device for host-side runs without hardware
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_ll.h"
+#include "system/gsm_ll_sim.h"
+#include "system/gsm_sys.h"
+#include "gsm/gsm.h"
+#include "gsm/gsm_mem.h"
+#include "gsm/gsm_input.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+#if !__DOXYGEN__
+
+/* Maximal number of response rules */
+#ifndef GSM_LL_SIM_RULES_NUM
+#define GSM_LL_SIM_RULES_NUM                16
+#endif
+
+/* Default delay before each response in units of milliseconds */
+#ifndef GSM_LL_SIM_LATENCY
+#define GSM_LL_SIM_LATENCY                  0
+#endif
+
+/* Maximal number of responses and injected data waiting for delivery */
+#ifndef GSM_LL_SIM_QUEUE_LEN
+#define GSM_LL_SIM_QUEUE_LEN                32
+#endif
+
+/* Local IP address reported by device */
+#ifndef GSM_LL_SIM_LOCAL_IP
+#define GSM_LL_SIM_LOCAL_IP                 "10.0.0.2"
+#endif
+
+/* IP address returned for every host name */
+#ifndef GSM_LL_SIM_DNS_IP
+#define GSM_LL_SIM_DNS_IP                   "93.184.216.34"
+#endif
+
+/* Data waiting for delivery to stack */
+typedef struct {
+    uint32_t delay;                             /*!< Delay before delivery in units of milliseconds */
+    uint8_t stop;                               /*!< Set to `1` to stop delivery thread */
+    size_t len;                                 /*!< Length of data */
+    uint8_t data[];                             /*!< Data to deliver */
+} sim_entry_t;
+
+/* Connection state on virtual device */
+typedef struct {
+    uint8_t active;                             /*!< Set to `1` when connection is active */
+    char type[4];                               /*!< Connection type */
+    char ip[16];                                /*!< Remote IP address */
+    unsigned port;                              /*!< Remote port */
+} sim_conn_t;
+
+/* Raw data expected after "> " prompt */
+typedef enum {
+    SIM_DATA_NONE = 0,
+    SIM_DATA_CIPSEND,
+    SIM_DATA_FSWRITE,
+    SIM_DATA_CMGS,
+} sim_data_t;
+
+/* State of virtual device of single instance */
+typedef struct {
+    uint8_t initialized;                        /*!< Set to `1` when virtual device is running */
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_p inst;                        /*!< Instance which owns virtual device */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    volatile uint8_t thread_running;            /*!< Set to `1` while delivery thread is running */
+
+    gsm_sys_mbox_t rsp_mbox;                    /*!< Queue of data for delivery thread */
+    gsm_sys_mutex_t mutex;                      /*!< Protects rules and statistics */
+    gsm_sys_thread_t thread;
+
+    gsm_ll_sim_rule_t rules[GSM_LL_SIM_RULES_NUM];
+    uint32_t rsp_latency;                       /*!< Delay before each default response */
+    gsm_ll_sim_stats_t stats;
+
+    char line[256];                             /*!< Command currently received from stack */
+    size_t line_len;
+    sim_data_t data_mode;                       /*!< Type of raw data currently received */
+    size_t data_rem;                            /*!< Number of raw data bytes still expected */
+    size_t data_len;                            /*!< Number of raw data bytes announced with command */
+    unsigned data_num;                          /*!< Connection number for raw data */
+    uint8_t qsend;                              /*!< Set to `1` when quick send mode is enabled */
+    const char* ip_state;
+    sim_conn_t conns[GSM_CFG_MAX_CONNS];
+} sim_ctx_t;
+
+static sim_ctx_t sim_ctx[GSM_CFG_MAX_INSTANCES];
+
+/**
+ * \brief           Get virtual device of instance selected for current thread
+ * \return          Pointer to virtual device state
+ */
+static sim_ctx_t *
+sim_get(void) {
+#if GSM_CFG_MAX_INSTANCES > 1
+    return &sim_ctx[gsm_instance_get_index(NULL)];
+#else /* GSM_CFG_MAX_INSTANCES > 1 */
+    return &sim_ctx[0];
+#endif /* !(GSM_CFG_MAX_INSTANCES > 1) */
+}
+
+/**
+ * \brief           Put data to delivery queue
+ * \param[in]       sim: Virtual device
+ * \param[in]       data: Data to deliver to stack
+ * \param[in]       len: Length of data
+ * \param[in]       delay: Delay before delivery in units of milliseconds
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+sim_queue(sim_ctx_t* sim, const void* data, size_t len, uint32_t delay) {
+    sim_entry_t* e;
+
+    if (!sim->initialized) {
+        return gsmERR;
+    }
+    if ((e = malloc(sizeof(*e) + len)) == NULL) {   /* Keep stack heap statistics untouched */
+        return gsmERRMEM;
+    }
+    e->delay = delay;
+    e->stop = 0;
+    e->len = len;
+    if (len) {
+        memcpy(e->data, data, len);
+    }
+
+    /* Never block, stack may call this function with core locked */
+    if (!gsm_sys_mbox_putnow(&sim->rsp_mbox, e)) {
+        printf("[SIM] Response queue full, dropping %d byte(s)\r\n", (int)len);
+        free(e);
+        return gsmERR;
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           Queue response string with default latency
+ * \param[in]       sim: Virtual device
+ * \param[in]       str: Response to send
+ */
+static void
+sim_rsp(sim_ctx_t* sim, const char* str) {
+    sim_queue(sim, str, strlen(str), sim->rsp_latency);
+}
+
+/**
+ * \brief           Build `+CIPSTATUS` response from current connection state
+ * \param[in]       sim: Virtual device
+ */
+static void
+sim_cipstatus(sim_ctx_t* sim) {
+    char buff[64 + 64 * GSM_CFG_MAX_CONNS];
+    size_t n;
+
+    n = (size_t)snprintf(buff, sizeof(buff), "\r\nOK\r\n\r\nSTATE: %s\r\n", sim->ip_state);
+    if (strcmp(sim->ip_state, "IP INITIAL")) {  /* No connection lines in initial state */
+        for (size_t i = 0; i < GSM_CFG_MAX_CONNS; i++) {
+            if (sim->conns[i].active) {
+                n += (size_t)snprintf(&buff[n], sizeof(buff) - n, "C: %d,0,\"%s\",\"%s\",\"%u\",\"CONNECTED\"\r\n",
+                    (int)i, sim->conns[i].type, sim->conns[i].ip, sim->conns[i].port);
+            } else {
+                n += (size_t)snprintf(&buff[n], sizeof(buff) - n, "C: %d,,\"\",\"\",\"\",\"INITIAL\"\r\n", (int)i);
+            }
+        }
+    }
+    sim_rsp(sim, buff);
+}
+
+/**
+ * \brief           Process single command received from stack
+ * \param[in]       sim: Virtual device
+ * \param[in]       cmd: Command string after `AT`
+ */
+static void
+sim_cmd(sim_ctx_t* sim, const char* cmd) {
+    gsm_ll_sim_rule_t rule;
+    char buff[128], host[64];
+    unsigned num, len;
+    uint8_t hit = 0;
+
+    /* Rules have priority over default responses */
+    gsm_sys_mutex_lock(&sim->mutex);
+    sim->stats.cmds++;
+    for (size_t i = 0; i < GSM_LL_SIM_RULES_NUM; i++) {
+        if (sim->rules[i].cmd != NULL && !strncmp(cmd, sim->rules[i].cmd, strlen(sim->rules[i].cmd))) {
+            rule = sim->rules[i];
+            if (sim->rules[i].count && !--sim->rules[i].count) {
+                sim->rules[i].cmd = NULL;       /* Rule is used up */
+            }
+            sim->stats.rules_hit++;
+            hit = 1;
+            break;
+        }
+    }
+    gsm_sys_mutex_unlock(&sim->mutex);
+    if (hit) {
+        if (rule.rsp != NULL) {                 /* No response simulates command timeout */
+            sim_queue(sim, rule.rsp, strlen(rule.rsp), rule.delay);
+        }
+        return;
+    }
+
+#define IS_CMD(str)         (!strncmp(cmd, (str), sizeof(str) - 1))
+    if (IS_CMD("+CPIN?")) {
+        sim_rsp(sim, "\r\n+CPIN: READY\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CGMI")) {
+        sim_rsp(sim, "\r\nSIMCOM_Ltd\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CGMM")) {
+        sim_rsp(sim, "\r\nSIMCOM_SIM800\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CGMR")) {
+        sim_rsp(sim, "\r\nRevision:1418B05SIM800L24\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CGSN")) {
+        sim_rsp(sim, "\r\n861234567890123\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CREG?")) {
+        sim_rsp(sim, "\r\n+CREG: 1,1\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CSQ")) {
+        sim_rsp(sim, "\r\n+CSQ: 20,0\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+COPS?")) {
+        sim_rsp(sim, "\r\n+COPS: 0,0,\"SIM\"\r\n\r\nOK\r\n");
+    } else if (IS_CMD("+CSTT=")) {
+        sim->ip_state = "IP START";
+        sim_rsp(sim, "\r\nOK\r\n");
+    } else if (IS_CMD("+CIICR")) {
+        sim->ip_state = "IP GPRSACT";
+        sim_rsp(sim, "\r\nOK\r\n");
+    } else if (IS_CMD("+CIFSR")) {
+        sim->ip_state = "IP STATUS";
+        sim_rsp(sim, "\r\n" GSM_LL_SIM_LOCAL_IP "\r\n");  /* Device does not send OK */
+    } else if (IS_CMD("+CIPSHUT")) {
+        sim->ip_state = "IP INITIAL";
+        memset(sim->conns, 0x00, sizeof(sim->conns));
+        sim_rsp(sim, "\r\nSHUT OK\r\n");
+    } else if (IS_CMD("+CIPQSEND=")) {
+        sim->qsend = cmd[10] == '1';
+        sim_rsp(sim, "\r\nOK\r\n");
+    } else if (IS_CMD("+CIPSTATUS")) {
+        sim_cipstatus(sim);
+    } else if (IS_CMD("+CIPSTART=")) {
+        sim_conn_t c;
+
+        memset(&c, 0x00, sizeof(c));
+        c.active = 1;
+        if (sscanf(&cmd[10], "%u,\"%3[^\"]\",\"%63[^\"]\",%u", &num, c.type, host, &c.port) != 4
+            || num >= GSM_CFG_MAX_CONNS || sim->conns[num].active) {
+            sim_rsp(sim, "\r\nERROR\r\n");
+            return;
+        }
+        if (host[0] >= '0' && host[0] <= '9') { /* Numeric host is used as remote IP */
+            if (strlen(host) >= sizeof(c.ip)) {
+                sim_rsp(sim, "\r\nERROR\r\n");
+                return;
+            }
+            strcpy(c.ip, host);
+        } else {
+            strcpy(c.ip, GSM_LL_SIM_DNS_IP);
+        }
+        sim->conns[num] = c;
+        snprintf(buff, sizeof(buff), "\r\nOK\r\n\r\n%u, CONNECT OK\r\n", num);
+        sim_rsp(sim, buff);
+    } else if (IS_CMD("+CIPCLOSE=")) {
+        num = (unsigned)atoi(&cmd[10]);
+        if (num >= GSM_CFG_MAX_CONNS || !sim->conns[num].active) {
+            sim_rsp(sim, "\r\nERROR\r\n");
+            return;
+        }
+        sim->conns[num].active = 0;
+        snprintf(buff, sizeof(buff), "\r\n%u, CLOSE OK\r\n", num);
+        sim_rsp(sim, buff);
+    } else if (IS_CMD("+CIPSEND=")) {
+        if (sscanf(&cmd[9], "%u,%u", &num, &len) != 2 || num >= GSM_CFG_MAX_CONNS || !sim->conns[num].active || !len) {
+            sim_rsp(sim, "\r\nERROR\r\n");
+            return;
+        }
+        sim->data_mode = SIM_DATA_CIPSEND;
+        sim->data_num = num;
+        sim->data_len = sim->data_rem = len;
+        sim_rsp(sim, "\r\n> ");
+    } else if (IS_CMD("+FSWRITE=")) {
+        if (sscanf(&cmd[9], "%*[^,],%*u,%u", &len) != 1 || !len) {
+            sim_rsp(sim, "\r\nERROR\r\n");
+            return;
+        }
+        sim->data_mode = SIM_DATA_FSWRITE;
+        sim->data_len = sim->data_rem = len;
+        sim_rsp(sim, "\r\n> ");
+    } else if (IS_CMD("+CMGS=")) {
+        sim->data_mode = SIM_DATA_CMGS;
+        sim_rsp(sim, "\r\n> ");
+    } else if (IS_CMD("+CDNSGIP=")) {
+        if (sscanf(&cmd[9], "\"%63[^\"]\"", host) != 1) {
+            sim_rsp(sim, "\r\nERROR\r\n");
+            return;
+        }
+        snprintf(buff, sizeof(buff), "\r\nOK\r\n\r\n+CDNSGIP: 1,\"%s\",\"" GSM_LL_SIM_DNS_IP "\"\r\n", host);
+        sim_rsp(sim, buff);
+    } else if (IS_CMD("+SSLSETCERT=")) {
+        sim_rsp(sim, "\r\nOK\r\n\r\n+SSLSETCERT: 0\r\n");
+    } else {
+        sim_rsp(sim, "\r\nOK\r\n");             /* Accept everything else */
+    }
+#undef IS_CMD
+}
+
+/**
+ * \brief           Process raw data byte received after "> " prompt
+ * \param[in]       sim: Virtual device
+ * \param[in]       ch: Received byte
+ */
+static void
+sim_data(sim_ctx_t* sim, uint8_t ch) {
+    char buff[48];
+
+    if (sim->data_mode == SIM_DATA_CMGS) {      /* Message is terminated with CTRL+Z or cancelled with ESC */
+        if (ch == 0x1A) {
+            sim_rsp(sim, "\r\n+CMGS: 1\r\n\r\nOK\r\n");
+            sim->data_mode = SIM_DATA_NONE;
+        } else if (ch == 0x1B) {
+            sim_rsp(sim, "\r\nOK\r\n");
+            sim->data_mode = SIM_DATA_NONE;
+        }
+        return;
+    }
+    if (--sim->data_rem > 0) {
+        return;
+    }
+    if (sim->data_mode == SIM_DATA_CIPSEND) {
+        if (sim->qsend) {
+            snprintf(buff, sizeof(buff), "\r\nDATA ACCEPT:%u,%u\r\n", sim->data_num, (unsigned)sim->data_len);
+        } else {
+            snprintf(buff, sizeof(buff), "\r\n%u, SEND OK\r\n", sim->data_num);
+        }
+        sim_rsp(sim, buff);
+    } else {
+        sim_rsp(sim, "\r\nOK\r\n");
+    }
+    sim->data_mode = SIM_DATA_NONE;
+}
+
+/**
+ * \brief           Send data to GSM device, function called from GSM stack when we have data to send
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ * \return          Number of bytes sent
+ */
+static size_t
+send_data(const void* data, size_t len) {
+    sim_ctx_t* sim = sim_get();
+    const uint8_t* d = data;
+
+    for (size_t i = 0; i < len; i++) {
+        if (sim->data_mode != SIM_DATA_NONE) {
+            sim_data(sim, d[i]);
+        } else if (d[i] == '\n') {              /* Command is complete, raw data may follow */
+            sim->line[sim->line_len] = 0;
+            if (sim->line_len >= 2 && sim->line[0] == 'A' && sim->line[1] == 'T') {
+                sim_cmd(sim, &sim->line[2]);
+            }
+            sim->line_len = 0;
+        } else if (d[i] != '\r' && sim->line_len < sizeof(sim->line) - 1) {
+            sim->line[sim->line_len++] = (char)d[i];
+        }
+    }
+    gsm_sys_mutex_lock(&sim->mutex);
+    sim->stats.tx_bytes += len;
+    gsm_sys_mutex_unlock(&sim->mutex);
+    return len;
+}
+
+/**
+ * \brief           Delivery thread, passes queued data to stack after their delay
+ * \param[in]       arg: Virtual device of instance which owns delivery thread
+ */
+static void
+sim_thread_fn(void* arg) {
+    sim_ctx_t* sim = arg;
+    sim_entry_t* e;
+    uint32_t time;
+
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_select(sim->inst);             /* Delivered data belong to owner instance */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    while (1) {
+        gsm_sys_mbox_get(&sim->rsp_mbox, (void **)&e, 0);
+        if (e->stop) {
+            free(e);
+            break;
+        }
+        if (e->delay) {
+            gsm_delay(e->delay);
+        }
+        time = gsm_sys_now();
+#if GSM_CFG_INPUT_USE_PROCESS
+        gsm_input_process(e->data, e->len);
+#else /* GSM_CFG_INPUT_USE_PROCESS */
+        gsm_input(e->data, e->len);
+#endif /* !GSM_CFG_INPUT_USE_PROCESS */
+        time = gsm_sys_now() - time;
+
+        gsm_sys_mutex_lock(&sim->mutex);
+        sim->stats.rx_bytes += e->len;
+        sim->stats.rx_time += time;
+        gsm_sys_mutex_unlock(&sim->mutex);
+        free(e);
+    }
+    sim->thread_running = 0;
+    gsm_sys_thread_terminate(NULL);
+}
+
+/**
+ * \brief           Add response rule
+ *
+ *                  Rules are checked in order of adding, before default responses
+ *
+ * \param[in]       rule: Rule to add, it is copied to internal table.
+ *                      Command and response strings must stay valid while rule is used
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_sim_add_rule(const gsm_ll_sim_rule_t* rule) {
+    sim_ctx_t* sim = sim_get();
+    gsmr_t res = gsmERRMEM;
+
+    if (rule == NULL || rule->cmd == NULL) {
+        return gsmPARERR;
+    }
+    gsm_sys_mutex_lock(&sim->mutex);
+    for (size_t i = 0; i < GSM_LL_SIM_RULES_NUM; i++) {
+        if (sim->rules[i].cmd == NULL) {
+            sim->rules[i] = *rule;
+            res = gsmOK;
+            break;
+        }
+    }
+    gsm_sys_mutex_unlock(&sim->mutex);
+    return res;
+}
+
+/**
+ * \brief           Remove all response rules
+ */
+void
+gsm_ll_sim_clear_rules(void) {
+    sim_ctx_t* sim = sim_get();
+
+    gsm_sys_mutex_lock(&sim->mutex);
+    memset(sim->rules, 0x00, sizeof(sim->rules));
+    gsm_sys_mutex_unlock(&sim->mutex);
+}
+
+/**
+ * \brief           Set delay before each default response
+ * \param[in]       ms: Delay in units of milliseconds
+ */
+void
+gsm_ll_sim_set_latency(uint32_t ms) {
+    sim_get()->rsp_latency = ms;
+}
+
+/**
+ * \brief           Inject raw data from device, such as URC
+ * \param[in]       data: Data to pass to stack
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       delay: Delay before delivery in units of milliseconds
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_sim_inject(const void* data, size_t len, uint32_t delay) {
+    if (data == NULL || !len) {
+        return gsmPARERR;
+    }
+    return sim_queue(sim_get(), data, len, delay);
+}
+
+/**
+ * \brief           Inject network data received on connection with `+RECEIVE` header
+ * \param[in]       num: Connection number
+ * \param[in]       data: Received data
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       delay: Delay before delivery in units of milliseconds
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_sim_receive(uint8_t num, const void* data, size_t len, uint32_t delay) {
+    char hdr[32];
+    uint8_t* buff;
+    size_t hdr_len;
+    gsmr_t res;
+
+    if (data == NULL || !len) {
+        return gsmPARERR;
+    }
+    hdr_len = (size_t)snprintf(hdr, sizeof(hdr), "\r\n+RECEIVE,%u,%u:\r\n", (unsigned)num, (unsigned)len);
+    if ((buff = malloc(hdr_len + len)) == NULL) {
+        return gsmERRMEM;
+    }
+    memcpy(buff, hdr, hdr_len);
+    memcpy(&buff[hdr_len], data, len);
+    res = sim_queue(sim_get(), buff, hdr_len + len, delay); /* Header and data are delivered together */
+    free(buff);
+    return res;
+}
+
+/**
+ * \brief           Get virtual device statistics
+ *
+ *                  Input throughput of stack is `rx_bytes * 1000 / rx_time` bytes per second.
+ *                  Use \ref gsm_mem_getstats for heap usage
+ *
+ * \param[out]      stats: Output variable to save statistics to
+ */
+void
+gsm_ll_sim_get_stats(gsm_ll_sim_stats_t* stats) {
+    sim_ctx_t* sim = sim_get();
+
+    if (stats != NULL) {
+        gsm_sys_mutex_lock(&sim->mutex);
+        *stats = sim->stats;
+        gsm_sys_mutex_unlock(&sim->mutex);
+    }
+}
+
+/**
+ * \brief           Reset virtual device statistics
+ */
+void
+gsm_ll_sim_reset_stats(void) {
+    sim_ctx_t* sim = sim_get();
+
+    gsm_sys_mutex_lock(&sim->mutex);
+    memset(&sim->stats, 0x00, sizeof(sim->stats));
+    gsm_sys_mutex_unlock(&sim->mutex);
+}
+
+/**
+ * \brief           Callback function called from initialization process
+ *
+ * \note            This function may be called multiple times if AT baudrate is changed from application.
+ *                  Virtual device ignores baudrate
+ *
+ * \note            Each instance gets its own virtual device.
+ *                  Memory is assigned to allocator once and shared by all instances
+ *
+ * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure to fill data for communication functions
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_init(gsm_ll_t* ll) {
+    /* Step 1: Configure memory for dynamic allocations */
+    static uint8_t memory[GSM_CFG_MAX_INSTANCES][0x10000];  /* Create memory for dynamic allocations with specific size */
+    sim_ctx_t* sim = sim_get();
+
+    /*
+     * Create memory region(s) of memory.
+     * If device has internal/external memory available,
+     * multiple memories may be used
+     */
+    gsm_mem_region_t mem_regions[] = {
+        { memory[(size_t)(sim - sim_ctx)], sizeof(memory[0]) }
+    };
+    if (sim->initialized) {
+        return gsmOK;                           /* Nothing to reconfigure */
+    }
+    gsm_mem_assignmemory(mem_regions, GSM_ARRAYSIZE(mem_regions));  /* Assign memory to heap of instance, ignored when already assigned */
+
+    /* Step 2: Set AT port send function to use when we have data to transmit */
+    ll->send_fn = send_data;                    /* Set callback function to send data */
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+    ll->rx_flow_fn = NULL;                      /* Virtual device has no flow control lines */
+    ll->tx_ready_fn = NULL;
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+#if GSM_CFG_SLEEP
+    ll->wake_fn = NULL;                         /* Virtual device never sleeps */
+#endif /* GSM_CFG_SLEEP */
+
+    /* Step 3: Create delivery thread instead of configuring AT port */
+    if (!gsm_sys_mutex_create(&sim->mutex)) {
+        return gsmERR;
+    }
+    if (!gsm_sys_mbox_create(&sim->rsp_mbox, GSM_LL_SIM_QUEUE_LEN)) {
+        gsm_sys_mutex_delete(&sim->mutex);
+        return gsmERR;
+    }
+    sim->line_len = 0;
+    sim->data_mode = SIM_DATA_NONE;
+    sim->qsend = 0;
+    sim->ip_state = "IP INITIAL";
+    sim->rsp_latency = GSM_LL_SIM_LATENCY;
+    memset(sim->conns, 0x00, sizeof(sim->conns));
+#if GSM_CFG_MAX_INSTANCES > 1
+    sim->inst = gsm_instance_current();         /* Instance being initialized owns virtual device */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    sim->thread_running = 1;
+    if (!gsm_sys_thread_create(&sim->thread, "gsm_ll_sim", sim_thread_fn, sim, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO)) {
+        sim->thread_running = 0;
+        gsm_sys_mbox_delete(&sim->rsp_mbox);
+        gsm_sys_mutex_delete(&sim->mutex);
+        return gsmERR;
+    }
+    sim->initialized = 1;
+    return gsmOK;
+}
+
+/**
+ * \brief           Stop delivery thread and drop virtual device state
+ * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_ll_deinit(gsm_ll_t* ll) {
+    sim_ctx_t* sim = sim_get();
+    sim_entry_t* e;
+
+    (void)ll;
+    if (!sim->initialized) {
+        return gsmERR;
+    }
+    if ((e = calloc(1, sizeof(*e))) == NULL) {
+        return gsmERRMEM;
+    }
+    e->stop = 1;
+    sim->initialized = 0;                       /* No more data may be queued */
+    gsm_sys_mbox_put(&sim->rsp_mbox, e);        /* Stop after queued data are delivered */
+    while (sim->thread_running) {
+        gsm_delay(1);
+    }
+    gsm_sys_mbox_delete(&sim->rsp_mbox);
+    gsm_sys_mutex_delete(&sim->mutex);
+    return gsmOK;
+}
+
+#endif /* !__DOXYGEN__ */
@@ -83,6 +83,13 @@ gsm_ll_init(gsm_ll_t* ll) {
     /* Step 2: Set AT port send function to use when we have data to transmit */
     if (!initialized) {
         ll->send_fn = send_data;                /* Set callback function to send data */
+#if GSM_CFG_AT_PORT_FLOW_CONTROL
+        ll->rx_flow_fn = NULL;                  /* Set function to drive RTS line, if available */
+        ll->tx_ready_fn = NULL;                 /* Set function to read CTS line, if available */
+#endif /* GSM_CFG_AT_PORT_FLOW_CONTROL */
+#if GSM_CFG_SLEEP
+        ll->wake_fn = NULL;                     /* Set function to drive DTR line, if available */
+#endif /* GSM_CFG_SLEEP */
     }
 
     /* Step 3: Configure AT port to be able to send/receive data to/from GSM device */
@@ -34,16 +34,126 @@
 #include "gsm/gsm.h"
 #include "gsm/gsm_mem.h"
 #include "gsm/gsm_input.h"
+#include "gsm/gsm_buff.h"
 
 #if !__DOXYGEN__
 
-static uint8_t initialized = 0;
+/* Set to `1` to print received data to console */
+#ifndef GSM_LL_WIN32_TRACE_CONSOLE
+#define GSM_LL_WIN32_TRACE_CONSOLE          0
+#endif
 
-DWORD thread_id;
-HANDLE thread_handle;
+/* Set to `1` to write received data to `log_file.txt` */
+#ifndef GSM_LL_WIN32_TRACE_FILE
+#define GSM_LL_WIN32_TRACE_FILE             0
+#endif
+
+/* Size of trace buffer between reader and logger thread */
+#ifndef GSM_LL_WIN32_TRACE_BUFF_SIZE
+#define GSM_LL_WIN32_TRACE_BUFF_SIZE        0x4000
+#endif
+
+#define GSM_LL_WIN32_TRACE                  (GSM_LL_WIN32_TRACE_CONSOLE || GSM_LL_WIN32_TRACE_FILE)
+
+/* State of COM port owned by single instance */
+typedef struct {
+    uint8_t initialized;                        /*!< Set to `1` when COM port is configured */
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_p inst;                        /*!< Instance which owns COM port */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    HANDLE thread_handle;
+    HANDLE comPort;                             /*!< COM port handle */
+    uint8_t data_buffer[0x1000];                /*!< Received data array */
+    HANDLE tx_event;                            /*!< Event for overlapped write completion */
+    CRITICAL_SECTION tx_lock;                   /*!< Serializes writes from multiple threads */
+} ll_ctx_t;
+
+static ll_ctx_t ll_ctx[GSM_CFG_MAX_INSTANCES];
 static void uart_thread(void* param);
-HANDLE comPort;                                 /*!< COM port handle */
-uint8_t data_buffer[0x1000];                    /*!< Received data array */
+
+/**
+ * \brief           Get COM port state of instance selected for current thread
+ * \return          Pointer to COM port state
+ */
+static ll_ctx_t *
+ctx_get(void) {
+#if GSM_CFG_MAX_INSTANCES > 1
+    return &ll_ctx[gsm_instance_get_index(NULL)];
+#else /* GSM_CFG_MAX_INSTANCES > 1 */
+    return &ll_ctx[0];
+#endif /* !(GSM_CFG_MAX_INSTANCES > 1) */
+}
+
+#if GSM_LL_WIN32_TRACE
+static gsm_buff_t trace_buff;                   /*!< Received data waiting for logger thread */
+static CRITICAL_SECTION trace_lock;             /*!< Protects trace buffer pointers */
+static HANDLE trace_event;                      /*!< Signaled when new data are in trace buffer */
+static size_t trace_dropped;                    /*!< Number of bytes dropped because logger was too slow */
+static uint8_t trace_started;                   /*!< Set to `1` when logger thread is running */
+
+/**
+ * \brief           Logger thread writing traced data in big blocks
+ * \param[in]       param: Unused
+ */
+static void
+trace_thread(void* param) {
+    FILE* file = NULL;
+    void* addr;
+    size_t len, dropped;
+
+#if GSM_LL_WIN32_TRACE_FILE
+    fopen_s(&file, "log_file.txt", "w+");       /* Open debug file in write mode */
+#endif /* GSM_LL_WIN32_TRACE_FILE */
+    while (1) {
+        WaitForSingleObject(trace_event, INFINITE);
+        do {
+            EnterCriticalSection(&trace_lock);
+            addr = gsm_buff_get_linear_block_address(&trace_buff);
+            len = gsm_buff_get_linear_block_length(&trace_buff);
+            dropped = trace_dropped;
+            trace_dropped = 0;
+            LeaveCriticalSection(&trace_lock);
+
+            if (len > 0) {                      /* Reader never writes to unread part of buffer */
+#if GSM_LL_WIN32_TRACE_CONSOLE
+                fwrite(addr, 1, len, stdout);
+#endif /* GSM_LL_WIN32_TRACE_CONSOLE */
+                if (file != NULL) {
+                    fwrite(addr, 1, len, file);
+                }
+                EnterCriticalSection(&trace_lock);
+                gsm_buff_skip(&trace_buff, len);
+                LeaveCriticalSection(&trace_lock);
+            }
+            if (dropped > 0) {
+                printf("\r\n[LL] %d bytes not traced\r\n", (int)dropped);
+            }
+        } while (len > 0);
+#if GSM_LL_WIN32_TRACE_CONSOLE
+        fflush(stdout);
+#endif /* GSM_LL_WIN32_TRACE_CONSOLE */
+        if (file != NULL) {
+            fflush(file);                       /* Flush once per batch */
+        }
+    }
+}
+
+/**
+ * \brief           Queue received data for logger thread
+ * \param[in]       data: Received data
+ * \param[in]       len: Number of received bytes
+ */
+static void
+trace_write(const void* data, size_t len) {
+    size_t written;
+
+    EnterCriticalSection(&trace_lock);
+    written = gsm_buff_write(&trace_buff, data, len);
+    trace_dropped += len - written;
+    LeaveCriticalSection(&trace_lock);
+    SetEvent(trace_event);
+}
+#endif /* GSM_LL_WIN32_TRACE */
 
 /**
  * \brief           Send data to GSM device, function called from GSM stack when we have data to send
@@ -53,50 +163,76 @@ uint8_t data_buffer[0x1000];                    /*!< Received data array */
  */
 static size_t
 send_data(const void* data, size_t len) {
-	if (comPort != NULL) {
-		WriteFile(comPort, data, len, NULL, NULL);
-        FlushFileBuffers(comPort);
-		return len;
-	}
-    return 0;
+    ll_ctx_t* ctx = ctx_get();
+    OVERLAPPED ov = { 0 };
+    DWORD written = 0;
+
+    if (ctx->comPort == NULL) {
+        return 0;
+    }
+    EnterCriticalSection(&ctx->tx_lock);
+    ov.hEvent = ctx->tx_event;
+    if (!WriteFile(ctx->comPort, data, (DWORD)len, NULL, &ov) && GetLastError() != ERROR_IO_PENDING) {
+        written = 0;
+    } else {
+        GetOverlappedResult(ctx->comPort, &ov, &written, TRUE); /* Wait until data are in driver */
+    }
+    LeaveCriticalSection(&ctx->tx_lock);
+    return (size_t)written;
 }
 
 /**
  * \brief			Configure UART (USB to UART)
+ *
+ * COM ports are opened for exclusive access, each instance gets first port
+ * from the list which is not already used by another instance
+ *
+ * \param[in]       ctx: COM port state of instance
+ * \param[in]       baudrate: Baudrate in units of bits per second
  */
 static void
-configure_uart(uint32_t baudrate) {
+configure_uart(ll_ctx_t* ctx, uint32_t baudrate) {
 	DCB dcb = { 0 };
 	dcb.DCBlength = sizeof(dcb);
 
     /*
      * On first call,
      * create virtual file on selected COM port and open it 
-     * as generic read and write
+     * as generic read and write with overlapped I/O
      */
-	if (!initialized) {
+	if (!ctx->initialized) {
         static const LPCWSTR com_ports[] = {
             L"\\\\.\\COM23",
             L"\\\\.\\COM9"
         };
         for (size_t i = 0; i < sizeof(com_ports) / sizeof(com_ports[0]); i++) {
-            comPort = CreateFile(com_ports[i],
+            ctx->comPort = CreateFile(com_ports[i],
                 GENERIC_READ | GENERIC_WRITE,
                 0,
                 0,
                 OPEN_EXISTING,
-                0,
+                FILE_FLAG_OVERLAPPED,
                 NULL
             );
-            if (GetCommState(comPort, &dcb)) {
+            if (GetCommState(ctx->comPort, &dcb)) {
                 printf("COM PORT %s opened!\r\n", (const char *)com_ports[i]);
                 break;
             }
+            if (ctx->comPort != INVALID_HANDLE_VALUE) {
+                CloseHandle(ctx->comPort);
+            }
+            ctx->comPort = NULL;
+        }
+        if (ctx->comPort == NULL) {
+            printf("Cannot open COM PORT\r\n");
+            return;
         }
+        ctx->tx_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+        InitializeCriticalSection(&ctx->tx_lock);
 	}
 
     /* Configure COM port parameters */
-	if (GetCommState(comPort, &dcb)) {
+	if (GetCommState(ctx->comPort, &dcb)) {
         COMMTIMEOUTS timeouts;
 
         dcb.BaudRate = baudrate;
@@ -104,70 +240,103 @@ configure_uart(uint32_t baudrate) {
         dcb.Parity = NOPARITY;
         dcb.StopBits = ONESTOPBIT;
 
-        if (!SetCommState(comPort, &dcb)) {
+        if (!SetCommState(ctx->comPort, &dcb)) {
             printf("Cannot set COM PORT info\r\n");
         }
-        if (GetCommTimeouts(comPort, &timeouts)) {
-            /* Set timeout to return immediatelly from ReadFile function */
+        if (GetCommTimeouts(ctx->comPort, &timeouts)) {
+            /* Set timeout to return immediatelly from ReadFile function with bytes already received */
             timeouts.ReadIntervalTimeout = MAXDWORD;
             timeouts.ReadTotalTimeoutConstant = 0;
             timeouts.ReadTotalTimeoutMultiplier = 0;
-            if (!SetCommTimeouts(comPort, &timeouts)) {
+            if (!SetCommTimeouts(ctx->comPort, &timeouts)) {
                 printf("Cannot set COM PORT timeouts\r\n");
             }
-            GetCommTimeouts(comPort, &timeouts);
+            GetCommTimeouts(ctx->comPort, &timeouts);
         } else {
             printf("Cannot get COM PORT timeouts\r\n");
         }
+        SetupComm(ctx->comPort, sizeof(ctx->data_buffer), sizeof(ctx->data_buffer));  /* Ask driver for big queues */
+        SetCommMask(ctx->comPort, EV_RXCHAR);   /* Wakeup reader when data arrive */
     } else {
         printf("Cannot get COM PORT info\r\n");
     }
 
     /* On first function call, create a thread to read data from COM port */
-	if (!initialized) {
-		thread_handle = CreateThread(0, 0, (LPTHREAD_START_ROUTINE)uart_thread, NULL, 0, 0);
+	if (!ctx->initialized) {
+#if GSM_LL_WIN32_TRACE
+        if (!trace_started) {                   /* Single logger for all instances */
+            gsm_buff_init(&trace_buff, GSM_LL_WIN32_TRACE_BUFF_SIZE);
+            InitializeCriticalSection(&trace_lock);
+            trace_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+            CreateThread(0, 0, (LPTHREAD_START_ROUTINE)trace_thread, NULL, 0, 0);
+            trace_started = 1;
+        }
+#endif /* GSM_LL_WIN32_TRACE */
+		ctx->thread_handle = CreateThread(0, 0, (LPTHREAD_START_ROUTINE)uart_thread, ctx, 0, 0);
 	}
 }
 
 /**
- * \brief			UART thread
+ * \brief           Read all data currently received by driver and send them to upper layer
+ * \param[in]       ctx: COM port state of instance
+ * \param[in]       ov: Overlapped structure with event used for reading
  */
 static void
-uart_thread(void* param) {
-	DWORD bytes_read;
-    gsm_sys_sem_t sem;
-    FILE* file = NULL;
+uart_read_available(ll_ctx_t* ctx, OVERLAPPED* ov) {
+    DWORD bytes_read, errors;
+    COMSTAT stat;
 
-	while (comPort == NULL);
+    do {
+        if (!ClearCommError(ctx->comPort, &errors, &stat) || !stat.cbInQue) {
+            break;                              /* Nothing more to read */
+        }
+        bytes_read = 0;
+        if (!ReadFile(ctx->comPort, ctx->data_buffer, min(stat.cbInQue, (DWORD)sizeof(ctx->data_buffer)), NULL, ov)
+            && GetLastError() != ERROR_IO_PENDING) {
+            break;
+        }
+        if (!GetOverlappedResult(ctx->comPort, ov, &bytes_read, TRUE)) {
+            break;
+        }
+        if (bytes_read > 0) {
+            /* Send received data to input processing module */
+            gsm_input_process(ctx->data_buffer, (size_t)bytes_read);
+#if GSM_LL_WIN32_TRACE
+            trace_write(ctx->data_buffer, (size_t)bytes_read);
+#endif /* GSM_LL_WIN32_TRACE */
+        }
+    } while (bytes_read > 0);
+}
 
-    gsm_sys_sem_create(&sem, 0);                /* Create semaphore for delay functions */
+/**
+ * \brief			UART thread
+ *
+ * Thread sleeps in \ref WaitCommEvent until device sends data,
+ * then reads everything driver already has in one go
+ *
+ * \param[in]       param: COM port state of instance which owns COM port
+ */
+static void
+uart_thread(void* param) {
+    ll_ctx_t* ctx = param;
+    OVERLAPPED ov_evt = { 0 }, ov_read = { 0 };
+    DWORD mask, dummy;
 
-    fopen_s(&file, "log_file.txt", "w+");       /* Open debug file in write mode */
+#if GSM_CFG_MAX_INSTANCES > 1
+    gsm_instance_select(ctx->inst);             /* Received data belong to owner instance */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
+    ov_evt.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    ov_read.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
 	while (1) {
-        /*
-         * Try to read data from COM port
-         * and send it to upper layer for processing
-         */
-        do {
-            ReadFile(comPort, data_buffer, sizeof(data_buffer), &bytes_read, NULL);
-            if (bytes_read > 0) {
-                DWORD i;
-                for (i = 0; i < bytes_read; i++) {
-                    printf("%c", data_buffer[i]);
-                }
-                /* Send received data to input processing module */
-                gsm_input_process(data_buffer, (size_t)bytes_read);
-
-                /* Write received data to output debug file */
-                if (file != NULL) {
-                    fwrite(data_buffer, 1, bytes_read, file);
-                    fflush(file);
-                }
+        mask = 0;
+        if (!WaitCommEvent(ctx->comPort, &mask, &ov_evt)) {
+            if (GetLastError() != ERROR_IO_PENDING
+                || !GetOverlappedResult(ctx->comPort, &ov_evt, &dummy, TRUE)) {
+                Sleep(10);                      /* Port error, do not spin */
+                continue;
             }
-        } while (bytes_read == (DWORD)sizeof(data_buffer));
-
-        /* Implement delay to allow other tasks processing */
-        gsm_sys_sem_wait(&sem, 1);
+        }
+        uart_read_available(ctx, &ov_read);
 	}
 }
 
@@ -180,13 +349,17 @@ uart_thread(void* param) {
  * \note            This function may be called from different threads in GSM stack when using OS.
  *                  When \ref GSM_CFG_INPUT_USE_PROCESS is set to 1, this function may be called from user UART thread.
  *
+ * \note            Each instance opens its own COM port.
+ *                  Memory is assigned to allocator once and shared by all instances
+ *
  * \param[in,out]   ll: Pointer to \ref gsm_ll_t structure to fill data for communication functions
  * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
  */
 gsmr_t
 gsm_ll_init(gsm_ll_t* ll) {
     /* Step 1: Configure memory for dynamic allocations */
-    static uint8_t memory[0x10000];             /* Create memory for dynamic allocations with specific size */
+    static uint8_t memory[GSM_CFG_MAX_INSTANCES][0x10000];  /* Create memory for dynamic allocations with specific size */
+    ll_ctx_t* ctx = ctx_get();
 
     /*
      * Create memory region(s) of memory.
@@ -194,20 +367,21 @@ gsm_ll_init(gsm_ll_t* ll) {
      * multiple memories may be used
      */
     gsm_mem_region_t mem_regions[] = {
-        { memory, sizeof(memory) }
+        { memory[(size_t)(ctx - ll_ctx)], sizeof(memory[0]) }
     };
-    if (!initialized) {
-        gsm_mem_assignmemory(mem_regions, GSM_ARRAYSIZE(mem_regions));  /* Assign memory for allocations to GSM library */
-    }
+    gsm_mem_assignmemory(mem_regions, GSM_ARRAYSIZE(mem_regions));  /* Assign memory to heap of instance, ignored when already assigned */
     
     /* Step 2: Set AT port send function to use when we have data to transmit */
-    if (!initialized) {
+    if (!ctx->initialized) {
         ll->send_fn = send_data;                /* Set callback function to send data */
+#if GSM_CFG_MAX_INSTANCES > 1
+        ctx->inst = gsm_instance_current();     /* Instance being initialized owns COM port */
+#endif /* GSM_CFG_MAX_INSTANCES > 1 */
     }
 
     /* Step 3: Configure AT port to be able to send/receive data to/from GSM device */
-    configure_uart(ll->uart.baudrate);          /* Initialize UART for communication */
-    initialized = 1;
+    configure_uart(ctx, ll->uart.baudrate);     /* Initialize UART for communication */
+    ctx->initialized = 1;
     return gsmOK;
 }
 
@@ -0,0 +1,491 @@
+/**
+ * \file            gsm_sys_cmsis_os2.c
+ * \brief           System dependant functions for CMSIS-RTOS2 with static allocation
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "system/gsm_sys.h"
+#include "string.h"
+#include "cmsis_os2.h"
+
+#if !__DOXYGEN__
+
+/*
+ * Kernel objects never use RTOS heap. Control blocks, queue storage and
+ * thread stacks are taken from fixed slots below.
+ * Slots are only taken and returned from thread context, with kernel locked
+ */
+
+#define CB_WORDS                ((GSM_SYS_CMSIS_OS2_CB_SIZE + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+#define MBOX_WORDS              ((GSM_SYS_CMSIS_OS2_MBOX_LEN * GSM_SYS_CMSIS_OS2_MBOX_ENTRY_SIZE + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+#define STACK_WORDS             ((GSM_SYS_CMSIS_OS2_THREAD_STACK_SIZE + sizeof(uint64_t) - 1) / sizeof(uint64_t))
+#define SLOT_NUM(x)             (sizeof(x) / sizeof((x)[0]))
+
+/**
+ * \brief           Slot for mutex or semaphore
+ */
+typedef struct {
+    uint64_t cb[CB_WORDS];                      /*!< Control block memory */
+    void* id;                                   /*!< Object ID or `NULL` when slot is free */
+} os2_obj_slot_t;
+
+/**
+ * \brief           Slot for message queue
+ */
+typedef struct {
+    uint64_t cb[CB_WORDS];                      /*!< Control block memory */
+    uint64_t mem[MBOX_WORDS];                   /*!< Entries memory */
+    osMessageQueueId_t id;                      /*!< Queue ID or `NULL` when slot is free */
+    uint32_t peak;                              /*!< Maximal number of entries ever in queue */
+} os2_mbox_slot_t;
+
+/**
+ * \brief           Slot for thread
+ */
+typedef struct {
+    uint64_t cb[CB_WORDS];                      /*!< Control block memory */
+    uint64_t stack[STACK_WORDS];                /*!< Stack memory */
+    osThreadId_t id;                            /*!< Thread ID or `NULL` when slot is free */
+    uint8_t terminated;                         /*!< Set to `1` when thread terminated itself, slot is reused once kernel confirms */
+} os2_thread_slot_t;
+
+static os2_obj_slot_t mutex_slots[GSM_SYS_CMSIS_OS2_MUTEX_NUM];
+static os2_obj_slot_t sem_slots[GSM_SYS_CMSIS_OS2_SEM_NUM];
+static os2_mbox_slot_t mbox_slots[GSM_SYS_CMSIS_OS2_MBOX_NUM];
+static os2_thread_slot_t thread_slots[GSM_SYS_CMSIS_OS2_THREAD_NUM];
+
+static osMutexId_t sys_mutex;                   /* Mutex ID for main protection */
+
+/**
+ * \brief           Convert stack timeout to kernel ticks
+ * \param[in]       timeout: Timeout in units of milliseconds, `0` means wait forever
+ * \return          Timeout in kernel ticks
+ */
+static uint32_t
+ms_to_ticks(uint32_t timeout) {
+    uint32_t freq = osKernelGetTickFreq();
+    if (!timeout) {
+        return osWaitForever;
+    }
+    if (freq == 1000) {
+        return timeout;
+    }
+    timeout = (uint32_t)(((uint64_t)timeout * freq + 999U) / 1000U);
+    return timeout ? timeout : 1;
+}
+
+/**
+ * \brief           Take free object slot
+ * \param[in]       slots: Array of slots
+ * \param[in]       num: Number of slots in array
+ * \return          Free slot or `NULL` if none available
+ */
+static os2_obj_slot_t *
+obj_slot_take(os2_obj_slot_t* slots, size_t num) {
+    os2_obj_slot_t* s = NULL;
+    int32_t lock;
+
+    lock = osKernelLock();
+    for (size_t i = 0; i < num; i++) {
+        if (slots[i].id == NULL) {
+            slots[i].id = &slots[i];            /* Reserve it until real ID is known */
+            s = &slots[i];
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+    return s;
+}
+
+/**
+ * \brief           Return object slot by object ID
+ * \param[in]       slots: Array of slots
+ * \param[in]       num: Number of slots in array
+ * \param[in]       id: Object ID
+ */
+static void
+obj_slot_give(os2_obj_slot_t* slots, size_t num, void* id) {
+    int32_t lock;
+
+    lock = osKernelLock();
+    for (size_t i = 0; i < num; i++) {
+        if (slots[i].id == id) {
+            slots[i].id = NULL;
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+}
+
+uint8_t
+gsm_sys_init(void) {
+    gsm_sys_mutex_create(&sys_mutex);           /* Create system mutex */
+    return 1;
+}
+
+uint32_t
+gsm_sys_now(void) {
+    uint32_t freq = osKernelGetTickFreq();
+    uint32_t tick = osKernelGetTickCount();
+    return freq == 1000 ? tick : (uint32_t)(((uint64_t)tick * 1000U) / freq);
+}
+
+uint8_t
+gsm_sys_protect(void) {
+    gsm_sys_mutex_lock(&sys_mutex);             /* Lock system and protect it */
+    return 1;
+}
+
+uint8_t
+gsm_sys_unprotect(void) {
+    gsm_sys_mutex_unlock(&sys_mutex);           /* Release lock */
+    return 1;
+}
+
+uint8_t
+gsm_sys_mutex_create(gsm_sys_mutex_t* p) {
+    osMutexAttr_t attr = { 0 };
+    os2_obj_slot_t* s;
+
+    *p = NULL;
+    if ((s = obj_slot_take(mutex_slots, SLOT_NUM(mutex_slots))) == NULL) {
+        return 0;
+    }
+    attr.attr_bits = osMutexRecursive | osMutexPrioInherit;
+    attr.cb_mem = s->cb;
+    attr.cb_size = sizeof(s->cb);
+    *p = osMutexNew(&attr);                     /* Create recursive mutex */
+    s->id = *p;                                 /* Slot is free again if creation failed */
+    return *p != NULL;
+}
+
+uint8_t
+gsm_sys_mutex_delete(gsm_sys_mutex_t* p) {
+    uint8_t res = osMutexDelete(*p) == osOK;
+    obj_slot_give(mutex_slots, SLOT_NUM(mutex_slots), *p);
+    return res;
+}
+
+uint8_t
+gsm_sys_mutex_lock(gsm_sys_mutex_t* p) {
+    return osMutexAcquire(*p, osWaitForever) == osOK;   /* Wait forever for mutex */
+}
+
+uint8_t
+gsm_sys_mutex_unlock(gsm_sys_mutex_t* p) {
+    return osMutexRelease(*p) == osOK;          /* Release mutex */
+}
+
+uint8_t
+gsm_sys_mutex_isvalid(gsm_sys_mutex_t* p) {
+    return *p != NULL;                          /* Check if mutex is valid */
+}
+
+uint8_t
+gsm_sys_mutex_invalid(gsm_sys_mutex_t* p) {
+    *p = GSM_SYS_MUTEX_NULL;                    /* Set mutex as invalid */
+    return 1;
+}
+
+uint8_t
+gsm_sys_sem_create(gsm_sys_sem_t* p, uint8_t cnt) {
+    osSemaphoreAttr_t attr = { 0 };
+    os2_obj_slot_t* s;
+
+    *p = NULL;
+    if ((s = obj_slot_take(sem_slots, SLOT_NUM(sem_slots))) == NULL) {
+        return 0;
+    }
+    attr.cb_mem = s->cb;
+    attr.cb_size = sizeof(s->cb);
+    *p = osSemaphoreNew(1, !!cnt, &attr);       /* Create binary semaphore */
+    s->id = *p;
+    return *p != NULL;
+}
+
+uint8_t
+gsm_sys_sem_delete(gsm_sys_sem_t* p) {
+    uint8_t res = osSemaphoreDelete(*p) == osOK;
+    obj_slot_give(sem_slots, SLOT_NUM(sem_slots), *p);
+    return res;
+}
+
+uint32_t
+gsm_sys_sem_wait(gsm_sys_sem_t* p, uint32_t timeout) {
+    uint32_t tick = gsm_sys_now();              /* Get start tick time */
+    return (osSemaphoreAcquire(*p, ms_to_ticks(timeout)) == osOK) ? (gsm_sys_now() - tick) : GSM_SYS_TIMEOUT;
+}
+
+uint8_t
+gsm_sys_sem_release(gsm_sys_sem_t* p) {
+    return osSemaphoreRelease(*p) == osOK;      /* Release semaphore, may be called from interrupt */
+}
+
+uint8_t
+gsm_sys_sem_isvalid(gsm_sys_sem_t* p) {
+    return *p != NULL;                          /* Check if valid */
+}
+
+uint8_t
+gsm_sys_sem_invalid(gsm_sys_sem_t* p) {
+    *p = GSM_SYS_SEM_NULL;                      /* Invaldiate semaphore */
+    return 1;
+}
+
+/**
+ * \brief           Update maximal number of entries after successful write to queue
+ * \note            Update is not atomic, concurrent writers may report slightly lower value
+ * \param[in]       id: Message queue ID
+ */
+static void
+mbox_peak_update(osMessageQueueId_t id) {
+    uint32_t cnt = osMessageQueueGetCount(id);
+
+    for (size_t i = 0; i < SLOT_NUM(mbox_slots); i++) {
+        if (mbox_slots[i].id == id) {
+            if (cnt > mbox_slots[i].peak) {
+                mbox_slots[i].peak = cnt;
+            }
+            break;
+        }
+    }
+}
+
+uint8_t
+gsm_sys_mbox_create(gsm_sys_mbox_t* b, size_t size) {
+    osMessageQueueAttr_t attr = { 0 };
+    os2_mbox_slot_t* s = NULL;
+    int32_t lock;
+
+    *b = NULL;
+    if (size == 0 || size > GSM_SYS_CMSIS_OS2_MBOX_LEN) {
+        return 0;                               /* Does not fit to static memory */
+    }
+    lock = osKernelLock();
+    for (size_t i = 0; i < SLOT_NUM(mbox_slots); i++) {
+        if (mbox_slots[i].id == NULL) {
+            mbox_slots[i].id = (osMessageQueueId_t)&mbox_slots[i];
+            s = &mbox_slots[i];
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+    if (s == NULL) {
+        return 0;
+    }
+    attr.cb_mem = s->cb;
+    attr.cb_size = sizeof(s->cb);
+    attr.mq_mem = s->mem;
+    attr.mq_size = (uint32_t)(size * GSM_SYS_CMSIS_OS2_MBOX_ENTRY_SIZE);
+    s->peak = 0;
+    *b = osMessageQueueNew((uint32_t)size, sizeof(void *), &attr);
+    s->id = *b;
+    return *b != NULL;
+}
+
+uint8_t
+gsm_sys_mbox_delete(gsm_sys_mbox_t* b) {
+    int32_t lock;
+
+    if (osMessageQueueGetCount(*b)) {           /* We still have messages in queue, should not delete queue */
+        return 0;                               /* Return error as we still have entries in message queue */
+    }
+    if (osMessageQueueDelete(*b) != osOK) {
+        return 0;
+    }
+    lock = osKernelLock();
+    for (size_t i = 0; i < SLOT_NUM(mbox_slots); i++) {
+        if (mbox_slots[i].id == *b) {
+            mbox_slots[i].id = NULL;
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+    return 1;
+}
+
+uint32_t
+gsm_sys_mbox_put(gsm_sys_mbox_t* b, void* m) {
+    uint32_t tick = gsm_sys_now();              /* Get start time */
+    if (osMessageQueuePut(*b, &m, 0, osWaitForever) == osOK) {
+        mbox_peak_update(*b);
+        return gsm_sys_now() - tick;
+    }
+    return GSM_SYS_TIMEOUT;
+}
+
+uint32_t
+gsm_sys_mbox_get(gsm_sys_mbox_t* b, void** m, uint32_t timeout) {
+    uint32_t tick = gsm_sys_now();              /* Get current time */
+    if (osMessageQueueGet(*b, m, NULL, ms_to_ticks(timeout)) == osOK) {
+        return gsm_sys_now() - tick;            /* Return time required for reading message */
+    }
+    return GSM_SYS_TIMEOUT;
+}
+
+uint8_t
+gsm_sys_mbox_putnow(gsm_sys_mbox_t* b, void* m) {
+    if (osMessageQueuePut(*b, &m, 0, 0) == osOK) {  /* Put new message without timeout, may be called from interrupt */
+        mbox_peak_update(*b);
+        return 1;
+    }
+    return 0;
+}
+
+uint8_t
+gsm_sys_mbox_getnow(gsm_sys_mbox_t* b, void** m) {
+    return osMessageQueueGet(*b, m, NULL, 0) == osOK;
+}
+
+uint8_t
+gsm_sys_mbox_isvalid(gsm_sys_mbox_t* b) {
+    return *b != NULL;                          /* Return status if message box is valid */
+}
+
+uint8_t
+gsm_sys_mbox_invalid(gsm_sys_mbox_t* b) {
+    *b = GSM_SYS_MBOX_NULL;                     /* Invalidate message box */
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_create(gsm_sys_thread_t* t, const char* name, gsm_sys_thread_fn thread_func, void* const arg, size_t stack_size, gsm_sys_thread_prio_t prio) {
+    osThreadAttr_t attr = { 0 };
+    os2_thread_slot_t* s = NULL;
+    osThreadId_t id;
+    osThreadState_t state;
+    int32_t lock;
+
+    if (stack_size > sizeof(s->stack)) {
+        return 0;                               /* Does not fit to static stack */
+    }
+    lock = osKernelLock();
+    for (size_t i = 0; i < SLOT_NUM(thread_slots); i++) {
+        if (thread_slots[i].id != NULL && thread_slots[i].terminated) {
+            state = osThreadGetState(thread_slots[i].id);
+            if (state == osThreadTerminated || state == osThreadInactive || state == osThreadError) {
+                thread_slots[i].id = NULL;      /* Thread is gone, stack may be reused */
+            }
+        }
+        if (thread_slots[i].id == NULL) {
+            thread_slots[i].id = (osThreadId_t)&thread_slots[i];
+            thread_slots[i].terminated = 0;
+            s = &thread_slots[i];
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+    if (s == NULL) {
+        return 0;
+    }
+
+    attr.name = name;
+    attr.cb_mem = s->cb;
+    attr.cb_size = sizeof(s->cb);
+    attr.stack_mem = s->stack;
+    attr.stack_size = sizeof(s->stack);
+    attr.priority = prio;
+    id = osThreadNew((osThreadFunc_t)thread_func, arg, &attr);
+    s->id = id;
+    if (t != NULL) {
+        *t = id;
+    }
+    return id != NULL;
+}
+
+uint8_t
+gsm_sys_thread_terminate(gsm_sys_thread_t* t) {
+    osThreadId_t id = t != NULL ? *t : osThreadGetId();
+    int32_t lock;
+
+    lock = osKernelLock();
+    for (size_t i = 0; i < SLOT_NUM(thread_slots); i++) {
+        if (thread_slots[i].id == id) {
+            thread_slots[i].terminated = 1;     /* Slot is released on next create once thread is really gone */
+            break;
+        }
+    }
+    osKernelRestoreLock(lock);
+    osThreadTerminate(id);                      /* Terminate thread */
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_yield(void) {
+    osThreadYield();                            /* Yield current thread */
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_notify(gsm_sys_thread_t* t) {
+    if (*t == NULL) {
+        return 0;
+    }
+    /* Thread flags can be set from interrupt context */
+    return !(osThreadFlagsSet(*t, GSM_SYS_CMSIS_OS2_WAKEUP_FLAG) & osFlagsError);
+}
+
+uint32_t
+gsm_sys_thread_notify_wait(uint32_t timeout) {
+    uint32_t tick = gsm_sys_now();
+    if (osThreadFlagsWait(GSM_SYS_CMSIS_OS2_WAKEUP_FLAG, osFlagsWaitAny, ms_to_ticks(timeout)) & osFlagsError) {
+        return GSM_SYS_TIMEOUT;
+    }
+    return gsm_sys_now() - tick;
+}
+
+uint8_t
+gsm_sys_thread_get_stats(gsm_sys_thread_t* t, gsm_sys_thread_stats_t* stats) {
+    memset(stats, 0x00, sizeof(*stats));
+    if (*t == NULL) {
+        return 0;
+    }
+    stats->stack_size = osThreadGetStackSize(*t);
+    stats->stack_free_min = osThreadGetStackSpace(*t);  /* High-water mark, as kernel reports it */
+    return 1;                                   /* Run time is not available through CMSIS-RTOS2 */
+}
+
+uint8_t
+gsm_sys_mbox_get_stats(gsm_sys_mbox_t* b, gsm_sys_mbox_stats_t* stats) {
+    memset(stats, 0x00, sizeof(*stats));
+    if (*b == NULL) {
+        return 0;
+    }
+    stats->size = osMessageQueueGetCapacity(*b);
+    stats->used = osMessageQueueGetCount(*b);
+    for (size_t i = 0; i < SLOT_NUM(mbox_slots); i++) {
+        if (mbox_slots[i].id == *b) {
+            stats->peak = mbox_slots[i].peak;
+            break;
+        }
+    }
+    return 1;
+}
+
+#endif /* !__DOXYGEN__ */
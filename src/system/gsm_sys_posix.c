@@ -0,0 +1,582 @@
+/**	
+ * \file            gsm_sys_posix.c
+ * \brief           System dependant functions for POSIX (Linux)
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif /* _GNU_SOURCE */
+#include "system/gsm_sys.h"
+#include "string.h"
+#include "stdlib.h"
+#include "time.h"
+#include "limits.h"
+#include "sched.h"
+#include "unistd.h"
+#include "sys/syscall.h"
+#include "linux/futex.h"
+
+#if !__DOXYGEN__
+
+/*
+ * Semaphores and message queues use atomic operations and wait on Linux futex.
+ * Threads only enter kernel when they have to sleep or when other thread sleeps
+ */
+
+/**
+ * \brief           Wakeup point, incremented on each signal
+ */
+typedef struct {
+    uint32_t seq;                               /*!< Futex word, changed on every signal */
+    uint32_t waiters;                           /*!< Number of threads sleeping on futex */
+} posix_evt_t;
+
+/**
+ * \brief           Binary semaphore
+ */
+struct gsm_sys_posix_sem {
+    uint32_t val;                               /*!< Futex word, `1` when semaphore is available */
+    uint32_t waiters;                           /*!< Number of threads sleeping on futex */
+};
+
+/**
+ * \brief           Message queue entry
+ */
+typedef struct {
+    size_t seq;                                 /*!< Entry sequence number */
+    void* data;                                 /*!< Entry data */
+} posix_mbox_cell_t;
+
+/**
+ * \brief           Bounded lock-free message queue, safe for multiple writers and readers
+ *
+ * Each cell has sequence number telling writer and reader when cell is ready for them.
+ * Number of cells is rounded up to power of two, number of entries is limited to requested size
+ */
+struct gsm_sys_posix_mbox {
+    size_t mask;                                /*!< Number of cells minus one */
+    size_t size;                                /*!< Maximal number of entries in queue */
+    size_t in;                                  /*!< Next write position */
+    size_t out;                                 /*!< Next read position */
+    size_t peak;                                /*!< Maximal number of entries ever in queue */
+    posix_evt_t not_empty;                      /*!< Signaled after each write */
+    posix_evt_t not_full;                       /*!< Signaled after each read */
+    posix_mbox_cell_t cells[1];                 /*!< Queue entries */
+};
+
+/**
+ * \brief           Thread start information
+ */
+typedef struct {
+    gsm_sys_thread_fn fn;                       /*!< Thread function */
+    void* arg;                                  /*!< Thread argument */
+    uint8_t paint;                              /*!< Set to `1` to fill unused stack with pattern at start */
+} posix_thread_start_t;
+
+/* Pattern of unused stack memory, used to find stack high-water mark */
+#define POSIX_STACK_PATTERN         0xA5
+
+static struct timespec sys_start_time;
+static pthread_mutex_t sys_mutex = PTHREAD_MUTEX_INITIALIZER;   /* Mutex for main protection */
+static __thread uint32_t sys_protect_depth;     /* Nesting level of protection in current thread */
+
+static void
+futex_wait(uint32_t* addr, uint32_t val, uint32_t timeout) {
+    struct timespec ts;
+
+    if (timeout) {
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (long)(timeout % 1000) * 1000000L;
+    }
+    syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, timeout ? &ts : NULL, NULL, 0);
+}
+
+static void
+futex_wake(uint32_t* addr, int cnt) {
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, cnt, NULL, NULL, 0);
+}
+
+static void
+evt_signal(posix_evt_t* e) {
+    __atomic_add_fetch(&e->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&e->waiters, __ATOMIC_SEQ_CST)) {
+        futex_wake(&e->seq, 1);                 /* Somebody sleeps, wake one thread */
+    }
+}
+
+static uint32_t
+osKernelSysTick(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((now.tv_sec - sys_start_time.tv_sec) * 1000
+        + (now.tv_nsec - sys_start_time.tv_nsec) / 1000000L);
+}
+
+/**
+ * \brief           Get remaining wait time
+ * \param[in]       start: Start time of wait
+ * \param[in]       timeout: Timeout, `0` for unlimited time
+ * \param[out]      rem: Remaining time, `0` for unlimited time
+ * \return          `1` when time is left, `0` when timeout expired
+ */
+static uint8_t
+wait_remaining(uint32_t start, uint32_t timeout, uint32_t* rem) {
+    uint32_t spent = osKernelSysTick() - start;
+
+    if (!timeout) {
+        *rem = 0;
+        return 1;
+    }
+    if (spent >= timeout) {
+        return 0;
+    }
+    *rem = timeout - spent;
+    return 1;
+}
+
+static uint8_t
+mbox_try_put(struct gsm_sys_posix_mbox* mbox, void* m) {
+    posix_mbox_cell_t* c;
+    size_t pos, seq;
+    intptr_t diff;
+
+    pos = __atomic_load_n(&mbox->in, __ATOMIC_RELAXED);
+    for (;;) {
+        c = &mbox->cells[pos & mbox->mask];
+        seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+        diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {                        /* Cell is free, try to reserve it */
+            if ((intptr_t)(pos - __atomic_load_n(&mbox->out, __ATOMIC_ACQUIRE)) >= (intptr_t)mbox->size) {
+                return 0;                       /* Queue has requested number of entries */
+            }
+            if (__atomic_compare_exchange_n(&mbox->in, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0;                           /* Queue is full */
+        } else {
+            pos = __atomic_load_n(&mbox->in, __ATOMIC_RELAXED); /* Other writer was faster */
+        }
+    }
+    c->data = m;
+    __atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);   /* Publish entry to readers */
+
+    /* Track maximal queue depth */
+    seq = pos + 1 - __atomic_load_n(&mbox->out, __ATOMIC_RELAXED);
+    pos = __atomic_load_n(&mbox->peak, __ATOMIC_RELAXED);
+    while (seq > pos && seq <= mbox->size
+        && !__atomic_compare_exchange_n(&mbox->peak, &pos, seq, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+    evt_signal(&mbox->not_empty);
+    return 1;
+}
+
+static uint8_t
+mbox_try_get(struct gsm_sys_posix_mbox* mbox, void** m) {
+    posix_mbox_cell_t* c;
+    size_t pos, seq;
+    intptr_t diff;
+
+    pos = __atomic_load_n(&mbox->out, __ATOMIC_RELAXED);
+    for (;;) {
+        c = &mbox->cells[pos & mbox->mask];
+        seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+        diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {                        /* Cell is written, try to take it */
+            if (__atomic_compare_exchange_n(&mbox->out, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0;                           /* Queue is empty */
+        } else {
+            pos = __atomic_load_n(&mbox->out, __ATOMIC_RELAXED);    /* Other reader was faster */
+        }
+    }
+    *m = c->data;
+    __atomic_store_n(&c->seq, pos + mbox->mask + 1, __ATOMIC_RELEASE);  /* Release cell to writers */
+    evt_signal(&mbox->not_full);
+    return 1;
+}
+
+/**
+ * \brief           Fill unused part of current thread stack with pattern
+ * \note            Stack grows down, everything below current frame is not used yet
+ */
+static void
+stack_paint(void) {
+    pthread_attr_t attr;
+    volatile uint8_t* p;
+    uintptr_t end;
+    void* addr;
+    size_t size;
+
+    if (pthread_getattr_np(pthread_self(), &attr)) {
+        return;
+    }
+    end = (uintptr_t)__builtin_frame_address(0);
+    if (!pthread_attr_getstack(&attr, &addr, &size) && end > (uintptr_t)addr + 512) {
+        end -= 512;                             /* Keep safe distance to current frame */
+        for (p = addr; (uintptr_t)p < end; ++p) {
+            *p = POSIX_STACK_PATTERN;
+        }
+    }
+    pthread_attr_destroy(&attr);
+}
+
+static void*
+thread_start(void* arg) {
+    posix_thread_start_t st = *(posix_thread_start_t *)arg;
+
+    free(arg);
+    if (st.paint) {
+        stack_paint();
+    }
+    st.fn(st.arg);
+    return NULL;
+}
+
+uint8_t
+gsm_sys_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &sys_start_time);    /* Get start time */
+    return 1;
+}
+
+uint32_t
+gsm_sys_now(void) {
+    return osKernelSysTick();                   /* Get current tick in units of milliseconds */
+}
+
+uint8_t
+gsm_sys_protect(void) {
+    if (sys_protect_depth++ == 0) {             /* Lock only on first level in this thread */
+        pthread_mutex_lock(&sys_mutex);
+    }
+    return 1;
+}
+
+uint8_t
+gsm_sys_unprotect(void) {
+    if (--sys_protect_depth == 0) {             /* Release lock on last level */
+        pthread_mutex_unlock(&sys_mutex);
+    }
+    return 1;
+}
+
+uint8_t
+gsm_sys_mutex_create(gsm_sys_mutex_t* p) {
+    pthread_mutexattr_t attr;
+
+    *p = malloc(sizeof(**p));
+    if (*p == NULL) {
+        return 0;
+    }
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    if (pthread_mutex_init(*p, &attr)) {
+        free(*p);
+        *p = NULL;
+    }
+    pthread_mutexattr_destroy(&attr);
+    return *p != NULL;
+}
+
+uint8_t
+gsm_sys_mutex_delete(gsm_sys_mutex_t* p) {
+    pthread_mutex_destroy(*p);
+    free(*p);
+    return 1;
+}
+
+uint8_t
+gsm_sys_mutex_lock(gsm_sys_mutex_t* p) {
+    return pthread_mutex_lock(*p) == 0;
+}
+
+uint8_t
+gsm_sys_mutex_unlock(gsm_sys_mutex_t* p) {
+    return pthread_mutex_unlock(*p) == 0;
+}
+
+uint8_t
+gsm_sys_mutex_isvalid(gsm_sys_mutex_t* p) {
+    return *p != NULL;                          /* Check if mutex is valid */
+}
+
+uint8_t
+gsm_sys_mutex_invalid(gsm_sys_mutex_t* p) {
+    *p = GSM_SYS_MUTEX_NULL;                    /* Set mutex as invalid */
+    return 1;
+}
+
+uint8_t
+gsm_sys_sem_create(gsm_sys_sem_t* p, uint8_t cnt) {
+    *p = malloc(sizeof(**p));
+    if (*p != NULL) {
+        (*p)->val = !!cnt;
+        (*p)->waiters = 0;
+    }
+    return *p != NULL;
+}
+
+uint8_t
+gsm_sys_sem_delete(gsm_sys_sem_t* p) {
+    free(*p);
+    return 1;
+}
+
+uint32_t
+gsm_sys_sem_wait(gsm_sys_sem_t* p, uint32_t timeout) {
+    struct gsm_sys_posix_sem* sem = *p;
+    uint32_t time = osKernelSysTick();          /* Get start tick time */
+    uint32_t one, rem;
+
+    for (;;) {
+        one = 1;
+        if (__atomic_compare_exchange_n(&sem->val, &one, 0, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return osKernelSysTick() - time;
+        }
+        if (!wait_remaining(time, timeout, &rem)) {
+            return GSM_SYS_TIMEOUT;
+        }
+        __atomic_add_fetch(&sem->waiters, 1, __ATOMIC_SEQ_CST);
+        futex_wait(&sem->val, 0, rem);          /* Sleep only if semaphore is still taken */
+        __atomic_sub_fetch(&sem->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+uint8_t
+gsm_sys_sem_release(gsm_sys_sem_t* p) {
+    struct gsm_sys_posix_sem* sem = *p;
+
+    __atomic_store_n(&sem->val, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&sem->waiters, __ATOMIC_SEQ_CST)) {
+        futex_wake(&sem->val, 1);
+    }
+    return 1;
+}
+
+uint8_t
+gsm_sys_sem_isvalid(gsm_sys_sem_t* p) {
+    return *p != NULL;                          /* Check if valid */
+}
+
+uint8_t
+gsm_sys_sem_invalid(gsm_sys_sem_t* p) {
+    *p = GSM_SYS_SEM_NULL;                      /* Invaldiate semaphore */
+    return 1;
+}
+
+uint8_t
+gsm_sys_mbox_create(gsm_sys_mbox_t* b, size_t size) {
+    struct gsm_sys_posix_mbox* mbox;
+    size_t cells, i;
+
+    for (cells = 2; cells < size; cells <<= 1) {}   /* Round cells up to power of two */
+    mbox = malloc(sizeof(*mbox) + (cells - 1) * sizeof(mbox->cells[0]));
+    if (mbox != NULL) {
+        memset(mbox, 0x00, sizeof(*mbox));
+        mbox->mask = cells - 1;
+        mbox->size = size;
+        for (i = 0; i < cells; i++) {
+            mbox->cells[i].seq = i;             /* Each cell is free for writer at its position */
+        }
+    }
+    *b = mbox;
+    return *b != NULL;
+}
+
+uint8_t
+gsm_sys_mbox_delete(gsm_sys_mbox_t* b) {
+    free(*b);
+    return 1;
+}
+
+uint32_t
+gsm_sys_mbox_put(gsm_sys_mbox_t* b, void* m) {
+    struct gsm_sys_posix_mbox* mbox = *b;
+    uint32_t time = osKernelSysTick();          /* Get start time */
+    uint32_t seq;
+
+    while (!mbox_try_put(mbox, m)) {
+        seq = __atomic_load_n(&mbox->not_full.seq, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&mbox->not_full.waiters, 1, __ATOMIC_SEQ_CST);
+        if (mbox_try_put(mbox, m)) {            /* Reader may have been faster */
+            __atomic_sub_fetch(&mbox->not_full.waiters, 1, __ATOMIC_SEQ_CST);
+            break;
+        }
+        futex_wait(&mbox->not_full.seq, seq, 0);    /* Wait for any read */
+        __atomic_sub_fetch(&mbox->not_full.waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    return osKernelSysTick() - time;
+}
+
+uint32_t
+gsm_sys_mbox_get(gsm_sys_mbox_t* b, void** m, uint32_t timeout) {
+    struct gsm_sys_posix_mbox* mbox = *b;
+    uint32_t time = osKernelSysTick();          /* Get current time */
+    uint32_t seq, rem;
+
+    while (!mbox_try_get(mbox, m)) {
+        if (!wait_remaining(time, timeout, &rem)) {
+            return GSM_SYS_TIMEOUT;
+        }
+        seq = __atomic_load_n(&mbox->not_empty.seq, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&mbox->not_empty.waiters, 1, __ATOMIC_SEQ_CST);
+        if (mbox_try_get(mbox, m)) {            /* Writer may have been faster */
+            __atomic_sub_fetch(&mbox->not_empty.waiters, 1, __ATOMIC_SEQ_CST);
+            break;
+        }
+        futex_wait(&mbox->not_empty.seq, seq, rem); /* Wait for any write */
+        __atomic_sub_fetch(&mbox->not_empty.waiters, 1, __ATOMIC_SEQ_CST);
+    }
+    return osKernelSysTick() - time;
+}
+
+uint8_t
+gsm_sys_mbox_putnow(gsm_sys_mbox_t* b, void* m) {
+    return mbox_try_put(*b, m);
+}
+
+uint8_t
+gsm_sys_mbox_getnow(gsm_sys_mbox_t* b, void** m) {
+    return mbox_try_get(*b, m);
+}
+
+uint8_t
+gsm_sys_mbox_isvalid(gsm_sys_mbox_t* b) {
+    return *b != NULL;                          /* Return status if message box is valid */
+}
+
+uint8_t
+gsm_sys_mbox_invalid(gsm_sys_mbox_t* b) {
+    *b = GSM_SYS_MBOX_NULL;                     /* Invalidate message box */
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_create(gsm_sys_thread_t* t, const char* name, gsm_sys_thread_fn thread_func, void* const arg, size_t stack_size, gsm_sys_thread_prio_t prio) {
+    posix_thread_start_t* st;
+    pthread_attr_t attr;
+    pthread_t h;
+    int res;
+
+    st = malloc(sizeof(*st));
+    if (st == NULL) {
+        return 0;
+    }
+    st->fn = thread_func;
+    st->arg = arg;
+    st->paint = stack_size > 0;                 /* Only explicit stacks are small enough to paint */
+
+    pthread_attr_init(&attr);
+    if (stack_size) {
+        pthread_attr_setstacksize(&attr, stack_size < (size_t)PTHREAD_STACK_MIN ? (size_t)PTHREAD_STACK_MIN : stack_size);
+    }
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    res = pthread_create(&h, &attr, thread_start, st);
+    pthread_attr_destroy(&attr);
+    if (res) {
+        free(st);
+        return 0;
+    }
+    if (name != NULL) {
+        char n[16];                             /* Linux limits thread name to 15 characters */
+
+        strncpy(n, name, sizeof(n) - 1);
+        n[sizeof(n) - 1] = 0;
+        pthread_setname_np(h, n);
+    }
+    if (t != NULL) {
+        *t = h;
+    }
+    (void)prio;
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_terminate(gsm_sys_thread_t* t) {
+    if (t == NULL) {                            /* Shall we terminate ourself? */
+        pthread_exit(NULL);
+    }
+    pthread_cancel(*t);
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_yield(void) {
+    sched_yield();
+    return 1;
+}
+
+uint8_t
+gsm_sys_thread_get_stats(gsm_sys_thread_t* t, gsm_sys_thread_stats_t* stats) {
+    pthread_attr_t attr;
+    struct timespec ts;
+    clockid_t cid;
+    const uint8_t* p;
+    void* addr;
+    size_t size;
+
+    memset(stats, 0x00, sizeof(*stats));
+    if (!pthread_getcpuclockid(*t, &cid) && !clock_gettime(cid, &ts)) {
+        stats->run_time = (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+    }
+
+    /* High-water mark is only known for painted stacks */
+    if (pthread_getattr_np(*t, &attr)) {
+        return 1;
+    }
+    if (!pthread_attr_getstack(&attr, &addr, &size)
+        && *(const uint8_t *)addr == POSIX_STACK_PATTERN) {
+        for (p = addr; p < (const uint8_t *)addr + size && *p == POSIX_STACK_PATTERN; ++p) {}
+        stats->stack_size = size;
+        stats->stack_free_min = (size_t)(p - (const uint8_t *)addr);
+    }
+    pthread_attr_destroy(&attr);
+    return 1;
+}
+
+uint8_t
+gsm_sys_mbox_get_stats(gsm_sys_mbox_t* b, gsm_sys_mbox_stats_t* stats) {
+    struct gsm_sys_posix_mbox* mbox = *b;
+    size_t in, out;
+
+    out = __atomic_load_n(&mbox->out, __ATOMIC_RELAXED);
+    in = __atomic_load_n(&mbox->in, __ATOMIC_RELAXED);
+    stats->size = mbox->size;
+    stats->used = in - out;
+    if (stats->used > stats->size) {            /* Positions were read while other thread moved them */
+        stats->used = 0;
+    }
+    stats->peak = __atomic_load_n(&mbox->peak, __ATOMIC_RELAXED);
+    return 1;
+}
+
+#endif /* !__DOXYGEN__ */